@@ -0,0 +1,377 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file FileChangeMonitor.cpp
+ * Watch a set of files for appended or replaced data
+ */
+
+#include <chrono>
+#include <thread>
+#include "FileChangeMonitor.hpp"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+   /** Directory events that may indicate new data in a monitored
+    * file, or its removal, or loss of the watch. */
+#define FCM_WATCH_MASK (IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO | \
+                        IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | \
+                        IN_MOVE_SELF)
+#endif
+   /** Longest single block on events in seconds, well inside the
+    * int milliseconds taken by poll(). */
+#define FCM_MAX_BLOCK 86400.0
+
+#ifndef WIN32
+#define PATH_SEP_STRING "/"
+#else
+#define PATH_SEP_STRING "/\\"
+#endif
+
+using namespace std;
+
+namespace gnsstk
+{
+   FileChangeMonitor ::
+   FileChangeMonitor(bool forcePolling)
+         : pollInterval(1.0), notifyFD(-1)
+   {
+#ifdef __linux__
+      if (!forcePolling)
+      {
+            // a failure here (e.g. the per-user instance limit) just
+            // leaves us polling
+         notifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      }
+#endif
+   }
+
+
+   FileChangeMonitor ::
+   ~FileChangeMonitor()
+   {
+#ifdef __linux__
+      if (notifyFD >= 0)
+         close(notifyFD);
+#endif
+   }
+
+
+   bool FileChangeMonitor ::
+   addFile(const std::string& fn)
+   {
+      pending.insert(fn);
+      std::map<std::string, FileInfo>::iterator fi = files.find(fn);
+      if (fi != files.end())
+         return (fi->second.watch >= 0);
+      FileInfo& info = files[fn];
+      info.update(fn);
+      return watchFile(fn, info);
+   }
+
+
+   bool FileChangeMonitor ::
+   watchFile(const std::string& fn, FileInfo& info)
+   {
+#ifdef __linux__
+      if (notifyFD >= 0)
+      {
+         std::string dir, base;
+         splitPath(fn, dir, base);
+         std::map<std::string, int>::iterator dwi = dirWatches.find(dir);
+         int wd;
+         if (dwi == dirWatches.end())
+         {
+            wd = inotify_add_watch(notifyFD, dir.c_str(), FCM_WATCH_MASK);
+            if (wd >= 0)
+               dirWatches[dir] = wd;
+         }
+         else
+         {
+            wd = dwi->second;
+         }
+         if (wd >= 0)
+         {
+            info.watch = wd;
+            watchFiles[wd][base] = fn;
+         }
+      }
+#endif
+      return (info.watch >= 0);
+   }
+
+
+   void FileChangeMonitor ::
+   dropWatch(int wd, std::set<std::string>& changed)
+   {
+      std::map<int, std::map<std::string, std::string> >::iterator
+         wfi = watchFiles.find(wd);
+      if (wfi == watchFiles.end())
+         return;
+      std::map<std::string, std::string> names;
+      names.swap(wfi->second);
+      watchFiles.erase(wfi);
+      std::map<std::string, int>::iterator dwi = dirWatches.begin();
+      while (dwi != dirWatches.end())
+      {
+         if (dwi->second == wd)
+            dirWatches.erase(dwi++);
+         else
+            ++dwi;
+      }
+         // the directory may already be back (e.g. renamed into
+         // place), otherwise poll until the file reappears
+      std::map<std::string, std::string>::const_iterator ni;
+      for (ni = names.begin(); ni != names.end(); ni++)
+      {
+         std::map<std::string, FileInfo>::iterator fi = files.find(ni->second);
+         if (fi == files.end())
+            continue;
+         fi->second.watch = -1;
+         fi->second.update(fi->first);
+         watchFile(fi->first, fi->second);
+         changed.insert(fi->first);
+      }
+   }
+
+
+   void FileChangeMonitor ::
+   removeFile(const std::string& fn)
+   {
+      pending.erase(fn);
+      std::map<std::string, FileInfo>::iterator fi = files.find(fn);
+      if (fi == files.end())
+         return;
+#ifdef __linux__
+      int wd = fi->second.watch;
+      if (wd >= 0)
+      {
+         std::string dir, base;
+         splitPath(fn, dir, base);
+         std::map<std::string, std::string>& names = watchFiles[wd];
+         names.erase(base);
+         if (names.empty())
+         {
+            inotify_rm_watch(notifyFD, wd);
+            watchFiles.erase(wd);
+               // several spellings of a directory can share one watch
+            std::map<std::string, int>::iterator dwi = dirWatches.begin();
+            while (dwi != dirWatches.end())
+            {
+               if (dwi->second == wd)
+                  dirWatches.erase(dwi++);
+               else
+                  ++dwi;
+            }
+         }
+      }
+#endif
+      files.erase(fi);
+   }
+
+
+   bool FileChangeMonitor ::
+   wait(double timeout, std::vector<std::string>& changed)
+   {
+      typedef std::chrono::steady_clock Clock;
+      Clock::time_point start = Clock::now();
+      std::set<std::string> found(pending);
+      pending.clear();
+      changed.clear();
+      bool anyPolled = false;
+      std::map<std::string, FileInfo>::const_iterator fi;
+      for (fi = files.begin(); !anyPolled && fi != files.end(); fi++)
+      {
+         anyPolled = (fi->second.watch < 0);
+      }
+      while (true)
+      {
+         double remaining = timeout -
+            std::chrono::duration<double>(Clock::now() - start).count();
+         if (!(remaining > 0))
+            remaining = 0;
+         if (notifyFD >= 0)
+         {
+               // block on events only while there's nothing to
+               // report, and wake up in time to check polled files
+            double block = remaining;
+            if (anyPolled && pollInterval < block)
+               block = pollInterval;
+            if (block > FCM_MAX_BLOCK)
+               block = FCM_MAX_BLOCK;
+            readEvents(found.empty() ? (int)(block * 1000) : 0, found);
+               // a lost directory watch leaves files to be polled
+            for (fi = files.begin(); !anyPolled && fi != files.end(); fi++)
+            {
+               anyPolled = (fi->second.watch < 0);
+            }
+         }
+         checkPolled(found);
+         if (!found.empty() || remaining <= 0)
+            break;
+         if (notifyFD < 0)
+         {
+            double nap = (pollInterval < remaining ? pollInterval
+                          : remaining);
+            std::this_thread::sleep_for(std::chrono::duration<double>(nap));
+         }
+      }
+      changed.assign(found.begin(), found.end());
+      return !changed.empty();
+   }
+
+
+   bool FileChangeMonitor::FileInfo ::
+   update(const std::string& fn)
+   {
+      struct stat st;
+      if (stat(fn.c_str(), &st))
+      {
+         bool rv = exists;
+         exists = false;
+         size = 0;
+         return rv;
+      }
+      bool rv = (!exists || (st.st_size != size) || (st.st_mtime != mtime) ||
+                 (st.st_ino != inode));
+      exists = true;
+      size = st.st_size;
+      mtime = st.st_mtime;
+      inode = st.st_ino;
+      return rv;
+   }
+
+
+   void FileChangeMonitor ::
+   splitPath(const std::string& fn, std::string& dir, std::string& base)
+   {
+      std::string::size_type pos = fn.find_last_of(PATH_SEP_STRING);
+      if (pos == std::string::npos)
+      {
+         dir = ".";
+         base = fn;
+      }
+      else
+      {
+         dir = (pos == 0 ? fn.substr(0,1) : fn.substr(0,pos));
+         base = fn.substr(pos+1);
+      }
+   }
+
+
+   void FileChangeMonitor ::
+   checkPolled(std::set<std::string>& changed)
+   {
+      std::map<std::string, FileInfo>::iterator fi;
+      for (fi = files.begin(); fi != files.end(); fi++)
+      {
+         if ((fi->second.watch < 0) && fi->second.update(fi->first))
+         {
+            changed.insert(fi->first);
+               // the file's directory exists again, so try to go back
+               // to events
+            if (fi->second.exists)
+               watchFile(fi->first, fi->second);
+         }
+      }
+   }
+
+
+   void FileChangeMonitor ::
+   readEvents(int timeout, std::set<std::string>& changed)
+   {
+#ifdef __linux__
+      struct pollfd pfd;
+      pfd.fd = notifyFD;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (poll(&pfd, 1, timeout) <= 0)
+         return;
+      alignas(struct inotify_event) char buf[16384];
+      while (true)
+      {
+         ssize_t len = read(notifyFD, buf, sizeof(buf));
+         if (len <= 0)
+            break;
+         for (char *ptr = buf; ptr < buf + len;
+              ptr += sizeof(struct inotify_event) +
+                 ((struct inotify_event*)ptr)->len)
+         {
+            const struct inotify_event *event = (struct inotify_event*)ptr;
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                  // events were lost, so anything may have changed
+               std::map<std::string, FileInfo>::const_iterator fi;
+               for (fi = files.begin(); fi != files.end(); fi++)
+                  changed.insert(fi->first);
+               continue;
+            }
+            if (event->mask & IN_MOVE_SELF)
+            {
+                  // the directory is no longer at the monitored path;
+                  // removing the watch generates IN_IGNORED
+               inotify_rm_watch(notifyFD, event->wd);
+               continue;
+            }
+            if (event->mask & IN_IGNORED)
+            {
+                  // the watch is gone: the directory was deleted,
+                  // unmounted or moved away
+               dropWatch(event->wd, changed);
+               continue;
+            }
+            if (event->len == 0)
+               continue;
+            std::map<int, std::map<std::string, std::string> >::const_iterator
+               wfi = watchFiles.find(event->wd);
+            if (wfi == watchFiles.end())
+               continue;
+            std::map<std::string, std::string>::const_iterator
+               ni = wfi->second.find(event->name);
+            if (ni != wfi->second.end())
+               changed.insert(ni->second);
+         }
+      }
+#endif
+   }
+
+} // namespace gnsstk
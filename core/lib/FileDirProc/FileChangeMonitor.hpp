@@ -0,0 +1,195 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file FileChangeMonitor.hpp
+ * Watch a set of files for appended or replaced data
+ */
+
+#ifndef GNSSTK_FILECHANGEMONITOR_HPP
+#define GNSSTK_FILECHANGEMONITOR_HPP
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gnsstk
+{
+      /// @ingroup FileDirProc
+      //@{
+
+      /** Watch any number of files from a single thread and report
+       * which of them have changed.
+       *
+       * On Linux the monitor is event driven: one inotify watch is
+       * placed on each directory containing a monitored file, so
+       * hundreds of station files in a handful of directories cost a
+       * handful of watches.  Files do not need to exist when they are
+       * added; creation, modification, removal and rename events are all
+       * reported.  Elsewhere, or when event notification can not be
+       * set up (e.g. the directory does not exist yet), the file is
+       * polled with stat() every #pollInterval seconds and reported
+       * when its size, modification time or inode changes.  If a
+       * watched directory is deleted or moved away its files are
+       * reported as changed and polled until they reappear, at which
+       * point the directory is watched again.  Files
+       * written by another host over a network file system do not
+       * generate events; use forcePolling for those.
+       *
+       * Every file is reported once by the first wait() after it is
+       * added so that data already present can be consumed.
+       *
+       * @code{.cpp}
+       *    gnsstk::FileChangeMonitor mon;
+       *    mon.addFile("/data/rt/abcd0010.22o");
+       *    std::vector<std::string> changed;
+       *    while (true)
+       *    {
+       *       mon.wait(10, changed);
+       *       for (unsigned i = 0; i < changed.size(); i++)
+       *          process(changed[i]);
+       *    }
+       * @endcode
+       */
+   class FileChangeMonitor
+   {
+   public:
+         /** Initialize the monitor.
+          * @param[in] forcePolling If true, never use event
+          *   notification even when it is available. */
+      FileChangeMonitor(bool forcePolling = false);
+
+         /// Release any event notification resources.
+      ~FileChangeMonitor();
+
+         /** Start monitoring a file.  Adding a file that is already
+          * monitored has no effect other than reporting it as changed
+          * on the next wait().
+          * @param[in] fn The path of the file to monitor.
+          * @return true if the file is watched using events, false
+          *   if it will be polled. */
+      bool addFile(const std::string& fn);
+
+         /// Stop monitoring a file.
+      void removeFile(const std::string& fn);
+
+         /// Return true if \a fn is being monitored.
+      bool isMonitored(const std::string& fn) const
+      { return files.find(fn) != files.end(); }
+
+         /// Return the number of files being monitored.
+      size_t size() const
+      { return files.size(); }
+
+         /// Return true if event notification is in use.
+      bool isEventDriven() const
+      { return notifyFD >= 0; }
+
+         /** Wait for one or more monitored files to change.
+          * @param[in] timeout The maximum time to wait in seconds.  A
+          *   value of zero checks for changes without blocking.
+          * @param[out] changed The names of the files that have
+          *   changed, as given to addFile(), without duplicates.
+          *   Cleared on entry.
+          * @return true if any file has changed. */
+      bool wait(double timeout, std::vector<std::string>& changed);
+
+         /// Seconds between stat() checks of polled files.
+      double pollInterval;
+
+   private:
+         /// What the last stat() said about a polled file.
+      struct FileInfo
+      {
+         FileInfo()
+               : exists(false), size(0), mtime(0), inode(0), watch(-1)
+         {}
+            /// Set from a stat() of \a fn, return true if different.
+         bool update(const std::string& fn);
+         bool exists;
+         off_t size;
+         time_t mtime;
+         ino_t inode;
+            /// Watch descriptor of the file's directory, -1 if polled.
+         int watch;
+      };
+
+         /// Split \a fn into a directory and base name.
+      static void splitPath(const std::string& fn, std::string& dir,
+                            std::string& base);
+
+         /** Place (or share) a watch on the directory of \a fn.
+          * @return true if the file is now watched using events. */
+      bool watchFile(const std::string& fn, FileInfo& info);
+
+         /** Forget a directory watch that the system has removed,
+          * falling back to polling for its files and adding them to
+          * \a changed. */
+      void dropWatch(int wd, std::set<std::string>& changed);
+
+         /// Check all polled files, adding changed ones to \a changed.
+      void checkPolled(std::set<std::string>& changed);
+
+         /** Read pending events from the notification descriptor,
+          * adding changed files to \a changed.
+          * @param[in] timeout Milliseconds to block for events. */
+      void readEvents(int timeout, std::set<std::string>& changed);
+
+
+         /// Monitored files.
+      std::map<std::string, FileInfo> files;
+         /// Files to report on the next wait() regardless of state.
+      std::set<std::string> pending;
+         /// Event notification file descriptor, or -1 if polling.
+      int notifyFD;
+         /// Watch descriptor for each watched directory.
+      std::map<std::string, int> dirWatches;
+         /** Monitored file names, keyed by the watch descriptor of
+          * their directory and then by base name. */
+      std::map<int, std::map<std::string, std::string> > watchFiles;
+   }; // class FileChangeMonitor
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_FILECHANGEMONITOR_HPP
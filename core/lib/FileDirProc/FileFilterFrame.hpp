@@ -292,7 +292,7 @@ namespace gnsstk
          if (s.good())
          {
             FileData data;
-            while (s >> data)
+            while (data.tryGetRecord(s) == FFStreamStatus::OK)
                this->addData(data);
          }
       }
@@ -0,0 +1,453 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file RTFileFollower.hpp
+ * Follow growing files, decoding records as they are appended
+ */
+
+#ifndef GNSSTK_RTFILEFOLLOWER_HPP
+#define GNSSTK_RTFILEFOLLOWER_HPP
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "FileChangeMonitor.hpp"
+#include "FFTextStream.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "SP3Stream.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileDirProc
+      //@{
+
+      /** The stream state needed to resume reading after an
+       * incomplete record.  This covers the stream position and the
+       * counters maintained by FFStream and FFTextStream; streams
+       * that carry more state between records extend it (see
+       * SP3FileCheckpoint). */
+   class RTFileCheckpoint
+   {
+   public:
+      RTFileCheckpoint()
+            : pos(0), recordNumber(0), lineNumber(0)
+      {}
+
+         /// Record the state of a binary stream.
+      void save(FFStream& s)
+      {
+         pos = s.tellg();
+         recordNumber = s.recordNumber;
+      }
+         /// Record the state of a text stream.
+      void save(FFTextStream& s)
+      {
+         save(static_cast<FFStream&>(s));
+         lineNumber = s.lineNumber;
+      }
+         /// Return a binary stream to the saved state.
+      void restore(FFStream& s) const
+      {
+         s.clear();
+         s.seekg(pos);
+         s.recordNumber = recordNumber;
+      }
+         /// Return a text stream to the saved state.
+      void restore(FFTextStream& s) const
+      {
+         restore(static_cast<FFStream&>(s));
+         s.lineNumber = lineNumber;
+      }
+         /** Return a text stream to the saved state less its first
+          * line, and save that, to get past a record that can't be
+          * decoded. */
+      void skipLine(FFTextStream& s)
+      {
+         restore(s);
+         std::string line;
+         std::getline(s, line);
+         s.lineNumber++;
+         save(s);
+      }
+
+         /// Offset of the first byte not yet decoded.
+      std::streampos pos;
+      unsigned int recordNumber;
+      unsigned int lineNumber;
+   };
+
+
+      /** SP3Stream reads one line ahead of the record being decoded,
+       * so the look-ahead line and current epoch are part of the
+       * resumable state. */
+   class SP3FileCheckpoint : public RTFileCheckpoint
+   {
+   public:
+      void save(SP3Stream& s)
+      {
+         RTFileCheckpoint::save(s);
+         lastLine = s.lastLine;
+         currentEpoch = s.currentEpoch;
+      }
+      void restore(SP3Stream& s) const
+      {
+         RTFileCheckpoint::restore(s);
+         s.lastLine = lastLine;
+         s.currentEpoch = currentEpoch;
+      }
+         /// The first line not yet decoded is the look-ahead line.
+      void skipLine(SP3Stream& s)
+      {
+         restore(s);
+         if (s.lastLine.empty())
+         {
+            std::string line;
+            std::getline(s, line);
+            s.lineNumber++;
+         }
+         else
+         {
+            s.lastLine.clear();
+         }
+         save(s);
+      }
+
+      std::string lastLine;
+      CommonTime currentEpoch;
+   };
+
+
+      /** Per-format hooks used by RTFileFollower.  The default is
+       * suitable for formats without a header that must be read
+       * explicitly. */
+   template <class FileStream>
+   class RTFileFollowerTraits
+   {
+   public:
+      typedef RTFileCheckpoint Checkpoint;
+         /** Read the file header into the stream, if the format has
+          * one.  @return false if the header is not yet complete. */
+      static bool readHeader(FileStream&)
+      { return true; }
+   };
+
+      /// RINEX 3 (and 2) observation files.
+   template <>
+   class RTFileFollowerTraits<Rinex3ObsStream>
+   {
+   public:
+      typedef RTFileCheckpoint Checkpoint;
+      static bool readHeader(Rinex3ObsStream& s)
+      {
+         s >> s.header;
+         return !s.fail();
+      }
+   };
+
+      /// SP3 orbit files.
+   template <>
+   class RTFileFollowerTraits<SP3Stream>
+   {
+   public:
+      typedef SP3FileCheckpoint Checkpoint;
+      static bool readHeader(SP3Stream& s)
+      {
+         s >> s.header;
+         return !s.fail();
+      }
+   };
+
+
+      /** Follow any number of files that are being written, for
+       * example the hourly RINEX observation files of a network of
+       * real-time stations, decoding records as they are appended.
+       *
+       * Change detection is done by a FileChangeMonitor, so on Linux
+       * the follower sleeps in the kernel until one of its files is
+       * written and then reads only that file.  Each file keeps its
+       * stream open along with a checkpoint taken after the last
+       * complete record.  A record that can not be decoded because
+       * the writer has not finished it (the read reaches the end of
+       * the file, or fails while the last line of the file has no
+       * newline) is discarded, the stream is
+       * returned to the checkpoint, and that file is not read again
+       * until it has grown.  Records before the checkpoint are never
+       * decoded twice.
+       *
+       * A read that fails before the end of the file, when the file
+       * ends with a complete line, is a malformed record rather than
+       * an unfinished one.  It is reported to the error handler, if
+       * any, and skipped a line at a time until a record decodes; a
+       * run of lines that can't be decoded is reported once.
+       *
+       * If a file shrinks, is replaced (different inode) or is
+       * removed and created again, it is read again from the
+       * beginning.
+       *
+       * For formats with a header (RINEX observation and SP3), the
+       * header is read before any data and is available via
+       * getStream().
+       *
+       * @note SP3Stream reads one line ahead, so the last record in
+       * an SP3 file is delivered once the following line (another
+       * record, or the "EOF" line) has been written.
+       *
+       * @code{.cpp}
+       *    gnsstk::RTFileFollower<gnsstk::Rinex3ObsStream,
+       *                           gnsstk::Rinex3ObsData> follower;
+       *    for (unsigned i = 0; i < stations.size(); i++)
+       *       follower.addFile(dir + stations[i] + suffix);
+       *    while (true)
+       *    {
+       *       follower.poll(60,
+       *          [](const std::string& fn, const gnsstk::Rinex3ObsData& rod)
+       *          { process(fn, rod); });
+       *    }
+       * @endcode
+       */
+   template <class FileStream, class FileData>
+   class RTFileFollower
+   {
+   public:
+      typedef typename RTFileFollowerTraits<FileStream>::Checkpoint Checkpoint;
+         /// Callback receiving each record and the name of its file.
+      typedef std::function<void(const std::string&, const FileData&)> Handler;
+         /// Callback receiving the error for a malformed record.
+      typedef std::function<void(const std::string&,
+                                 const FFStreamError&)> ErrorHandler;
+
+         /** Initialize with no files.
+          * @param[in] forcePolling Passed to the FileChangeMonitor. */
+      RTFileFollower(bool forcePolling = false)
+            : monitor(forcePolling)
+      {}
+
+         /** Start following a file.  The file need not exist yet.
+          * Any data already in the file is delivered by the next
+          * poll(). */
+      void addFile(const std::string& fn)
+      {
+         files[fn];
+         monitor.addFile(fn);
+      }
+
+         /// Stop following a file and close it.
+      void removeFile(const std::string& fn)
+      {
+         files.erase(fn);
+         monitor.removeFile(fn);
+      }
+
+         /** Get the stream used to read \a fn, e.g. to access its
+          * header.
+          * @return NULL if the file has not been opened yet. */
+      FileStream* getStream(const std::string& fn)
+      {
+         typename FollowMap::iterator fi = files.find(fn);
+         return (fi == files.end() ? NULL : fi->second.strm.get());
+      }
+
+         /** Wait for new data in any followed file and deliver all
+          * complete records to \a handler.
+          * @param[in] timeout Maximum time to wait, in seconds.
+          * @param[in] handler Called once for each new record.
+          * @param[in] errorHandler Called for each malformed record
+          *   that is skipped.
+          * @return the number of records delivered. */
+      size_t poll(double timeout, const Handler& handler,
+                  const ErrorHandler& errorHandler = ErrorHandler());
+
+         /** Deliver all complete records that have been appended to
+          * \a fn since the last call, without waiting.
+          * @return the number of records delivered. */
+      size_t process(const std::string& fn, const Handler& handler,
+                     const ErrorHandler& errorHandler = ErrorHandler());
+
+         /// Change detection for the followed files.
+      FileChangeMonitor monitor;
+
+   private:
+         /// Read state of one followed file.
+      struct Follow
+      {
+         Follow()
+               : headerDone(false), skipping(false), waitSize(-1), inode(0)
+         {}
+         std::unique_ptr<FileStream> strm;
+            /// State after the last complete record.
+         Checkpoint cp;
+         bool headerDone;
+            /// Lines are being skipped after a malformed record.
+         bool skipping;
+            /** File size at the last incomplete read; the file isn't
+             * read again until it's larger than this. */
+         off_t waitSize;
+            /// Used to detect a file being replaced.
+         ino_t inode;
+      };
+      typedef std::map<std::string, Follow> FollowMap;
+
+      FollowMap files;
+
+         /** Return true if the last byte of the file read by \a s is
+          * a newline.  This leaves the stream position undefined. */
+      static bool endsWithNewline(FileStream& s)
+      {
+         s.clear();
+         s.seekg(-1, std::ios::end);
+         return (s.peek() == '\n');
+      }
+   }; // class RTFileFollower
+
+      //@}
+
+
+   template <class FileStream, class FileData>
+   size_t RTFileFollower<FileStream, FileData> ::
+   poll(double timeout, const Handler& handler,
+        const ErrorHandler& errorHandler)
+   {
+      std::vector<std::string> changed;
+      size_t count = 0;
+      monitor.wait(timeout, changed);
+      for (unsigned i = 0; i < changed.size(); i++)
+      {
+         count += process(changed[i], handler, errorHandler);
+      }
+      return count;
+   }
+
+
+   template <class FileStream, class FileData>
+   size_t RTFileFollower<FileStream, FileData> ::
+   process(const std::string& fn, const Handler& handler,
+           const ErrorHandler& errorHandler)
+   {
+      typename FollowMap::iterator fi = files.find(fn);
+      if (fi == files.end())
+         return 0;
+      Follow& f(fi->second);
+      struct stat st;
+      if (stat(fn.c_str(), &st))
+      {
+            // gone; a file created in its place may reuse the inode
+         f = Follow();
+         return 0;
+      }
+      if (f.strm && ((st.st_ino != f.inode) ||
+                     (st.st_size < (off_t)(std::streamoff)f.cp.pos)))
+      {
+            // replaced or truncated, start over
+         f = Follow();
+      }
+      if (!f.strm)
+      {
+         f.strm.reset(new FileStream(fn.c_str(), std::ios::in));
+         if (!f.strm->is_open())
+         {
+            f.strm.reset();
+            return 0;
+         }
+         f.inode = st.st_ino;
+         f.cp.save(*f.strm);
+      }
+      if (st.st_size <= f.waitSize)
+         return 0;
+      FileStream& s(*f.strm);
+      if (!f.headerDone)
+      {
+         if (!RTFileFollowerTraits<FileStream>::readHeader(s) || s.eof())
+         {
+            f.cp.restore(s);
+            f.waitSize = st.st_size;
+            return 0;
+         }
+         f.headerDone = true;
+         f.cp.save(s);
+      }
+      size_t count = 0;
+      bool retried = false;
+      while (true)
+      {
+         FileData data;
+         s >> data;
+            // Hitting EOF means the last line had no newline yet, so
+            // it may be incomplete even though it decoded.
+         if (s.fail() || s.eof())
+         {
+               // Failing short of EOF with only complete lines after
+               // the checkpoint means the record is malformed.  Read
+               // it once more in case its last line was finished just
+               // after the read.
+            bool bad = !s.eof() && endsWithNewline(s);
+            f.cp.restore(s);
+            if (!bad)
+            {
+               f.waitSize = st.st_size;
+               break;
+            }
+            if (!retried)
+            {
+               retried = true;
+               continue;
+            }
+            if (!f.skipping && errorHandler)
+            {
+               errorHandler(fn, s.mostRecentException);
+            }
+            f.skipping = true;
+            f.cp.skipLine(s);
+            retried = false;
+            continue;
+         }
+         f.cp.save(s);
+         f.skipping = false;
+         retried = false;
+         count++;
+         handler(fn, data);
+      }
+      return count;
+   }
+
+} // namespace gnsstk
+
+#endif // GNSSTK_RTFILEFOLLOWER_HPP
@@ -356,7 +356,7 @@ namespace gnsstk
          // zero out seconds
       startTime = MJD(floor(MJD(startTime).mjd));
       endTime = MJD(floor(MJD(endTime).mjd));
-      currentTime = MJD(floor(MJD(curretnTime).mjd));
+      currentTime = MJD(floor(MJD(currentTime).mjd));
 
          // set up the stream
       openCurrentFile();
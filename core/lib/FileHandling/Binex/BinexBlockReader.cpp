@@ -0,0 +1,347 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file BinexBlockReader.cpp
+ * Buffered, block-oriented reading of BINEX records.
+ */
+
+#include <algorithm>
+#include <string.h>
+#include "BinexBlockReader.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   const size_t BinexBlockReader::DEFAULT_BLOCK_SIZE;
+
+
+   // -------------------------------------------------------------------------
+   void BinexRecordView ::
+   copyTo(BinexData& data) const
+   {
+      size_t offset = 0;
+      data.setRecordFlags(syncByte);
+      data.setRecordID(recID);
+      data.clearMessage();
+      data.updateMessageData(offset, message, messageLength);
+   }
+
+
+   // -------------------------------------------------------------------------
+   BinexBlockReader ::
+   BinexBlockReader(std::istream& s, size_t bs)
+         : strm(s), blockSize(bs == 0 ? DEFAULT_BLOCK_SIZE : bs), head(0),
+           tail(0), atEnd(false), consumed(0)
+   {
+   }
+
+
+   // -------------------------------------------------------------------------
+   bool BinexBlockReader ::
+   next(BinexRecordView& view)
+   {
+      if (fill(1) == 0)
+      {
+         return false;
+      }
+      BinexData::SyncByte syncBuf = buffer[head];
+      BinexData::SyncByte expectedSyncByte;
+      if (BinexData::isHeadSyncByteValid(syncBuf, expectedSyncByte))
+      {
+         parseForward(expectedSyncByte, view);
+      }
+      else if (BinexData::isTailSyncByteValid(syncBuf, expectedSyncByte))
+      {
+         parseReverse(expectedSyncByte, view);
+      }
+      else
+      {
+         std::ostringstream errStrm;
+         errStrm << "Invalid BINEX synchronization byte: "
+                 << static_cast<uint16_t>(syncBuf);
+         FFStreamError err(errStrm.str() );
+         GNSSTK_THROW(err);
+      }
+      view.streamOffset = consumed;
+      consumed += view.recordSize;
+      head += view.recordSize;
+      return true;
+   }
+
+
+   // -------------------------------------------------------------------------
+   size_t BinexBlockReader ::
+   fill(size_t need)
+   {
+      size_t avail = tail - head;
+      if ((avail >= need) || atEnd)
+      {
+         return avail;
+      }
+         // Move the unparsed bytes to the front so that the record
+         // being parsed stays contiguous after the refill.
+      if (head > 0)
+      {
+         if (avail > 0)
+         {
+            memmove(&buffer[0], &buffer[head], avail);
+         }
+         head = 0;
+         tail = avail;
+      }
+      if (buffer.size() < std::max(need, blockSize))
+      {
+         buffer.resize(std::max(need, blockSize));
+      }
+      std::streambuf *sb = strm.rdbuf();
+      if (sb == nullptr)
+      {
+         atEnd = true;
+         return avail;
+      }
+      try
+      {
+            // Read directly from the stream buffer, which avoids the
+            // per-call sentry and exception handling of istream::read.
+         while ((tail - head) < need)
+         {
+            std::streamsize got = sb->sgetn(&buffer[tail],
+                                            buffer.size() - tail);
+            if (got <= 0)
+            {
+               atEnd = true;
+               break;
+            }
+            tail += got;
+         }
+      }
+      catch (std::exception& exc)
+      {
+         FFStreamError err(exc.what());
+         GNSSTK_THROW(err);
+      }
+      return tail - head;
+   }
+
+
+   // -------------------------------------------------------------------------
+   size_t BinexBlockReader ::
+   decodeUBNXI(const char *buf, size_t len, bool littleEndian,
+               unsigned long& value)
+   {
+      value = 0;
+      for (size_t size = 0; size < BinexData::UBNXI::MAX_BYTES; size++)
+      {
+         if (size >= len)
+         {
+            return 0;
+         }
+         unsigned char mask = (size < 3) ? 0x7f : 0xff;
+         unsigned char byte = static_cast<unsigned char>(buf[size]);
+         if (littleEndian)
+         {
+            value |= ((unsigned long)byte & mask) << (7 * size);
+         }
+         else
+         {
+            value <<= (size < 3) ? 7 : 8;
+            value |= ((unsigned long)byte & mask);
+         }
+         if ((byte & 0x80) != 0x80)
+         {
+            return size + 1;
+         }
+      }
+      return BinexData::UBNXI::MAX_BYTES;
+   }
+
+
+   // -------------------------------------------------------------------------
+   void BinexBlockReader ::
+   parseForward(BinexData::SyncByte expectedTail, BinexRecordView& view)
+   {
+      const size_t maxHeadLen = 1 + 2 * BinexData::UBNXI::MAX_BYTES;
+      size_t avail = fill(maxHeadLen);
+      const char *rec = &buffer[head];
+      BinexData::SyncByte sync = rec[0];
+      bool littleEndian = (sync & BinexData::eBigEndian) == 0;
+      unsigned long recID, msgLen;
+      size_t idLen = decodeUBNXI(rec+1, avail-1, littleEndian, recID);
+      size_t lenLen = 0;
+      if (idLen > 0)
+      {
+         lenLen = decodeUBNXI(rec+1+idLen, avail-1-idLen, littleEndian,
+                              msgLen);
+      }
+      if (lenLen == 0)
+      {
+         FFStreamError err("Incomplete BINEX record head");
+         GNSSTK_THROW(err);
+      }
+      if (recID > BinexData::UBNXI::MAX_VALUE)
+      {
+         FFStreamError err("BINEX record ID overflow");
+         GNSSTK_THROW(err);
+      }
+      size_t headLen = 1 + idLen + lenLen;
+         // Get everything but the CRC and reverse-readable trailer,
+         // plus as much of the tail as could possibly be present.
+      size_t bodyLen = headLen + msgLen;
+      avail = fill(bodyLen + 16 + BinexData::UBNXI::MAX_BYTES + 1);
+      if (avail < bodyLen)
+      {
+         FFStreamError err("Incomplete BINEX record message");
+         GNSSTK_THROW(err);
+      }
+      rec = &buffer[head];
+      crcBuf.clear();
+      BinexData::getCRC(sync, rec+1, headLen-1, rec+headLen, msgLen, crcBuf);
+      size_t crcLen = crcBuf.size();
+      if ((avail < bodyLen + crcLen) ||
+          memcmp(rec+bodyLen, crcBuf.data(), crcLen))
+      {
+         FFStreamError err("Bad BINEX CRC");
+         GNSSTK_THROW(err);
+      }
+      size_t recSize = bodyLen + crcLen;
+      if (sync & BinexData::eReverseReadable)
+      {
+            // The total record length is stored as a byte-reversed
+            // UBNXI followed by the tail synchronization byte.
+         BinexData::UBNXI expectedLen(recSize);
+         size_t revLen = expectedLen.getSize();
+         if (avail < recSize + revLen + 1)
+         {
+            FFStreamError err("Incomplete BINEX record tail");
+            GNSSTK_THROW(err);
+         }
+         char lenBytes[4];
+         std::reverse_copy(rec+recSize, rec+recSize+revLen, lenBytes);
+         unsigned long revRecSize;
+         if ((decodeUBNXI(lenBytes, revLen, littleEndian, revRecSize) !=
+              revLen) ||
+             (revRecSize != recSize))
+         {
+            FFStreamError err("Bad BINEX reverse record length");
+            GNSSTK_THROW(err);
+         }
+         recSize += revLen;
+         if ((BinexData::SyncByte)rec[recSize] != expectedTail)
+         {
+            FFStreamError err("BINEX head/tail synchronization byte mismatch");
+            GNSSTK_THROW(err);
+         }
+         recSize++;
+      }
+      view.syncByte = sync;
+      view.recID = recID;
+      view.message = rec + headLen;
+      view.messageLength = msgLen;
+      view.recordSize = recSize;
+   }
+
+
+   // -------------------------------------------------------------------------
+   void BinexBlockReader ::
+   parseReverse(BinexData::SyncByte expectedHead, BinexRecordView& view)
+   {
+      size_t avail = fill(1 + BinexData::UBNXI::MAX_BYTES);
+      bool littleEndian = (expectedHead & BinexData::eBigEndian) == 0;
+      unsigned long revRecSize;
+      size_t revLen = decodeUBNXI(&buffer[head+1], avail-1, littleEndian,
+                                  revRecSize);
+      if (revLen == 0)
+      {
+         FFStreamError err("Incomplete BINEX record tail");
+         GNSSTK_THROW(err);
+      }
+      size_t recSize = 1 + revLen + revRecSize;
+      if (fill(recSize) < recSize)
+      {
+         FFStreamError err("Incomplete BINEX record message");
+         GNSSTK_THROW(err);
+      }
+         // Restore forward byte order so the message is contiguous.
+      const char *revStart = &buffer[head + 1 + revLen];
+      revBuf.assign(revStart, revRecSize);
+      std::reverse(revBuf.begin(), revBuf.end());
+      const char *rec = revBuf.data();
+      if ((revRecSize == 0) || ((BinexData::SyncByte)rec[0] != expectedHead))
+      {
+         FFStreamError err("BINEX head/tail synchronization byte mismatch");
+         GNSSTK_THROW(err);
+      }
+      unsigned long recID, msgLen;
+      size_t idLen = decodeUBNXI(rec+1, revRecSize-1, littleEndian, recID);
+      size_t lenLen = 0;
+      if (idLen > 0)
+      {
+         lenLen = decodeUBNXI(rec+1+idLen, revRecSize-1-idLen, littleEndian,
+                              msgLen);
+      }
+      size_t headLen = 1 + idLen + lenLen;
+      if ((lenLen == 0) || (headLen + msgLen > revRecSize))
+      {
+         FFStreamError err("Incomplete BINEX record message");
+         GNSSTK_THROW(err);
+      }
+      if (recID > BinexData::UBNXI::MAX_VALUE)
+      {
+         FFStreamError err("BINEX record ID overflow");
+         GNSSTK_THROW(err);
+      }
+      crcBuf.clear();
+      BinexData::getCRC(expectedHead, rec+1, headLen-1, rec+headLen, msgLen,
+                        crcBuf);
+      size_t crcLen = crcBuf.size();
+      if ((headLen + msgLen + crcLen != revRecSize) ||
+          memcmp(rec+headLen+msgLen, crcBuf.data(), crcLen))
+      {
+         FFStreamError err("Bad BINEX CRC");
+         GNSSTK_THROW(err);
+      }
+      view.syncByte = expectedHead;
+      view.recID = recID;
+      view.message = rec + headLen;
+      view.messageLength = msgLen;
+      view.recordSize = recSize;
+   }
+
+} // namespace gnsstk
@@ -0,0 +1,241 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file BinexBlockReader.hpp
+ * Buffered, block-oriented reading of BINEX records.
+ */
+
+#ifndef GNSSTK_BINEXBLOCKREADER_HPP
+#define GNSSTK_BINEXBLOCKREADER_HPP
+
+#include <istream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "BinexData.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * A reference to a single BINEX record held in the buffer of a
+       * BinexBlockReader.  The message pointer is only valid until
+       * the reader that produced the view is advanced, so callers
+       * that need to keep a record must take ownership of it using
+       * copyTo() or toData().
+       */
+   class BinexRecordView
+   {
+   public:
+         /// Initialize to an empty, invalid record.
+      BinexRecordView()
+            : syncByte(0), recID(BinexData::INVALID_RECORD_ID),
+              message(nullptr), messageLength(0), recordSize(0),
+              streamOffset(0)
+      {}
+
+         /** Copy the referenced record into a BinexData object.
+          * @param[out] data The object to receive the record contents.
+          * @throw FFStreamError if the record ID is invalid. */
+      void copyTo(BinexData& data) const;
+
+         /** Get a BinexData object containing a copy of the
+          * referenced record.
+          * @throw FFStreamError if the record ID is invalid. */
+      BinexData toData() const
+      {
+         BinexData rv;
+         copyTo(rv);
+         return rv;
+      }
+
+      BinexData::SyncByte syncByte;   ///< Head synchronization byte.
+      BinexData::RecordID recID;      ///< Record ID.
+      const char *message;            ///< Start of the record message.
+      size_t messageLength;           ///< Number of bytes in message.
+      size_t recordSize;              ///< Total record size in the stream.
+         /// Offset of the record relative to where reading started.
+      unsigned long long streamOffset;
+   };
+
+
+      /**
+       * Read BINEX records from an input stream in large blocks.
+       *
+       * BinexData::getRecord() reads each field of a record with its
+       * own stream call.  This class instead pulls large blocks from
+       * the stream's buffer and parses records, including
+       * reverse-readable framing and CRC checks, directly from
+       * memory.  Unconsumed bytes are moved to the front of the
+       * buffer before each refill so that every record is contiguous
+       * and can be returned as a BinexRecordView without copying.
+       *
+       * @code
+       * BinexStream bs("file.bnx");
+       * BinexBlockReader reader(bs);
+       * for (const BinexRecordView& view : reader)
+       * {
+       *    if (view.recID == 0x7f)
+       *       records.push_back(view.toData());
+       * }
+       * @endcode
+       *
+       * @note Reading starts at the current position of the stream,
+       *   and since data is read ahead, the stream position after
+       *   using a BinexBlockReader is not the end of the last record
+       *   returned.
+       * @sa BinexData, BinexStream.
+       */
+   class BinexBlockReader
+   {
+   public:
+         /// Input iterator over the records of a BinexBlockReader.
+      class iterator
+      {
+      public:
+         typedef std::input_iterator_tag iterator_category;
+         typedef BinexRecordView value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const BinexRecordView* pointer;
+         typedef const BinexRecordView& reference;
+
+            /// Create an end iterator.
+         iterator()
+               : reader(nullptr)
+         {}
+            /** Create an iterator referencing the next record of rdr.
+             * @throw FFStreamError */
+         explicit iterator(BinexBlockReader* rdr)
+               : reader(rdr)
+         { ++(*this); }
+
+         reference operator*() const
+         { return view; }
+         pointer operator->() const
+         { return &view; }
+            /// Advance to the next record.  @throw FFStreamError
+         iterator& operator++()
+         {
+            if (!reader->next(view))
+               reader = nullptr;
+            return *this;
+         }
+         bool operator==(const iterator& right) const
+         { return reader == right.reader; }
+         bool operator!=(const iterator& right) const
+         { return reader != right.reader; }
+
+      private:
+         BinexBlockReader *reader;
+         BinexRecordView view;
+      };
+
+         /// Default number of bytes read from the stream at a time.
+      static const size_t DEFAULT_BLOCK_SIZE = 1048576;
+
+         /** Prepare to read BINEX records from a stream.
+          * @param[in] s The stream to read from, starting at its
+          *   current position.  The stream must remain valid for the
+          *   life of this object.
+          * @param[in] blockSize The number of bytes to read from the
+          *   stream at a time. */
+      BinexBlockReader(std::istream& s,
+                       size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+         /** Parse the next record from the buffer, refilling it from
+          * the stream as needed.  Any previously returned view is
+          * invalidated.
+          * @param[out] view The record that was read.
+          * @return true if a record was read, false at end of input.
+          * @throw FFStreamError if the record is malformed, truncated
+          *   or fails its CRC check. */
+      bool next(BinexRecordView& view);
+
+         /// Get the number of bytes of records parsed so far.
+      unsigned long long getOffset() const
+      { return consumed; }
+
+         /// Get an iterator at the next unread record.
+      iterator begin()
+      { return iterator(this); }
+         /// Get the end-of-input iterator.
+      iterator end()
+      { return iterator(); }
+
+   private:
+         /** Attempt to have at least need unparsed bytes in the buffer.
+          * @return the number of unparsed bytes available, which is
+          *   less than need only if the end of input was reached. */
+      size_t fill(size_t need);
+
+         /** Decode a UBNXI from raw bytes.
+          * @param[in] buf The bytes to decode.
+          * @param[in] len The number of bytes available in buf.
+          * @param[in] littleEndian Byte order of the encoded bytes.
+          * @param[out] value The decoded value.
+          * @return the number of bytes decoded or 0 if buf ended
+          *   before the end of the UBNXI. */
+      static size_t decodeUBNXI(const char *buf, size_t len,
+                                bool littleEndian, unsigned long& value);
+
+         /// Parse a record whose head sync byte is at the buffer start.
+      void parseForward(BinexData::SyncByte expectedTail,
+                        BinexRecordView& view);
+         /// Parse a byte-reversed record starting with its tail sync byte.
+      void parseReverse(BinexData::SyncByte expectedHead,
+                        BinexRecordView& view);
+
+      std::istream& strm;          ///< Stream being read.
+      std::vector<char> buffer;    ///< Block buffer.
+      size_t blockSize;            ///< Minimum number of bytes per read.
+      size_t head;                 ///< Index of first unparsed byte.
+      size_t tail;                 ///< Index past last valid byte.
+      bool atEnd;                  ///< True when the stream is exhausted.
+      unsigned long long consumed; ///< Total bytes parsed.
+      std::string crcBuf;          ///< Scratch space for computed CRCs.
+      std::string revBuf;          ///< Forward-ordered reversed record.
+   };
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_BINEXBLOCKREADER_HPP
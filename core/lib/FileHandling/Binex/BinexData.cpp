@@ -1365,9 +1365,9 @@ namespace gnsstk
                GNSSTK_THROW(err);
             }
             std::string revRecBuf( (char*)&revRecVec[0], revRecSize);
-            reverseBuffer(revRecBuf, revRecSize);
+            reverseBuffer(revRecBuf, 0, revRecSize);
 
-            if (revRecBuf[0] != expectedSyncByte)
+            if ((SyncByte)revRecBuf[0] != expectedSyncByte)
             {
                FFStreamError err("BINEX head/tail synchronization byte mismatch");
                GNSSTK_THROW(err);
@@ -1429,7 +1429,21 @@ namespace gnsstk
                      const std::string&  message,
                      std::string&        crc) const
    {
-      size_t crcDataLen = head.size() + message.size();
+      getCRC(syncByte, head.data(), head.size(), message.data(),
+             message.size(), crc);
+
+   }  // BinexData::getCRC()
+
+   // -------------------------------------------------------------------------
+   void
+   BinexData::getCRC(SyncByte     sync,
+                     const char   *head,
+                     size_t       headLen,
+                     const char   *message,
+                     size_t       msgLen,
+                     std::string& crc)
+   {
+      size_t crcDataLen = headLen + msgLen;
       size_t crcLen     = 0;
       unsigned long crcTmp = 0;
 
@@ -1440,18 +1454,18 @@ namespace gnsstk
       }
       else // (crcLen < 1048576)
       {
-         if (syncByte & eEnhancedCRC)
+         if (sync & eEnhancedCRC)
          {
             if (crcDataLen < 128)
             {
                   // Use 2-byte CRC (CRC16)
                BinUtils::CRCParam params(BinUtils::CRC16);
-               crcTmp = BinUtils::computeCRC((const unsigned char*)head.data(),
-                                             head.size(),
+               crcTmp = BinUtils::computeCRC((const unsigned char*)head,
+                                             headLen,
                                              params);
                params.initial = crcTmp;
-               crcTmp = BinUtils::computeCRC((const unsigned char*)message.data(),
-                                             message.size(),
+               crcTmp = BinUtils::computeCRC((const unsigned char*)message,
+                                             msgLen,
                                              params);
                crcLen = 2;
             }
@@ -1459,12 +1473,12 @@ namespace gnsstk
             {
                   // Use 4-byte CRC (CRC32)
                BinUtils::CRCParam params(BinUtils::CRC32);
-               crcTmp = BinUtils::computeCRC((const unsigned char*)head.data(),
-                                             head.size(),
+               crcTmp = BinUtils::computeCRC((const unsigned char*)head,
+                                             headLen,
                                              params);
                params.initial = crcTmp;
-               crcTmp = BinUtils::computeCRC((const unsigned char*)message.data(),
-                                             message.size(),
+               crcTmp = BinUtils::computeCRC((const unsigned char*)message,
+                                             msgLen,
                                              params);
                crcLen = 4;
             }
@@ -1476,13 +1490,13 @@ namespace gnsstk
                   // Use 1-byte checksum: 8-bit XOR of all bytes
                size_t b;
                const char *ptr;
-               ptr = head.data();
-               for (b = head.size(); b > 0 ; b--, ptr++)
+               ptr = head;
+               for (b = headLen; b > 0 ; b--, ptr++)
                {
                   crcTmp ^= *ptr;
                }
-               ptr = message.data();
-               for (b = message.size(); b > 0 ; b--, ptr++)
+               ptr = message;
+               for (b = msgLen; b > 0 ; b--, ptr++)
                {
                   crcTmp ^= *ptr;
                }
@@ -1492,12 +1506,12 @@ namespace gnsstk
             {
                   // Use 2-byte CRC (CRC16)
                BinUtils::CRCParam params(BinUtils::CRC16);
-               crcTmp = BinUtils::computeCRC((const unsigned char*)head.data(),
-                                             head.size(),
+               crcTmp = BinUtils::computeCRC((const unsigned char*)head,
+                                             headLen,
                                              params);
                params.initial = crcTmp;
-               crcTmp = BinUtils::computeCRC((const unsigned char*)message.data(),
-                                             message.size(),
+               crcTmp = BinUtils::computeCRC((const unsigned char*)message,
+                                             msgLen,
                                              params);
                crcLen = 2;
             }
@@ -1505,12 +1519,12 @@ namespace gnsstk
             {
                   // Use 4-byte CRC (CRC32)
                BinUtils::CRCParam params(BinUtils::CRC32);
-               crcTmp = BinUtils::computeCRC((const unsigned char*)head.data(),
-                                             head.size(),
+               crcTmp = BinUtils::computeCRC((const unsigned char*)head,
+                                             headLen,
                                              params);
                params.initial = crcTmp;
-               crcTmp = BinUtils::computeCRC((const unsigned char*)message.data(),
-                                             message.size(),
+               crcTmp = BinUtils::computeCRC((const unsigned char*)message,
+                                             msgLen,
                                              params);
                crcLen = 4;
             }
@@ -1573,7 +1587,7 @@ namespace gnsstk
    // -------------------------------------------------------------------------
    bool
    BinexData::isHeadSyncByteValid(SyncByte  headSync,
-                                  SyncByte& expectedTailSync) const
+                                  SyncByte& expectedTailSync)
    {
       switch (headSync)
       {
@@ -1609,7 +1623,7 @@ namespace gnsstk
    // -------------------------------------------------------------------------
    bool
    BinexData::isTailSyncByteValid(SyncByte  tailSync,
-                                  SyncByte& expectedHeadSync) const
+                                  SyncByte& expectedHeadSync)
    {
       switch (tailSync)
       {
@@ -1690,8 +1704,9 @@ namespace gnsstk
          FFStreamError err("Invalid offset reversing BINEX data buffer");
          GNSSTK_THROW(err);
       }
-      size_t back = (n == std::string::npos) ? buffer.size() - 1: offset + n;
-      if (back >= buffer.size() )
+         // back is one past the last byte to reverse
+      size_t back = (n == std::string::npos) ? buffer.size() : offset + n;
+      if (back > buffer.size() )
       {
          FFStreamError err("Invalid size reversing BINEX data buffer");
          GNSSTK_THROW(err);
@@ -916,6 +916,24 @@ namespace gnsstk
                   const std::string& message,
                   std::string&       crc) const;
 
+         /**
+          * Computes the CRC of a record given raw head and message bytes
+          * and the record's synchronization byte, without requiring the
+          * data to be copied into a BinexData object.
+          * @param sync    The synchronization byte of the record
+          * @param head    Record head bytes excluding the sync byte
+          * @param headLen Number of bytes in head
+          * @param message Record message bytes
+          * @param msgLen  Number of bytes in message
+          * @param crc     The buffer in which to store the CRC
+          */
+      static void getCRC(SyncByte    sync,
+                         const char  *head,
+                         size_t      headLen,
+                         const char  *message,
+                         size_t      msgLen,
+                         std::string& crc);
+
          /**
           * Returns the number of bytes required to store the record's CRC
           * based on the record's current contents.
@@ -927,17 +945,17 @@ namespace gnsstk
           * Determines whether the supplied head sync byte is valid an returns
           * an expected correosponding tail sync byte if appropriate.
           */
-      bool
+      static bool
       isHeadSyncByteValid(SyncByte  headSync,
-                          SyncByte& expectedTailSync) const;
+                          SyncByte& expectedTailSync);
 
          /**
           * Determines whether the supplied tail sync byte is valid an returns
           * an expected correosponding head sync byte.
           */
-      bool
+      static bool
       isTailSyncByteValid(SyncByte  tailSync,
-                          SyncByte& expectedHeadSync) const;
+                          SyncByte& expectedHeadSync);
          /**
           * Converts a raw sequence of bytes into an unsigned long long integer.
           *
@@ -954,6 +972,10 @@ namespace gnsstk
 
    private:
 
+         // Parses records directly from its buffer using the CRC and
+         // synchronization byte helpers above.
+      friend class BinexBlockReader;
+
       template <class T>
       static void reverseBytes(T& val);
 
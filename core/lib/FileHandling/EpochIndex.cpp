@@ -0,0 +1,375 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file EpochIndex.cpp
+ * Byte offsets of the epochs in SP3 and RINEX clock files
+ */
+
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include "EpochIndex.hpp"
+#include "CivilTime.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+      /// First line of a sidecar file, including the format version.
+   static const string sidecarMagic("GNSSTK EPOCH INDEX 2");
+
+
+   EpochIndex ::
+   EpochIndex()
+         : format(Format::Unknown), headerEnd(0), dataEnd(0), fileSize(0),
+           fileTime(0), sorted(true)
+   {
+   }
+
+
+   bool EpochIndex ::
+   open(const std::string& dataFile, const std::string& cacheDir)
+   {
+      bool cache = !cacheDir.empty();
+      if (cache && readSidecar(dataFile, cacheDir))
+         return true;
+      if (!build(dataFile))
+         return false;
+      if (cache)
+         writeSidecar(dataFile, cacheDir);
+      return true;
+   }
+
+
+   std::string EpochIndex ::
+   sidecarName(const std::string& dataFile, const std::string& cacheDir)
+   {
+      string::size_type pos = dataFile.find_last_of("/\\");
+      string base(pos == string::npos ? dataFile : dataFile.substr(pos+1));
+      string dir(cacheDir);
+      if (!dir.empty() && dir[dir.size()-1] != '/')
+         dir += '/';
+      return dir + base + ".epochidx";
+   }
+
+
+   bool EpochIndex ::
+   fileStat(const std::string& fn, std::streamoff& size, long& mtime)
+   {
+      struct stat sb;
+      if (::stat(fn.c_str(), &sb) != 0)
+         return false;
+      size = sb.st_size;
+      mtime = static_cast<long>(sb.st_mtime);
+      return true;
+   }
+
+
+      /** Decode the epoch time of an SP3 '*' record.
+       * @return false if the line isn't a valid epoch line. */
+   static bool sp3EpochTime(const string& line, CommonTime& t)
+   {
+      if (line.size() < 31)
+         return false;
+      try
+      {
+         CivilTime ct(StringUtils::asInt(line.substr(3,4)),
+                      StringUtils::asInt(line.substr(8,2)),
+                      StringUtils::asInt(line.substr(11,2)),
+                      StringUtils::asInt(line.substr(14,2)),
+                      StringUtils::asInt(line.substr(17,2)),
+                      StringUtils::asDouble(line.substr(20,11)),
+                      TimeSystem::Any);
+         t = ct.convertToCommonTime();
+      }
+      catch (Exception&)
+      {
+         return false;
+      }
+      return true;
+   }
+
+
+      /** Decode the epoch time of a RINEX clock data record.
+       * @return false if the line isn't a valid data line. */
+   static bool clkEpochTime(const string& line, CommonTime& t)
+   {
+      if (line.size() < 34 || !isupper(line[0]) || !isupper(line[1]))
+         return false;
+      try
+      {
+         CivilTime ct(StringUtils::asInt(line.substr(8,4)),
+                      StringUtils::asInt(line.substr(12,3)),
+                      StringUtils::asInt(line.substr(15,3)),
+                      StringUtils::asInt(line.substr(18,3)),
+                      StringUtils::asInt(line.substr(21,3)),
+                      StringUtils::asDouble(line.substr(24,10)),
+                      TimeSystem::Any);
+         t = ct.convertToCommonTime();
+      }
+      catch (Exception&)
+      {
+         return false;
+      }
+      return true;
+   }
+
+
+   bool EpochIndex ::
+   build(const std::string& dataFile)
+   {
+      format = Format::Unknown;
+      epochs.clear();
+      headerEnd = dataEnd = 0;
+      sorted = true;
+      if (!fileStat(dataFile, fileSize, fileTime))
+         return false;
+      ifstream in(dataFile.c_str(), ios::in | ios::binary);
+      if (!in)
+         return false;
+      string line;
+      std::streamoff pos = 0, next;
+      if (!getline(in, line))
+         return false;
+      next = pos + line.size() + 1;
+         // Lines are scanned with a trailing CR removed so that DOS
+         // line endings don't change the column positions.
+      StringUtils::stripTrailing(line, '\r', 1);
+      if (!line.empty() && line[0] == '#')
+      {
+         format = Format::SP3;
+      }
+      else if ((line.size() > 60) &&
+               (line.substr(60,20) == "RINEX VERSION / TYPE") &&
+               (line[20] == 'C'))
+      {
+         format = Format::RinexClock;
+      }
+      else
+      {
+         return false;
+      }
+      bool inHeader = true;
+      CommonTime t, prev;
+      Epoch ep;
+      for (pos = next; getline(in, line); pos = next)
+      {
+         next = pos + line.size() + 1;
+         StringUtils::stripTrailing(line, '\r', 1);
+         if (format == Format::SP3)
+         {
+            if (line.compare(0,3,"EOF") == 0)
+            {
+               if (inHeader)
+                  headerEnd = pos;
+               dataEnd = pos;
+               break;
+            }
+            if (line.empty() || line[0] != '*')
+               continue;
+            if (inHeader)
+            {
+               headerEnd = pos;
+               inHeader = false;
+            }
+            if (!sp3EpochTime(line, t))
+               continue;
+         }
+         else
+         {
+            if (inHeader)
+            {
+               if ((line.size() > 60) &&
+                   (line.compare(60,13,"END OF HEADER") == 0))
+               {
+                  headerEnd = next;
+                  inHeader = false;
+               }
+               continue;
+            }
+               // All records of an epoch share a time stamp, so an
+               // epoch starts wherever the time stamp changes.
+            if (!clkEpochTime(line, t) ||
+                (!epochs.empty() && t == epochs.back().time))
+               continue;
+         }
+         if (!epochs.empty() && t < epochs.back().time)
+            sorted = false;
+         ep.time = t;
+         ep.offset = pos;
+         epochs.push_back(ep);
+      }
+      if (inHeader)
+      {
+         if (format == Format::RinexClock)
+         {
+               // no END OF HEADER
+            format = Format::Unknown;
+            epochs.clear();
+            return false;
+         }
+         headerEnd = pos;
+      }
+      if (dataEnd == 0)
+         dataEnd = fileSize;
+      return true;
+   }
+
+
+   bool EpochIndex ::
+   readSidecar(const std::string& dataFile, const std::string& cacheDir)
+   {
+      std::streamoff size;
+      long mtime;
+      if (!fileStat(dataFile, size, mtime))
+         return false;
+      ifstream in(sidecarName(dataFile, cacheDir).c_str());
+      string line;
+      if (!getline(in, line) || line != sidecarMagic)
+         return false;
+      if (!getline(in, line) || line != dataFile)
+         return false;
+      int fmt;
+      size_t count;
+      in >> fmt >> fileSize >> fileTime >> headerEnd >> dataEnd >> sorted
+         >> count;
+      if (!in || fileSize != size || fileTime != mtime ||
+          fmt <= static_cast<int>(Format::Unknown) ||
+          fmt > static_cast<int>(Format::RinexClock))
+         return false;
+      format = static_cast<Format>(fmt);
+      epochs.resize(count);
+      long day, sod;
+      double fsod;
+      for (size_t i = 0; i < count; i++)
+      {
+         in >> epochs[i].offset >> day >> sod >> fsod;
+         if (!in)
+         {
+            epochs.clear();
+            format = Format::Unknown;
+            return false;
+         }
+         epochs[i].time.set(day, sod, fsod, TimeSystem::Any);
+      }
+      return true;
+   }
+
+
+   bool EpochIndex ::
+   writeSidecar(const std::string& dataFile,
+                const std::string& cacheDir) const
+   {
+         // Write to a temporary and rename so that a concurrent
+         // reader never sees a partial index.
+      string fn(sidecarName(dataFile, cacheDir)), tmp(fn + ".tmp");
+      {
+         ofstream out(tmp.c_str());
+         if (!out)
+            return false;
+         out << sidecarMagic << endl
+             << dataFile << endl
+             << static_cast<int>(format) << " " << fileSize << " "
+             << fileTime << " " << headerEnd << " " << dataEnd << " "
+             << sorted << " " << epochs.size() << endl
+             << setprecision(17);
+         long day, sod;
+         double fsod;
+         for (const auto& ep : epochs)
+         {
+            ep.time.get(day, sod, fsod);
+            out << ep.offset << " " << day << " " << sod << " " << fsod
+                << "\n";
+         }
+         if (!out)
+         {
+            out.close();
+            std::remove(tmp.c_str());
+            return false;
+         }
+      }
+      if (std::rename(tmp.c_str(), fn.c_str()) != 0)
+      {
+         std::remove(tmp.c_str());
+         return false;
+      }
+      return true;
+   }
+
+
+   size_t EpochIndex ::
+   upperBound(const CommonTime& t) const
+   {
+      CommonTime tt(t);
+      tt.setTimeSystem(TimeSystem::Any);
+      auto it = std::upper_bound(epochs.begin(), epochs.end(), tt,
+                                 [](const CommonTime& a, const Epoch& b)
+                                 { return a < b.time; });
+      return it - epochs.begin();
+   }
+
+
+   std::streamoff EpochIndex ::
+   endOffset(size_t i) const
+   {
+      if (i+1 < epochs.size())
+         return epochs[i+1].offset;
+      return dataEnd;
+   }
+
+
+   void EpochIndex ::
+   dump(std::ostream& s) const
+   {
+      static const char *fmtNames[] = { "Unknown", "SP3", "RinexClock" };
+      s << "EpochIndex format=" << fmtNames[static_cast<int>(format)]
+        << " size=" << fileSize << " headerEnd=" << headerEnd
+        << " dataEnd=" << dataEnd << " sorted=" << sorted
+        << " epochs=" << epochs.size() << endl;
+      for (const auto& ep : epochs)
+      {
+         s << "  " << setw(10) << ep.offset << " " << ep.time << endl;
+      }
+   }
+
+} // namespace gnsstk
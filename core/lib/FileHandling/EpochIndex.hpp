@@ -0,0 +1,167 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file EpochIndex.hpp
+ * Byte offsets of the epochs in SP3 and RINEX clock files
+ */
+
+#ifndef GNSSTK_EPOCHINDEX_HPP
+#define GNSSTK_EPOCHINDEX_HPP
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "CommonTime.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /** An index of the epochs in an SP3 or RINEX clock file,
+       * recording the byte offset where each epoch's records begin,
+       * so that a subset of the epochs can be read by seeking rather
+       * than parsing the file from the start.
+       *
+       * Building the index only scans the file for epoch lines (SP3
+       * '*' records, or the time stamp of RINEX clock data records);
+       * no records are decoded.  The index can optionally be cached
+       * in a "sidecar" file in a directory chosen by the caller (see
+       * sidecarName()), which is used as long as the name, size and
+       * modification time of the data file are unchanged.  Nothing
+       * is written unless a cache directory is given.
+       *
+       * Epoch times are stored in TimeSystem::Any; the time system
+       * comes from the file header.
+       */
+   class EpochIndex
+   {
+   public:
+         /// Supported data file formats.
+      enum class Format
+      {
+         Unknown,    ///< Not indexed.
+         SP3,        ///< SP3 (a, b, c or d).
+         RinexClock  ///< RINEX clock (2 or 3).
+      };
+
+         /// One entry in the index.
+      struct Epoch
+      {
+         CommonTime time;       ///< Time of the epoch.
+         std::streamoff offset; ///< Offset of the epoch's first line.
+      };
+
+      EpochIndex();
+
+         /** Index the given file, using the sidecar if it's current.
+          * @param[in] dataFile The SP3 or RINEX clock file to index.
+          * @param[in] cacheDir If not empty, the directory in which
+          *   to read the sidecar if it's current, and write it if
+          *   the file had to be scanned.  This may be the directory
+          *   of the data file.  Failure to write the sidecar
+          *   (e.g. a read-only directory) is not an error.
+          * @return true if the file was indexed. */
+      bool open(const std::string& dataFile,
+                const std::string& cacheDir = std::string());
+
+         /** Scan a data file to build the index.
+          * @return true if the file is SP3 or RINEX clock. */
+      bool build(const std::string& dataFile);
+
+         /** Read the index from the sidecar of \a dataFile in
+          * \a cacheDir.
+          * @return false if there is no sidecar or it doesn't match
+          *   the current data file. */
+      bool readSidecar(const std::string& dataFile,
+                       const std::string& cacheDir);
+
+         /** Write the index to the sidecar of \a dataFile in
+          * \a cacheDir.
+          * @return true on success. */
+      bool writeSidecar(const std::string& dataFile,
+                        const std::string& cacheDir) const;
+
+         /** Return the name of the sidecar file for \a dataFile in
+          * \a cacheDir, which is the base name of the data file
+          * with ".epochidx" appended.  Data files of the same name
+          * in different directories share a sidecar; the data file
+          * name recorded in it decides which one it's for. */
+      static std::string sidecarName(const std::string& dataFile,
+                                     const std::string& cacheDir);
+
+         /** Return the index of the first epoch after \a t, or
+          * epochs.size() if there is none.  Only meaningful if
+          * #sorted is true. */
+      size_t upperBound(const CommonTime& t) const;
+
+         /** Return the offset of the end of epoch \a i, i.e. the
+          * start of the next epoch or the end of the data. */
+      std::streamoff endOffset(size_t i) const;
+
+         /// Write the index in human-readable form.
+      void dump(std::ostream& s) const;
+
+         /// The format of the indexed file.
+      Format format;
+         /// Epochs in file order.
+      std::vector<Epoch> epochs;
+         /// Offset of the first line after the header.
+      std::streamoff headerEnd;
+         /// Offset of the end of the data (the "EOF" line for SP3).
+      std::streamoff dataEnd;
+         /// Size of the data file when indexed.
+      std::streamoff fileSize;
+         /// Modification time of the data file when indexed.
+      long fileTime;
+         /// true if the epochs are in increasing time order.
+      bool sorted;
+
+   private:
+         /// Get the size and modification time of a file.
+      static bool fileStat(const std::string& fn, std::streamoff& size,
+                           long& mtime);
+   }; // class EpochIndex
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_EPOCHINDEX_HPP
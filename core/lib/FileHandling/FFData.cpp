@@ -56,6 +56,11 @@ namespace gnsstk
       s.tryFFStreamGet(*this);
    }
 
+   FFStreamStatus FFData::tryGetRecord(FFStream& s)
+   {
+      return s.tryFFStreamRead(*this);
+   }
+
    std::ostream& operator<<(FFStream& o, const FFData& f)
    {
       f.putRecord(o);
@@ -58,6 +58,14 @@ namespace gnsstk
       /// Forward declaration of FFStream class and friend functions
    class FFStream;
 
+      /// Outcome of FFData::tryGetRecord().
+   enum class FFStreamStatus
+   {
+      OK,        ///< A record was read.
+      EndOfFile, ///< No record was read because the stream is exhausted.
+      Error      ///< No record was read; see FFStream::mostRecentException.
+   };
+
       /**
        * This is the base class for all Formatted File Data (FFData).
        * The data in FFStream objects are read/written into classes derived
@@ -114,6 +122,25 @@ namespace gnsstk
           */
       void getRecord(FFStream& s);
 
+         /**
+          * Retrieve a "record" from the given stream, reporting the
+          * outcome rather than throwing.  The stream state and
+          * position are left as getRecord() leaves them, but no
+          * exception is thrown regardless of the stream's
+          * exceptions() setting, and the normal end of a file is
+          * found without the reader throwing internally.
+          * @note With stream exceptions disabled (the default) a
+          *   read error is only reported, never thrown.  With them
+          *   enabled the library still uses exceptions internally.
+          * @param s a FFStream-based stream
+          * @return FFStreamStatus::OK if a record was read,
+          *   FFStreamStatus::EndOfFile if there are no more records,
+          *   or FFStreamStatus::Error if the record could not be
+          *   read, in which case s.mostRecentException holds the
+          *   details and the stream is back at its pre-read position.
+          */
+      FFStreamStatus tryGetRecord(FFStream& s);
+
          /**
           * Send debug output to the given stream.
           * @param s a generic output stream
@@ -159,7 +159,29 @@ namespace gnsstk
    }  // End of method 'FFStream::dumpState()'
 
 
-   void FFStream::tryFFStreamGet(FFData& rec)
+   void FFStream ::
+   tryFFStreamGet(FFData& rec)
+   {
+      getRecord(rec, true);
+   }
+
+
+   FFStreamStatus FFStream ::
+   tryFFStreamRead(FFData& rec)
+   {
+      return getRecord(rec, false);
+   }
+
+
+   bool FFStream ::
+   atEndOfData()
+   {
+      return (rdbuf()->sgetc() == std::char_traits<char>::eof());
+   }
+
+
+   FFStreamStatus FFStream ::
+   getRecord(FFData& rec, bool throwErrors)
    {
          // JMK 2015/12/07 - some implementations of streams will
          // raise exceptions in tellg if eofbit is set but not
@@ -168,9 +190,31 @@ namespace gnsstk
          // fail until the failbit is set.
       if (rdstate() == std::ios::eofbit)
          clear(); // clear ONLY if eofbit is the only state flag set
+
+         // Normal end of file is otherwise found by the reader
+         // throwing EndOfFile, which is costly when reading many
+         // small files.  Headers are exempt as they may be "read"
+         // from a stream that has already consumed them.
+      if (rec.isData() && (recordNumber > 0) && atEndOfData())
+      {
+         mostRecentException = EndOfFile("EOF encountered");
+         mostRecentException.addText("In file " + filename);
+         try
+         {
+            setstate(std::ios::eofbit | std::ios::failbit);
+         }
+         catch (std::ios::failure&)
+         {
+               // Exceptions are enabled, but as with EndOfFile from
+               // the reader, EOF only sets the stream state.
+         }
+         return FFStreamStatus::EndOfFile;
+      }
+
          // Mark where we start in case there is an error.
       long initialPosition = tellg();
       unsigned long initialRecordNumber = recordNumber;
+      bool gotEOF = false;
       clear();
 
       try
@@ -189,6 +233,7 @@ namespace gnsstk
             e.addText("In file " + filename);
             e.addLocation(FILE_LOCATION);
             mostRecentException = e;
+            gotEOF = true;
          }
          catch (std::exception &e)
          {
@@ -202,7 +247,9 @@ namespace gnsstk
             seekg(initialPosition);
             recordNumber = initialRecordNumber;
             setstate(std::ios::failbit);
-            conditionalThrow();
+            if (throwErrors)
+               conditionalThrow();
+            return FFStreamStatus::Error;
          }
          catch (gnsstk::StringUtils::StringException& e)
          {
@@ -215,7 +262,9 @@ namespace gnsstk
             seekg(initialPosition);
             recordNumber = initialRecordNumber;
             setstate(std::ios::failbit);
-            conditionalThrow();
+            if (throwErrors)
+               conditionalThrow();
+            return FFStreamStatus::Error;
          }
             // catches some errors we can encounter
          catch (FFStreamError& e)
@@ -229,8 +278,9 @@ namespace gnsstk
             seekg(initialPosition);
             recordNumber = initialRecordNumber;
             setstate(std::ios::failbit);
-            conditionalThrow();
-
+            if (throwErrors)
+               conditionalThrow();
+            return FFStreamStatus::Error;
          }
       }
          // this is if you throw an FFStream error in the above catch
@@ -238,7 +288,24 @@ namespace gnsstk
          // This also takes care of catching StringExceptions
       catch (gnsstk::Exception &e)
       {
-         GNSSTK_RETHROW(e);
+         if (throwErrors)
+         {
+            GNSSTK_RETHROW(e);
+         }
+            // any other exception from the reader
+         mostRecentException = e;
+         mostRecentException.addText("In file " + filename);
+         try
+         {
+            clear();
+            seekg(initialPosition);
+            recordNumber = initialRecordNumber;
+            setstate(std::ios::failbit);
+         }
+         catch (std::ios::failure&)
+         {
+         }
+         return FFStreamStatus::Error;
       }
       catch (std::ifstream::failure &e)
       {
@@ -253,7 +320,9 @@ namespace gnsstk
             mostRecentException.addText("In file " + filename);
             mostRecentException.addLocation(FILE_LOCATION);
          }
-         conditionalThrow();
+         if (throwErrors)
+            conditionalThrow();
+         return FFStreamStatus::Error;
       }
       catch (std::exception &e)
       {
@@ -262,7 +331,9 @@ namespace gnsstk
          mostRecentException.addText("In file " + filename);
          mostRecentException.addLocation(FILE_LOCATION);
          setstate(std::ios::failbit);
-         conditionalThrow();
+         if (throwErrors)
+            conditionalThrow();
+         return FFStreamStatus::Error;
       }
       catch (...)
       {
@@ -270,10 +341,17 @@ namespace gnsstk
          mostRecentException.addText("In file " + filename);
          mostRecentException.addLocation(FILE_LOCATION);
          setstate(std::ios::failbit);
-         conditionalThrow();
+         if (throwErrors)
+            conditionalThrow();
+         return FFStreamStatus::Error;
       }
 
-   }  // End of method 'FFStream::tryFFStreamGet()'
+      if (gotEOF)
+         return FFStreamStatus::EndOfFile;
+      if (!fail())
+         return FFStreamStatus::OK;
+      return (eof() ? FFStreamStatus::EndOfFile : FFStreamStatus::Error);
+   }  // End of method 'FFStream::getRecord()'
 
 
 
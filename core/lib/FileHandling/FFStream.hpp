@@ -192,6 +192,19 @@ namespace gnsstk
           */
       virtual void tryFFStreamGet(FFData& rec);
 
+         /** Read a record as tryFFStreamGet() does, but report
+          * errors through the return value and mostRecentException
+          * rather than by throwing.
+          * @return the outcome of the read. */
+      virtual FFStreamStatus tryFFStreamRead(FFData& rec);
+
+         /** Return true if no record can be read because the end of
+          * the stream has been reached.  Used to detect the normal
+          * end of file without relying on the reader throwing
+          * EndOfFile.  Streams that hold data read ahead of the
+          * current record must override this. */
+      virtual bool atEndOfData();
+
 
          /** Encapsulates shared try/catch blocks for all file types
           * to hide std::exception.
@@ -201,6 +214,16 @@ namespace gnsstk
       virtual void tryFFStreamPut(const FFData& rec);
 
    private:
+         /** Common implementation of tryFFStreamGet() and
+          * tryFFStreamRead().
+          * @param[in] throwErrors If true, call conditionalThrow()
+          *   on errors and let exceptions other than FFStreamError,
+          *   StringException and EndOfFile from the reader propagate.
+          * @throw FFStreamError
+          * @throw StringUtils::StringException
+          */
+      FFStreamStatus getRecord(FFData& rec, bool throwErrors);
+
          /// Initialize internal data structures according to file name & mode
       void init(const char* fn, std::ios::openmode mode);
 
@@ -120,6 +120,21 @@ namespace gnsstk
    }
 
 
+   FFStreamStatus FFTextStream ::
+   tryFFStreamRead(FFData& rec)
+   {
+      unsigned int initialLineNumber = lineNumber;
+      FFStreamStatus rv = FFStream::tryFFStreamRead(rec);
+      if (rv == FFStreamStatus::Error)
+      {
+         mostRecentException.addText( std::string("Near file line ") +
+                                      gnsstk::StringUtils::asString(lineNumber) );
+         lineNumber = initialLineNumber;
+      }
+      return rv;
+   }
+
+
    void FFTextStream ::
    tryFFStreamPut(const FFData& rec)
    {
@@ -127,6 +127,9 @@ namespace gnsstk
           */
       virtual void tryFFStreamGet(FFData& rec);
 
+         /// calls FFStream::tryFFStreamRead and adds line number information
+      virtual FFStreamStatus tryFFStreamRead(FFData& rec);
+
          /** calls FFStream::tryFFStreamPut and adds line number information
           * @throw FFStreamError
           * @throw StringUtils::StringException
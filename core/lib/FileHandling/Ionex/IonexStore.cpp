@@ -106,7 +106,8 @@ namespace gnsstk
 
             // object data. If valid, add to the map
          IonexData iod;
-         while ( strm >> iod && iod.isValid() )
+         while ( (iod.tryGetRecord(strm) == FFStreamStatus::OK) &&
+                 iod.isValid() )
          {
             addMap(iod);
          }
@@ -79,7 +79,7 @@ namespace gnsstk
       }
 
       RinexMetData rmd;
-      while (rms >> rmd)
+      while (rmd.tryGetRecord(rms) == FFStreamStatus::OK)
       {
          WxObservation wob(
             rmd.time,
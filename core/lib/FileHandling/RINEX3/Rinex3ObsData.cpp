@@ -73,19 +73,19 @@ namespace gnsstk
       {
          CivilTime civTime(rod.time);
          line  = string(1, ' ');
-         line += rightJustify(asString<short>(civTime.year),2);
-         line += string(1, ' ');
-         line += rightJustify(asString<short>(civTime.month),2);
-         line += string(1, ' ');
-         line += rightJustify(asString<short>(civTime.day),2);
-         line += string(1, ' ');
-         line += rightJustify(asString<short>(civTime.hour),2);
-         line += string(1, ' ');
-         line += rightJustify(asString<short>(civTime.minute),2);
-         line += rightJustify(asString(civTime.second, 7),11);
-         line += string(2, ' ');
-         line += rightJustify(asString<short>(rod.epochFlag), 1);
-         line += rightJustify(asString<short>(rod.numSVs), 3);
+         appendInt(line, static_cast<short>(civTime.year), 2);
+         line += ' ';
+         appendInt(line, static_cast<short>(civTime.month), 2);
+         line += ' ';
+         appendInt(line, static_cast<short>(civTime.day), 2);
+         line += ' ';
+         appendInt(line, static_cast<short>(civTime.hour), 2);
+         line += ' ';
+         appendInt(line, static_cast<short>(civTime.minute), 2);
+         appendFixed(line, civTime.second, 7, 11);
+         line.append(2, ' ');
+         appendInt(line, rod.epochFlag, 1);
+         appendInt(line, rod.numSVs, 3);
       }
 
          // write satellite ids to 'line'
@@ -107,7 +107,7 @@ namespace gnsstk
          if( rod.clockOffset != 0.0 )
          {
             line += string(68 - line.size(), ' ');
-            line += rightJustify( asString(rod.clockOffset, 9), 12 );
+            appendFixed(line, rod.clockOffset, 9, 12);
          }
 
             // continuation lines
@@ -115,7 +115,7 @@ namespace gnsstk
          {
             if((satsWritten % maxPrnsPerLine) == 0)
             {
-               strm << line << endl;
+               strm << line << '\n';
                strm.lineNumber++;
                line  = string(32, ' ');
             }
@@ -127,7 +127,7 @@ namespace gnsstk
       }  // End of 'if( rod.epochFlag==0 || rod.epochFlag==1 || ...'
 
          // write the epoch line
-      strm << line << endl;
+      strm << line << '\n';
       strm.lineNumber++;
          // write the auxiliary header records, if any
       if( rod.epochFlag >= 2 && rod.epochFlag <= 5 )
@@ -183,7 +183,7 @@ namespace gnsstk
                   // need a continuation line?
                if( obsWritten != 0 && (obsWritten % maxObsPerLine) == 0 )
                {
-                  strm << line << endl;
+                  strm << line << '\n';
                   strm.lineNumber++;
                   line = string("");
                }
@@ -192,17 +192,17 @@ namespace gnsstk
                if (ind == -1)
                {
                   RinexDatum empty;
-                  line += empty.asString();
+                  empty.appendTo(line);
                }
                else
                {
-                  line += itr->second[ind].asString();
+                  itr->second[ind].appendTo(line);
                }
                obsWritten++;
 
             }  // End of 'for( i=0; i<strm.header.R2ObsTypes.size(); i++ )'
 
-            strm << line << endl;
+            strm << line << '\n';
             strm.lineNumber++;
 
          }  // End of 'for( itr = rod.obs.begin(); itr != rod.obs.end();...'
@@ -330,21 +330,24 @@ namespace gnsstk
          return;
       }
 
-      string line;
+         // The record is built in one buffer and handed to the stream
+         // with a single write, rather than formatting each field
+         // through temporary strings and flushing each line.
+      string buf;
+      size_t numLines = 1;
+      size_t numObs = obs.empty() ? 0 : obs.begin()->second.size();
+      buf.reserve(64 + obs.size() * (4 + 16 * numObs));
 
          // first the epoch line
-      line  = ">";
-      line += writeTime(time);
-      line += string(2, ' ');
-      line += rightJustify(asString<short>(epochFlag), 1);
-      line += rightJustify(asString<short>(numSVs   ), 3);
-      line += string(6, ' ');
+      buf  = ">";
+      buf += writeTime(time);
+      buf.append(2, ' ');
+      appendInt(buf, epochFlag, 1);
+      appendInt(buf, numSVs, 3);
+      buf.append(6, ' ');
       if(clockOffset != 0.0) // optional data; need to test for its existence
-         line += rightJustify(asString(clockOffset, 12), 15);
-
-      strm << line << endl;
-      strm.lineNumber++;
-      line.erase();
+         appendFixed(buf, clockOffset, 12, 15);
+      buf += '\n';
 
       if(epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
       {
@@ -352,23 +355,24 @@ namespace gnsstk
 
          while(itr != obs.end())
          {
-            line = itr->first.toString();
+            buf += itr->first.toString();
 
             for(size_t i=0; i < itr->second.size(); i++)
             {
-               line += itr->second[i].asString();
+               itr->second[i].appendTo(buf);
             }
-               // write the data line out
-            strm << line << endl;
-            strm.lineNumber++;
-            line.erase();
+            buf += '\n';
+            numLines++;
 
             itr++;
          } // end loop over sats and data
       }
 
+      strm.write(buf.data(), buf.size());
+      strm.lineNumber += numLines;
+
          // write the auxiliary header records, if any
-      else if(epochFlag >= 2 && epochFlag <= 5)
+      if(epochFlag >= 2 && epochFlag <= 5)
       {
          try
          {
@@ -804,18 +808,19 @@ namespace gnsstk
 
       CivilTime civtime(ct);
       string line;
-
-      line  = string(1, ' ');
-      line += rightJustify(asString<short>(civtime.year    ), 4);
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(civtime.month   ), 2, '0');
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(civtime.day     ), 2, '0');
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(civtime.hour    ), 2, '0');
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(civtime.minute  ), 2, '0');
-      line += rightJustify(asString       (civtime.second,7),11);
+      line.reserve(26);
+
+      line.assign(1, ' ');
+      appendInt(line, static_cast<short>(civtime.year), 4);
+      line += ' ';
+      appendInt(line, static_cast<short>(civtime.month), 2, '0');
+      line += ' ';
+      appendInt(line, static_cast<short>(civtime.day), 2, '0');
+      line += ' ';
+      appendInt(line, static_cast<short>(civtime.hour), 2, '0');
+      line += ' ';
+      appendInt(line, static_cast<short>(civtime.minute), 2, '0');
+      appendFixed(line, civtime.second, 7, 11);
 
       return line;
    }  // end writeTime
@@ -107,34 +107,40 @@ namespace gnsstk
    asString() const
    {
       std::string rv;
-      using gnsstk::StringUtils::rightJustify;
+      rv.reserve(16);
+      appendTo(rv);
+      return rv;
+   } // asString() const
 
+
+   void RinexDatum ::
+   appendTo(std::string& s) const
+   {
       if (!dataBlank)
       {
             // double 14.3
-         rv += rightJustify(gnsstk::StringUtils::asString(data, 3), 14);
+         gnsstk::StringUtils::appendFixed(s, data, 3, 14);
       }
       else
       {
-         rv += std::string(14, ' ');
+         s.append(14, ' ');
       }
       if ((lli != 0) || !lliBlank)
       {
-         rv += rightJustify(gnsstk::StringUtils::asString<short>(lli),1);
+         gnsstk::StringUtils::appendInt(s, lli, 1);
       }
       else
       {
-         rv += " ";
+         s += ' ';
       }
       if ((ssi != 0) || !ssiBlank)
       {
-         rv += rightJustify(gnsstk::StringUtils::asString<short>(ssi),1);
+         gnsstk::StringUtils::appendInt(s, ssi, 1);
       }
       else
       {
-         rv += " ";
+         s += ' ';
       }
-      return rv;
-   } // asString() const
+   } // appendTo()
 
 } // namespace gnsstk
@@ -73,6 +73,12 @@ namespace gnsstk
          /// Turn this datum into a RINEX OBS formatted string
       std::string asString() const;
 
+         /** Append this datum, RINEX OBS formatted, to a string.
+          * This produces the same text as asString() without
+          * creating any temporary strings.
+          * @param[in,out] s The string to append to. */
+      void appendTo(std::string& s) const;
+
       double data;    ///< The actual data point.
       bool dataBlank; ///< True if the data is blank in the file
       short lli;      ///< See the RINEX Spec. for an explanation.
@@ -99,6 +99,13 @@ namespace gnsstk
    }
 
 
+   bool SP3Stream :: atEndOfData()
+   {
+      return ((lastLine.compare(0, 3, "EOF") == 0) &&
+              FFTextStream::atEndOfData());
+   }
+
+
    void SP3Stream :: init(std::ios::openmode mode)
    {
       header = SP3Header();
@@ -92,6 +92,10 @@ namespace gnsstk
       std::string lastLine;      ///< Last line read, perhaps not yet processed
       std::vector<std::string> warnings; ///< warnings produced by reallyGetRecord()s
 
+   protected:
+         /// End of data only once lastLine holds nothing but the EOF line.
+      virtual bool atEndOfData();
+
    private:
          /// Initialize internal data structures according to file mode
       void init(std::ios::openmode);
@@ -0,0 +1,221 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file AntennaPCVGrid.cpp
+    Phase center offset and variation of one antenna at one frequency,
+    compiled from AntexData into a regular grid for fast lookup. */
+
+#include "AntennaPCVGrid.hpp"
+#include "GNSSconstants.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+      /* Return the spacing of the (sorted) values in v, throwing if they
+         are not evenly spaced. */
+   static double regularStep(const vector<double>& v, const string& what)
+   {
+      if (v.size() < 2)
+      {
+         return 0.0;
+      }
+      double step = (v.back() - v.front()) / (v.size() - 1);
+      for (size_t i = 1; i < v.size(); i++)
+      {
+         if (::fabs(v[i] - v[0] - i * step) > 1.e-6 * step)
+         {
+            Exception e("PCVs are not on a regular grid in " + what);
+            GNSSTK_THROW(e);
+         }
+      }
+      return step;
+   }
+
+   AntennaPCVGrid::AntennaPCVGrid(const AntexData& antdata, const string& freq)
+         : frequency(freq), isRxAntenna(antdata.isRxAntenna), nAzim(0),
+           nZen(0), azim0(0.0), azimStep(0.0), invAzimStep(0.0), zen0(0.0),
+           zenStep(0.0), invZenStep(0.0)
+   {
+      if (!antdata.isValid())
+      {
+         Exception e("Invalid AntexData object");
+         GNSSTK_THROW(e);
+      }
+      map<string, AntexData::antennaPCOandPCVData>::const_iterator it =
+         antdata.freqPCVmap.find(freq);
+      if (it == antdata.freqPCVmap.end())
+      {
+         Exception e("Frequency " + freq +
+                     " not found! System not supported or data corrupted.");
+         GNSSTK_THROW(e);
+      }
+      const AntexData::antennaPCOandPCVData& antpco = it->second;
+      for (int i = 0; i < 3; i++)
+         pco[i] = antpco.PCOvalue[i];
+
+         /* collect the rows: the NOAZI row (azimuth -1) alone, or the azimuth
+            rows, which ignore the NOAZI row just as the map lookup does */
+      const AntexData::azimZenMap& azzenmap = antpco.PCVvalue;
+      vector<const AntexData::zenOffsetMap*> rows;
+      vector<double> azims;
+      AntexData::azimZenMap::const_iterator jt;
+      for (jt = azzenmap.begin(); jt != azzenmap.end(); ++jt)
+      {
+         if (!antpco.hasAzimuth)
+         {
+            rows.push_back(&jt->second);
+            break;
+         }
+         if (jt->first >= 0.0)
+         {
+            rows.push_back(&jt->second);
+            azims.push_back(jt->first);
+         }
+      }
+      if (rows.empty() || rows[0]->empty())
+      {
+         Exception e("No PCVs for frequency " + freq);
+         GNSSTK_THROW(e);
+      }
+
+         // zenith angles, which must be the same in every row
+      vector<double> zens;
+      AntexData::zenOffsetMap::const_iterator kt;
+      for (kt = rows[0]->begin(); kt != rows[0]->end(); ++kt)
+         zens.push_back(kt->first);
+      zenStep = regularStep(zens, "zenith angle");
+      zen0 = zens[0];
+      invZenStep = (zenStep > 0.0 ? 1.0 / zenStep : 0.0);
+      nZen = zens.size();
+
+      if (azims.size() > 1)
+      {
+         azimStep = regularStep(azims, "azimuth");
+         azim0 = azims[0];
+            // rows must cover a full turn; add the first row again at +360
+            // if the table stops one step short of it
+         double span = azims.back() - azim0;
+         if (::fabs(span + azimStep - 360.0) < 1.e-6)
+         {
+            rows.push_back(rows[0]);
+         }
+         else if (::fabs(span - 360.0) > 1.e-6)
+         {
+            Exception e("PCV azimuths do not cover 360 degrees");
+            GNSSTK_THROW(e);
+         }
+         invAzimStep = 1.0 / azimStep;
+      }
+      else
+      {
+         rows.resize(1);
+      }
+      nAzim = rows.size();
+
+      pcv.resize(nAzim * nZen);
+      for (unsigned int i = 0; i < nAzim; i++)
+      {
+         if (rows[i]->size() != nZen)
+         {
+            Exception e("PCV rows have different zenith angles");
+            GNSSTK_THROW(e);
+         }
+         unsigned int j = 0;
+         for (kt = rows[i]->begin(); kt != rows[i]->end(); ++kt, ++j)
+         {
+            if (kt->first != zens[j])
+            {
+               Exception e("PCV rows have different zenith angles");
+               GNSSTK_THROW(e);
+            }
+            pcv[i * nZen + j] = float(kt->second);
+         }
+      }
+   }
+
+   void AntennaPCVGrid::getPhaseCenterVariations(const double *azimuth,
+                                                 const double *elev_nadir,
+                                                 double *pcvs, size_t n) const
+   {
+      if (!isValid())
+      {
+         Exception e("Invalid AntennaPCVGrid object");
+         GNSSTK_THROW(e);
+      }
+      for (size_t i = 0; i < n; i++)
+      {
+         if (elev_nadir[i] < 0.0 || elev_nadir[i] > 90.0)
+         {
+            Exception e("Invalid elevation/nadir angle");
+            GNSSTK_THROW(e);
+         }
+         pcvs[i] = interpolate(azimuth[i], elev_nadir[i]);
+      }
+   }
+
+   double AntennaPCVGrid::getTotalPhaseCenterOffset(double azim,
+                                                    double elev_nadir) const
+   {
+      try
+      {
+         double pcvval = getPhaseCenterVariation(azim, elev_nadir);
+
+         double elev = elev_nadir;
+         if (!isRxAntenna)           // satellite : elev_nadir is 'nadir' angle:
+         {
+            elev = 90. - elev_nadir; //             from Z axis toward XY plane.
+         }
+
+         double cosel = ::cos(elev * DEG_TO_RAD);
+         double sinel = ::sin(elev * DEG_TO_RAD);
+         double cosaz = ::cos(azim * DEG_TO_RAD);
+         double sinaz = ::sin(azim * DEG_TO_RAD);
+
+            // see doc for class AntexData for signs, etc
+         return (-pcvval + pco[0] * cosel * cosaz + pco[1] * cosel * sinaz +
+                 pco[2] * sinel);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+} // namespace gnsstk
@@ -0,0 +1,217 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file AntennaPCVGrid.hpp
+ * Phase center offset and variation of one antenna at one frequency,
+ * compiled from AntexData into a regular grid for fast lookup. */
+
+#ifndef GNSSTK_ANTENNA_PCV_GRID_HPP
+#define GNSSTK_ANTENNA_PCV_GRID_HPP
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "AntexData.hpp"
+#include "Exception.hpp"
+#include "Triple.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /** The PCO and PCV pattern of one antenna at one frequency, as in
+       * AntexData, but with the PCVs stored in a contiguous regular
+       * (azimuth, zenith) grid of floats with precomputed spacing. A lookup
+       * is then two multiplies, two index computations and a bilinear
+       * interpolation, instead of walking the nested std::maps of
+       * AntexData::getPhaseCenterVariation(), whose results (including the
+       * treatment of azimuth wrap and of zenith angles beyond the table) are
+       * reproduced to within float precision.
+       *
+       * Angles, signs and units are as in AntexData: azimuth in degrees,
+       * elevation (receivers) or nadir angle (satellites) in degrees,
+       * offsets in millimeters.
+       *
+       * Grids are normally obtained from AntennaStore::getPCVHandle() and
+       * AntennaStore::getPCVGrid(). */
+   class AntennaPCVGrid
+   {
+   public:
+         /// Empty constructor; the grid is not valid.
+      AntennaPCVGrid()
+            : isRxAntenna(true), nAzim(0), nZen(0), azim0(0.0), azimStep(0.0),
+              invAzimStep(0.0), zen0(0.0), zenStep(0.0), invZenStep(0.0)
+      {
+         pco[0] = pco[1] = pco[2] = 0.0;
+      }
+
+         /** Compile the pattern of antenna data at frequency freq.
+          * @param antdata valid antenna data
+          * @param freq frequency e.g. G01
+          * @throw Exception if antdata is invalid, if freq is not
+          *   found, or if the PCVs are not on a regular grid */
+      AntennaPCVGrid(const AntexData& antdata, const std::string& freq);
+
+         /// @return true if the grid has been compiled
+      bool isValid() const { return !pcv.empty(); }
+
+         /// @return frequency of the grid, e.g. G01
+      const std::string& getFrequency() const { return frequency; }
+
+         /// @return the PC offsets in mm, as AntexData::getPhaseCenterOffset()
+      Triple getPhaseCenterOffset() const
+      { return Triple(pco[0], pco[1], pco[2]); }
+
+         /** Compute the phase center variation, as
+          * AntexData::getPhaseCenterVariation().
+          * @param azimuth azimuth in degrees
+          * @param elev_nadir elevation (receivers) or nadir angle
+          *   (satellites) in degrees, 0 to 90
+          * @return phase center variation in millimeters
+          * @throw Exception if the grid is invalid or elev_nadir is
+          *   out of range */
+      double getPhaseCenterVariation(double azimuth, double elev_nadir) const
+      {
+         if (!isValid())
+         {
+            Exception e("Invalid AntennaPCVGrid object");
+            GNSSTK_THROW(e);
+         }
+         if (elev_nadir < 0.0 || elev_nadir > 90.0)
+         {
+            Exception e("Invalid elevation/nadir angle");
+            GNSSTK_THROW(e);
+         }
+         return interpolate(azimuth, elev_nadir);
+      }
+
+         /** Compute the phase center variations for n (azimuth,
+          * elev_nadir) pairs; see getPhaseCenterVariation().
+          * @param azimuth array of n azimuths in degrees
+          * @param elev_nadir array of n elevation or nadir angles in degrees
+          * @param pcvs output array of n phase center variations in mm
+          * @param n number of pairs
+          * @throw Exception if the grid is invalid or any elev_nadir is
+          *   out of range */
+      void getPhaseCenterVariations(const double *azimuth,
+                                    const double *elev_nadir, double *pcvs,
+                                    size_t n) const;
+
+         /** Compute the total phase center offset, as
+          * AntexData::getTotalPhaseCenterOffset().
+          * @throw Exception if the grid is invalid or elev_nadir is
+          *   out of range */
+      double getTotalPhaseCenterOffset(double azimuth, double elev_nadir) const;
+
+         /// @return number of azimuths in the grid, 1 if no azimuth dependence
+      unsigned int getNumberOfAzimuths() const { return nAzim; }
+
+         /// @return number of zenith angles in the grid
+      unsigned int getNumberOfZeniths() const { return nZen; }
+
+   private:
+         /// bilinear interpolation, no checking
+      double interpolate(double azimuth, double elev_nadir) const
+      {
+         double zen = (isRxAntenna ? 90.0 - elev_nadir : elev_nadir);
+            // zenith angles beyond the table take the end value
+         double z = (zen - zen0) * invZenStep;
+         unsigned int iz = 0;
+         double fz = 0.0;
+         if (nZen > 1 && z > 0.0)
+         {
+            if (z >= double(nZen - 1))
+            {
+               iz = nZen - 2;
+               fz = 1.0;
+            }
+            else
+            {
+               iz = (unsigned int)z;
+               fz = z - iz;
+            }
+         }
+         const unsigned int iz1 = (nZen > 1 ? iz + 1 : iz);
+
+         if (nAzim == 1)
+         {
+            return pcv[iz] + fz * (pcv[iz1] - pcv[iz]);
+         }
+
+            // rows cover [azim0, azim0+360] so there is always a next row
+         double a = std::fmod(azimuth - azim0, 360.0);
+         if (a < 0.0)
+         {
+            a += 360.0;
+         }
+         double u = a * invAzimStep;
+         unsigned int ia = (unsigned int)u;
+         if (ia > nAzim - 2)
+         {
+            ia = nAzim - 2;
+         }
+         const double fa = u - ia;
+         const float *lo = &pcv[ia * nZen];
+         const float *hi = lo + nZen;
+         const double plo = lo[iz] + fz * (lo[iz1] - lo[iz]);
+         const double phi = hi[iz] + fz * (hi[iz1] - hi[iz]);
+         return plo + fa * (phi - plo);
+      }
+
+      std::string frequency;  ///< frequency of the grid, e.g. G01
+      bool isRxAntenna;       ///< see AntexData::isRxAntenna
+      double pco[3];          ///< PC offsets, mm
+      unsigned int nAzim;     ///< number of rows (azimuths)
+      unsigned int nZen;      ///< number of columns (zenith angles)
+      double azim0;           ///< azimuth of the first row, degrees
+      double azimStep;        ///< azimuth spacing, degrees
+      double invAzimStep;     ///< 1/azimStep
+      double zen0;            ///< zenith angle of the first column, degrees
+      double zenStep;         ///< zenith angle spacing, degrees
+      double invZenStep;      ///< 1/zenStep
+      std::vector<float> pcv; ///< PCVs, mm, pcv[iazim*nZen + izen]
+   }; // class AntennaPCVGrid
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_ANTENNA_PCV_GRID_HPP
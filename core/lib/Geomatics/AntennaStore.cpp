@@ -74,6 +74,60 @@ namespace gnsstk
 
          // add the new data
       antennaMap[name] = antdata;
+
+         // recompile any grids of this antenna, keeping their handles
+      map<pair<string, string>, int>::const_iterator jt;
+      for (jt = pcvHandles.lower_bound(make_pair(name, string()));
+           jt != pcvHandles.end() && jt->first.first == name; ++jt)
+      {
+         try
+         {
+            pcvGrids[jt->second] = AntennaPCVGrid(antdata, jt->first.second);
+         }
+         catch (Exception& e)
+         {
+               // getPCVHandle() will throw for this one
+            pcvGrids[jt->second] = AntennaPCVGrid();
+         }
+      }
+   }
+
+      /* Get a handle to the compiled PCO/PCV grid of the named antenna at the
+         given frequency, compiling it on the first call.
+      */
+   int AntennaStore::getPCVHandle(const string& name, const string& freq)
+   {
+      pair<string, string> key(name, freq);
+      map<pair<string, string>, int>::const_iterator jt;
+      jt = pcvHandles.find(key);
+      if (jt != pcvHandles.end() && pcvGrids[jt->second].isValid())
+      {
+         return jt->second;
+      }
+
+      map<string, AntexData>::const_iterator it = antennaMap.find(name);
+      if (it == antennaMap.end())
+      {
+         Exception e("Antenna " + name + " not found in the store");
+         GNSSTK_THROW(e);
+      }
+
+      try
+      {
+         AntennaPCVGrid grid(it->second, freq);
+         if (jt != pcvHandles.end())
+         {
+            pcvGrids[jt->second] = grid;
+            return jt->second;
+         }
+         pcvGrids.push_back(grid);
+         pcvHandles[key] = pcvGrids.size() - 1;
+         return pcvGrids.size() - 1;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
    }
 
       /* Get the antenna data for the given name from the store.
@@ -46,11 +46,13 @@
 #ifndef GNSSTK_ANTENNA_STORE_INCLUDE
 #define GNSSTK_ANTENNA_STORE_INCLUDE
 
+#include <deque>
 #include <iostream>
 #include <map>
 #include <string>
 #include <vector>
 
+#include "AntennaPCVGrid.hpp"
 #include "AntexData.hpp"
 #include "AntexHeader.hpp"
 #include "AntexStream.hpp"
@@ -146,7 +148,12 @@ namespace gnsstk
       unsigned int size() const { return antennaMap.size(); }
 
       /// clear the store of all information
-      void clear() { antennaMap.clear(); }
+      void clear()
+      {
+         antennaMap.clear();
+         pcvGrids.clear();
+         pcvHandles.clear();
+      }
 
          /**
           call to have satellite antennas included in store
@@ -215,6 +222,41 @@ namespace gnsstk
       Triple ComToPcVector(const SatID& sidr, const CommonTime& ct,
                            const Triple& satVector) const;
 
+         /**
+          Get a handle to the PCO/PCV pattern of the named antenna at the
+          given frequency, compiled into a regular grid (AntennaPCVGrid) on
+          the first call; later calls return the same handle. Handles stay
+          valid until clear(); if addAntenna() replaces the antenna, its
+          grids are recompiled under the same handles.
+          Use the handle with getPCVGrid() to look up PCVs without any
+          string or map searches per observation.
+          @param name  Antenna name, as in getAntenna()
+          @param freq  Frequency e.g. G01
+          @return handle for getPCVGrid()
+          @throw Exception if the name or frequency is not found, or the
+          pattern is not on a regular grid
+         */
+      int getPCVHandle(const std::string& name, const std::string& freq);
+
+         /**
+          Get the compiled PCO/PCV grid for a handle from getPCVHandle().
+          The reference stays valid, like the handle, until clear(); later
+          calls to getPCVHandle() do not move existing grids. If addAntenna()
+          replaces the antenna it refers to the recompiled grid, which is
+          invalid (and throws when used) if recompiling failed.
+          @throw Exception if the handle is invalid
+         */
+      const AntennaPCVGrid& getPCVGrid(int handle) const
+      {
+         if (handle < 0 || handle >= int(pcvGrids.size()) ||
+             !pcvGrids[handle].isValid())
+         {
+            Exception e("Invalid PCV grid handle");
+            GNSSTK_THROW(e);
+         }
+         return pcvGrids[handle];
+      }
+
       /// dump the store
       void dump(std::ostream& s = std::cout, short detail = 0);
 
@@ -231,6 +273,13 @@ namespace gnsstk
       /// map from name of antenna to AntexData object
       std::map<std::string, AntexData> antennaMap;
 
+      /// compiled PCO/PCV grids, indexed by handle; a deque so that adding
+      /// a grid does not move the others
+      std::deque<AntennaPCVGrid> pcvGrids;
+
+      /// map from (antenna name, frequency) to handle in pcvGrids
+      std::map<std::pair<std::string, std::string>, int> pcvHandles;
+
    }; // end class AntennaStore
 
 } // namespace gnsstk
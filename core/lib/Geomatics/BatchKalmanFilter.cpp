@@ -0,0 +1,423 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file BatchKalmanFilter.cpp Many independent Kalman filters of the same
+/// dimension, stored and updated together.
+
+#include "BatchKalmanFilter.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace gnsstk
+{
+   BatchKalmanFilter ::
+   BatchKalmanFilter(unsigned int n, unsigned int K)
+         : numThreads(0), minFiltersPerThread(4096), nState(n), nFilters(K)
+   {
+      if (n == 0 || K == 0)
+      {
+         Exception e("BatchKalmanFilter requires non-zero dimension and size");
+         GNSSTK_THROW(e);
+      }
+      X.assign(n * K, 0.0);
+      P.assign(n * n * K, 0.0);
+      work.assign(n * n * K, 0.0);
+      workX.assign(n * K, 0.0);
+      gain.assign(K, 0.0);
+      zrow.assign(K, 0.0);
+      rrow.assign(K, 0.0);
+      innov.assign(K, 0.0);
+      innovVar.assign(K, 0.0);
+   }
+
+
+   void BatchKalmanFilter ::
+   setState(unsigned int k, const Vector<double>& Xk, const Matrix<double>& Pk)
+   {
+      if (k >= nFilters || Xk.size() != nState || Pk.rows() != nState ||
+          Pk.cols() != nState)
+      {
+         Exception e("Invalid filter index or dimensions in setState()");
+         GNSSTK_THROW(e);
+      }
+      for (unsigned int i = 0; i < nState; i++)
+      {
+         X[i * nFilters + k] = Xk(i);
+         for (unsigned int j = 0; j < nState; j++)
+            P[(i * nState + j) * nFilters + k] = Pk(i, j);
+      }
+   }
+
+
+   void BatchKalmanFilter ::
+   setAllStates(const Vector<double>& Xk, const Matrix<double>& Pk)
+   {
+      if (Xk.size() != nState || Pk.rows() != nState || Pk.cols() != nState)
+      {
+         Exception e("Invalid dimensions in setAllStates()");
+         GNSSTK_THROW(e);
+      }
+      for (unsigned int i = 0; i < nState; i++)
+      {
+         std::fill_n(&X[i * nFilters], nFilters, Xk(i));
+         for (unsigned int j = 0; j < nState; j++)
+            std::fill_n(&P[(i * nState + j) * nFilters], nFilters, Pk(i, j));
+      }
+   }
+
+
+   Vector<double> BatchKalmanFilter ::
+   getState(unsigned int k) const
+   {
+      Vector<double> rv(nState);
+      for (unsigned int i = 0; i < nState; i++)
+         rv(i) = X[i * nFilters + k];
+      return rv;
+   }
+
+
+   Matrix<double> BatchKalmanFilter ::
+   getCovariance(unsigned int k) const
+   {
+      Matrix<double> rv(nState, nState);
+      for (unsigned int i = 0; i < nState; i++)
+         for (unsigned int j = 0; j < nState; j++)
+            rv(i, j) = P[(i * nState + j) * nFilters + k];
+      return rv;
+   }
+
+
+   void BatchKalmanFilter ::
+   checkTimeUpdate(const Matrix<double>& Phi, const Matrix<double>& Q) const
+   {
+      if (Phi.rows() != nState || Phi.cols() != nState ||
+          Q.rows() != nState || Q.cols() != nState)
+      {
+         Exception e("Invalid dimensions of Phi or Q in timeUpdate()");
+         GNSSTK_THROW(e);
+      }
+   }
+
+
+   void BatchKalmanFilter ::
+   timeUpdate(const Matrix<double>& Phi, const Matrix<double>& Q)
+   {
+      checkTimeUpdate(Phi, Q);
+      forEachRange([&](unsigned int k0, unsigned int k1)
+                   { timeUpdateRange(Phi, Q, nullptr, k0, k1); });
+   }
+
+
+   void BatchKalmanFilter ::
+   timeUpdate(const Matrix<double>& Phi, const Matrix<double>& Q,
+              const std::vector<double>& qscale)
+   {
+      checkTimeUpdate(Phi, Q);
+      if (qscale.size() != nFilters)
+      {
+         Exception e("Invalid length of qscale in timeUpdate()");
+         GNSSTK_THROW(e);
+      }
+      forEachRange([&](unsigned int k0, unsigned int k1)
+                   { timeUpdateRange(Phi, Q, qscale.data(), k0, k1); });
+   }
+
+
+   void BatchKalmanFilter ::
+   measurementUpdate(const Vector<double>& h, const std::vector<double>& z,
+                     const std::vector<double>& r)
+   {
+      if (h.size() != nState || z.size() != nFilters || r.size() != nFilters)
+      {
+         Exception e("Invalid dimensions in measurementUpdate()");
+         GNSSTK_THROW(e);
+      }
+      forEachRange(
+         [&](unsigned int k0, unsigned int k1)
+         {
+               // spread the common partials into the state layout
+            for (unsigned int i = 0; i < nState; i++)
+               std::fill(&workX[i * nFilters + k0], &workX[i * nFilters + k1],
+                         h(i));
+            measurementUpdateRange(workX.data(), z.data(), r.data(), k0, k1);
+         });
+   }
+
+
+   void BatchKalmanFilter ::
+   measurementUpdate(const std::vector<double>& H, const std::vector<double>& z,
+                     const std::vector<double>& r)
+   {
+      if (H.size() != nState * nFilters || z.size() != nFilters ||
+          r.size() != nFilters)
+      {
+         Exception e("Invalid dimensions in measurementUpdate()");
+         GNSSTK_THROW(e);
+      }
+      forEachRange([&](unsigned int k0, unsigned int k1)
+                   { measurementUpdateRange(H.data(), z.data(), r.data(), k0,
+                                            k1); });
+   }
+
+
+   void BatchKalmanFilter ::
+   measurementUpdate(const Matrix<double>& H, const Matrix<double>& Z,
+                     const Matrix<double>& R)
+   {
+      const unsigned int m(H.rows());
+      if (H.cols() != nState || Z.rows() != m || R.rows() != m ||
+          Z.cols() != nFilters || R.cols() != nFilters)
+      {
+         Exception e("Invalid dimensions in measurementUpdate()");
+         GNSSTK_THROW(e);
+      }
+      for (unsigned int l = 0; l < m; l++)
+      {
+         for (unsigned int k = 0; k < nFilters; k++)
+         {
+            zrow[k] = Z(l, k);
+            rrow[k] = R(l, k);
+         }
+         forEachRange(
+            [&](unsigned int k0, unsigned int k1)
+            {
+               for (unsigned int i = 0; i < nState; i++)
+                  std::fill(&workX[i * nFilters + k0],
+                            &workX[i * nFilters + k1], H(l, i));
+               measurementUpdateRange(workX.data(), zrow.data(), rrow.data(),
+                                      k0, k1);
+            });
+      }
+   }
+
+
+   void BatchKalmanFilter ::
+   forEachRange(
+      const std::function<void(unsigned int, unsigned int)>& kernel) const
+   {
+      unsigned int nthreads = numThreads;
+      if (nthreads == 0)
+      {
+         nthreads = std::max(1u, std::thread::hardware_concurrency());
+      }
+      nthreads = std::min(nthreads,
+                          nFilters / std::max(1u, minFiltersPerThread));
+      if (nthreads <= 1)
+      {
+         kernel(0, nFilters);
+         return;
+      }
+
+         // contiguous ranges of filters; the calling thread takes the first
+      const unsigned int chunk((nFilters + nthreads - 1) / nthreads);
+      std::vector<std::thread> threads;
+      for (unsigned int k0 = chunk; k0 < nFilters; k0 += chunk)
+      {
+         threads.push_back(
+            std::thread(kernel, k0, std::min(nFilters, k0 + chunk)));
+      }
+      kernel(0, std::min(nFilters, chunk));
+      for (std::thread& th : threads)
+      {
+         th.join();
+      }
+   }
+
+
+   void BatchKalmanFilter ::
+   timeUpdateRange(const Matrix<double>& Phi, const Matrix<double>& Q,
+                   const double *qscale, unsigned int k0, unsigned int k1)
+   {
+      const unsigned int n(nState), K(nFilters);
+      unsigned int i, j, l, k;
+
+         // X = Phi*X, via workX
+      for (i = 0; i < n; i++)
+      {
+         double *out = &workX[i * K];
+         for (k = k0; k < k1; k++)
+            out[k] = 0.0;
+         for (l = 0; l < n; l++)
+         {
+            const double a(Phi(i, l));
+            if (a == 0.0)
+            {
+               continue;
+            }
+            const double *x = &X[l * K];
+            for (k = k0; k < k1; k++)
+               out[k] += a * x[k];
+         }
+      }
+      for (i = 0; i < n; i++)
+         std::copy(&workX[i * K + k0], &workX[i * K + k1], &X[i * K + k0]);
+
+         // work = Phi*P
+      for (i = 0; i < n; i++)
+      {
+         for (j = 0; j < n; j++)
+         {
+            double *out = &work[(i * n + j) * K];
+            for (k = k0; k < k1; k++)
+               out[k] = 0.0;
+            for (l = 0; l < n; l++)
+            {
+               const double a(Phi(i, l));
+               if (a == 0.0)
+               {
+                  continue;
+               }
+               const double *p = &P[(l * n + j) * K];
+               for (k = k0; k < k1; k++)
+                  out[k] += a * p[k];
+            }
+         }
+      }
+
+         // P = work*Phi^T + Q; P is symmetric, so compute j >= i and copy
+      for (i = 0; i < n; i++)
+      {
+         for (j = i; j < n; j++)
+         {
+            double *out = &P[(i * n + j) * K];
+            const double q(Q(i, j));
+            if (qscale)
+            {
+               for (k = k0; k < k1; k++)
+                  out[k] = q * qscale[k];
+            }
+            else
+            {
+               for (k = k0; k < k1; k++)
+                  out[k] = q;
+            }
+            for (l = 0; l < n; l++)
+            {
+               const double a(Phi(j, l));
+               if (a == 0.0)
+               {
+                  continue;
+               }
+               const double *w = &work[(i * n + l) * K];
+               for (k = k0; k < k1; k++)
+                  out[k] += w[k] * a;
+            }
+            if (j > i)
+            {
+               std::copy(out + k0, out + k1, &P[(j * n + i) * K + k0]);
+            }
+         }
+      }
+   }
+
+
+   void BatchKalmanFilter ::
+   measurementUpdateRange(const double *H, const double *z, const double *r,
+                          unsigned int k0, unsigned int k1)
+   {
+      const unsigned int n(nState), K(nFilters);
+      unsigned int i, j, l, k;
+      double *ph = work.data(); // P*H^T, n*K
+      double *s  = innovVar.data();
+      double *v  = innov.data();
+      double *g  = gain.data();
+
+         // ph = P*H^T
+      for (i = 0; i < n; i++)
+      {
+         double *out = &ph[i * K];
+         for (k = k0; k < k1; k++)
+            out[k] = 0.0;
+         for (l = 0; l < n; l++)
+         {
+            const double *p = &P[(i * n + l) * K];
+            const double *h = &H[l * K];
+            for (k = k0; k < k1; k++)
+               out[k] += p[k] * h[k];
+         }
+      }
+
+         // s = H*P*H^T + r, v = z - H*X
+      for (k = k0; k < k1; k++)
+      {
+         s[k] = r[k];
+         v[k] = z[k];
+      }
+      for (i = 0; i < n; i++)
+      {
+         const double *h = &H[i * K];
+         const double *p = &ph[i * K];
+         const double *x = &X[i * K];
+         for (k = k0; k < k1; k++)
+         {
+            s[k] += h[k] * p[k];
+            v[k] -= h[k] * x[k];
+         }
+      }
+
+         // filters with no data get zero gain and are left unchanged
+      for (k = k0; k < k1; k++)
+      {
+         const bool ok(z[k] == z[k] && r[k] > 0.0 && s[k] > 0.0);
+         g[k] = (ok ? 1.0 / s[k] : 0.0);
+         v[k] = (ok ? v[k] : 0.0);
+      }
+
+         // X += ph*v/s, P -= ph*ph^T/s
+      for (i = 0; i < n; i++)
+      {
+         const double *pi = &ph[i * K];
+         double *x = &X[i * K];
+         for (k = k0; k < k1; k++)
+            x[k] += pi[k] * g[k] * v[k];
+         for (j = i; j < n; j++)
+         {
+            const double *pj = &ph[j * K];
+            double *out = &P[(i * n + j) * K];
+            for (k = k0; k < k1; k++)
+               out[k] -= pi[k] * pj[k] * g[k];
+            if (j > i)
+            {
+               std::copy(out + k0, out + k1, &P[(j * n + i) * K + k0]);
+            }
+         }
+      }
+   }
+
+} // end namespace gnsstk
@@ -0,0 +1,269 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file BatchKalmanFilter.hpp Many independent Kalman filters of the same
+/// dimension, stored and updated together.
+
+#ifndef BATCH_KALMAN_FILTER_INCLUDE
+#define BATCH_KALMAN_FILTER_INCLUDE
+
+#include "Exception.hpp"
+#include "Matrix.hpp"
+#include "Vector.hpp"
+#include <functional>
+#include <vector>
+
+namespace gnsstk
+{
+      /**
+       A bank of K independent Kalman filters, all with the same number of
+       states n, in covariance form, e.g. one small clock or ionosphere filter
+       per satellite. Rather than K filter objects each with its own Matrix
+       and Vector, the states and covariances of all the filters are stored in
+       structure-of-arrays layout, with the filter index k varying fastest:
+
+          state(i,k)        is stored at X[i*K + k]
+          covariance(i,j,k) is stored at P[(i*n + j)*K + k]
+
+       so that each time and measurement update is a set of loops whose
+       innermost loop runs over the filters, through contiguous memory, with
+       no branches; the compiler can vectorize these. All storage, including
+       the scratch space used by the updates, is allocated by the constructor,
+       so the updates themselves allocate nothing. When there are enough
+       filters the updates are also split over threads, each thread updating
+       a contiguous range of the filters.
+
+       The filters share the state transition Phi, the process noise Q
+       (optionally scaled per filter), and the measurement partials h
+       (optionally per filter); they have their own data and measurement
+       variances. A measurement of NaN, or a variance that is not positive,
+       means that filter has no data this epoch and is left unchanged, so
+       filters need not all be observed at once. A vector of measurements
+       with uncorrelated noise is processed as a sequence of scalar updates.
+
+       A single filter is the special case K = 1.
+
+       Unlike KalmanFilter, which is a framework for one SRIF with smoothing,
+       this class is a bare covariance-form engine: the caller drives it with
+       timeUpdate() and measurementUpdate().
+      */
+   class BatchKalmanFilter
+   {
+   public:
+         /**
+          Constructor.
+          @param n dimension of the state of each filter
+          @param K number of filters
+          @throw Exception if n or K is zero
+         */
+      BatchKalmanFilter(unsigned int n, unsigned int K);
+
+         /// dimension of the state of each filter
+      unsigned int dimension() const { return nState; }
+
+         /// number of filters
+      unsigned int size() const { return nFilters; }
+
+         /**
+          set the state and covariance of filter k
+          @param k index of the filter
+          @param X state, length n
+          @param P covariance, n x n
+          @throw Exception if k or the dimensions are invalid
+         */
+      void setState(unsigned int k, const Vector<double>& X,
+                    const Matrix<double>& P);
+
+         /**
+          set the state and covariance of every filter
+          @param X state, length n
+          @param P covariance, n x n
+          @throw Exception if the dimensions are invalid
+         */
+      void setAllStates(const Vector<double>& X, const Matrix<double>& P);
+
+         /// state of filter k
+      Vector<double> getState(unsigned int k) const;
+
+         /// covariance of filter k
+      Matrix<double> getCovariance(unsigned int k) const;
+
+         /// element i of the state of filter k
+      double state(unsigned int i, unsigned int k) const
+      {
+         return X[i * nFilters + k];
+      }
+
+         /// element (i,j) of the covariance of filter k
+      double covariance(unsigned int i, unsigned int j, unsigned int k) const
+      {
+         return P[(i * nState + j) * nFilters + k];
+      }
+
+         /// all the states, in the layout described above (n*K)
+      std::vector<double>& stateData() { return X; }
+
+         /// all the covariances, in the layout described above (n*n*K)
+      std::vector<double>& covarianceData() { return P; }
+
+         /**
+          time update of every filter: X = Phi*X, P = Phi*P*Phi^T + Q
+          @param Phi state transition matrix, n x n
+          @param Q   process noise covariance, n x n
+          @throw Exception if the dimensions are invalid
+         */
+      void timeUpdate(const Matrix<double>& Phi, const Matrix<double>& Q);
+
+         /**
+          time update of every filter with its own scale of the process noise,
+          P = Phi*P*Phi^T + qscale[k]*Q, e.g. with qscale[k] the time step of
+          filter k for a random walk
+          @param Phi    state transition matrix, n x n
+          @param Q      process noise covariance, n x n
+          @param qscale process noise scale of each filter, length K
+          @throw Exception if the dimensions are invalid
+         */
+      void timeUpdate(const Matrix<double>& Phi, const Matrix<double>& Q,
+                      const std::vector<double>& qscale);
+
+         /**
+          scalar measurement update of every filter, with partials h common
+          to all the filters, z[k] = h*X(k) + noise of variance r[k].
+          @param h partials, length n
+          @param z measurement of each filter, length K; NaN for no data
+          @param r measurement variance of each filter, length K
+          @throw Exception if the dimensions are invalid
+         */
+      void measurementUpdate(const Vector<double>& h,
+                             const std::vector<double>& z,
+                             const std::vector<double>& r);
+
+         /**
+          scalar measurement update of every filter, with partials for each
+          filter, z[k] = sum_i H[i*K+k]*X(i,k) + noise of variance r[k].
+          @param H partials of each filter, length n*K, in the state layout
+          @param z measurement of each filter, length K; NaN for no data
+          @param r measurement variance of each filter, length K
+          @throw Exception if the dimensions are invalid
+         */
+      void measurementUpdate(const std::vector<double>& H,
+                             const std::vector<double>& z,
+                             const std::vector<double>& r);
+
+         /**
+          measurement update of every filter with m uncorrelated measurements
+          and partials H common to all the filters, processed as m scalar
+          updates.
+          @param H partials, m x n
+          @param Z measurements, m x K; NaN for no data
+          @param R measurement variances, m x K
+          @throw Exception if the dimensions are invalid
+         */
+      void measurementUpdate(const Matrix<double>& H, const Matrix<double>& Z,
+                             const Matrix<double>& R);
+
+         /**
+          pre-fit residuals (innovations) z-h*X of the last scalar measurement
+          update, length K; zero for filters with no data
+         */
+      const std::vector<double>& innovations() const { return innov; }
+
+         /**
+          variances h*P*h^T+r of the innovations of the last scalar measurement
+          update, length K
+         */
+      const std::vector<double>& innovationVariances() const
+      {
+         return innovVar;
+      }
+
+         /// number of threads to use for the updates; 0 means all available
+      unsigned int numThreads;
+
+         /**
+          the updates are split over threads only if each thread would get at
+          least this many filters
+         */
+      unsigned int minFiltersPerThread;
+
+   private:
+         /**
+          call kernel(k0,k1) for ranges [k0,k1) covering all the filters,
+          in parallel if there are enough filters.
+         */
+      void forEachRange(const std::function<void(unsigned int, unsigned int)>&
+                           kernel) const;
+
+         /// time update kernel for filters [k0,k1)
+      void timeUpdateRange(const Matrix<double>& Phi, const Matrix<double>& Q,
+                           const double *qscale, unsigned int k0,
+                           unsigned int k1);
+
+         /**
+          scalar measurement update kernel for filters [k0,k1), with partials
+          H in the state layout
+         */
+      void measurementUpdateRange(const double *H, const double *z,
+                                  const double *r, unsigned int k0,
+                                  unsigned int k1);
+
+         /// check the dimensions of Phi and Q
+      void checkTimeUpdate(const Matrix<double>& Phi,
+                           const Matrix<double>& Q) const;
+
+      unsigned int nState;   ///< n, dimension of each state
+      unsigned int nFilters; ///< K, number of filters
+
+      std::vector<double> X; ///< states, X[i*K+k]
+      std::vector<double> P; ///< covariances, P[(i*n+j)*K+k]
+
+         /// scratch, n*n*K: Phi*P in the TU; P*h^T in the MU (n*K)
+      std::vector<double> work;
+         /// scratch, n*K: Phi*X in the TU; common partials in the MU
+      std::vector<double> workX;
+         /// scratch, K: gain factors, and one row of data and variances
+      std::vector<double> gain, zrow, rrow;
+         /// innovations and their variances from the last MU
+      std::vector<double> innov, innovVar;
+
+   }; // end class BatchKalmanFilter
+
+} // end namespace gnsstk
+
+#endif // BATCH_KALMAN_FILTER_INCLUDE
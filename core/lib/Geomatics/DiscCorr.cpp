@@ -46,11 +46,15 @@
 //------------------------------------------------------------------------------------
 // system
 #include <algorithm>
+#include <atomic>
 #include <deque>
+#include <exception>
 #include <iostream>
 #include <list>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 // gnsstk
 #include "GNSSconstants.hpp" // PI,C_MPS,OSC_FREQ_GPS,L1_MULT_GPS,L2_MULT_GPS
@@ -65,273 +69,6 @@ using namespace std;
 using namespace gnsstk;
 using namespace StringUtils;
 
-//------------------------------------------------------------------------------------
-// class GDCconfiguration
-//------------------------------------------------------------------------------------
-// class GDCconfiguration: string giving version of gnsstk Discontinuity
-// Corrector
-const string GDCconfiguration::GDCVersion = string("6.3 12/15/2015");
-
-// class GDCconfiguration: member functions
-//------------------------------------------------------------------------------------
-// Set a parameter in the configuration; the input string 'cmd' is of the form
-// '[--DC]<id><s><value>' : separator s is one of ':=,' and leading --DC is
-// optional.
-void GDCconfiguration::setParameter(std::string cmd)
-{
-   try
-   {
-      if (cmd.empty())
-      {
-         return;
-      }
-         // remove leading --DC
-      while (cmd[0] == '-')
-      {
-         cmd.erase(0, 1);
-      }
-
-      if (cmd.substr(0, 2) == "DC")
-      {
-         cmd.erase(0, 2);
-      }
-
-      string label, value;
-      string::size_type pos = cmd.find_first_of(",=:");
-      if (pos == string::npos)
-      {
-         label = cmd;
-      }
-      else
-      {
-         label = cmd.substr(0, pos);
-         value = cmd;
-         value.erase(0, pos + 1);
-      }
-
-      setParameter(label, asDouble(value));
-   }
-   catch (Exception& e)
-   {
-      GNSSTK_RETHROW(e);
-   }
-   catch (std::exception& e)
-   {
-      Exception E("std except: " + string(e.what()));
-      GNSSTK_THROW(E);
-   }
-   catch (...)
-   {
-      Exception e("Unknown exception");
-      GNSSTK_THROW(e);
-   }
-}
-
-//------------------------------------------------------------------------------------
-/* Set a parameter in the configuration using the label and the value,
-   for booleans use (T,F)=(non-zero,zero). */
-void GDCconfiguration::setParameter(const std::string& label, double value)
-{
-   try
-   {
-      if (CFG.find(label) == CFG.end())
-      {
-         {};
-      }
-      else
-      {
-            // log is not defined yet
-         if (CFG["Debug"] > 0)
-         {
-            *(p_oflog) << "GDCconfiguration::setParameter sets " << label
-                       << " to " << value << endl;
-         }
-         CFG[label] = value;
-      }
-   }
-   catch (Exception& e)
-   {
-      GNSSTK_RETHROW(e);
-   }
-   catch (std::exception& e)
-   {
-      Exception E("std except: " + string(e.what()));
-      GNSSTK_THROW(E);
-   }
-   catch (...)
-   {
-      Exception e("Unknown exception");
-      GNSSTK_THROW(e);
-   }
-}
-
-//------------------------------------------------------------------------------------
-/* Print help page, including descriptions and current values of all
-   the parameters, to the ostream. */
-void GDCconfiguration::DisplayParameterUsage(ostream& os, bool advanced)
-{
-   try
-   {
-      os << "GNSSTk Discontinuity Corrector (GDC) v." << GDCVersion
-         << " configuration:"
-         //<< "\n  [ pass setParameter() a string '<label><sep><value>';"
-         //<< " <sep> is one of ,=: ]"
-         << endl;
-
-      map<string, double>::const_iterator it;
-      for (it = CFG.begin(); it != CFG.end(); it++)
-      {
-         if (CFGdescription[it->first][0] == '*') // advanced options
-         {
-            continue;
-         }
-         ostringstream stst;
-         stst << it->first          // label
-              << "=" << it->second; // value
-         os << " " << leftJustify(stst.str(), 18) << " : "
-            << CFGdescription[it->first] // description
-            << endl;
-      }
-      if (advanced)
-      {
-         os << "   Advanced options:\n";
-         for (it = CFG.begin(); it != CFG.end(); it++)
-         {
-            if (CFGdescription[it->first][0] != '*') // ordinary options
-            {
-               continue;
-            }
-            ostringstream stst;
-            stst << it->first          // label
-                 << "=" << it->second; // value
-            os << " " << leftJustify(stst.str(), 25) << " : "
-               << CFGdescription[it->first].substr(2) // description
-               << endl;
-         }
-      }
-   }
-   catch (Exception& e)
-   {
-      GNSSTK_RETHROW(e);
-   }
-   catch (std::exception& e)
-   {
-      Exception E("std except: " + string(e.what()));
-      GNSSTK_THROW(E);
-   }
-   catch (...)
-   {
-      Exception e("Unknown exception");
-      GNSSTK_THROW(e);
-   }
-}
-
-//------------------------------------------------------------------------------------
-#define setcfg(a, b, c)                                                        \
-   {                                                                           \
-      CFG[#a]            = b;                                                  \
-      CFGdescription[#a] = c;                                                  \
-   }
-// initialize with default values
-void GDCconfiguration::initialize()
-{
-   try
-   {
-      p_oflog = &cout;
-
-         // bookkeeping
-      setcfg(ResetUnique, 0, "if non-zero, reset the unique number to zero");
-
-         // use cfg(DT) NOT dt -  dt is part of SatPass...
-      setcfg(DT, -1,
-             "nominal timestep of data (seconds) [required - no default!]");
-      setcfg(Debug, 0,
-             "level of diagnostic output to log, from 0(none) to 7(extreme)");
-      setcfg(useCA1, 0, "use L1 C/A code pseudorange (C1) ()");
-      setcfg(useCA2, 0, "use L2 C/A code pseudorange (C2) ()");
-      setcfg(MaxGap, 180,
-             "maximum allowed time gap within a segment (seconds)");
-      setcfg(MinPts, 13, "minimum number of good points in phase segment ()");
-      setcfg(WLSigma, 1.5,
-             "expected WL sigma (WL cycle) [NB = ~0.83*p-range noise(m)]");
-      setcfg(GFVariation, 16, // about 300 5.4-cm wavelengths
-             "expected maximum variation in GF phase in time DT (meters)");
-         // output
-      setcfg(OutputGPSTime, 0,
-             "if 0, output Y,M,D,H,M,S else: W,SoW in edit cmds (log uses "
-             "SatPass fmt)");
-      setcfg(OutputDeletes, 1,
-             "if non-zero, include delete commands in the output cmd list");
-
-         // -------------------------------------------------------------------------
-         // advanced options - marked with * - ordinary user will most likely NOT
-         // change
-      setcfg(RawBiasLimit, 100,
-             "* change in raw R-Ph that triggers bias reset (m)");
-         // WL editing
-      setcfg(WLNSigmaDelete, 2,
-             "* delete segments with sig(WL) > this * WLSigma ()");
-      setcfg(
-         WLWindowWidth, 50,
-         "* sliding window width for WL slip detection = 10+this/dt) (points)");
-      setcfg(WLNWindows, 2.5,
-             "* minimum segment size for WL small slip search (WLWindowWidth)");
-      setcfg(WLobviousLimit, 3,
-             "* minimum delta(WL) that produces an obvious slip (WLSigma)");
-      setcfg(WLNSigmaStrip, 3.5,
-             "* delete points with WL > this * computed sigma ()");
-      setcfg(WLNptsOutlierStats, 200,
-             "* maximum segment size to use robust outlier detection (pts)");
-      setcfg(WLRobustWeightLimit, 0.35,
-             "* minimum good weight in robust outlier detection (0<wt<=1)");
-         // WL small slips
-      setcfg(
-         WLSlipEdge, 3,
-         "* minimum separating WL slips and end of segment, else edit (pts)");
-      setcfg(WLSlipSize, 0.9, "* minimum WL slip size (WL wavelengths)");
-      setcfg(WLSlipExcess, 0.1,
-             "* minimum amount WL slip must exceed noise (WL wavelengths)");
-      setcfg(WLSlipSeparation, 2.5,
-             "* minimum excess/noise ratio of WL slip ()");
-         // GF small slips
-      setcfg(GFSlipWidth, 5,
-             "* minimum segment length for GF small slip detection (pts)");
-      setcfg(
-         GFSlipEdge, 3,
-         "* minimum separating GF slips and end of segment, else edit (pts)");
-      setcfg(GFobviousLimit, 1,
-             "* minimum delta(GF) that produces an obvious slip (GFVariation)");
-      setcfg(GFSlipOutlier, 5, "* minimum GF outlier magnitude/noise ratio ()");
-      setcfg(GFSlipSize, 0.8, "* minimum GF slip size (5.4cm wavelengths)");
-      setcfg(GFSlipStepToNoise, 0.1, "* maximum GF slip step/noise ratio ()");
-      setcfg(GFSlipToStep, 3, "* minimum GF slip magnitude/step ratio ()");
-      setcfg(GFSlipToNoise, 3, "* minimum GF slip magnitude/noise ratio ()");
-         // GF fix
-      setcfg(GFFixNpts, 15,
-             "* maximum number of points on each side to fix GF slips ()");
-      setcfg(GFFixDegree, 3, "* degree of polynomial used to fix GF slips ()");
-      setcfg(
-         GFFixMaxRMS, 100,
-         "* limit on RMS fit residuals to fix GF slips, else delete (5.4cm)");
-      setcfg(GFSkipSmall, 1,
-             "* if non-zero, skip small GF slips unless there is a WL slip");
-   }
-   catch (Exception& e)
-   {
-      GNSSTK_RETHROW(e);
-   }
-   catch (std::exception& e)
-   {
-      Exception E("std except: " + string(e.what()));
-      GNSSTK_THROW(E);
-   }
-   catch (...)
-   {
-      Exception e("Unknown exception");
-      GNSSTK_THROW(e);
-   }
-}
-
 //------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
 /* class Segment - used internally only.
@@ -617,6 +354,32 @@ class GDCPass : public SatPass, public GDCconfiguration
    /// finish()
    map<string, int> learn;
 
+ public:
+   /* these are members, not file-scope globals, so that separate passes may
+      be corrected concurrently in different threads */
+
+   /// unique number associated with this pass in the log file
+   int GDCUnique;
+
+   /// unique for each (WL,GF) fix
+   int GDCUniqueFix;
+
+   /// obs types of the caller's pass; indexes into both data and this vector
+   /// are L1,L2,etc...
+   vector<string> DCobstypes;
+
+   /// wavelength and other frequency-dependent quantities, determined early in
+   /// DC() constants used in linear combinations
+   int GLOn;
+   double wl1, wl2, wlwl, wlgf;   // wavelengths: L1,L2,widelane,narrowlane
+   double wl1r, wl2r, wl1p, wl2p; // coefficients in widelane linear combinations
+   double gf1r, gf2r, gf1p,
+      gf2p; // coefficients in geometry-free linear combinations
+
+   /// define wavelengths and linear combination coefficients, for the
+   /// satellite of this pass and (if Glonass) frequency channel GLOn
+   void setWavelengths();
+
 }; // end class GDCPass
 
 //------------------------------------------------------------------------------------
@@ -629,8 +392,6 @@ static const int P1 = 2;
 static const int P2 = 3;
 static const int A1 = 4;
 static const int A2 = 5;
-vector<string>
-   DCobstypes; // indexes into both data and this vector are L1,L2,etc...
 
 //------------------------------------------------------------------------------------
 // Return values (used by all routines within this module):
@@ -644,19 +405,25 @@ static const int ReturnOK     = 0;
 
 //------------------------------------------------------------------------------------
 /* these are used only to associate a unique number in the log file with each
-   pass */
-static int GDCUnique = 0;     // unique number for each call
-static int GDCUniqueFix;      // unique for each (WL,GF) fix
-static string GDCtag = "GDC"; // begin each line of return message
-
-//------------------------------------------------------------------------------------
-/* wavelength and other frequency-dependent quantities, determined early in DC()
-   constants used in linear combinations */
-int GLOn;
-double wl1, wl2, wlwl, wlgf;   // wavelengths: L1,L2,widelane,narrowlane
-double wl1r, wl2r, wl1p, wl2p; // coefficients in widelane linear combinations
-double gf1r, gf2r, gf1p,
-   gf2p; // coefficients in geometry-free linear combinations
+   pass; the counter is shared by all callers, so it is guarded by a mutex */
+static int GDCUniqueCount = 0;   // last unique number handed out
+static std::mutex GDCUniqueMutex; // guards GDCUniqueCount
+static const string GDCtag = "GDC"; // begin each line of return message
+
+/* reserve n consecutive unique numbers, honoring the ResetUnique parameter;
+   return the first */
+static int reserveUnique(GDCconfiguration& gdc, int n)
+{
+   std::lock_guard<std::mutex> lock(GDCUniqueMutex);
+   if (gdc.getParameter("ResetUnique") != 0)
+   {
+      GDCUniqueCount = 0;
+      gdc.setParameter("ResetUnique=0");
+   }
+   int first = GDCUniqueCount + 1;
+   GDCUniqueCount += n;
+   return first;
+}
 
 /*------------------------------------------------------------------------------------
    Flags - constants used to mark slips, etc. using the SatPass flag:
@@ -691,6 +458,180 @@ const unsigned short GDCPass::FIX      = 24; // = WLFIX | GFFIX
    either !(flag & OK) or (flag ^ OK) for bad data, and (flag & OK) for good
    data */
 
+//------------------------------------------------------------------------------------
+// The discontinuity corrector function, for one pass with given unique number
+//------------------------------------------------------------------------------------
+static int correctPass(SatPass& svp, GDCconfiguration& gdc,
+                       vector<string>& editCmds, string& retMessage,
+                       int GLOn_in, int unique)
+{
+   unsigned int i, j;
+   int iret;
+
+      // if(!retMessage.empty()) { GDCtag = retMessage; }
+   retMessage = "";
+
+      // --------------------------------------------------------------------------
+      // require obstypes L1,L2,C1/P1,C2/P2, and add two auxiliary arrays
+   vector<string> DCobstypes;
+   DCobstypes.push_back("L1");
+   DCobstypes.push_back("L2");
+   DCobstypes.push_back((int(gdc.getParameter("useCA1"))) == 0 ? "P1" : "C1");
+   DCobstypes.push_back((int(gdc.getParameter("useCA2"))) == 0 ? "P2" : "C2");
+   DCobstypes.push_back("A1");
+   DCobstypes.push_back("A2");
+
+      // --------------------------------------------------------------------------
+      // test input for (a) some data and (b) the required obs types
+      // L1,L2,C1/P1,P2
+   vector<double> newdata(6);
+   string found;
+   try
+   {
+      newdata[L1] = svp.data(0, DCobstypes[L1]);
+      found += " " + DCobstypes[L1];
+      newdata[L2] = svp.data(0, DCobstypes[L2]);
+      found += " " + DCobstypes[L2];
+      newdata[P1] = svp.data(0, DCobstypes[P1]);
+      found += " " + DCobstypes[P1];
+      newdata[P2] = svp.data(0, DCobstypes[P2]);
+      found += " " + DCobstypes[P2];
+   }
+   catch (Exception& e)
+   { // if obs type is not found in input
+      ostringstream oss;
+      oss << "   Missing required obs types. Require";
+      for (i = 0; i < 4; i++)
+      {
+         oss << " " << DCobstypes[i];
+      }
+      oss << "; found only" << found;
+
+      retMessage = oss.str();
+      return BadInput;
+   }
+
+      // --------------------------------------------------------------------------
+      // create a SatPass using DCobstypes, and fill from input
+   RinexSatID sat(svp.getSat());
+   SatPass nsvp(sat, svp.getDT(), DCobstypes);
+
+      // fill the new SatPass with the input data
+   nsvp.status() = svp.status();
+   nsvp.reserve(svp.size());
+   vector<unsigned short> lli(6), ssi(6);
+   for (i = 0; i < static_cast<int>(svp.size()); i++)
+   {
+      for (j = 0; j < 6; j++)
+      {
+         newdata[j] = j < 4 ? svp.data(i, DCobstypes[j]) : 0.0;
+         lli[j]     = j < 4 ? svp.LLI(i, DCobstypes[j]) : 0;
+         ssi[j]     = j < 4 ? svp.SSI(i, DCobstypes[j]) : 0;
+      }
+         // return value must be 0
+      nsvp.addData(svp.time(i), DCobstypes, newdata, lli, ssi,
+                   svp.getFlag(i));
+   }
+
+      // --------------------------------------------------------------------------
+      // create a GDCPass from the input SatPass (modified) and GDC
+      // configuration
+   GDCPass gp(nsvp, gdc);
+   gp.GDCUnique  = unique;
+   gp.DCobstypes = DCobstypes;
+
+      // --------------------------------------------------------------------------
+      /* if the satellite is Glonass, compute the frequency channel, if
+         necessary, and define wavelengths and other constants for this
+         satellite */
+   gp.GLOn = GLOn_in;
+   if (sat.system == SatelliteSystem::Glonass)
+   {
+
+         // only compute it if it is out of range
+      if (gp.GLOn < -7 || gp.GLOn > 7)
+      {
+         string msg;
+            // call SatPass::getGLOchannel() to get channel from data
+         gp.GLOn = 0;
+         if (gp.getGLOchannel(gp.GLOn, msg))
+         {
+               // log << "Computed GLONASS frequency channel = " << GLOn
+               //   << "\n   (" << msg << ")" << endl;
+         }
+         else
+         {
+            ostringstream oss;
+            oss << GDCtag << " " << setw(3) << unique << " " << sat << " "
+                << printTime(svp.getFirstTime(), svp.outFormat)
+                << " is returning with error code: failed to find GLONASS "
+                   "frequency\n"
+                << msg << endl;
+            retMessage = oss.str();
+            return GLOfailed;
+         }
+      }
+   }
+   gp.setWavelengths();
+
+      // --------------------------------------------------------------------------
+      /* implement the DC algorithm using the GDCPass
+         NB search for 'change the arrays' for places where arrays are
+         re-defined NB search for 'change the data' for places where the data is
+         modified (! biases) NB search for 'change the bias' for places where
+         the bias is changed */
+   for (;;)
+   { // a convenience...
+         // preparation
+      if ((iret = gp.preprocess()))
+      {
+         break;
+      }
+      if ((iret = gp.linearCombinations()))
+      {
+         break;
+      }
+
+         // WL
+      if ((iret = gp.detectWLslips()))
+      {
+         break;
+      }
+      if ((iret = gp.fixAllSlips("WL")))
+      {
+         break;
+      }
+
+         // GF
+      if ((iret = gp.prepareGFdata()))
+      {
+         break;
+      }
+      if ((iret = gp.detectGFslips()))
+      {
+         break;
+      }
+      if ((iret = gp.WLconsistencyCheck()))
+      {
+         break;
+      }
+      if ((iret = gp.fixAllSlips("GF")))
+      {
+         break;
+      }
+
+      break; // mandatory
+   }
+
+      // --------------------------------------------------------------------------
+      /* generate editing commands for deleted (flagged) data and slips,
+         use editing command (slips and deletes) to modify the original SatPass
+         data and print ending summary */
+   retMessage = gp.finish(iret, svp, editCmds);
+
+   return iret;
+}
+
 //------------------------------------------------------------------------------------
 // The discontinuity corrector function
 //------------------------------------------------------------------------------------
@@ -701,228 +642,118 @@ int gnsstk::DiscontinuityCorrector(SatPass& svp, GDCconfiguration& gdc,
 {
    try
    {
-      unsigned int i, j;
-      int iret;
-
-      if (gdc.getParameter("ResetUnique") != 0)
-      {
-         GDCUnique = 0;
-         gdc.setParameter("ResetUnique=0");
-      }
-      GDCUnique++;
-
-         // if(!retMessage.empty()) { GDCtag = retMessage; }
-      retMessage = "";
-
-         // --------------------------------------------------------------------------
-         // require obstypes L1,L2,C1/P1,C2/P2, and add two auxiliary arrays
-      DCobstypes.clear();
-      DCobstypes.push_back("L1");
-      DCobstypes.push_back("L2");
-      DCobstypes.push_back((int(gdc.getParameter("useCA1"))) == 0 ? "P1"
-                                                                  : "C1");
-      DCobstypes.push_back((int(gdc.getParameter("useCA2"))) == 0 ? "P2"
-                                                                  : "C2");
-      DCobstypes.push_back("A1");
-      DCobstypes.push_back("A2");
-
-         // --------------------------------------------------------------------------
-         // test input for (a) some data and (b) the required obs types
-         // L1,L2,C1/P1,P2
-      vector<double> newdata(6);
-      string found;
-      try
-      {
-         newdata[L1] = svp.data(0, DCobstypes[L1]);
-         found += " " + DCobstypes[L1];
-         newdata[L2] = svp.data(0, DCobstypes[L2]);
-         found += " " + DCobstypes[L2];
-         newdata[P1] = svp.data(0, DCobstypes[P1]);
-         found += " " + DCobstypes[P1];
-         newdata[P2] = svp.data(0, DCobstypes[P2]);
-         found += " " + DCobstypes[P2];
-      }
-      catch (Exception& e)
-      { // if obs type is not found in input
-         ostringstream oss;
-         oss << "   Missing required obs types. Require";
-         for (i = 0; i < 4; i++)
-         {
-            oss << " " << DCobstypes[i];
-         }
-         oss << "; found only" << found;
+      int unique = reserveUnique(gdc, 1);
+      return correctPass(svp, gdc, editCmds, retMessage, GLOn_in, unique);
+   }
+   catch (Exception& e)
+   {
+      GNSSTK_RETHROW(e);
+   }
+   catch (std::exception& e)
+   {
+      Exception E("std except: " + string(e.what()));
+      GNSSTK_THROW(E);
+   }
+   catch (...)
+   {
+      Exception e("Unknown exception");
+      GNSSTK_THROW(e);
+   }
+}
 
-         retMessage = oss.str();
-         return BadInput;
+//------------------------------------------------------------------------------------
+// The discontinuity corrector function, for many passes at once
+//------------------------------------------------------------------------------------
+vector<int> gnsstk::DiscontinuityCorrector(vector<SatPass>& SPList,
+                                           GDCconfiguration& gdc,
+                                           vector<string>& editCmds,
+                                           vector<string>& retMessages,
+                                           int nthreads,
+                                           const vector<int>& GLOn_in)
+{
+   try
+   {
+      const size_t npass = SPList.size();
+      vector<int> iret(npass, 0);
+      retMessages.assign(npass, string());
+      if (npass == 0)
+      {
+         return iret;
       }
 
-         // --------------------------------------------------------------------------
-         // create a SatPass using DCobstypes, and fill from input
-      RinexSatID sat(svp.getSat());
-      SatPass nsvp(sat, svp.getDT(), DCobstypes);
+         // unique numbers are handed out in pass order, before any work starts
+      int unique = reserveUnique(gdc, static_cast<int>(npass));
 
-         // fill the new SatPass with the input data
-      nsvp.status() = svp.status();
-      vector<unsigned short> lli(6), ssi(6);
-      for (i = 0; i < static_cast<int>(svp.size()); i++)
+      if (nthreads <= 0)
       {
-         for (j = 0; j < 6; j++)
-         {
-            newdata[j] = j < 4 ? svp.data(i, DCobstypes[j]) : 0.0;
-            lli[j]     = j < 4 ? svp.LLI(i, DCobstypes[j]) : 0;
-            ssi[j]     = j < 4 ? svp.SSI(i, DCobstypes[j]) : 0;
-         }
-            // return value must be 0
-         nsvp.addData(svp.time(i), DCobstypes, newdata, lli, ssi,
-                      svp.getFlag(i));
+         nthreads = static_cast<int>(std::thread::hardware_concurrency());
+      }
+      if (nthreads <= 0)
+      {
+         nthreads = 1;
+      }
+      if (static_cast<size_t>(nthreads) > npass)
+      {
+         nthreads = static_cast<int>(npass);
       }
 
-         // --------------------------------------------------------------------------
-         // create a GDCPass from the input SatPass (modified) and GDC
-         // configuration
-      GDCPass gp(nsvp, gdc);
+         /* per-pass results; each worker writes only to the slots of the passes
+            it takes, and the debug output of each pass goes to its own buffer,
+            so that output is in pass order regardless of scheduling */
+      vector<vector<string>> passCmds(npass);
+      vector<ostringstream> passLogs(npass);
+      vector<std::exception_ptr> passErrors(npass);
+      std::atomic<size_t> next(0);
+      std::ostream& oflog = gdc.getDebugStream();
 
-         // --------------------------------------------------------------------------
-         /* if the satellite is Glonass, compute the frequency channel, if
-            necessary, and define wavelengths and other constants for this
-            satellite */
-      GLOn = GLOn_in;
-      if (sat.system == SatelliteSystem::Glonass)
+      auto worker = [&]()
       {
-
-            // only compute it if it is out of range
-         if (GLOn < -7 || GLOn > 7)
+         for (size_t k = next++; k < npass; k = next++)
          {
-            string msg;
-               // call SatPass::getGLOchannel() to get channel from data
-            GLOn = 0;
-            if (gp.getGLOchannel(GLOn, msg))
+            try
             {
-                  // log << "Computed GLONASS frequency channel = " << GLOn
-                  //   << "\n   (" << msg << ")" << endl;
+               GDCconfiguration passgdc(gdc);
+               passgdc.setDebugStream(passLogs[k]);
+               int GLOn = (k < GLOn_in.size() ? GLOn_in[k] : -99);
+               iret[k]  = correctPass(SPList[k], passgdc, passCmds[k],
+                                      retMessages[k], GLOn, unique + int(k));
             }
-            else
+            catch (...)
             {
-               ostringstream oss;
-               oss << GDCtag << " " << setw(3) << GDCUnique << " " << sat << " "
-                   << printTime(svp.getFirstTime(), svp.outFormat)
-                   << " is returning with error code: failed to find GLONASS "
-                      "frequency\n"
-                   << msg << endl;
-               retMessage = oss.str();
-               return GLOfailed;
+               passErrors[k] = std::current_exception();
             }
          }
+      };
 
-            /* GLO Frequency(Hz) L1 is 1602.0e6 + n*562.5e3 Hz = 9 * (178 +
-               n*0.0625) MHz
-                                 L2    1246.0e6 + n*437.5e3 Hz = 7 * (178 +
-                                 n*0.0625) MHz
-               Note that L1/L2 is always 9/7 for freq, 7/9 for wavelength */
-         static const double GLOfreq0L1 = 1602.0e6;
-         static const double GLOdfreqL1 = 562.5e3;
-         static const double GLOfreq0L2 = 1246.0e6;
-         static const double GLOdfreqL2 = 437.5e3;
-         static const double F1oF2      = 9.0 / 7.0;
-         static const double F2oF1      = 7.0 / 9.0;
-
-         wl1  = C_MPS / (GLOfreq0L1 + GLOn * GLOdfreqL1);
-         wl2  = C_MPS / (GLOfreq0L2 + GLOn * GLOdfreqL2);
-         wlwl = 1.0 / (1.0 / wl1 - 1.0 / wl2);
-         wlgf = wl2 - wl1;
-
-         wl1r = 1.0 / (1.0 + F2oF1);
-         wl2r = 1.0 / (1.0 + F1oF2);
-         wl1p = wl1 / (1.0 - F2oF1);
-         wl2p = wl2 / (1.0 - F1oF2);
-
-         gf1r = -1.0;
-         gf2r = 1.0;
-         gf1p = wl1;
-         gf2p = -wl2;
+      if (nthreads == 1)
+      {
+         worker();
       }
       else
-      { // GPS satellite
-         static const double CFF     = C_MPS / OSC_FREQ_GPS;
-         static const double wl1_GPS = CFF / L1_MULT_GPS; // 19.0cm
-         static const double wl2_GPS = CFF / L2_MULT_GPS; // 24.4cm
-         static const double wlwl_GPS =
-            CFF / (L1_MULT_GPS - L2_MULT_GPS);                     // 86.2cm
-         static const double wlgf_GPS = wl2_GPS - wl1_GPS;         //  5.4cm
-         static const double F1oF2    = L1_MULT_GPS / L2_MULT_GPS; // 77/60
-         static const double F2oF1    = L2_MULT_GPS / L1_MULT_GPS; // 60/77
-
-         wl1  = wl1_GPS;
-         wl2  = wl2_GPS;
-         wlwl = wlwl_GPS;
-         wlgf = wlgf_GPS;
-
-         wl1r = 1.0 / (1.0 + F2oF1);
-         wl2r = 1.0 / (1.0 + F1oF2);
-         wl1p = wl1 / (1.0 - F2oF1);
-         wl2p = wl2 / (1.0 - F1oF2);
-
-         gf1r = -1.0;
-         gf2r = 1.0;
-         gf1p = wl1;
-         gf2p = -wl2;
-      }
-
-         // --------------------------------------------------------------------------
-         /* implement the DC algorithm using the GDCPass
-            NB search for 'change the arrays' for places where arrays are
-            re-defined NB search for 'change the data' for places where the data is
-            modified (! biases) NB search for 'change the bias' for places where
-            the bias is changed */
-      for (;;)
-      { // a convenience...
-            // preparation
-         if ((iret = gp.preprocess()))
+      {
+         vector<std::thread> threads;
+         for (int t = 0; t < nthreads; t++)
          {
-            break;
+            threads.push_back(std::thread(worker));
          }
-         if ((iret = gp.linearCombinations()))
+         for (size_t t = 0; t < threads.size(); t++)
          {
-            break;
-         }
-
-            // WL
-         if ((iret = gp.detectWLslips()))
-         {
-            break;
-         }
-         if ((iret = gp.fixAllSlips("WL")))
-         {
-            break;
+            threads[t].join();
          }
+      }
 
-            // GF
-         if ((iret = gp.prepareGFdata()))
-         {
-            break;
-         }
-         if ((iret = gp.detectGFslips()))
-         {
-            break;
-         }
-         if ((iret = gp.WLconsistencyCheck()))
-         {
-            break;
-         }
-         if ((iret = gp.fixAllSlips("GF")))
+         // collect, in pass order; stop at the first pass that threw
+      for (size_t k = 0; k < npass; k++)
+      {
+         oflog << passLogs[k].str();
+         if (passErrors[k])
          {
-            break;
+            std::rethrow_exception(passErrors[k]);
          }
-
-         break; // mandatory
+         editCmds.insert(editCmds.end(), passCmds[k].begin(),
+                         passCmds[k].end());
       }
 
-         // --------------------------------------------------------------------------
-         /* generate editing commands for deleted (flagged) data and slips,
-            use editing command (slips and deletes) to modify the original SatPass
-            data and print ending summary */
-      retMessage = gp.finish(iret, svp, editCmds);
-
       return iret;
    }
    catch (Exception& e)
@@ -959,27 +790,97 @@ GDCPass::GDCPass(SatPass& sp, const GDCconfiguration& gdc)
       indexForLabel[labelForIndex[i]] = i;
    }
 
-   vector<double> vdata;
-   vector<unsigned short> lli, ssi;
+      // add the epochs, then copy the data one obs type column at a time
+   vector<int> index; // index in sp of each epoch added
+   reserve(sp.size());
    for (i = 0; i < static_cast<int>(sp.size()); i++)
    {
-      vdata.clear();
-      lli.clear();
-      ssi.clear();
-      for (j = 0; j < static_cast<int>(ot.size()); j++)
+      if (pushBack(sp.time(i), sp.getFlag(i)) >= 0)
       {
-         vdata.push_back(sp.data(i, ot[j]));
-         lli.push_back(sp.LLI(i, ot[j]));
-         ssi.push_back(sp.SSI(i, ot[j]));
+         index.push_back(i);
+      }
+   }
+   for (j = 0; j < static_cast<int>(ot.size()); j++)
+   {
+      int h(sp.obsHandle(ot[j]));
+      const double *data(sp.dataColumn(h));
+      const unsigned short *lli(sp.LLIColumn(h)), *ssi(sp.SSIColumn(h));
+      for (i = 0; i < static_cast<int>(index.size()); i++)
+      {
+         spddata[j][i] = data[index[i]];
+         spdlli[j][i]  = lli[index[i]];
+         spdssi[j][i]  = ssi[index[i]];
       }
-      addData(sp.time(i), ot, vdata, lli, ssi, sp.getFlag(i));
    }
 
    *((GDCconfiguration *)this) = gdc;
 
+   GDCUnique = GDCUniqueFix = 0;
+   GLOn                     = 0;
+
    learn.clear();
 }
 
+//---------------------------------------------------------------------------------
+void GDCPass::setWavelengths()
+{
+   if (sat.system == SatelliteSystem::Glonass)
+   {
+         /* GLO Frequency(Hz) L1 is 1602.0e6 + n*562.5e3 Hz = 9 * (178 +
+            n*0.0625) MHz
+                              L2    1246.0e6 + n*437.5e3 Hz = 7 * (178 +
+                              n*0.0625) MHz
+            Note that L1/L2 is always 9/7 for freq, 7/9 for wavelength */
+      static const double GLOfreq0L1 = 1602.0e6;
+      static const double GLOdfreqL1 = 562.5e3;
+      static const double GLOfreq0L2 = 1246.0e6;
+      static const double GLOdfreqL2 = 437.5e3;
+      static const double F1oF2      = 9.0 / 7.0;
+      static const double F2oF1      = 7.0 / 9.0;
+
+      wl1  = C_MPS / (GLOfreq0L1 + GLOn * GLOdfreqL1);
+      wl2  = C_MPS / (GLOfreq0L2 + GLOn * GLOdfreqL2);
+      wlwl = 1.0 / (1.0 / wl1 - 1.0 / wl2);
+      wlgf = wl2 - wl1;
+
+      wl1r = 1.0 / (1.0 + F2oF1);
+      wl2r = 1.0 / (1.0 + F1oF2);
+      wl1p = wl1 / (1.0 - F2oF1);
+      wl2p = wl2 / (1.0 - F1oF2);
+
+      gf1r = -1.0;
+      gf2r = 1.0;
+      gf1p = wl1;
+      gf2p = -wl2;
+   }
+   else
+   { // GPS satellite
+      static const double CFF     = C_MPS / OSC_FREQ_GPS;
+      static const double wl1_GPS = CFF / L1_MULT_GPS; // 19.0cm
+      static const double wl2_GPS = CFF / L2_MULT_GPS; // 24.4cm
+      static const double wlwl_GPS =
+         CFF / (L1_MULT_GPS - L2_MULT_GPS);                     // 86.2cm
+      static const double wlgf_GPS = wl2_GPS - wl1_GPS;         //  5.4cm
+      static const double F1oF2    = L1_MULT_GPS / L2_MULT_GPS; // 77/60
+      static const double F2oF1    = L2_MULT_GPS / L1_MULT_GPS; // 60/77
+
+      wl1  = wl1_GPS;
+      wl2  = wl2_GPS;
+      wlwl = wlwl_GPS;
+      wlgf = wlgf_GPS;
+
+      wl1r = 1.0 / (1.0 + F2oF1);
+      wl2r = 1.0 / (1.0 + F1oF2);
+      wl1p = wl1 / (1.0 - F2oF1);
+      wl2p = wl2 / (1.0 - F1oF2);
+
+      gf1r = -1.0;
+      gf2r = 1.0;
+      gf1p = wl1;
+      gf2p = -wl2;
+   }
+}
+
 //---------------------------------------------------------------------------------
 int GDCPass::preprocess()
 {
@@ -1025,23 +926,23 @@ int GDCPass::preprocess()
       {
 
             // ignore data the caller has marked BAD
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          {
             continue;
          }
 
             // just in case the caller has set it to something else...
-         spdvector[i].flag = OK;
+         spdflag[i] = OK;
 
             /* look for obvious outliers
                Don't do this - sometimes the pseudoranges get extreme values b/c
                the clock is allowed to run off for long times - perfectly normal
-               if(spdvector[i].data[P1] < cfg(MinRange) ||
-                 spdvector[i].data[P1] > cfg(MaxRange) ||
-                 spdvector[i].data[P2] < cfg(MinRange) ||
-                 spdvector[i].data[P2] > cfg(MaxRange) )
+               if(spddata[P1][i] < cfg(MinRange) ||
+                 spddata[P1][i] > cfg(MaxRange) ||
+                 spddata[P2][i] < cfg(MinRange) ||
+                 spddata[P2][i] > cfg(MaxRange) )
            {
-                 spdvector[i].flag = BAD;
+                 spdflag[i] = BAD;
                  learn["points deleted: obvious outlier"]++;
                  if(cfg(Debug) > 6)
                     log << "Obvious outlier " << GDCUnique << " " << sat
@@ -1086,12 +987,12 @@ int GDCPass::preprocess()
             // loop over points in this segment
          for (i = it->nbeg; i <= it->nend; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
 
-            dbias = fabs(spdvector[i].data[P1] - wl1 * spdvector[i].data[L1] -
+            dbias = fabs(spddata[P1][i] - wl1 * spddata[L1][i] -
                          biasL1);
             if (dbias > cfg(RawBiasLimit))
             {
@@ -1100,13 +1001,13 @@ int GDCPass::preprocess()
                   log << "BEFresetL1 " << GDCUnique << " " << sat << " "
                       << printTime(time(i), outFormat) << " " << fixed
                       << setprecision(3) << biasL1 << " "
-                      << spdvector[i].data[P1] - wl1 * spdvector[i].data[L1]
+                      << spddata[P1][i] - wl1 * spddata[L1][i]
                       << endl;
                }
-               biasL1 = spdvector[i].data[P1] - wl1 * spdvector[i].data[L1];
+               biasL1 = spddata[P1][i] - wl1 * spddata[L1][i];
             }
 
-            dbias = fabs(spdvector[i].data[P2] - wl2 * spdvector[i].data[L2] -
+            dbias = fabs(spddata[P2][i] - wl2 * spddata[L2][i] -
                          biasL2);
             if (dbias > cfg(RawBiasLimit))
             {
@@ -1115,16 +1016,16 @@ int GDCPass::preprocess()
                   log << "BEFresetL2 " << GDCUnique << " " << sat << " "
                       << printTime(time(i), outFormat) << " " << fixed
                       << setprecision(3) << biasL2 << " "
-                      << spdvector[i].data[P2] - wl2 * spdvector[i].data[L2]
+                      << spddata[P2][i] - wl2 * spddata[L2][i]
                       << endl;
                }
-               biasL2 = spdvector[i].data[P2] - wl2 * spdvector[i].data[L2];
+               biasL2 = spddata[P2][i] - wl2 * spddata[L2][i];
             }
 
-            spdvector[i].data[A1] =
-               spdvector[i].data[P1] - wl1 * spdvector[i].data[L1] - biasL1;
-            spdvector[i].data[A2] =
-               spdvector[i].data[P2] - wl2 * spdvector[i].data[L2] - biasL2;
+            spddata[A1][i] =
+               spddata[P1][i] - wl1 * spddata[L1][i] - biasL1;
+            spddata[A2][i] =
+               spddata[P2][i] - wl2 * spddata[L2][i] - biasL2;
 
          } // end loop over points in the segment
 
@@ -1184,19 +1085,19 @@ int GDCPass::linearCombinations()
             // loop over points in this segment
          for (i = it->nbeg; i <= it->nend; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
 
                // narrow lane range (m)
-            wlr = wl1r * spdvector[i].data[P1] + wl2r * spdvector[i].data[P2];
+            wlr = wl1r * spddata[P1][i] + wl2r * spddata[P2][i];
                // wide lane phase (m)
-            wlp = wl1p * spdvector[i].data[L1] + wl2p * spdvector[i].data[L2];
+            wlp = wl1p * spddata[L1][i] + wl2p * spddata[L2][i];
                // geometry-free range (m)
-            gfr = spdvector[i].data[P1] - spdvector[i].data[P2];
+            gfr = spddata[P1][i] - spddata[P2][i];
                // geometry-free phase (m)
-            gfp = gf1p * spdvector[i].data[L1] + gf2p * spdvector[i].data[L2];
+            gfp = gf1p * spddata[L1][i] + gf2p * spddata[L2][i];
                // wide lane bias (cycles)
             wlbias = (wlp - wlr) / wlwl;
 
@@ -1208,10 +1109,10 @@ int GDCPass::linearCombinations()
             }
 
                // change the arrays
-            spdvector[i].data[L1] = gfp + gfr; // only used in GF
-            spdvector[i].data[L2] = gfp;
-            spdvector[i].data[P1] = wlbias;
-            spdvector[i].data[P2] = -gfr;
+            spddata[L1][i] = gfp + gfr; // only used in GF
+            spddata[L2][i] = gfp;
+            spddata[P1][i] = wlbias;
+            spddata[P2][i] = -gfr;
 
             it->npts++;
          }
@@ -1390,11 +1291,11 @@ int GDCPass::detectObviousSlips(string which)
          { // change segments
             if (outlier)
             {
-               if (spdvector[ibad].flag & OK)
+               if (spdflag[ibad] & OK)
                {
                   nok--;
                }
-               spdvector[ibad].flag = BAD;
+               spdflag[ibad] = BAD;
                learn[string("points deleted: ") + which +
                      string(" slip outlier")]++;
                outlier = false;
@@ -1403,13 +1304,13 @@ int GDCPass::detectObviousSlips(string which)
 
                // update nbeg and nend
             while (it->nbeg < it->nend && it->nbeg < static_cast<int>(size()) &&
-                   !(spdvector[it->nbeg].flag & OK))
+                   !(spdflag[it->nbeg] & OK))
             {
                it->nbeg++;
             }
 
             while (it->nend > it->nbeg && it->nend > 0 &&
-                   !(spdvector[it->nend].flag & OK))
+                   !(spdflag[it->nend] & OK))
             {
                it->nend--;
             }
@@ -1421,7 +1322,7 @@ int GDCPass::detectObviousSlips(string which)
             nok = 0;
          }
 
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          {
             continue;
          }
@@ -1433,7 +1334,7 @@ int GDCPass::detectObviousSlips(string which)
             nogood = false;
          } // igood is index of last good point
 
-         if (fabs(spdvector[i].data[A1]) > limit)
+         if (fabs(spddata[A1][i]) > limit)
          { // found an outlier (1st diff, cycles)
             outlier = true;
             ibad    = i; // ibad is index of last bad point
@@ -1442,18 +1343,18 @@ int GDCPass::detectObviousSlips(string which)
          { // this point good, but not past one(s)
             for (unsigned int j = igood + 1; j < ibad; j++)
             {
-               if (spdvector[j].flag & OK)
+               if (spdflag[j] & OK)
                {
                   nok--;
                }
-               if (spdvector[j].flag & DETECT)
+               if (spdflag[j] & DETECT)
                {
                   log << "Warning - found an obvious slip, "
                       << "but marking BAD a point already marked with slip "
                       << GDCUnique << " " << sat << " "
                       << printTime(time(j), outFormat) << " " << j << endl;
                }
-               spdvector[j].flag = BAD; // mark all points between as bad
+               spdflag[j] = BAD; // mark all points between as bad
                learn[string("points deleted: ") + which +
                      string(" slip outlier")]++;
             }
@@ -1464,19 +1365,19 @@ int GDCPass::detectObviousSlips(string which)
             it = createSegment(it, ibad, which + string(" slip gross"));
 
                // mark it
-            spdvector[ibad].flag |=
+            spdflag[ibad] |=
                (which == string("WL") ? WLDETECT : GFDETECT);
 
                // change the bias in the new segment
             if (which == "WL")
             {
-               wlbias = spdvector[ibad].data[P1];
+               wlbias = spddata[P1][ibad];
                it->bias1 =
                   long(wlbias + (wlbias > 0 ? 0.5 : -0.5)); // WL bias (NWL)
             }
             if (which == "GF")
             {
-               it->bias2 = spdvector[ibad].data[L2]; // GFP bias
+               it->bias2 = spddata[L2][ibad]; // GFP bias
             }
 
                // prep for next point
@@ -1524,9 +1425,9 @@ int GDCPass::firstDifferences(string which)
       for (i = 0; i < static_cast<int>(size()); i++)
       {
             // ignore bad data
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          {
-            spdvector[i].data[A1] = spdvector[i].data[A2] = 0.0;
+            spddata[A1][i] = spddata[A2][i] = 0.0;
             continue;
          }
 
@@ -1535,28 +1436,28 @@ int GDCPass::firstDifferences(string which)
          {
             if (iprev == -1)
             {
-               spdvector[i].data[A1] = 0.0;
+               spddata[A1][i] = 0.0;
             }
             else
             {
-               spdvector[i].data[A1] =
-                  (spdvector[i].data[P1] - spdvector[iprev].data[P1]);
+               spddata[A1][i] =
+                  (spddata[P1][i] - spddata[P1][iprev]);
             }
          }
          else if (which == string("GF"))
          {
             if (iprev == -1) // first difference not defined at first point
             {
-               spdvector[i].data[A1] = spdvector[i].data[A2] = 0.0;
+               spddata[A1][i] = spddata[A2][i] = 0.0;
             }
             else
             {
                   // compute first difference of L1 = raw residual GFP-GFR
-               spdvector[i].data[A1] =
-                  (spdvector[i].data[L1] - spdvector[iprev].data[L1]);
+               spddata[A1][i] =
+                  (spddata[L1][i] - spddata[L1][iprev]);
                   // compute first difference of L2 = GFP
-               spdvector[i].data[A2] =
-                  (spdvector[i].data[L2] - spdvector[iprev].data[L2]);
+               spddata[A2][i] =
+                  (spddata[L2][i] - spddata[L2][iprev]);
             }
          }
 
@@ -1596,11 +1497,11 @@ void GDCPass::WLcomputeStats(list<Segment>::iterator& it)
          // loop over data, adding to Stats, and counting good points
       for (unsigned int i = it->nbeg; i <= it->nend; i++)
       {
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          {
             continue;
          }
-         it->WLStats.Add(spdvector[i].data[P1] - it->bias1);
+         it->WLStats.Add(spddata[P1][i] - it->bias1);
          it->npts++;
       }
 
@@ -1654,11 +1555,11 @@ void GDCPass::WLsigmaStrip(list<Segment>::iterator& it)
             // from nbeg
          for (j = i = it->nbeg; i <= it->nend; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
-            wlbias = spdvector[i].data[P1] - it->bias1;
+            wlbias = spddata[P1][i] - it->bias1;
             vecA1.push_back(wlbias);
             vecA2.push_back(0.0);
             j++;
@@ -1673,22 +1574,22 @@ void GDCPass::WLsigmaStrip(list<Segment>::iterator& it)
             // weights copy temps out into A1 and A2
          for (k = 0, i = it->nbeg; i < j; k++, i++)
          {
-            spdvector[i].data[A1] = vecA1[k];
-            spdvector[i].data[A2] = vecA2[k];
+            spddata[A1][i] = vecA1[k];
+            spddata[A2][i] = vecA2[k];
          }
 
          haveslip = false;
          for (j = i = it->nbeg; i <= it->nend; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
 
-            wlbias = spdvector[i].data[P1] - it->bias1;
+            wlbias = spddata[P1][i] - it->bias1;
 
             if (fabs(wlbias - ave) > nsigma ||
-                spdvector[j].data[A2] < cfg(WLRobustWeightLimit))
+                spddata[A2][j] < cfg(WLRobustWeightLimit))
             {
                outlier = true;
             }
@@ -1700,31 +1601,31 @@ void GDCPass::WLsigmaStrip(list<Segment>::iterator& it)
                // remove points by sigma stripping
             if (outlier)
             {
-               if (spdvector[i].flag & DETECT || i == it->nbeg)
+               if (spdflag[i] & DETECT || i == it->nbeg)
                {
                   haveslip  = true;
                   slipindex = i;            // mark
-                  slip = spdvector[i].flag; // save to put on first good point
+                  slip = spdflag[i]; // save to put on first good point
                }
-               spdvector[i].flag = BAD;
+               spdflag[i] = BAD;
                learn["points deleted: WL sigma stripping"]++;
                it->npts--;
                it->WLStats.Subtract(wlbias);
             }
             else if (haveslip)
             {
-               spdvector[i].flag = slip;
-               haveslip          = false;
+               spdflag[i] = slip;
+               haveslip   = false;
             }
 
             if (cfg(Debug) >= 6)
             {
                log << "DSCWLR " << GDCUnique << " " << sat << " " << it->nseg
                    << " " << printTime(time(i), outFormat) << fixed
-                   << setprecision(3) << " " << setw(3) << spdvector[i].flag
-                   << " " << setw(13) << spdvector[j].data[A1] // wlbias
+                   << setprecision(3) << " " << setw(3) << spdflag[i]
+                   << " " << setw(13) << spddata[A1][j] // wlbias
                    << " " << setw(13) << fabs(wlbias - ave) << " " << setw(5)
-                   << spdvector[j].data[A2] // 0 <= weight <= 1
+                   << spddata[A2][j] // 0 <= weight <= 1
                    << " " << setw(3) << i << (outlier ? " outlier" : "");
                if (i == it->nbeg)
                {
@@ -1747,31 +1648,31 @@ void GDCPass::WLsigmaStrip(list<Segment>::iterator& it)
          ave      = it->WLStats.Average();
          for (i = it->nbeg; i <= it->nend; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
 
-            wlbias = spdvector[i].data[P1] - it->bias1;
+            wlbias = spddata[P1][i] - it->bias1;
 
                // remove points by sigma stripping
             if (fabs(wlbias - ave) > nsigma)
             { // TD add absolute limit?
-               if (spdvector[i].flag & DETECT)
+               if (spdflag[i] & DETECT)
                {
                   haveslip  = true;
                   slipindex = i;            // mark
-                  slip = spdvector[i].flag; // save to put on first good point
+                  slip = spdflag[i]; // save to put on first good point
                }
-               spdvector[i].flag = BAD;
+               spdflag[i] = BAD;
                learn["points deleted: WL sigma stripping"]++;
                it->npts--;
                it->WLStats.Subtract(wlbias);
             }
             else if (haveslip)
             {
-               spdvector[i].flag = slip;
-               haveslip          = false;
+               spdflag[i] = slip;
+               haveslip   = false;
             }
 
          } // loop over points in segment
@@ -1791,11 +1692,11 @@ void GDCPass::WLsigmaStrip(list<Segment>::iterator& it)
       else
       {
             // update nbeg and nend // TD add limit 0 size()
-         while (it->nbeg < it->nend && !(spdvector[it->nbeg].flag & OK))
+         while (it->nbeg < it->nend && !(spdflag[it->nbeg] & OK))
          {
             it->nbeg++;
          }
-         while (it->nend > it->nbeg && !(spdvector[it->nend].flag & OK))
+         while (it->nend > it->nbeg && !(spdflag[it->nend] & OK))
          {
             it->nend--;
          }
@@ -1850,9 +1751,9 @@ int GDCPass::WLstatSweep(list<Segment>::iterator& it, int width)
             segment */
       while (futureStats.N() < uwidth && iplus <= it->nend)
       {
-         if (spdvector[iplus].flag & OK)
+         if (spdflag[iplus] & OK)
          { // add only good data
-            futureStats.Add(spdvector[iplus].data[P1] - it->bias1);
+            futureStats.Add(spddata[P1][iplus] - it->bias1);
          }
          iplus++;
       }
@@ -1860,7 +1761,7 @@ int GDCPass::WLstatSweep(list<Segment>::iterator& it, int width)
          // now loop over all points in the segment
       for (i = it->nbeg; i <= it->nend; i++)
       {
-         if (!(spdvector[i].flag & OK)) // add only good data
+         if (!(spdflag[i] & OK)) // add only good data
          {
             continue;
          }
@@ -1873,10 +1774,10 @@ int GDCPass::WLstatSweep(list<Segment>::iterator& it, int width)
          }
          limit = ::sqrt(futureStats.Variance() + pastStats.Variance());
             // 'change the arrays' A1 and A2
-         spdvector[i].data[A1] = test;
-         spdvector[i].data[A2] = limit;
+         spddata[A1][i] = test;
+         spddata[A2][i] = limit;
 
-         wlbias = spdvector[i].data[P1] - it->bias1; // debiased WLbias
+         wlbias = spddata[P1][i] - it->bias1; // debiased WLbias
 
             // dump the stats
          if (cfg(Debug) >= 6)
@@ -1888,8 +1789,8 @@ int GDCPass::WLstatSweep(list<Segment>::iterator& it, int width)
                 << " " << setw(3) << futureStats.N() << " " << setw(7)
                 << futureStats.Average() << " " << setw(7)
                 << futureStats.StdDev() << " " << setw(9)
-                << spdvector[i].data[A1] << " " << setw(9)
-                << spdvector[i].data[A2] << " " << setw(9) << wlbias << " "
+                << spddata[A1][i] << " " << setw(9)
+                << spddata[A2][i] << " " << setw(9) << wlbias << " "
                 << setw(3) << i << endl;
          }
 
@@ -1900,18 +1801,18 @@ int GDCPass::WLstatSweep(list<Segment>::iterator& it, int width)
             // ... and move iplus up by one (good) point, ...
          while (futureStats.N() < uwidth && iplus <= it->nend)
          {
-            if (spdvector[iplus].flag & OK)
+            if (spdflag[iplus] & OK)
             {
-               futureStats.Add(spdvector[iplus].data[P1] - it->bias1);
+               futureStats.Add(spddata[P1][iplus] - it->bias1);
             }
             iplus++;
          }
             // ... and move iminus up by one good point
          while (static_cast<int>(pastStats.N()) > uwidth && iminus <= it->nend)
          {
-            if (spdvector[iminus].flag & OK)
+            if (spdflag[iminus] & OK)
             {
-               pastStats.Subtract(spdvector[iminus].data[P1] - it->bias1);
+               pastStats.Subtract(spddata[P1][iminus] - it->bias1);
             }
             iminus++;
          }
@@ -1986,13 +1887,13 @@ int GDCPass::detectWLsmallSlips()
             }
          }
 
-         if (spdvector[i].flag & OK)
+         if (spdflag[i] & OK)
          {
             nok++; // nok = # good points in segment
 
             if (nok == 1)
             { // change the bias, as WLStats reset
-               wlbias    = spdvector[i].data[P1];
+               wlbias    = spddata[P1][i];
                it->bias1 = long(wlbias + (wlbias > 0 ? 0.5 : -0.5));
             }
 
@@ -2007,7 +1908,7 @@ int GDCPass::detectWLsmallSlips()
                   log << "too near end " << GDCUnique << " " << i << " " << nok
                       << " " << it->npts - nok << " "
                       << printTime(time(i), outFormat) << " "
-                      << spdvector[i].data[A1] << " " << spdvector[i].data[A2]
+                      << spddata[A1][i] << " " << spddata[A2][i]
                       << endl;
                }
             }
@@ -2022,7 +1923,7 @@ int GDCPass::detectWLsmallSlips()
                it = createSegment(it, i, "WL slip small");
 
                   // mark it
-               spdvector[i].flag |= WLDETECT;
+               spdflag[i] |= WLDETECT;
 
                   // prep for next segment
                   // biases remain the same in the new segment
@@ -2030,11 +1931,11 @@ int GDCPass::detectWLsmallSlips()
                nok      = 0;
                it->WLStats.Reset();
                wlbias =
-                  spdvector[i].data[P1]; // change the bias, as WLStats reset
+                  spddata[P1][i]; // change the bias, as WLStats reset
                it->bias1 = long(wlbias + (wlbias > 0 ? 0.5 : -0.5));
             }
 
-            it->WLStats.Add(spdvector[i].data[P1] - it->bias1);
+            it->WLStats.Add(spddata[P1][i] - it->bias1);
 
          } // end if good data
 
@@ -2083,8 +1984,8 @@ bool GDCPass::foundWLsmallSlip(list<Segment>::iterator& it, int i)
          /* A1 = step = fabs(futureStats.Average() - pastStats.Average());
             A2 = limit = ::sqrt(futureStats.Variance() + pastStats.Variance());
             all units WL cycles */
-      double step = spdvector[i].data[A1];
-      double lim  = spdvector[i].data[A2];
+      double step = spddata[A1][i];
+      double lim  = spddata[A2][i];
 
          // 050109 if Debug=6, print only possible slips, if 7 print all
       bool isSlip = false, halfCycle = false;
@@ -2098,11 +1999,11 @@ bool GDCPass::foundWLsmallSlip(list<Segment>::iterator& it, int i)
              << printTime(time(i), outFormat)
              //<< " " << it->npts << "pt"
              << fixed << setprecision(2) << " step=" << step << " lim=" << lim
-             << " (1)" << spdvector[i].data[A1]
-             << (spdvector[i].data[A1] > cfg(WLSlipSize) ? ">" : "<=")
+             << " (1)" << spddata[A1][i]
+             << (spddata[A1][i] > cfg(WLSlipSize) ? ">" : "<=")
              << cfg(WLSlipSize) << " (2)"
-             << spdvector[i].data[A1] - spdvector[i].data[A2]
-             << (spdvector[i].data[A1] - spdvector[i].data[A2] >
+             << spddata[A1][i] - spddata[A2][i]
+             << (spddata[A1][i] - spddata[A2][i] >
                        cfg(WLSlipExcess)
                     ? ">"
                     : "<=")
@@ -2159,7 +2060,7 @@ bool GDCPass::foundWLsmallSlip(list<Segment>::iterator& it, int i)
          do
          {
             jp++;
-         } while (jp < it->nend && !(spdvector[jp].flag & OK));
+         } while (jp < it->nend && !(spdflag[jp] & OK));
 
          if (jp >= it->nend)
          {
@@ -2167,13 +2068,13 @@ bool GDCPass::foundWLsmallSlip(list<Segment>::iterator& it, int i)
          }
 
             // CONDITION 4: test(A1) is a local maximum
-         if (spdvector[i].data[A1] - spdvector[jp].data[A1] > j * slope)
+         if (spddata[A1][i] - spddata[A1][jp] > j * slope)
          {
             pass4++;
          }
 
             // CONDITION 5: limit(A2) is a local minimum
-         if (spdvector[i].data[A2] - spdvector[jp].data[A2] < -(j * slope))
+         if (spddata[A2][i] - spddata[A2][jp] < -(j * slope))
          {
             pass5++;
          }
@@ -2182,19 +2083,19 @@ bool GDCPass::foundWLsmallSlip(list<Segment>::iterator& it, int i)
          do
          {
             jm--;
-         } while (jm > it->nbeg && !(spdvector[jm].flag & OK));
+         } while (jm > it->nbeg && !(spdflag[jm] & OK));
 
          if (jm <= it->nbeg)
          {
             break;
          }
             // CONDITION 4: test(A1) is a local maximum
-         if (spdvector[i].data[A1] - spdvector[jm].data[A1] > j * slope)
+         if (spddata[A1][i] - spddata[A1][jm] > j * slope)
          {
             pass4++;
          }
             // CONDITION 5: limit(A2) is a local minimum
-         if (spdvector[i].data[A2] - spdvector[jm].data[A2] < -(j * slope))
+         if (spddata[A2][i] - spddata[A2][jm] < -(j * slope))
          {
             pass5++;
          }
@@ -2334,11 +2235,11 @@ int GDCPass::fixAllSlips(string which)
          WLPassStats.Reset();
          for (i = kt->nbeg; i <= kt->nend; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
-            WLPassStats.Add(spdvector[i].data[P1] - kt->bias1);
+            WLPassStats.Add(spddata[P1][i] - kt->bias1);
          }
       }
          // change the biases - reset the GFP bias so that it matches the GFR
@@ -2348,19 +2249,19 @@ int GDCPass::fixAllSlips(string which)
          bool first(true);
          for (i = kt->nbeg; i <= kt->nend; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
             if (first)
             {
                first     = false;
-               kt->bias2 = spdvector[i].data[L2] + spdvector[i].data[P2];
-               kt->bias1 = spdvector[i].data[P1];
+               kt->bias2 = spddata[L2][i] + spddata[P2][i];
+               kt->bias1 = spddata[P1][i];
             }
                // change the data - recompute GFR-GFP so it has one consistent bias
-            spdvector[i].data[L1] =
-               spdvector[i].data[L2] + spdvector[i].data[P2];
+            spddata[L1][i] =
+               spddata[L2][i] + spddata[P2][i];
          }
       }
 
@@ -2511,10 +2412,10 @@ void GDCPass::WLslipFix(list<Segment>::iterator& left,
             left's */
       for (i = right->nbeg; i <= right->nend; i++)
       {
-            /* if(!(spdvector[i].flag & OK)) continue;
+            /* if(!(spdflag[i] & OK)) continue;
                'change the data' */
-         spdvector[i].data[P1] -= nwl;       // WLbias
-         spdvector[i].data[L2] -= nwl * wl2; // GFP
+         spddata[P1][i] -= nwl;       // WLbias
+         spddata[L2][i] -= nwl * wl2; // GFP
       }
 
          /* fix the slips beyond the 'right' segment.
@@ -2529,8 +2430,8 @@ void GDCPass::WLslipFix(list<Segment>::iterator& left,
          it->bias1 -= dwl;
          for (i = it->nbeg; i <= it->nend; i++)
          {
-            spdvector[i].data[P1] -= nwl;       // WLbias
-            spdvector[i].data[L2] -= nwl * wl2; // GFP
+            spddata[P1][i] -= nwl;       // WLbias
+            spddata[L2][i] -= nwl * wl2; // GFP
          }
       }
 
@@ -2541,7 +2442,7 @@ void GDCPass::WLslipFix(list<Segment>::iterator& left,
       SlipList.push_back(newSlip);
 
          // mark it
-      spdvector[right->nbeg].flag |= WLFIX;
+      spdflag[right->nbeg] |= WLFIX;
 
       return;
    }
@@ -2586,7 +2487,7 @@ void GDCPass::GFslipFix(list<Segment>::iterator& left,
       ilast = -1; // ilast is last good point before slip
       while (nb > left->nbeg && i < Npts)
       {
-         if (spdvector[nb].flag & OK)
+         if (spdflag[nb] & OK)
          {
             if (ilast == -1)
             {
@@ -2594,9 +2495,9 @@ void GDCPass::GFslipFix(list<Segment>::iterator& left,
             }
             i++;
             nl++;
-            Lstats.Add(spdvector[nb].data[L1] - left->bias2);
+            Lstats.Add(spddata[L1][nb] - left->bias2);
                // log << "LDATA " << nb << " " <<
-               // spdvector[nb].data[L1]-left->bias2 << endl;
+               // spddata[L1][nb]-left->bias2 << endl;
          }
          nb--;
       }
@@ -2605,13 +2506,13 @@ void GDCPass::GFslipFix(list<Segment>::iterator& left,
       nr = 0;
       while (ne < right->nend && i < Npts)
       {
-         if (spdvector[ne].flag & OK)
+         if (spdflag[ne] & OK)
          {
             i++;
             nr++;
-            Rstats.Add(spdvector[ne].data[L1] - right->bias2);
+            Rstats.Add(spddata[L1][ne] - right->bias2);
                // log << "RDATA " << ne << " " <<
-               // spdvector[ne].data[L1]-right->bias2 <<endl;
+               // spddata[L1][ne]-right->bias2 <<endl;
          }
          ne++;
       }
@@ -2623,8 +2524,8 @@ void GDCPass::GFslipFix(list<Segment>::iterator& left,
             thing to do.... ultimately, GFR-GFP is accurate but noisy. rms rof
             should tell you how much weight to put on rof larger rof -> smaller
             npts and larger degree */
-      dn1 = spdvector[right->nbeg].data[L2] - right->bias2 -
-            (spdvector[ilast].data[L2] - left->bias2);
+      dn1 = spddata[L2][right->nbeg] - right->bias2 -
+            (spddata[L2][ilast] - left->bias2);
       n1 = long(dn1 + (dn1 > 0 ? 0.5 : -0.5));
 
          // estimate the slip using polynomial fits - this prints GFE data
@@ -2681,8 +2582,8 @@ void GDCPass::GFslipFix(list<Segment>::iterator& left,
             and through the end of the pass, to fix the slip */
       for (i = right->nbeg; i < static_cast<int>(size()); i++)
       {
-         spdvector[i].data[L2] -= n1; // GFP
-         spdvector[i].data[L1] -= n1; // GFR+GFP
+         spddata[L2][i] -= n1; // GFP
+         spddata[L1][i] -= n1; // GFR+GFP
       }
 
          /* 'change the bias' for all segments in the future (although right to be
@@ -2713,7 +2614,7 @@ void GDCPass::GFslipFix(list<Segment>::iterator& left,
       }
 
          // mark it
-      spdvector[right->nbeg].flag |= GFFIX;
+      spdflag[right->nbeg] |= GFFIX;
 
       return;
    }
@@ -2772,19 +2673,19 @@ long GDCPass::EstimateGFslipFix(list<Segment>::iterator& left,
                // add all the data
             for (i = nb; i <= ne; i++)
             {
-               if (!(spdvector[i].flag & OK))
+               if (!(spdflag[i] & OK))
                {
                   continue;
                }
                PF[in[k]].Add(
                      // data
-                  spdvector[i].data[L2]
+                  spddata[L2][i]
                         // - (either               left bias - poss. slip : right
                         // bias)
                      - (i < right->nbeg ? left->bias2 - n1 - (nadj + k - 1)
                                         : right->bias2),
                      //  use a debiased count
-                  spdvector[i].ndt - spdvector[nb].ndt);
+                  spdndt[i] - spdndt[nb]);
             }
 
                // TD check that it not singular
@@ -2793,15 +2694,15 @@ long GDCPass::EstimateGFslipFix(list<Segment>::iterator& left,
             rmsrof[in[k]] = 0.0;
             for (i = nb; i <= ne; i++)
             {
-               if (!(spdvector[i].flag & OK))
+               if (!(spdflag[i] & OK))
                {
                   continue;
                }
                rof = // data minus fit
-                  spdvector[i].data[L2] -
+                  spddata[L2][i] -
                   (i < right->nbeg ? left->bias2 - n1 - (nadj + k - 1)
                                    : right->bias2) -
-                  PF[in[k]].Evaluate(spdvector[i].ndt - spdvector[nb].ndt);
+                  PF[in[k]].Evaluate(spdndt[i] - spdndt[nb]);
                rmsrof[in[k]] += rof * rof;
             }
             rmsrof[in[k]] = ::sqrt(rmsrof[in[k]]);
@@ -2875,21 +2776,21 @@ long GDCPass::EstimateGFslipFix(list<Segment>::iterator& left,
          log << "EstimateGFslipFix dump " << endl;
          for (i = nb; i <= ne; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
             log << "GFE " << GDCUnique << " " << sat << " " << GDCUniqueFix
                 << " " << printTime(time(i), outFormat) << " " << setw(2)
-                << spdvector[i].flag << fixed << setprecision(3);
+                << spdflag[i] << fixed << setprecision(3);
             for (k = 0; k < 3; k++)
                log << " "
-                   << spdvector[i].data[L2] -
+                   << spddata[L2][i] -
                          (i < right->nbeg ? left->bias2 - n1 - (nadj + k - 1)
                                           : right->bias2)
                    << " "
-                   << PF[in[k]].Evaluate(spdvector[i].ndt - spdvector[nb].ndt);
-            log << " " << setw(3) << spdvector[i].ndt << endl;
+                   << PF[in[k]].Evaluate(spdndt[i] - spdndt[nb]);
+            log << " " << setw(3) << spdndt[i] << endl;
          }
       }
 
@@ -2928,7 +2829,7 @@ int GDCPass::prepareGFdata()
 
       for (first = true, i = nbeg; i <= nend; i++)
       {
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          {
             continue;
          }
@@ -2943,13 +2844,13 @@ int GDCPass::prepareGFdata()
 
             /* 'change the arrays'
                change units on the GFP and the GFR */
-         spdvector[i].data[P2] /= wlgf; // -gfr (cycles of wlgf)
-         spdvector[i].data[L2] /= wlgf; // gfp (cycles of wlgf)
+         spddata[P2][i] /= wlgf; // -gfr (cycles of wlgf)
+         spddata[L2][i] /= wlgf; // gfp (cycles of wlgf)
 
             /* 'change the data'
                save in L1                          // gfp+gfr residual (cycles of
                wlgf) */
-         spdvector[i].data[L1] = spdvector[i].data[L2] - spdvector[i].data[P2];
+         spddata[L1][i] = spddata[L2][i] - spddata[P2][i];
       }
 
       return ReturnOK;
@@ -2993,7 +2894,7 @@ int GDCPass::detectGFslips()
             // compute stats on dGF/dt
          for (i = it->nbeg; i <= it->nend; i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue;
             }
@@ -3002,7 +2903,7 @@ int GDCPass::detectGFslips()
                   skip the first point in a segment - it is an obvious GF slip */
             if (i > it->nbeg)
             {
-               GFPassStats.Add(spdvector[i].data[A1] * wlgf);
+               GFPassStats.Add(spddata[A1][i] * wlgf);
             }
 
          } // end loop over data in segment it
@@ -3099,11 +3000,11 @@ int GDCPass::GFphaseResiduals(list<Segment>::iterator& it)
 
       for (i = it->nbeg; i <= it->nend; i++)
       {
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          {
             continue;
          }
-         it->PF.Add(spdvector[i].data[P2], spdvector[i].ndt);
+         it->PF.Add(spddata[P2][i], spdndt[i]);
       }
 
       if (it->PF.isSingular())
@@ -3119,12 +3020,12 @@ int GDCPass::GFphaseResiduals(list<Segment>::iterator& it)
       for (i = it->nbeg; i <= it->nend; i++)
       {
             // skip bad data
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          {
             continue;
          }
 
-         fit = it->PF.Evaluate(spdvector[i].ndt);
+         fit = it->PF.Evaluate(spdndt[i]);
 
             /* all (fit, resid, gfr and gfp) are in cycles of wlgf (5.4cm)
 
@@ -3132,25 +3033,25 @@ int GDCPass::GFphaseResiduals(list<Segment>::iterator& it)
                A2 OR let's try first difference of residual of fit
                          residual =  phase                            - fit to
                          range */
-         spdvector[i].data[A1] = spdvector[i].data[L2] - it->bias2 - fit;
+         spddata[A1][i] = spddata[L2][i] - it->bias2 - fit;
          if (rbias == 0.0)
          {
-            rbias = spdvector[i].data[A1];
-            nprev = spdvector[i].ndt - 1;
+            rbias = spddata[A1][i];
+            nprev = spdndt[i] - 1;
          }
-         spdvector[i].data[A1] -= rbias; // debias residual for plots
+         spddata[A1][i] -= rbias; // debias residual for plots
 
             // compute stats on residual of fit
-         rofStats.Add(spdvector[i].data[A1]);
+         rofStats.Add(spddata[A1][i]);
 
          if (1)
          { // 1stD of residual - remember A1 has just been debiased
-            tmp = spdvector[i].data[A1];
-            spdvector[i].data[A1] -= prev; // diff with previous epoch's
+            tmp = spddata[A1][i];
+            spddata[A1][i] -= prev; // diff with previous epoch's
                // 040809 should this be divided by delta n?
-               // spdvector[i].data[A1] /= (spdvector[i].ndt - nprev);
+               // spddata[A1][i] /= (spdndt[i] - nprev);
             prev  = tmp; // store residual for next point
-            nprev = spdvector[i].ndt;
+            nprev = spdndt[i];
          }
       }
 
@@ -3213,7 +3114,7 @@ int GDCPass::detectGFsmallSlips()
          {
                // ignore bad points
             if (iplus <= static_cast<int>(it->nend) &&
-                !(spdvector[iplus].flag & OK))
+                !(spdflag[iplus] & OK))
             {
                continue;
             }
@@ -3228,7 +3129,7 @@ int GDCPass::detectGFsmallSlips()
             {
                inew = futureIndex.front();
                futureIndex.pop_front();
-               futureStats.Subtract(spdvector[inew].data[A1]);
+               futureStats.Subtract(spddata[A1][inew]);
                nok++;
             }
 
@@ -3236,7 +3137,7 @@ int GDCPass::detectGFsmallSlips()
             if (iplus <= static_cast<int>(it->nend))
             {
                futureIndex.push_back(iplus);
-               futureStats.Add(spdvector[iplus].data[A1]);
+               futureStats.Add(spddata[A1][iplus]);
             }
             else
             {
@@ -3255,18 +3156,18 @@ int GDCPass::detectGFsmallSlips()
             {
                   /* check that i was not marked a slip in the last iteration
                      if so, let inew be the slip and i the outlier */
-               if (spdvector[i].flag & DETECT)
+               if (spdflag[i] & DETECT)
                {
                      /* log << "Warning - marking a slip point BAD in GF detect
                         small "
                           << GDCUnique << " " << sat
                           << " " << printTime(time(i),outFormat) << " " << i <<
                           endl; */
-                  spdvector[inew].flag = spdvector[i].flag;
-                  it->nbeg             = inew;
+                  spdflag[inew] = spdflag[i];
+                  it->nbeg      = inew;
                }
-               spdvector[i].flag = BAD;
-               spdvector[inew].data[A1] += spdvector[i].data[A1];
+               spdflag[i] = BAD;
+               spddata[A1][inew] += spddata[A1][i];
                learn["points deleted: GF outlier"]++;
                i = inew;
                nok--;
@@ -3277,14 +3178,14 @@ int GDCPass::detectGFsmallSlips()
             {
                j = pastIndex.front();
                pastIndex.pop_front();
-               pastStats.Subtract(spdvector[j].data[A1]);
+               pastStats.Subtract(spddata[A1][j]);
             }
 
                // move i into the past
             if (i > -1)
             {
                pastIndex.push_back(i);
-               pastStats.Add(spdvector[i].data[A1]);
+               pastStats.Add(spddata[A1][i]);
             }
 
                // return to original state
@@ -3301,7 +3202,7 @@ int GDCPass::detectGFsmallSlips()
                nok      = 1;
 
                   // mark it
-               spdvector[i].flag |= GFDETECT;
+               spdflag[i] |= GFDETECT;
             }
 
          } // end loop over points in the pass
@@ -3338,8 +3239,8 @@ bool GDCPass::foundGFoutlier(int i, int inew, Stats<double>& pastSt,
          return false;
       }
       bool ok;
-      double pmag = spdvector[i].data[A1];    // -pastSt.Average();
-      double fmag = spdvector[inew].data[A1]; // -futureSt.Average();
+      double pmag = spddata[A1][i];    // -pastSt.Average();
+      double fmag = spddata[A1][inew]; // -futureSt.Average();
       double var  = ::sqrt(pastSt.Variance() + futureSt.Variance());
 
       ostringstream oss;
@@ -3439,11 +3340,11 @@ bool GDCPass::foundGFsmallSlip(int i, int nseg, int iend, int ibeg,
          // TD be very careful when N is small
       if (pastSt.N() > 0)
       {
-         pmag = spdvector[i].data[A1] - pastSt.Average();
+         pmag = spddata[A1][i] - pastSt.Average();
       }
       if (futureSt.N() > 0)
       {
-         fmag = spdvector[i].data[A1] - futureSt.Average();
+         fmag = spddata[A1][i] - futureSt.Average();
       }
       if (pastSt.N() > 1)
       {
@@ -3476,7 +3377,7 @@ bool GDCPass::foundGFsmallSlip(int i, int nseg, int iend, int ibeg,
              << " " << setw(3) << futureSt.N() << " " << setw(7)
              << futureSt.Average() << " " << setw(7) << futureSt.StdDev() << " "
              << setw(7) << mag << " " << setw(7) << ::sqrt(pvar + fvar) << " "
-             << setw(9) << spdvector[i].data[A1] << " " << setw(7) << pmag
+             << setw(9) << spddata[A1][i] << " " << setw(7) << pmag
              << " " << setw(7) << pvar << " " << setw(7) << fmag << " "
              << setw(7) << fvar << " " << setw(3) << i << endl;
       }
@@ -3597,11 +3498,11 @@ bool GDCPass::foundGFsmallSlip(int i, int nseg, int iend, int ibeg,
             {
                if (pastIn[j] > -1)
                {
-                  pGFRmPh.Add(spdvector[pastIn[j]].data[L1]);
+                  pGFRmPh.Add(spddata[L1][pastIn[j]]);
                }
                if (futureIn[j] > -1)
                {
-                  fGFRmPh.Add(spdvector[futureIn[j]].data[L1]);
+                  fGFRmPh.Add(spddata[L1][futureIn[j]]);
                }
             }
             magGFR = fGFRmPh.Average() - pGFRmPh.Average();
@@ -3654,9 +3555,9 @@ bool GDCPass::foundGFsmallSlip(int i, int nseg, int iend, int ibeg,
             k = 0;
             while (j >= ibeg && k < 15)
             {
-               if (spdvector[j].flag & OK)
+               if (spdflag[j] & OK)
                {
-                  fdStats.Add(spdvector[j].data[A2]);
+                  fdStats.Add(spddata[A2][j]);
                   k++;
                }
                j--;
@@ -3665,14 +3566,14 @@ bool GDCPass::foundGFsmallSlip(int i, int nseg, int iend, int ibeg,
             k = 0;
             while (j <= iend && k < 15)
             {
-               if (spdvector[j].flag & OK)
+               if (spdflag[j] & OK)
                {
-                  fdStats.Add(spdvector[j].data[A2]);
+                  fdStats.Add(spddata[A2][j]);
                   k++;
                }
                j++;
             }
-            magFD = spdvector[i].data[A2] - fdStats.Average();
+            magFD = spddata[A2][i] - fdStats.Average();
 
             if (cfg(Debug) >= 6)
             {
@@ -3685,7 +3586,7 @@ bool GDCPass::foundGFsmallSlip(int i, int nseg, int iend, int ibeg,
          }
 
             // 8. if switch is on and there is no WL slip here - skip
-         if (cfg(GFSkipSmall) && !(spdvector[i].flag & WLDETECT))
+         if (cfg(GFSkipSmall) && !(spdflag[i] & WLDETECT))
          {
             if (cfg(Debug) >= 6)
             {
@@ -3745,15 +3646,15 @@ int GDCPass::WLconsistencyCheck()
       for (i = 0; i < static_cast<int>(size()); i++)
       {
 
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          {
             continue; // bad
          }
-         if (!(spdvector[i].flag & DETECT))
+         if (!(spdflag[i] & DETECT))
          {
             continue; // no slips
          }
-         if (spdvector[i].flag & WLDETECT)
+         if (spdflag[i] & WLDETECT)
          {
             continue; // WL was detected
          }
@@ -3765,9 +3666,9 @@ int GDCPass::WLconsistencyCheck()
          while (k < static_cast<int>(size()) &&
                 static_cast<int>(futureStats.N()) < N)
          {
-            if (spdvector[k].flag & OK)                // data is good
+            if (spdflag[k] & OK)                // data is good
             {
-               futureStats.Add(spdvector[k].data[P1]); // wlbias
+               futureStats.Add(spddata[P1][k]); // wlbias
             }
             k++;
          }
@@ -3775,9 +3676,9 @@ int GDCPass::WLconsistencyCheck()
          k = i - 1;
          while (k >= 0 && static_cast<int>(pastStats.N()) < N)
          {
-            if (spdvector[k].flag & OK)              // data is good
+            if (spdflag[k] & OK)              // data is good
             {
-               pastStats.Add(spdvector[k].data[P1]); // wlbias
+               pastStats.Add(spddata[P1][k]); // wlbias
             }
             k--;
          }
@@ -3803,10 +3704,10 @@ int GDCPass::WLconsistencyCheck()
                // now do the fixing - change the data to the future of the slip
             for (k = i; k < static_cast<int>(size()); k++)
             {
-                  /* if(!(spdvector[i].flag & OK)) continue;
+                  /* if(!(spdflag[i] & OK)) continue;
                      'change the data' */
-               spdvector[k].data[P1] -= nwl;          // WLbias
-               spdvector[k].data[L2] -= nwl * factor; // GFP
+               spddata[P1][k] -= nwl;          // WLbias
+               spddata[L2][k] -= nwl * factor; // GFP
             }
 
                // Add to slip list
@@ -3816,7 +3717,7 @@ int GDCPass::WLconsistencyCheck()
             SlipList.push_back(newSlip);
 
                // mark it
-            spdvector[i].flag |= (WLDETECT + WLFIX);
+            spdflag[i] |= (WLDETECT + WLFIX);
 
             if (cfg(Debug) >= 7)
             {
@@ -3890,7 +3791,7 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
       {
 
             // is this point bad?
-         if (!(spdvector[i].flag & OK))
+         if (!(spdflag[i] & OK))
          { // data is bad
             ok = false;
             if (i == static_cast<int>(size()) - 1)
@@ -4042,10 +3943,10 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
          }
 
             // 'change the data' for the last time
-         spdvector[i].data[L1] = svp.data(i, DCobstypes[L1]) - slipL1;
-         spdvector[i].data[L2] = svp.data(i, DCobstypes[L2]) - slipL2;
-         spdvector[i].data[P1] = svp.data(i, DCobstypes[P1]);
-         spdvector[i].data[P2] = svp.data(i, DCobstypes[P2]);
+         spddata[L1][i] = svp.data(i, DCobstypes[L1]) - slipL1;
+         spddata[L2][i] = svp.data(i, DCobstypes[L2]) - slipL2;
+         spddata[P1][i] = svp.data(i, DCobstypes[P1]);
+         spddata[P2][i] = svp.data(i, DCobstypes[P2]);
 
             // compute range minus phase for output
             // do the same at the beginning ("BEG")
@@ -4053,25 +3954,25 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
             // compute WL and GFP
             // narrow lane range (m)
          double wlr =
-            wl1r * spdvector[i].data[P1] + wl2r * spdvector[i].data[P2];
+            wl1r * spddata[P1][i] + wl2r * spddata[P2][i];
             // wide lane phase (m)
          double wlp =
-            wl1p * spdvector[i].data[L1] + wl2p * spdvector[i].data[L2];
+            wl1p * spddata[L1][i] + wl2p * spddata[L2][i];
             // geo-free range (m)
          double gfr =
-            gf1r * spdvector[i].data[P1] + gf2r * spdvector[i].data[P2];
+            gf1r * spddata[P1][i] + gf2r * spddata[P2][i];
             // geo-free phase (m)
          double gfp =
-            gf1p * spdvector[i].data[L1] + gf2p * spdvector[i].data[L2];
+            gf1p * spddata[L1][i] + gf2p * spddata[L2][i];
          if (i == ifirst)
          {
             WLbias = (wlp - wlr) / wlwl;
             GFbias = gfp;
          }
-         spdvector[i].data[A1] =
+         spddata[A1][i] =
             (wlp - wlr) / wlwl - WLbias;       // wide lane bias (cyc)
-         spdvector[i].data[A2] = gfp - GFbias; // geo-free phase (m)
-            // spdvector[i].data[A2] = gfr - gfp;             // geo-free range -
+         spddata[A2][i] = gfp - GFbias; // geo-free phase (m)
+            // spddata[A2][i] = gfr - gfp;             // geo-free range -
             // phase (m)
 
       } // end loop over all data
@@ -4102,10 +4003,10 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
          // types
       for (i = 0; i < static_cast<int>(size()); i++)
       {
-         svp.data(i, DCobstypes[L1]) = spdvector[i].data[L1];
-         svp.data(i, DCobstypes[L2]) = spdvector[i].data[L2];
-         svp.data(i, DCobstypes[P1]) = spdvector[i].data[P1];
-         svp.data(i, DCobstypes[P2]) = spdvector[i].data[P2];
+         svp.data(i, DCobstypes[L1]) = spddata[L1][i];
+         svp.data(i, DCobstypes[L2]) = spddata[L2][i];
+         svp.data(i, DCobstypes[P1]) = spddata[P1][i];
+         svp.data(i, DCobstypes[P2]) = spddata[P2][i];
 
             /* change the flag for use by SatPass
                const unsigned short SatPass::OK  = 1; good data
@@ -4116,27 +4017,27 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
                const unsigned short GDCPass::DETECT   =   6;  // = WLDETECT |
                GFDETECT const unsigned short GDCPass::FIX      =  24;  // = WLFIX |
                GFFIX */
-         if (spdvector[i].flag & OK)
+         if (spdflag[i] & OK)
          {
-            if (((spdvector[i].flag & DETECT) == 0 &&
-                 (spdvector[i].flag & FIX) != 0) ||
+            if (((spdflag[i] & DETECT) == 0 &&
+                 (spdflag[i] & FIX) != 0) ||
                 i == ifirst)
             {
-               spdvector[i].flag = LL3 + OK;
+               spdflag[i] = LL3 + OK;
             }
             else
             {
-               spdvector[i].flag = OK;
+               spdflag[i] = OK;
             }
          }
          else
          {
-            spdvector[i].flag = BAD;
+            spdflag[i] = BAD;
          }
 
-         svp.LLI(i, DCobstypes[L1]) = (spdvector[i].flag & LL1) ? 1 : 0;
-         svp.LLI(i, DCobstypes[L2]) = (spdvector[i].flag & LL2) ? 1 : 0;
-         svp.setFlag(i, spdvector[i].flag);
+         svp.LLI(i, DCobstypes[L1]) = (spdflag[i] & LL1) ? 1 : 0;
+         svp.LLI(i, DCobstypes[L2]) = (spdflag[i] & LL2) ? 1 : 0;
+         svp.setFlag(i, spdflag[i]);
       }
 
          // ---------------------------------------------------------
@@ -4161,17 +4062,17 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
             {
                ifirst = static_cast<int>(it->nbeg);
                while (ifirst <= static_cast<int>(it->nend) &&
-                      !(spdvector[ifirst].flag & OK))
+                      !(spdflag[ifirst] & OK))
                {
                   ifirst++;
                }
-               i = spdvector[ifirst].ndt - spdvector[ilast].ndt;
+               i = spdndt[ifirst] - spdndt[ilast];
                oss << " gap_segs " << setprecision(1) << setw(5) << cfg(DT) * i
                    << " s = " << i << " pts.";
             }
             ilast = static_cast<int>(it->nend);
             while (ilast >= static_cast<int>(it->nbeg) &&
-                   !(spdvector[ilast].flag & OK))
+                   !(spdflag[ilast] & OK))
             {
                ilast--;
             }
@@ -4308,11 +4209,11 @@ list<Segment>::iterator GDCPass::createSegment(list<Segment>::iterator sit,
       sit->nend = ibeg - 1;
 
          // 'trim' beg and end indexes
-      while (s.nend > s.nbeg && !(spdvector[s.nend].flag & OK))
+      while (s.nend > s.nbeg && !(spdflag[s.nend] & OK))
       {
          s.nend--;
       }
-      while (sit->nend > sit->nbeg && !(spdvector[sit->nend].flag & OK))
+      while (sit->nend > sit->nbeg && !(spdflag[sit->nend] & OK))
       {
          sit->nend--;
       }
@@ -4321,12 +4222,12 @@ list<Segment>::iterator GDCPass::createSegment(list<Segment>::iterator sit,
       unsigned int i;
       s.npts = sit->npts = 0;
       for (i = s.nbeg; i <= s.nend; i++)
-         if (spdvector[i].flag & OK)
+         if (spdflag[i] & OK)
          {
             s.npts++;
          }
       for (i = sit->nbeg; i <= sit->nend; i++)
-         if (spdvector[i].flag & OK)
+         if (spdflag[i] & OK)
          {
             sit->npts++;
          }
@@ -4412,17 +4313,17 @@ string GDCPass::dumpSegments(string label, int level, bool extra)
             if (ilast > -1)
             {
                ifirst = it->nbeg;
-               while (ifirst <= it->nend && !(spdvector[ifirst].flag & OK))
+               while (ifirst <= it->nend && !(spdflag[ifirst] & OK))
                {
                   ifirst++;
                }
-               i = spdvector[ifirst].ndt - spdvector[ilast].ndt;
+               i = spdndt[ifirst] - spdndt[ilast];
                oss << " Gap " << setprecision(1) << setw(5) << cfg(DT) * i
                    << " s = " << i << " pts.";
             }
             ilast = it->nend;
             while (ilast >= static_cast<int>(it->nbeg) &&
-                   !(spdvector[ilast].flag & OK))
+                   !(spdflag[ilast] & OK))
             {
                ilast--;
             }
@@ -4446,18 +4347,18 @@ string GDCPass::dumpSegments(string label, int level, bool extra)
 
             oss << "DSC" << label << " " << GDCUnique << " " << sat << " "
                 << it->nseg << " " << printTime(time(i), outFormat) << " "
-                << setw(3) << spdvector[i].flag << fixed << setprecision(3)
+                << setw(3) << spdflag[i] << fixed << setprecision(3)
                 << " " << setw(13)
-                << spdvector[i].data[L1] - it->bias2 // biasgf  //temp
+                << spddata[L1][i] - it->bias2 // biasgf  //temp
                 << " " << setw(13)
-                << spdvector[i].data[L2] - it->bias2 // biasgf
+                << spddata[L2][i] - it->bias2 // biasgf
                 << " " << setw(13)
-                << spdvector[i].data[P1] - it->bias1 // biaswl
-                << " " << setw(13) << spdvector[i].data[P2];
+                << spddata[P1][i] - it->bias1 // biaswl
+                << " " << setw(13) << spddata[P2][i];
             if (extra)
             {
-               oss << " " << setw(13) << spdvector[i].data[A1] << " "
-                   << setw(13) << spdvector[i].data[A2];
+               oss << " " << setw(13) << spddata[A1][i] << " "
+                   << setw(13) << spddata[A2][i];
             }
             oss << " " << setw(4) << i;
             if (i == it->nbeg)
@@ -4506,11 +4407,11 @@ void GDCPass::deleteSegment(list<Segment>::iterator& it, string msg)
 
       it->npts = 0;
       for (i = it->nbeg; i <= it->nend; i++)
-         if (spdvector[i].flag & OK)
+         if (spdflag[i] & OK)
          {
                // count these : learn
             learn["points deleted: " + msg]++;
-            spdvector[i].flag = BAD;
+            spdflag[i] = BAD;
          }
 
       learn["segments deleted: " + msg]++;
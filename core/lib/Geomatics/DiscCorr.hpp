@@ -39,9 +39,9 @@
 /** @file DiscCorr.hpp
     GPS phase discontinuity correction. Given a SatPass object
     containing dual-frequency pseudorange and phase for an entire satellite
-    pass, and a configuration object (as defined herein), detect discontinuities
-    in the phase and, if possible, estimate their size. Output is in the form of
-    Rinex editing commands (see class RinexEditor). */
+    pass, and a configuration object (see GDCconfiguration.hpp), detect
+    discontinuities in the phase and, if possible, estimate their size. Output
+    is in the form of Rinex editing commands (see class RinexEditor). */
 
 #ifndef GNSSTK_DISCONTINUITY_CORRECTOR_INCLUDE
 #define GNSSTK_DISCONTINUITY_CORRECTOR_INCLUDE
@@ -49,6 +49,7 @@
 #include "gnsstk_export.h"
 #include "Epoch.hpp"
 #include "Exception.hpp"
+#include "GDCconfiguration.hpp"
 #include "RinexObsHeader.hpp"
 #include "RinexSatID.hpp"
 #include "SatPass.hpp"
@@ -65,88 +66,6 @@ namespace gnsstk
    /** @addtogroup rinexutils */
    //@{
 
-      /**
-       class GDCconfiguration encapsulates the configuration for input to the
-       GNSSTK Discontinuity Corrector.
-      */
-   class GDCconfiguration
-   {
-   public:
-         /// constructor; this sets a full default set of parameters.
-      GDCconfiguration() { initialize(); }
-         /// destructor
-      ~GDCconfiguration()
-      {
-         CFG.clear();
-         CFGdescription.clear();
-      }
-
-         /**
-          Set a parameter in the configuration; the input string 'cmd'
-          is of the form '[--DC]\<id\>\<s\>\<value\>' where the separator s is
-          one of (:=,) and leading '-','--', or '--DC' are optional.
-          @throw Exception
-         */
-      void setParameter(std::string cmd);
-
-         /**
-          Set a parameter in the configuration using the label and the value,
-          for booleans use (T,F)=(non-zero,zero).
-          @throw Exception
-         */
-      void setParameter(const std::string& label, double value);
-
-         /// Get the parameter in the configuration corresponding to label
-      double getParameter(const std::string& label)
-      {
-         if (CFG.find(label) == CFG.end())
-         {
-            return 0.0; // TD throw?
-         }
-         return CFG[label];
-      }
-
-         /// Get the description of a parameter
-      std::string getDescription(const std::string& label)
-      {
-         if (CFGdescription.find(label) == CFGdescription.end())
-         {
-            return std::string("Invalid label");
-         }
-         return CFGdescription[label];
-      }
-
-         /// Tell GDCconfiguration to which stream to send debugging output.
-      void setDebugStream(std::ostream& os) { p_oflog = &os; }
-
-         /**
-          Print help page, including descriptions and current values of all
-          the parameters, to the ostream. If 'advanced' is true, also print
-          advanced parameters.
-          @throw Exception
-         */
-      void DisplayParameterUsage(std::ostream& os, bool advanced = false);
-
-         /// Return version string
-      std::string Version() { return GDCVersion; }
-
-   protected:
-         /// map containing configuration labels and their values
-      std::map<std::string, double> CFG;
-
-         /// map containing configuration labels and their descriptions
-      std::map<std::string, std::string> CFGdescription;
-
-         /// Stream on which to write debug output.
-      std::ostream *p_oflog;
-
-      void initialize();
-
-      GNSSTK_EXPORT
-      static const std::string GDCVersion;
-
-   }; // end class GDCconfiguration
-
       /**
        class GDCreturn encapsulates the information in the 'message' returned by
        the GNSSTK Discontinuity Corrector. Create it using the string created by
@@ -348,6 +267,36 @@ namespace gnsstk
                               std::vector<std::string>& EditCmds,
                               std::string& retMsg, int GLOn = -99);
 
+      /**
+       GNSSTK Discontinuity Corrector for many passes at once, e.g. all the
+       passes returned by SatPassFromRinexFiles(). The passes are independent,
+       and are corrected concurrently on nthreads threads, each with its own
+       copy of the configuration. Results are the same, and in the same order,
+       as calling the single-pass DiscontinuityCorrector() on each element of
+       SPList in turn: passes are numbered consecutively, editing commands are
+       appended to EditCmds in pass order, and the debug output of each pass
+       is written to config's debug stream as a block, in pass order (the
+       EditCmd dump of each pass lists only that pass's commands).
+
+       @param SPList   vector of SatPass objects containing the input data;
+                        these are corrected in place.
+       @param config   GDCconfiguration object, used for every pass.
+       @param EditCmds vector<string> (output) to which RinexEditor commands
+                        for all passes are appended.
+       @param retMsgs  vector<string> (output) containing the summary of
+                        results for each pass; parallel to SPList.
+       @param nthreads number of threads to use; if <= 0 use one per core.
+       @param GLOn     GLONASS frequency channel for each pass, parallel to
+                        SPList; missing entries mean UNKNOWN.
+       @return vector of return codes, parallel to SPList; see above.
+       @throw Exception if any pass throws; the first such, in pass order, is
+                        rethrown after all threads have finished.
+      */
+   std::vector<int> DiscontinuityCorrector(
+      std::vector<SatPass>& SPList, GDCconfiguration& config,
+      std::vector<std::string>& EditCmds, std::vector<std::string>& retMsgs,
+      int nthreads = 0, const std::vector<int>& GLOn = std::vector<int>());
+
    //@}
 
 } // end namespace gnsstk
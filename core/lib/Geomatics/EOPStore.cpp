@@ -42,6 +42,9 @@
 */
 
 //------------------------------------------------------------------------------------
+#include <cstring>
+#include <fstream>
+
 #include "EOPStore.hpp"
 //#include "logstream.hpp"
 
@@ -50,11 +53,16 @@ using namespace std;
 
 namespace gnsstk
 {
+      /* Header of the binary file: magic string, then an int (=1) to check
+         the byte order, then the number of records. Each record is the int MJD
+         followed by the doubles xp, yp, UT1mUTC. */
+   static const char binaryMagic[8] = {'G', 'T', 'K', 'E', 'O', 'P', '0', '1'};
+
       // Add to the store directly
    void EOPStore::addEOP(int mjd, EarthOrientation& eop)
    {
       mapMJD_EOP[mjd] = eop;
-
+      tableCurrent    = false;
       if (begMJD == -1 || endMJD == -1)
       {
          begMJD = endMJD = mjd;
@@ -97,6 +105,25 @@ namespace gnsstk
          @throw if the file is not found */
    void EOPStore::addFile(const string& filename)
    {
+         // binary file?
+      {
+         ifstream inpf(filename.c_str(), ios::in | ios::binary);
+         char magic[8];
+         if (inpf.read(magic, 8) && memcmp(magic, binaryMagic, 8) == 0)
+         {
+            inpf.close();
+            try
+            {
+               addBinaryFile(filename);
+            }
+            catch (FileMissingException& fme)
+            {
+               GNSSTK_RETHROW(fme);
+            }
+            return;
+         }
+      }
+
       try
       {
          addEOPPFile(filename);
@@ -206,6 +233,80 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+   void EOPStore::addBinaryFile(const string& filename)
+   {
+      ifstream inpf(filename.c_str(), ios::in | ios::binary);
+      if (!inpf)
+      {
+         FileMissingException fme("Could not open binary EOP file " + filename);
+         GNSSTK_THROW(fme);
+      }
+
+         // header
+      char magic[8];
+      int one(0), n(0);
+      inpf.read(magic, 8);
+      inpf.read((char *)&one, sizeof(int));
+      inpf.read((char *)&n, sizeof(int));
+      if (!inpf || memcmp(magic, binaryMagic, 8) != 0 || one != 1 || n < 0)
+      {
+         FileMissingException fme("Binary EOP file " + filename +
+                                  " is corrupted or wrong format");
+         GNSSTK_THROW(fme);
+      }
+
+         // records
+      for (int i = 0; i < n; i++)
+      {
+         int mjd;
+         EarthOrientation eo;
+         inpf.read((char *)&mjd, sizeof(int));
+         inpf.read((char *)&eo.xp, sizeof(double));
+         inpf.read((char *)&eo.yp, sizeof(double));
+         inpf.read((char *)&eo.UT1mUTC, sizeof(double));
+         if (!inpf)
+         {
+            FileMissingException fme("Binary EOP file " + filename +
+                                     " is truncated");
+            GNSSTK_THROW(fme);
+         }
+         addEOP(mjd, eo);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EOPStore::writeBinaryFile(const string& filename) const
+   {
+      ofstream strm(filename.c_str(), ios::out | ios::binary);
+      if (!strm.is_open())
+      {
+         Exception e("Failed to open output file " + filename + ". Abort.");
+         GNSSTK_THROW(e);
+      }
+
+      int one(1), n(mapMJD_EOP.size());
+      strm.write(binaryMagic, 8);
+      strm.write((const char *)&one, sizeof(int));
+      strm.write((const char *)&n, sizeof(int));
+
+      map<int, EarthOrientation>::const_iterator it;
+      for (it = mapMJD_EOP.begin(); it != mapMJD_EOP.end(); ++it)
+      {
+         strm.write((const char *)&it->first, sizeof(int));
+         strm.write((const char *)&it->second.xp, sizeof(double));
+         strm.write((const char *)&it->second.yp, sizeof(double));
+         strm.write((const char *)&it->second.UT1mUTC, sizeof(double));
+      }
+
+      strm.close();
+      if (!strm)
+      {
+         Exception e("Failed to write output file " + filename);
+         GNSSTK_THROW(e);
+      }
+   }
+
    //---------------------------------------------------------------------------------
       /* Edit the store by deleting all entries before(after) the given min(max)
          MJDs. If mjdmin is later than mjdmax, the two times are switched.
@@ -229,6 +330,8 @@ namespace gnsstk
          return;
       }
 
+      tableCurrent = false;
+
       map<int, EarthOrientation>::iterator it;
       it = mapMJD_EOP.lower_bound(mjdmin);
       if (it != mapMJD_EOP.begin())
@@ -299,12 +402,121 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+      /* Rebuild the interpolation table from the map. For each day d that is in
+         the map and is not the last entry, choose the 4 entries surrounding d
+         just as the original map-based getEOP() did, remove the zonal tides
+         from UT1mUTC (both conventions), and expand the Lagrange polynomial
+         through those 4 points in powers of u = mjd - d. */
+   void EOPStore::buildTable()
+   {
+      const int ndays = (mapMJD_EOP.empty() ? 0 : endMJD - begMJD);
+      table.assign(TABLE_STRIDE * ndays, 0.0);
+      tableOK.assign(ndays, false);
+
+      const size_t N = mapMJD_EOP.size();
+      if (N < 4)
+      {
+         tableCurrent = true;
+         return;
+      }
+
+         // copy the map into arrays, removing zonal tides from UT1mUTC
+      size_t i, j, k;
+      vector<int> mjd(N);
+      vector<double> val[4];
+      for (k = 0; k < 4; k++)
+      {
+         val[k].resize(N);
+      }
+      map<int, EarthOrientation>::const_iterator it = mapMJD_EOP.begin();
+      for (i = 0; i < N; ++i, ++it)
+      {
+         mjd[i]    = it->first;
+         val[0][i] = it->second.xp;
+         val[1][i] = it->second.yp;
+         val[2][i] = it->second.UT1mUTC -
+            EarthOrientation::zonalTideUT1(mjd[i], IERSConvention::IERS2010);
+         val[3][i] = it->second.UT1mUTC -
+            EarthOrientation::zonalTideUT1(mjd[i], IERSConvention::IERS2003);
+      }
+
+      for (i = 0; i + 1 < N; i++)
+      {
+            // low and hi must span 4 entries and bracket the day
+         size_t lo;
+         if (i == 0)
+         {
+            lo = 0; // L t . . H
+         }
+         else if (i + 2 == N)
+         {
+            lo = i - 2; // L . . t H
+         }
+         else
+         {
+            lo = i - 1; // L . t . H
+         }
+
+            // nodes relative to the day
+         double a[4];
+         for (k = 0; k < 4; k++)
+         {
+            a[k] = double(mjd[lo + k] - mjd[i]);
+         }
+
+            // power series coefficients of the Lagrange basis polynomials
+         double basis[4][4];
+         for (k = 0; k < 4; k++)
+         {
+            double p[4] = {1.0, 0.0, 0.0, 0.0}, den(1.0);
+            int deg(0);
+            for (j = 0; j < 4; j++)
+            {
+               if (j == k)
+               {
+                  continue;
+               }
+                  // p *= (u - a[j])
+               deg++;
+               for (int m = deg; m > 0; m--)
+               {
+                  p[m] = p[m - 1] - a[j] * p[m];
+               }
+               p[0] *= -a[j];
+               den *= a[k] - a[j];
+            }
+            for (j = 0; j < 4; j++)
+            {
+               basis[k][j] = p[j] / den;
+            }
+         }
+
+         double *c = &table[TABLE_STRIDE * (mjd[i] - begMJD)];
+         for (int s = 0; s < 4; s++)
+         {
+            for (j = 0; j < 4; j++)
+            {
+               double sum(0.0);
+               for (k = 0; k < 4; k++)
+               {
+                  sum += basis[k][j] * val[s][lo + k];
+               }
+               c[4 * s + j] = sum;
+            }
+         }
+         tableOK[mjd[i] - begMJD] = true;
+      }
+
+      tableCurrent = true;
+   }
+
    //---------------------------------------------------------------------------------
       /* Get the EOP at the given epoch. This involves interpolation and
          corrections as prescribed by the appropriate IERS convention, using code
-         in class EarthOrientation. This routine pulls data from the map for 4
-         entries surrounding the input time; this array of data is passed to class
-         EarthOrientation to perform the interpolation and corrections.
+         in class EarthOrientation. The interpolation uses the 4 entries
+         surrounding the input time, and is evaluated from the precomputed table;
+         the corrections are applied by EarthOrientation::correctEOP().
          @param mjd MJD(UTC) time of interest
          @param conv IERSConvention to be used.
          @throw InvalidRequest if the integer MJD falls outside the store,
@@ -319,78 +531,54 @@ namespace gnsstk
          GNSSTK_THROW(ir);
       }
 
-         /* Stored data uses UTC times
-            if(t.getTimeSystem() == TimeSystem::Unknown) {
-              InvalidRequest ir("Time system is unknown");
-              GNSSTK_THROW(ir);
-        } */
-
-         // get MJD(UTC)
-      double mjdUTC(mjd);
-
-         // find 4 points surrounding the time of interest ----------------
-      map<int, EarthOrientation>::iterator lowit, hiit, it;
-      it = lowit = mapMJD_EOP.find(int(mjdUTC));
-      (hiit = it)++;
-      if (lowit == mapMJD_EOP.end() || hiit == mapMJD_EOP.end())
-      {
-         InvalidRequest ir("Requested time lies outside the store");
-         GNSSTK_THROW(ir);
-      }
-      if (mapMJD_EOP.size() < 4)
+      if (!tableCurrent)
       {
-         InvalidRequest ir("Store contains less than 4 entries");
-         GNSSTK_THROW(ir);
+         buildTable();
       }
 
-         // low and hi must span 4 entries and bracket t
-      (it = lowit)--;
-      if (it == mapMJD_EOP.end())
-      {
-         hiit++;
-         hiit++; // L t . . H
-      }
-      else
+         // find the day; stored data uses UTC times
+      if (!(mjd >= begMJD && mjd < endMJD) || !tableOK[int(mjd) - begMJD])
       {
-         lowit = it;
-         (it = hiit)++;
-         if (it == mapMJD_EOP.end())
-         {
-            lowit--; // L . . t H
-         }
-         else
-         {
-            hiit = it; // L . t . H
-         }
-      }
-
-         /* fill arrays for Lagrange interpolation -----------------------
-            LOG(INFO) << " LAGINT at " << fixed << setprecision(9) << mjdUTC <<
-            "(UTC)"; */
-      vector<double> vtime, vX, vY, vdT;
-      for (it = lowit; it != mapMJD_EOP.end(); ++it)
-      {
-         vtime.push_back(double(it->first));
-         vX.push_back(it->second.xp);
-         vY.push_back(it->second.yp);
-            /* LOG(INFO) << " xy " << fixed << setprecision(10) <<
-               double(it->first)
-                 << " " << it->second.xp << " " << it->second.yp; */
-         vdT.push_back(it->second.UT1mUTC);
-         if (it == hiit)
-         {
-            break;
-         }
+         InvalidRequest ir("Requested time lies outside the store");
+         GNSSTK_THROW(ir);
       }
+      const int day   = int(mjd);
+      const double u  = mjd - day;
+      const double *c = &table[TABLE_STRIDE * (day - begMJD)];
+      const double *cUT =
+         c + (conv == IERSConvention::IERS2010 ? 8 : 12);
 
-         // let EarthOrientation do the interpolation and correction -----
+         // evaluate the cubics
       EarthOrientation eo;
+      eo.xp      = c[0] + u * (c[1] + u * (c[2] + u * c[3]));     // arcsec
+      eo.yp      = c[4] + u * (c[5] + u * (c[6] + u * c[7]));     // arcsec
+      eo.UT1mUTC = cUT[0] + u * (cUT[1] + u * (cUT[2] + u * cUT[3])); // sec
+
+         // let EarthOrientation apply the corrections ---------------------
       EphTime ttag;
-      ttag.setMJD(mjdUTC);
+      ttag.setMJD(mjd);
       ttag.setTimeSystem(TimeSystem::UTC);
-      eo.interpolateEOP(ttag, vtime, vX, vY, vdT, conv);
+      eo.correctEOP(ttag, conv);
 
       return eo;
    }
 
+   //---------------------------------------------------------------------------------
+   void EOPStore::getEOP(const vector<double>& mjds, const IERSConvention& conv,
+                         vector<EarthOrientation>& eops)
+   {
+      eops.resize(mjds.size());
+      try
+      {
+         for (size_t i = 0; i < mjds.size(); i++)
+         {
+            eops[i] = getEOP(mjds[i], conv);
+         }
+      }
+      catch (InvalidRequest& ir)
+      {
+         GNSSTK_RETHROW(ir);
+      }
+   }
+
 } // end namespace gnsstk
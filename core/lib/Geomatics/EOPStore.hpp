@@ -50,6 +50,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 // GNSSTk
 #include "EOPPrediction.hpp"
 #include "EarthOrientation.hpp"
@@ -65,6 +66,14 @@ namespace gnsstk
        map with key = integer MJD at which the EOPs are computed. Access the
        store with any MJD(UTC), interpolating the stored EOPs to the given epoch
        using the algorithm in class EarthOrientation.
+
+       For fast access the map is copied into a contiguous table holding, for
+       each day in the store, the coefficients of the cubic polynomials that
+       interpolate xp, yp and UT1mUTC (zonal tides removed) over that day.
+       The table is rebuilt by the first call to getEOP() after the store is
+       modified, so getEOP() is a constant time lookup plus the tidal
+       corrections. The store may also be saved to and restored from a binary
+       file, which is much faster to read than the text formats.
       */
    class EOPStore
    {
@@ -74,9 +83,27 @@ namespace gnsstk
          /// first and last times in the store, -1 if store is empty.
       int begMJD, endMJD;
 
+         /** Interpolation table, TABLE_STRIDE coefficients per day from begMJD
+             to endMJD-1: for each of xp, yp, UT1mUTC-zonal tides(IERS2010)
+             and UT1mUTC-zonal tides(IERS2003), in that order, c0..c3 of the
+             cubic in (mjd - day). */
+      std::vector<double> table;
+
+         /// parallel to table, true if the day can be interpolated
+      std::vector<bool> tableOK;
+
+         /// true if table is consistent with mapMJD_EOP
+      bool tableCurrent;
+
+         /// number of doubles per day in table
+      static const int TABLE_STRIDE = 16;
+
+         /// Rebuild table from mapMJD_EOP
+      void buildTable();
+
    public:
          /// Constructor
-      EOPStore() : begMJD(-1), endMJD(-1) {}
+      EOPStore() : begMJD(-1), endMJD(-1), tableCurrent(false) {}
 
          /// Add to the store directly
       void addEOP(int MJD, EarthOrientation& eop);
@@ -90,10 +117,11 @@ namespace gnsstk
       int addEOP(int MJD, EOPPrediction& eopp);
 
          /**
-          Add EOPs to the store via an input file: either an EOPP file
-          or a flat file produced by the IERS and available at USNO
+          Add EOPs to the store via an input file: either an EOPP file,
+          a flat file produced by the IERS and available at USNO
           (see http://maia.usno.navy.mil/ and get either file
-          'finals.data' or 'finals2000A.data').
+          'finals.data' or 'finals2000A.data'), or a binary file written
+          by writeBinaryFile().
           @param filename Name of file to read, including path.
           @throw FileMissingException if file is not found.
          */
@@ -116,6 +144,23 @@ namespace gnsstk
          */
       void addIERSFile(const std::string& filename);
 
+         /**
+          Add EOPs to the store via a binary file written by writeBinaryFile().
+          @param filename Name of file to read, including path.
+          @throw FileMissingException if file is not found, or is not a
+                  binary EOP file written on a machine of the same byte order.
+         */
+      void addBinaryFile(const std::string& filename);
+
+         /**
+          Write the contents of the store to a binary file, which can be read
+          with addBinaryFile() (or addFile()) much faster than the text
+          formats. The file is written in the byte order of this machine.
+          @param filename Name of file to write, including path.
+          @throw Exception if the file cannot be opened or written.
+         */
+      void writeBinaryFile(const std::string& filename) const;
+
          /**
           Edit the store by deleting all entries before(after)
           the given min(max) MJDs (TimeSystem UTC).
@@ -133,6 +178,7 @@ namespace gnsstk
       {
          mapMJD_EOP.clear();
          begMJD = endMJD = -1;
+         tableCurrent = false;
       }
 
          /**
@@ -152,10 +198,10 @@ namespace gnsstk
          /**
           Get the EOP at the given epoch. This involves interpolation and
           corrections as prescribed by the appropriate IERS convention, using
-          code in class EarthOrientation. This routine pulls data from the map
-          for 4 entries surrounding the input time; this array of data is passed
-          to class EarthOrientation to perform the interpolation and
-          corrections.
+          code in class EarthOrientation. The interpolation uses the 4 entries
+          surrounding the input time, and is evaluated from the precomputed
+          table (rebuilt here if the store was modified); the corrections are
+          applied by EarthOrientation::correctEOP().
           @param mjd MJD(UTC) time of interest
           @param conv IERSConvention to be used.
           @throw InvalidRequest if the integer MJD falls outside the store,
@@ -164,6 +210,18 @@ namespace gnsstk
          */
       EarthOrientation getEOP(double mjd, const IERSConvention& conv);
 
+         /**
+          Get the EOPs at each of a list of epochs; equivalent to calling
+          getEOP(mjd,conv) for each epoch.
+          @param mjds vector of MJD(UTC) times of interest
+          @param conv IERSConvention to be used.
+          @param eops output vector of EOPs, parallel to mjds
+          @throw InvalidRequest if any integer MJD falls outside the store,
+                  or if the store contains fewer than 4 entries
+         */
+      void getEOP(const std::vector<double>& mjds, const IERSConvention& conv,
+                  std::vector<EarthOrientation>& eops);
+
    }; // end class EOPStore
 
 } // end namespace gnsstk
@@ -51,12 +51,19 @@
 #include "logstream.hpp"
 
 #include "EarthOrientation.hpp"
+#include "NutationSeries.hpp"
+#include "SMatrix.hpp"
 
 //------------------------------------------------------------------------------------
 using namespace std;
 
 namespace gnsstk
 {
+      /* The rotation chains below are computed with fixed-size 3x3
+         matrices, which avoids a heap allocation per intermediate
+         product; results are converted to Matrix<double> on return. */
+   typedef SMatrix<double, 3, 3> Matrix33;
+
    //---------------------------------------------------------------------------------
       // constants
    //---------------------------------------------------------------------------------
@@ -162,23 +169,13 @@ namespace gnsstk
                                          vector<double>& dT,
                                          const IERSConvention& in_conv)
    {
-      int i, j;
-      double dxp, dyp, dUT, dlod, domega;
-      double args[6];
-
-         // set the convention for this object
-      convention = in_conv;
+      int i;
 
          // first get MJD(UTC), for the Lagrange interpolation
       EphTime ttag(t);
       ttag.convertSystemTo(TimeSystem::UTC);
       double mjdUTC(ttag.dMJD());
 
-         // now convert to TT, for the corrections algorithms
-      ttag.convertSystemTo(TimeSystem::TT);
-      double mjd(ttag.dMJD());
-      double T = (mjd - 51544.5) / 36525.0;
-
          // ----------------------------------------------------------------
          // step 1 : Lagrange interpolation of xp and yp
       double err;
@@ -187,24 +184,10 @@ namespace gnsstk
          // LOG(INFO) << " -> " << fixed << setprecision(10) << mjdUTC
          //   << " " << setprecision(15) << xp << " " << yp;
 
-         /* 1a. remove long period tides from UT1-UTC data -------------------
-            NB don't need ttag anymore but do need mjd and T. */
+         // 1a. remove long period tides from UT1-UTC data -------------------
       for (i = 0; i < time.size(); i++)
       {
-         ttag.setMJD(time[i]);
-         ttag.setTimeSystem(TimeSystem::UTC);
-         ttag.convertSystemTo(TimeSystem::TT);
-         double Ttemp = (ttag.dMJD() - 51544.5) / 36525.0;
-         computeFundamentalArgs(Ttemp, args);
-         if (convention == IERSConvention::IERS2010)
-         {
-            correctEarthRotationZonalTides(args, dUT, dlod, domega);
-         }
-         else
-         {
-            correctEarthRotationZonalTides2003(args, dUT, dlod, domega);
-         }
-         dT[i] -= dUT;
+         dT[i] -= zonalTideUT1(time[i], in_conv);
             // LOG(INFO) << " UT " <<fixed<< setprecision(10) << time[i] << " " <<
             // dT[i];
       }
@@ -214,6 +197,61 @@ namespace gnsstk
          // LOG(INFO) << " -> " << fixed << setprecision(10) << mjdUTC
          //                    << " " << setprecision(15) << UT1mUTC;
 
+         // steps 2 and 3 : corrections
+      correctEOP(ttag, in_conv);
+   }
+
+   //---------------------------------------------------------------------------------
+      /* Correction to UT1mUTC due to zonal tides at the given MJD(UTC); this is
+         the quantity removed from the stored UT1mUTC before interpolation.
+         param mjdUTC MJD(UTC) time of interest
+         param conv the IERSConvention to be used.
+         return correction to UT1mUTC in seconds */
+   double EarthOrientation::zonalTideUT1(double mjdUTC,
+                                         const IERSConvention& conv)
+   {
+      double dUT, dlod, domega;
+      double args[6];
+
+      EphTime ttag;
+      ttag.setMJD(mjdUTC);
+      ttag.setTimeSystem(TimeSystem::UTC);
+      ttag.convertSystemTo(TimeSystem::TT);
+      double T = (ttag.dMJD() - 51544.5) / 36525.0;
+      computeFundamentalArgs(T, args);
+      if (conv == IERSConvention::IERS2010)
+      {
+         correctEarthRotationZonalTides(args, dUT, dlod, domega);
+      }
+      else
+      {
+         correctEarthRotationZonalTides2003(args, dUT, dlod, domega);
+      }
+
+      return dUT;
+   }
+
+   //---------------------------------------------------------------------------------
+      /* Apply corrections to interpolated EOPs xp, yp and UT1mUTC, where
+         UT1mUTC has had the zonal tides removed (steps 2 and 3 of
+         interpolateEOP()).
+         param t EphTime at which the EOPs were interpolated
+         param conv the IERSConvention to be used. */
+   void EarthOrientation::correctEOP(const EphTime& t,
+                                     const IERSConvention& in_conv)
+   {
+      double dxp, dyp, dUT, dlod, domega;
+      double args[6];
+
+         // set the convention for this object
+      convention = in_conv;
+
+         // convert to TT, for the corrections algorithms
+      EphTime ttag(t);
+      ttag.convertSystemTo(TimeSystem::TT);
+      double mjd(ttag.dMJD());
+      double T = (mjd - 51544.5) / 36525.0;
+
          /* ----------------------------------------------------------------
             step 2 : Compute fundamental arguments for use in corrections */
       computeFundamentalArgs(T, args);
@@ -1600,113 +1638,9 @@ namespace gnsstk
          param Y, y coordinate of CIO */
    void EarthOrientation::XYCIO(double& T, double& X, double& Y)
    {
-// include data arrays : defines MAXPT
-#include "IERS2010CIOSeriesData.hpp"
-
-      int i, j;
-      double t;
-
-         // compute and store powers of T
-      double powsT[MAXPT + 1];
-      t = 1.0;
-      for (i = 0; i <= MAXPT; i++)
-      {
-         powsT[i] = t;
-         t *= T;
-      }
-
-         // fundamental arguments
-      double fa[14];
-      fa[0]  = L(T);         // mean anomaly of the moon
-      fa[1]  = Lp(T);        // mean anomaly of the sun
-      fa[2]  = F(T);         // mean longitude of the moon - Omega
-      fa[3]  = D(T);         // mean elongation of the moon from the sun
-      fa[4]  = Omega2003(T); // mean longitude of lunar ascending node
-      fa[5]  = LMe(T);       // mean longitude Mercury
-      fa[6]  = LV(T);        // mean longitude of Venus
-      fa[7]  = LE(T);        // mean longitude of Earth
-      fa[8]  = LMa(T);       // mean longitude Mars
-      fa[9]  = LJ(T);        // mean longitude Jupiter
-      fa[10] = LS(T);        // mean longitude Saturn
-      fa[11] = LU(T);        // mean longitude Uranus
-      fa[12] = LN(T);        // mean longitude Neptune
-      fa[13] = Pa(T);        // general precession in longitude
-
-         // intermediate totals
-      double xypoly[2] = {0.0, 0.0}, xylunarsolar[2] = {0.0, 0.0},
-             xyplanet[2] = {0.0, 0.0};
-
-         // polynomial
-      for (i = 0; i < 2; i++)
-      {
-         for (j = MAXPT; j >= 0; j--)
-         {
-            xypoly[i] += XYcoeff[i][j] * powsT[j];
-         }
-      }
-
-         // nutation planetary terms
-      int ilast(NAmp), jlast;
-      double sc[2];
-      for (int ifreq = NFAP - 1; ifreq >= 0; ifreq--)
-      {
-            // build the argument
-         double arg(0.0);
-         for (i = 0; i < 14; i++)
-         {
-            if (nFAplanetary[ifreq][i]) // don't add zero
-            {
-               arg += double(nFAplanetary[ifreq][i]) * fa[i];
-            }
-         }
-
-            // store sin and cos
-         sc[0] = ::sin(arg);
-         sc[1] = ::cos(arg);
-
-            // amplitudes
-         jlast = iamp[ifreq + NFALS];
-         for (i = ilast; i >= jlast; i--)
-         {
-            j = i - jlast; // coeff number
-            xyplanet[jaxy[j]] += amp[i - 1] * sc[jasc[j]] * powsT[japt[j]];
-         }
-         ilast = jlast - 1;
-      }
-
-         // NB ilast is maintained through this point
-
-         // nutation lunar solar terms
-      for (int ifreq = NFALS - 1; ifreq >= 0; ifreq--)
-      {
-            // build the argument
-         double arg(0.0);
-         for (i = 0; i < 5; i++)
-         {
-            if (nFAlunarsolar[ifreq][i]) // don't add zero
-            {
-               arg += double(nFAlunarsolar[ifreq][i]) * fa[i];
-            }
-         }
-
-            // store sin and cos
-         sc[0] = ::sin(arg);
-         sc[1] = ::cos(arg);
-
-            // amplitudes
-         jlast = iamp[ifreq];
-         for (i = ilast; i >= jlast; i--)
-         {
-            j = i - jlast; // coeff number
-            xylunarsolar[jaxy[j]] += amp[i - 1] * sc[jasc[j]] * powsT[japt[j]];
-         }
-         ilast = jlast - 1;
-      }
-
-      X = xypoly[0] + (xylunarsolar[0] + xyplanet[0]) * 1.e-6;
-      X *= ARCSEC_TO_RAD;
-      Y = xypoly[1] + (xylunarsolar[1] + xyplanet[1]) * 1.e-6;
-      Y *= ARCSEC_TO_RAD;
+         // compiled series, with its workspace, for each thread
+      static thread_local NutationSeries series;
+      series.XYCIO(T, X, Y);
    }
 
    //---------------------------------------------------------------------------------
@@ -2268,9 +2202,8 @@ namespace gnsstk
    {
       xp *= ARCSEC_TO_RAD;
       yp *= ARCSEC_TO_RAD;
-      Matrix<double> R1, R2;
-      R1 = rotation(-yp, 1);
-      R2 = rotation(-xp, 2);
+      Matrix33 R1 = Matrix33::rotation(-yp, 1);
+      Matrix33 R2 = Matrix33::rotation(-xp, 2);
       return (R2 * R1);
    }
 
@@ -2291,10 +2224,9 @@ namespace gnsstk
                   << " with T = " << coordTransTime(t);
       xp *= ARCSEC_TO_RAD;
       yp *= ARCSEC_TO_RAD;
-      Matrix<double> R1, R2, R3;
-      R3 = rotation(sp, 3);
-      R2 = rotation(-xp, 2);
-      R1 = rotation(-yp, 1);
+      Matrix33 R3 = Matrix33::rotation(sp, 3);
+      Matrix33 R2 = Matrix33::rotation(-xp, 2);
+      Matrix33 R1 = Matrix33::rotation(-yp, 1);
       return (R1 * R2 * R3);
    }
 
@@ -2356,9 +2288,9 @@ namespace gnsstk
                                                       double psib,
                                                       double epsa)
    {
-      Matrix<double> R;
-      R = rotation(-epsa, 1) * rotation(-psib, 3) * rotation(phib, 1) *
-          rotation(gamb, 3);
+      Matrix33 R = Matrix33::rotation(-epsa, 1) *
+                   Matrix33::rotation(-psib, 3) *
+                   Matrix33::rotation(phib, 1) * Matrix33::rotation(gamb, 3);
       return R;
    }
 
@@ -2447,119 +2379,9 @@ namespace gnsstk
    void EarthOrientation::nutationAngles2003(double T, double& deps,
                                              double& dpsi)
    {
-         // sin and cos coefficients have units 0.1 microarcsec = 1e-7as
-      const double COEFF_TO_RAD(ARCSEC_TO_RAD * 1.0e-7);
-
-// -----------------------------------------
-// include huge static arrays of coefficients
-#include "IERS2003NutationData.hpp"
-
-         /* -----------------------------------------
-            Lunar-Solar nutation
-            fundamental arguments, in radians */
-      double l(L(T)); // mean anomaly of the moon
-
-      double lp(
-         ::fmod(1287104.79305 // mean anomaly of the sun MHB2000 value
-                   + T * (129596581.0481 +
-                          T * (-0.5532 + T * (0.000136 + T * (-0.00001149)))),
-                ARCSEC_PER_CIRCLE) *
-         ARCSEC_TO_RAD);
-
-      double f(
-         ::fmod(335779.526232 // mean longitude of moon minus Omega MHB2000
-                   + T * (1739527262.8478 +
-                          T * (-12.7512 + T * (-0.001037 + T * (0.00000417)))),
-                ARCSEC_PER_CIRCLE) *
-         ARCSEC_TO_RAD);
-
-      double d(
-         ::fmod(1072260.70369 // mean elongation moon from sun MHB2000
-                   + T * (1602961601.2090 +
-                          T * (-6.3706 + T * (0.006593 + T * (-0.00003169)))),
-                ARCSEC_PER_CIRCLE) *
-         ARCSEC_TO_RAD);
-
-      double Om(Omega2003(T)); // mean longitude of lunar ascending node
-
-         // initialize
-      deps = dpsi = 0.0;
-      int i;
-      double arg, sina, cosa;
-
-         // form the LS series
-      for (i = NLS - 1; i >= 0; --i)
-      {
-            // argument
-         arg =
-            ::fmod(LSCoeff[i].nl * l + LSCoeff[i].nlp * lp + LSCoeff[i].nf * f +
-                      LSCoeff[i].nd * d + LSCoeff[i].nom * Om,
-                   TWOPI);
-         sina = ::sin(arg);
-         cosa = ::cos(arg);
-            // term
-         deps +=
-            (LSCoeff[i].ce + LSCoeff[i].cet * T) * cosa + LSCoeff[i].se * sina;
-         dpsi +=
-            (LSCoeff[i].sp + LSCoeff[i].spt * T) * sina + LSCoeff[i].cp * cosa;
-      }
-
-         // -----------------------------------------
-         // Planetary nutation
-         // fundamental arguments, in radians.
-
-         // NB MHB2000 values are very close to IERS2003; follow SOFA here TD ??
-         // mean anomaly of the moon MHB2000 value
-      l = ::fmod(2.35555598 + 8328.6914269554 * T, TWOPI);
-         // mean longitude of the moon minus Omega MHB2000 value
-      f = ::fmod(1.627905234 + 8433.466158131 * T, TWOPI);
-         // mean elongation of the Moon from the Sun MHB2000 value
-      d = ::fmod(5.198466741 + 7771.3771468121 * T, TWOPI);
-         // mean longitude of lunar ascending node MHB2000 value
-      Om = ::fmod(2.18243920 - 33.757045 * T, TWOPI);
-
-         // mean longitude Mercury
-      double lme(LMe(T));
-         // mean longitude of Venus
-      double lve(LV(T));
-         // mean longitude of Earth
-      double lea(LE(T));
-         // mean longitude Mars
-      double lma(LMa(T));
-         // mean longitude Jupiter
-      double lju(LJ(T));
-         // mean longitude Saturn
-      double lsa(LS(T));
-         // mean longitude Uranus
-      double lur(LU(T));
-         // mean longitude Neptune
-      double lne(::fmod(5.321159000 + 3.8127774000 * T, TWOPI));
-         // general precession in longitude
-      double pa(Pa(T));
-
-         // form the planetary series
-      for (i = NP - 1; i >= 0; --i)
-      {
-            // argument
-         arg  = ::fmod(PCoeff[i].nl * l + PCoeff[i].nf * f + PCoeff[i].nd * d +
-                         PCoeff[i].nom * Om + PCoeff[i].nme * lme +
-                         PCoeff[i].nve * lve + PCoeff[i].nea * lea +
-                         PCoeff[i].nma * lma + PCoeff[i].nju * lju +
-                         PCoeff[i].nsa * lsa + PCoeff[i].nur * lur +
-                         PCoeff[i].nne * lne + PCoeff[i].npa * pa,
-                      TWOPI);
-         sina = ::sin(arg);
-         cosa = ::cos(arg);
-            // term
-         deps += PCoeff[i].ce * cosa + PCoeff[i].se * sina;
-         dpsi += PCoeff[i].sp * sina + PCoeff[i].cp * cosa;
-      }
-
-         // convert 0.1microarcsec to radians
-      deps *= COEFF_TO_RAD;
-      dpsi *= COEFF_TO_RAD;
-
-      return;
+         // compiled series, with its workspace, for each thread
+      static thread_local NutationSeries series;
+      series.nutationAngles2003(T, deps, dpsi);
    }
 
    //---------------------------------------------------------------------------------
@@ -2586,9 +2408,9 @@ namespace gnsstk
    Matrix<double> EarthOrientation::nutationMatrix(double eps, double dpsi,
                                                    double deps)
    {
-      Matrix<double> R1 = rotation(eps, 1);
-      Matrix<double> R2 = rotation(-dpsi, 3);
-      Matrix<double> R3 = rotation(-(eps + deps), 1);
+      Matrix33 R1 = Matrix33::rotation(eps, 1);
+      Matrix33 R2 = Matrix33::rotation(-dpsi, 3);
+      Matrix33 R3 = Matrix33::rotation(-(eps + deps), 1);
       return (R3 * R2 * R1);
    }
 
@@ -2665,10 +2487,10 @@ namespace gnsstk
       double theta = TAR * (2004.3109 - T * (0.42665 + T * 0.041833));
       double z     = TAR * (2306.2181 + T * (1.09468 + T * 0.018203));
 
-      Matrix<double> R1 = rotation(-zeta, 3);
-      Matrix<double> R2 = rotation(theta, 2);
-      Matrix<double> R3 = rotation(-z, 3);
-      Matrix<double> P  = R3 * R2 * R1;
+      Matrix33 R1 = Matrix33::rotation(-zeta, 3);
+      Matrix33 R2 = Matrix33::rotation(theta, 2);
+      Matrix33 R3 = Matrix33::rotation(-z, 3);
+      Matrix33 P  = R3 * R2 * R1;
 
       return P;
    }
@@ -2722,19 +2544,19 @@ namespace gnsstk
       epsa += depspr;
 
          // Frame bias matrix
-      Matrix<double> R1 = rotation(raeps0, 3);
-      Matrix<double> R2 = rotation(psibias * ::sin(eps0), 2);
-      Matrix<double> R3 = rotation(-epsbias, 1);
-      Matrix<double> FrameBias(R3 * R2 * R1);
+      Matrix33 R1 = Matrix33::rotation(raeps0, 3);
+      Matrix33 R2 = Matrix33::rotation(psibias * ::sin(eps0), 2);
+      Matrix33 R3 = Matrix33::rotation(-epsbias, 1);
+      Matrix33 FrameBias(R3 * R2 * R1);
       LOG(DEBUG7) << "\nframe bias matrix:\n"
                   << fixed << setprecision(15) << showpos << FrameBias;
 
          // Precession matrix
-      R1                = rotation(eps0, 1);
-      R2                = rotation(-psia, 3);
-      R3                = rotation(-epsa, 1);
-      Matrix<double> R4 = rotation(chia, 3);
-      Matrix<double> Precess(R4 * R3 * R2 * R1);
+      R1          = Matrix33::rotation(eps0, 1);
+      R2          = Matrix33::rotation(-psia, 3);
+      R3          = Matrix33::rotation(-epsa, 1);
+      Matrix33 R4 = Matrix33::rotation(chia, 3);
+      Matrix33 Precess(R4 * R3 * R2 * R1);
       LOG(DEBUG7) << "\nprecession matrix:\n"
                   << fixed << setprecision(15) << showpos << Precess;
 
@@ -2858,12 +2680,12 @@ namespace gnsstk
    {
       try
       {
-         Matrix<double> P, N, W, S;
+         Matrix33 P, N, W, S;
 
          double T = coordTransTime(t);
 
             // precession
-         P = precessionMatrix1996(T);
+         P = Matrix33(precessionMatrix1996(T));
          LOG(DEBUG7) << "\nprecession matrix:\n"
                      << fixed << setprecision(15) << setw(18) << showpos << P;
 
@@ -2878,7 +2700,7 @@ namespace gnsstk
          LOG(DEBUG7) << "\nnutation angles psi eps " << fixed
                      << setprecision(15) << showpos << dpsi << " " << deps;
             // nutation matrix
-         N = nutationMatrix(eps, dpsi, deps);
+         N = Matrix33(nutationMatrix(eps, dpsi, deps));
          LOG(DEBUG7) << "\nnutation matrix:\n"
                      << fixed << setprecision(15) << setw(18) << showpos << N;
 
@@ -2898,13 +2720,13 @@ namespace gnsstk
          LOG(DEBUG7) << "\nGAST = " << fixed << setprecision(15) << showpos
                      << g * RAD_TO_DEG;
 
-         S = rotation(g, 3);
+         S = Matrix33::rotation(g, 3);
          LOG(DEBUG7) << "\ncelestial-to-terrestrial matrix (no polar motion):\n"
                      << fixed << setprecision(15) << setw(18) << showpos
                      << S * N * P;
 
             // Polar Motion
-         W = polarMotionMatrix1996(xp, yp);
+         W = Matrix33(polarMotionMatrix1996(xp, yp));
          LOG(DEBUG7) << "\npolar motion matrix:\n"
                      << fixed << setprecision(15) << setw(18) << showpos << W;
 
@@ -2928,7 +2750,7 @@ namespace gnsstk
    {
       try
       {
-         Matrix<double> P, N, R, W;
+         Matrix33 P, N, R, W;
 
          double T(coordTransTime(t));
 
@@ -2960,14 +2782,14 @@ namespace gnsstk
                      << showpos << eps;
          eps += depspr;
 
-         N = nutationMatrix(eps, dpsi, deps);
+         N = Matrix33(nutationMatrix(eps, dpsi, deps));
          LOG(DEBUG7) << "\nnutation matrix:\n"
                      << fixed << setprecision(15) << setw(18) << showpos << N;
 
             // precession
-         P = precessionMatrix2003(T);
+         P = Matrix33(precessionMatrix2003(T));
 
-         Matrix<double> NPB(N * P);
+         Matrix33 NPB(N * P);
          LOG(DEBUG7) << "\nNPB matrix:\n"
                      << fixed << setprecision(15) << setw(18) << showpos << NPB;
 
@@ -2975,13 +2797,13 @@ namespace gnsstk
          double era(EarthRotationAngle(t, UT1mUTC));
          LOG(DEBUG7) << "\nERA = " << fixed << setprecision(15) << showpos
                      << era * RAD_TO_DEG;
-         R = rotation(era, 3);
+         R = Matrix33::rotation(era, 3);
 
             /* double gast = GAST2003(t, UT1mUTC);
                R = rotation(gast,3); */
 
             // polar motion
-         W = polarMotionMatrix2003(t, xp, yp);
+         W = Matrix33(polarMotionMatrix2003(t, xp, yp));
          LOG(DEBUG7) << "\npolar motion matrix:\n"
                      << fixed << setprecision(15) << setw(18) << showpos << W;
 
@@ -3023,8 +2845,9 @@ namespace gnsstk
          double r2(X * X + Y * Y);                  // squared radius
          double e(r2 != 0.0 ? ::atan2(Y, X) : 0.0); // spherical angles
          double d(::atan(::sqrt(r2 / (1.0 - r2)))); //
-         Matrix<double> GCRStoCIRS;
-         GCRStoCIRS = rotation(-(e + s), 3) * rotation(d, 2) * rotation(e, 3);
+         Matrix33 GCRStoCIRS = Matrix33::rotation(-(e + s), 3) *
+                               Matrix33::rotation(d, 2) *
+                               Matrix33::rotation(e, 3);
          LOG(DEBUG7) << "\nNPB matrix:\n"
                      << fixed << setprecision(15) << setw(18) << showpos
                      << GCRStoCIRS;
@@ -3038,23 +2861,21 @@ namespace gnsstk
 
             // compute transf. CIRS-to-TIRS or
             // intermediate-celestial-to-terrestrial
-         Matrix<double> CIRStoTIRS;
-         CIRStoTIRS = rotation(era, 3);
+         Matrix33 CIRStoTIRS = Matrix33::rotation(era, 3);
          LOG(DEBUG7) << "\ncelestial-to-terrestrial matrix (no polar motion):\n"
                      << fixed << setprecision(15) << setw(18) << showpos
                      << CIRStoTIRS * GCRStoCIRS;
 
             // compute the polar motion matrix, TIRS-to-ITRS
             // double sprime(Sprime(T));
-         Matrix<double> polarMotion(
+         Matrix33 polarMotion(
             polarMotionMatrix2003(t, xp, yp)); // 2010 == 2003
          LOG(DEBUG7) << "\npolar motion matrix:\n"
                      << fixed << setprecision(15) << setw(18) << showpos
                      << polarMotion;
 
             // combine to get GCRS-to-ITRS
-         Matrix<double> GCRStoITRS;
-         GCRStoITRS = polarMotion * CIRStoTIRS * GCRStoCIRS;
+         Matrix33 GCRStoITRS = polarMotion * CIRStoTIRS * GCRStoCIRS;
 
             // invert to get ITRS-to-GCRS or ECEFtoInertial
          return (transpose(GCRStoITRS));
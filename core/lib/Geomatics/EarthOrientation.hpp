@@ -164,6 +164,29 @@ namespace gnsstk
                           const std::vector<double>& Y, std::vector<double>& dT,
                           const IERSConvention& conv);
 
+         /**
+          Apply the corrections of interpolateEOP() to EOPs that have already
+          been interpolated to ttag: this object's xp, yp and UT1mUTC must
+          hold the interpolated values, where UT1mUTC was interpolated from
+          data with the zonal tides removed (cf. zonalTideUT1()). Restores the
+          zonal tides and adds the ocean tide corrections; also sets
+          convention.
+          @param ttag EphTime at which the EOPs were interpolated
+          @param conv the IERSConvention to be used.
+          @throw Exception if the TimeSystem conversion fails
+         */
+      void correctEOP(const EphTime& ttag, const IERSConvention& conv);
+
+         /**
+          Correction to UT1mUTC due to zonal tides at the given time; this is
+          the quantity interpolateEOP() removes from each stored UT1mUTC
+          before interpolation.
+          @param mjdUTC MJD(UTC) time of interest
+          @param conv the IERSConvention to be used.
+          @return correction to UT1mUTC in seconds
+         */
+      static double zonalTideUT1(double mjdUTC, const IERSConvention& conv);
+
       //------------------------------------------------------------------------------
          /**
           'coordinate transformation time', which is used throughout the
@@ -439,6 +462,9 @@ namespace gnsstk
       Matrix<double> ECEFtoJ2000(const EphTime& t, bool reduced = false);
 
    private:
+         /// EarthRotationTable tabulates the private series below.
+      friend class EarthRotationTable;
+
       //------------------------------------------------------------------------------
          /**
           locator s which gives the position of the CIO on the equator of
@@ -479,7 +505,7 @@ namespace gnsstk
           a series based on IAU 2006 precession and IAU 2000A nutation (IERS
           2010). The coordinates form a unit vector that points towards the CIO;
           they include the effects of frame bias, precession and nutation. cf.
-          sofa xy06
+          sofa xy06. Evaluated by NutationSeries, one per thread.
           @param T the coordinate transformation time at the time of interest
           @param X x coordinate of CIO
           @param Y y coordinate of CIO
@@ -743,7 +769,7 @@ namespace gnsstk
       //------------------------------------------------------------------------------
          /**
           Nutation of the obliquity (deps) and of the longitude (dpsi), IERS
-          2003
+          2003. Evaluated by NutationSeries, one per thread.
           @param T    the coordinate transformation time at the time of interest
           @param deps nutation of the obliquity (output) in radians
           @param dpsi nutation of the longitude (output) in radians
@@ -0,0 +1,308 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file EarthRotationTable.cpp
+    Implement class EarthRotationTable, tabulated CIP quantities and EOPs for
+    the ECEF-to-inertial rotation. */
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <cmath>
+// GNSSTk
+#include "EarthRotationTable.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gnsstk
+{
+   typedef SMatrix<double, 3, 3> Matrix33;
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationTable::initialize(EOPStore& eops, const IERSConvention& conv,
+                                       const EphTime& beg, const EphTime& end,
+                                       double stepDays)
+   {
+      try
+      {
+         if (conv != IERSConvention::IERS2003 &&
+             conv != IERSConvention::IERS2010)
+         {
+            Exception e("EarthRotationTable supports IERS2003 and IERS2010 only");
+            GNSSTK_THROW(e);
+         }
+         if (stepDays <= 0.0)
+         {
+            Exception e("Grid step must be positive");
+            GNSSTK_THROW(e);
+         }
+
+         EphTime ttbeg, ttend;
+         toTT(beg, ttbeg);
+         toTT(end, ttend);
+         if (ttend.dMJD() < ttbeg.dMJD())
+         {
+            Exception e("End time precedes begin time");
+            GNSSTK_THROW(e);
+         }
+
+            /* one extra grid point before beg and two after end, so that
+               every time in [beg,end] has two grid points on either side */
+         convention = conv;
+         step       = stepDays;
+         begMJD     = ttbeg.dMJD() - step;
+         size_t n   = size_t(::ceil((ttend.dMJD() - ttbeg.dMJD()) / step)) + 4;
+
+         X.resize(n);
+         Y.resize(n);
+         S.resize(n);
+         XP.resize(n);
+         YP.resize(n);
+         DUT.resize(n);
+         cacheMJD = -1;
+
+         for (size_t i = 0; i < n; i++)
+         {
+            EphTime tt(begMJD + double(i) * step, TimeSystem::TT);
+            EphTime utc(tt);
+            utc.convertSystemTo(TimeSystem::UTC);
+            double TTmUTC = (tt.lMJD() - utc.lMJD()) * 86400.0 +
+                            (tt.secOfDay() - utc.secOfDay());
+            double T = EarthOrientation::coordTransTime(tt);
+
+               // CIP and CIO locator
+            if (conv == IERSConvention::IERS2010)
+            {
+               EarthOrientation::XYCIO(T, X[i], Y[i]);
+               S[i] = EarthOrientation::S(T, X[i], Y[i],
+                                          IERSConvention::IERS2010);
+            }
+            else
+            {
+                  /* the NPB matrix of EarthOrientation::ECEFtoInertial2003()
+                     is R3(-(e+s)) * R2(d) * R3(e), where the CIP is
+                     X = sin(d)cos(e), Y = sin(d)sin(e) */
+               double deps, dpsi, dpsipr, depspr;
+               EarthOrientation::nutationAngles2003(T, deps, dpsi);
+               EarthOrientation::precessionRateCorrections2003(T, dpsipr,
+                                                               depspr);
+               double eps = EarthOrientation::obliquity1996(T) + depspr;
+               Matrix33 NPB =
+                  Matrix33(EarthOrientation::nutationMatrix(eps, dpsi, deps)) *
+                  Matrix33(EarthOrientation::precessionMatrix2003(T));
+               X[i] = NPB(2, 0);
+               Y[i] = NPB(2, 1);
+               double r2(X[i] * X[i] + Y[i] * Y[i]);
+               double e(r2 != 0.0 ? ::atan2(Y[i], X[i]) : 0.0);
+               double d(::atan(::sqrt(r2 / (1.0 - r2))));
+               Matrix33 M = NPB * transpose(Matrix33::rotation(d, 2) *
+                                            Matrix33::rotation(e, 3));
+               S[i] = -::atan2(M(0, 1), M(0, 0)) - e;
+            }
+
+               // EOPs, with UT1 relative to TT
+            EarthOrientation eo = eops.getEOP(utc.dMJD(), conv);
+            XP[i]  = eo.xp;
+            YP[i]  = eo.yp;
+            DUT[i] = eo.UT1mUTC - TTmUTC;
+         }
+
+            // keep s continuous (it is computed from an angle for IERS2003)
+         for (size_t i = 1; i < n; i++)
+         {
+            while (S[i] - S[i - 1] > EarthOrientation::PI)
+               S[i] -= EarthOrientation::TWOPI;
+            while (S[i] - S[i - 1] < -EarthOrientation::PI)
+               S[i] += EarthOrientation::TWOPI;
+         }
+      }
+      catch (Exception& e)
+      {
+         X.clear();
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   const SMatrix<double, 3, 3>& EarthRotationTable::rotation(const EphTime& t)
+   {
+      try
+      {
+         EphTime tt;
+         double TTmUTC = toTT(t, tt);
+
+            // reuse the result for identical epochs
+         if (tt.lMJD() == cacheMJD && tt.secOfDay() == cacheSOD)
+         {
+            return cacheRot;
+         }
+
+         double wts[4];
+         size_t i = weights(tt, wts);
+         double Xc(interp(X, i, wts)), Yc(interp(Y, i, wts));
+         double s(interp(S, i, wts));
+         double xp(interp(XP, i, wts) * EarthOrientation::ARCSEC_TO_RAD);
+         double yp(interp(YP, i, wts) * EarthOrientation::ARCSEC_TO_RAD);
+         double UT1mUTC(interp(DUT, i, wts) + TTmUTC);
+
+            // GCRS-to-CIRS, as in EarthOrientation::ECEFtoInertial2010()
+         double r2(Xc * Xc + Yc * Yc);
+         double e(r2 != 0.0 ? ::atan2(Yc, Xc) : 0.0);
+         double d(::atan(::sqrt(r2 / (1.0 - r2))));
+         Matrix33 GCRStoCIRS = Matrix33::rotation(-(e + s), 3) *
+                               Matrix33::rotation(d, 2) *
+                               Matrix33::rotation(e, 3);
+
+            // CIRS-to-TIRS
+         double era = EarthOrientation::EarthRotationAngle(tt, UT1mUTC);
+         Matrix33 CIRStoTIRS = Matrix33::rotation(era, 3);
+
+            // TIRS-to-ITRS, cf. EarthOrientation::polarMotionMatrix2003()
+         double sp = EarthOrientation::Sprime(EarthOrientation::coordTransTime(tt));
+         Matrix33 polarMotion = Matrix33::rotation(-yp, 1) *
+                                Matrix33::rotation(-xp, 2) *
+                                Matrix33::rotation(sp, 3);
+
+         cacheRot = transpose(polarMotion * CIRStoTIRS * GCRStoCIRS);
+         cacheMJD = tt.lMJD();
+         cacheSOD = tt.secOfDay();
+
+         return cacheRot;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationTable::getCIP(const EphTime& t, double& Xcip,
+                                   double& Ycip, double& s)
+   {
+      try
+      {
+         EphTime tt;
+         toTT(t, tt);
+         double wts[4];
+         size_t i = weights(tt, wts);
+         Xcip = interp(X, i, wts);
+         Ycip = interp(Y, i, wts);
+         s    = interp(S, i, wts);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   EarthOrientation EarthRotationTable::getEOP(const EphTime& t)
+   {
+      try
+      {
+         EphTime tt;
+         double TTmUTC = toTT(t, tt);
+         double wts[4];
+         size_t i = weights(tt, wts);
+
+         EarthOrientation eo;
+         eo.xp         = interp(XP, i, wts);
+         eo.yp         = interp(YP, i, wts);
+         eo.UT1mUTC    = interp(DUT, i, wts) + TTmUTC;
+         eo.convention = convention;
+         return eo;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   size_t EarthRotationTable::weights(const EphTime& tt, double wts[4]) const
+   {
+      if (X.empty())
+      {
+         InvalidRequest ir("EarthRotationTable has not been initialized");
+         GNSSTK_THROW(ir);
+      }
+
+         /* the grid points i..i+3 are used, with the time between i+1 and
+            i+2 except at the very ends of the table */
+      double x = (double(tt.lMJD()) - begMJD + tt.secOfDay() / 86400.0) / step;
+      if (x < 1.0 - 1.e-9 || x > double(X.size() - 2) + 1.e-9)
+      {
+         InvalidRequest ir("Time lies outside the EarthRotationTable");
+         GNSSTK_THROW(ir);
+      }
+      long k = long(::floor(x)) - 1;
+      if (k < 0)
+      {
+         k = 0;
+      }
+      if (k > long(X.size()) - 4)
+      {
+         k = long(X.size()) - 4;
+      }
+
+         // 4-point Lagrange weights at u = x-k, for nodes 0,1,2,3
+      double u = x - double(k);
+      double u0(u), u1(u - 1.0), u2(u - 2.0), u3(u - 3.0);
+      wts[0] = -u1 * u2 * u3 / 6.0;
+      wts[1] = u0 * u2 * u3 / 2.0;
+      wts[2] = -u0 * u1 * u3 / 2.0;
+      wts[3] = u0 * u1 * u2 / 6.0;
+
+      return size_t(k);
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   double EarthRotationTable::toTT(const EphTime& t, EphTime& tt)
+   {
+      tt = t;
+      tt.convertSystemTo(TimeSystem::TT);
+      EphTime utc(tt);
+      utc.convertSystemTo(TimeSystem::UTC);
+      return ((tt.lMJD() - utc.lMJD()) * 86400.0 +
+              (tt.secOfDay() - utc.secOfDay()));
+   }
+
+} // end namespace gnsstk
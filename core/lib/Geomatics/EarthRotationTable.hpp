@@ -0,0 +1,212 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file EarthRotationTable.hpp
+    Include file defining the EarthRotationTable class, which tabulates the
+    celestial intermediate pole quantities and EOPs on a time grid and
+    interpolates them to produce the ECEF-to-inertial rotation quickly. */
+
+#ifndef CLASS_EARTHROTATIONTABLE_INCLUDE
+#define CLASS_EARTHROTATIONTABLE_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <vector>
+// GNSSTk
+#include "Exception.hpp"
+#include "Matrix.hpp"
+#include "SMatrix.hpp"
+// geomatics
+#include "EOPStore.hpp"
+#include "EarthOrientation.hpp"
+#include "EphTime.hpp"
+#include "IERSConvention.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gnsstk
+{
+
+      /**
+       class EarthRotationTable is a fast replacement for
+       EarthOrientation::ECEFtoInertial() when the rotation is needed at many
+       epochs, e.g. at every integration step and every observation of precise
+       orbit work. The full computation sums the IERS nutation series of
+       thousands of terms and builds the precession-nutation, Earth rotation
+       and polar motion matrices at every call. This class instead computes, on
+       a regular grid in TT, the coordinates X,Y of the celestial intermediate
+       pole (CIP) and the CIO locator s, plus the EOPs xp, yp and UT1
+       (interpolated and tide corrected by EOPStore), and then interpolates
+       these with a 4-point Lagrange polynomial. The Earth rotation angle and
+       s' are computed exactly from the interpolated UT1 and the time. The
+       rotation for the most recent epoch is kept, and reused when the same
+       epoch is requested again.
+
+       UT1 is tabulated as UT1-TT, which is continuous across leap seconds.
+
+       Only the CIO-based conventions IERS2003 and IERS2010 are supported; for
+       IERS2003 X, Y and s are extracted from the precession-nutation-bias
+       matrix of EarthOrientation::ECEFtoInertial(), so the table reproduces
+       it at the grid nodes.
+
+       Interpolation error: the largest terms that are not smooth on the grid
+       are the diurnal and semi-diurnal ocean tide corrections to the EOPs.
+       Compared with EarthOrientation::ECEFtoInertial() (see
+       EarthRotationTable_T), the largest element of the difference of the
+       rotation matrices is about 1.5e-12 for the default grid of one hour
+       (0.04 mm at GPS altitude), 1e-10 for three hours and 8e-10 for six
+       hours (5 mm at the Earth's surface, 2 cm at GPS altitude).
+      */
+   class EarthRotationTable
+   {
+   public:
+         /// Constructor; the table is empty until initialize() is called.
+      EarthRotationTable()
+            : convention(IERSConvention::Unknown), begMJD(0.0), step(0.0),
+              cacheMJD(-1), cacheSOD(0.0)
+      {
+      }
+
+         /**
+          Fill the table over the given time span.
+          @param eops EOPStore covering the span plus one day on either side.
+          @param conv IERS convention, IERS2003 or IERS2010.
+          @param beg first time at which the table will be used.
+          @param end last time at which the table will be used.
+          @param stepDays spacing of the grid in days (default one hour).
+          @throw Exception if the convention is not supported, the step is
+                     not positive or end is before beg.
+          @throw InvalidRequest if the EOPStore does not cover the span.
+         */
+      void initialize(EOPStore& eops, const IERSConvention& conv,
+                      const EphTime& beg, const EphTime& end,
+                      double stepDays = 1.0 / 24.0);
+
+         /// Return true if the table has been initialized.
+      bool isValid() const { return (!X.empty()); }
+
+         /// Return the spacing of the grid in days.
+      double getStepDays() const { return step; }
+
+         /// Return the number of grid points.
+      size_t size() const { return X.size(); }
+
+         /// Return the IERS convention of the table.
+      IERSConvention getConvention() const { return convention; }
+
+         /**
+          Rotation from ECEF to the conventional inertial frame, interpolated
+          from the table. The rotation for the most recent epoch is kept and
+          returned again if the same epoch is requested.
+          @param t epoch of the rotation, UTC, TT or TDB.
+          @return reference to the 3x3 rotation, valid until the next call.
+          @throw InvalidRequest if t lies outside the table.
+         */
+      const SMatrix<double, 3, 3>& rotation(const EphTime& t);
+
+         /**
+          Rotation from ECEF to the conventional inertial frame, as
+          EarthOrientation::ECEFtoInertial() would compute it.
+          @param t epoch of the rotation, UTC, TT or TDB.
+          @return 3x3 rotation matrix
+          @throw InvalidRequest if t lies outside the table.
+         */
+      Matrix<double> ECEFtoInertial(const EphTime& t)
+      {
+         return Matrix<double>(rotation(t));
+      }
+
+         /**
+          Interpolate the coordinates of the CIP and the CIO locator.
+          @param t epoch of interest, UTC, TT or TDB.
+          @param Xcip X coordinate of the CIP (radians)
+          @param Ycip Y coordinate of the CIP (radians)
+          @param s CIO locator (radians)
+          @throw InvalidRequest if t lies outside the table.
+         */
+      void getCIP(const EphTime& t, double& Xcip, double& Ycip, double& s);
+
+         /**
+          Interpolate the EOPs.
+          @param t epoch of interest, UTC, TT or TDB.
+          @return EarthOrientation with xp, yp (arcsec) and UT1mUTC (sec)
+          @throw InvalidRequest if t lies outside the table.
+         */
+      EarthOrientation getEOP(const EphTime& t);
+
+   private:
+         /**
+          Find the four grid points for t and the Lagrange weights.
+          @param tt the time of interest in TT
+          @param wts the four weights (output)
+          @return index of the first of the four grid points
+          @throw InvalidRequest if t lies outside the table.
+         */
+      size_t weights(const EphTime& tt, double wts[4]) const;
+
+         /// Sum the four tabulated values starting at i with the weights.
+      static double interp(const std::vector<double>& v, size_t i,
+                           const double wts[4])
+      {
+         return (wts[0] * v[i] + wts[1] * v[i + 1] + wts[2] * v[i + 2] +
+                 wts[3] * v[i + 3]);
+      }
+
+         /// Convert t to TT, and return TT-UTC in seconds at t.
+      static double toTT(const EphTime& t, EphTime& tt);
+
+      IERSConvention convention; ///< convention of the table
+      double begMJD;             ///< MJD(TT) of the first grid point
+      double step;               ///< grid spacing in days
+
+         /// tabulated CIP X and Y, and CIO locator s (radians)
+      std::vector<double> X, Y, S;
+         /// tabulated polar motion xp and yp (arcsec)
+      std::vector<double> XP, YP;
+         /// tabulated UT1-TT (seconds)
+      std::vector<double> DUT;
+
+      long cacheMJD;    ///< integer MJD(TT) of the cached rotation, or -1
+      double cacheSOD;  ///< seconds of day (TT) of the cached rotation
+      SMatrix<double, 3, 3> cacheRot; ///< the cached rotation
+
+   }; // end class EarthRotationTable
+
+} // end namespace gnsstk
+
+#endif // CLASS_EARTHROTATIONTABLE_INCLUDE
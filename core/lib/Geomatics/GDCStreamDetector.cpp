@@ -0,0 +1,602 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file GDCStreamDetector.cpp
+    Streaming cycle slip detection with the algorithms of the GNSSTK
+    Discontinuity Corrector. */
+
+//------------------------------------------------------------------------------------
+// system
+#include <algorithm>
+#include <cmath>
+// gnsstk
+#include "FreqConsts.hpp"
+// geomatics
+#include "GDCStreamDetector.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   const unsigned short GDCStreamDetector::BAD    = 0;
+   const unsigned short GDCStreamDetector::OK     = 1;
+   const unsigned short GDCStreamDetector::WLSLIP = 2;
+   const unsigned short GDCStreamDetector::GFSLIP = 4;
+   const unsigned short GDCStreamDetector::BREAK  = 8;
+
+   //---------------------------------------------------------------------------------
+   GDCStreamDetector::GDCStreamDetector(GDCconfiguration& config,
+                                        SatelliteSystem sys, int GLOn)
+   {
+      const double DT = config.getParameter("DT");
+      if (DT <= 0.0)
+      {
+         Exception e("GDCStreamDetector requires DT to be set");
+         GNSSTK_THROW(e);
+      }
+      if (sys == SatelliteSystem::Glonass && (GLOn < -7 || GLOn > 7))
+      {
+         Exception e("GDCStreamDetector requires the GLONASS frequency channel");
+         GNSSTK_THROW(e);
+      }
+
+         // wavelengths and coefficients of the linear combinations
+      wl1 = getWavelength(sys, 1, GLOn);
+      wl2 = getWavelength(sys, 2, GLOn);
+      if (wl1 == 0.0 || wl2 == 0.0)
+      {
+         Exception e("GDCStreamDetector: satellite system has no bands 1 and 2");
+         GNSSTK_THROW(e);
+      }
+      const double F1oF2 = wl2 / wl1;
+      const double F2oF1 = wl1 / wl2;
+      wlwl               = 1.0 / (1.0 / wl1 - 1.0 / wl2);
+      wlgf               = wl2 - wl1;
+      wl1r               = 1.0 / (1.0 + F2oF1);
+      wl2r               = 1.0 / (1.0 + F1oF2);
+      wl1p               = wl1 / (1.0 - F2oF1);
+      wl2p               = wl2 / (1.0 - F1oF2);
+      gf1p               = wl1;
+      gf2p               = -wl2;
+
+         // parameters, in units of WL cycles, GF cycles and points
+      maxGap    = config.getParameter("MaxGap");
+      WLobvious = config.getParameter("WLobviousLimit") *
+                  config.getParameter("WLSigma");
+      GFobvious = config.getParameter("GFobviousLimit") *
+                  config.getParameter("GFVariation") / wlgf;
+      WLwidth =
+         10 + static_cast<int>(0.5 + config.getParameter("WLWindowWidth") / DT);
+      WLedge        = static_cast<int>(config.getParameter("WLSlipEdge"));
+      WLsize        = config.getParameter("WLSlipSize");
+      WLexcess      = config.getParameter("WLSlipExcess");
+      WLseparation  = config.getParameter("WLSlipSeparation");
+      GFwidth       = static_cast<int>(config.getParameter("GFSlipWidth"));
+      GFedge        = static_cast<int>(config.getParameter("GFSlipEdge"));
+      GFoutlier     = config.getParameter("GFSlipOutlier");
+      GFsize        = config.getParameter("GFSlipSize");
+      GFstepToNoise = config.getParameter("GFSlipStepToNoise");
+      GFtoStep      = config.getParameter("GFSlipToStep");
+      GFtoNoise     = config.getParameter("GFSlipToNoise");
+      rangeCheck    = 2 * config.getParameter("WLSigma") / (0.83 * wlgf);
+      GFskipSmall   = (config.getParameter("GFSkipSmall") != 0.0);
+
+         /* WL slips are decided WLwidth+WLedge-1 points behind the newest, GF
+            slips GFwidth behind, but no sooner than WL; the buffer holds the
+            past panes of the oldest point still being tested */
+      lag = std::max(GFwidth, WLwidth + WLedge - 1);
+      cap = std::max(2 * WLwidth + WLedge + 1, lag + GFwidth + 3);
+
+      reset();
+   }
+
+   //---------------------------------------------------------------------------------
+   void GDCStreamDetector::reset()
+   {
+      buf.clear();
+      base = nadd = 0;
+      nextK = nextC = nextG = nextE = 0;
+      nseg = curSeg = 0;
+      haveBias      = false;
+      wlbias = gfbias = resbias = 0.0;
+   }
+
+   //---------------------------------------------------------------------------------
+   unsigned int GDCStreamDetector::pending() const
+   {
+      return static_cast<unsigned int>(nadd - nextE);
+   }
+
+   //---------------------------------------------------------------------------------
+   int GDCStreamDetector::add(const Epoch& t, double L1, double L2, double P1,
+                              double P2, bool good, vector<Result>& out)
+   {
+      int n = 0;
+      unsigned long i, j, h;
+
+      if (!buf.empty() && t <= buf.back().time)
+      {
+         Exception e("GDCStreamDetector: time tags must increase");
+         GNSSTK_THROW(e);
+      }
+
+         // a gap ends the stream
+      if (good && goodNeighbor(nadd, -1, false, j) && t - at(j).time > maxGap)
+      {
+         n += flush(out);
+      }
+
+      Point p;
+      p.time = t;
+      p.flag = (good ? OK : BAD);
+      p.head = false;
+      p.seg  = curSeg;
+      p.wl = p.gf = p.res = p.dgf = 0.0;
+      p.step = p.lim = p.WLslip = p.GFslip = 0.0;
+      if (good)
+      {
+         double wlr = wl1r * P1 + wl2r * P2; // narrow lane range (m)
+         double wlp = wl1p * L1 + wl2p * L2; // wide lane phase (m)
+         double gfr = P1 - P2;               // geometry-free range (m)
+         double gfp = gf1p * L1 + gf2p * L2; // geometry-free phase (m)
+         double wl  = (wlp - wlr) / wlwl;    // wide lane bias (WL cycles)
+         double gf  = gfp / wlgf;            // GF phase (GF cycles)
+         double res = (gfp + gfr) / wlgf;    // GF residual (GF cycles)
+         if (!haveBias)
+         {
+            wlbias   = wl;
+            gfbias   = gf;
+            resbias  = res;
+            haveBias = true;
+         }
+         p.wl  = wl - wlbias;
+         p.gf  = gf - gfbias;
+         p.res = res - resbias;
+      }
+      buf.push_back(p);
+      i = nadd++;
+
+      if (good)
+      {
+         Point& P = at(i);
+         if (!goodNeighbor(i, -1, false, j))
+         { // first point of the stream
+            P.flag |= BREAK;
+            newSegment(i);
+         }
+         else
+         {
+               // obvious slips, from the first differences
+            P.dgf       = P.gf - at(j).gf;
+            bool obvWL = (fabs(P.wl - at(j).wl) > WLobvious);
+            bool obvGF = (fabs(P.dgf) > GFobvious);
+            Point& Q    = at(j);
+
+               // an obvious slip at j, reversed here: j is an outlier
+            if ((obvWL || obvGF) && Q.head && !(Q.flag & BREAK) &&
+                j >= nextK && goodNeighbor(j, -1, false, h) &&
+                fabs(P.wl - at(h).wl) <= WLobvious &&
+                fabs(P.gf - at(h).gf) <= GFobvious)
+            {
+               Q.flag = BAD;
+               Q.head = false;
+               P.seg = curSeg = at(h).seg;
+               P.dgf = P.gf - at(h).gf;
+               obvWL = obvGF = false;
+            }
+
+            if (obvWL || obvGF)
+            {
+               P.flag |= (obvWL ? WLSLIP : 0) | (obvGF ? GFSLIP : 0);
+               newSegment(i);
+            }
+         }
+      }
+
+         // run the tests that now have enough data, in order
+      while (nadd >= nextK + WLwidth)
+      {
+         testWL(nextK++);
+      }
+      while (nextK > nextC + WLedge)
+      {
+         decideWL(nextC++);
+      }
+      while (nadd > nextG + lag && nextC > nextG)
+      {
+         testGF(nextG++);
+      }
+      while (nextG > nextE + 1)
+      {
+         emit(nextE++, out);
+         n++;
+      }
+
+         // drop points that can no longer be in a pane
+      while (buf.size() > cap && base < nextE)
+      {
+         buf.pop_front();
+         base++;
+      }
+
+      return n;
+   }
+
+   //---------------------------------------------------------------------------------
+   int GDCStreamDetector::flush(vector<Result>& out)
+   {
+      int n = 0;
+      while (nextK < nadd)
+      {
+         testWL(nextK++);
+      }
+      while (nextC < nadd)
+      {
+         decideWL(nextC++);
+      }
+      while (nextG < nadd)
+      {
+         testGF(nextG++);
+      }
+      while (nextE < nadd)
+      {
+         emit(nextE++, out);
+         n++;
+      }
+      reset();
+      return n;
+   }
+
+   //---------------------------------------------------------------------------------
+   bool GDCStreamDetector::goodNeighbor(unsigned long i, int dir, bool sameSeg,
+                                        unsigned long& j)
+   {
+      long k = long(i) + dir;
+      for (; k >= long(base) && k < long(nadd); k += dir)
+      {
+         const Point& Q = at(k);
+         if (!(Q.flag & OK))
+         {
+            continue;
+         }
+         if (sameSeg && Q.seg != at(i).seg)
+         {
+            return false;
+         }
+         j = k;
+         return true;
+      }
+      return false;
+   }
+
+   //---------------------------------------------------------------------------------
+   void GDCStreamDetector::pane(long i, int dir, unsigned int n,
+                                unsigned long seg, double Point::*field,
+                                bool noHead, Stats<double>& st)
+   {
+      st.Reset();
+      for (; i >= long(base) && i < long(nadd) && st.N() < n; i += dir)
+      {
+         const Point& Q = at(i);
+         if (!(Q.flag & OK))
+         {
+            continue;
+         }
+         if (Q.seg != seg || (noHead && Q.head))
+         {
+            break;
+         }
+         st.Add(Q.*field);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void GDCStreamDetector::newSegment(unsigned long i)
+   {
+      const unsigned long old = at(i).seg;
+      nseg++;
+      for (unsigned long k = i; k < nadd; k++)
+      {
+         if (at(k).seg == old)
+         {
+            at(k).seg = nseg;
+         }
+      }
+      if (curSeg == old)
+      {
+         curSeg = nseg;
+      }
+      at(i).head = true;
+   }
+
+   //---------------------------------------------------------------------------------
+   // the 'two-paned sliding window' of the corrector's WLstatSweep(), with the
+   // future pane starting at point k
+   void GDCStreamDetector::testWL(unsigned long k)
+   {
+      Point& P = at(k);
+      P.step = P.lim = 0.0;
+      if (!(P.flag & OK))
+      {
+         return;
+      }
+
+      Stats<double> pastSt, futureSt;
+      pane(k, 1, WLwidth, P.seg, &Point::wl, false, futureSt);
+      pane(long(k) - 1, -1, WLwidth, P.seg, &Point::wl, false, pastSt);
+      if (pastSt.N() > 0 && futureSt.N() > 0)
+      {
+         P.step = futureSt.Average() - pastSt.Average();
+      }
+      P.lim = ::sqrt(futureSt.Variance() + pastSt.Variance());
+   }
+
+   //---------------------------------------------------------------------------------
+   // the corrector's foundWLsmallSlip(): conditions 1, 2 and 6 at c, and 4 and
+   // 5 over WLedge good points on each side
+   void GDCStreamDetector::decideWL(unsigned long c)
+   {
+      Point& P = at(c);
+      unsigned long j;
+      if (!(P.flag & OK))
+      {
+         return;
+      }
+
+         // start of a segment: estimate the slip from the previous segment
+      if (P.head)
+      {
+         if (!(P.flag & BREAK) && goodNeighbor(c, -1, false, j))
+         {
+            Stats<double> pastSt, futureSt;
+            pane(c, 1, WLwidth, P.seg, &Point::wl, false, futureSt);
+            pane(j, -1, WLwidth, at(j).seg, &Point::wl, false, pastSt);
+            P.WLslip = futureSt.Average() - pastSt.Average();
+         }
+         return;
+      }
+
+      const double step = fabs(P.step);
+      const double lim  = P.lim;
+      if (step <= WLsize || step - lim <= WLexcess ||
+          (step - lim) / lim <= WLseparation)
+      {
+         return;
+      }
+
+         // step is a local maximum and lim a local minimum; allow one miss
+      const double slope = (step - lim) / (8.0 * WLedge);
+      unsigned int k, pass4 = 0, pass5 = 0;
+      unsigned long jp = c, jm = c;
+      for (k = 0; k < WLedge; k++)
+      {
+         if (!goodNeighbor(jp, 1, true, jp) || jp >= nextK)
+         {
+            break;
+         }
+         if (step - fabs(at(jp).step) > k * slope)
+         {
+            pass4++;
+         }
+         if (lim - at(jp).lim < -(k * slope))
+         {
+            pass5++;
+         }
+
+         if (!goodNeighbor(jm, -1, true, jm) || at(jm).head)
+         {
+            break;
+         }
+         if (step - fabs(at(jm).step) > k * slope)
+         {
+            pass4++;
+         }
+         if (lim - at(jm).lim < -(k * slope))
+         {
+            pass5++;
+         }
+      }
+      if (pass4 + 1 < 2 * WLedge || pass5 + 1 < 2 * WLedge)
+      {
+         return;
+      }
+
+         // a slip: start a new segment here, and redo the tests after it
+      P.flag  |= WLSLIP;
+      P.WLslip = P.step;
+      newSegment(c);
+      for (j = c + 1; j < nextK; j++)
+      {
+         testWL(j);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   // the corrector's detectGFsmallSlips() at point g: outlier test on the
+   // previous point, then slip test, on the first differences of the GF phase
+   void GDCStreamDetector::testGF(unsigned long g)
+   {
+      Point& P = at(g);
+      unsigned long j;
+      Stats<double> pastSt, futureSt, pastRes, futureRes;
+      if (!(P.flag & OK))
+      {
+         return;
+      }
+
+         // start of a segment: estimate the slip from the previous segment
+      if (P.head)
+      {
+         if (!(P.flag & BREAK) && goodNeighbor(g, -1, false, j))
+         {
+            pane(j, -1, GFwidth, at(j).seg, &Point::dgf, true, pastSt);
+            pane(g + 1, 1, GFwidth, P.seg, &Point::dgf, true, futureSt);
+            P.GFslip = P.dgf - (pastSt.Average() + futureSt.Average()) / 2.0;
+            if (fabs(P.GFslip) > GFsize)
+            {
+               P.flag |= GFSLIP;
+            }
+         }
+         return;
+      }
+
+      pane(g + 1, 1, GFwidth, P.seg, &Point::dgf, true, futureSt);
+
+         /* outlier: j and g have large first differences of opposite sign,
+            relative to the pane averages, which stand in for the corrector's
+            fit to the GF range */
+      if (goodNeighbor(g, -1, true, j) && !at(j).head && j >= nextE)
+      {
+         Point& Q = at(j);
+         pane(long(j) - 1, -1, GFwidth, P.seg, &Point::dgf, true, pastSt);
+         const double pmag = Q.dgf - pastSt.Average();
+         const double fmag = P.dgf - futureSt.Average();
+         const double noise =
+            GFoutlier * ::sqrt(pastSt.Variance() + futureSt.Variance());
+         if (pmag * fmag < 0.0 && fabs(pmag) >= noise && fabs(fmag) >= noise)
+         {
+            if (Q.flag & GFSLIP)
+            { // let g be the slip and j the outlier
+               P.flag  |= GFSLIP;
+               P.GFslip = Q.GFslip;
+            }
+            Q.flag = BAD;
+            P.dgf += Q.dgf;
+         }
+      }
+
+      pane(long(g) - 1, -1, GFwidth, P.seg, &Point::dgf, true, pastSt);
+      pane(long(g) - 1, -1, GFwidth, P.seg, &Point::res, true, pastRes);
+      pane(g + 1, 1, GFwidth, P.seg, &Point::res, true, futureRes);
+      double mag;
+      if (isGFslip(g, pastSt, futureSt, pastRes, futureRes, mag))
+      {
+         P.flag  |= GFSLIP;
+         P.GFslip = mag;
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   // the corrector's foundGFsmallSlip()
+   bool GDCStreamDetector::isGFslip(unsigned long g, const Stats<double>& pastSt,
+                                    const Stats<double>& futureSt,
+                                    const Stats<double>& pastRes,
+                                    const Stats<double>& futureRes, double& mag)
+   {
+      const Point& P = at(g);
+      double pmag = 0.0, fmag = 0.0;
+      if (pastSt.N() > 0)
+      {
+         pmag = P.dgf - pastSt.Average();
+      }
+      if (futureSt.N() > 0)
+      {
+         fmag = P.dgf - futureSt.Average();
+      }
+      const double noise = ::sqrt(pastSt.Variance() + futureSt.Variance());
+      mag                = (pmag + fmag) / 2.0;
+
+         // 1. slip must be non-trivial
+      if (fabs(mag) <= GFsize)
+      {
+         return false;
+      }
+         // 2. change in average is larger than noise
+      if (fabs(pmag - fmag) / noise <= GFstepToNoise)
+      {
+         return false;
+      }
+         // 3. slip is large compared to change in average
+      if (fabs(mag) <= GFtoStep * fabs(pmag - fmag))
+      {
+         return false;
+      }
+         // 4. magnitude is large compared to noise
+      if (fabs(mag) <= GFtoNoise * noise)
+      {
+         return false;
+      }
+         // 5. not too close to the edge
+      if (static_cast<int>(pastSt.N()) < GFedge ||
+          static_cast<int>(futureSt.N()) < GFedge + 1)
+      {
+         return false;
+      }
+         // 6. large slips (compared to range noise) must be seen in GFR-GFP
+      if (fabs(mag) > rangeCheck)
+      {
+         double magGFR = futureRes.Average() - pastRes.Average();
+         double mtnGFR = fabs(magGFR) / ::sqrt(pastRes.Variance() +
+                                               futureRes.Variance());
+         if (fabs(mag - magGFR) > fabs(magGFR) || mtnGFR < 3)
+         {
+            return false;
+         }
+      }
+         // 8. if switch is on and there is no WL slip here - skip
+      if (GFskipSmall && !(P.flag & WLSLIP))
+      {
+         return false;
+      }
+
+      return true;
+   }
+
+   //---------------------------------------------------------------------------------
+   void GDCStreamDetector::emit(unsigned long e, vector<Result>& out)
+   {
+      const Point& P = at(e);
+      Result r;
+      r.time   = P.time;
+      r.flag   = P.flag;
+      r.WLslip = r.GFslip = 0.0;
+      r.N1 = r.N2 = 0;
+      if (P.flag & (WLSLIP | GFSLIP))
+      {
+            /* the WL bias jumps by N1-N2, the GF phase by
+               (wl1*N1-wl2*N2)/wlgf = wl2*(N1-N2)/wlgf - N1 */
+         r.WLslip = P.WLslip;
+         r.GFslip = P.GFslip;
+         long NWL = static_cast<long>(floor(P.WLslip + 0.5));
+         r.N1     = static_cast<long>(floor(wl2 * NWL / wlgf - P.GFslip + 0.5));
+         r.N2     = r.N1 - NWL;
+      }
+      out.push_back(r);
+   }
+
+} // end namespace gnsstk
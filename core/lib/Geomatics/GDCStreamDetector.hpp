@@ -0,0 +1,256 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file GDCStreamDetector.hpp
+    Streaming cycle slip detection with the algorithms of the GNSSTK
+    Discontinuity Corrector (DiscCorr.hpp). Where the corrector needs a whole
+    satellite pass, the detector consumes one epoch at a time, keeps a bounded
+    buffer of recent epochs, and emits each epoch, flagged and with estimated
+    slip sizes, a fixed number of epochs later. */
+
+#ifndef GNSSTK_GDC_STREAM_DETECTOR_INCLUDE
+#define GNSSTK_GDC_STREAM_DETECTOR_INCLUDE
+
+#include <deque>
+#include <vector>
+
+#include "Epoch.hpp"
+#include "Exception.hpp"
+#include "GDCconfiguration.hpp"
+#include "SatelliteSystem.hpp"
+#include "Stats.hpp"
+
+namespace gnsstk
+{
+   /** @addtogroup rinexutils */
+   //@{
+
+      /**
+       GDCStreamDetector detects cycle slips in dual-frequency phase, one
+       satellite at a time, as the data arrive. It applies the tests of the
+       GNSSTK Discontinuity Corrector, with the same GDCconfiguration
+       parameters:
+       - obvious slips: a first difference of the wide lane (WL) bias or of
+         the geometry-free (GF) phase larger than WLobviousLimit*WLSigma or
+         GFobviousLimit*GFVariation; an obvious slip immediately followed by
+         its reversal is an outlier.
+       - small WL slips: the 'two-paned sliding window' test on the WL bias,
+         panes of 10+WLWindowWidth/DT points, with the WLSlipSize,
+         WLSlipExcess and WLSlipSeparation tests and the local extremum test
+         over WLSlipEdge points on each side.
+       - small GF slips and GF outliers: the two-paned window on the first
+         difference of the GF phase, panes of GFSlipWidth points, with the
+         GFSlip* tests, including the range check and GFSkipSmall.
+
+       Obvious slips, WL slips and gaps longer than MaxGap start a new segment,
+       and no window extends across a segment boundary. Where the corrector
+       removes the ionospheric trend from the GF phase with a polynomial fit
+       over the whole segment, the detector relies on the averages of the two
+       panes, which follow the local trend.
+
+       Each epoch passed to add() is returned, as a Result, exactly latency()
+       epochs later (or by flush()); memory is bounded by capacity() epochs.
+       A Result flagged with a slip carries the estimated slip in the WL bias
+       and in the GF phase, and the corresponding integer slips on L1 and L2.
+       Nothing is fixed: it is up to the caller to apply the slips.
+      */
+   class GDCStreamDetector
+   {
+   public:
+         /// Flags in Result::flag
+      static const unsigned short BAD;    ///< missing or edited data
+      static const unsigned short OK;     ///< good data
+      static const unsigned short WLSLIP; ///< slip found in the WL bias
+      static const unsigned short GFSLIP; ///< slip found in the GF phase
+         /// first epoch, or first after a gap or reset; no slip estimate
+      static const unsigned short BREAK;
+
+         /// The outcome for one epoch.
+      struct Result
+      {
+         Epoch time;          ///< time tag passed to add()
+         unsigned short flag; ///< OR of the flags above
+         double WLslip;       ///< estimated slip in WL bias (WL cycles)
+         double GFslip;       ///< estimated slip in GF phase (cycles of wl2-wl1)
+         long N1;             ///< estimated slip on L1 (cycles)
+         long N2;             ///< estimated slip on L2 (cycles)
+      };
+
+         /**
+          Constructor.
+          @param config  configuration; parameters are read here, so later
+                          changes to config have no effect on this object.
+          @param sys     satellite system of the data, which has phase and
+                          pseudorange on RINEX bands 1 and 2.
+          @param GLOn    GLONASS frequency channel (-7<=n<=7), required for
+                          Glonass.
+          @throw Exception if DT is not set, the system has no bands 1 and 2,
+                          or the GLONASS channel is invalid.
+         */
+      GDCStreamDetector(GDCconfiguration& config,
+                        SatelliteSystem sys = SatelliteSystem::GPS,
+                        int GLOn = -99);
+
+         /**
+          Add one epoch of data; time tags must increase.
+          @param t     time tag of the data
+          @param L1,L2 phase on bands 1 and 2 (cycles)
+          @param P1,P2 pseudorange on bands 1 and 2 (meters)
+          @param good  if false the data is missing or bad and is not used
+          @param out   Results that are now final are appended to this
+          @return number of Results appended to out
+          @throw Exception if the time tag does not increase
+         */
+      int add(const Epoch& t, double L1, double L2, double P1, double P2,
+              bool good, std::vector<Result>& out);
+
+         /**
+          Finish the stream, e.g. at the end of a pass, and reset. Tests for
+          the last epochs use the data available.
+          @param out   Results for all pending epochs are appended to this
+          @return number of Results appended to out
+         */
+      int flush(std::vector<Result>& out);
+
+         /// Discard all pending epochs and start over.
+      void reset();
+
+         /// Number of epochs between add() of an epoch and its Result.
+      unsigned int latency() const { return lag + 1; }
+
+         /// Maximum number of epochs kept in the buffer.
+      unsigned int capacity() const { return cap; }
+
+         /// Number of epochs waiting for their Result.
+      unsigned int pending() const;
+
+   private:
+         /// one epoch in the buffer
+      struct Point
+      {
+         Epoch time;          ///< time tag
+         unsigned short flag; ///< OK, BAD, slip flags
+         bool head;           ///< first good point of its segment
+         unsigned long seg;   ///< segment number
+         double wl;           ///< WL bias (WL cycles) - bias
+         double gf;           ///< GF phase (GF cycles) - bias
+         double res;          ///< GF phase + GF range (GF cycles) - bias
+         double dgf;          ///< first difference of gf
+         double step;         ///< WL window test: future - past average
+         double lim;          ///< WL window limit: sqrt(sum of variances)
+         double WLslip;       ///< estimated slip in wl
+         double GFslip;       ///< estimated slip in gf
+      };
+
+         /// point with sequence number i, which must be in the buffer
+      Point& at(unsigned long i) { return buf[i - base]; }
+
+         /// sequence number j of the nearest good point to i in direction dir
+         /// (+1,-1), in the same segment if sameSeg; false if there is none
+      bool goodNeighbor(unsigned long i, int dir, bool sameSeg,
+                        unsigned long& j);
+
+         /** accumulate field of up to n good points, starting at sequence
+          * number i and stepping by dir (+1,-1) within segment seg; if noHead,
+          * stop before the head of the segment */
+      void pane(long i, int dir, unsigned int n, unsigned long seg,
+                double Point::*field, bool noHead, Stats<double>& st);
+
+         /// start a new segment at point i
+      void newSegment(unsigned long i);
+
+         /// compute the WL window test at point k
+      void testWL(unsigned long k);
+
+         /// decide on a small WL slip at point c, and estimate WL slips
+      void decideWL(unsigned long c);
+
+         /// test for GF outlier and small GF slip at point g
+      void testGF(unsigned long g);
+
+         /// GF slip test of DiscCorr at point g, given the two panes
+      bool isGFslip(unsigned long g, const Stats<double>& pastSt,
+                    const Stats<double>& futureSt,
+                    const Stats<double>& pastRes,
+                    const Stats<double>& futureRes, double& mag);
+
+         /// append the Result for point e to out
+      void emit(unsigned long e, std::vector<Result>& out);
+
+         // wavelengths and linear combination coefficients, as in DiscCorr
+      double wl1, wl2, wlwl, wlgf;
+      double wl1r, wl2r, wl1p, wl2p;
+      double gf1p, gf2p;
+
+         // configuration parameters, in the units of the tests
+      double maxGap;          ///< MaxGap (s)
+      double WLobvious;       ///< WLobviousLimit*WLSigma (WL cycles)
+      double GFobvious;       ///< GFobviousLimit*GFVariation (GF cycles)
+      unsigned int WLwidth;   ///< WL pane width (points)
+      unsigned int WLedge;    ///< WLSlipEdge (points)
+      double WLsize, WLexcess, WLseparation;
+      unsigned int GFwidth;   ///< GFSlipWidth (points)
+      int GFedge;             ///< GFSlipEdge (points)
+      double GFoutlier, GFsize, GFstepToNoise, GFtoStep, GFtoNoise;
+      double rangeCheck;      ///< 2*range noise (GF cycles)
+      bool GFskipSmall;
+
+      unsigned int lag;       ///< GF test lags the newest point by this
+      unsigned int cap;       ///< buffer capacity
+
+         // state
+      std::deque<Point> buf;  ///< recent points, oldest first
+      unsigned long base;     ///< sequence number of buf.front()
+      unsigned long nadd;     ///< sequence number of the next point
+      unsigned long nextK;    ///< next point for testWL()
+      unsigned long nextC;    ///< next point for decideWL()
+      unsigned long nextG;    ///< next point for testGF()
+      unsigned long nextE;    ///< next point for emit()
+      unsigned long nseg;     ///< number of segments started
+      unsigned long curSeg;   ///< segment of the next point
+      bool haveBias;          ///< biases below have been set
+      double wlbias, gfbias, resbias;
+
+   }; // end class GDCStreamDetector
+
+   //@}
+
+} // end namespace gnsstk
+
+//------------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,148 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file GDCconfiguration.hpp
+    Configuration of the GNSSTK Discontinuity Corrector: the parameters shared
+    by the batch corrector (DiscCorr.hpp) and the streaming slip detector
+    (GDCStreamDetector.hpp). */
+
+#ifndef GNSSTK_GDCCONFIGURATION_INCLUDE
+#define GNSSTK_GDCCONFIGURATION_INCLUDE
+
+#include "gnsstk_export.h"
+
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace gnsstk
+{
+   /** @addtogroup rinexutils */
+   //@{
+
+      /**
+       class GDCconfiguration encapsulates the configuration for input to the
+       GNSSTK Discontinuity Corrector.
+      */
+   class GDCconfiguration
+   {
+   public:
+         /// constructor; this sets a full default set of parameters.
+      GDCconfiguration() { initialize(); }
+         /// destructor
+      ~GDCconfiguration()
+      {
+         CFG.clear();
+         CFGdescription.clear();
+      }
+
+         /**
+          Set a parameter in the configuration; the input string 'cmd'
+          is of the form '[--DC]\<id\>\<s\>\<value\>' where the separator s is
+          one of (:=,) and leading '-','--', or '--DC' are optional.
+          @throw Exception
+         */
+      void setParameter(std::string cmd);
+
+         /**
+          Set a parameter in the configuration using the label and the value,
+          for booleans use (T,F)=(non-zero,zero).
+          @throw Exception
+         */
+      void setParameter(const std::string& label, double value);
+
+         /// Get the parameter in the configuration corresponding to label
+      double getParameter(const std::string& label)
+      {
+         if (CFG.find(label) == CFG.end())
+         {
+            return 0.0; // TD throw?
+         }
+         return CFG[label];
+      }
+
+         /// Get the description of a parameter
+      std::string getDescription(const std::string& label)
+      {
+         if (CFGdescription.find(label) == CFGdescription.end())
+         {
+            return std::string("Invalid label");
+         }
+         return CFGdescription[label];
+      }
+
+         /// Tell GDCconfiguration to which stream to send debugging output.
+      void setDebugStream(std::ostream& os) { p_oflog = &os; }
+
+         /// Stream to which debugging output is sent.
+      std::ostream& getDebugStream() { return *p_oflog; }
+
+         /**
+          Print help page, including descriptions and current values of all
+          the parameters, to the ostream. If 'advanced' is true, also print
+          advanced parameters.
+          @throw Exception
+         */
+      void DisplayParameterUsage(std::ostream& os, bool advanced = false);
+
+         /// Return version string
+      std::string Version() { return GDCVersion; }
+
+   protected:
+         /// map containing configuration labels and their values
+      std::map<std::string, double> CFG;
+
+         /// map containing configuration labels and their descriptions
+      std::map<std::string, std::string> CFGdescription;
+
+         /// Stream on which to write debug output.
+      std::ostream *p_oflog;
+
+      void initialize();
+
+      GNSSTK_EXPORT
+      static const std::string GDCVersion;
+
+   }; // end class GDCconfiguration
+
+   //@}
+
+} // end namespace gnsstk
+
+//------------------------------------------------------------------------------------
+#endif
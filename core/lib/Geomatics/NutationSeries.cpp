@@ -0,0 +1,554 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file NutationSeries.cpp
+    Implement class NutationSeries, compiled evaluation of the IERS nutation
+    and CIP X,Y series. */
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+// GNSSTk
+#include "NutationSeries.hpp"
+#include "EarthOrientation.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gnsstk
+{
+      // A series of terms in sin and cos of integer combinations of the
+      // fundamental arguments, compiled into structure-of-arrays form.
+   struct NutationSeries::Series
+   {
+         /* Compile the multipliers, given as nTerms rows of nArgs integers.
+            Each argument a gets a slot range in the table of multiples, of
+            length 2*maxMult[a]+1 centered on the multiple zero; each term then
+            needs only the slots of its K nonzero multipliers. */
+      void compile(int nArgs, const vector<int>& mult);
+
+      int nArgs;               ///< number of fundamental arguments
+      int nTerms;              ///< number of terms
+      int nSlots;              ///< size of the table of multiples
+      int K;                   ///< max number of nonzero multipliers in a term
+      vector<int> maxMult;     ///< largest |multiplier| of each argument
+      vector<int> zero;        ///< slot of the multiple zero of each argument
+      vector<int> slot;        ///< term slots, K arrays of nTerms each
+
+         // nutation: the columns of the IAU 2000A table, each nTerms long
+      vector<double> ce, cet, se, sp, spt, cp;
+
+         // CIP X,Y: polynomial and the amplitudes, grouped by output.
+         // group g = (xy*2+sc)*NPOW+p; amplitudes grpBeg[g] to grpBeg[g+1]
+      static const int NPOW = 5;
+      vector<double> poly[2];  ///< polynomial coefficients for X and Y
+      vector<int> grpBeg;      ///< start of each group in ampTerm/ampVal
+      vector<int> ampTerm;     ///< term of each amplitude
+      vector<double> ampVal;   ///< value of each amplitude
+   };
+
+   //---------------------------------------------------------------------------------
+   void NutationSeries::Series::compile(int nA, const vector<int>& mult)
+   {
+      nArgs = nA;
+      nTerms = int(mult.size()) / nArgs;
+      maxMult = vector<int>(nArgs, 0);
+      K = 1;
+      for (int t = 0; t < nTerms; t++)
+      {
+         int nz(0);
+         for (int a = 0; a < nArgs; a++)
+         {
+            int m(mult[t * nArgs + a]);
+            if (m == 0)
+            {
+               continue;
+            }
+            nz++;
+            if (abs(m) > maxMult[a])
+            {
+               maxMult[a] = abs(m);
+            }
+         }
+         if (nz > K)
+         {
+            K = nz;
+         }
+      }
+
+      zero = vector<int>(nArgs);
+      nSlots = 0;
+      for (int a = 0; a < nArgs; a++)
+      {
+         zero[a] = nSlots + maxMult[a];
+         nSlots += 2 * maxMult[a] + 1;
+      }
+
+         // unused slots point to the multiple zero, cos=1 sin=0
+      slot = vector<int>(K * nTerms, zero[0]);
+      for (int t = 0; t < nTerms; t++)
+      {
+         int k(0);
+         for (int a = 0; a < nArgs; a++)
+         {
+            int m(mult[t * nArgs + a]);
+            if (m != 0)
+            {
+               slot[(k++) * nTerms + t] = zero[a] + m;
+            }
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Sum of products, in four independent lanes.
+   static double dotProduct(const double *a, const double *b, int n)
+   {
+      double s0(0.0), s1(0.0), s2(0.0), s3(0.0);
+      int i(0);
+      for (; i + 3 < n; i += 4)
+      {
+         s0 += a[i] * b[i];
+         s1 += a[i + 1] * b[i + 1];
+         s2 += a[i + 2] * b[i + 2];
+         s3 += a[i + 3] * b[i + 3];
+      }
+      for (; i < n; i++)
+      {
+         s0 += a[i] * b[i];
+      }
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   //---------------------------------------------------------------------------------
+   // Sum of amplitudes times gathered values, in four independent lanes.
+   static double gatherProduct(const double *amp, const int *ind,
+                               const double *v, int n)
+   {
+      double s0(0.0), s1(0.0), s2(0.0), s3(0.0);
+      int i(0);
+      for (; i + 3 < n; i += 4)
+      {
+         s0 += amp[i] * v[ind[i]];
+         s1 += amp[i + 1] * v[ind[i + 1]];
+         s2 += amp[i + 2] * v[ind[i + 2]];
+         s3 += amp[i + 3] * v[ind[i + 3]];
+      }
+      for (; i < n; i++)
+      {
+         s0 += amp[i] * v[ind[i]];
+      }
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   //---------------------------------------------------------------------------------
+   const NutationSeries::Series& NutationSeries::nutationSeries()
+   {
+         // compiled once; initialization of a local static is thread safe
+      static const Series ser = []() {
+// include huge static arrays of coefficients
+#include "IERS2003NutationData.hpp"
+
+            // arguments 0-4 lunar-solar l,lp,F,D,Om;
+            // 5-17 planetary l,F,D,Om,Me,Ve,Ea,Ma,Ju,Sa,Ur,Ne,pa
+         const int NARG(18);
+         Series s;
+         vector<int> mult((NLS + NP) * NARG, 0);
+         for (int i = 0; i < NLS; i++)
+         {
+            int *m(&mult[i * NARG]);
+            m[0] = LSCoeff[i].nl;
+            m[1] = LSCoeff[i].nlp;
+            m[2] = LSCoeff[i].nf;
+            m[3] = LSCoeff[i].nd;
+            m[4] = LSCoeff[i].nom;
+            s.ce.push_back(LSCoeff[i].ce);
+            s.cet.push_back(LSCoeff[i].cet);
+            s.se.push_back(LSCoeff[i].se);
+            s.sp.push_back(LSCoeff[i].sp);
+            s.spt.push_back(LSCoeff[i].spt);
+            s.cp.push_back(LSCoeff[i].cp);
+         }
+         for (int i = 0; i < NP; i++)
+         {
+            int *m(&mult[(NLS + i) * NARG]);
+            m[5] = PCoeff[i].nl;
+            m[6] = PCoeff[i].nf;
+            m[7] = PCoeff[i].nd;
+            m[8] = PCoeff[i].nom;
+            m[9] = PCoeff[i].nme;
+            m[10] = PCoeff[i].nve;
+            m[11] = PCoeff[i].nea;
+            m[12] = PCoeff[i].nma;
+            m[13] = PCoeff[i].nju;
+            m[14] = PCoeff[i].nsa;
+            m[15] = PCoeff[i].nur;
+            m[16] = PCoeff[i].nne;
+            m[17] = PCoeff[i].npa;
+            s.ce.push_back(PCoeff[i].ce);
+            s.cet.push_back(0.0);
+            s.se.push_back(PCoeff[i].se);
+            s.sp.push_back(PCoeff[i].sp);
+            s.spt.push_back(0.0);
+            s.cp.push_back(PCoeff[i].cp);
+         }
+         s.compile(NARG, mult);
+         return s;
+      }();
+      return ser;
+   }
+
+   //---------------------------------------------------------------------------------
+   const NutationSeries::Series& NutationSeries::cioSeries()
+   {
+      static const Series ser = []() {
+// include data arrays : defines MAXPT
+#include "IERS2010CIOSeriesData.hpp"
+
+            // arguments L,Lp,F,D,Om,Me,Ve,Ea,Ma,Ju,Sa,Ur,Ne,pa; the
+            // lunar-solar frequencies come first, then the planetary
+         const int NARG(14);
+         Series s;
+         vector<int> mult((NFALS + NFAP) * NARG, 0);
+         for (int i = 0; i < NFALS; i++)
+         {
+            for (int a = 0; a < 5; a++)
+            {
+               mult[i * NARG + a] = nFAlunarsolar[i][a];
+            }
+         }
+         for (int i = 0; i < NFAP; i++)
+         {
+            for (int a = 0; a < NARG; a++)
+            {
+               mult[(NFALS + i) * NARG + a] = nFAplanetary[i][a];
+            }
+         }
+         s.compile(NARG, mult);
+
+         for (int xy = 0; xy < 2; xy++)
+         {
+            s.poly[xy].assign(XYcoeff[xy], XYcoeff[xy] + MAXPT + 1);
+         }
+
+            // amplitudes iamp[f] to iamp[f+1]-1 (1-based) belong to term f;
+            // amplitude j within a term uses jaxy[j], jasc[j] and japt[j]
+         const int NGRP(4 * Series::NPOW);
+         vector<vector<int> > gterm(NGRP);
+         vector<vector<double> > gval(NGRP);
+         for (int f = 0; f < NFALS + NFAP; f++)
+         {
+            int ilast(f + 1 < NFALS + NFAP ? iamp[f + 1] - 1 : NAmp);
+            for (int i = iamp[f]; i <= ilast; i++)
+            {
+               int j(i - iamp[f]);
+               int g((jaxy[j] * 2 + jasc[j]) * Series::NPOW + japt[j]);
+               gterm[g].push_back(f);
+               gval[g].push_back(amp[i - 1]);
+            }
+         }
+         s.grpBeg.push_back(0);
+         for (int g = 0; g < NGRP; g++)
+         {
+            s.ampTerm.insert(s.ampTerm.end(), gterm[g].begin(), gterm[g].end());
+            s.ampVal.insert(s.ampVal.end(), gval[g].begin(), gval[g].end());
+            s.grpBeg.push_back(int(s.ampTerm.size()));
+         }
+         return s;
+      }();
+      return ser;
+   }
+
+   //---------------------------------------------------------------------------------
+   NutationSeries::NutationSeries()
+         : nutT(numeric_limits<double>::quiet_NaN()), nutDeps(0.0), nutDpsi(0.0),
+           cioT(numeric_limits<double>::quiet_NaN()), cioX(0.0), cioY(0.0)
+   {
+      const Series& nut(nutationSeries());
+      const Series& cio(cioSeries());
+      size_t n(std::max(nut.nSlots, cio.nSlots));
+      argCos.resize(n);
+      argSin.resize(n);
+      n = std::max(nut.nTerms, cio.nTerms);
+      termCos.resize(n);
+      termSin.resize(n);
+   }
+
+   //---------------------------------------------------------------------------------
+   void NutationSeries::evaluateTerms(const Series& ser, const double *args)
+   {
+         // multiples of each argument, by rotation; negative ones are conjugate
+      for (int a = 0; a < ser.nArgs; a++)
+      {
+         double *c(&argCos[ser.zero[a]]), *s(&argSin[ser.zero[a]]);
+         double c1(::cos(args[a])), s1(::sin(args[a]));
+         c[0] = 1.0;
+         s[0] = 0.0;
+         for (int m = 1; m <= ser.maxMult[a]; m++)
+         {
+            c[m] = c[m - 1] * c1 - s[m - 1] * s1;
+            s[m] = s[m - 1] * c1 + c[m - 1] * s1;
+            c[-m] = c[m];
+            s[-m] = -s[m];
+         }
+      }
+
+         // each term is the product of its multiples
+      const int N(ser.nTerms);
+      const int *sl(&ser.slot[0]);
+      double *tc(&termCos[0]), *ts(&termSin[0]);
+      const double *ac(&argCos[0]), *as(&argSin[0]);
+      for (int t = 0; t < N; t++)
+      {
+         tc[t] = ac[sl[t]];
+         ts[t] = as[sl[t]];
+      }
+      for (int k = 1; k < ser.K; k++)
+      {
+         sl = &ser.slot[k * N];
+         for (int t = 0; t < N; t++)
+         {
+            double c(ac[sl[t]]), s(as[sl[t]]);
+            double tmp(tc[t] * c - ts[t] * s);
+            ts[t] = ts[t] * c + tc[t] * s;
+            tc[t] = tmp;
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void NutationSeries::nutationAngles2003(double T, double& deps, double& dpsi)
+   {
+      if (T == nutT)
+      {
+         deps = nutDeps;
+         dpsi = nutDpsi;
+         return;
+      }
+
+         // sin and cos coefficients have units 0.1 microarcsec = 1e-7as
+      const double COEFF_TO_RAD(EarthOrientation::ARCSEC_TO_RAD * 1.0e-7);
+      const double AS2R(EarthOrientation::ARCSEC_TO_RAD);
+      const double ASPC(EarthOrientation::ARCSEC_PER_CIRCLE);
+      const double TWOPI(EarthOrientation::TWOPI);
+
+      double args[18];
+         // Lunar-Solar fundamental arguments, in radians
+         // mean anomaly of the moon
+      args[0] = EarthOrientation::L(T);
+         // mean anomaly of the sun MHB2000 value
+      args[1] = ::fmod(1287104.79305 +
+                          T * (129596581.0481 +
+                               T * (-0.5532 + T * (0.000136 + T * (-0.00001149)))),
+                       ASPC) * AS2R;
+         // mean longitude of moon minus Omega MHB2000
+      args[2] = ::fmod(335779.526232 +
+                          T * (1739527262.8478 +
+                               T * (-12.7512 + T * (-0.001037 + T * (0.00000417)))),
+                       ASPC) * AS2R;
+         // mean elongation moon from sun MHB2000
+      args[3] = ::fmod(1072260.70369 +
+                          T * (1602961601.2090 +
+                               T * (-6.3706 + T * (0.006593 + T * (-0.00003169)))),
+                       ASPC) * AS2R;
+         // mean longitude of lunar ascending node
+      args[4] = EarthOrientation::Omega2003(T);
+
+         // Planetary fundamental arguments, in radians; MHB2000 values for the
+         // moon, as in SOFA
+      args[5] = ::fmod(2.35555598 + 8328.6914269554 * T, TWOPI);
+      args[6] = ::fmod(1.627905234 + 8433.466158131 * T, TWOPI);
+      args[7] = ::fmod(5.198466741 + 7771.3771468121 * T, TWOPI);
+      args[8] = ::fmod(2.18243920 - 33.757045 * T, TWOPI);
+      args[9] = EarthOrientation::LMe(T);
+      args[10] = EarthOrientation::LV(T);
+      args[11] = EarthOrientation::LE(T);
+      args[12] = EarthOrientation::LMa(T);
+      args[13] = EarthOrientation::LJ(T);
+      args[14] = EarthOrientation::LS(T);
+      args[15] = EarthOrientation::LU(T);
+      args[16] = ::fmod(5.321159000 + 3.8127774000 * T, TWOPI);
+      args[17] = EarthOrientation::Pa(T);
+
+      const Series& ser(nutationSeries());
+      evaluateTerms(ser, args);
+
+      const int N(ser.nTerms);
+      const double *tc(&termCos[0]), *ts(&termSin[0]);
+      deps = dotProduct(&ser.ce[0], tc, N) + T * dotProduct(&ser.cet[0], tc, N) +
+             dotProduct(&ser.se[0], ts, N);
+      dpsi = dotProduct(&ser.sp[0], ts, N) + T * dotProduct(&ser.spt[0], ts, N) +
+             dotProduct(&ser.cp[0], tc, N);
+
+         // convert 0.1microarcsec to radians
+      deps *= COEFF_TO_RAD;
+      dpsi *= COEFF_TO_RAD;
+
+      nutT = T;
+      nutDeps = deps;
+      nutDpsi = dpsi;
+   }
+
+   //---------------------------------------------------------------------------------
+   void NutationSeries::nutationAngles2010(double T, double& deps, double& dpsi)
+   {
+      nutationAngles2003(T, deps, dpsi);
+      double fj2(-2.7774e-6 * T);
+      dpsi *= (1.0 + 0.4697e-6 + fj2);
+      deps *= (1.0 + fj2);
+   }
+
+   //---------------------------------------------------------------------------------
+   void NutationSeries::XYCIO(double T, double& X, double& Y)
+   {
+      if (T == cioT)
+      {
+         X = cioX;
+         Y = cioY;
+         return;
+      }
+
+      const Series& ser(cioSeries());
+      double args[14];
+      args[0] = EarthOrientation::L(T);         // mean anomaly of the moon
+      args[1] = EarthOrientation::Lp(T);        // mean anomaly of the sun
+      args[2] = EarthOrientation::F(T);         // mean longitude of moon - Omega
+      args[3] = EarthOrientation::D(T);         // mean elongation moon from sun
+      args[4] = EarthOrientation::Omega2003(T); // mean longitude of lunar node
+      args[5] = EarthOrientation::LMe(T);       // mean longitude Mercury
+      args[6] = EarthOrientation::LV(T);        // mean longitude of Venus
+      args[7] = EarthOrientation::LE(T);        // mean longitude of Earth
+      args[8] = EarthOrientation::LMa(T);       // mean longitude Mars
+      args[9] = EarthOrientation::LJ(T);        // mean longitude Jupiter
+      args[10] = EarthOrientation::LS(T);       // mean longitude Saturn
+      args[11] = EarthOrientation::LU(T);       // mean longitude Uranus
+      args[12] = EarthOrientation::LN(T);       // mean longitude Neptune
+      args[13] = EarthOrientation::Pa(T);       // general precession in longitude
+      evaluateTerms(ser, args);
+
+         // powers of T
+      double powsT[Series::NPOW];
+      powsT[0] = 1.0;
+      for (int p = 1; p < Series::NPOW; p++)
+      {
+         powsT[p] = powsT[p - 1] * T;
+      }
+
+         // series, in microarcseconds
+      double xy[2] = {0.0, 0.0};
+      for (int xy01 = 0; xy01 < 2; xy01++)
+      {
+         for (int sc = 0; sc < 2; sc++)
+         {
+            const double *v(sc == 0 ? &termSin[0] : &termCos[0]);
+            for (int p = 0; p < Series::NPOW; p++)
+            {
+               int g((xy01 * 2 + sc) * Series::NPOW + p);
+               int n(ser.grpBeg[g + 1] - ser.grpBeg[g]);
+               if (n == 0)
+               {
+                  continue;
+               }
+               xy[xy01] += powsT[p] * gatherProduct(&ser.ampVal[ser.grpBeg[g]],
+                                                    &ser.ampTerm[ser.grpBeg[g]],
+                                                    v, n);
+            }
+         }
+      }
+
+         // polynomial, in arcseconds
+      double xypoly[2] = {0.0, 0.0};
+      for (int i = 0; i < 2; i++)
+      {
+         for (int j = int(ser.poly[i].size()) - 1; j >= 0; j--)
+         {
+            xypoly[i] = xypoly[i] * T + ser.poly[i][j];
+         }
+      }
+
+      X = (xypoly[0] + xy[0] * 1.e-6) * EarthOrientation::ARCSEC_TO_RAD;
+      Y = (xypoly[1] + xy[1] * 1.e-6) * EarthOrientation::ARCSEC_TO_RAD;
+
+      cioT = T;
+      cioX = X;
+      cioY = Y;
+   }
+
+   //---------------------------------------------------------------------------------
+   void NutationSeries::nutationAngles2003(const vector<double>& T,
+                                           vector<double>& deps,
+                                           vector<double>& dpsi)
+   {
+      deps.resize(T.size());
+      dpsi.resize(T.size());
+      for (size_t i = 0; i < T.size(); i++)
+      {
+         nutationAngles2003(T[i], deps[i], dpsi[i]);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void NutationSeries::nutationAngles2010(const vector<double>& T,
+                                           vector<double>& deps,
+                                           vector<double>& dpsi)
+   {
+      deps.resize(T.size());
+      dpsi.resize(T.size());
+      for (size_t i = 0; i < T.size(); i++)
+      {
+         nutationAngles2010(T[i], deps[i], dpsi[i]);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void NutationSeries::XYCIO(const vector<double>& T, vector<double>& X,
+                              vector<double>& Y)
+   {
+      X.resize(T.size());
+      Y.resize(T.size());
+      for (size_t i = 0; i < T.size(); i++)
+      {
+         XYCIO(T[i], X[i], Y[i]);
+      }
+   }
+
+} // end namespace gnsstk
@@ -0,0 +1,170 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file NutationSeries.hpp
+    Include file defining the NutationSeries class, a compiled evaluator for
+    the IERS2003 nutation series and the IERS2010 CIP X,Y series. */
+
+#ifndef CLASS_NUTATIONSERIES_INCLUDE
+#define CLASS_NUTATIONSERIES_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <vector>
+
+//------------------------------------------------------------------------------------
+namespace gnsstk
+{
+
+      /**
+       class NutationSeries evaluates the large series of the IERS
+       Conventions, the IAU 2000A nutation (IERS2003NutationData.hpp, used
+       by EarthOrientation::nutationAngles2003() and 2010) and the X,Y
+       coordinates of the CIP (IERS2010CIOSeriesData.hpp, used by
+       EarthOrientation::XYCIO()), much faster than term by term.
+
+       The tables are compiled once, on first use, into contiguous arrays
+       shared by all objects. At each epoch the fundamental arguments are
+       computed once, with a single sine and cosine each; the sines and cosines
+       of all their integer multiples follow by rotation, and those of each
+       term by at most six complex products, with no further trigonometric
+       calls. The term loops run over contiguous arrays without branches, so
+       that the compiler can vectorize them, and the sums are accumulated in
+       four independent lanes.
+
+       An object holds the workspace and the result for the most recent epoch,
+       which is returned directly when the same epoch is requested again. An
+       object is therefore not safe for concurrent use; use one per thread.
+       The results agree with the term-by-term evaluation to the rounding
+       error of the sums, about 1e-15 radians.
+      */
+   class NutationSeries
+   {
+   public:
+         /// Constructor; compiles the shared tables if necessary.
+      NutationSeries();
+
+         /**
+          Nutation of the obliquity (deps) and of the longitude (dpsi), IERS
+          2003 or IAU 2000A model, as EarthOrientation::nutationAngles2003().
+          @param T    the coordinate transformation time at the time of interest
+          @param deps nutation of the obliquity (output) in radians
+          @param dpsi nutation of the longitude (output) in radians
+         */
+      void nutationAngles2003(double T, double& deps, double& dpsi);
+
+         /**
+          Nutation of the obliquity (deps) and of the longitude (dpsi), IERS
+          2010, which is IAU 2000A with P03 adjustments, as
+          EarthOrientation::nutationAngles2010().
+          @param T    the coordinate transformation time at the time of interest
+          @param deps nutation of the obliquity (output) in radians
+          @param dpsi nutation of the longitude (output) in radians
+         */
+      void nutationAngles2010(double T, double& deps, double& dpsi);
+
+         /**
+          Coordinates X,Y of the CIP from the IAU 2006/2000A series (IERS
+          2010), as EarthOrientation::XYCIO().
+          @param T the coordinate transformation time at the time of interest
+          @param X x coordinate of the CIP, radians (output)
+          @param Y y coordinate of the CIP, radians (output)
+         */
+      void XYCIO(double T, double& X, double& Y);
+
+         /**
+          Evaluate nutationAngles2003() at each of the given times.
+          @param T vector of coordinate transformation times
+          @param deps nutation of the obliquity (output), resized to T.size()
+          @param dpsi nutation of the longitude (output), resized to T.size()
+         */
+      void nutationAngles2003(const std::vector<double>& T,
+                              std::vector<double>& deps,
+                              std::vector<double>& dpsi);
+
+         /**
+          Evaluate nutationAngles2010() at each of the given times.
+          @param T vector of coordinate transformation times
+          @param deps nutation of the obliquity (output), resized to T.size()
+          @param dpsi nutation of the longitude (output), resized to T.size()
+         */
+      void nutationAngles2010(const std::vector<double>& T,
+                              std::vector<double>& deps,
+                              std::vector<double>& dpsi);
+
+         /**
+          Evaluate XYCIO() at each of the given times.
+          @param T vector of coordinate transformation times
+          @param X x coordinates of the CIP (output), resized to T.size()
+          @param Y y coordinates of the CIP (output), resized to T.size()
+         */
+      void XYCIO(const std::vector<double>& T, std::vector<double>& X,
+                 std::vector<double>& Y);
+
+   private:
+         /// A compiled series, defined in the implementation.
+      struct Series;
+
+         /// The compiled IAU 2000A nutation series.
+      static const Series& nutationSeries();
+
+         /// The compiled IERS2010 X,Y series.
+      static const Series& cioSeries();
+
+         /**
+          Compute the sines and cosines of all the terms of a series, given the
+          values of its fundamental arguments.
+         */
+      void evaluateTerms(const Series& ser, const double *args);
+
+      std::vector<double> argCos, argSin;   ///< multiples of the arguments
+      std::vector<double> termCos, termSin; ///< cos and sin of each term
+
+      double nutT;    ///< time of the cached nutation, or NaN
+      double nutDeps; ///< cached nutation of the obliquity (IERS2003)
+      double nutDpsi; ///< cached nutation of the longitude (IERS2003)
+      double cioT;    ///< time of the cached X,Y, or NaN
+      double cioX;    ///< cached X
+      double cioY;    ///< cached Y
+
+   }; // end class NutationSeries
+
+} // end namespace gnsstk
+
+#endif // CLASS_NUTATIONSERIES_INCLUDE
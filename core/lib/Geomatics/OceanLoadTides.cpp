@@ -417,17 +417,45 @@ namespace gnsstk
    {
       try
       {
-         ostringstream oss; // TEMP
+         Harmonics harm;
+         getHarmonics(site, time, harm);
+         return computeDisplacement(harm, time);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+
+   } // end Triple OceanLoadTides::computeDisplacement
+
+   //---------------------------------------------------------------------------------
+   void OceanLoadTides::getHarmonics(const string& site, const EphTime& time,
+                                     Harmonics& harm) const
+   {
+      try
+      {
          int i;
 
-         if (!isValid(site))
+         map<string, vector<double>>::const_iterator it;
+         it = coefficientMap.find(site);
+         if (it == coefficientMap.end())
          {
             Exception e("Site " + site + " has not been initialized.");
             GNSSTK_THROW(e);
          }
 
             // get the coefficients for this site
-         vector<double> coeff = coefficientMap[site];
+         const vector<double>& coeff(it->second);
 
             // Cartwright-Tayler numbers of Scherneck tides
             // ordering is: M2, S2, N2, K2, K1, O1, P1, Q1, Mf, Mm, Ssa
@@ -454,64 +482,13 @@ namespace gnsstk
             GNSSTK_THROW(e);
          }
 
-            // compute time argument
-         EphTime ttag(time);
-         ttag.convertSystemTo(TimeSystem::UTC);
-         double dayfr(ttag.secOfDay() / 86400.0);
-         ttag.convertSystemTo(TimeSystem::TT);
-            // T = EarthOrientation::CoordTransTime()
-         double T((ttag.dMJD() - 51544.5) / 36525.0);
-
-            // get the Delauney arguments and frequencies at t
-         double Del[5], freqDel[5]; // degrees and cycles/day
-         Del[0] =
-            134.9634025100 + // EarthOrientation::L()
-            T * (477198.8675605000 +
-                 T * (0.0088553333 + T * (0.0000143431 + T * (-0.0000000680))));
-         Del[1] =
-            357.5291091806 + // EarthOrientation::Lp()
-            T *
-               (35999.0502911389 +
-                T * (-0.0001536667 + T * (0.0000000378 + T * (-0.0000000032))));
-         Del[2] =
-            93.2720906200 + // EarthOrientation::F()
-            T *
-               (483202.0174577222 +
-                T * (-0.0035420000 + T * (-0.0000002881 + T * (0.0000000012))));
-         Del[3] =
-            297.8501954694 + // EarthOrientation::D()
-            T *
-               (445267.1114469445 +
-                T * (-0.0017696111 + T * (0.0000018314 + T * (-0.0000000088))));
-         Del[4] =
-            125.0445550100 + // EarthOrientation::Omega2003()
-            T * (-1934.1362619722 +
-                 T * (0.0020756111 + T * (0.0000021394 + T * (-0.0000000165))));
-         for (i = 0; i < 5; i++)
-            Del[i] = ::fmod(Del[i], 360.0);
-         freqDel[0] = 0.0362916471 + 0.0000000013 * T;
-         freqDel[1] = 0.0027377786;
-         freqDel[2] = 0.0367481951 - 0.0000000005 * T;
-         freqDel[3] = 0.0338631920 - 0.0000000003 * T;
-         freqDel[4] = -0.0001470938 + 0.0000000003 * T;
-
-            // convert to Doodson (Darwin) variables
+            /* the frequencies at t determine the amplitudes and phases; with
+               the Doodson arguments set to zero deriveTides() returns only the
+               phase offset of each derived tide */
          double Dood[6], freqDood[6];
-         Dood[0] = 360.0 * dayfr - Del[3];
-         Dood[1] = Del[2] + Del[4];
-         Dood[2] = Dood[1] - Del[3];
-         Dood[3] = Dood[1] - Del[0];
-         Dood[4] = -Del[4];
-         Dood[5] = Dood[2] - Del[1];
+         DoodsonArguments(time, Dood, freqDood);
          for (i = 0; i < 6; i++)
-            Dood[i] = ::fmod(Dood[i], 360.0);
-
-         freqDood[0] = 1.0 - freqDel[3];
-         freqDood[1] = freqDel[2] + freqDel[4];
-         freqDood[2] = freqDood[1] - freqDel[3];
-         freqDood[3] = freqDood[1] - freqDel[0];
-         freqDood[4] = -freqDel[4];
-         freqDood[5] = freqDood[2] - freqDel[1];
+            Dood[i] = 0.0;
 
             // find amplitudes and phases for vertical, west and south components,
             // for all 342 derived tides, from standard tides
@@ -521,6 +498,7 @@ namespace gnsstk
          double phsS[NDER], phsW[NDER],
             phsU[NDER];     // south,west,up component phs.s
          double freq[NDER]; // frequencies (same for S,W,U)
+         NVector nDer[NDER]; // Doodson numbers (same for S,W,U)
 
             // vertical
          int nder; // number returned, may be < NDER
@@ -529,33 +507,8 @@ namespace gnsstk
             amp[i] = coeff[i];
             phs[i] = -coeff[33 + i];
          }
-            // oss.str(""); oss << fixed << setprecision(5) << "TEST Amp  1 ";
-            // for(i=0; i<NSTD; i++) oss << " " << setw(8) << amp[i];
-            // LOG(INFO) << oss.str();
-            // oss.str(""); oss << fixed << setprecision(1) << "TEST Phs  1 ";
-            // for(i=0; i<NSTD; i++) oss << " " << setw(8) << phs[i];
-            // LOG(INFO) << oss.str();
-            // LOG(INFO) << "TEST T,DAYFR,DELTA" << fixed << setprecision(15)
-            //   << setw(25) << T << setw(25) << dayfr << setw(25) <<
-            //   ttag.secOfDay();
-            // LOG(INFO) << "TEST Delauneys " << fixed << setprecision(15)
-            //   << setw(22) << Del[0] << setw(22) << Del[1] << setw(22) << Del[2]
-            //   << setw(22) << Del[3] << setw(22) << Del[4];
-            // LOG(INFO) << "TEST Del freqs " << fixed << setprecision(15)
-            //   << setw(22) << freqDel[0] << setw(22) << freqDel[1] << setw(22)
-            //   << freqDel[2] << setw(22) << freqDel[3] << setw(22) << freqDel[4];
-            // LOG(INFO) << "TEST Doods     " << fixed << setprecision(15)
-            //   << setw(22) << Dood[0] << setw(22) << Dood[1] << setw(22)
-            //   << Dood[2] << setw(22) << Dood[3] << setw(22) << Dood[4]
-            //   << setw(22) << Dood[5];
-            // LOG(INFO) << "TEST Dood freqs" << fixed << setprecision(15)
-            //   << setw(22) << freqDood[0] << setw(22) << freqDood[1] << setw(22)
-            //   << freqDood[2] << setw(22) << freqDood[3] << setw(22) <<
-            //   freqDood[4]
-            //   << setw(22) << freqDood[5];
          nder = deriveTides(SchInd, amp, phs, Dood, freqDood, ampU, phsU, freq,
-                            NSTD);
-            // LOG(INFO) << "Vertical returned " << nder << " derived tides";
+                            NSTD, nDer);
 
             // west
          for (i = 0; i < NSTD; i++)
@@ -563,15 +516,8 @@ namespace gnsstk
             amp[i] = coeff[11 + i];
             phs[i] = -coeff[44 + i];
          }
-            // oss.str(""); oss << fixed << setprecision(5) << "TEST Amp  2 ";
-            // for(i=0; i<NSTD; i++) oss << " " << setw(8) << amp[i];
-            // LOG(INFO) << oss.str();
-            // oss.str(""); oss << fixed << setprecision(1) << "TEST Phs  2 ";
-            // for(i=0; i<NSTD; i++) oss << " " << setw(8) << phs[i];
-            // LOG(INFO) << oss.str();
          nder = deriveTides(SchInd, amp, phs, Dood, freqDood, ampW, phsW, freq,
                             NSTD);
-            // LOG(INFO) << "West returned " << nder << " derived tides";
 
             // south
          for (i = 0; i < NSTD; i++)
@@ -579,87 +525,138 @@ namespace gnsstk
             amp[i] = coeff[22 + i];
             phs[i] = -coeff[55 + i];
          }
-            // oss.str(""); oss << fixed << setprecision(5) << "TEST Amp  3 ";
-            // for(i=0; i<NSTD; i++) oss << " " << setw(8) << amp[i];
-            // LOG(INFO) << oss.str();
-            // oss.str(""); oss << fixed << setprecision(1) << "TEST Phs  3 ";
-            // for(i=0; i<NSTD; i++) oss << " " << setw(8) << phs[i];
-            // LOG(INFO) << oss.str();
          nder = deriveTides(SchInd, amp, phs, Dood, freqDood, ampS, phsS, freq,
                             NSTD);
-            // LOG(INFO) << "TEST First 40 South amp, phase";
-            // for(i=0; i<40; i++) LOG(INFO) << "TEST " << setw(2) << i+1 << fixed
-            //   << setprecision(15) << setw(22) << ampS[i] << setw(22) << phsS[i];
-
-            // sum up
-         Triple dc(0.0, 0.0, 0.0); // U S W
-         for (i = 0; i < nder; i++)
-         {
-            dc[0] += ampU[i] * ::cos(phsU[i] * DEG_TO_RAD);
-               // LOG(INFO)<<"TEST LOOP U " << setw(3) << i+1 << fixed <<
-               // setprecision(15)
-               //  << setw(22) << ampU[i]*::cos(phsU[i]*DEG_TO_RAD) << setw(22) <<
-               //  dc[0];
-         }
-            // LOG(INFO) << "TEST RECURS result U    " << fixed << setprecision(15)
-            //      << setw(22) << dc[0];
 
+            // save the tides
+         harm.n.resize(6 * nder);
+         harm.cosU.resize(nder);
+         harm.sinU.resize(nder);
+         harm.cosS.resize(nder);
+         harm.sinS.resize(nder);
+         harm.cosW.resize(nder);
+         harm.sinW.resize(nder);
          for (i = 0; i < nder; i++)
          {
-            dc[1] += ampS[i] * ::cos(phsS[i] * DEG_TO_RAD);
-               // LOG(INFO)<<"TEST LOOP S " << setw(3) << i+1 << fixed <<
-               // setprecision(15)
-               //  << setw(22) << ampS[i]*::cos(phsS[i]*DEG_TO_RAD) << setw(22) <<
-               //  dc[1];
+            for (int k = 0; k < 6; k++)
+               harm.n[6 * i + k] = nDer[i].n[k];
+            harm.cosU[i] = ampU[i] * ::cos(phsU[i] * DEG_TO_RAD);
+            harm.sinU[i] = ampU[i] * ::sin(phsU[i] * DEG_TO_RAD);
+            harm.cosS[i] = ampS[i] * ::cos(phsS[i] * DEG_TO_RAD);
+            harm.sinS[i] = ampS[i] * ::sin(phsS[i] * DEG_TO_RAD);
+            harm.cosW[i] = ampW[i] * ::cos(phsW[i] * DEG_TO_RAD);
+            harm.sinW[i] = ampW[i] * ::sin(phsW[i] * DEG_TO_RAD);
          }
-            // LOG(INFO) << "TEST RECURS result S    " << fixed << setprecision(15)
-            //      << setw(22) << dc[1];
-
-         for (i = 0; i < nder; i++)
-         {
-            dc[2] += ampW[i] * ::cos(phsW[i] * DEG_TO_RAD);
-               // LOG(INFO)<<"TEST LOOP W " << setw(3) << i+1 << fixed <<
-               // setprecision(15)
-               //  << setw(22) << ampW[i]*::cos(phsW[i]*DEG_TO_RAD) << setw(22) <<
-               //  dc[2];
-         }
-            // LOG(INFO) << "TEST RECURS result W    " << fixed << setprecision(15)
-            //      << setw(22) << dc[2];
-
-            // LOG(INFO) << "TEST      " << fixed << setprecision(6)
-            //   << " " << dc[0] << "     " << dc[1] << "     " << dc[2];
-
-            // convert vertical,south,west to north,east,up
-         double temp = dc[0];
-         dc[0]       = -dc[1]; // N = -S
-         dc[1]       = -dc[2]; // E = -W
-         dc[2]       = temp;   // U = U
-
-         return dc;
       }
       catch (Exception& e)
       {
          GNSSTK_RETHROW(e);
       }
-      catch (exception& e)
-      {
-         Exception E("std except: " + string(e.what()));
-         GNSSTK_THROW(E);
-      }
-      catch (...)
+
+   } // end void OceanLoadTides::getHarmonics
+
+   //---------------------------------------------------------------------------------
+   Triple OceanLoadTides::computeDisplacement(const Harmonics& harm,
+                                              const EphTime& time)
+   {
+      double Dood[6], freqDood[6];
+      DoodsonArguments(time, Dood, freqDood);
+
+         // sum up; cos(arg+phs) = cos(arg)cos(phs) - sin(arg)sin(phs)
+      Triple dc(0.0, 0.0, 0.0); // U S W
+      const int nder(harm.cosU.size());
+      const int *n = (nder > 0 ? &harm.n[0] : NULL);
+      for (int i = 0; i < nder; i++, n += 6)
       {
-         Exception e("Unknown exception");
-         GNSSTK_THROW(e);
+         double arg = (n[0] * Dood[0] + n[1] * Dood[1] + n[2] * Dood[2] +
+                       n[3] * Dood[3] + n[4] * Dood[4] + n[5] * Dood[5]) *
+                      DEG_TO_RAD;
+         double carg(::cos(arg)), sarg(::sin(arg));
+         dc[0] += harm.cosU[i] * carg - harm.sinU[i] * sarg;
+         dc[1] += harm.cosS[i] * carg - harm.sinS[i] * sarg;
+         dc[2] += harm.cosW[i] * carg - harm.sinW[i] * sarg;
       }
 
-   } // end Triple OceanLoadTides::computeDisplacement
+         // convert vertical,south,west to north,east,up
+      double temp = dc[0];
+      dc[0]       = -dc[1]; // N = -S
+      dc[1]       = -dc[2]; // E = -W
+      dc[2]       = temp;   // U = U
+
+      return dc;
+   }
+
+   //---------------------------------------------------------------------------------
+   void OceanLoadTides::DoodsonArguments(const EphTime& time, double Dood[],
+                                         double freqDood[])
+   {
+      int i;
+
+         // compute time argument
+      EphTime ttag(time);
+      ttag.convertSystemTo(TimeSystem::UTC);
+      double dayfr(ttag.secOfDay() / 86400.0);
+      ttag.convertSystemTo(TimeSystem::TT);
+         // T = EarthOrientation::CoordTransTime()
+      double T((ttag.dMJD() - 51544.5) / 36525.0);
+
+         // get the Delauney arguments and frequencies at t
+      double Del[5], freqDel[5]; // degrees and cycles/day
+      Del[0] =
+         134.9634025100 + // EarthOrientation::L()
+         T * (477198.8675605000 +
+              T * (0.0088553333 + T * (0.0000143431 + T * (-0.0000000680))));
+      Del[1] =
+         357.5291091806 + // EarthOrientation::Lp()
+         T *
+            (35999.0502911389 +
+             T * (-0.0001536667 + T * (0.0000000378 + T * (-0.0000000032))));
+      Del[2] =
+         93.2720906200 + // EarthOrientation::F()
+         T *
+            (483202.0174577222 +
+             T * (-0.0035420000 + T * (-0.0000002881 + T * (0.0000000012))));
+      Del[3] =
+         297.8501954694 + // EarthOrientation::D()
+         T *
+            (445267.1114469445 +
+             T * (-0.0017696111 + T * (0.0000018314 + T * (-0.0000000088))));
+      Del[4] =
+         125.0445550100 + // EarthOrientation::Omega2003()
+         T * (-1934.1362619722 +
+              T * (0.0020756111 + T * (0.0000021394 + T * (-0.0000000165))));
+      for (i = 0; i < 5; i++)
+         Del[i] = ::fmod(Del[i], 360.0);
+      freqDel[0] = 0.0362916471 + 0.0000000013 * T;
+      freqDel[1] = 0.0027377786;
+      freqDel[2] = 0.0367481951 - 0.0000000005 * T;
+      freqDel[3] = 0.0338631920 - 0.0000000003 * T;
+      freqDel[4] = -0.0001470938 + 0.0000000003 * T;
+
+         // convert to Doodson (Darwin) variables
+      Dood[0] = 360.0 * dayfr - Del[3];
+      Dood[1] = Del[2] + Del[4];
+      Dood[2] = Dood[1] - Del[3];
+      Dood[3] = Dood[1] - Del[0];
+      Dood[4] = -Del[4];
+      Dood[5] = Dood[2] - Del[1];
+      for (i = 0; i < 6; i++)
+         Dood[i] = ::fmod(Dood[i], 360.0);
+
+      freqDood[0] = 1.0 - freqDel[3];
+      freqDood[1] = freqDel[2] + freqDel[4];
+      freqDood[2] = freqDood[1] - freqDel[3];
+      freqDood[3] = freqDood[1] - freqDel[0];
+      freqDood[4] = -freqDel[4];
+      freqDood[5] = freqDood[2] - freqDel[1];
+   }
 
    //---------------------------------------------------------------------------------
    int OceanLoadTides::deriveTides(const NVector SchInd[], const double amp[],
                                    const double phs[], const double Dood[],
                                    const double freqDood[], double ampDer[],
                                    double phsDer[], double freqDer[],
-                                   const int Nin)
+                                   const int Nin, NVector nDer[])
    {
          // indexes for std tides: M2, S2, N2, K2, K1,  O1,  P1,  Q1,  Mf,  Mm, Ssa
       static const int stdindex[] = {0,   1,   2,   3,   109, 110,
@@ -1042,6 +1039,10 @@ namespace gnsstk
          }
 
             // get phase and freq for this tide
+         if (nDer)
+         {
+            nDer[nout] = DerInd[j];
+         }
          freqDer[nout] = phsDer[nout] = 0.0;
          for (k = 0; k < 6; k++)
          {
@@ -82,6 +82,23 @@ namespace gnsstk
    class OceanLoadTides
    {
    public:
+         /**
+          The derived tides of one site, as computed by getHarmonics(). The
+          displacement (U,S,W) at time t is the sum over the tides k of
+             ampU[k]*cos(arg[k](t)+phsU[k]), etc.
+          where arg[k](t) is the Doodson argument, n[6k]...n[6k+5] dotted into
+          the Doodson variables at t; cf. computeDisplacement(Harmonics,EphTime).
+          These are stored as cosU[k] = ampU[k]*cos(phsU[k]) and
+          sinU[k] = ampU[k]*sin(phsU[k]), etc.
+         */
+      struct Harmonics
+      {
+         std::vector<int> n; ///< 6 Doodson numbers for each tide
+            /// amplitude (m) times cos and sin of the phase, for each tide,
+            /// in the vertical, south and west components
+         std::vector<double> cosU, sinU, cosS, sinS, cosW, sinW;
+      };
+
          /// Constructor
       OceanLoadTides(){};
 
@@ -145,6 +162,32 @@ namespace gnsstk
          */
       Triple computeDisplacement(std::string site, EphTime t);
 
+         /**
+          Compute the derived tides for the given site, as used by
+          computeDisplacement(). The amplitudes and phases depend on time only
+          through the tidal frequencies, which change by less than 1.e-8
+          cycles/day per century, so the result may be used with
+          computeDisplacement(Harmonics,EphTime) at any time near t.
+          @param site  string Input name of the site; must be the same as previously
+                       successfully passed to initializeSites().
+          @param t     EphTime Input reference time.
+          @param harm  Harmonics Output derived tides for the site.
+          @throw Exception if the site has not been initialized, or if there is
+                           corruption in the static arrays.
+         */
+      void getHarmonics(const std::string& site, const EphTime& t,
+                        Harmonics& harm) const;
+
+         /**
+          Compute the site displacement vector at the given time from the
+          derived tides of a site, cf. getHarmonics().
+          @param harm  Harmonics of the site, from getHarmonics().
+          @param t     EphTime Input time of interest.
+          @return Triple containing the North, East and Up components of the
+                         site displacement in meters.
+         */
+      static Triple computeDisplacement(const Harmonics& harm, const EphTime& t);
+
          /**
           Return the recorded latitude, longitude and ht(=0) for the given site.
           Return value of (0.0,0.0,0.0) probably means the position was not
@@ -193,6 +236,15 @@ namespace gnsstk
          /// Number of derived tides computed by deriveTides()
       static const int NDER;
 
+         /**
+          Compute the Doodson variables, and their frequencies, at time t.
+          @param t         time of interest
+          @param Dood      array of 6 Doodson arguments at time t in degrees
+          @param freqDood  array of 6 Doodson frequencies at time in cycles/day
+         */
+      static void DoodsonArguments(const EphTime& t, double Dood[],
+                                   double freqDood[]);
+
          /**
           Derive the 342 tides from the standard 11 tides using cubic spline
           interpolation. Called by computeDisplacements()
@@ -205,13 +257,16 @@ namespace gnsstk
           @param phsDer    array of nout (up to 342) phases of the derived tides
           @param freq      array of nout (up to 342) frequencies of the derived tides
           @param Nin       number of std tides (11)
+          @param nDer      if not NULL, array of nout NVectors output with the
+                           Doodson numbers of the derived tides
           @return nout     number of derived tides actually computed, may be < 342
           @throw Exception if static arrays are corrupted.
          */
-      int deriveTides(const NVector SchTides[], const double amp[],
-                      const double phs[], const double Dood[],
-                      const double freqDood[], double ampDer[], double phsDer[],
-                      double freq[], const int Nin);
+      static int deriveTides(const NVector SchTides[], const double amp[],
+                             const double phs[], const double Dood[],
+                             const double freqDood[], double ampDer[],
+                             double phsDer[], double freq[], const int Nin,
+                             NVector nDer[] = NULL);
 
    }; // end class OceanLoadTides
 
@@ -174,18 +174,21 @@ namespace gnsstk
 
       try
       {
-         const unsigned int n(R.rows());
-         unsigned int i, j;
-            // build a permutation matrix
-         Matrix<double> P(n, n, 0.0);
-         for (i = 0; i < n; i++)
+            // bring each name of nl, in order, into place; each move keeps R
+            // upper triangular, so a nearly identical ordering is cheap
+         vector<string> labels(names.labels);
+         for (unsigned int t = 0; t < labels.size(); t++)
          {
-            j       = nl.index(names.getName(i));
-            P(j, i) = 1;
+            unsigned int p(std::find(labels.begin() + t, labels.end(),
+                                     nl.labels[t]) - labels.begin());
+            if (p == t)
+            {
+               continue;
+            }
+            SrifMoveState(R, Z, p, t);
+            std::rotate(labels.begin() + t, labels.begin() + p,
+                        labels.begin() + p + 1);
          }
-
-            // inverse of P is transpose of P
-         retriangularize(R * transpose(P), Z);
          names = nl;
       }
       catch (MatrixException& me)
@@ -450,37 +453,32 @@ namespace gnsstk
 
             // all.sort();        // TEMP - for testing with old version
 
-            // stack the (R|Z)'s from both in one matrix;
-            // all determines the columns, plus last column is for Z
+            // the names of this SRI come first in all, so R|Z extended with
+            // zeros is still upper triangular; S.R|S.Z, with its columns
+            // placed by all, is then just whitened data for a measurement update
          unsigned int i, j, n, m, sm;
          n  = all.labels.size();
          m  = R.rows();
          sm = S.R.rows();
-         Matrix<double> A(m + sm, n + 1, 0.0);
-
-            // copy R into A, permuting columns as names differs from all
-            // loop over columns of R; do Z at the same time using j=row
-         for (j = 0; j < m; j++)
+         if (n != m)
          {
-               // find where this column of R goes in A
-               // (should never throw..)
-            int k = all.index(names.labels[j]);
-            if (k == -1)
+            Matrix<double> RR(n, n, 0.0);
+            Vector<double> ZZ(n, 0.0);
+            for (j = 0; j < m; j++)
             {
-               MatrixException me("Algorithm error 1");
-               GNSSTK_THROW(me);
+               for (i = 0; i <= j; i++)
+                  RR(i, j) = R(i, j);
+               ZZ(j) = Z(j);
             }
-
-               // copy this col of R into A (R is UT)
-            for (i = 0; i <= j; i++)
-               A(i, k) = R(i, j);
-               // also the jth element of Z
-            A(j, n) = Z(j);
+            R = RR;
+            Z = ZZ;
          }
 
-            // now do the same for S, but put S.R|S.Z below R|Z
+         Matrix<double> H(sm, n, 0.0);
+         Vector<double> D(sm);
          for (j = 0; j < sm; j++)
          {
+               // find where this column of S.R goes (should never throw..)
             int k = all.index(S.names.labels[j]);
             if (k == -1)
             {
@@ -488,18 +486,11 @@ namespace gnsstk
                GNSSTK_THROW(me);
             }
             for (i = 0; i <= j; i++)
-               A(m + i, k) = S.R(i, j);
-            A(m + j, n) = S.Z(j);
+               H(i, k) = S.R(i, j);
+            D(j) = S.Z(j);
          }
 
-            // now triangularize A and pull out the new R and Z
-            // DONT - dimensions change - retriangularize(A);
-         Householder<double> HA;
-         HA(A);
-            // submatrix args are matrix,toprow,topcol,numrows,numcols
-         R = Matrix<double>(HA.A, 0, 0, n, n);
-         Z = Vector<double>(HA.A.colCopy(n));
-         Z.resize(n);
+         SrifMUInPlace(R, Z, H, D);
          names = all;
 
          return *this;
@@ -629,11 +620,13 @@ namespace gnsstk
          GNSSTK_THROW(me);
       }
 
-      Householder<double> HA;
-      HA(A);
-         // submatrix args are matrix,toprow,topcol,numrows,numcols
-      R = Matrix<double>(HA.A, 0, 0, n, n);
-      Z = Vector<double>(HA.A.colCopy(n));
+      for (unsigned int j = 0; j < n; j++)
+      {
+         for (unsigned int i = 0; i < n; i++)
+            R(i, j) = A(i, j);
+         Z(j) = A(j, n);
+      }
+      SrifRetriangularize(R, Z);
          // NB names cannot be changed - caller must do it.
    }
 
@@ -643,7 +636,8 @@ namespace gnsstk
          @param R Matrix<double> input the modified (non-UT) R
          @param Z Vector<double> input the (potentially) modified Z
          @throw if dimensions are wrong. */
-   void SRI::retriangularize(Matrix<double> RR, Vector<double> ZZ)
+   void SRI::retriangularize(const Matrix<double>& RR,
+                             const Vector<double>& ZZ)
    {
       const unsigned int n(R.rows());
       if (RR.rows() != n || RR.cols() != n || ZZ.size() != n)
@@ -655,8 +649,15 @@ namespace gnsstk
          GNSSTK_THROW(me);
       }
 
-      Matrix<double> A(RR || ZZ);
-      retriangularize(A);
+      if (&RR != &R)
+      {
+         R = RR;
+      }
+      if (&ZZ != &Z)
+      {
+         Z = ZZ;
+      }
+      SrifRetriangularize(R, Z);
    }
 
       /* -----------------------------------------------------------------------------
@@ -680,7 +681,7 @@ namespace gnsstk
       }
 
       R = R * invT;
-      retriangularize(R, Z);
+      SrifRetriangularize(R, Z);
       names = NL;
    }
 
@@ -708,11 +709,16 @@ namespace gnsstk
          {
             return;
          }
-         double factor = 0.0;
-         if (q != 0.0)
+         if (q == 0.0)
          {
-            factor = 1.0 / q;
+               // all information is lost; move the element to the front,
+               // zero it and move it back, which is O(N^2)
+            SrifMoveState(R, Z, in, 0);
+            zeroOne(0);
+            SrifMoveState(R, Z, 0, in);
+            return;
          }
+         double factor = 1.0 / q;
 
          unsigned int ns = 1, i, j, n = R.rows();
 
@@ -362,7 +362,7 @@ namespace gnsstk
           @param[in] ZZ the (potentially) modified Z
           @throw MatrixException if dimensions are wrong.
          */
-      void retriangularize(Matrix<double> RR, Vector<double> ZZ);
+      void retriangularize(const Matrix<double>& RR, const Vector<double>& ZZ);
 
          /**
           Transform the state by the transformation matrix T; i.e. X -> T*X;
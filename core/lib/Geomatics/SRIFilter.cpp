@@ -155,7 +155,7 @@ namespace gnsstk
          }
 
             // update *this with the whitened information
-         SrifMU(R, Z, P, D);
+         SrifMUInPlace(R, Z, P, D);
 
             // un-whiten residuals
          if (&CM != &SRINullMatrix) // same if above creates CHL
@@ -945,8 +945,8 @@ namespace gnsstk
          C = F * X - G * Zw;
          X = Phinv * C;
             // update P
-         P = F * P * transpose(F) + G * transpose(G);
-         P = Phinv * P * transpose(Phinv);
+         P = timesTranspose(F * P, F) + timesTranspose(G, G);
+         P = timesTranspose(Phinv * P, Phinv);
       }
       catch (Exception& e)
       {
@@ -992,8 +992,8 @@ namespace gnsstk
          C = F * X - G * Zw - U;
          X = Phinv * C;
             // update P
-         P = F * P * transpose(F) + G * transpose(G);
-         P = Phinv * P * transpose(Phinv);
+         P = timesTranspose(F * P, F) + timesTranspose(G, G);
+         P = timesTranspose(Phinv * P, Phinv);
          P += outer(U, U);
       }
       catch (Exception& e)
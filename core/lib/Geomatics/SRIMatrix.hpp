@@ -46,6 +46,9 @@
 
 //------------------------------------------------------------------------------------
 // system includes
+#include <algorithm>
+#include <sstream>
+#include <vector>
 // GNSSTk
 #include "Matrix.hpp"
 #include "Vector.hpp"
@@ -145,6 +148,53 @@ namespace gnsstk
    void SrifMU(Matrix<T>& R, Vector<T>& Z, const Matrix<T>& H, Vector<T>& D,
                unsigned int M = 0);
 
+      /**
+       Square root information filter (Srif) measurement update (MU), in place.
+       Identical to SrifMU(R,Z,H,D,M) except that the partials matrix is used
+       as workspace rather than copied, so that a batch of measurements is
+       absorbed without allocating anything; R and Z are updated in place.
+       @param  R  Upper triangluar apriori SRI covariance matrix of dimension N
+       @param  Z  A priori SRI state vector of length N
+       @param  H  Partials matrix of dimension MxN, trashed on output.
+       @param  D  Data vector of length M; on output contains the residuals of fit.
+       @param  M  If H and D have dimension M' > M, then call with M = data length;
+                   otherwise M = 0 (the default) and is ignored.
+       @throw MatrixException if the input has inconsistent dimensions.
+      */
+   template <class T>
+   void SrifMUInPlace(Matrix<T>& R, Vector<T>& Z, Matrix<T>& H, Vector<T>& D,
+                      unsigned int M = 0);
+
+      /**
+       Retriangularize, in place, an SRI {R,Z} in which R (square, dimension N)
+       is no longer upper triangular, e.g. after a transformation of the state.
+       Householder transformations are applied to the rows of R and Z; each one
+       is restricted to the rows that are actually non-zero in its column, so
+       that the cost for a nearly triangular R is much less than N^3.
+       @param  R  SRI matrix of dimension N, upper triangular on output
+       @param  Z  SRI state vector of length N
+       @throw MatrixException if the input has inconsistent dimensions.
+      */
+   template <class T>
+   void SrifRetriangularize(Matrix<T>& R, Vector<T>& Z);
+
+      /**
+       Move the state element at index 'from' to index 'to' in the SRI {R,Z},
+       shifting the elements in between by one, and restore the upper
+       triangular form of R with Givens rotations. This is an O(N*|from-to|)
+       operation, in place, and is the building block for permuting, adding
+       and removing states without re-triangularizing the whole SRI.
+       @param  R  Upper triangular SRI matrix of dimension N
+       @param  Z  SRI state vector of length N
+       @param  from  index of the state to move
+       @param  to    index at which the state is placed
+       @throw MatrixException if the input has inconsistent dimensions or
+                  either index is out of range.
+      */
+   template <class T>
+   void SrifMoveState(Matrix<T>& R, Vector<T>& Z, unsigned int from,
+                      unsigned int to);
+
    // Compute Cholesky decomposition of symmetric positive definite matrix using
    // Crout algorithm. A = L*L^T where A and L are (nxn) and L is lower
    // triangular reads: [ A00 A01 A02 ... A0n ] = [ L00  0   0  0 ...  0 ][ L00
@@ -451,13 +501,9 @@ namespace gnsstk
    {
       try
       {
-         Matrix<T> A;
-         A = H || D;
-
-         SrifMU(R, Z, A, M);
-
-         // copy residuals out of A into D
-         D = Vector<T>(A.colCopy(A.cols() - 1));
+         // H is trashed by the update; copy it once, and update D in place
+         Matrix<T> A(H);
+         SrifMUInPlace(R, Z, A, D, M);
       }
       catch (MatrixException& me)
       {
@@ -465,6 +511,257 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+   // The same algorithm as SrifMU(R,Z,A), with the data column kept separately
+   // in D, and using the columns of H (which are contiguous) directly.
+   template <class T>
+   void SrifMUInPlace(Matrix<T>& R, Vector<T>& Z, Matrix<T>& H, Vector<T>& D,
+                      unsigned int M)
+   {
+      if (H.cols() == 0 || H.cols() != R.cols() || Z.size() < R.rows() ||
+          D.size() != H.rows())
+      {
+         if (H.cols() > 0 && D.size() == H.rows() && R.rows() == 0 &&
+             Z.size() == 0)
+         {
+            // create R and Z
+            R = Matrix<T>(H.cols(), H.cols(), T(0));
+            Z = Vector<T>(H.cols(), T(0));
+         }
+         else
+         {
+            std::ostringstream oss;
+            oss << "Invalid input dimensions:\n  R has dimension " << R.rows()
+                << "x" << R.cols() << ",\n  Z has length " << Z.size()
+                << ",\n  H has dimension " << H.rows() << "x" << H.cols()
+                << ",\n  and D has length " << D.size();
+            GNSSTK_THROW(MatrixException(oss.str()));
+         }
+      }
+
+      const T EPS    = -T(1.e-200);
+      unsigned int m = M, n = R.rows();
+      if (m == 0 || m > H.rows())
+      {
+         m = H.rows();
+      }
+      const unsigned int ld(H.rows());
+      unsigned int i, j, k;
+      T dum, delta, beta, sum;
+      T *hj, *hk, *d(D.begin());
+
+      for (j = 0; j < n; j++)
+      { // loop over columns
+         hj  = H.data() + j * ld;
+         sum = T(0);
+         for (i = 0; i < m; i++)
+            sum += hj[i] * hj[i]; // sum squares of elements in this column
+         if (sum <= T(0))
+         {
+            continue;
+         }
+
+         dum = R(j, j);
+         sum += dum * dum; // add diagonal element
+         sum     = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
+         delta   = dum - sum;
+         R(j, j) = sum;
+
+         beta = sum * delta; // beta must be negative
+         if (beta > EPS)
+         {
+            continue;
+         }
+         beta = T(1) / beta;
+
+         for (k = j + 1; k <= n; k++)
+         { // columns to right of diagonal, then the data
+            hk  = (k == n ? d : H.data() + k * ld);
+            sum = delta * (k == n ? Z(j) : R(j, k));
+            for (i = 0; i < m; i++)
+               sum += hj[i] * hk[i];
+            if (sum == T(0))
+            {
+               continue;
+            }
+
+            sum *= beta;
+            if (k == n)
+            {
+               Z(j) += sum * delta;
+            }
+            else
+            {
+               R(j, k) += sum * delta;
+            }
+
+            for (i = 0; i < m; i++)
+               hk[i] += sum * hj[i];
+         }
+      }
+   } // end SrifMUInPlace
+
+   //---------------------------------------------------------------------------------
+   // Householder triangularization of [R || Z], as in class Householder, but in
+   // place. last[k] is the last row that may be non-zero in column k; the
+   // reflection that zeros column j below the diagonal touches only rows
+   // j..last[j], and fills in the other columns no further down than that.
+   // Columns that are already zero below the diagonal are left alone.
+   template <class T>
+   void SrifRetriangularize(Matrix<T>& R, Vector<T>& Z)
+   {
+      const unsigned int n(R.rows());
+      if (R.cols() != n || Z.size() != n)
+      {
+         std::ostringstream oss;
+         oss << "Invalid input dimensions:\n  R has dimension " << R.rows()
+             << "x" << R.cols() << ",\n  and Z has length " << Z.size();
+         GNSSTK_THROW(MatrixException(oss.str()));
+      }
+      if (n == 0)
+      {
+         return;
+      }
+
+      unsigned int i, j, k, b;
+      std::vector<unsigned int> last(n + 1, 0);
+      for (k = 0; k < n; k++)
+      {
+         for (i = n - 1; i > k && R(i, k) == T(0); i--)
+            ;
+         last[k] = i;
+      }
+      last[n] = n - 1; // Z is never reduced
+
+      T *rj, *rk, sum, dum, delta, beta;
+      for (j = 0; j + 1 < n; j++)
+      {
+         b = last[j];
+         if (b <= j)
+         {
+            continue;
+         }
+         rj  = R.data() + j * n;
+         sum = T(0);
+         for (i = j + 1; i <= b; i++)
+            sum += rj[i] * rj[i];
+         if (sum <= T(0))
+         {
+            continue;
+         }
+
+         dum = rj[j];
+         sum += dum * dum;
+         sum   = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
+         delta = dum - sum;
+         rj[j] = sum;
+         beta  = T(1) / (sum * delta);
+
+         for (k = j + 1; k <= n; k++)
+         {
+            rk  = (k == n ? Z.begin() : R.data() + k * n);
+            dum = delta * rk[j];
+            for (i = j + 1; i <= b; i++)
+               dum += rj[i] * rk[i];
+            if (dum == T(0))
+            {
+               continue;
+            }
+            dum *= beta;
+            rk[j] += dum * delta;
+            for (i = j + 1; i <= b; i++)
+               rk[i] += dum * rj[i];
+            if (last[k] < b)
+            {
+               last[k] = b;
+            }
+         }
+
+         for (i = j + 1; i <= b; i++)
+            rj[i] = T(0);
+      }
+   } // end SrifRetriangularize
+
+   //---------------------------------------------------------------------------------
+   // Move column 'from' of R to 'to', then restore R to upper triangular form.
+   // Moving to the right leaves R upper Hessenberg in columns from..to-1; each
+   // subdiagonal element (p+1,p) is rotated into the diagonal using rows p,p+1.
+   // Moving to the left leaves column 'to' full down to row 'from' (and the
+   // diagonal of the shifted columns zero); its elements are rotated, from the
+   // bottom up, into row 'to' using rows i-1,i. Either way each rotation
+   // touches only two rows, so the whole operation costs O(N*|from-to|).
+   template <class T>
+   void SrifMoveState(Matrix<T>& R, Vector<T>& Z, unsigned int from,
+                      unsigned int to)
+   {
+      const unsigned int n(R.rows());
+      if (R.cols() != n || Z.size() != n || from >= n || to >= n)
+      {
+         std::ostringstream oss;
+         oss << "Invalid input: R has dimension " << R.rows() << "x"
+             << R.cols() << ", Z has length " << Z.size()
+             << ", and indexes are " << from << " and " << to;
+         GNSSTK_THROW(MatrixException(oss.str()));
+      }
+      if (from == to)
+      {
+         return;
+      }
+
+      unsigned int i, k, p;
+      T a, b, r, c, s, t;
+
+         // rotate rows p and q so that element (q,col) becomes zero
+      auto rotate = [&](unsigned int u, unsigned int v, unsigned int j)
+      {
+         a = R(u, j);
+         b = R(v, j);
+         if (b == T(0))
+         {
+            return;
+         }
+         r = ::sqrt(a * a + b * b);
+         c = a / r;
+         s = b / r;
+         R(u, j) = r;
+         R(v, j) = T(0);
+         for (k = j + 1; k < n; k++)
+         {
+            t       = R(u, k);
+            R(u, k) = c * t + s * R(v, k);
+            R(v, k) = c * R(v, k) - s * t;
+         }
+         t    = Z(u);
+         Z(u) = c * t + s * Z(v);
+         Z(v) = c * Z(v) - s * t;
+      };
+
+         // move the column; columns are contiguous in Matrix
+      std::vector<T> moved(R.data() + from * n, R.data() + (from + 1) * n);
+      if (from < to)
+      {
+         std::copy(R.data() + (from + 1) * n, R.data() + (to + 1) * n,
+                   R.data() + from * n);
+      }
+      else
+      {
+         std::copy_backward(R.data() + to * n, R.data() + from * n,
+                            R.data() + (from + 1) * n);
+      }
+      std::copy(moved.begin(), moved.end(), R.data() + to * n);
+
+      if (from < to)
+      {
+         for (p = from; p < to; p++)
+            rotate(p, p + 1, p);
+      }
+      else
+      {
+         for (i = from; i > to; i--)
+            rotate(i - 1, i, to);
+      }
+   } // end SrifMoveState
+
    //---------------------------------------------------------------------------------
    // Compute Cholesky decomposition of symmetric positive definite matrix using
    // Crout algorithm. A = L*L^T where A and L are (nxn) and L is lower
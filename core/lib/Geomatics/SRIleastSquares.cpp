@@ -420,7 +420,7 @@ namespace gnsstk
                }
 
                   // update with whitened information
-               SrifMU(R, Z, P, Res);
+               SrifMUInPlace(R, Z, P, Res);
 
                   // un-whiten the residuals
                if (doRobust || doWeight) // NB same if above creates CHL
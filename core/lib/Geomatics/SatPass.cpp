@@ -109,6 +109,9 @@ namespace gnsstk
          indexForLabel[obstypes[i]] = i;
          labelForIndex[i]           = obstypes[i];
       }
+      spddata.resize(obstypes.size());
+      spdlli.resize(obstypes.size());
+      spdssi.resize(obstypes.size());
    }
 
    SatPass& SatPass::operator=(const SatPass& right)
@@ -123,9 +126,13 @@ namespace gnsstk
          firstTime     = right.firstTime;
          lastTime      = right.lastTime;
          ngood         = right.ngood;
-         spdvector.resize(right.spdvector.size());
-         for (int i = 0; i < right.spdvector.size(); i++)
-            spdvector[i] = right.spdvector[i];
+         spdflag       = right.spdflag;
+         spduserflag   = right.spduserflag;
+         spdndt        = right.spdndt;
+         spdtoffset    = right.spdtoffset;
+         spddata       = right.spddata;
+         spdlli        = right.spdlli;
+         spdssi        = right.spdssi;
       }
 
       return *this;
@@ -164,29 +171,60 @@ namespace gnsstk
                      StringUtils::asString(ssi.size()));
          GNSSTK_THROW(e);
       }
-      if (spdvector.size() > 0 && spdvector[0].data.size() != data.size())
+      if (obstypes.size() != data.size())
       {
-         Exception e(
-            "Error - addData passed different dimension that earlier!" +
-            StringUtils::asString(data.size()) +
-            " != " + StringUtils::asString(spdvector[0].data.size()));
+         Exception e("Dimensions do not match in addData()" +
+                     StringUtils::asString(obstypes.size()) + "," +
+                     StringUtils::asString(data.size()));
          GNSSTK_THROW(e);
       }
 
-         // create a new SatPassData
-      SatPassData spd(data.size());
-      spd.flag = flag;
-      for (int k = 0; k < data.size(); k++)
+         // find the column of each obs type before adding anything
+      vector<int> handles(obstypes.size());
+      for (int k = 0; k < obstypes.size(); k++)
       {
-         int i       = indexForLabel[obstypes[k]];
-         spd.data[i] = data[k];
-         spd.lli[i]  = lli[k];
-         spd.ssi[i]  = ssi[k];
+         if ((handles[k] = obsHandle(obstypes[k])) < 0)
+         {
+            Exception e("Invalid obs type in addData() " + obstypes[k]);
+            GNSSTK_THROW(e);
+         }
       }
 
          // push_back defines count and
          // returns : >=0 index of added data (ok), -1 gap, -2 tt out of order
-      return pushBack(tt, spd);
+      int n = pushBack(tt, flag);
+      if (n < 0)
+      {
+         return n;
+      }
+      for (int k = 0; k < data.size(); k++)
+      {
+         spddata[handles[k]][n] = data[k];
+         spdlli[handles[k]][n]  = lli[k];
+         spdssi[handles[k]][n]  = ssi[k];
+      }
+      return n;
+   }
+
+      // return -2 time tag out of order, data not added
+      //        -1 gap is larger than MaxGap, data not added
+      //       >=0 (success) index of the added data
+   int SatPass::addData(const Epoch& tt, const double *data,
+                        const unsigned short *lli, const unsigned short *ssi,
+                        const unsigned short flag)
+   {
+      int n = pushBack(tt, flag);
+      if (n < 0)
+      {
+         return n;
+      }
+      for (size_t k = 0; k < spddata.size(); k++)
+      {
+         spddata[k][n] = data[k];
+         spdlli[k][n]  = (lli ? lli[k] : 0);
+         spdssi[k][n]  = (ssi ? ssi[k] : 0);
+      }
+      return n;
    }
 
       /* return -4 robs was not obs data (header info)
@@ -204,44 +242,115 @@ namespace gnsstk
       RinexObsData::RinexSatMap::const_iterator it;
       RinexObsData::RinexObsTypeMap::const_iterator jt;
       map<string, unsigned int>::const_iterator kt;
-      SatPassData spd(indexForLabel.size());
+      const size_t nobs(spddata.size());
+      vector<double> data(nobs, 0.0);
+      vector<unsigned short> lli(nobs, 0), ssi(nobs, 0);
 
          // loop over satellites
       for (it = robs.obs.begin(); it != robs.obs.end(); it++)
       {
          if (it->first == sat)
          { // sat is this->sat
-            spd.flag = OK;
+            unsigned short flag = OK;
                // loop over obs
             for (kt = indexForLabel.begin(); kt != indexForLabel.end(); kt++)
             {
                if ((jt = it->second.find(RinexObsHeader::convertObsType(
-                       kt->first))) == it->second.end())
-               {
-                  spd.data[kt->second] = 0.0;
-                  spd.lli[kt->second]  = 0;
-                  spd.ssi[kt->second]  = 0;
-                     // spd.flag = BAD;// don't do this b/c spd may have 'empty'
-                     // obs types
-               }
-               else
+                       kt->first))) != it->second.end())
                {
-                  spd.data[kt->second] = jt->second.data;
-                  spd.lli[kt->second]  = jt->second.lli;
-                  spd.ssi[kt->second]  = jt->second.ssi;
+                     // missing obs are left zero, but do not make the epoch
+                     // BAD b/c the pass may have 'empty' obs types
+                  data[kt->second] = jt->second.data;
+                  lli[kt->second]  = jt->second.lli;
+                  ssi[kt->second]  = jt->second.ssi;
                   if (jt->second.data == 0.0)
                   {
-                     spd.flag = BAD;
+                     flag = BAD;
                   }
                }
             } // end loop over obs
 
-            return pushBack(robs.time, spd);
+            return addData(robs.time, &data[0], &lli[0], &ssi[0], flag);
          }
       }
       return -3; // sat was not found
    }
 
+   void SatPass::reserve(unsigned int n)
+   {
+      spdflag.reserve(n);
+      spduserflag.reserve(n);
+      spdndt.reserve(n);
+      spdtoffset.reserve(n);
+      for (size_t k = 0; k < spddata.size(); k++)
+      {
+         spddata[k].reserve(n);
+         spdlli[k].reserve(n);
+         spdssi[k].reserve(n);
+      }
+   }
+
+      // -------------------------- bulk access by obs type handle
+   double *SatPass::dataColumn(int h)
+   {
+      if (h < 0 || h >= int(spddata.size()))
+      {
+         Exception e("Invalid handle in dataColumn() " + asString(h));
+         GNSSTK_THROW(e);
+      }
+      return (spddata[h].empty() ? NULL : &spddata[h][0]);
+   }
+
+   const double *SatPass::dataColumn(int h) const
+   {
+      if (h < 0 || h >= int(spddata.size()))
+      {
+         Exception e("Invalid handle in dataColumn() " + asString(h));
+         GNSSTK_THROW(e);
+      }
+      return (spddata[h].empty() ? NULL : &spddata[h][0]);
+   }
+
+   unsigned short *SatPass::LLIColumn(int h)
+   {
+      if (h < 0 || h >= int(spdlli.size()))
+      {
+         Exception e("Invalid handle in LLIColumn() " + asString(h));
+         GNSSTK_THROW(e);
+      }
+      return (spdlli[h].empty() ? NULL : &spdlli[h][0]);
+   }
+
+   const unsigned short *SatPass::LLIColumn(int h) const
+   {
+      if (h < 0 || h >= int(spdlli.size()))
+      {
+         Exception e("Invalid handle in LLIColumn() " + asString(h));
+         GNSSTK_THROW(e);
+      }
+      return (spdlli[h].empty() ? NULL : &spdlli[h][0]);
+   }
+
+   unsigned short *SatPass::SSIColumn(int h)
+   {
+      if (h < 0 || h >= int(spdssi.size()))
+      {
+         Exception e("Invalid handle in SSIColumn() " + asString(h));
+         GNSSTK_THROW(e);
+      }
+      return (spdssi[h].empty() ? NULL : &spdssi[h][0]);
+   }
+
+   const unsigned short *SatPass::SSIColumn(int h) const
+   {
+      if (h < 0 || h >= int(spdssi.size()))
+      {
+         Exception e("Invalid handle in SSIColumn() " + asString(h));
+         GNSSTK_THROW(e);
+      }
+      return (spdssi[h].empty() ? NULL : &spdssi[h][0]);
+   }
+
       /* Truncate all data at and after the given time.
          return -1 if ttag is at or before the start of this pass,
          return +1 if ttag is at or after the end of this pass,
@@ -267,22 +376,22 @@ namespace gnsstk
             return -1;
          }
 
-         unsigned int i, j, n(0); // count for ngood
-         for (i = 0; i < spdvector.size(); i++)
+         unsigned int i, j(spdndt.size()), n(0); // count for ngood
+         for (i = 0; i < spdndt.size(); i++)
          {
-            if (spdvector[i].ndt >= static_cast<unsigned int>(count))
+            if (spdndt[i] >= static_cast<unsigned int>(count))
             {
                j = i;
                break;
             }
-            if (spdvector[i].flag != SatPass::BAD)
+            if (spdflag[i] != SatPass::BAD)
             {
                n++;
             }
          }
-         if (j > -1)
+         if (j < spdndt.size())
          {
-            spdvector.resize(j + 1);
+            resizeData(j + 1);
             lastTime = time(j);
             ngood    = n;
          }
@@ -352,7 +461,11 @@ namespace gnsstk
 
          bool first, done, ok;
          int i, dn, di, sign(0);
-         const int N(spdvector.size());
+         const int N(spdndt.size());
+         const vector<double>& P1col(spddata[indexForLabel[useC1 ? "C1" : "P1"]]);
+         const vector<double>& P2col(spddata[indexForLabel["P2"]]);
+         const vector<double>& L1col(spddata[indexForLabel["L1"]]);
+         const vector<double>& L2col(spddata[indexForLabel["L2"]]);
          double pP1, pP2, pL1, pL2, pRB1, pRB2;
          TwoSampleStats<double> dN1, dN2;
          static const double testStdDev(40.0), testSlope(0.1), testRatio(10.0),
@@ -380,16 +493,15 @@ namespace gnsstk
             first = true;
             for (i = 0; i < N; i += di)
             {
-               if (!(spdvector[i].flag &  OK))
+               if (!(spdflag[i] &  OK))
                {
                   continue; // skip bad data
                }
 
-               double P1 =
-                  spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]];
-               double P2  = spdvector[i].data[indexForLabel["P2"]];
-               double L1  = spdvector[i].data[indexForLabel["L1"]];
-               double L2  = spdvector[i].data[indexForLabel["L2"]];
+               double P1  = P1col[i];
+               double P2  = P2col[i];
+               double L1  = L1col[i];
+               double L2  = L2col[i];
                double RB1 = wl1 * L1 - D11 * P1 - D12 * P2;
                double RB2 = wl2 * L2 - D21 * P1 - D22 * P2;
 
@@ -586,36 +698,23 @@ namespace gnsstk
          }
 
          bool first, useC1(hasType("C1")), useC2(hasType("C2"));
+         vector<double>& Pcol(spddata[indexForLabel[
+            freq == 1 ? (useC1 ? "C1" : "P1") : (useC2 ? "C2" : "P2")]]);
+         vector<double>& Lcol(spddata[indexForLabel[freq == 1 ? "L1" : "L2"]]);
          int i;
          double RB, dLB0(0.0);
          long LB, LB0;
          Stats<double> PB;
 
             // get the biases B = L - P
-         for (first = true, i = 0; i < spdvector.size(); i++)
+         for (first = true, i = 0; i < spdndt.size(); i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue; // skip bad data
             }
 
-            double P, L;
-            if (freq == 1)
-            {
-               P = spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]];
-            }
-            else
-            {
-               P = spdvector[i].data[indexForLabel[(useC2 ? "C2" : "P2")]];
-            }
-            if (freq == 1)
-            {
-               L = spdvector[i].data[indexForLabel["L1"]];
-            }
-            else
-            {
-               L = spdvector[i].data[indexForLabel["L2"]];
-            }
+            double P(Pcol[i]), L(Lcol[i]);
 
             if (first)
             { // remove the large numerical range
@@ -667,9 +766,9 @@ namespace gnsstk
             return;
          }
 
-         for (i = 0; i < spdvector.size(); i++)
+         for (i = 0; i < spdndt.size(); i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue; // skip bad data
             }
@@ -678,30 +777,14 @@ namespace gnsstk
             if (smoothPR)
             {
                   // compute the debiased phase, with real bias
-               if (freq == 1)
-               {
-                  spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]] =
-                     spdvector[i].data[indexForLabel["L1"]] - RB;
-               }
-               else if (freq == 2)
-               {
-                  spdvector[i].data[indexForLabel[(useC2 ? "C2" : "P2")]] =
-                     spdvector[i].data[indexForLabel["L2"]] - RB;
-               }
+               Pcol[i] = Lcol[i] - RB;
             }
 
                // replace the phase with the debiased phase, with integer bias
                // (cycles)
             if (debiasPH)
             {
-               if (freq == 1)
-               {
-                  spdvector[i].data[indexForLabel["L1"]] -= LB;
-               }
-               if (freq == 2)
-               {
-                  spdvector[i].data[indexForLabel["L2"]] -= LB;
-               }
+               Lcol[i] -= LB;
             }
          }
       }
@@ -746,6 +829,10 @@ namespace gnsstk
          }
 
          bool useC1(hasType("C1")), useC2(hasType("C2"));
+         vector<double>& P1col(spddata[indexForLabel[useC1 ? "C1" : "P1"]]);
+         vector<double>& P2col(spddata[indexForLabel[useC2 ? "C2" : "P2"]]);
+         vector<double>& L1col(spddata[indexForLabel["L1"]]);
+         vector<double>& L2col(spddata[indexForLabel["L2"]]);
 
             /* transformation matrix
                PB = D * L - P   pure biases = constants for continuous phase
@@ -770,17 +857,17 @@ namespace gnsstk
          Stats<double> PB1, PB2;
 
             // get the biases B = L - DP
-         for (first = true, i = 0; i < spdvector.size(); i++)
+         for (first = true, i = 0; i < spdndt.size(); i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue; // skip bad data
             }
 
-            double P1 = spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]];
-            double P2 = spdvector[i].data[indexForLabel[(useC2 ? "C2" : "P2")]];
-            double L1 = spdvector[i].data[indexForLabel["L1"]] - dLB10;
-            double L2 = spdvector[i].data[indexForLabel["L2"]] - dLB20;
+            double P1 = P1col[i];
+            double P2 = P2col[i];
+            double L1 = L1col[i] - dLB10;
+            double L2 = L2col[i] - dLB20;
 
             if (first)
             { // remove the large numerical range
@@ -842,9 +929,9 @@ namespace gnsstk
             return;
          }
 
-         for (i = 0; i < spdvector.size(); i++)
+         for (i = 0; i < spdndt.size(); i++)
          {
-            if (!(spdvector[i].flag & OK))
+            if (!(spdflag[i] & OK))
             {
                continue; // skip bad data
             }
@@ -853,12 +940,12 @@ namespace gnsstk
             if (smoothPR)
             {
                   // compute the debiased phase, with real bias
-               dbL1 = spdvector[i].data[indexForLabel["L1"]] - RB1;
-               dbL2 = spdvector[i].data[indexForLabel["L2"]] - RB2;
+               dbL1 = L1col[i] - RB1;
+               dbL2 = L2col[i] - RB2;
 
-               spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]] =
+               P1col[i] =
                   D11 * wl1 * dbL1 + D12 * wl2 * dbL2;
-               spdvector[i].data[indexForLabel[(useC2 ? "C2" : "P2")]] =
+               P2col[i] =
                   D21 * wl1 * dbL1 + D22 * wl2 * dbL2;
             }
 
@@ -866,8 +953,8 @@ namespace gnsstk
                // (cycles)
             if (debiasPH)
             {
-               spdvector[i].data[indexForLabel["L1"]] -= LB1;
-               spdvector[i].data[indexForLabel["L2"]] -= LB2;
+               L1col[i] -= LB1;
+               L2col[i] -= LB2;
             }
          }
       }
@@ -881,7 +968,7 @@ namespace gnsstk
       // ---------------------------- NB may be used as rvalue or lvalue
    double& SatPass::data(unsigned int i, const std::string& type)
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in data() " + asString(i));
          GNSSTK_THROW(e);
@@ -892,22 +979,22 @@ namespace gnsstk
          Exception e("Invalid obs type in data() " + type);
          GNSSTK_THROW(e);
       }
-      return spdvector[i].data[it->second];
+      return spddata[it->second][i];
    }
 
    double& SatPass::timeoffset(unsigned int i)
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in timeoffset() " + asString(i));
          GNSSTK_THROW(e);
       }
-      return spdvector[i].toffset;
+      return spdtoffset[i];
    }
 
    unsigned short& SatPass::LLI(unsigned int i, const std::string& type)
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in LLI() " + asString(i));
          GNSSTK_THROW(e);
@@ -918,12 +1005,12 @@ namespace gnsstk
          Exception e("Invalid obs type in LLI() " + type);
          GNSSTK_THROW(e);
       }
-      return spdvector[i].lli[it->second];
+      return spdlli[it->second][i];
    }
 
    unsigned short& SatPass::SSI(unsigned int i, const std::string& type)
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in SSI() " + asString(i));
          GNSSTK_THROW(e);
@@ -934,28 +1021,28 @@ namespace gnsstk
          Exception e("Invalid obs type in SSI() " + type);
          GNSSTK_THROW(e);
       }
-      return spdvector[i].ssi[it->second];
+      return spdssi[it->second][i];
    }
 
       // ---------------------------------- set routines
       // ----------------------------
    void SatPass::setFlag(unsigned int i, unsigned short f)
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in setFlag() " + asString(i));
          GNSSTK_THROW(e);
       }
 
-      if (spdvector[i].flag != BAD && f == BAD)
+      if (spdflag[i] != BAD && f == BAD)
       {
          ngood--;
       }
-      if (spdvector[i].flag == BAD && f != BAD)
+      if (spdflag[i] == BAD && f != BAD)
       {
          ngood++;
       }
-      spdvector[i].flag = f;
+      spdflag[i] = f;
    }
 
       /* set the userflag at one index to inflag;
@@ -963,25 +1050,25 @@ namespace gnsstk
          getUserFlag(); */
    void SatPass::setUserFlag(unsigned int i, unsigned int f)
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in setUserFlag() " + asString(i));
          GNSSTK_THROW(e);
       }
 
-      spdvector[i].userflag = f;
+      spduserflag[i] = f;
    }
 
       // ---------------------------------- get routines
       // ---------------------------- get value of flag at one index
    unsigned short SatPass::getFlag(unsigned int i) const
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in getFlag() " + asString(i));
          GNSSTK_THROW(e);
       }
-      return spdvector[i].flag;
+      return spdflag[i];
    }
 
       /* get the userflag at one index
@@ -989,23 +1076,23 @@ namespace gnsstk
          getUserFlag(); */
    unsigned int SatPass::getUserFlag(unsigned int i) const
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in getUserFlag() " + asString(i));
          GNSSTK_THROW(e);
       }
-      return spdvector[i].userflag;
+      return spduserflag[i];
    }
 
       // get one element of the count array of this SatPass
    unsigned int SatPass::getCount(unsigned int i) const
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("invalid in getCount() " + asString(i));
          GNSSTK_THROW(e);
       }
-      return spdvector[i].ndt;
+      return spdndt[i];
    }
 
       // @return the earliest time (full, including toffset) in this SatPass data
@@ -1014,7 +1101,7 @@ namespace gnsstk
       // @return the latest time (full, including toffset) in this SatPass data
    Epoch SatPass::getLastTime() const
    {
-      return time(spdvector.size() - 1);
+      return time(spdndt.size() - 1);
    }
 
       /* these allow you to get e.g. P1 or C1. NB return double not double& as
@@ -1022,7 +1109,7 @@ namespace gnsstk
    double SatPass::data(unsigned int i, const std::string& type1,
                         const std::string& type2) const
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in data() " + asString(i));
          GNSSTK_THROW(e);
@@ -1030,11 +1117,11 @@ namespace gnsstk
       map<string, unsigned int>::const_iterator it;
       if ((it = indexForLabel.find(type1)) != indexForLabel.end())
       {
-         return spdvector[i].data[it->second];
+         return spddata[it->second][i];
       }
       else if ((it = indexForLabel.find(type2)) != indexForLabel.end())
       {
-         return spdvector[i].data[it->second];
+         return spddata[it->second][i];
       }
       else
       {
@@ -1046,7 +1133,7 @@ namespace gnsstk
    unsigned short SatPass::LLI(unsigned int i, const std::string& type1,
                                const std::string& type2)
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in LLI() " + asString(i));
          GNSSTK_THROW(e);
@@ -1054,11 +1141,11 @@ namespace gnsstk
       map<string, unsigned int>::const_iterator it;
       if ((it = indexForLabel.find(type1)) != indexForLabel.end())
       {
-         return spdvector[i].lli[it->second];
+         return spdlli[it->second][i];
       }
       else if ((it = indexForLabel.find(type2)) != indexForLabel.end())
       {
-         return spdvector[i].lli[it->second];
+         return spdlli[it->second][i];
       }
       else
       {
@@ -1070,7 +1157,7 @@ namespace gnsstk
    unsigned short SatPass::SSI(unsigned int i, const std::string& type1,
                                const std::string& type2)
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in SSI() " + asString(i));
          GNSSTK_THROW(e);
@@ -1078,11 +1165,11 @@ namespace gnsstk
       map<string, unsigned int>::const_iterator it;
       if ((it = indexForLabel.find(type1)) == indexForLabel.end())
       {
-         return spdvector[i].ssi[it->second];
+         return spdssi[it->second][i];
       }
       else if ((it = indexForLabel.find(type2)) == indexForLabel.end())
       {
-         return spdvector[i].ssi[it->second];
+         return spdssi[it->second][i];
       }
       else
       {
@@ -1096,13 +1183,13 @@ namespace gnsstk
          given index in the data array */
    Epoch SatPass::time(unsigned int i) const
    {
-      if (i >= spdvector.size())
+      if (i >= spdndt.size())
       {
          Exception e("Invalid index in time() " + asString(i));
          GNSSTK_THROW(e);
       }
          // computing toff first is necessary to avoid a rare bug in Epoch..
-      double toff = spdvector[i].ndt * dt + spdvector[i].toffset;
+      double toff = spdndt[i] * dt + spdtoffset[i];
       return (firstTime + toff);
    }
 
@@ -1133,44 +1220,40 @@ namespace gnsstk
    {
       try
       {
-         int i, j, n, oldgood, ilast;
+         int i, j, n, ilast;
          Epoch tt;
 
-         newSP               = SatPass(sat, dt); // create new SatPass
-         newSP.Status        = Status;
-         newSP.indexForLabel = indexForLabel;
-         newSP.labelForIndex = labelForIndex;
+         newSP        = SatPass(sat, dt, getObsTypes()); // create new SatPass
+         newSP.Status = Status;
 
-         oldgood = ngood;
          ngood = ilast = 0;
-         for (i = 0; i < spdvector.size(); i++)
+         for (i = 0; i < spdndt.size(); i++)
          { // loop over all data
-            n  = spdvector[i].ndt;
+            n  = spdndt[i];
             tt = time(i);
             if (n < N)
             { // keep in this SatPass
-               if (spdvector[i].flag != BAD)
+               if (spdflag[i] != BAD)
                {
                   ngood++;
                }
                ilast = i;
             }
             else
-            { // copy out data into new SP
-               if (n == N)
+            { // copy out data into new SP; this sets its times and ngood
+               j = newSP.pushBack(tt, spdflag[i]);
+               newSP.spduserflag[j] = spduserflag[i];
+               for (size_t k = 0; k < spddata.size(); k++)
                {
-                  newSP.ngood     = oldgood - ngood;
-                  newSP.firstTime = newSP.lastTime = tt;
+                  newSP.spddata[k][j] = spddata[k][i];
+                  newSP.spdlli[k][j]  = spdlli[k][i];
+                  newSP.spdssi[k][j]  = spdssi[k][i];
                }
-               j                    = newSP.countForTime(tt);
-               spdvector[i].ndt     = j;
-               spdvector[i].toffset = tt - newSP.firstTime - j * dt;
-               newSP.spdvector.push_back(spdvector[i]);
             }
          }
 
             // now trim this SatPass
-         spdvector.resize(ilast + 1);
+         resizeData(ilast + 1);
          lastTime = time(ilast);
 
          return true;
@@ -1189,7 +1272,7 @@ namespace gnsstk
          {
             return;
          }
-         if (spdvector.size() < N)
+         if (spdndt.size() < N)
          {
             dt = N * dt;
             return;
@@ -1212,28 +1295,27 @@ namespace gnsstk
             // decimate
          ngood = 0;
          Epoch newfirstTime, tt;
-         for (j = 0, i = 0; i < spdvector.size(); i++)
+         for (j = 0, i = 0; i < spdndt.size(); i++)
          {
-            if (spdvector[i].ndt % N != nstart)
+            if (spdndt[i] % N != nstart)
             {
                continue;
             }
             lastTime = time(i);
             if (j == 0)
             {
-               newfirstTime         = time(i);
-               spdvector[i].toffset = 0.0;
-               spdvector[i].ndt     = 0;
+               newfirstTime  = time(i);
+               spdtoffset[i] = 0.0;
+               spdndt[i]     = 0;
             }
             else
             {
-               tt               = time(i);
-               spdvector[i].ndt = int(0.5 + (tt - newfirstTime) / (N * dt));
-               spdvector[i].toffset =
-                  tt - newfirstTime - spdvector[i].ndt * N * dt;
+               tt            = time(i);
+               spdndt[i]     = int(0.5 + (tt - newfirstTime) / (N * dt));
+               spdtoffset[i] = tt - newfirstTime - spdndt[i] * N * dt;
             }
-            spdvector[j] = spdvector[i];
-            if (spdvector[j].flag != BAD)
+            copyEpoch(j, i);
+            if (spdflag[j] != BAD)
             {
                ngood++;
             }
@@ -1242,7 +1324,7 @@ namespace gnsstk
 
          dt        = N * dt;
          firstTime = newfirstTime;
-         spdvector.resize(j); // trim
+         resizeData(j); // trim
       }
       catch (Exception& e)
       {
@@ -1351,25 +1433,25 @@ namespace gnsstk
       os << " gap(pts)";
       os << endl;
 
-      for (i = 0; i < spdvector.size(); i++)
+      for (i = 0; i < spdndt.size(); i++)
       {
          tt = time(i);
          os << msg1 << " " << setw(3) << i << " " << sat << " " << setw(3)
-            << spdvector[i].ndt << " " << setw(2) << spdvector[i].flag << " "
+            << spdndt[i] << " " << setw(2) << spdflag[i] << " "
             << printTime(tt, SatPass::outFormat) << fixed << setprecision(6)
-            << " " << setw(9) << spdvector[i].toffset << setprecision(3);
+            << " " << setw(9) << spdtoffset[i] << setprecision(3);
          for (j = 0; j < indexForLabel.size(); j++)
-            os << " " << setw(13) << spdvector[i].data[j] << " "
-               << spdvector[i].lli[j] << " " << spdvector[i].ssi[j];
+            os << " " << setw(13) << spddata[j][i] << " "
+               << spdlli[j][i] << " " << spdssi[j][i];
          if (i == 0)
          {
-            last = spdvector[i].ndt;
+            last = spdndt[i];
          }
-         if (spdvector[i].ndt - last > 1)
+         if (spdndt[i] - last > 1)
          {
-            os << " " << spdvector[i].ndt - last;
+            os << " " << spdndt[i] - last;
          }
-         last = spdvector[i].ndt;
+         last = spdndt[i];
          os << endl;
       }
    }
@@ -1377,7 +1459,7 @@ namespace gnsstk
       // output SatPass to ostream
    std::ostream& operator<<(std::ostream& os, SatPass& sp)
    {
-      os << setw(4) << sp.spdvector.size() << " " << sp.sat << " " << setw(4)
+      os << setw(4) << sp.spdndt.size() << " " << sp.sat << " " << setw(4)
          << sp.ngood << " " << setw(2) << sp.Status << " "
          << printTime(sp.firstTime, SatPass::outFormat) << " "
          << printTime(sp.lastTime, SatPass::outFormat) << " " << fixed
@@ -1388,14 +1470,14 @@ namespace gnsstk
       return os;
    }
 
-      /* ---------------------------- private SatPassData functions
-         -------------------- add data to the arrays at timetag tt (private) return
-         >=0 ok (index of added data), -1 gap, -2 timetag out of order */
-   int SatPass::pushBack(const Epoch tt, SatPassData& spd)
+      /* ---------------------------- private storage functions
+         -------------------- add an epoch to the arrays at timetag tt (private)
+         return >=0 ok (index of added epoch), -1 gap, -2 timetag out of order */
+   int SatPass::pushBack(const Epoch tt, const unsigned short flag)
    {
       unsigned int n;
          // if this is the first point, save first time
-      if (spdvector.size() == 0)
+      if (spdndt.size() == 0)
       {
          firstTime = lastTime = tt;
          n                    = 0;
@@ -1409,7 +1491,7 @@ namespace gnsstk
             // compute count for this point - prev line means n is >= 0
          n = countForTime(tt);
             // test size of gap
-         if ((n - spdvector[spdvector.size() - 1].ndt) * dt > maxGap)
+         if ((n - spdndt.back()) * dt > maxGap)
          {
             return -1;
          }
@@ -1417,27 +1499,52 @@ namespace gnsstk
       }
 
          /* add it
-            spd.flag = 1;
             ngood is useless unless it's changed whenever any flag is... */
-      if (spd.flag != SatPass::BAD)
+      if (flag != SatPass::BAD)
       {
          ngood++;
       }
-      spd.ndt     = n;
-      spd.toffset = tt - firstTime - n * dt;
-      spdvector.push_back(spd);
-      return (spdvector.size() - 1);
+      spdflag.push_back(flag);
+      spduserflag.push_back(0);
+      spdndt.push_back(n);
+      spdtoffset.push_back(tt - firstTime - n * dt);
+      for (size_t k = 0; k < spddata.size(); k++)
+      {
+         spddata[k].push_back(0.0);
+         spdlli[k].push_back(0);
+         spdssi[k].push_back(0);
+      }
+      return (spdndt.size() - 1);
    }
 
-      // get one element of the data array of this SatPass (private)
-   struct SatPass::SatPassData SatPass::getData(unsigned int i) const
+      // change the number of epochs stored (private)
+   void SatPass::resizeData(unsigned int n)
    {
-      if (i >= spdvector.size())
-      { // TD ?? keep this - its private
-         Exception e("invalid in getData() " + asString(i));
-         GNSSTK_THROW(e);
+      spdflag.resize(n, SatPass::OK);
+      spduserflag.resize(n, 0);
+      spdndt.resize(n, 0);
+      spdtoffset.resize(n, 0.0);
+      for (size_t k = 0; k < spddata.size(); k++)
+      {
+         spddata[k].resize(n, 0.0);
+         spdlli[k].resize(n, 0);
+         spdssi[k].resize(n, 0);
+      }
+   }
+
+      // copy all data of one epoch to another (private)
+   void SatPass::copyEpoch(unsigned int to, unsigned int from)
+   {
+      spdflag[to]     = spdflag[from];
+      spduserflag[to] = spduserflag[from];
+      spdndt[to]      = spdndt[from];
+      spdtoffset[to]  = spdtoffset[from];
+      for (size_t k = 0; k < spddata.size(); k++)
+      {
+         spddata[k][to] = spddata[k][from];
+         spdlli[k][to]  = spdlli[k][from];
+         spdssi[k][to]  = spdssi[k][from];
       }
-      return spdvector[i];
    }
 
 } // end namespace gnsstk
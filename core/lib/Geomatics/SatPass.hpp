@@ -41,6 +41,7 @@
 #ifndef GNSSTK_SATELLITE_PASS_INCLUDE
 #define GNSSTK_SATELLITE_PASS_INCLUDE
 
+#include <algorithm>
 #include <map>
 #include <ostream>
 #include <string>
@@ -71,83 +72,6 @@ namespace gnsstk
    class SatPass
    {
    protected:
-      // --------------- SatPassData data structure for internal use only
-         /**
-          struct SatPassData, for internal use only, stores the data and flag
-          arrays (data, lli, ssi) plus a time offset, a SatPass flag, a user flag,
-          and the offset n in time (n*dt) since FirstTime. class SatPass will
-          include a vector of these structs.
-         */
-      struct SatPassData
-      {
-         // member data ----------------------------------
-            /**
-             a flag (cf. SatPass::BAD, etc.) that is set to OK at creation
-             then reset by other processing.
-            */
-         unsigned short flag;
-
-            /**
-             a flag for arbitrary use by the user; SatPass ONLY has
-             set/getUserFlag()
-            */
-         unsigned int userflag;
-
-            /// time 'count' : time of data = FirstTime + ndt * dt + offset
-         unsigned int ndt;
-
-            /// offset of time from integer number * dt since FirstTime.
-         double toffset;
-
-            /// data for one epoch of RINEX data
-         std::vector<double> data;
-
-            /**
-             loss-of-lock and signal-strength indicators (from RINEX) for data
-             parallel to data vector
-            */
-         std::vector<unsigned short> lli, ssi;
-
-         // private member functions ---------------------
-
-            /**
-             constructor
-             @param n the number of data types to be stored, default 4
-            */
-         SatPassData(unsigned short n = 4)
-            : flag(SatPass::OK), userflag(0), ndt(0), toffset(0.0)
-         {
-            data = std::vector<double>(n, 0.0);
-            lli  = std::vector<unsigned short>(n, 0);
-            ssi  = std::vector<unsigned short>(n, 0);
-         }
-
-         // d'tor, copy c'tor and operator= are built by compiler,
-         // but operator= will not work correctly, b/c a deep copy is needed.
-         SatPassData& operator=(const SatPassData& right)
-         {
-            if (&right != this)
-            {
-               flag     = right.flag;
-               userflag = right.userflag;
-               ndt      = right.ndt;
-               toffset  = right.toffset;
-               data.resize(right.data.size());
-               lli.resize(right.lli.size());
-               ssi.resize(right.ssi.size());
-               int i;
-               for (i = 0; i < right.data.size(); i++)
-                  data[i] = right.data[i];
-               for (i = 0; i < right.lli.size(); i++)
-                  lli[i] = right.lli[i];
-               for (i = 0; i < right.ssi.size(); i++)
-                  ssi[i] = right.ssi[i];
-            }
-
-            return *this;
-         }
-      }; // end struct SatPassData
-
       // --------------- private member data -----------------------------
          /**
           Status flag for use exclusively by the caller. It is set to 0
@@ -181,8 +105,31 @@ namespace gnsstk
          /// number of timetags with good data in the data arrays.
       unsigned int ngood;
 
-         /// ALL data in the pass, stored in SatPassData objects, in time order
-      std::vector<SatPassData> spdvector;
+      // ALL data in the pass, in time order, stored as contiguous columns
+      // parallel to each other; element i of each belongs to epoch i.
+
+         /**
+          flag (cf. SatPass::BAD, etc.) of each epoch; set to OK at creation,
+          then reset by other processing.
+         */
+      std::vector<unsigned short> spdflag;
+
+         /// flag of each epoch for arbitrary use by the user
+      std::vector<unsigned int> spduserflag;
+
+         /// time 'count' of each epoch: time = firstTime + ndt * dt + toffset
+      std::vector<unsigned int> spdndt;
+
+         /// offset of time from integer number * dt since firstTime
+      std::vector<double> spdtoffset;
+
+         /**
+          data, loss-of-lock and signal-strength indicators, one column per obs
+          type: the value of obs type k at epoch i is spddata[k][i], where
+          k = indexForLabel[label] is the handle of the obs type.
+         */
+      std::vector<std::vector<double> > spddata;
+      std::vector<std::vector<unsigned short> > spdlli, spdssi;
 
       // --------------- private member functions ------------------------
 
@@ -191,18 +138,19 @@ namespace gnsstk
                 std::vector<std::string> obstypes);
 
          /**
-          add a complete SatPassData at time tt
-          @return n>=0 if data was added successfully, n is the index of the new
-          data
-                     -1 if a gap is found (no data is added),
-                     -2 if time tag is out of order (no data is added)
+          add a new epoch at time tt, with the given flag and with zero data,
+          lli and ssi, which the caller then fills.
+          @return n>=0 if the epoch was added successfully, n is its index
+                     -1 if a gap is found (nothing is added),
+                     -2 if time tag is out of order (nothing is added)
          */
-      int pushBack(const Epoch tt, SatPassData& spd);
+      int pushBack(const Epoch tt, const unsigned short flag);
 
-         /** get a complete SatPassData at count i
-          * @throw Exception
-          */
-      struct SatPassData getData(unsigned int i) const;
+         /// change the number of epochs stored, keeping the first n.
+      void resizeData(unsigned int n);
+
+         /// copy all data of epoch from to epoch to.
+      void copyEpoch(unsigned int to, unsigned int from);
 
    public:
       // ------------------ friends --------------------------------------
@@ -335,6 +283,93 @@ namespace gnsstk
          */
       int addData(const RinexObsData& robs);
 
+         /**
+          Add one epoch of data at tt, with values for every obs type given in
+          handle order (cf. obsHandle()), without any lookup by label.
+          @param tt    the time tag of interest
+          @param data  array of getObsTypes().size() data values, element k
+                        being the value for the obs type with handle k
+          @param lli   array of LLI values parallel to data, or NULL for zeros
+          @param ssi   array of SSI values parallel to data, or NULL for zeros
+          @param flag  flag for this epoch
+          @return n>=0 if data was added successfully, n is the index of the new data
+                 -1 if a gap is found (no data is added),
+                 -2 if time tag is out of order (no data is added)
+         */
+      int addData(const Epoch& tt, const double *data,
+                  const unsigned short *lli = NULL,
+                  const unsigned short *ssi = NULL,
+                  const unsigned short flag = SatPass::OK);
+
+         /**
+          Reserve storage for n epochs, to avoid reallocation when the number
+          of epochs to be added is known in advance.
+          @param n number of epochs
+         */
+      void reserve(unsigned int n);
+
+      // -------------------------- bulk access by obs type handle
+      // The data of each obs type is stored contiguously, in time order, so
+      // an entire column may be processed without lookups by label. The
+      // pointers returned are valid until data is added or removed.
+
+         /**
+          Get the handle of an obs type, for use with the bulk access routines
+          @param type observation type (e.g. "L1")
+          @return handle of the type, 0 <= handle < getObsTypes().size(), or
+                  -1 if the type is not stored in this object
+         */
+      int obsHandle(const std::string& type) const
+      {
+         std::map<std::string, unsigned int>::const_iterator it;
+         it = indexForLabel.find(type);
+         return (it == indexForLabel.end() ? -1 : int(it->second));
+      }
+
+         /**
+          Access the data of one obs type at all epochs, as size() contiguous
+          values in time order.
+          @param handle handle of the obs type, from obsHandle()
+          @return pointer to the first value
+          @throw Exception if handle is invalid
+         */
+      double *dataColumn(int handle);
+      const double *dataColumn(int handle) const;
+
+         /**
+          Access the LLI of one obs type at all epochs, parallel to dataColumn()
+          @param handle handle of the obs type, from obsHandle()
+          @throw Exception if handle is invalid
+         */
+      unsigned short *LLIColumn(int handle);
+      const unsigned short *LLIColumn(int handle) const;
+
+         /**
+          Access the SSI of one obs type at all epochs, parallel to dataColumn()
+          @param handle handle of the obs type, from obsHandle()
+          @throw Exception if handle is invalid
+         */
+      unsigned short *SSIColumn(int handle);
+      const unsigned short *SSIColumn(int handle) const;
+
+         /**
+          Access the flags at all epochs, parallel to dataColumn(); r-value
+          only, use setFlag() to change a flag.
+         */
+      const unsigned short *flagColumn() const
+      {
+         return (spdflag.empty() ? NULL : &spdflag[0]);
+      }
+
+         /**
+          Access the counts at all epochs, parallel to dataColumn(); cf.
+          getCount().
+         */
+      const unsigned int *countColumn() const
+      {
+         return (spdndt.empty() ? NULL : &spdndt[0]);
+      }
+
       // -------------------------- get and set routines
       // -------------------------- can change ssi, lli, data, but not
       // times,sat,dt,ngood,count get and set flag so you can update ngood
@@ -483,8 +518,8 @@ namespace gnsstk
          /// @return the earliest time of good data in this SatPass data
       Epoch getFirstGoodTime() const
       {
-         for (int j = 0; j < spdvector.size(); j++)
-            if (spdvector[j].flag & OK)
+         for (int j = 0; j < spdndt.size(); j++)
+            if (spdflag[j] & OK)
             {
                return time(j);
             }
@@ -494,8 +529,8 @@ namespace gnsstk
          /// @return the latest time of good data in this SatPass data
       Epoch getLastGoodTime() const
       {
-         for (int j = spdvector.size() - 1; j >= 0; j--)
-            if (spdvector[j].flag & OK)
+         for (int j = spdndt.size() - 1; j >= 0; j--)
+            if (spdflag[j] & OK)
             {
                return time(j);
             }
@@ -524,7 +559,7 @@ namespace gnsstk
           get the size of (the arrays in) this SatPass
           @return the size of the data array in this object
          */
-      unsigned int size() const { return spdvector.size(); }
+      unsigned int size() const { return spdndt.size(); }
 
          /**
           get one element of the count array of this SatPass
@@ -590,7 +625,7 @@ namespace gnsstk
       // -------------------------------- utils
       // ---------------------------------
          /// clear the data (but not the obs types) from the arrays
-      void clear() { spdvector.clear(); }
+      void clear() { resizeData(0); }
 
          /**
           compute the timetag associated with index i in the data array
@@ -614,12 +649,15 @@ namespace gnsstk
          {
             return -1;
          }
-         for (int i = 0; i < spdvector.size(); i++)
-            if (count == spdvector[i].ndt)
-            {
-               return i;
-            }
-         return -1;
+            // counts are in increasing order
+         std::vector<unsigned int>::const_iterator it =
+            std::lower_bound(spdndt.begin(), spdndt.end(),
+                             static_cast<unsigned int>(count));
+         if (it == spdndt.end() || *it != static_cast<unsigned int>(count))
+         {
+            return -1;
+         }
+         return int(it - spdndt.begin());
       }
 
          /**
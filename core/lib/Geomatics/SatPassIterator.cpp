@@ -38,6 +38,9 @@
 
 /// @file SatPassIterator.cpp Iterate over a vector of SatPass in time order.
 
+#include <algorithm>
+#include <functional>
+
 #include "SatPassIterator.hpp"
 #include "logstream.hpp"
 
@@ -64,19 +67,6 @@ namespace gnsstk
          // ensure time order
       std::sort(SPList.begin(), SPList.end());
 
-         // copy the list of obs types, and check that each is registered
-      vector<string> otlist;
-      for (i = 0; i < SPList[0].labelForIndex.size(); i++)
-      {
-         otlist.push_back(SPList[0].labelForIndex[i]);
-            // if(RinexObsHeader::convertObsType(SPList[0].labelForIndex[i])
-            //      == RinexObsHeader::UN)
-            //{
-            //   Exception e("Unregistered observation type :
-            //   "+SPList[0].labelForIndex[i]); GNSSTK_THROW(e);
-            //}
-      }
-
          /* copy the data from the first SatPass in the list, for comparison with
             the rest */
       DT        = SPList[0].dt;
@@ -106,9 +96,43 @@ namespace gnsstk
 
       } // end loop over the list
 
+         // count offset of each pass, and the RINEX obs types of its columns
+      passOffset.resize(SPList.size());
+      rinexBeg.resize(SPList.size() + 1);
+      rinexTypes.clear();
+      for (i = 0; i < SPList.size(); i++)
+      {
+         passOffset[i] = int((SPList[i].firstTime - FirstTime) / DT + 0.5);
+         rinexBeg[i]   = rinexTypes.size();
+         for (j = 0; j < SPList[i].labelForIndex.size(); j++)
+         {
+            rinexTypes.push_back(
+               RinexObsHeader::convertObsType(SPList[i].labelForIndex[j]));
+         }
+      }
+      rinexBeg[SPList.size()] = rinexTypes.size();
+
+         // columns of EpochData default to the obs types of the first pass
+      setObsTypes(SPList[0].getObsTypes());
+
       reset(timeReverse, debug);
    }
 
+      // -----------------------------------------------------------------------------
+   void SatPassIterator::setObsTypes(const vector<string>& ots)
+   {
+      obsTypes = ots;
+      obsHandles.resize(SPList.size() * obsTypes.size());
+      for (int i = 0; i < SPList.size(); i++)
+      {
+         for (int n = 0; n < obsTypes.size(); n++)
+         {
+            obsHandles[i * obsTypes.size() + n] =
+               SPList[i].obsHandle(obsTypes[n]);
+         }
+      }
+   }
+
       // -----------------------------------------------------------------------------
       // restart the iteration
    void SatPassIterator::reset(bool rev, bool dbug)
@@ -117,270 +141,243 @@ namespace gnsstk
       debug       = dbug;
          // clear out the old
       currentN = 0;
-      listIndex.clear();
-      dataIndex.clear();
-      countOffset.clear();
-      indexStatus = vector<int>(SPList.size(), -1);
-         // loop over the list
-      int i = (timeReverse ? SPList.size() - 1 : 0);
-      while ((timeReverse && i >= 0) || (!timeReverse && i < SPList.size()))
+      current.clear();
+      heap.clear();
+      dataIndex = vector<int>(SPList.size(), 0);
+      nextPass  = vector<int>(SPList.size(), -1);
+
+         // chain the passes of each satellite in the order of iteration
+      map<RinexSatID, int> lastPass;
+      vector<int> firstPass;
+      int n(SPList.size());
+      for (int m = 0; m < n; m++)
       {
-
-         for (;;)
-         {
-               // ignore passes with negative Status
-            if (SPList[i].Status < 0)
-            {
-               break;
-            }
-
-               // define latest epoch when time reversed
-            if (timeReverse && currentN == 0)
-            {
-               currentN = int((SPList[i].firstTime - FirstTime) / DT + 0.5) +
-                          SPList[i].spdvector[SPList[i].size() - 1].ndt;
-            }
-
-               // (re)build the maps
-            if (listIndex.find(SPList[i].sat) == listIndex.end())
-            {
-               indexStatus[i]           = 0;
-               listIndex[SPList[i].sat] = i;
-               dataIndex[SPList[i].sat] =
-                  (timeReverse ? SPList[i].size() - 1 : 0);
-               countOffset[SPList[i].sat] =
-                  int((SPList[i].firstTime - FirstTime) / DT + 0.5);
-               LOG(DEBUG4) << "reset - define map " << i << " for sat "
-                           << SPList[i].sat << " at time "
-                           << SPList[i].firstTime.printf("%4F %10.3g")
-                           << " offset " << countOffset[SPList[i].sat];
-            }
-            else
-            {
-               indexStatus[i] = -1;
-               LOG(DEBUG4) << "reset - turn off pass " << i << " for sat "
-                           << SPList[i].sat << " at time "
-                           << SPList[i].firstTime.printf("%4F %10.3g");
-            }
-
-            break; // mandatory
-         }
-
-         if (timeReverse)
+         int i = (timeReverse ? n - 1 - m : m);
+         map<RinexSatID, int>::iterator it = lastPass.find(SPList[i].sat);
+         if (it == lastPass.end())
          {
-            i--;
+            lastPass[SPList[i].sat] = i;
+            firstPass.push_back(i);
          }
          else
          {
-            i++;
+            nextPass[it->second] = i;
+            it->second           = i;
          }
-      } // end loop over the list
+      }
+
+         // start the first good pass of each satellite
+      for (int m = 0; m < firstPass.size(); m++)
+      {
+         startPass(firstPass[m]);
+      }
+
+         // define latest epoch when time reversed
+      if (heap.size() > 0)
+      {
+         currentN = (timeReverse ? -heap[0].first : heap[0].first);
+      }
+   }
+
+      // -----------------------------------------------------------------------------
+   void SatPassIterator::startPass(int i)
+   {
+         // ignore passes with negative Status
+      while (i >= 0 && (SPList[i].Status < 0 || SPList[i].size() == 0))
+      {
+         LOG(DEBUG4) << "reset - turn off pass " << i << " for sat "
+                     << SPList[i].sat << " at time "
+                     << SPList[i].firstTime.printf("%4F %10.3g");
+         i = nextPass[i];
+      }
+      if (i < 0)
+      {
+         return;
+      }
+
+      dataIndex[i] = (timeReverse ? SPList[i].size() - 1 : 0);
+      LOG(DEBUG4) << "start pass " << i << " for sat " << SPList[i].sat
+                  << " at time " << SPList[i].firstTime.printf("%4F %10.3g")
+                  << " offset " << passOffset[i];
+      heap.push_back(make_pair(key(i, dataIndex[i]), (unsigned int)(i)));
+      push_heap(heap.begin(), heap.end(),
+                greater<pair<int, unsigned int> >());
    }
 
       /* -----------------------------------------------------------------------------
-         return 1 for success, 0 at end of data
-         Access (all of) the data for the next epoch. As long as this function
-         returns non-zero, there is more data to be accessed. Ignore passes with
-         Status less than zero.
-         @param indexMap  map<unsigned int, unsigned int> defined so that all the
-                          data in the current iteration is found at
-                          SatPassList[i].data(j) where indexMap[i] = j.
-         @return 1 for success, 0 at the end of the dataset.
-         @throw if time tags are out of order. */
-   int SatPassIterator::next(std::map<unsigned int, unsigned int>& indexMap)
+         return 1 for success, 0 at end of data, leaving the list in current.
+         Pop all the passes with the smallest key off the heap, record them and
+         push back the ones that have more data. */
+   int SatPassIterator::advance()
    {
-      int i, j, k, numsvs;
-      RinexSatID sat;
+      current.clear();
 
-      numsvs = 0;
-      indexMap.clear();
-      nextIndexMap.clear();
+         // drop passes whose Status was made negative since they were started
+      while (heap.size() > 0 && SPList[heap[0].second].Status < 0)
+      {
+         unsigned int i = heap[0].second;
+         pop_heap(heap.begin(), heap.end(),
+                  greater<pair<int, unsigned int> >());
+         heap.pop_back();
+         if (debug)
+         {
+            LOG(INFO) << " Erase this pass for bad status: index " << i
+                      << " sat " << SPList[i].sat;
+         }
+         startPass(nextPass[i]);
+      }
+
+      if (heap.size() == 0)
+      {
+         if (debug)
+         {
+            LOG(INFO) << "Return 0 from next()";
+         }
+         return 0;
+      }
 
+      const int thiskey(heap[0].first);
+      currentN = (timeReverse ? -thiskey : thiskey);
       if (debug)
       {
-         LOG(INFO) << "SPIterator::next(map) - time "
+         LOG(INFO) << "SPIterator::next - time "
                    << (FirstTime + currentN * DT).printf("%4F %10.3g")
-                   << " size of listIndex " << listIndex.size();
+                   << " active passes " << heap.size();
       }
 
-      while (numsvs == 0)
+      while (heap.size() > 0 && heap[0].first == thiskey)
       {
-         if (listIndex.size() == 0)
+         unsigned int i = heap[0].second;
+         pop_heap(heap.begin(), heap.end(),
+                  greater<pair<int, unsigned int> >());
+         heap.pop_back();
+
+         if (SPList[i].Status < 0)
          {
-            if (debug)
-            {
-               LOG(INFO) << "Return 0 from next()";
-            }
-            return 0;
+            startPass(nextPass[i]);
+            continue;
          }
 
-            // loop over active SatPass's
-         map<RinexSatID, int>::iterator kt;
-
-            // debugging - dump the listIndex
-
+         int j = dataIndex[i];
+         current.push_back(make_pair(i, (unsigned int)(j)));
          if (debug)
          {
-            for (kt = listIndex.begin(); kt != listIndex.end(); kt++)
-               LOG(INFO) << "   listIndex: " << kt->first << " " << kt->second;
+            LOG(INFO) << "SPIterator::next found sat " << SPList[i].sat
+                      << " at index " << i << " " << j;
          }
 
-         kt = listIndex.begin();
-         while (kt != listIndex.end())
+            // increment data index
+         if ((timeReverse && --j < 0) ||
+             (!timeReverse && ++j == SPList[i].spdndt.size()))
          {
-            sat = kt->first;
-            i   = kt->second;
-            j   = dataIndex[sat];
-            if (debug)
+               // this pass is done - start the next one for this sat
+            int k = nextPass[i];
+            while (k >= 0 && (SPList[k].Status < 0 || SPList[k].size() == 0))
             {
-               LOG(INFO) << "Loop over listIndex: " << sat << " " << i << " "
-                         << j;
+               k = nextPass[k];
             }
-
-            if (SPList[i].Status < 0)
+            if (k >= 0)
             {
-               listIndex.erase(
-                  kt++); // erasing a map - do exactly this and no more
-               if (debug)
-               {
-                  LOG(INFO)
-                     << " Erase this pass for bad status: index " << i
-                     << " sat " << sat << " size is now " << listIndex.size();
-               }
-               continue;
-            }
-
-            if (countOffset[sat] + SPList[i].spdvector[j].ndt == currentN)
-            {
-                  // found active sat at this count - add to map
-               nextIndexMap[i] = j;
-               numsvs++;
-               if (debug)
-               {
-                  LOG(INFO) << "SPIterator::next(map) found sat " << sat
-                            << " at index " << i;
-               }
-
-                  // increment data index
-               if ((timeReverse && --j < 0) ||
-                   (!timeReverse && ++j == SPList[i].spdvector.size()))
-               {
-                  if (debug)
-                  {
-                     LOG(INFO)
-                        << " This pass for sat " << sat << " is done ...";
-                  }
-                  indexStatus[i] = 1;
-
-                     // find the next pass for this sat
-                  k = i + (timeReverse ? -1 : 1);
-                  while ((timeReverse && k >= 0) ||
-                         (!timeReverse && k < SPList.size()))
-                     // for(k=i+1; k<SPList.size(); k++)
-                  {
-                     if (debug)
-                     {
-                        LOG(INFO) << " ... consider next pass " << k << " "
-                                  << SPList[k].sat << " "
-                                  << SPList[k].firstTime.printf("%4F %10.3g");
-                     }
-                     bool found(false);
-                     for (;;)
-                     {
-                        if (SPList[k].Status < 0) // bad pass
-                        {
-                           break;
-                        }
-                        if (SPList[k].sat != sat) // wrong sat
-                        {
-                           break;
-                        }
-                        if (indexStatus[k] > 0) // already done
-                        {
-                           break;
-                        }
-
-                           // take this one
-                        indexStatus[k] = 0;
-                        i = listIndex[sat] = k;
-                        dataIndex[sat] =
-                           (timeReverse ? SPList[i].size() - 1 : 0);
-                        countOffset[sat] =
-                           int((SPList[i].firstTime - FirstTime) / DT + 0.5);
-                        found = true;
-                        break; // mandatory
-                     }
-                     if (found)
-                     {
-                        break;
-                     }
-                     if (timeReverse)
-                     {
-                        k--;
-                     }
-                     else
-                     {
-                        k++;
-                     }
-                  } // end while loop over next passes
-
-                  if (indexStatus[i] == 0)
-                  {
-                     if (debug)
-                     {
-                        LOG(INFO) << " ... new pass for sat " << SPList[i].sat
-                                  << " at index " << i << " and time "
-                                  << SPList[i].firstTime.printf("%4F %10.3g");
-                     }
-                  }
-               }
-               else
+               int jk = (timeReverse ? SPList[k].size() - 1 : 0);
+               if (key(k, jk) <= thiskey)
                {
-                  dataIndex[sat] = j;
+                  Exception e("Time tags out of order: passes " + asString(i) +
+                              " and " + asString(k) + " for sat " +
+                              SPList[i].sat.toString() + " overlap");
+                  GNSSTK_THROW(e);
                }
-
-            } // end if found active sat at this count
-
-               // increment the iterator
-            if (indexStatus[i] > 0)
-            { // a new one was not found
-               listIndex.erase(
-                  kt++); // erasing a map - do exactly this and no more
                if (debug)
                {
-                  LOG(INFO) << " Erase this pass: index " << i << " sat " << sat
-                            << " size is now " << listIndex.size();
+                  LOG(INFO) << " ... new pass for sat " << SPList[k].sat
+                            << " at index " << k << " and time "
+                            << SPList[k].firstTime.printf("%4F %10.3g");
                }
+               startPass(k);
             }
-            else
-            {
-               kt++;
-            }
-
-         } // end while loop over active SatPass's
-         if (debug)
-         {
-            LOG(INFO) << "End while loop over active SatPasses";
-         }
-
-            // if(robs.numSvs == 0) cout << "Gap at " << currentN << endl;
-         if (timeReverse)
-         {
-            currentN--;
          }
          else
          {
-            currentN++;
+            dataIndex[i] = j;
+            heap.push_back(make_pair(key(i, j), i));
+            push_heap(heap.begin(), heap.end(),
+                      greater<pair<int, unsigned int> >());
          }
+      }
 
-      } // end while robs.numSvs==0
+      if (current.size() == 0)
+      {
+         return advance(); // all were bad; try the next epoch
+      }
 
-      indexMap = nextIndexMap;
+      sort(current.begin(), current.end());
       if (debug)
       {
          LOG(INFO) << "Return 1 from next()";
       }
 
+      return 1;
+   }
+
+      // -----------------------------------------------------------------------------
+   int SatPassIterator::next(IndexList& indexes)
+   {
+      int iret = advance();
+      indexes = current;
+      return iret;
+   }
+
+      // -----------------------------------------------------------------------------
+   int SatPassIterator::next(std::map<unsigned int, unsigned int>& indexMap)
+   {
+      int iret = advance();
+      indexMap.clear();
+      indexMap.insert(current.begin(), current.end());
+      return iret;
+   }
+
+      // -----------------------------------------------------------------------------
+   int SatPassIterator::next(EpochData& ed)
+   {
+      int iret = advance();
+      if (iret == 0)
+      {
+         return iret;
+      }
+
+      const unsigned int nsat(current.size()), nobs(obsTypes.size());
+      ed.time = SPList[current[0].first].time(current[0].second);
+      ed.sats.resize(nsat);
+      ed.pass.resize(nsat);
+      ed.index.resize(nsat);
+      ed.flag.resize(nsat);
+      ed.data.resize(nobs);
+      ed.lli.resize(nobs);
+      ed.ssi.resize(nobs);
+      for (unsigned int n = 0; n < nobs; n++)
+      {
+         ed.data[n].resize(nsat);
+         ed.lli[n].resize(nsat);
+         ed.ssi[n].resize(nsat);
+      }
+
+      for (unsigned int k = 0; k < nsat; k++)
+      {
+         const unsigned int i(current[k].first), j(current[k].second);
+         const SatPass& sp(SPList[i]);
+         ed.sats[k]  = sp.sat;
+         ed.pass[k]  = i;
+         ed.index[k] = j;
+         ed.flag[k]  = sp.spdflag[j];
+         const int *handles = (nobs ? &obsHandles[i * nobs] : NULL);
+         for (unsigned int n = 0; n < nobs; n++)
+         {
+            int h = handles[n];
+            ed.data[n][k] = (h < 0 ? 0.0 : sp.spddata[h][j]);
+            ed.lli[n][k]  = (h < 0 ? 0 : sp.spdlli[h][j]);
+            ed.ssi[n][k]  = (h < 0 ? 0 : sp.spdssi[h][j]);
+         }
+      }
+
       return 1;
    }
 
@@ -395,14 +392,7 @@ namespace gnsstk
            as nec. */
    int SatPassIterator::next(RinexObsData& robs)
    {
-      if (listIndex.size() == 0)
-      {
-         return 0;
-      }
-
-      map<unsigned int, unsigned int> indexMap;
-      map<unsigned int, unsigned int>::const_iterator kt;
-      int iret = next(indexMap);
+      int iret = advance();
       if (iret == 0)
       {
          return iret;
@@ -414,27 +404,24 @@ namespace gnsstk
       robs.numSvs      = 0;
 
          /* get the time tag.
-            NB there is an assumption here, that all that SatPass'es in indexMap
+            NB there is an assumption here, that all that SatPass'es in current
             are consistent w.r.t. time tag - clearly ok if SPList was created in
             the usual ways. */
-      kt        = indexMap.begin();
-      robs.time = SPList[kt->first].time(kt->second);
+      robs.time = SPList[current[0].first].time(current[0].second);
 
-         // loop over the map
-      for (kt = indexMap.begin(); kt != indexMap.end(); kt++)
+         // loop over the list
+      for (IndexList::const_iterator kt = current.begin(); kt != current.end();
+           kt++)
       {
          int i          = kt->first;
          int j          = kt->second;
          RinexSatID sat = SPList[i].getSat();
-            // LOG(DEBUG2) << "SPIterator::next(robs) found sat " << sat
-            //   << " at index " << i << " and time " << SPList[i].time(j);
 
          bool found = false;
-         bool flag  = (SPList[i].spdvector[j].flag != SatPass::BAD);
-         for (int k = 0; k < SPList[i].labelForIndex.size(); k++)
+         RinexObsData::RinexObsTypeMap *otmap = NULL;
+         for (int k = rinexBeg[i]; k < rinexBeg[i + 1]; k++)
          {
-            RinexObsType ot;
-            ot = RinexObsHeader::convertObsType(SPList[i].labelForIndex[k]);
+            const RinexObsType& ot(rinexTypes[k]);
             if (ot == RinexObsHeader::UN)
             {
                ; // LOG(DEBUG1) << " Error - this sat has UN obstype"; // TD
@@ -443,15 +430,17 @@ namespace gnsstk
             else
             {
                found = true;
+               if (otmap == NULL)
+               {
+                  otmap = &robs.obs[sat];
+               }
                   /* NO some obs may be zero b/c they are not collected (e.g. C2)
-                     -> bad
-                     robs.obs[sat][ot].data = flag ? SPList[i].spdvector[j].data[k]
-                     : 0.; robs.obs[sat][ot].lli  = flag ?
-                     SPList[i].spdvector[j].lli[k] : 0; robs.obs[sat][ot].ssi  =
-                     flag ? SPList[i].spdvector[j].ssi[k] : 0; */
-               robs.obs[sat][ot].data = SPList[i].spdvector[j].data[k];
-               robs.obs[sat][ot].lli  = SPList[i].spdvector[j].lli[k];
-               robs.obs[sat][ot].ssi  = SPList[i].spdvector[j].ssi[k];
+                     -> bad; so copy the data whatever the flag */
+               RinexDatum& rd((*otmap)[ot]);
+               int h   = k - rinexBeg[i];
+               rd.data = SPList[i].spddata[h][j];
+               rd.lli  = SPList[i].spdlli[h][j];
+               rd.ssi  = SPList[i].spdssi[h][j];
             }
          }
          if (found)
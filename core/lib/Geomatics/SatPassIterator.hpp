@@ -42,6 +42,9 @@
 #define GNSSTK_SATELLITE_PASS_ITERATOR_INCLUDE
 
 // -------------------------------------------------------------------------------
+#include <utility>
+#include <vector>
+
 #include "SatPass.hpp"
 
 namespace gnsstk
@@ -51,10 +54,37 @@ namespace gnsstk
        Iterate over a list (vector) of SatPass using this class. NB. this class
        ignores passes that have Status less than zero, but does not change any
        Status.
+
+       The passes are merged with a heap holding the next epoch of each
+       satellite, so one call to next() costs O(log(number of satellites)) per
+       satellite at the epoch, however many passes there are in the list.
       */
    class SatPassIterator
    {
    public:
+         /// pairs (i,j), sorted on i, such that the data of the current epoch
+         /// is found at epoch j of SatPassList[i]
+      typedef std::vector<std::pair<unsigned int, unsigned int> > IndexList;
+
+         /**
+          All the data at one epoch, in columns: element k of each vector is
+          for satellite sats[k], found at epoch index[k] of SatPassList[pass[k]].
+          Data columns are parallel to getObsTypes(); an obs type missing from a
+          pass gives zero data, lli and ssi. Pass the same object to next() on
+          each call to reuse its memory.
+         */
+      struct EpochData
+      {
+         Epoch time;                     ///< time tag of the epoch
+         std::vector<RinexSatID> sats;   ///< satellites at this epoch
+         std::vector<unsigned int> pass; ///< index of the pass in the list
+         std::vector<unsigned int> index; ///< index of the epoch in the pass
+         std::vector<unsigned short> flag; ///< SatPass flag
+            /// data[n][k] is obs type n for satellite k, likewise lli and ssi
+         std::vector<std::vector<double> > data;
+         std::vector<std::vector<unsigned short> > lli, ssi;
+      };
+
          /**
           Explicit (only) constructor. Check the list for consistency (else
           throw) and find common time step and obs types, as well as first and
@@ -77,6 +107,19 @@ namespace gnsstk
          /// Restart the iteration, i.e. return to the initial time
       void reset(bool rev = false, bool dbug = false);
 
+         /**
+          Access (all of) the data for the next epoch. As long as this function
+          returns non-zero, there is more data to be accessed.
+          Ignore passes with Status less than zero.
+          @param indexes   IndexList (cleared, its memory reused) of pairs (i,j)
+                           such that all the data in the current iteration is
+                           found at SatPassList[i].data(j).
+          @return 1 for success, 0 at the end of the dataset.
+          @throw Exception if time tags are out of order, i.e. if passes for
+                           the same satellite overlap in time.
+         */
+      int next(IndexList& indexes);
+
          /**
           Access (all of) the data for the next epoch. As long as this function
           returns non-zero, there is more data to be accessed.
@@ -89,13 +132,21 @@ namespace gnsstk
          */
       int next(std::map<unsigned int, unsigned int>& indexMap);
 
+         /**
+          Access (all of) the data for the next epoch, in columns.
+          Ignore passes with Status less than zero.
+          @param ed    EpochData in which data is returned.
+          @return 1 for success, 0 at the end of the dataset.
+          @throw Exception if time tags are out of order.
+         */
+      int next(EpochData& ed);
+
          /**
           Access (all of) the data for the next epoch. As long as this function
           returns non-zero, there is more data to be accessed.
           Ignore passes with Status less than zero.
           NB. If SatPass obs types are not registered (cf. RinexUtilities.hpp),
-          then data will NOT be added to RinexObsData. NB. This assumes that all
-          the SatPasses have the same obs in the same order!!
+          then data will NOT be added to RinexObsData.
           @param robs  RinexObsData in which data is returned.
           @return 1 for success, 0 at the end of the dataset.
           @throw Exception if time tags are out of order
@@ -135,6 +186,13 @@ namespace gnsstk
          /// Get the time interval, which is common to all the SatPass in the list.
       double getDT() { return DT; }
 
+         /// Get the obs types of the columns of EpochData; by default those of
+         /// the first SatPass in the list.
+      const std::vector<std::string>& getObsTypes() const { return obsTypes; }
+
+         /// Set the obs types of the columns of EpochData.
+      void setObsTypes(const std::vector<std::string>& ots);
+
          /**
           get a map of pairs of indexes for the current epoch. call this after
           calling next() to get pairs (i,j) where the data returned by next() is
@@ -143,14 +201,34 @@ namespace gnsstk
          */
       std::map<unsigned int, unsigned int> getIndexes()
       {
-         return nextIndexMap;
+         return std::map<unsigned int, unsigned int>(current.begin(),
+                                                     current.end());
       }
 
+         /// get the pairs of indexes for the current epoch, as getIndexes().
+      const IndexList& getIndexList() const { return current; }
+
    private:
       SatPassIterator(const SatPassIterator &);            // DO NOT implement
       SatPassIterator& operator=(const SatPassIterator &); // DO NOT implement
 
-         /// if true, print debug info in nex()
+         /// heap key of epoch j of pass i: its count, negated if timeReverse
+      int key(unsigned int i, int j) const
+      {
+         int n = passOffset[i] + SPList[i].spdndt[j];
+         return (timeReverse ? -n : n);
+      }
+
+         /// find the next epoch, leaving its indexes in current
+         /// @return 1 for success, 0 at the end of the dataset.
+         /// @throw Exception if time tags are out of order.
+      int advance();
+
+         /// start pass i, or the next usable pass for its satellite after i,
+         /// if any, by pushing its first epoch onto the heap
+      void startPass(int i);
+
+         /// if true, print debug info in next()
       bool debug;
 
          /// if true, iterate in reverse time order
@@ -172,33 +250,41 @@ namespace gnsstk
          */
       Epoch FirstTime, LastTime;
 
-         /// index of the current object in the list for this satellite
-      std::map<RinexSatID, int> listIndex;
-
-         /**
-          index of the data vector (spdvector) of the current object in the list
-          for this satellite
-         */
-      std::map<RinexSatID, int> dataIndex;
+         /// vectors parallel to SPList: offset in count of the first epoch of
+         /// each pass, and index of the next pass (in the direction of
+         /// iteration) for the same satellite, or -1
+      std::vector<int> passOffset, nextPass;
 
-         /// offset in count of the current object in the list for this satellite
-      std::map<RinexSatID, int> countOffset;
+         /// vector parallel to SPList: index of the current epoch of each pass
+      std::vector<int> dataIndex;
 
          /**
-          vector parallel to SPList used to mark current use by iteration;
-          value is "-1,0,1" as SPList[i] is "yet to be used, in use, done".
-          This has nothing to do with SatPass::Status()
+          heap of (key,i) for the active pass i of each satellite, where key is
+          that of the next epoch of the pass; the smallest key is on top.
          */
-      std::vector<int> indexStatus;
+      std::vector<std::pair<int, unsigned int> > heap;
 
          /// reference to the vector of passes being processed
       std::vector<SatPass> &SPList;
 
          /**
-          map of indexes i,j, created by next(), such that data returned by
-          next() is found at SatPassList[i].spdvector[j] where map[i]=j.
+          list of indexes (i,j), created by next(), such that data returned by
+          next() is found at epoch j of SatPassList[i].
          */
-      std::map<unsigned int, unsigned int> nextIndexMap;
+      IndexList current;
+
+         /// obs types of the columns of EpochData
+      std::vector<std::string> obsTypes;
+
+         /// handles of obsTypes in each pass: column n of pass i is
+         /// obsHandles[i*obsTypes.size()+n], -1 if missing
+      std::vector<int> obsHandles;
+
+         /// RINEX obs type of each column of each pass (labelForIndex order, as
+         /// found by the constructor), beginning at rinexTypes[rinexBeg[i]]
+         /// for pass i
+      std::vector<RinexObsType> rinexTypes;
+      std::vector<unsigned int> rinexBeg;
 
    }; // end class SatPassIterator
 
@@ -62,8 +62,8 @@ namespace gnsstk
       {
          int i, j, nep;
          Epoch ttag;
-         map<unsigned int, unsigned int> indexMap;
-         map<unsigned int, unsigned int>::const_iterator kt;
+         SatPassIterator::IndexList indexMap;
+         SatPassIterator::IndexList::const_iterator kt;
          vector<string> obstypes;
          ostringstream oss;
 
@@ -139,8 +139,8 @@ namespace gnsstk
          int i, ii, jj;
          double data;
          Epoch ttag;
-         map<unsigned int, unsigned int> indexMap;
-         map<unsigned int, unsigned int>::iterator kt;
+         SatPassIterator::IndexList indexMap;
+         SatPassIterator::IndexList::const_iterator kt;
          SatPassIterator SPit(SPList);
 
          msh.setDT(SPit.getDT());
@@ -161,9 +161,10 @@ namespace gnsstk
                   // loop over obs types in this SP
                for (i = 0; i < ots.size(); i++)
                {
-                  if (SPList[ii].hasType(ots[i]))
+                  int h = SPList[ii].obsHandle(ots[i]);
+                  if (h >= 0)
                   {
-                     data = SPList[ii].data(jj, ots[i]);
+                     data = SPList[ii].dataColumn(h)[jj];
                      msh.add(ttag, sat, ots[i], data);
                   }
                }
@@ -195,8 +196,8 @@ namespace gnsstk
          double data;
          Epoch ttag;
          CommonTime ttagdum;
-         map<unsigned int, unsigned int> indexMap;
-         map<unsigned int, unsigned int>::iterator kt;
+         SatPassIterator::IndexList indexMap;
+         SatPassIterator::IndexList::const_iterator kt;
 
          SatPassIterator SPit(SPList);
          while (SPit.next(indexMap))
@@ -217,13 +218,15 @@ namespace gnsstk
                   // loop over obs types in this SP
                for (i = 0; i < ots.size(); i++)
                {
-                  if (SPList[ii].hasType(ots[i]))
+                  int h = SPList[ii].obsHandle(ots[i]);
+                  if (h >= 0)
                   {
-                     data = SPList[ii].data(jj, ots[i]);
+                     double *column = SPList[ii].dataColumn(h);
+                     data           = column[jj];
                         // tricky - don't keep correcting ttag
                      ttagdum = static_cast<CommonTime>(ttag);
                      msh.fix(ttagdum, sat, ots[i], data);
-                     SPList[ii].data(jj, ots[i]) = data;
+                     column[jj] = data;
                      if (++n == 1)
                      {
                         deltfix = (ttagdum - ttag); // only once
@@ -652,11 +655,8 @@ namespace gnsstk
             return 0;
          }
 
-         int i, j, ii, jj, ngood;
-         double data;
+         int i, j, ii;
          vector<string> obstypes, ots;
-         map<unsigned int, unsigned int> indexMap;
-         map<unsigned int, unsigned int>::const_iterator kt;
          RinexObsData robs;
             // RinexObsData::RinexSatMap::const_iterator it;
             // RinexObsData::RinexObsTypeMap::const_iterator jt;
@@ -725,47 +725,32 @@ namespace gnsstk
 
          rstrm << header;
 
-         while (spit.next(indexMap))
+            // read the data in columns parallel to obstypes; missing types are 0
+         SatPassIterator::EpochData ed;
+         spit.setObsTypes(obstypes);
+         while (spit.next(ed))
          {
             robs.obs.clear();
             robs.numSvs      = 0;
             robs.clockOffset = 0.0;
+            robs.time        = ed.time;
 
-            kt        = indexMap.begin();
-            robs.time = SPList[kt->first].time(kt->second);
-
-            for (kt = indexMap.begin(); kt != indexMap.end(); ++kt)
+            for (i = 0; i < ed.sats.size(); i++)
             {
-               ii = kt->first;
-               jj = kt->second;
-               if (SPList[ii].status() == -1)
+               ii = ed.pass[i];
+               if (SPList[ii].status() == -1 || ed.flag[i] == SatPass::BAD)
                {
                   continue;
                }
-               SatID sat = SPList[ii].getSat();
-               RinexObsData::RinexObsTypeMap rotm;
-               for (ngood = 0, j = 0; j < header.obsTypeList.size(); j++)
+               RinexObsData::RinexObsTypeMap& rotm(robs.obs[ed.sats[i]]);
+               for (j = 0; j < header.obsTypeList.size(); j++)
                {
                   RinexDatum rd;
-
-                  if (SPList[ii].getFlag(jj) != SatPass::BAD &&
-                      SPList[ii].hasType(obstypes[j]))
-                  {
-                     rd.data = SPList[ii].data(jj, obstypes[j]);
-                     ngood++;
-                  }
-                     // else rd is all zeros
-
+                  rd.data = ed.data[j][i];
                   rotm.insert(map<RinexObsType, RinexDatum>::value_type(
                      header.obsTypeList[j], rd));
                }
-               if (ngood > 0)
-               {
-                  robs.obs.insert(
-                     map<SatID, RinexObsData::RinexObsTypeMap>::value_type(
-                        sat, rotm));
-                  robs.numSvs++;
-               }
+               robs.numSvs++;
             }
 
             if (robs.numSvs == 0)
@@ -805,8 +790,8 @@ namespace gnsstk
 
          int i, j, ii, jj, ngood;
          vector<string> obstypes;
-         map<unsigned int, unsigned int> indexMap;
-         map<unsigned int, unsigned int>::const_iterator kt;
+         SatPassIterator::IndexList indexMap;
+         SatPassIterator::IndexList::const_iterator kt;
          Rinex3ObsData robs;
 
             // open file
@@ -875,6 +860,22 @@ namespace gnsstk
          header.valid |= Rinex3ObsHeader::validLastTime;
          header.valid |= Rinex3ObsHeader::validInterval;
 
+            /* find the handle of each obs type written for each pass, once;
+               in R2, obstypes are defined above, a superset of all
+               systems/passes in R3, obstypes are defined per system/pass */
+         vector<vector<int>> passHandles(SPList.size());
+         for (ii = 0; ii < SPList.size(); ii++)
+         {
+            if (header.version >= 3)
+            {
+               obstypes = SPList[ii].getObstypes();
+            }
+            for (j = 0; j < obstypes.size(); j++)
+            {
+               passHandles[ii].push_back(SPList[ii].obsHandle(obstypes[j]));
+            }
+         }
+
          rstrm << header;
 
          while (spit.next(indexMap))
@@ -896,23 +897,17 @@ namespace gnsstk
                   continue;                          // skip bad passes
                }
                RinexSatID sat = SPList[ii].getSat(); // get sat
-
-                  /* in R2, obstypes are defined above, a superset of all
-                     systems/passes in R3, obstypes are defined per system/pass */
-               if (header.version >= 3)
-               {
-                  obstypes = SPList[ii].getObstypes();
-               }
+               const vector<int>& handles(passHandles[ii]);
 
                vector<RinexDatum> vRD;
-               for (ngood = 0, j = 0; j < obstypes.size(); j++)
+               for (ngood = 0, j = 0; j < handles.size(); j++)
                {
                   RinexDatum rd;
 
-                  if (SPList[ii].getFlag(jj) != SatPass::BAD &&
-                      SPList[ii].hasType(obstypes[j]))
+                  int h = handles[j];
+                  if (SPList[ii].getFlag(jj) != SatPass::BAD && h >= 0)
                   {
-                     rd.data = SPList[ii].data(jj, obstypes[j]);
+                     rd.data = SPList[ii].dataColumn(h)[jj];
                         // rd.ssi = ?;
                         // rd.lli = ?;
                      ngood++;
@@ -0,0 +1,197 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file SiteTides.cpp
+    Tide corrections for one site: solid Earth, ocean loading and pole tides,
+    with the site-dependent quantities computed once.
+*/
+
+//------------------------------------------------------------------------------------
+// GNSSTk
+// geomatics
+#include "SiteTides.hpp"
+#include "SolarPosition.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   //---------------------------------------------------------------------------------
+   SiteTides::SiteTides(const Position& site, const IERSConvention& iers,
+                        double emrat, double serat)
+      : tideSite(site, iers), EMRAT(emrat), SERAT(serat), doSolid(true),
+        doOcean(true), doPole(true)
+   {
+   }
+
+   //---------------------------------------------------------------------------------
+   void SiteTides::setOceanLoading(const OceanLoadTides& olt, const string& name,
+                                   const EphTime& t)
+   {
+      try
+      {
+         olt.getHarmonics(name, t, harmonics);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   Triple SiteTides::computeDisplacement(const EphTime& t, const Position& Sun,
+                                         const Position& Moon, double xp,
+                                         double yp) const
+   {
+      try
+      {
+         return displacement(t, Sun, Moon, xp, yp, EMRAT, SERAT, doPole);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   Triple SiteTides::displacement(const EphTime& t, const Position& Sun,
+                                  const Position& Moon, double xp, double yp,
+                                  double emrat, double serat, bool pole) const
+   {
+      try
+      {
+         Triple disp(0.0, 0.0, 0.0), tmp;
+
+         if (doSolid)
+         {
+            disp = computeSolidEarthTides(tideSite, t, Sun, Moon, emrat, serat);
+         }
+
+         if (pole)
+         {
+            tmp = computePolarTides(tideSite, t, xp, yp);
+            for (int i = 0; i < 3; i++)
+               disp[i] += tmp[i];
+         }
+
+         if (doOcean && !harmonics.cosU.empty())
+         {
+               // NEU, rotate to ECEF XYZ using geodetic latitude
+            tmp = OceanLoadTides::computeDisplacement(harmonics, t);
+            for (int i = 0; i < 3; i++)
+               disp[i] += tmp[0] * tideSite.northGD[i] +
+                          tmp[1] * tideSite.eastGD[i] +
+                          tmp[2] * tideSite.upGD[i];
+         }
+
+         return disp;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void SiteTides::computeDisplacements(const vector<EphTime>& times,
+                                        SolarSystem& ss,
+                                        vector<Triple>& disp) const
+   {
+      try
+      {
+         Position Sun, Moon;
+         double xp(0.0), yp(0.0);
+         const double emrat(ss.ratioEarthToMoonMass());
+         const double serat(ss.ratioSunToEarthMass());
+
+         disp.resize(times.size());
+         for (size_t i = 0; i < times.size(); i++)
+         {
+            if (doSolid)
+            {
+               Sun  = ss.solarPosition(times[i]);
+               Moon = ss.lunarPosition(times[i]);
+            }
+            if (doPole)
+            {
+               EphTime ttag(times[i]);
+               ttag.convertSystemTo(TimeSystem::UTC);
+               const EarthOrientation eo = ss.getEOP(ttag.dMJD());
+               xp                        = eo.xp;
+               yp                        = eo.yp;
+            }
+            disp[i] = displacement(times[i], Sun, Moon, xp, yp, emrat, serat,
+                                   doPole);
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void SiteTides::computeDisplacements(const vector<EphTime>& times,
+                                        vector<Triple>& disp) const
+   {
+      try
+      {
+         Position Sun, Moon;
+         double AR;
+
+         disp.resize(times.size());
+         for (size_t i = 0; i < times.size(); i++)
+         {
+            if (doSolid)
+            {
+               Sun  = solarPosition(times[i], AR);
+               Moon = lunarPosition(times[i], AR);
+            }
+            disp[i] = displacement(times[i], Sun, Moon, 0.0, 0.0, EMRAT, SERAT,
+                                   false);
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+} // end namespace gnsstk
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
@@ -0,0 +1,201 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file SiteTides.hpp
+    Tide corrections for one site: solid Earth, ocean loading and pole tides,
+    with the site-dependent quantities computed once.
+*/
+
+#ifndef CLASS_SITETIDES_INCLUDE
+#define CLASS_SITETIDES_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <string>
+#include <vector>
+// GNSSTk
+#include "EphTime.hpp"
+#include "Exception.hpp"
+#include "Position.hpp"
+#include "Triple.hpp"
+// geomatics
+#include "IERSConvention.hpp"
+#include "OceanLoadTides.hpp"
+#include "SolarSystem.hpp"
+#include "SolidEarthTides.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gnsstk
+{
+      /**
+       Tide corrections for a single site. The total displacement of the site
+       due to solid Earth tides (computeSolidEarthTides()), ocean loading
+       (OceanLoadTides) and the pole tide (computePolarTides()) is computed at
+       one time or for a vector of times.
+
+       Everything that depends only on the site is computed once: the site
+       geometry (TideSite) at construction, and the derived ocean tides
+       (OceanLoadTides::Harmonics) by setOceanLoading(). After configuration
+       the object is not changed by any compute function, so one object may be
+       shared by threads that process different satellites at the site; note
+       however that SolarSystem is not thread safe, so the function that uses
+       it must not be called on the same SolarSystem from more than one thread.
+
+       Example:
+       @code
+       SiteTides tides(sitePos);
+       tides.setOceanLoading(oceanStore, "ONSALA", firstTime);
+       vector<Triple> disp;
+       tides.computeDisplacements(times, SolSys, disp);  // ECEF XYZ meters
+       @endcode
+      */
+   class SiteTides
+   {
+   public:
+         /**
+          Constructor. Compute the site-dependent quantities. By default solid
+          Earth and pole tides are included, and ocean loading is included once
+          setOceanLoading() is called.
+          @param site  Nominal position of the site of interest.
+          @param iers  IERS convention to use (default IERS2010)
+          @param EMRAT Earth-to-Moon mass ratio (default to DE405 value)
+          @param SERAT Sun-to-Earth mass ratio (default to DE405 value)
+         */
+      explicit SiteTides(const Position& site,
+                         const IERSConvention& iers = IERSConvention::IERS2010,
+                         double EMRAT = 81.30056,
+                         double SERAT = 332946.050894783285912);
+
+         /**
+          Include ocean loading, computing the derived tides for the given site
+          name once, cf. OceanLoadTides::getHarmonics().
+          @param olt   OceanLoadTides that has been initialized with the site.
+          @param name  Name of the site in olt.
+          @param t     Reference time for the derived tides, e.g. the first
+                       epoch of the data.
+          @throw Exception if the site has not been initialized in olt.
+         */
+      void setOceanLoading(const OceanLoadTides& olt, const std::string& name,
+                           const EphTime& t);
+
+         /**
+          Choose which tides are included in the displacement.
+          @param solid  include solid Earth tides
+          @param ocean  include ocean loading (ignored unless setOceanLoading()
+                        has been called)
+          @param pole   include the pole tide
+         */
+      void setTides(bool solid, bool ocean, bool pole)
+      {
+         doSolid = solid;
+         doOcean = ocean;
+         doPole  = pole;
+      }
+
+         /// @return the site-dependent quantities
+      const TideSite& getTideSite() const { return tideSite; }
+
+         /// @return the derived ocean tides; empty if ocean loading was not set
+      const OceanLoadTides::Harmonics& getHarmonics() const { return harmonics; }
+
+         /**
+          Compute the site displacement at one time, given the positions of Sun
+          and Moon and the polar motion angles at that time.
+          @param t     Time of interest.
+          @param Sun   Position of the Sun at t (used if solid tides are included)
+          @param Moon  Position of the Moon at t (used if solid tides are included)
+          @param xp,yp Polar motion angles in arcsec at t (used if the pole tide
+                       is included)
+          @return Displacement vector, ECEF XYZ in meters.
+          @throw Exception
+         */
+      Triple computeDisplacement(const EphTime& t, const Position& Sun,
+                                 const Position& Moon, double xp,
+                                 double yp) const;
+
+         /**
+          Compute the site displacement at each of a vector of times, taking the
+          positions of Sun and Moon, the mass ratios and the polar motion angles
+          from the SolarSystem, as SolarSystem::computeSolidEarthTides() and
+          SolarSystem::computePolarTides() do.
+          @param times  Times of interest.
+          @param ss     SolarSystem with ephemeris and EOPs covering the times.
+          @param disp   Output displacement vectors, ECEF XYZ in meters,
+                        parallel to times.
+          @throw Exception
+         */
+      void computeDisplacements(const std::vector<EphTime>& times,
+                                SolarSystem& ss,
+                                std::vector<Triple>& disp) const;
+
+         /**
+          Compute the site displacement at each of a vector of times, using the
+          low precision positions of Sun and Moon (solarPosition() and
+          lunarPosition() in SolarPosition.hpp). Without EOPs the pole tide is
+          not included.
+          @param times  Times of interest.
+          @param disp   Output displacement vectors, ECEF XYZ in meters,
+                        parallel to times.
+          @throw Exception
+         */
+      void computeDisplacements(const std::vector<EphTime>& times,
+                                std::vector<Triple>& disp) const;
+
+   private:
+         /// compute the displacement at t, given everything that depends on t
+      Triple displacement(const EphTime& t, const Position& Sun,
+                          const Position& Moon, double xp, double yp,
+                          double emrat, double serat, bool pole) const;
+
+         /// site-dependent quantities for solid Earth and pole tides
+      TideSite tideSite;
+
+         /// derived ocean tides for the site
+      OceanLoadTides::Harmonics harmonics;
+
+         /// Earth-to-Moon and Sun-to-Earth mass ratios
+      double EMRAT, SERAT;
+
+         /// which tides to include
+      bool doSolid, doOcean, doPole;
+
+   }; // end class SiteTides
+
+} // end namespace gnsstk
+
+#endif // nothing below this
@@ -49,6 +49,14 @@
 
 //------------------------------------------------------------------------------------
 #include "SolarSystemEphemeris.hpp"
+// system
+#include <cmath>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 // GNSSTk
 #include "FormattedDouble.hpp"
 #include "StringUtils.hpp"
@@ -82,6 +90,55 @@ namespace gnsstk
       }
    };
 
+   //---------------------------------------------------------------------------------
+      /// The memory-mapped binary file (or its data records, without mmap).
+   struct SolarSystemEphemeris::MappedFile
+   {
+      MappedFile() : base(nullptr), length(0) {}
+      ~MappedFile()
+      {
+#ifndef _WIN32
+         if (base)
+         {
+            ::munmap(base, length);
+         }
+#endif
+      }
+      void *base;                 ///< start of the mapping
+      size_t length;              ///< length of the mapping in bytes
+      std::vector<double> buffer; ///< data records where mmap is unavailable
+   };
+
+   //---------------------------------------------------------------------------------
+      /// Throw the Exception that corresponds to a failed record lookup.
+   static void throwLookupError(int iret)
+   {
+      if (iret == SolarSystemEphemeris::retEarly ||
+          iret == SolarSystemEphemeris::retLate)
+      {
+         Exception e(string("Requested time is ") +
+                     (iret == SolarSystemEphemeris::retEarly ? string("before")
+                                                             : string("after")) +
+                     string(" the range spanned by the ephemeris."));
+         GNSSTK_THROW(e);
+      }
+      else if (iret == SolarSystemEphemeris::retStrm)
+      {
+         Exception e(string("Stream error on ephemeris binary file"));
+         GNSSTK_THROW(e);
+      }
+      else if (iret == SolarSystemEphemeris::retEphN)
+      {
+         Exception e(string("Ephemeris not initialized"));
+         GNSSTK_THROW(e);
+      }
+      else
+      {
+         Exception e(string("Unknown error on ephemeris binary file"));
+         GNSSTK_THROW(e);
+      }
+   }
+
    //---------------------------------------------------------------------------------
    void SolarSystemEphemeris::readASCIIheader(const string& filename)
    {
@@ -99,8 +156,11 @@ namespace gnsstk
             GNSSTK_THROW(e);
          }
 
-            // clear existing data
+            // clear existing data, including any mapped file
          constants.clear();
+         mapping.reset();
+         mapData = nullptr;
+         mapNrec = 0;
 
             /* read the file one line at a time, process depending on the value of
                group */
@@ -275,6 +335,8 @@ namespace gnsstk
 
             // EphemerisNumber != -1 means the header is complete
          EphemerisNumber = int(constants["DENUM"]);
+         auKm            = constants["AU"];
+         emRatio         = constants["EMRAT"];
 
             // clear the data arrays
          store.clear();
@@ -912,172 +974,193 @@ namespace gnsstk
    }
 
    //---------------------------------------------------------------------------------
-      // get an inertial position of one body relative to another.
-   void SolarSystemEphemeris::relativeInertialPositionVelocity(
-               double MJD, SolarSystemEphemeris::Planet target,
-               SolarSystemEphemeris::Planet center, double pv[6], bool kilometers)
+   int SolarSystemEphemeris::initializeWithMappedFile(const string& filename)
    {
       try
       {
-         int iret, i;
+            // read the header, which also releases any existing mapping
+         readBinaryHeader(filename);
+         if (EphemerisNumber == -1)
+         {
+            istrm.close();
+            return retEphN;
+         }
 
-            // initialize
-         for (i = 0; i < 6; i++)
-            pv[i] = 0.0;
+            // data records follow the two header records
+         long dataOffset = istrm.tellg();
+         istrm.clear();
+         istrm.close();
+         if (dataOffset <= 0)
+         {
+            Exception e("Failed to locate data records in " + filename);
+            GNSSTK_THROW(e);
+         }
 
-            // trivial; return
-         if (target == center)
+            // the format is native binary; a file written with the other byte
+            // order shows up as nonsense in the record length or interval
+         if (Ncoeff <= 2 || !(interval > 0.0 && interval < 1.e4))
          {
-            return;
+            Exception e("Invalid header in binary file " + filename
+                        + "; it may have been written with a different"
+                          " byte order");
+            GNSSTK_THROW(e);
          }
 
-            // get the right record from the file
-         double JD(MJD + MJD_TO_JD);
-         iret = seekToJD(JD);
-            /* -1 out of range : input time is before the first time in file
-               -2 out of range : input time is after the last time in file, or in gap
-               -3 stream is not open or not good, or EOF was found prematurely
-               -4 EphemerisNumber is not defined */
-         if (iret)
+         shared_ptr<MappedFile> mf(new MappedFile());
+         size_t recSize = size_t(Ncoeff) * sizeof(double), nrec = 0;
+         const double *data = nullptr;
+#ifndef _WIN32
+            // the records are used in place, so they must be aligned as doubles
+         if (dataOffset % long(alignof(double)) == 0)
          {
-            if (iret == retEarly || iret == retLate)
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
             {
-               Exception e(string("Requested time is ") +
-                           (iret == retEarly ? string("before") : string("after")) +
-                           string(" the range spanned by the ephemeris."));
+               Exception e("Failed to open input binary file " + filename);
                GNSSTK_THROW(e);
             }
-            else if (iret == retStrm)
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size <= dataOffset)
             {
-               Exception e(string("Stream error on ephemeris binary file"));
+               ::close(fd);
+               Exception e("No data records in binary file " + filename);
                GNSSTK_THROW(e);
             }
-            else if (iret == retEphN)
+            void *base = ::mmap(nullptr, size_t(st.st_size), PROT_READ,
+                                MAP_SHARED, fd, 0);
+            ::close(fd); // the mapping keeps its own reference to the file
+            if (base == MAP_FAILED)
             {
-               Exception e(string("Ephemeris not initialized"));
+               Exception e("Failed to memory-map binary file " + filename);
                GNSSTK_THROW(e);
             }
-            else
+            mf->base   = base;
+            mf->length = size_t(st.st_size);
+            nrec       = (mf->length - size_t(dataOffset)) / recSize;
+            data       = reinterpret_cast<const double *>(
+               static_cast<const char *>(base) + dataOffset);
+         }
+#endif
+         if (data == nullptr)
+         {
+               // no mmap, or unaligned records; read the data records into
+               // memory instead
+            ifstream strm(filename.c_str(), ios::in | ios::binary);
+            strm.seekg(0, ios_base::end);
+            long length = strm.tellg();
+            if (!strm.good() || length <= dataOffset)
             {
-               Exception e(string("Unknown error on ephemeris binary file"));
+               Exception e("No data records in binary file " + filename);
                GNSSTK_THROW(e);
             }
+            nrec = size_t(length - dataOffset) / recSize;
+            if (nrec > 0)
+            {
+               mf->buffer.resize(nrec * Ncoeff);
+               strm.seekg(dataOffset, ios_base::beg);
+               strm.read((char *)&mf->buffer[0], nrec * recSize);
+               if (!strm.good())
+               {
+                  Exception e("Stream error reading binary file " + filename);
+                  GNSSTK_THROW(e);
+               }
+               data = &mf->buffer[0];
+            }
          }
-
-            // compute Nutations or Librations
-         if (target == idNutations || target == idLibrations)
-         {
-            inertialPositionVelocity(
-               MJD, target == idNutations ? NUTATIONS : LIBRATIONS, pv);
-            return;
-         }
-
-            // define computeID's for target and center
-         computeID TARGET, CENTER;
-
-         if (target <= idSun)
-         {
-            TARGET = computeID(target - 1);
-         }
-         else if (target == idSolarSystemBarycenter)
-         {
-            TARGET = NONE;
-         }
-         else if (target == idEarthMoonBarycenter)
-         {
-            TARGET = EMBARY;
-         }
-            // (Nutations and Librations are done above)
-         if (center <= idSun)
-         {
-            CENTER = computeID(center - 1);
-         }
-         else if (center == idSolarSystemBarycenter)
-         {
-            CENTER = NONE;
-         }
-         else if (center == idEarthMoonBarycenter)
-         {
-            CENTER = EMBARY;
-         }
-
-            /* Earth and Moon need special treatment - get moon and Earth-moon
-               barycenter */
-         double pvmoon[6], pvembary[6], Eratio, Mratio;
-
-            // special cases of Earth AND Moon: Moon result is always geocentric
-         if (target == idEarth && center == idMoon)
-         {
-            TARGET = NONE;
-         }
-         if (center == idEarth && target == idMoon)
-         {
-            CENTER = NONE;
-         }
-
-            // special cases of Earth OR Moon, but not both:
-         if ((target == idEarth && center != idMoon) ||
-             (center == idEarth && target != idMoon))
-         {
-            Eratio = 1.0 / (1.0 + constants["EMRAT"]);
-            inertialPositionVelocity(MJD, MOON, pvmoon);
-         }
-         if ((target == idMoon && center != idEarth) ||
-             (center == idMoon && target != idEarth))
+         if (nrec == 0)
          {
-            Mratio = constants["EMRAT"] / (1.0 + constants["EMRAT"]);
-            inertialPositionVelocity(MJD, EMBARY, pvembary);
+            Exception e("No data records in binary file " + filename);
+            GNSSTK_THROW(e);
          }
 
-            // compute states for target and center
-         double pvtarget[6], pvcenter[6];
-         inertialPositionVelocity(MJD, TARGET, pvtarget);
-         inertialPositionVelocity(MJD, CENTER, pvcenter);
-
-            /* handle the Earth/Moon special cases
-               convert from E-M barycenter to Earth */
-         if (target == idEarth && center != idMoon)
+            // records must be contiguous and of equal length to be indexed
+         for (size_t n = 0; n < nrec; n++)
          {
-            for (i = 0; i < 6; i++)
+            const double *rec = data + n * Ncoeff;
+            if (n > 0 && rec[0] != rec[1 - Ncoeff])
             {
-               pvtarget[i] -= pvmoon[i] * Eratio;
+               ostringstream oss;
+               oss << "ERROR: found gap in data at " << n + 1 << fixed
+                   << setprecision(6) << " : prev end = " << rec[1 - Ncoeff]
+                   << " != new beg = " << rec[0];
+               Exception e(oss.str());
+               GNSSTK_THROW(e);
             }
-         }
-         if (center == idEarth && target != idMoon)
-         {
-            for (i = 0; i < 6; i++)
+            if (::fabs(rec[1] - rec[0] - interval) > 1.e-8)
             {
-               pvcenter[i] -= pvmoon[i] * Eratio;
+               ostringstream oss;
+               oss << "ERROR: record " << n + 1 << fixed << setprecision(6)
+                   << " spans " << rec[1] - rec[0] << " days, not the interval "
+                   << interval;
+               Exception e(oss.str());
+               GNSSTK_THROW(e);
             }
          }
 
-         if (target == idMoon && center != idEarth)
-         {
-            for (i = 0; i < 6; i++)
-            {
-               pvtarget[i] = pvembary[i] + pvtarget[i] * Mratio;
-            }
-         }
-         if (center == idMoon && target != idEarth)
+         mapping = mf;
+         mapData = data;
+         mapNrec = nrec;
+         mapGeneration++;
+         mapCursor.reset();
+         fileposMap.clear();
+         coefficients.clear();
+
+         EphemerisNumber = int(constants["DENUM"]);
+         LOG(DEBUG) << "initializeWithMappedFile maps " << nrec
+                    << " records, sets EphemerisNumber " << EphemerisNumber;
+
+         return 0;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // get an inertial position of one body relative to another.
+   void SolarSystemEphemeris::relativeInertialPositionVelocity(
+               double MJD, SolarSystemEphemeris::Planet target,
+               SolarSystemEphemeris::Planet center, double pv[6], bool kilometers)
+   {
+      try
+      {
+            // a mapped file needs no seeking
+         if (mapData)
          {
-            for (i = 0; i < 6; i++)
-            {
-               pvcenter[i] = pvembary[i] + pvcenter[i] * Mratio;
-            }
+            relativeInertialPositionVelocity(MJD, target, center, pv, mapCursor,
+                                             kilometers);
+            return;
          }
 
-            // final relative result
-         for (i = 0; i < 6; i++)
+         for (int i = 0; i < 6; i++)
+            pv[i] = 0.0;
+
+            // trivial; return
+         if (target == center)
          {
-            pv[i] = pvtarget[i] - pvcenter[i];
+            return;
          }
 
-         if (!kilometers)
+            // get the right record from the file
+         int iret = seekToJD(MJD + MJD_TO_JD);
+         if (iret)
          {
-            double AU = constants["AU"];
-            for (i = 0; i < 6; i++)
-               pv[i] /= AU;
+            throwLookupError(iret);
          }
+
+         relativeFromRecord(&coefficients[0], MJD, target, center, pv,
+                            kilometers);
       }
       catch (Exception& e)
       {
@@ -1095,6 +1178,78 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+   void SolarSystemEphemeris::relativeInertialPositionVelocity(
+      double MJD, SolarSystemEphemeris::Planet target,
+      SolarSystemEphemeris::Planet center, double pv[6], RecordCursor& cursor,
+      bool kilometers) const
+   {
+      for (int i = 0; i < 6; i++)
+         pv[i] = 0.0;
+
+      if (target == center)
+      {
+         return;
+      }
+
+      int iret = findMappedRecord(MJD + MJD_TO_JD, cursor);
+      if (iret)
+      {
+         throwLookupError(iret);
+      }
+
+      relativeFromRecord(cursor.record, MJD, target, center, pv, kilometers);
+   }
+
+   //---------------------------------------------------------------------------------
+   void SolarSystemEphemeris::relativeInertialPositionVelocity(
+      const vector<double>& MJDs, SolarSystemEphemeris::Planet target,
+      SolarSystemEphemeris::Planet center, vector<double>& PV,
+      bool kilometers) const
+   {
+      PV.resize(6 * MJDs.size());
+      RecordCursor cursor;
+      for (size_t n = 0; n < MJDs.size(); n++)
+      {
+         relativeInertialPositionVelocity(MJDs[n], target, center, &PV[6 * n],
+                                          cursor, kilometers);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void SolarSystemEphemeris::geocentricSunMoon(const vector<double>& MJDs,
+                                                vector<double>& sunPV,
+                                                vector<double>& moonPV,
+                                                bool kilometers) const
+   {
+      sunPV.resize(6 * MJDs.size());
+      moonPV.resize(6 * MJDs.size());
+
+      const double Eratio = 1.0 / (1.0 + emRatio);
+      const double scale  = (kilometers ? 1.0 : 1.0 / auKm);
+      double pvembary[6];
+      RecordCursor cursor;
+      for (size_t n = 0; n < MJDs.size(); n++)
+      {
+         int iret = findMappedRecord(MJDs[n] + MJD_TO_JD, cursor);
+         if (iret)
+         {
+            throwLookupError(iret);
+         }
+
+            // the Moon is geocentric; the Earth is E-M barycenter - Moon*Eratio
+         double *sun = &sunPV[6 * n], *moon = &moonPV[6 * n];
+         inertialPositionVelocity(cursor.record, MJDs[n], EMBARY, pvembary);
+         inertialPositionVelocity(cursor.record, MJDs[n], MOON, moon);
+         inertialPositionVelocity(cursor.record, MJDs[n], SUN, sun);
+         for (int i = 0; i < 6; i++)
+         {
+            sun[i] = (sun[i] - (pvembary[i] - moon[i] * Eratio)) * scale;
+            moon[i] *= scale;
+         }
+      }
+   }
+
    //---------------------------------------------------------------------------------
    //---------------------------------------------------------------------------------
       // private
@@ -1179,6 +1334,9 @@ namespace gnsstk
          EphemerisNumber = -1;
          constants.clear();
          store.clear();
+         mapping.reset();
+         mapData   = nullptr;
+         mapNrec   = 0;
          recLength = 0;
 
             /* ----------------------------------------------------------------
@@ -1294,6 +1452,8 @@ namespace gnsstk
          {
             readBinary(buffer, 1);
          }
+         auKm    = constants["AU"];
+         emRatio = constants["EMRAT"];
 
             // ----------------------------------------------------------------
             // test the header
@@ -1560,97 +1720,253 @@ namespace gnsstk
 
    //---------------------------------------------------------------------------------
       // private
-   void SolarSystemEphemeris::inertialPositionVelocity(
-      double MJD, SolarSystemEphemeris::computeID which, double PV[6])
+   void SolarSystemEphemeris::relativeFromRecord(
+      const double *record, double MJD, SolarSystemEphemeris::Planet target,
+      SolarSystemEphemeris::Planet center, double pv[6], bool kilometers) const
    {
-      try
+      int i;
+
+         // compute Nutations or Librations
+      if (target == idNutations || target == idLibrations)
+      {
+         inertialPositionVelocity(
+            record, MJD, target == idNutations ? NUTATIONS : LIBRATIONS, pv);
+         return;
+      }
+
+         // define computeID's for target and center
+      computeID TARGET, CENTER;
+
+      if (target <= idSun)
+      {
+         TARGET = computeID(target - 1);
+      }
+      else if (target == idSolarSystemBarycenter)
+      {
+         TARGET = NONE;
+      }
+      else if (target == idEarthMoonBarycenter)
+      {
+         TARGET = EMBARY;
+      }
+         // (Nutations and Librations are done above)
+      if (center <= idSun)
+      {
+         CENTER = computeID(center - 1);
+      }
+      else if (center == idSolarSystemBarycenter)
+      {
+         CENTER = NONE;
+      }
+      else if (center == idEarthMoonBarycenter)
       {
-         int i, j, i0, ncomp, offset;
+         CENTER = EMBARY;
+      }
+
+         /* Earth and Moon need special treatment - get moon and Earth-moon
+            barycenter */
+      double pvmoon[6], pvembary[6], Eratio, Mratio;
 
+         // special cases of Earth AND Moon: Moon result is always geocentric
+      if (target == idEarth && center == idMoon)
+      {
+         TARGET = NONE;
+      }
+      if (center == idEarth && target == idMoon)
+      {
+         CENTER = NONE;
+      }
+
+         // special cases of Earth OR Moon, but not both:
+      if ((target == idEarth && center != idMoon) ||
+          (center == idEarth && target != idMoon))
+      {
+         Eratio = 1.0 / (1.0 + emRatio);
+         inertialPositionVelocity(record, MJD, MOON, pvmoon);
+      }
+      if ((target == idMoon && center != idEarth) ||
+          (center == idMoon && target != idEarth))
+      {
+         Mratio = emRatio / (1.0 + emRatio);
+         inertialPositionVelocity(record, MJD, EMBARY, pvembary);
+      }
+
+         // compute states for target and center
+      double pvtarget[6], pvcenter[6];
+      inertialPositionVelocity(record, MJD, TARGET, pvtarget);
+      inertialPositionVelocity(record, MJD, CENTER, pvcenter);
+
+         /* handle the Earth/Moon special cases
+            convert from E-M barycenter to Earth */
+      if (target == idEarth && center != idMoon)
+      {
          for (i = 0; i < 6; i++)
          {
-            PV[i] = 0.0;
+            pvtarget[i] -= pvmoon[i] * Eratio;
          }
-         if (which == NONE)
+      }
+      if (center == idEarth && target != idMoon)
+      {
+         for (i = 0; i < 6; i++)
          {
-            return;
+            pvcenter[i] -= pvmoon[i] * Eratio;
          }
+      }
 
-            /* coefficients[0,1] give span of JD's in which coefficients[2,...] are
-               applicable coefficients[0,1] are even days JDs - 2452xxx.5 =>
-               secOfDay() for these == 0. */
-         double T, Tbeg, Tspan, Tspan0;
-         Tbeg   = coefficients[0];
-         Tspan0 = Tspan = coefficients[1] - coefficients[0];
-         i0    = c_offset[which] - 1; // index of first coefficient in array
-         ncomp = (which == NUTATIONS ? 2 : 3); // number of components returned
-
-            // if more than one set, find the right set
-         if (c_nsets[which] > 1)
+      if (target == idMoon && center != idEarth)
+      {
+         for (i = 0; i < 6; i++)
          {
-            Tspan /= double(c_nsets[which]);
-            for (j = c_nsets[which]; j > 0; j--)
-            {
-               Tbeg = coefficients[0] + double(j - 1) * Tspan;
-               if (MJD > Tbeg - MJD_TO_JD)
-               { // == with j==1 is the default
-                  i0 += (j - 1) * ncomp * c_ncoeff[which];
-                  break;
-               }
-            }
+            pvtarget[i] = pvembary[i] + pvtarget[i] * Mratio;
          }
+      }
+      if (center == idMoon && target != idEarth)
+      {
+         for (i = 0; i < 6; i++)
+         {
+            pvcenter[i] = pvembary[i] + pvcenter[i] * Mratio;
+         }
+      }
 
-            // normalized time
-         T = 2.0 * (MJD - (Tbeg - MJD_TO_JD)) / Tspan - 1.0;
+         // final relative result
+      for (i = 0; i < 6; i++)
+      {
+         pv[i] = pvtarget[i] - pvcenter[i];
+      }
 
-            // interpolate
-         int N = c_ncoeff[which];
-         vector<double> C(N, 0.0); // Chebyshev
-         vector<double> U(N, 0.0); // derivative of Chebyshev
-         for (i = 0; i < ncomp; i++)
-         { // loop over components
+      if (!kilometers)
+      {
+         for (i = 0; i < 6; i++)
+            pv[i] /= auKm;
+      }
+   }
 
-               // seed the Chebyshev recursions
-            C[0] = 1;
-            C[1] = T; // C[2] = 2*T*T-1;
-            U[0] = 0;
-            U[1] = 1; // U[2] = 4*T;
+   //---------------------------------------------------------------------------------
+      /* private
+         return 0 ok, or
+         -1 out of range : input time is before the first mapped record
+         -2 out of range : input time is after the last mapped record
+         -4 no file is mapped */
+   int SolarSystemEphemeris::findMappedRecord(double JD,
+                                              RecordCursor& cursor) const
+   {
+      if (!mapData)
+      {
+         return retEphN;
+      }
 
-               // generate the Chebyshevs
-            for (j = 2; j < N; j++)
-            {
-               C[j] = 2 * T * C[j - 1] - C[j - 2];
-               U[j] = 2 * T * U[j - 1] + 2 * C[j - 1] - U[j - 2];
-            }
+         // the cursor's record is good unless it came from another mapping
+      if (cursor.owner == this && cursor.generation == mapGeneration &&
+          cursor.record && cursor.record[0] <= JD && JD <= cursor.record[1])
+      {
+         return 0;
+      }
 
-               // compute P and V
-               // done above PV[i] = PV[i+3] = 0.0;
-            for (j = N - 1; j > -1; j--) // POS
-            {
-               PV[i] += coefficients[i0 + j + i * N] * C[j];
-            }
-            for (j = N - 1; j > 0; j--) // j>0 b/c U[0]=0             // VEL
-            {
-               PV[i + ncomp] += coefficients[i0 + j + i * N] * U[j];
-            }
+         // records are contiguous and of equal length, so index directly
+      if (JD < mapData[0])
+      {
+         return retEarly;
+      }
+      size_t n = size_t((JD - mapData[0]) / interval);
+      if (n >= mapNrec)
+      {
+         n = mapNrec - 1;
+      }
+      const double *rec = mapData + n * Ncoeff;
 
-               // convert velocity to 'per day'
-            PV[i + ncomp] *= 2 * double(c_nsets[which]) / Tspan0;
-         }
+         // allow for rounding in the index
+      if (JD < rec[0] && n > 0)
+      {
+         rec -= Ncoeff;
       }
-      catch (Exception& e)
+      else if (JD > rec[1] && n + 1 < mapNrec)
       {
-         GNSSTK_RETHROW(e);
+         rec += Ncoeff;
       }
-      catch (exception& e)
+      if (JD > rec[1])
       {
-         Exception E("std except: " + string(e.what()));
-         GNSSTK_THROW(E);
+         return retLate;
       }
-      catch (...)
+
+      cursor.owner      = this;
+      cursor.generation = mapGeneration;
+      cursor.record     = rec;
+      return 0;
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   void SolarSystemEphemeris::inertialPositionVelocity(
+      const double *record, double MJD, SolarSystemEphemeris::computeID which,
+      double PV[6]) const
+   {
+      int i, j;
+
+      for (i = 0; i < 6; i++)
       {
-         Exception e("Unknown exception");
-         GNSSTK_THROW(e);
+         PV[i] = 0.0;
+      }
+      if (which == NONE)
+      {
+         return;
+      }
+
+         /* record[0,1] give span of JD's in which record[2,...] are applicable
+            record[0,1] are even days JDs - 2452xxx.5 => secOfDay() for these
+            == 0. */
+      const int N      = c_ncoeff[which];
+      const int nsets  = c_nsets[which];
+      const int ncomp  = (which == NUTATIONS ? 2 : 3); // number of components
+      const double Tspan0 = record[1] - record[0];
+      double Tspan = Tspan0, Tbeg = record[0] - MJD_TO_JD;
+      int i0 = c_offset[which] - 1; // index of first coefficient in array
+
+         // if more than one set, find the right set
+      if (nsets > 1)
+      {
+         Tspan /= double(nsets);
+         j = int((MJD - Tbeg) / Tspan);
+         j = (j < 0 ? 0 : (j >= nsets ? nsets - 1 : j));
+         Tbeg += double(j) * Tspan;
+         i0 += j * ncomp * N;
+      }
+
+         // normalized time
+      const double T = 2.0 * (MJD - Tbeg) / Tspan - 1.0;
+      const double *coef = record + i0;
+
+         /* generate the Chebyshevs C and their derivatives U once, and
+            accumulate all components as they are generated */
+      double C0 = 1.0, C1 = T, U0 = 0.0, U1 = 1.0, C2, U2;
+      for (i = 0; i < ncomp; i++)
+      {
+         PV[i] = coef[i * N];
+         if (N > 1)
+         {
+            PV[i] += coef[i * N + 1] * T;
+            PV[i + ncomp] = coef[i * N + 1];
+         }
+      }
+      for (j = 2; j < N; j++)
+      {
+         C2 = 2 * T * C1 - C0;
+         U2 = 2 * T * U1 + 2 * C1 - U0;
+         for (i = 0; i < ncomp; i++)
+         {
+            PV[i] += coef[i * N + j] * C2;
+            PV[i + ncomp] += coef[i * N + j] * U2;
+         }
+         C0 = C1;
+         C1 = C2;
+         U0 = U1;
+         U1 = U2;
+      }
+
+         // convert velocity to 'per day'
+      const double vscale = 2 * double(nsets) / Tspan0;
+      for (i = 0; i < ncomp; i++)
+      {
+         PV[i + ncomp] *= vscale;
       }
    }
 
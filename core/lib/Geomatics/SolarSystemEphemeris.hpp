@@ -56,6 +56,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 // GNSSTk
@@ -92,6 +93,14 @@ namespace gnsstk
        binary file, then calling relativeInertialPositionVelocity() any number
        of times, passing it the time and Planet of interest. Time for this class
        is always Barycentric Dynamic Time (TDB), always as MJD.
+
+       Alternatively call initializeWithMappedFile(file), which memory-maps the
+       binary file and evaluates the Chebyshev coefficients directly from the
+       mapped records, with no seeking or copying. In this mode the const
+       versions of relativeInertialPositionVelocity(), which take a
+       RecordCursor holding the caller's current record, may be called from
+       any number of threads at once, and the batch routines evaluate whole
+       epoch grids (e.g. geocentricSunMoon() for tides and attitude models).
       */
    class SolarSystemEphemeris
    {
@@ -129,11 +138,35 @@ namespace gnsstk
          idLibrations             ///< 15 Lunar Librations (3 euler angles)
       };
 
+         /**
+          Current-record state for one caller of the const (mapped file)
+          versions of relativeInertialPositionVelocity(). Each thread should
+          own its own cursor; consecutive times within the same record then
+          require no search at all.
+         */
+      class RecordCursor
+      {
+      public:
+         RecordCursor() : owner(nullptr), generation(0), record(nullptr) {}
+
+            /// Forget the current record.
+         void reset() { record = nullptr; }
+
+      private:
+         friend class SolarSystemEphemeris;
+         const SolarSystemEphemeris *owner; ///< ephemeris that set record
+         unsigned long generation;          ///< mapping that set record
+         const double *record;              ///< current record, or null
+      };
+
          /**
           Constructor. Set EphemerisNumber to -1 to indicate that nothing has
           been read yet.
          */
-      SolarSystemEphemeris() : EphemerisNumber(-1){};
+      SolarSystemEphemeris()
+            : EphemerisNumber(-1), mapData(nullptr), mapNrec(0),
+              mapGeneration(0), auKm(0.0), emRatio(0.0)
+      {}
 
       //------------------------------------------------------------------
       // reading and writing ASCII (JPL) files
@@ -240,6 +273,28 @@ namespace gnsstk
          */
       int initializeWithBinaryFile(const std::string& filename);
 
+         /**
+          Open the given binary file, read the header and memory-map the data
+          records, for use by relativeInertialPositionVelocity() and the batch
+          routines. The records must be contiguous and of equal length
+          (interval), as written by writeBinaryFile(); the record containing a
+          given time is then found by indexing rather than searching.
+          Like initializeWithBinaryFile(), the file must have been written
+          with the byte order of this platform. Data records that do not
+          start on a double boundary, and all records on non-POSIX
+          platforms, are read into memory instead of being mapped.
+          @param filename  name of binary file to be mapped.
+          @return 0 success,
+                 -4 header could not be read or is inconsistent.
+          @throw Exception if the file cannot be opened or mapped, has a header
+                     inconsistent with this byte order, contains no data
+                     records, or has gaps or unequal records.
+         */
+      int initializeWithMappedFile(const std::string& filename);
+
+         /// Return true if initializeWithMappedFile() has succeeded.
+      bool isMapped() const { return (mapData != nullptr); }
+
       //------------------------------------------------------------------
       // utilizing the ephemeris
 
@@ -280,6 +335,58 @@ namespace gnsstk
                                             Planet center, double PV[6],
                                             bool kilometers = true);
 
+         /**
+          Thread-safe version of relativeInertialPositionVelocity() for use
+          after initializeWithMappedFile(). The record containing MJD is taken
+          from cursor if possible, and cursor is updated otherwise.
+          @param  MJD   time (Modified Julian Date) of interest, in TDB system.
+          @param target Body for which position and velocity are computed.
+          @param center Body relative to which the results apply.
+          @param PV     output position and velocity, as above.
+          @param cursor current record of the calling thread.
+          @param kilometers  if true (default) km, km/day; else AU, AU/day.
+          @throw Exception if the file is not mapped, or the time is not
+                     covered by the ephemeris.
+         */
+      void relativeInertialPositionVelocity(double MJD, Planet target,
+                                            Planet center, double PV[6],
+                                            RecordCursor& cursor,
+                                            bool kilometers = true) const;
+
+         /**
+          Batch version of relativeInertialPositionVelocity() for use after
+          initializeWithMappedFile(); MJDs are best given in time order.
+          @param MJDs   times (Modified Julian Date, TDB) of interest.
+          @param target Body for which position and velocity are computed.
+          @param center Body relative to which the results apply.
+          @param PV     output, resized to 6*MJDs.size(); six components
+                           (as above) for each time in turn.
+          @param kilometers  if true (default) km, km/day; else AU, AU/day.
+          @throw Exception if the file is not mapped, or any time is not
+                     covered by the ephemeris.
+         */
+      void relativeInertialPositionVelocity(const std::vector<double>& MJDs,
+                                            Planet target, Planet center,
+                                            std::vector<double>& PV,
+                                            bool kilometers = true) const;
+
+         /**
+          Compute geocentric positions and velocities of both the Sun and the
+          Moon over a grid of times, using one record lookup and one
+          evaluation of the Moon per time. For use after
+          initializeWithMappedFile().
+          @param MJDs   times (Modified Julian Date, TDB) of interest.
+          @param sunPV  output, resized to 6*MJDs.size(), Sun relative to Earth
+          @param moonPV output, resized to 6*MJDs.size(), Moon relative to Earth
+          @param kilometers  if true (default) km, km/day; else AU, AU/day.
+          @throw Exception if the file is not mapped, or any time is not
+                     covered by the ephemeris.
+         */
+      void geocentricSunMoon(const std::vector<double>& MJDs,
+                             std::vector<double>& sunPV,
+                             std::vector<double>& moonPV,
+                             bool kilometers = true) const;
+
          /**
           Return the value of 1 AU (Astronomical Unit) in km. If the file header
           has not been read, return -1.0.
@@ -431,20 +538,41 @@ namespace gnsstk
 
          /**
           Compute inertial position and velocity of given body at given time,
-          relative to the solar system barycenter, using the current coefficient
-          array. NB caller MUST call seekToJD(time) BEFORE calling this. On
-          successful return, PV[0-2] contains the three position components, in
-          km, and PV[3-5] the velocity components in km/day (for regular
-          bodies), relative to the solar system barycenter, except for the moon,
-          which is relative to Earth. For nutations and librations the units are
-          radians and radians/day; nutations (components 0-3 only) are longitude
-          and obliquity, and librations are the three euler angles.
+          relative to the solar system barycenter, using the given coefficient
+          record, which must contain the time (cf. seekToJD() and
+          findMappedRecord()). On successful return, PV[0-2] contains the three
+          position components, in km, and PV[3-5] the velocity components in
+          km/day (for regular bodies), relative to the solar system barycenter,
+          except for the moon, which is relative to Earth. For nutations and
+          librations the units are radians and radians/day; nutations
+          (components 0-3 only) are longitude and obliquity, and librations are
+          the three euler angles.
+          @param  record one complete data record (Ncoeff doubles).
           @param  MJD    time (Modified Julian Date) of interest (system TDB).
           @param  which  computeID of the body of interest.
           @param  PV     double(6) array containing the inertial position and
                            velocity relative to the solar system barycenter.
          */
-      void inertialPositionVelocity(double MJD, computeID which, double PV[6]);
+      void inertialPositionVelocity(const double *record, double MJD,
+                                    computeID which, double PV[6]) const;
+
+         /**
+          Combine the inertial states computed from one record into the state
+          of target relative to center; cf. relativeInertialPositionVelocity().
+         */
+      void relativeFromRecord(const double *record, double MJD, Planet target,
+                              Planet center, double PV[6],
+                              bool kilometers) const;
+
+         /**
+          Find the mapped record containing the given time, trying the
+          cursor's record first and updating the cursor.
+          @param JD the time (Julian Date) of interest
+          @param cursor current record of the caller
+          @return 0 success, -1 time is before the first record,
+                 -2 time is after the last record, -4 file is not mapped.
+         */
+      int findMappedRecord(double JD, RecordCursor& cursor) const;
 
       //------------------------------------------------------------------
       // member data
@@ -533,6 +661,19 @@ namespace gnsstk
          */
       std::vector<double> coefficients;
 
+         /// Memory-mapped binary file, defined in the implementation.
+      struct MappedFile;
+
+         /// Mapping set up by initializeWithMappedFile(), or null.
+      std::shared_ptr<MappedFile> mapping;
+
+      const double *mapData;       ///< first mapped data record, or null
+      size_t mapNrec;              ///< number of mapped data records
+      unsigned long mapGeneration; ///< incremented with each new mapping
+      RecordCursor mapCursor; ///< used by the non-const interface when mapped
+      double auKm;    ///< constants["AU"], for const access
+      double emRatio; ///< constants["EMRAT"], for const access
+
    }; // end class SolarSystemEphemeris
 
 } // end namespace gnsstk
@@ -57,6 +57,59 @@ using namespace std;
 
 namespace gnsstk
 {
+   //---------------------------------------------------------------------------------
+   TideSite::TideSite(const Position& pos, const IERSConvention& conv)
+      : site(pos), iers(conv)
+   {
+      double Rx(site.radius());
+      rx = Triple(site.X() / Rx, site.Y() / Rx, site.Z() / Rx);
+
+         // generate geodetic transformation first - for debug
+      lat    = site.getGeodeticLatitude() * DEG_TO_RAD;
+      lon    = site.getLongitude() * DEG_TO_RAD;
+      sinlat = ::sin(lat);
+      coslat = ::cos(lat);
+      sinlon = ::sin(lon);
+      coslon = ::cos(lon);
+
+         // transform  X=(x,y,z) into (R*X)(north,east,up) using geodetic
+         // longitude
+      northGD = Triple(-sinlat * coslon, -sinlat * sinlon, coslat);
+      eastGD  = Triple(-sinlon, coslon, 0.0);
+      upGD    = Triple(coslat * coslon, coslat * sinlon, sinlat);
+
+         // use geocentric latitude for formulas
+      latdeg = site.getGeocentricLatitude();
+      lat    = latdeg * DEG_TO_RAD;
+      lon    = site.getLongitude() * DEG_TO_RAD;
+      sinlat = ::sin(lat);
+      coslat = ::cos(lat);
+      sinlon = ::sin(lon);
+      coslon = ::cos(lon);
+
+         /* transform  X=(x,y,z) into (R*X)(north,east,up) using geocentric
+            longitude */
+      north = Triple(-sinlat * coslon, -sinlat * sinlon, coslat);
+      east  = Triple(-sinlon, coslon, 0.0);
+      up    = Triple(coslat * coslon, coslat * sinlon, sinlat);
+
+         // nominal degree 2 Love and Shida numbers pg 60
+      double poly = sinlat;
+      poly        = (3.0 * poly * poly - 1.0) / 2.0;
+
+         // here is the only difference between 1996 and 2003/10
+      if (iers == IERSConvention::IERS1996)
+      {
+         Love  = 0.6026 - 0.0006 * poly;
+         Shida = 0.0831 + 0.0002 * poly;
+      }
+      else
+      { // 2003 or 2010
+         Love  = 0.6078 - 0.0006 * poly;
+         Shida = 0.0847 + 0.0002 * poly;
+      }
+   }
+
    //---------------------------------------------------------------------------------
       /* Compute the site displacement due to solid Earth tides for the given
          Position (assumed to be fixed to the solid Earth) at the given time, given
@@ -81,6 +134,22 @@ namespace gnsstk
                                  const Position& Sun, const Position& Moon,
                                  double EMRAT, double SERAT,
                                  const IERSConvention& iers)
+   {
+      try
+      {
+         return computeSolidEarthTides(TideSite(site, iers), ttag, Sun, Moon,
+                                       EMRAT, SERAT);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   Triple computeSolidEarthTides(const TideSite& site, const EphTime& ttag,
+                                 const Position& Sun, const Position& Moon,
+                                 double EMRAT, double SERAT)
    {
       try
       {
@@ -94,13 +163,19 @@ namespace gnsstk
          static bool debug    = (LOGlevel >= DEBUG7);
             // NB icount is a dummy used in test vs solid.f
          int i, icount(-1);
-         double RSun, RMoon, Rx, Love, Shida, sunFactor, moonFactor;
+         double RSun, RMoon, Love, Shida, sunFactor, moonFactor;
          double sunDOTrx, moonDOTrx, REoRS, REoRM;
-         double lat, lon, sinlat, coslat, sinlon, coslon;
          double latSun, lonSun, latMoon, lonMoon;
-         Triple disp, sunUnit, moonUnit, rx, tSun, tMoon, north, east, up;
+         Triple disp, sunUnit, moonUnit, tSun, tMoon;
+            // site-dependent quantities
+         const double &lat(site.lat), &lon(site.lon);
+         const double &sinlat(site.sinlat), &coslat(site.coslat);
+         const Triple &rx(site.rx), &north(site.north), &east(site.east),
+            &up(site.up);
             // quantities for debug printing only
-         Triple northGD, eastGD, upGD, tmp, tmp2, tmp3, tmp4;
+         const Triple &northGD(site.northGD), &eastGD(site.eastGD),
+            &upGD(site.upGD);
+         Triple tmp, tmp2, tmp3, tmp4;
 
          LOG(DEBUG7) << "Sun position " << ttag.asGPSString() << fixed
                      << setprecision(3) << setw(23) << Sun.X() << setw(23)
@@ -112,48 +187,17 @@ namespace gnsstk
             // distances (m)
          RSun  = Sun.radius();
          RMoon = Moon.radius();
-         Rx    = site.radius();
 
             // unit vectors
          sunUnit = Triple(Sun.X() / RSun, Sun.Y() / RSun, Sun.Z() / RSun);
          moonUnit =
             Triple(Moon.X() / RMoon, Moon.Y() / RMoon, Moon.Z() / RMoon);
-         rx = Triple(site.X() / Rx, site.Y() / Rx, site.Z() / Rx);
-
-            // generate geodetic transformation first - for debug
-         if (debug)
-         {
-            lat    = site.getGeodeticLatitude() * DEG_TO_RAD;
-            lon    = site.getLongitude() * DEG_TO_RAD;
-            sinlat = ::sin(lat);
-            coslat = ::cos(lat);
-            sinlon = ::sin(lon);
-            coslon = ::cos(lon);
-
-               // transform  X=(x,y,z) into (R*X)(north,east,up) using geodetic
-               // longitude
-            northGD = Triple(-sinlat * coslon, -sinlat * sinlon, coslat);
-            eastGD  = Triple(-sinlon, coslon, 0.0);
-            upGD    = Triple(coslat * coslon, coslat * sinlon, sinlat);
-         }
 
             // use geocentric latitude for formulas
          latSun  = Sun.getGeocentricLatitude() * DEG_TO_RAD;
          lonSun  = Sun.getLongitude() * DEG_TO_RAD;
          latMoon = Moon.getGeocentricLatitude() * DEG_TO_RAD;
          lonMoon = Moon.getLongitude() * DEG_TO_RAD;
-         lat     = site.getGeocentricLatitude() * DEG_TO_RAD;
-         lon     = site.getLongitude() * DEG_TO_RAD;
-         sinlat  = ::sin(lat);
-         coslat  = ::cos(lat);
-         sinlon  = ::sin(lon);
-         coslon  = ::cos(lon);
-
-            /* transform  X=(x,y,z) into (R*X)(north,east,up) using geocentric
-               longitude */
-         north = Triple(-sinlat * coslon, -sinlat * sinlon, coslat);
-         east  = Triple(-sinlon, coslon, 0.0);
-         up    = Triple(coslat * coslon, coslat * sinlon, sinlat);
 
             // GM*R factors
          REoRS = REarth / RSun; // ratio Earth/Sun radius
@@ -183,21 +227,11 @@ namespace gnsstk
             // formulas are generally repeated in other IERS technical notes.
 
             // Step 1a IERS(1996) eq. (8) pg 61.
-            // nominal degree 2 Love and Shida numbers pg 60
+            // nominal degree 2 Love and Shida numbers pg 60, cf. TideSite
          double poly = sinlat;
          poly        = (3.0 * poly * poly - 1.0) / 2.0;
-
-            // here is the only difference between 1996 and 2003/10
-         if (iers == IERSConvention::IERS1996)
-         {
-            Love  = 0.6026 - 0.0006 * poly;
-            Shida = 0.0831 + 0.0002 * poly;
-         }
-         else
-         { // 2003 or 2010
-            Love  = 0.6078 - 0.0006 * poly;
-            Shida = 0.0847 + 0.0002 * poly;
-         }
+         Love        = site.Love;
+         Shida       = site.Shida;
          LOG(DEBUG6) << "H2L2 " << setw(4) << icount << fixed
                      << setprecision(15) << " " << setw(18) << Love << " "
                      << setw(18) << Shida << " " << setw(18) << poly;
@@ -714,6 +748,21 @@ namespace gnsstk
    {
       try
       {
+         return computePolarTides(TideSite(site, iers), ttag, xp, yp);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   Triple computePolarTides(const TideSite& site, const EphTime& ttag,
+                            double xp, double yp)
+   {
+      try
+      {
+         const IERSConvention& iers(site.iers);
          double m1, m2, upcoef;
 
          if (iers == IERSConvention::IERS1996)
@@ -762,17 +811,11 @@ namespace gnsstk
                      << " " << m1 << " " << m2;
 
             // the rest is nearly identical in all conventions
-         double lat, lon, theta, sinlat, coslat, sinlon, coslon;
+         const double &sinlat(site.sinlat), &coslat(site.coslat);
+         const double &sinlon(site.sinlon), &coslon(site.coslon);
+         double theta((90.0 - site.latdeg) * DEG_TO_RAD);
          Triple disp, dispXYZ;
 
-         lat    = site.getGeocentricLatitude();
-         lon    = site.getLongitude();
-         sinlat = ::sin(lat * DEG_TO_RAD);
-         coslat = ::cos(lat * DEG_TO_RAD);
-         sinlon = ::sin(lon * DEG_TO_RAD);
-         coslon = ::cos(lon * DEG_TO_RAD);
-         theta  = (90.0 - lat) * DEG_TO_RAD;
-
             // NEU components (r==Up, theta=S, lambda=E)
          disp[0] =
             0.009 * ::cos(2 * theta) * (m1 * coslon + m2 * sinlon);    // -S = N
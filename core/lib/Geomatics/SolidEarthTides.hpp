@@ -62,6 +62,34 @@
 namespace gnsstk
 {
 
+   //---------------------------------------------------------------------------------
+      /**
+       Quantities that depend only on the site (and IERS convention) used by
+       computeSolidEarthTides() and computePolarTides(). Build one of these per
+       site and pass it to the overloads below to avoid recomputing them at
+       every epoch.
+      */
+   struct TideSite
+   {
+         /**
+          Compute the site-dependent quantities.
+          @param site  Nominal position of the site of interest.
+          @param iers  IERS convention to use (default IERS2010)
+         */
+      explicit TideSite(const Position& site,
+                        const IERSConvention& iers = IERSConvention::IERS2010);
+
+      Position site;        ///< nominal position of the site
+      IERSConvention iers;  ///< IERS convention
+      double latdeg;        ///< geocentric latitude in degrees
+      double lat, lon;      ///< geocentric latitude and longitude in radians
+      double sinlat, coslat, sinlon, coslon; ///< sin and cos of lat and lon
+      double Love, Shida;   ///< nominal degree 2 Love and Shida numbers at lat
+      Triple rx;            ///< unit vector to the site, ECEF XYZ
+      Triple north, east, up; ///< geocentric NEU unit vectors, ECEF XYZ
+      Triple northGD, eastGD, upGD; ///< geodetic NEU unit vectors (debug output)
+   };
+
    //---------------------------------------------------------------------------------
       /**
        Compute the site displacement due to solid Earth tides for the given
@@ -92,6 +120,24 @@ namespace gnsstk
                           double SERAT        = 332946.050894783285912,
                           const IERSConvention& iers = IERSConvention::IERS2010);
 
+      /**
+       Compute the site displacement due to solid Earth tides, as above, using
+       site-dependent quantities computed once by TideSite.
+       @param site  TideSite of the site of interest; defines the IERS convention
+       @param ttag   Time of interest.
+       @param Sun   Position of the Sun at time
+       @param Moon  Position of the Moon at time
+       @param EMRAT   Earth-to-Moon mass ratio (default to DE405 value)
+       @param SERAT   Sun-to-Earth mass ratio (default to DE405 value)
+       @return Displacement vector, ECEF XYZ in meters.
+       @throw Exception
+      */
+   Triple
+   computeSolidEarthTides(const TideSite& site, const EphTime& ttag,
+                          const Position& Sun, const Position& Moon,
+                          double EMRAT = 81.30056,
+                          double SERAT = 332946.050894783285912);
+
    //---------------------------------------------------------------------------------
       /**
        Compute the site displacement due to rotational deformation due to polar
@@ -112,6 +158,20 @@ namespace gnsstk
    computePolarTides(const Position& site, const EphTime& ttag, double xp, double yp,
                      const IERSConvention& iers = IERSConvention::IERS2010);
 
+      /**
+       Compute the site displacement due to rotational deformation due to polar
+       motion, as above, using site-dependent quantities computed once by
+       TideSite.
+       @param site  TideSite of the site of interest; defines the IERS convention
+       @param ttag   Time of interest.
+       @param xp,yp   Polar motion angles in arcsec (cf. EarthOrientation)
+       @return Displacement vector, ECEF XYZ in meters.
+       @throw Exception
+      */
+   Triple
+   computePolarTides(const TideSite& site, const EphTime& ttag, double xp,
+                     double yp);
+
 } // end namespace gnsstk
 
 #endif // SOLID_EARTH_TIDES_INCLUDE
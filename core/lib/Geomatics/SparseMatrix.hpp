@@ -147,7 +147,7 @@ namespace gnsstk
    // get the value of the SparseMatrix at irow, jcol
    template <class T> T SMatProxy<T>::value() const
    {
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
       it = mySM.rowsMap.find(irow);
       if (it != mySM.rowsMap.end())
       {
@@ -161,7 +161,7 @@ namespace gnsstk
    // assignment, used by operator=, operator+=, etc
    template <class T> void SMatProxy<T>::assign(T rhs)
    {
-      typename std::map<unsigned int, SparseVector<T>>::iterator it;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
       it = mySM.rowsMap.find(irow);
 
       // add a new row? only if row is not there, and rhs is not zero
@@ -196,7 +196,7 @@ namespace gnsstk
    // cast
    template <class T> SMatProxy<T>::operator T() const
    {
-      typename std::map<unsigned int, SparseVector<T>>::iterator it;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
       it = mySM.rowsMap.find(irow);
       if (it == mySM.rowsMap.end())
       {
@@ -335,7 +335,10 @@ namespace gnsstk
        Class SparseMatrix. This class is designed to present an interface nearly
        identical to class Matrix, but more efficiently handle sparse matrices,
        in which most of the elements are zero. The class stores only non-zero
-       elements; using a map of SparseVectors, with key = row index. it also
+       elements; using a SparseIndexMap of SparseVectors, with key = row index,
+       which is compressed row storage: the non-empty rows are kept in one
+       array sorted by row index, and each row keeps its elements in one array
+       sorted by column index. it also
        stores a nominal dimension - number of rows and columns. The class uses a
        proxy class, SMatProxy, to access elements; this allows rvalues and
        lvalues to be treated separately. Notes on speed. The most expensive
@@ -349,7 +352,12 @@ namespace gnsstk
        re-write the algorithm in terms of the transpose of the column-loop
        matrix, and then apply a transpose(), which is cheap, either before
        starting (when col-loop matrix is input) or after returning (output).
-       Then the loops become loops over rows.
+       Then the loops become loops over rows. Products are formed a row at a
+       time, scattering scaled rows into a SparseAccumulator (Gustavson's
+       algorithm), and sums and concatenations merge the sorted rows, so that
+       the cost of each is proportional to the number of non-zero elements.
+       Inserting a row or element in the middle of the storage moves the data
+       after it, so algorithms here build rows in index order and append.
        NB. never store zeros in the map, particularly when you are creating the
        matrix and using it at the same time, as in inverseLT().
       */
@@ -469,7 +477,7 @@ namespace gnsstk
       inline unsigned int datasize() const
       {
          unsigned int n(0);
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator it;
          it = rowsMap.begin();
          for (; it != rowsMap.end(); ++it)
             n += it->second.datasize();
@@ -491,7 +499,7 @@ namespace gnsstk
          /// resize - only changes len and removes elements if necessary
       void resize(const unsigned int newrows, const unsigned int newcols)
       {
-         typename std::map<unsigned int, SparseVector<T>>::iterator it;
+         typename SparseIndexMap<SparseVector<T>>::iterator it;
          if (newrows < nrows)
          {
             // lower_bound returns it for first key >= newrows
@@ -527,7 +535,7 @@ namespace gnsstk
          /// true if the element (i,j) is non-zero
       inline bool isFilled(const unsigned int i, const unsigned int j)
       {
-         typename std::map<unsigned int, SparseVector<T>>::iterator it;
+         typename SparseIndexMap<SparseVector<T>>::iterator it;
          it = rowsMap.find(i);
          return (it != rowsMap.end() && it->second.isFilled(j));
       }
@@ -576,7 +584,7 @@ namespace gnsstk
          oss << (dosci ? std::scientific : std::fixed) << std::setprecision(p);
 
          // loop over rows
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator it;
          it = rowsMap.begin();
          if (it == rowsMap.end())
          {
@@ -602,8 +610,8 @@ namespace gnsstk
          values.clear();
 
          // loop over rows, then columns
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
-         typename std::map<unsigned int, T>::const_iterator jt;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<T>::const_iterator jt;
          for (it = rowsMap.begin(); it != rowsMap.end(); ++it)
          {
             unsigned int row(it->first);
@@ -633,8 +641,8 @@ namespace gnsstk
       SparseMatrix<T> operator-() const
       {
          SparseMatrix<T> toRet(*this);
-         typename std::map<unsigned int, SparseVector<T>>::iterator it;
-         typename std::map<unsigned int, T>::iterator jt;
+         typename SparseIndexMap<SparseVector<T>>::iterator it;
+         typename SparseIndexMap<T>::iterator jt;
          for (it = toRet.rowsMap.begin(); it != toRet.rowsMap.end(); ++it)
          {
             for (jt = it->second.vecMap.begin(); jt != it->second.vecMap.end();
@@ -660,11 +668,14 @@ namespace gnsstk
       void swapCols(const unsigned int ii, const unsigned int jj);
 
    private:
+         /// this += a*SM, merging the rows of SM into rowsMap in one pass
+      void addScaledRows(const T& a, const SparseMatrix<T>& SM);
+
          /// dimensions of the "real" matrix (not the number of data stored)
       unsigned int nrows, ncols;
 
          /// map of row index, row SparseVector
-      std::map<unsigned int, SparseVector<T>> rowsMap;
+      SparseIndexMap<SparseVector<T>> rowsMap;
 
       // TD ? obsolete this by always using transpose when you must loop over
       // columns
@@ -676,7 +687,7 @@ namespace gnsstk
       std::map<unsigned int, std::vector<unsigned int>> columnMap() const
       {
          unsigned int j, k;
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator it;
          typename std::map<unsigned int, std::vector<unsigned int>> colMap;
          typename std::map<unsigned int, std::vector<unsigned int>>::iterator
             jt;
@@ -737,21 +748,17 @@ namespace gnsstk
 
       nrows = rnum;
       ncols = cnum;
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
-      for (it = SM.rowsMap.begin(); it != SM.rowsMap.end(); ++it)
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
+      for (it = SM.rowsMap.lower_bound(rind); it != SM.rowsMap.end(); ++it)
       {
-         if (it->first < rind)
-         {
-            continue; // skip rows before rind
-         }
-         if (it->first > rind + rnum)
+         if (it->first >= rind + rnum)
          {
             break;                                   // done with rows
          }
          SparseVector<T> SV(it->second, cind, cnum); // get sub-vector
          if (!SV.isEmpty())
          {
-            rowsMap[it->first] = SV; // add it
+            rowsMap.push_back(it->first - rind, std::move(SV)); // add it
          }
       }
    }
@@ -764,7 +771,7 @@ namespace gnsstk
       ncols = M.cols();
       for (i = 0; i < nrows; i++)
       {
-         bool haverow(false); // rather than rowsMap.find() every time
+         SparseVector<T> SVrow(ncols); // 'real' length ncols
          for (j = 0; j < ncols; j++)
          {
             if (M(i, j) == T(0))
@@ -772,14 +779,13 @@ namespace gnsstk
                continue; // nothing to do - element(i,j) is zero
             }
 
-            // non-zero, must add it
-            if (!haverow)
-            {                                // add row i
-               SparseVector<T> SVrow(ncols); // 'real' length ncols
-               rowsMap[i] = SVrow;
-               haverow    = true;
-            }
-            rowsMap[i].vecMap[j] = M(i, j);
+            // non-zero, must add it; j increases so this is an append
+            SVrow.vecMap.push_back(j, M(i, j));
+         }
+
+         if (!SVrow.isEmpty())
+         {
+            rowsMap.push_back(i, std::move(SVrow));
          }
       }
    }
@@ -788,8 +794,8 @@ namespace gnsstk
    template <class T> SparseMatrix<T>::operator Matrix<T>() const
    {
       Matrix<T> toRet(nrows, ncols, T(0));
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
-      typename std::map<unsigned int, T>::const_iterator jt;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<T>::const_iterator jt;
       for (it = rowsMap.begin(); it != rowsMap.end(); ++it)
       {
          for (jt = it->second.vecMap.begin(); jt != it->second.vecMap.end();
@@ -805,49 +811,57 @@ namespace gnsstk
       /// zeroize - remove elements that are less than tolerance in abs value
    template <class T> void SparseMatrix<T>::zeroize(const T tol)
    {
-      std::vector<unsigned int> toDelete; // row indexes
-      typename std::map<unsigned int, SparseVector<T>>::iterator it;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
       for (it = rowsMap.begin(); it != rowsMap.end(); ++it)
       {
          it->second.zeroize(tol);
-
-         // remove row if its empty - but not inside the iteration loop
-         if (it->second.datasize() == 0)
-         {
-            toDelete.push_back(it->first);
-         }
       }
 
-      // now remove the marked rows
-      for (unsigned int i = 0; i < toDelete.size(); i++)
-      {
-         rowsMap.erase(toDelete[i]);
-      }
+      // now remove the empty rows, in one pass
+      rowsMap.eraseIf(
+         [](const typename SparseIndexMap<SparseVector<T>>::value_type& row)
+         { return row.second.isEmpty(); });
    }
 
-      /// transpose
+      /**
+       transpose. The elements of each row of M are distributed to the rows of
+       the transpose; since the rows of M are visited in increasing order,
+       every element is appended, and the cost is O(rows + cols + non-zeros).
+      */
    template <class T> SparseMatrix<T> transpose(const SparseMatrix<T>& M)
    {
       SparseMatrix<T> toRet(M.cols(), M.rows());
 
-      // loop over rows of M = columns of toRet - faster
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
-      typename std::map<unsigned int, SparseVector<T>>::iterator jt;
+      // count the elements in each column of M, to size the rows of toRet
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<T>::const_iterator jt;
+      std::vector<unsigned int> count(M.cols(), 0);
       for (it = M.rowsMap.begin(); it != M.rowsMap.end(); ++it)
       {
-         for (unsigned int j = 0; j < M.cols(); j++)
+         for (jt = it->second.vecMap.begin(); jt != it->second.vecMap.end();
+              ++jt)
+            count[jt->first]++;
+      }
+
+      std::vector<SparseVector<T>> rows(M.cols(), SparseVector<T>(M.rows()));
+      for (unsigned int j = 0; j < M.cols(); j++)
+      {
+         rows[j].vecMap.reserve(count[j]);
+      }
+
+      // loop over rows of M = columns of toRet
+      for (it = M.rowsMap.begin(); it != M.rowsMap.end(); ++it)
+      {
+         for (jt = it->second.vecMap.begin(); jt != it->second.vecMap.end();
+              ++jt)
+            rows[jt->first].vecMap.push_back(it->first, jt->second);
+      }
+
+      for (unsigned int j = 0; j < M.cols(); j++)
+      {
+         if (count[j] > 0)
          {
-            if (it->second.isFilled(j))
-            { // M(i,j)
-               jt = toRet.rowsMap.find(j);
-               if (jt == toRet.rowsMap.end())
-               { // add the row
-                  SparseVector<T> rowSV(M.rows());
-                  toRet.rowsMap[j] = rowSV;
-                  jt               = toRet.rowsMap.find(j);
-               }
-               jt->second.vecMap[it->first] = it->second[j];
-            }
+            toRet.rowsMap.push_back(j, std::move(rows[j]));
          }
       }
 
@@ -857,7 +871,7 @@ namespace gnsstk
       /// Maximum element - return 0 if empty
    template <class T> T min(const SparseMatrix<T>& SM)
    {
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
       it = SM.rowsMap.begin();
       if (it == SM.rowsMap.end())
       {
@@ -880,7 +894,7 @@ namespace gnsstk
       /// Maximum element - return 0 if empty
    template <class T> T max(const SparseMatrix<T>& SM)
    {
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
       it = SM.rowsMap.begin();
       if (it == SM.rowsMap.end())
       {
@@ -903,7 +917,7 @@ namespace gnsstk
       /// Minimum absolute value - return 0 if empty
    template <class T> T minabs(const SparseMatrix<T>& SM)
    {
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
       it = SM.rowsMap.begin();
       if (it == SM.rowsMap.end())
       {
@@ -926,7 +940,7 @@ namespace gnsstk
       /// Maximum absolute value - return 0 if empty
    template <class T> T maxabs(const SparseMatrix<T>& SM)
    {
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
       it = SM.rowsMap.begin();
       if (it == SM.rowsMap.end())
       {
@@ -955,7 +969,7 @@ namespace gnsstk
       savefmt.copyfmt(os);
 
       unsigned int i, j; // the "real" vector row and column index
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
 
       it = SM.rowsMap.begin();
       // if(it == SM.rowsMap.end()) { os << "empty"; return os; }
@@ -1003,7 +1017,7 @@ namespace gnsstk
          }
 
          SparseVector<T> retSV(L.rows());
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator it;
 
          // loop over rows of L = rows of answer
          for (it = L.rowsMap.begin(); it != L.rowsMap.end(); ++it)
@@ -1036,7 +1050,7 @@ namespace gnsstk
          {
             T sum(0);
             // loop over elements of V
-            typename std::map<unsigned int, T>::const_iterator it;
+            typename SparseIndexMap<T>::const_iterator it;
             for (it = V.vecMap.begin(); it != V.vecMap.end(); ++it)
                sum += L(i, it->first) * it->second;
             retSV.vecMap[i] = sum;
@@ -1063,7 +1077,7 @@ namespace gnsstk
          }
 
          SparseVector<T> retSV(L.rows());
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator it;
 
          // loop over rows of L = rows of answer
          for (it = L.rowsMap.begin(); it != L.rowsMap.end(); ++it)
@@ -1088,28 +1102,28 @@ namespace gnsstk
       }
 
       SparseVector<T> retSV(R.cols());
+      SparseAccumulator<T> sum(R.cols());
 
-      // first build a "column map" for R - vectors (of row-index) for each
-      // column colMap[column index] = vector of all row indexes, in ascending
-      // order
-      std::map<unsigned int, std::vector<unsigned int>>::iterator jt;
-      std::map<unsigned int, std::vector<unsigned int>> colMap = R.columnMap();
-
-      // loop over columns of R = elements of answer
-      for (jt = colMap.begin(); jt != colMap.end(); ++jt)
+      // answer = sum over elements V(k) of V(k) * (row k of R)
+      typename SparseIndexMap<T>::const_iterator vt;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator kt;
+      kt = R.rowsMap.begin();
+      for (vt = V.vecMap.begin(); vt != V.vecMap.end(); ++vt)
       {
-         T sum(0);
-         // loop over rows of R and elements of V
-         for (unsigned int k = 0; k < jt->second.size(); k++)
-            if (V.isFilled(jt->second[k]))
-            {
-               sum += V[jt->second[k]] * R(k, jt->first);
-            }
-         if (sum != T(0))
+         while (kt != R.rowsMap.end() && kt->first < vt->first)
          {
-            retSV.vecMap[jt->first] = sum;
+            ++kt;
+         }
+         if (kt == R.rowsMap.end())
+         {
+            break;
+         }
+         if (kt->first == vt->first)
+         {
+            sum.addScaled(vt->second, kt->second);
          }
       }
+      sum.gather(retSV);
 
       return retSV;
    }
@@ -1127,16 +1141,17 @@ namespace gnsstk
 
          T sum;
          SparseVector<T> retSV(R.cols());
+         typename SparseIndexMap<T>::const_iterator vt;
 
          // loop over columns of R = elements of answer
          for (unsigned int j = 0; j < R.cols(); j++)
          {
-            // copy out the whole column as a Vector
-            Vector<T> colR = R.colCopy(j);
-            sum            = dot(colR, V);
+            sum = T(0);
+            for (vt = V.vecMap.begin(); vt != V.vecMap.end(); ++vt)
+               sum += R(vt->first, j) * vt->second;
             if (sum != T(0))
             {
-               retSV.vecMap[j] = sum;
+               retSV.vecMap.push_back(j, sum);
             }
          }
 
@@ -1158,25 +1173,18 @@ namespace gnsstk
       }
 
       SparseVector<T> retSV(R.cols());
+      SparseAccumulator<T> sum(R.cols());
 
-      // first build a "column map" for R - vectors (of row-index) for each
-      // column colMap[column index] = vector of all row indexes, in ascending
-      // order
-      std::map<unsigned int, std::vector<unsigned int>>::iterator jt;
-      std::map<unsigned int, std::vector<unsigned int>> colMap = R.columnMap();
-
-      // loop over columns of R = elements of answer
-      for (jt = colMap.begin(); jt != colMap.end(); ++jt)
+      // answer = sum over rows k of R of V(k) * (row k of R)
+      typename SparseIndexMap<SparseVector<T>>::const_iterator kt;
+      for (kt = R.rowsMap.begin(); kt != R.rowsMap.end(); ++kt)
       {
-         T sum(0);
-         // loop over rows of R and elements of V
-         for (unsigned int k = 0; k < jt->second.size(); k++)
-            sum += V[jt->second[k]] * R(jt->second[k], jt->first);
-         if (sum != T(0))
+         if (V[kt->first] != T(0))
          {
-            retSV.vecMap[jt->first] = sum;
+            sum.addScaled(V[kt->first], kt->second);
          }
       }
+      sum.gather(retSV);
 
       return retSV;
    }
@@ -1191,29 +1199,38 @@ namespace gnsstk
       }
 
       const unsigned int nr(L.rows()), nc(R.cols());
-      SparseMatrix<T> retSM(nr, nc);          // empty but with correct dimen.
-      const SparseMatrix<T> RT(transpose(R)); // work with transpose
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it, jt;
+      SparseMatrix<T> retSM(nr, nc); // empty but with correct dimen.
+      SparseAccumulator<T> sum(nc);
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it, kt;
+      typename SparseIndexMap<T>::const_iterator vt;
 
-      // loop over rows of L = rows of retSM
+      // loop over rows of L = rows of retSM; row i of the answer is the sum
+      // over elements L(i,k) of L(i,k) * (row k of R)
       for (it = L.rowsMap.begin(); it != L.rowsMap.end(); ++it)
       {
-         bool haveRow(false); // use to create the row
-         // loop over rows of RT == columns of R
-         for (jt = RT.rowsMap.begin(); jt != RT.rowsMap.end(); ++jt)
+         kt = R.rowsMap.begin();
+         for (vt = it->second.vecMap.begin(); vt != it->second.vecMap.end();
+              ++vt)
          {
-            // answer(i,j) = dot product of Lrow and RTrow==Rcol
-            T d(dot(it->second, jt->second));
-            if (d != T(0))
+            while (kt != R.rowsMap.end() && kt->first < vt->first)
             {
-               if (!haveRow)
-               {
-                  SparseVector<T> row(nc);
-                  retSM.rowsMap[it->first] = row;
-                  haveRow                  = true;
-               }
-               retSM.rowsMap[it->first].vecMap[jt->first] = d;
+               ++kt;
+            }
+            if (kt == R.rowsMap.end())
+            {
+               break;
             }
+            if (kt->first == vt->first)
+            {
+               sum.addScaled(vt->second, kt->second);
+            }
+         }
+
+         SparseVector<T> row(nc);
+         sum.gather(row);
+         if (!row.isEmpty())
+         {
+            retSM.rowsMap.push_back(it->first, std::move(row));
          }
       }
 
@@ -1233,28 +1250,34 @@ namespace gnsstk
 
          const unsigned int nr(L.rows()), nc(R.cols());
          SparseMatrix<T> retSM(nr, nc);
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<T>::const_iterator vt;
+         std::vector<T> sum(nc);
 
-         // loop over rows of L = rows of answer
+         // loop over rows of L = rows of answer; row i of the answer is the
+         // sum over elements L(i,k) of L(i,k) * (row k of R)
          for (it = L.rowsMap.begin(); it != L.rowsMap.end(); ++it)
          {
-            bool haveRow(false); // use to create the row
-            // loop over columns of R = cols of answer
-            for (unsigned int j = 0; j < R.cols(); j++)
+            std::fill(sum.begin(), sum.end(), T(0));
+            for (vt = it->second.vecMap.begin(); vt != it->second.vecMap.end();
+                 ++vt)
+            {
+               for (unsigned int j = 0; j < nc; j++)
+                  sum[j] += vt->second * R(vt->first, j);
+            }
+
+            SparseVector<T> row(nc);
+            for (unsigned int j = 0; j < nc; j++)
             {
-               Vector<T> colR(R.colCopy(j));
-               T d(dot(it->second, colR));
-               if (d != T(0))
+               if (sum[j] != T(0))
                {
-                  if (!haveRow)
-                  {
-                     SparseVector<T> row(nc);
-                     retSM.rowsMap[it->first] = row;
-                     haveRow                  = true;
-                  }
-                  retSM.rowsMap[it->first].vecMap[j] = d;
+                  row.vecMap.push_back(j, sum[j]);
                }
             }
+            if (!row.isEmpty())
+            {
+               retSM.rowsMap.push_back(it->first, std::move(row));
+            }
          }
 
          return retSM;
@@ -1276,31 +1299,27 @@ namespace gnsstk
 
       const unsigned int nr(L.rows()), nc(R.cols());
       SparseMatrix<T> retSM(nr, nc);
-      const SparseMatrix<T> RT(transpose(R)); // work with transpose
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator jt;
+      SparseAccumulator<T> sum(nc);
+      typename SparseIndexMap<SparseVector<T>>::const_iterator kt;
 
-      // loop over rows of L = rows of retSM
+      // loop over rows of L = rows of retSM; row i of the answer is the sum
+      // over rows k of R of L(i,k) * (row k of R)
       for (unsigned int i = 0; i < nr; i++)
       {
-         bool haveRow(false);                // use to create the row in retSM
-         const Vector<T> rowL(L.rowCopy(i)); // copy out the row in L
-
-         // loop over rows of RT == columns of R
-         for (jt = RT.rowsMap.begin(); jt != RT.rowsMap.end(); ++jt)
+         for (kt = R.rowsMap.begin(); kt != R.rowsMap.end(); ++kt)
          {
-            // answer(i,j) = dot product of Lrow and RTrow==Rcol
-            T d(dot(rowL, jt->second));
-            if (d != T(0))
+            if (L(i, kt->first) != T(0))
             {
-               if (!haveRow)
-               {
-                  SparseVector<T> row(nc);
-                  retSM.rowsMap[i] = row;
-                  haveRow          = true;
-               }
-               retSM.rowsMap[i].vecMap[jt->first] = d;
+               sum.addScaled(L(i, kt->first), kt->second);
             }
          }
+
+         SparseVector<T> row(nc);
+         sum.gather(row);
+         if (!row.isEmpty())
+         {
+            retSM.rowsMap.push_back(i, std::move(row));
+         }
       }
 
       return retSM;
@@ -1317,24 +1336,33 @@ namespace gnsstk
          GNSSTK_THROW(Exception("Incompatible dimensions op||(SM,V)"));
       }
 
-      SparseMatrix<T> toRet(L);
-      toRet.ncols++;
+      const unsigned int n(L.ncols);
+      SparseMatrix<T> toRet(L.nrows, n + 1);
 
-      unsigned int i, n(toRet.ncols - 1);
-      typename std::map<unsigned int, SparseVector<T>>::iterator jt;
-      for (i = 0; i < V.size(); i++)
+      // merge the rows of L with the elements of V, which become column n
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
+      it = L.rowsMap.begin();
+      for (unsigned int i = 0; i < V.size(); i++)
       {
+         const bool haveRow(it != L.rowsMap.end() && it->first == i);
+         if (!haveRow && V(i) == T(0))
+         {
+            continue;
+         }
+
+         SparseVector<T> row(haveRow ? it->second : SparseVector<T>());
+         row.len = n + 1;
          if (V(i) != T(0))
-         {                              // add it
-            jt = toRet.rowsMap.find(i); // find the row
-            if (jt == toRet.rowsMap.end())
-            { // add the row
-               SparseVector<T> V(toRet.ncols);
-               toRet.rowsMap[i] = V;
-            }
-            toRet.rowsMap[i].vecMap[n] = V(i);
+         {
+            row.vecMap.push_back(n, V(i));
+         }
+         toRet.rowsMap.push_back(i, std::move(row));
+         if (haveRow)
+         {
+            ++it;
          }
       }
+
       return toRet;
    }
 
@@ -1348,42 +1376,95 @@ namespace gnsstk
          GNSSTK_THROW(Exception("Incompatible dimensions op||(SM,SM)"));
       }
 
-      SparseMatrix<T> toRet(L);
-      toRet.ncols += R.ncols;
+      const unsigned int N(L.ncols);
+      SparseMatrix<T> toRet(L.nrows, L.ncols + R.ncols);
 
-      unsigned int i, N(L.ncols);
-      typename std::map<unsigned int, SparseVector<T>>::iterator it;
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator jt;
-      it = toRet.rowsMap.begin();
+      // merge the rows of L and R; the columns of R follow those of L
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it, jt;
+      typename SparseIndexMap<T>::const_iterator vt;
+      it = L.rowsMap.begin();
       jt = R.rowsMap.begin();
-      while (it != toRet.rowsMap.end() && jt != R.rowsMap.end())
-      {
-         if (it->first < jt->first)
-         { // R has no row here - do nothing
-            it->second.len += N;
+      while (it != L.rowsMap.end() || jt != R.rowsMap.end())
+      {
+         unsigned int i;
+         SparseVector<T> row;
+         if (jt == R.rowsMap.end() ||
+             (it != L.rowsMap.end() && it->first < jt->first))
+         { // R has no row here
+            i   = it->first;
+            row = it->second;
             ++it;
          }
-         else if (it->first > jt->first)
-         { // R has a row where toRet does not
-            toRet.rowsMap[jt->first] = jt->second;
-            toRet.rowsMap[jt->first].len += N;
-            ++jt;
-         }
          else
-         { // equal indexes - both have rows
-            it->second.len += N;
-            typename std::map<unsigned int, T>::const_iterator vt;
+         { // R has a row here; L may or may not
+            i = jt->first;
+            if (it != L.rowsMap.end() && it->first == i)
+            {
+               row = it->second;
+               ++it;
+            }
+            row.vecMap.reserve(row.vecMap.size() + jt->second.vecMap.size());
             for (vt = jt->second.vecMap.begin(); vt != jt->second.vecMap.end();
                  ++vt)
+               row.vecMap.push_back(N + vt->first, vt->second);
+            ++jt;
+         }
+         row.len = toRet.ncols;
+         toRet.rowsMap.push_back(i, std::move(row));
+      }
+
+      return toRet;
+   }
+
+   //---------------------------------------------------------------------------
+   //---------------------------------------------------------------------------
+   // merge the rows of this and a*SM into a new row array, then swap it in.
+   // SM may be *this: each row is updated before it is moved.
+   template <class T>
+   void SparseMatrix<T>::addScaledRows(const T& a, const SparseMatrix<T>& SM)
+   {
+      SparseIndexMap<SparseVector<T>> merged;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator jt;
+      it = rowsMap.begin();
+      jt = SM.rowsMap.begin();
+      while (it != rowsMap.end() || jt != SM.rowsMap.end())
+      {
+         unsigned int i;
+         SparseVector<T> row;
+         if (jt == SM.rowsMap.end() ||
+             (it != rowsMap.end() && it->first < jt->first))
+         { // SM has no row here
+            i   = it->first;
+            row = std::move(it->second);
+            ++it;
+         }
+         else if (it == rowsMap.end() || jt->first < it->first)
+         { // only SM has a row here
+            i   = jt->first;
+            row = jt->second;
+            if (a != T(1))
             {
-               toRet.rowsMap[it->first].vecMap[N + vt->first] = vt->second;
+               row *= a;
             }
+            ++jt;
+         }
+         else
+         { // both have rows
+            i = it->first;
+            it->second.addScaledSparseVector(a, jt->second);
+            row = std::move(it->second);
             ++it;
             ++jt;
          }
-      }
 
-      return toRet;
+         row.zeroize(T(0));
+         if (!row.isEmpty())
+         {
+            merged.push_back(i, std::move(row));
+         }
+      }
+      rowsMap.swap(merged);
    }
 
    //---------------------------------------------------------------------------
@@ -1398,22 +1479,7 @@ namespace gnsstk
       }
       // std::cout << "SM::op-=(SM)" << std::endl;
 
-      // loop over rows of SM
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator sit;
-      for (sit = SM.rowsMap.begin(); sit != SM.rowsMap.end(); ++sit)
-      {
-         // find same row in this
-         if (rowsMap.find(sit->first) == rowsMap.end())
-         {
-            rowsMap[sit->first] = -sit->second;
-         }
-         else
-         {
-            rowsMap[sit->first] -= sit->second;
-         }
-      }
-
-      zeroize(T(0));
+      addScaledRows(T(-1), SM);
       return *this;
    }
 
@@ -1427,20 +1493,30 @@ namespace gnsstk
       }
       // std::cout << "SM::op-=(M)" << std::endl;
 
-      // loop over rows of M
+      // merge the rows of M into rowsMap, in one pass
+      SparseIndexMap<SparseVector<T>> merged;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
+      it = rowsMap.begin();
       for (unsigned int i = 0; i < M.rows(); i++)
       {
          Vector<T> rowV(M.rowCopy(i));
-         if (rowsMap.find(i) == rowsMap.end())
+         SparseVector<T> row;
+         if (it != rowsMap.end() && it->first == i)
          {
-            SparseVector<T> SV(rowV);
-            rowsMap[i] = -SV;
+            row = std::move(it->second);
+            ++it;
+            row -= rowV;
          }
          else
          {
-            rowsMap[i] -= rowV;
+            row = -SparseVector<T>(rowV);
+         }
+         if (!row.isEmpty())
+         {
+            merged.push_back(i, std::move(row));
          }
       }
+      rowsMap.swap(merged);
 
       zeroize(T(0));
       return *this;
@@ -1506,22 +1582,7 @@ namespace gnsstk
       }
       // std::cout << "SM::op+=(SM)" << std::endl;
 
-      // loop over rows of SM
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator sit;
-      for (sit = SM.rowsMap.begin(); sit != SM.rowsMap.end(); ++sit)
-      {
-         // find same row in this
-         if (rowsMap.find(sit->first) == rowsMap.end())
-         {
-            rowsMap[sit->first] = sit->second;
-         }
-         else
-         {
-            rowsMap[sit->first] += sit->second;
-         }
-      }
-
-      zeroize(T(0));
+      addScaledRows(T(1), SM);
       return *this;
    }
 
@@ -1535,20 +1596,30 @@ namespace gnsstk
       }
       // std::cout << "SM::op+=(M)" << std::endl;
 
-      // loop over rows of M
+      // merge the rows of M into rowsMap, in one pass
+      SparseIndexMap<SparseVector<T>> merged;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
+      it = rowsMap.begin();
       for (unsigned int i = 0; i < M.rows(); i++)
       {
          Vector<T> rowV(M.rowCopy(i));
-         if (rowsMap.find(i) == rowsMap.end())
+         SparseVector<T> row;
+         if (it != rowsMap.end() && it->first == i)
          {
-            SparseVector<T> SV(rowV);
-            rowsMap[i] = SV;
+            row = std::move(it->second);
+            ++it;
+            row += rowV;
          }
          else
          {
-            rowsMap[i] += rowV;
+            row = SparseVector<T>(rowV);
+         }
+         if (!row.isEmpty())
+         {
+            merged.push_back(i, std::move(row));
          }
       }
+      rowsMap.swap(merged);
 
       zeroize(T(0));
       return *this;
@@ -1566,8 +1637,8 @@ namespace gnsstk
       }
 
       // loop over all elements
-      typename std::map<unsigned int, SparseVector<T>>::iterator it;
-      typename std::map<unsigned int, T>::iterator vt;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
+      typename SparseIndexMap<T>::iterator vt;
       for (it = rowsMap.begin(); it != rowsMap.end(); ++it)
       {
          for (vt = it->second.vecMap.begin(); vt != it->second.vecMap.end();
@@ -1591,8 +1662,8 @@ namespace gnsstk
       }
 
       // loop over all elements
-      typename std::map<unsigned int, SparseVector<T>>::iterator it;
-      typename std::map<unsigned int, T>::iterator vt;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
+      typename SparseIndexMap<T>::iterator vt;
       for (it = rowsMap.begin(); it != rowsMap.end(); ++it)
       {
          for (vt = it->second.vecMap.begin(); vt != it->second.vecMap.end();
@@ -1614,7 +1685,7 @@ namespace gnsstk
       // std::cout << "SM::op+(SM,SM)" << std::endl;
 
       SparseMatrix<T> retSM(L);
-      retSM -= R; // will zeroize(T(0))
+      retSM += R; // will zeroize(T(0))
 
       return retSM;
    }
@@ -1630,7 +1701,7 @@ namespace gnsstk
       // std::cout << "SM::op+(SM,M)" << std::endl;
 
       SparseMatrix<T> retSM(L);
-      retSM -= R; // will zeroize(T(0))
+      retSM += R; // will zeroize(T(0))
 
       return retSM;
    }
@@ -1648,8 +1719,8 @@ namespace gnsstk
       }
       // std::cout << "SM::op+(M,SM)" << std::endl;
 
-      SparseMatrix<T> retSM(L);
-      retSM -= R; // will zeroize(T(0))
+      SparseMatrix<T> retSM(R);
+      retSM += L; // will zeroize(T(0))
 
       return retSM;
    }
@@ -1662,7 +1733,7 @@ namespace gnsstk
    SparseVector<T> SparseMatrix<T>::rowCopy(const unsigned int i) const
    {
       SparseVector<T> retSV;
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
       it = rowsMap.find(i);
       if (it != rowsMap.end())
       {
@@ -1677,7 +1748,7 @@ namespace gnsstk
    {
       SparseVector<T> retSV;
 
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
       for (it = rowsMap.begin(); it != rowsMap.end(); ++it)
       { // loop over rows
          if (it->second.isFilled(j))
@@ -1695,7 +1766,7 @@ namespace gnsstk
    {
       SparseVector<T> retSV;
 
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
       for (it = rowsMap.begin(); it != rowsMap.end(); ++it)
       { // loop over rows
          if (it->second.isFilled(it->first))
@@ -1718,35 +1789,29 @@ namespace gnsstk
          GNSSTK_THROW(Exception("Invalid indexes"));
       }
 
-      typename std::map<unsigned int, SparseVector<T>>::iterator it, jt;
+      typename SparseIndexMap<SparseVector<T>>::iterator it, jt;
       it = rowsMap.find(ii);
       jt = rowsMap.find(jj);
-      if (it == rowsMap.end())
+      if (it == rowsMap.end() && jt == rowsMap.end())
       {
-         if (jt == rowsMap.end())
-         {
-            return; // nothing to do
-         }
-         else
-         {
-            rowsMap[ii] = rowsMap[jj];
-            rowsMap.erase(jt);
-         }
+         return; // nothing to do
       }
-      else
+      if (it != rowsMap.end() && jt != rowsMap.end())
       {
-         if (jt == rowsMap.end())
-         {
-            rowsMap[jj] = rowsMap[ii];
-            rowsMap.erase(it);
-         }
-         else
-         {
-            SparseVector<T> save(it->second);
-            rowsMap[ii] = rowsMap[jj];
-            rowsMap[jj] = save;
-         }
+         std::swap(it->second, jt->second);
+         return;
       }
+
+      // only one of the rows exists; move it to the other index
+      unsigned int to(ii);
+      if (it != rowsMap.end())
+      {
+         to = jj;
+         jt = it;
+      }
+      SparseVector<T> save(std::move(jt->second));
+      rowsMap.erase(jt);
+      rowsMap[to] = std::move(save);
    }
 
       /// swap columns of this SparseMatrix
@@ -1761,7 +1826,7 @@ namespace gnsstk
       // may not be the fastest, but may be fast enough - tranpose() is fast
       SparseMatrix<T> trans(transpose(*this));
       trans.swapRows(ii, jj);
-      *this = transpose(*this);
+      *this = transpose(trans);
    }
 
    //---------------------------------------------------------------------------------
@@ -1797,31 +1862,13 @@ namespace gnsstk
 
    //---------------------------------------------------------------------------------
    // SM * transpose(SM)
-   // NB this is barely faster than just forming SM * transpose(SM)
+   // NB this is the same as forming SM * transpose(SM)
    template <class T>
    SparseMatrix<T> matrixTimesTranspose(const SparseMatrix<T>& SM)
    {
       try
       {
-         SparseMatrix<T> toRet(SM.rows(), SM.rows());
-
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it,
-            jt;
-         for (it = SM.rowsMap.begin(); it != SM.rowsMap.end(); ++it)
-         {
-            SparseVector<T> Vrow(SM.rows());
-            toRet.rowsMap[it->first] = Vrow;
-            for (jt = SM.rowsMap.begin(); jt != SM.rowsMap.end(); ++jt)
-            {
-               T d(dot(it->second, jt->second));
-               if (d != T(0))
-               {
-                  toRet.rowsMap[it->first][jt->first] = d;
-               }
-            }
-         }
-
-         return toRet;
+         return (SM * transpose(SM));
       }
       catch (Exception& e)
       {
@@ -1843,8 +1890,8 @@ namespace gnsstk
          }
 
          const unsigned int n(P.cols());
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator jt;
-         typename std::map<unsigned int, T>::const_iterator vt;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator jt;
+         typename SparseIndexMap<T>::const_iterator vt;
 
          Vector<T> toRet(P.rows(), T(0));
          T sum;
@@ -1901,7 +1948,7 @@ namespace gnsstk
          unsigned int i, k;
          T dtmp;
          // T big, small;
-         typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
+         typename SparseIndexMap<SparseVector<T>>::const_iterator it;
 
          // does A have any zero rows?
          for (it = A.rowsMap.begin(), i = 0; it != A.rowsMap.end(); i++, ++it)
@@ -1915,8 +1962,8 @@ namespace gnsstk
          }
 
          const unsigned int N(A.rows());
-         typename std::map<unsigned int, SparseVector<T>>::iterator jt, kt;
-         typename std::map<unsigned int, T>::iterator vt;
+         typename SparseIndexMap<SparseVector<T>>::iterator jt, kt;
+         typename SparseIndexMap<T>::iterator vt;
          SparseMatrix<T> GJ(A || identSparse<T>(N));
 
          // std::cout << "\nInitial:\n" << std::scientific
@@ -1989,7 +2036,7 @@ namespace gnsstk
 
          // loop over rows of work matrix in reverse order,
          // zero-ing out the column above the diag
-         typename std::map<unsigned int, SparseVector<T>>::reverse_iterator rjt,
+         typename SparseIndexMap<SparseVector<T>>::reverse_iterator rjt,
             rkt;
          for (rjt = GJ.rowsMap.rbegin(); rjt != GJ.rowsMap.rend(); ++rjt)
          {
@@ -2076,8 +2123,8 @@ namespace gnsstk
       T d, diag;
       SparseMatrix<T> L(n, n); // compute the answer
       std::vector<T> rowSums;  // keep sum(k=0..j-1)[L(j,k)^2] for each row j
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it, jt;
-      typename std::map<unsigned int, SparseVector<T>>::iterator Lit, Ljt;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it, jt;
+      typename SparseIndexMap<SparseVector<T>>::iterator Lit, Ljt;
 
       // A must have all rows - a zero row in A means its singular
       // create all the rows in L; all exist b/c if any diagonal is 0 ->
@@ -2166,8 +2213,8 @@ namespace gnsstk
 
       // trick is to fill transpose(inverse) and then transpose at the end
       SparseMatrix<T> invLT(L.cols(), L.rows());
-      typename std::map<unsigned int, SparseVector<T>>::const_iterator it;
-      typename std::map<unsigned int, SparseVector<T>>::iterator jt;
+      typename SparseIndexMap<SparseVector<T>>::const_iterator it;
+      typename SparseIndexMap<SparseVector<T>>::iterator jt;
 
       // do the diagonal first; this finds singularities and defines all rows in
       // InvLT
@@ -2210,7 +2257,7 @@ namespace gnsstk
          dum = T(1) / it->second[it->first]; // has to be there, and non-zero
          // loop over columns of invL (rows of invLT) before the diagonal
          // store results temporarily in a map
-         std::map<unsigned int, T> tempMap;
+         SparseIndexMap<T> tempMap;
          // for(j=0; j<i; j++)
          for (jt = invLT.rowsMap.begin(); jt != invLT.rowsMap.end(); ++jt)
          {
@@ -2228,7 +2275,7 @@ namespace gnsstk
             // jt->second.vecMap[it->first] = -dum*sum;
          }
          // now move contents of tempMap to invLT
-         typename std::map<unsigned int, T>::iterator tt = tempMap.begin();
+         typename SparseIndexMap<T>::iterator tt = tempMap.begin();
          for (; tt != tempMap.end(); ++tt)
             invLT.rowsMap[tt->first].vecMap[it->first] =
                tt->second; // invLT(j,i)
@@ -2296,32 +2343,35 @@ namespace gnsstk
    template <class T>
    SparseMatrix<T> SparseHouseholder(const SparseMatrix<T>& A)
    {
-      unsigned int i, j, k;
-      typename std::map<unsigned int, SparseVector<T>>::iterator jt, kt, it;
-      typename std::map<unsigned int, T>::iterator vt;
+      unsigned int j, k;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
+      typename SparseIndexMap<T>::iterator vt;
 
-      SparseMatrix<T> AT(
-         transpose(A)); // perform the algorithm on the transpose
+      // perform the algorithm on the columns of A, each held by index so
+      // that columns filled in by the transformation cost no insertions
+      SparseMatrix<T> AT(transpose(A));
+      std::vector<SparseVector<T>> cols(A.cols(), SparseVector<T>(A.rows()));
+      for (it = AT.rowsMap.begin(); it != AT.rowsMap.end(); ++it)
+      {
+         cols[it->first] = std::move(it->second);
+      }
+      AT.rowsMap.clear();
 
-      // loop over rows (columns of input A)
+      // loop over columns of input A
       for (j = 0; (j < A.cols() - 1 && j < A.rows() - 1); j++)
       {
-         jt = AT.rowsMap.find(j);    // is column j there?
-         if (jt == AT.rowsMap.end()) // no, so A is already zero below diag
+         SparseVector<T>& Aj(cols[j]);
+         if (Aj.isEmpty()) // A is already zero below diag
          {
             continue;
          }
 
-         // pull out column j (use only below and including diagonal, ignore
-         // V(i<j))
-         SparseVector<T> V(jt->second);
+         // pull out column j at and below the diagonal
+         SparseVector<T> V(A.rows());
          T sum(0);
-         for (vt = V.vecMap.begin(); vt != V.vecMap.end(); ++vt)
+         for (vt = Aj.vecMap.lower_bound(j); vt != Aj.vecMap.end(); ++vt)
          {
-            if (vt->first < j)
-            {
-               continue;
-            }
+            V.vecMap.push_back(vt->first, vt->second);
             sum += vt->second * vt->second;
          }
          if (sum < T(1.e-20))
@@ -2330,11 +2380,7 @@ namespace gnsstk
          }
 
          // zero out below diagonal - must remove element
-         vt = jt->second.vecMap.lower_bound(jt->first);
-         if (vt != jt->second.vecMap.end())
-         {
-            jt->second.vecMap.erase(vt, jt->second.vecMap.end());
-         }
+         Aj.truncate(j);
 
          sum = SQRT(sum);
          vt  = V.vecMap.find(j);
@@ -2344,57 +2390,37 @@ namespace gnsstk
             {
                sum = -sum;
             }
-            jt->second[j] = sum; // A(j,j) = sum
-            vt->second -= sum;   // V(j) -= sum
+            Aj.vecMap.push_back(j, sum); // A(j,j) = sum
+            vt->second -= sum;           // V(j) -= sum
             sum = T(1) / (sum * vt->second);
          }
          else
          {
-            jt->second[j] = sum;  // A(j,j) = sum
-            V.vecMap[j]   = -sum; // V(j) -= sum
-            sum           = T(-1) / (sum * sum);
+            Aj.vecMap.push_back(j, sum); // A(j,j) = sum
+            V.vecMap[j] = -sum;          // V(j) -= sum
+            sum         = T(-1) / (sum * sum);
          }
 
          // loop over columns beyond j
-         kt = jt;
-         for (++kt; kt != AT.rowsMap.end(); ++kt)
+         for (k = j + 1; k < A.cols(); k++)
          {
-            T alpha(0);
-            for (vt = kt->second.vecMap.begin(); vt != kt->second.vecMap.end();
-                 ++vt)
-            {
-               if (vt->first < j)
-               {
-                  continue;
-               }
-               i = vt->first;
-               if (V.isFilled(i)) // alpha += A(i,k)*V(i)
-               {
-                  alpha += vt->second * V.vecMap[i];
-               }
-            }
+            // alpha = sum(i>=j) A(i,k)*V(i); V is zero above j
+            T alpha(dot(cols[k], V));
             alpha *= sum;
             if (alpha == T(0))
             {
                continue;
             }
             // modify column k at and below j
-            for (i = jt->first; i < AT.cols(); i++)
-            {
-               if (!V.isFilled(i))
-               {
-                  continue;
-               }
-               vt = kt->second.vecMap.find(i);
-               if (vt == kt->second.vecMap.end())
-               { // create element
-                  kt->second.vecMap[i] = alpha * V.vecMap[i];
-               }
-               else
-               {
-                  kt->second.vecMap[i] += alpha * V.vecMap[i];
-               }
-            }
+            cols[k].addScaledSparseVector(alpha, V);
+         }
+      }
+
+      for (k = 0; k < A.cols(); k++)
+      {
+         if (!cols[k].isEmpty())
+         {
+            AT.rowsMap.push_back(k, std::move(cols[k]));
          }
       }
 
@@ -2470,8 +2496,8 @@ namespace gnsstk
       // if necessary, create R and Z
       if (A.cols() > 1 && R.rows() == 0 && Z.size() == 0)
       {
-         R = Matrix<double>(A.cols() - 1, A.cols() - 1, 0.0);
-         Z = Vector<double>(A.cols() - 1, 0.0);
+         R = Matrix<T>(A.cols() - 1, A.cols() - 1, T(0));
+         Z = Vector<T>(A.cols() - 1, T(0));
       }
 
       if (A.cols() <= 1 || A.cols() != R.cols() + 1 || Z.size() < R.rows())
@@ -2487,24 +2513,30 @@ namespace gnsstk
       const unsigned int m(M == 0 || M > A.rows() ? A.rows() : M), n(R.rows());
       const unsigned int np1(n +
                              1); // if np1 = n, state vector Z is not updated
-      unsigned int i, j, k;
+      unsigned int j, k;
       T dum, delta, beta;
-      typename std::map<unsigned int, SparseVector<T>>::iterator jt, kt, it;
-      typename std::map<unsigned int, T>::iterator vt;
+      typename SparseIndexMap<SparseVector<T>>::iterator it;
+      typename SparseIndexMap<T>::const_iterator vt;
 
-      SparseMatrix<T> AT(transpose(A)); // work with the transpose
+      // work with the columns of A, rows 0..m-1 only, each held by index so
+      // that columns filled in by the update cost no insertions
+      SparseMatrix<T> AT(transpose(A));
+      std::vector<SparseVector<T>> cols(np1, SparseVector<T>(A.rows()));
+      for (it = AT.rowsMap.begin(); it != AT.rowsMap.end(); ++it)
+      {
+         cols[it->first] = std::move(it->second);
+         cols[it->first].truncate(m);
+      }
 
       for (j = 0; j < n; j++)
-      {                           // loop over columns
-         jt = AT.rowsMap.find(j); // is column j empty?
-         if (jt ==
-             AT.rowsMap.end()) //   no, so A is already zero below the diagonal
+      {                                   // loop over columns
+         const SparseVector<T>& Vj(cols[j]); // column j of A
+         if (Vj.isEmpty())                //   A is already zero below diagonal
          {
             continue;
          }
 
-         // pull out column j of A; it is entirely below the diagonal
-         SparseVector<T> Vj(jt->second);
+         // column j of A is entirely below the diagonal
          T sum(dot(Vj, Vj));
          // T sum(0);
          // for(i=0; i<m; i++)
@@ -2530,24 +2562,9 @@ namespace gnsstk
          }
          beta = T(1) / beta;
 
-         kt = jt;
          for (k = j + 1; k < np1; k++)
-         {                         // columns to right of diagonal (j,j)
-            SparseVector<T> Vk(m); // will be column k of A
-
-            if (kt->first == k - 1)
-            {
-               ++kt; // kt now points to next column -- is it k?
-            }
-            if (kt->first != k)
-            { // no col k - should create a column in A...
-               AT.rowsMap[k] = Vk;
-               kt            = AT.rowsMap.find(k);
-            }
-            else
-            {
-               Vk = kt->second; // now Vk is column k of A, perhaps empty
-            }
+         {                                // columns to right of diagonal (j,j)
+            SparseVector<T>& Vk(cols[k]); // column k of A, perhaps empty
 
             sum = delta * (k == n ? Z(j) : R(j, k));
             sum += dot(Vk, Vj);
@@ -2568,57 +2585,49 @@ namespace gnsstk
                R(j, k) += sum * delta;
             }
 
-            vt = kt->second.vecMap.begin();
-            for (i = 0; i < m; i++)
-            {  // loop over rows in column k
-               //      A(i,k) += sum * A(i,j);
-               if (vt != kt->second.vecMap.end() && vt->first == i)
-               {
-                  vt->second += sum * Vj.vecMap[i];
-                  ++vt;
-               }
-               else
-               {
-                  kt->second.vecMap[i] = sum * Vj.vecMap[i];
-               }
-            }
+            // A(i,k) += sum * A(i,j), for the non-zero A(i,j)
+            Vk.addScaledSparseVector(sum, Vj);
          }
       }
 
-      // must put last row of AT (last column of A) back into A - these are
-      // residuals
-      jt = AT.rowsMap.find(AT.rows() - 1);
-      // should never happen
-      if (jt == AT.rowsMap.end())
-      {
-         GNSSTK_THROW(Exception("Failure on last column"));
-      }
-
-      // put this row, jt->second, into the last column of A
-      j  = A.cols() - 1;
-      i  = 0;
+      // must put column n of A back into the last column of A, rows 0..m-1
+      // - these are residuals. Merge them into the rows of A in one pass.
+      const SparseIndexMap<T>& resid(cols[n].vecMap);
+      SparseIndexMap<SparseVector<T>> rows;
       it = A.rowsMap.begin();
-      vt = jt->second.vecMap.begin();
-      while (it != A.rowsMap.end() && vt != jt->second.vecMap.end())
+      vt = resid.begin();
+      while (it != A.rowsMap.end() || vt != resid.end())
       {
-         if (it->first > vt->first)
+         if (vt == resid.end() ||
+             (it != A.rowsMap.end() && it->first < vt->first))
+         { // no residual in this row
+            if (it->first < m)
+            {
+               it->second.vecMap.erase(n);
+            }
+            if (!it->second.isEmpty())
+            {
+               rows.push_back(it->first, std::move(it->second));
+            }
+            ++it;
+         }
+         else if (it == A.rowsMap.end() || vt->first < it->first)
          { // A has no row at index vt->first
             SparseVector<T> SV(A.cols());
-            SV.vecMap[j]         = vt->second;
-            A.rowsMap[vt->first] = SV;
+            SV.vecMap.push_back(n, vt->second);
+            rows.push_back(vt->first, std::move(SV));
             ++vt;
          }
-         else if (vt->first > it->first)
-         { // resids are missing at this row
-            ++it;
-         }
          else
-         { // match - equal indexes
-            A.rowsMap[vt->first].vecMap[j] = vt->second;
+         { // match - equal indexes; residual is the last element
+            it->second.vecMap.erase(n);
+            it->second.vecMap.push_back(n, vt->second);
+            rows.push_back(it->first, std::move(it->second));
             ++it;
             ++vt;
          }
       }
+      A.rowsMap.swap(rows);
 
    } // end SrifMU
 
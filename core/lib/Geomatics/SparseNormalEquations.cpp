@@ -0,0 +1,512 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file SparseNormalEquations.cpp
+ * Implementation of class SparseNormalEquations, which accumulates block
+ * sparse normal equations and solves them by eliminating the local parameters
+ * of each block with a Schur complement.
+ */
+
+// -----------------------------------------------------------------------------------
+// system
+#include <string>
+#include <vector>
+// geomatics
+#include "SRIMatrix.hpp"
+#include "SparseNormalEquations.hpp"
+// GNSSTk
+#include "StringUtils.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   using namespace StringUtils;
+
+      // -----------------------------------------------------------------------------
+   SparseNormalEquations::SparseNormalEquations(const Namelist& globals)
+         : valid(false), ndata(0), sumDWD(0.0)
+   {
+      addGlobals(globals);
+   }
+
+      // -----------------------------------------------------------------------------
+   void SparseNormalEquations::addGlobals(const Namelist& globals)
+   {
+      Namelist toAdd;
+      for (unsigned int i = 0; i < globals.size(); i++)
+      {
+         const string name(globals.getName(i));
+         if (globalNames.contains(name) || toAdd.contains(name))
+         {
+            continue;
+         }
+         map<string, Block>::const_iterator it;
+         for (it = blocks.begin(); it != blocks.end(); ++it)
+         {
+            if (it->second.names.contains(name))
+            {
+               Exception e("Global parameter " + name +
+                           " is a local parameter of block " + it->first);
+               GNSSTK_THROW(e);
+            }
+         }
+         toAdd += name;
+      }
+      if (toAdd.size() == 0)
+      {
+         return;
+      }
+
+         // extend Ngg and bg, keeping the information already accumulated
+      const unsigned int n(globalNames.size()), nnew(n + toAdd.size());
+      Matrix<double> N(nnew, nnew, 0.0);
+      Vector<double> b(nnew, 0.0);
+      for (unsigned int i = 0; i < n; i++)
+      {
+         b(i) = bg(i);
+         for (unsigned int j = 0; j < n; j++)
+            N(i, j) = Ngg(i, j);
+      }
+      Ngg = N;
+      bg  = b;
+      globalNames += toAdd;
+      valid = false;
+   }
+
+      // -----------------------------------------------------------------------------
+   void SparseNormalEquations::addBlock(const string& block,
+                                        const Namelist& locals)
+   {
+      if (block.empty() || blocks.find(block) != blocks.end())
+      {
+         Exception e("Invalid or duplicate block label '" + block + "'");
+         GNSSTK_THROW(e);
+      }
+      if (locals.size() == 0 || !locals.valid())
+      {
+         Exception e("Invalid Namelist for block " + block);
+         GNSSTK_THROW(e);
+      }
+      for (unsigned int i = 0; i < locals.size(); i++)
+      {
+         if (globalNames.contains(locals.getName(i)))
+         {
+            Exception e("Local parameter " + locals.getName(i) + " of block " +
+                        block + " is a global parameter");
+            GNSSTK_THROW(e);
+         }
+      }
+
+      Block& B(blocks[block]);
+      B.names = locals;
+      B.Nkk   = Matrix<double>(locals.size(), locals.size(), 0.0);
+      B.bk    = Vector<double>(locals.size(), 0.0);
+      B.Nkg   = Matrix<double>(locals.size(), 0, 0.0);
+      blockLabels.push_back(block);
+      valid = false;
+   }
+
+      // -----------------------------------------------------------------------------
+   void SparseNormalEquations::addData(const string& block,
+                                       const Namelist& names,
+                                       const Matrix<double>& H,
+                                       const Vector<double>& D)
+   {
+      try
+      {
+         addData(block, names, H, D, Vector<double>(D.size(), 1.0));
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+      // -----------------------------------------------------------------------------
+   void SparseNormalEquations::addData(const string& block,
+                                       const Namelist& names,
+                                       const Matrix<double>& H,
+                                       const Vector<double>& D,
+                                       const Vector<double>& W)
+   {
+      const unsigned int m(H.rows()), p(H.cols());
+      if (p != names.size() || D.size() != m || W.size() != m)
+      {
+         MatrixException me(
+            "Invalid dimensions in addData(): H is " + asString<int>(m) + "x" +
+            asString<int>(p) + ", names has length " +
+            asString<int>(names.size()) + ", D has length " +
+            asString<int>(D.size()) + " and W has length " +
+            asString<int>(W.size()));
+         GNSSTK_THROW(me);
+      }
+
+      Block *B(nullptr);
+      if (!block.empty())
+      {
+         map<string, Block>::iterator it(blocks.find(block));
+         if (it == blocks.end())
+         {
+            Exception e("Unknown block " + block);
+            GNSSTK_THROW(e);
+         }
+         B = &it->second;
+      }
+
+         // classify the columns of H: local index (>=0), or global index
+         // (local index < 0) and its column in Nkg
+      vector<int> local(p, -1);
+      vector<unsigned int> global(p, 0), coupling(p, 0);
+      for (unsigned int a = 0; a < p; a++)
+      {
+         const string name(names.getName(a));
+         if (B)
+         {
+            local[a] = B->names.index(name);
+         }
+         if (local[a] >= 0)
+         {
+            continue;
+         }
+         const int g(globalNames.index(name));
+         if (g < 0)
+         {
+            Exception e("Unknown parameter " + name +
+                        (B ? " for block " + block : string()));
+            GNSSTK_THROW(e);
+         }
+         global[a] = g;
+      }
+      if (B)
+      {
+         for (unsigned int a = 0; a < p; a++)
+         {
+            if (local[a] < 0)
+            {
+               coupling[a] = couplingColumn(*B, global[a]);
+            }
+         }
+      }
+
+         // form H^T*W*H and H^T*W*D for these columns only
+      Matrix<double> N(p, p, 0.0);
+      Vector<double> b(p, 0.0);
+      for (unsigned int i = 0; i < m; i++)
+      {
+         const double w(W(i)), wd(w * D(i));
+         sumDWD += wd * D(i);
+         for (unsigned int a = 0; a < p; a++)
+         {
+            const double wha(w * H(i, a));
+            if (wha == 0.0)
+            {
+               continue;
+            }
+            b(a) += H(i, a) * wd;
+            for (unsigned int c = a; c < p; c++)
+               N(a, c) += wha * H(i, c);
+         }
+      }
+
+         // scatter them into the blocks of the normal equations
+      for (unsigned int a = 0; a < p; a++)
+      {
+         if (local[a] >= 0)
+         {
+            B->bk(local[a]) += b(a);
+         }
+         else
+         {
+            bg(global[a]) += b(a);
+         }
+
+         for (unsigned int c = a; c < p; c++)
+         {
+            const double n(N(a, c));
+            if (n == 0.0)
+            {
+               continue;
+            }
+            if (local[a] >= 0 && local[c] >= 0)
+            {
+               B->Nkk(local[a], local[c]) += n;
+               if (a != c)
+               {
+                  B->Nkk(local[c], local[a]) += n;
+               }
+            }
+            else if (local[a] >= 0)
+            {
+               B->Nkg(local[a], coupling[c]) += n;
+            }
+            else if (local[c] >= 0)
+            {
+               B->Nkg(local[c], coupling[a]) += n;
+            }
+            else
+            {
+               Ngg(global[a], global[c]) += n;
+               if (a != c)
+               {
+                  Ngg(global[c], global[a]) += n;
+               }
+            }
+         }
+      }
+
+      ndata += m;
+      valid = false;
+   }
+
+      // -----------------------------------------------------------------------------
+   unsigned int SparseNormalEquations::couplingColumn(Block& B, unsigned int g)
+   {
+      for (unsigned int k = 0; k < B.gindex.size(); k++)
+      {
+         if (B.gindex[k] == g)
+         {
+            return k;
+         }
+      }
+
+         // first data coupling this block to g - add a column to Nkg
+      const unsigned int nl(B.names.size()), nc(B.gindex.size());
+      Matrix<double> Nkg(nl, nc + 1, 0.0);
+      for (unsigned int i = 0; i < nl; i++)
+         for (unsigned int j = 0; j < nc; j++)
+            Nkg(i, j) = B.Nkg(i, j);
+      B.Nkg = Nkg;
+      B.gindex.push_back(g);
+      return nc;
+   }
+
+      // -----------------------------------------------------------------------------
+   void SparseNormalEquations::solve()
+   {
+      const unsigned int ng(globalNames.size());
+      Matrix<double> N(Ngg);
+      Vector<double> b(bg);
+      valid = false;
+
+         // eliminate the local parameters of each block:
+         // N -= Ngk*inverse(Nkk)*Nkg, b -= Ngk*inverse(Nkk)*bk
+      for (unsigned int k = 0; k < blockLabels.size(); k++)
+      {
+         Block& B(blocks[blockLabels[k]]);
+         try
+         {
+            B.Ninv = inverseCholesky(B.Nkk);
+         }
+         catch (Exception& e)
+         {
+            e.addText("Local parameters of block " + blockLabels[k] +
+                      " are singular");
+            GNSSTK_RETHROW(e);
+         }
+         B.X = B.Ninv * B.bk; // solution with the global parameters zero
+
+         const unsigned int nc(B.gindex.size());
+         if (nc == 0)
+         {
+            continue;
+         }
+         B.M = B.Ninv * B.Nkg;
+         const Matrix<double> S(transpose(B.Nkg) * B.M);
+         const Vector<double> s(transpose(B.Nkg) * B.X);
+         for (unsigned int i = 0; i < nc; i++)
+         {
+            b(B.gindex[i]) -= s(i);
+            for (unsigned int j = 0; j < nc; j++)
+               N(B.gindex[i], B.gindex[j]) -= S(i, j);
+         }
+      }
+
+         // solve the reduced global system
+      if (ng > 0)
+      {
+         try
+         {
+            Cgg = inverseCholesky(N);
+         }
+         catch (Exception& e)
+         {
+            e.addText("Global parameters are singular");
+            GNSSTK_RETHROW(e);
+         }
+         Xg = Cgg * b;
+      }
+      else
+      {
+         Cgg = Matrix<double>();
+         Xg  = Vector<double>();
+      }
+
+         // back substitute for the local parameters:
+         // Xk = inverse(Nkk)*(bk - Nkg*Xg)
+      for (unsigned int k = 0; k < blockLabels.size(); k++)
+      {
+         Block& B(blocks[blockLabels[k]]);
+         for (unsigned int j = 0; j < B.gindex.size(); j++)
+         {
+            const double x(Xg(B.gindex[j]));
+            for (unsigned int i = 0; i < B.X.size(); i++)
+               B.X(i) -= B.M(i, j) * x;
+         }
+      }
+
+      valid = true;
+   }
+
+      // -----------------------------------------------------------------------------
+   void SparseNormalEquations::zeroAll()
+   {
+      Ngg = 0.0;
+      bg  = 0.0;
+      map<string, Block>::iterator it;
+      for (it = blocks.begin(); it != blocks.end(); ++it)
+      {
+         it->second.Nkk = 0.0;
+         it->second.bk  = 0.0;
+         it->second.Nkg = Matrix<double>(it->second.names.size(), 0, 0.0);
+         it->second.gindex.clear();
+      }
+      ndata  = 0;
+      sumDWD = 0.0;
+      valid  = false;
+   }
+
+      // -----------------------------------------------------------------------------
+   const SparseNormalEquations::Block&
+   SparseNormalEquations::findBlock(const string& block) const
+   {
+      map<string, Block>::const_iterator it(blocks.find(block));
+      if (it == blocks.end())
+      {
+         Exception e("Unknown block " + block);
+         GNSSTK_THROW(e);
+      }
+      return it->second;
+   }
+
+      // -----------------------------------------------------------------------------
+   void SparseNormalEquations::checkValid(const string& where) const
+   {
+      if (!valid)
+      {
+         Exception e(where + ": no valid solution; call solve()");
+         GNSSTK_THROW(e);
+      }
+   }
+
+      // -----------------------------------------------------------------------------
+   const Namelist& SparseNormalEquations::getLocalNames(const string& block) const
+   {
+      try
+      {
+         return findBlock(block).names;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+      // -----------------------------------------------------------------------------
+   Vector<double> SparseNormalEquations::getGlobalSolution() const
+   {
+      checkValid("getGlobalSolution()");
+      return Xg;
+   }
+
+      // -----------------------------------------------------------------------------
+   Matrix<double> SparseNormalEquations::getGlobalCovariance() const
+   {
+      checkValid("getGlobalCovariance()");
+      return Cgg;
+   }
+
+      // -----------------------------------------------------------------------------
+   Vector<double> SparseNormalEquations::getLocalSolution(const string& block) const
+   {
+      checkValid("getLocalSolution()");
+      return findBlock(block).X;
+   }
+
+      // -----------------------------------------------------------------------------
+   Matrix<double>
+   SparseNormalEquations::getLocalCovariance(const string& block) const
+   {
+      checkValid("getLocalCovariance()");
+      const Block& B(findBlock(block));
+      Matrix<double> C(B.Ninv);
+      const unsigned int nc(B.gindex.size());
+      if (nc == 0)
+      {
+         return C;
+      }
+
+         // Cgg restricted to the global parameters coupled to this block
+      Matrix<double> Ck(nc, nc);
+      for (unsigned int i = 0; i < nc; i++)
+         for (unsigned int j = 0; j < nc; j++)
+            Ck(i, j) = Cgg(B.gindex[i], B.gindex[j]);
+      C += B.M * Ck * transpose(B.M);
+      return C;
+   }
+
+      // -----------------------------------------------------------------------------
+   double SparseNormalEquations::getSumSquaredResiduals() const
+   {
+      checkValid("getSumSquaredResiduals()");
+         // X^T*b summed over the global and all the local parameters
+      double xb(0.0);
+      for (unsigned int i = 0; i < Xg.size(); i++)
+         xb += Xg(i) * bg(i);
+      map<string, Block>::const_iterator it;
+      for (it = blocks.begin(); it != blocks.end(); ++it)
+      {
+         for (unsigned int i = 0; i < it->second.X.size(); i++)
+            xb += it->second.X(i) * it->second.bk(i);
+      }
+      return (sumDWD - xb);
+   }
+
+} // end namespace gnsstk
@@ -0,0 +1,271 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file SparseNormalEquations.hpp
+ * Include file defining class SparseNormalEquations, which accumulates the
+ * normal equations of a large least squares problem with block structure -
+ * many blocks of local parameters (e.g. per-station clocks and troposphere)
+ * coupled only through a set of global parameters (e.g. satellite-shared
+ * parameters) - and solves them by eliminating the local parameters of each
+ * block with a Schur complement before solving the global system.
+ */
+
+//------------------------------------------------------------------------------------
+#ifndef CLASS_SPARSE_NORMAL_EQUATIONS_INCLUDE
+#define CLASS_SPARSE_NORMAL_EQUATIONS_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <map>
+#include <string>
+#include <vector>
+// GNSSTk
+#include "Matrix.hpp"
+#include "Vector.hpp"
+// geomatics
+#include "Namelist.hpp"
+
+namespace gnsstk
+{
+
+   //---------------------------------------------------------------------------------
+      /**
+       class SparseNormalEquations accumulates and solves the normal equations
+       N*X = b (N = sum H^T*W*H, b = sum H^T*W*D) of a least squares problem
+       whose state is a set of global parameters plus any number of blocks of
+       local parameters, where data couple the parameters of at most one block
+       to the global parameters. N is then block sparse:
+       @code
+            | N11           N1g |
+            |      N22      N2g |
+        N = |           ... ... |
+            | Ng1  Ng2  ... Ngg |
+       @endcode
+       and is stored that way: each block keeps its own dense Nkk and bk, and
+       Nkg only for the global parameters its data actually touched; only Ngg
+       is dense over all the global parameters. Nothing of size (total number
+       of parameters)^2 is ever formed.
+
+       solve() eliminates the local parameters of each block in turn, replacing
+       Ngg with the Schur complement Ngg - Ngk*inverse(Nkk)*Nkg (and bg
+       likewise), solves the reduced global system, then recovers the local
+       solution of each block by back substitution. The cost is linear in the
+       number of blocks.
+
+       Parameters are labelled with Namelists: the global Namelist, and one per
+       block. A local label need only be unique within its block, so every
+       station may have a parameter called "Clock"; but a local label may not
+       also be a global label.
+      */
+   class SparseNormalEquations
+   {
+   public:
+         /// empty constructor - no global parameters
+      SparseNormalEquations() : valid(false), ndata(0), sumDWD(0.0) {}
+
+         /**
+          constructor given the global parameters
+          @param globals Namelist of the global parameters
+         */
+      explicit SparseNormalEquations(const Namelist& globals);
+
+         /**
+          add global parameters; labels already present are ignored. Any
+          previous solution is invalidated.
+          @param globals Namelist of the global parameters to add
+          @throw Exception if a label is a local label of some block
+         */
+      void addGlobals(const Namelist& globals);
+
+         /**
+          add a block of local parameters
+          @param block  label of the new block (e.g. the station name)
+          @param locals Namelist of the local parameters of the block
+          @throw Exception if the block exists, locals is empty or not valid,
+                 or a label is also a global label
+         */
+      void addBlock(const std::string& block, const Namelist& locals);
+
+         /**
+          accumulate data with unit weight (data that are already whitened).
+          @param block label of the block that the data belong to, or the
+                       empty string if the data depend on global parameters
+                       only
+          @param names labels of the columns of H; each must be global, or
+                       local to block
+          @param H     partials matrix, M x names.size()
+          @param D     data (pre-fit residuals), length M
+          @throw MatrixException if the dimensions are inconsistent
+          @throw Exception if the block or a label is unknown
+         */
+      void addData(const std::string& block, const Namelist& names,
+                   const Matrix<double>& H, const Vector<double>& D);
+
+         /**
+          accumulate data with diagonal weights (inverse variances)
+          @param block as above
+          @param names as above
+          @param H     as above
+          @param D     as above
+          @param W     weights of the data, length M
+          @throw MatrixException if the dimensions are inconsistent
+          @throw Exception if the block or a label is unknown
+         */
+      void addData(const std::string& block, const Namelist& names,
+                   const Matrix<double>& H, const Vector<double>& D,
+                   const Vector<double>& W);
+
+         /**
+          eliminate the local parameters, solve the global system and then
+          the local systems.
+          @throw SingularMatrixException if the information for the global
+                 parameters, or for the local parameters of a block, is
+                 singular; the text names the block.
+         */
+      void solve();
+
+         /// true if solve() succeeded and no data were added since
+      bool isValid() const { return valid; }
+
+         /// zero the accumulated information, keeping all the parameters
+      void zeroAll();
+
+         /// Namelist of the global parameters
+      const Namelist& getGlobalNames() const { return globalNames; }
+
+         /// labels of the blocks, in the order they were added
+      std::vector<std::string> getBlocks() const { return blockLabels; }
+
+         /**
+          Namelist of the local parameters of a block
+          @throw Exception if the block is unknown
+         */
+      const Namelist& getLocalNames(const std::string& block) const;
+
+         /// number of data accumulated
+      unsigned int getNumberOfData() const { return ndata; }
+
+         /**
+          solution for the global parameters
+          @throw Exception if there is no valid solution
+         */
+      Vector<double> getGlobalSolution() const;
+
+         /**
+          covariance of the global parameters
+          @throw Exception if there is no valid solution
+         */
+      Matrix<double> getGlobalCovariance() const;
+
+         /**
+          solution for the local parameters of a block
+          @throw Exception if the block is unknown or there is no valid solution
+         */
+      Vector<double> getLocalSolution(const std::string& block) const;
+
+         /**
+          covariance of the local parameters of a block,
+          inverse(Nkk) + inverse(Nkk)*Nkg*Cgg*Ngk*inverse(Nkk)
+          @throw Exception if the block is unknown or there is no valid solution
+         */
+      Matrix<double> getLocalCovariance(const std::string& block) const;
+
+         /**
+          sum of the weighted squared post-fit residuals, D^T*W*D - X^T*b
+          @throw Exception if there is no valid solution
+         */
+      double getSumSquaredResiduals() const;
+
+   private:
+         /// normal equations of one block of local parameters
+      struct Block
+      {
+            /// labels of the local parameters
+         Namelist names;
+            /// local normal matrix Nkk, and inverse(Nkk) after solve()
+         Matrix<double> Nkk, Ninv;
+            /// local right hand side bk, and solution after solve()
+         Vector<double> bk, X;
+            /// indexes in globalNames of the columns of Nkg
+         std::vector<unsigned int> gindex;
+            /**
+             coupling Nkg, for the global parameters in gindex only, and
+             inverse(Nkk)*Nkg after solve()
+            */
+         Matrix<double> Nkg, M;
+      };
+
+         /// find a block, throwing if not found
+      const Block& findBlock(const std::string& block) const;
+
+         /**
+          column index in Nkg of global parameter g in block B; add the
+          column if it is not there
+         */
+      static unsigned int couplingColumn(Block& B, unsigned int g);
+
+         /// throw if there is no valid solution
+      void checkValid(const std::string& where) const;
+
+         /// global parameter labels
+      Namelist globalNames;
+         /// global normal matrix Ngg and right hand side bg
+      Matrix<double> Ngg;
+      Vector<double> bg;
+         /// blocks of local parameters, by label
+      std::map<std::string, Block> blocks;
+         /// block labels in the order added
+      std::vector<std::string> blockLabels;
+
+         /// global solution and covariance, after solve()
+      Vector<double> Xg;
+      Matrix<double> Cgg;
+         /// true after a successful solve()
+      bool valid;
+         /// number of data accumulated
+      unsigned int ndata;
+         /// sum of D^T*W*D over all data
+      double sumDWD;
+
+   }; // end class SparseNormalEquations
+
+} // end namespace gnsstk
+
+#endif
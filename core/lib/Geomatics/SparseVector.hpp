@@ -47,6 +47,7 @@
 
 #include <algorithm> // for find,lower_bound
 #include <map>
+#include <utility>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -59,6 +60,138 @@ namespace gnsstk
       /// forward declarations
    template <class T> class SparseVector;
    template <class T> class SparseMatrix;
+   template <class T> class SparseAccumulator;
+
+   //---------------------------------------------------------------------------
+      /**
+       Storage for the non-zero elements of SparseVector, and the rows of
+       SparseMatrix: (index, value) pairs kept in one contiguous array, sorted
+       by index. This presents the part of the interface of
+       std::map<unsigned int, V> used by the sparse classes, but traversal is a
+       linear scan of memory, lookup is a binary search, and appending in
+       index order, which is how sparse data is usually built, is amortized
+       O(1) with no per-element allocation. Unlike std::map, inserting or
+       erasing an element invalidates the iterators at and beyond it.
+      */
+   template <class V> class SparseIndexMap
+   {
+   public:
+      typedef std::pair<unsigned int, V> value_type;
+      typedef typename std::vector<value_type>::iterator iterator;
+      typedef typename std::vector<value_type>::const_iterator const_iterator;
+      typedef typename std::vector<value_type>::reverse_iterator
+         reverse_iterator;
+      typedef typename std::vector<value_type>::const_reverse_iterator
+         const_reverse_iterator;
+
+      iterator begin() { return elems.begin(); }
+      const_iterator begin() const { return elems.begin(); }
+      iterator end() { return elems.end(); }
+      const_iterator end() const { return elems.end(); }
+      reverse_iterator rbegin() { return elems.rbegin(); }
+      const_reverse_iterator rbegin() const { return elems.rbegin(); }
+      reverse_iterator rend() { return elems.rend(); }
+      const_reverse_iterator rend() const { return elems.rend(); }
+
+         /// number of elements stored
+      size_t size() const { return elems.size(); }
+         /// true if nothing is stored
+      bool empty() const { return elems.empty(); }
+         /// remove all elements
+      void clear() { elems.clear(); }
+         /// reserve space for n elements
+      void reserve(size_t n) { elems.reserve(n); }
+
+         /// first element with index >= key
+      iterator lower_bound(unsigned int key)
+      {
+         return std::lower_bound(elems.begin(), elems.end(), key, keyLess);
+      }
+         /// first element with index >= key
+      const_iterator lower_bound(unsigned int key) const
+      {
+         return std::lower_bound(elems.begin(), elems.end(), key, keyLess);
+      }
+
+         /// element with index key, or end()
+      iterator find(unsigned int key)
+      {
+         iterator it(lower_bound(key));
+         return ((it != elems.end() && it->first == key) ? it : elems.end());
+      }
+         /// element with index key, or end()
+      const_iterator find(unsigned int key) const
+      {
+         const_iterator it(lower_bound(key));
+         return ((it != elems.end() && it->first == key) ? it : elems.end());
+      }
+
+         /// element with index key, inserted (as V()) if not present
+      V& operator[](unsigned int key)
+      {
+         if (elems.empty() || elems.back().first < key)
+         {
+            elems.push_back(value_type(key, V()));
+            return elems.back().second;
+         }
+         iterator it(lower_bound(key));
+         if (it->first != key)
+         {
+            it = elems.insert(it, value_type(key, V()));
+         }
+         return it->second;
+      }
+
+         /// append an element; key must be greater than any index stored
+      void push_back(unsigned int key, const V& value)
+      {
+         elems.push_back(value_type(key, value));
+      }
+         /// append an element by moving it; key must be greater than any index
+      void push_back(unsigned int key, V&& value)
+      {
+         elems.push_back(value_type(key, std::move(value)));
+      }
+
+         /// exchange contents with another SparseIndexMap
+      void swap(SparseIndexMap<V>& other) { elems.swap(other.elems); }
+
+         /// remove one element
+      iterator erase(iterator it) { return elems.erase(it); }
+         /// remove a range of elements
+      iterator erase(iterator first, iterator last)
+      {
+         return elems.erase(first, last);
+      }
+         /// remove the element with index key, if present
+      size_t erase(unsigned int key)
+      {
+         iterator it(find(key));
+         if (it == elems.end())
+         {
+            return 0;
+         }
+         elems.erase(it);
+         return 1;
+      }
+
+         /// remove all elements for which pred(element) is true
+      template <class Pred> void eraseIf(Pred pred)
+      {
+         elems.erase(std::remove_if(elems.begin(), elems.end(), pred),
+                     elems.end());
+      }
+
+   private:
+      static bool keyLess(const value_type& e, unsigned int key)
+      {
+         return e.first < key;
+      }
+
+         /// the elements, in increasing order of index
+      std::vector<value_type> elems;
+
+   }; // end class SparseIndexMap
 
    //---------------------------------------------------------------------------
       /**
@@ -198,6 +331,15 @@ namespace gnsstk
    template <class T>
    SparseVector<T> operator*(const SparseMatrix<T>& L, const Vector<T>& V);
    template <class T>
+   SparseVector<T> operator*(const Matrix<T>& L, const SparseVector<T>& V);
+   template <class T>
+   SparseVector<T> operator*(const SparseVector<T>& V,
+                             const SparseMatrix<T>& R);
+   template <class T>
+   SparseVector<T> operator*(const SparseVector<T>& V, const Matrix<T>& R);
+   template <class T>
+   SparseVector<T> operator*(const Vector<T>& V, const SparseMatrix<T>& R);
+   template <class T>
    SparseMatrix<T> operator*(const SparseMatrix<T>& L,
                              const SparseMatrix<T>& R);
    template <class T>
@@ -261,7 +403,8 @@ namespace gnsstk
        Class SparseVector. This class is designed to present an interface nearly
        identical to class Vector, but more efficiently handle sparse vectors, in
        which most of the elements are zero. The class stores only non-zero
-       elements in a map with key = index; it also stores a nominal length. The
+       elements in a SparseIndexMap (a sorted array of index,value pairs) with
+       key = index; it also stores a nominal length. The
        class uses a proxy class, SVecProxy, to access elements; this allows
        rvalues and lvalues to be treated separately.
       */
@@ -271,6 +414,7 @@ namespace gnsstk
          /// Proxy needs access to vecMap
       friend class SVecProxy<T>;
       friend class SparseMatrix<T>;
+      friend class SparseAccumulator<T>;
 
          /// lots of friends
       // output stream operator
@@ -311,6 +455,14 @@ namespace gnsstk
                                           const SparseVector<T>& V);
       friend SparseVector<T> operator*<T>(const SparseMatrix<T>& L,
                                           const Vector<T>& V);
+      friend SparseVector<T> operator*<T>(const Matrix<T>& L,
+                                          const SparseVector<T>& V);
+      friend SparseVector<T> operator*<T>(const SparseVector<T>& V,
+                                          const SparseMatrix<T>& R);
+      friend SparseVector<T> operator*<T>(const SparseVector<T>& V,
+                                          const Matrix<T>& R);
+      friend SparseVector<T> operator*<T>(const Vector<T>& V,
+                                          const SparseMatrix<T>& R);
       friend SparseMatrix<T> operator*<T>(const SparseMatrix<T>& L,
                                           const SparseMatrix<T>& V);
       friend SparseMatrix<T> operator*<T>(const SparseMatrix<T>& L,
@@ -397,7 +549,7 @@ namespace gnsstk
          }
          else if (n < len)
          {
-            typename std::map<unsigned int, T>::iterator it;
+            typename SparseIndexMap<T>::iterator it;
             // lower_bound returns it for first key >= newlen
             it = vecMap.lower_bound(n);
             vecMap.erase(it, vecMap.end());
@@ -461,7 +613,7 @@ namespace gnsstk
          size_t i;
          oss << "len=" << len << ", N=" << vecMap.size();
          oss << (dosci ? std::scientific : std::fixed) << std::setprecision(p);
-         typename std::map<unsigned int, T>::const_iterator it = vecMap.begin();
+         typename SparseIndexMap<T>::const_iterator it = vecMap.begin();
          for (; it != vecMap.end(); ++it)
             oss << " " << it->first << "," << it->second; // << ")";
          return oss.str();
@@ -472,7 +624,7 @@ namespace gnsstk
       inline T sum(const SparseVector<T>& SV) const
       {
          T tot(0);
-         typename std::map<unsigned int, T>::iterator it = vecMap.begin();
+         typename SparseIndexMap<T>::iterator it = vecMap.begin();
          for (; it != vecMap.end(); ++it)
             tot += it->second;
          return tot;
@@ -493,15 +645,21 @@ namespace gnsstk
       {
          // std::cout << " SV unary minus with len " << len << std::endl;
          SparseVector<T> toRet(*this);
-         typename std::map<unsigned int, T>::iterator it;
+         typename SparseIndexMap<T>::iterator it;
          for (it = toRet.vecMap.begin(); it != toRet.vecMap.end(); ++it)
          {
-            toRet.vecMap[it->first] = -toRet.vecMap[it->first];
+            it->second = -it->second;
          }
          return toRet;
       }
 
    private:
+         /// this += a*R, as one merge of the sorted index arrays; elements
+         /// that become exactly zero are not stored. R may be *this.
+      void addScaledMerge(const T& a, const SparseVector<T>& R);
+         /// this += a*R for a full Vector R of length len, in one pass
+      void addScaledMerge(const T& a, const Vector<T>& R);
+
          /**
           length of the "real" vector (not the number of data stored =
           vecMap.size())
@@ -509,7 +667,7 @@ namespace gnsstk
       unsigned int len;
 
          /// map of index,value pairs; vecMap[index in real vector] = data element
-      std::map<unsigned int, T> vecMap;
+      SparseIndexMap<T> vecMap;
 
          /**
           return a vector containing all the indexes, in order, of non-zero
@@ -518,7 +676,7 @@ namespace gnsstk
       inline std::vector<unsigned int> getIndexes() const
       {
          std::vector<unsigned int> vecind;
-         typename std::map<unsigned int, T>::const_iterator it;
+         typename SparseIndexMap<T>::const_iterator it;
          for (it = vecMap.begin(); it != vecMap.end(); ++it)
             vecind.push_back(it->first);
          return vecind;
@@ -540,7 +698,7 @@ namespace gnsstk
    // get the value of the SparseVector at index
    template <class T> T SVecProxy<T>::value() const
    {
-      typename std::map<unsigned int, T>::iterator it = mySV.vecMap.find(index);
+      typename SparseIndexMap<T>::iterator it = mySV.vecMap.find(index);
       if (it != mySV.vecMap.end())
       {
          return it->second;
@@ -555,7 +713,7 @@ namespace gnsstk
       // zero or default - remove from map
       if (T(rhs) == T(0))
       {
-         typename std::map<unsigned int, T>::iterator it =
+         typename SparseIndexMap<T>::iterator it =
             mySV.vecMap.find(index);
          if (it != mySV.vecMap.end())
          {
@@ -566,7 +724,7 @@ namespace gnsstk
       // add/replace it in the map
       else
       {
-         (static_cast<std::map<unsigned int, T> &>(mySV.vecMap))[index] = rhs;
+         mySV.vecMap[index] = rhs;
       }
    }
 
@@ -574,7 +732,7 @@ namespace gnsstk
    // cast
    template <class T> SVecProxy<T>::operator T() const
    {
-      typename std::map<unsigned int, T>::iterator it = mySV.vecMap.find(index);
+      typename SparseIndexMap<T>::iterator it = mySV.vecMap.find(index);
       if (it != mySV.vecMap.end())
       {
          return (*it).second;
@@ -585,6 +743,76 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------
+      /**
+       Dense accumulator for forming sparse products one row (or one vector)
+       at a time, as in Gustavson's algorithm. Scaled sparse vectors are
+       scattered into a dense array of the full length, which records the
+       indexes it touches; gather() then writes the sum, in index order, into
+       a SparseVector and resets only the touched elements, so the cost per
+       row is proportional to the work done and not to the length.
+      */
+   template <class T> class SparseAccumulator
+   {
+   public:
+         /// constructor for vectors of length n
+      explicit SparseAccumulator(const unsigned int n)
+            : values(n, T(0)), touched(n, 0)
+      {}
+
+         /// add value to element j
+      inline void add(const unsigned int j, const T& value)
+      {
+         if (!touched[j])
+         {
+            touched[j] = 1;
+            indexes.push_back(j);
+         }
+         values[j] += value;
+      }
+
+         /// add a*SV, SV of length n
+      void addScaled(const T& a, const SparseVector<T>& SV)
+      {
+         typename SparseIndexMap<T>::const_iterator it;
+         for (it = SV.vecMap.begin(); it != SV.vecMap.end(); ++it)
+         {
+            add(it->first, a * it->second);
+         }
+      }
+
+         /**
+          replace the elements of SV with the non-zero elements accumulated,
+          and reset the accumulator to zero
+         */
+      void gather(SparseVector<T>& SV)
+      {
+         std::sort(indexes.begin(), indexes.end());
+         SV.vecMap.clear();
+         SV.vecMap.reserve(indexes.size());
+         for (size_t k = 0; k < indexes.size(); k++)
+         {
+            const unsigned int j(indexes[k]);
+            if (values[j] != T(0))
+            {
+               SV.vecMap.push_back(j, values[j]);
+            }
+            values[j]  = T(0);
+            touched[j] = 0;
+         }
+         indexes.clear();
+      }
+
+   private:
+         /// dense sums, length n
+      std::vector<T> values;
+         /// flags for elements of values that have been added to
+      std::vector<char> touched;
+         /// indexes of touched elements, in the order touched
+      std::vector<unsigned int> indexes;
+
+   }; // end class SparseAccumulator
+
    //---------------------------------------------------------------------------
    // implementation of SparseVector
    //---------------------------------------------------------------------------
@@ -621,18 +849,18 @@ namespace gnsstk
       }
 
       len = n;
-      typename std::map<unsigned int, T>::const_iterator it;
+      typename SparseIndexMap<T>::const_iterator it;
       for (it = SV.vecMap.begin(); it != SV.vecMap.end(); ++it)
       {
          if (it->first < ind)
          {
             continue; // skip ones before ind
          }
-         if (it->first > ind + n)
+         if (it->first >= ind + n)
          {
             break;
          }
-         vecMap[it->first - ind] = it->second;
+         vecMap.push_back(it->first - ind, it->second);
       }
    }
 
@@ -640,7 +868,7 @@ namespace gnsstk
    template <class T> SparseVector<T>::operator Vector<T>() const
    {
       Vector<T> toRet(len, T(0));
-      typename std::map<unsigned int, T>::const_iterator it;
+      typename SparseIndexMap<T>::const_iterator it;
       for (it = vecMap.begin(); it != vecMap.end(); ++it)
       {
          toRet(it->first) = it->second;
@@ -655,19 +883,8 @@ namespace gnsstk
    // multiply, but ONLY with the tolerance T(0).
    template <class T> void SparseVector<T>::zeroize(const T tol)
    {
-      std::vector<unsigned int> toDelete;
-      typename std::map<unsigned int, T>::iterator it;
-
-      for (it = vecMap.begin(); it != vecMap.end(); ++it)
-      {
-         if (ABS(it->second) <= tol)
-         {
-            toDelete.push_back(it->first);
-         }
-      }
-
-      for (unsigned int i = 0; i < toDelete.size(); i++)
-         vecMap.erase(toDelete[i]);
+      vecMap.eraseIf([tol](const typename SparseIndexMap<T>::value_type& e)
+                     { return (ABS(e.second) <= tol); });
    }
 
    // SparseVector stream output operator
@@ -678,7 +895,7 @@ namespace gnsstk
       savefmt.copyfmt(os);
 
       unsigned int i; // the "real" vector index
-      typename std::map<unsigned int, T>::const_iterator it = SV.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator it = SV.vecMap.begin();
       for (i = 0; i < SV.len; i++)
       {
          if (i > 0)
@@ -704,7 +921,7 @@ namespace gnsstk
    // Norm = sqrt(sum(squares))
    template <class T> T norm(const SparseVector<T>& SV)
    {
-      typename std::map<unsigned int, T>::const_iterator it = SV.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator it = SV.vecMap.begin();
       if (it == SV.vecMap.end())
       {
          return T(0);
@@ -793,8 +1010,8 @@ namespace gnsstk
          GNSSTK_THROW(Exception("length mismatch"));
       }
       T value(0);
-      typename std::map<unsigned int, T>::const_iterator it = SL.vecMap.begin();
-      typename std::map<unsigned int, T>::const_iterator jt = SR.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator it = SL.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator jt = SR.vecMap.begin();
       while (it != SL.vecMap.end() && jt != SR.vecMap.end())
       {
          if (it->first > jt->first)
@@ -825,8 +1042,8 @@ namespace gnsstk
          GNSSTK_THROW(Exception("length mismatch"));
       }
       T value(0);
-      typename std::map<unsigned int, T>::const_iterator it = SL.vecMap.begin();
-      typename std::map<unsigned int, T>::const_iterator jt = SR.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator it = SL.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator jt = SR.vecMap.begin();
       while (it != SL.vecMap.end() && jt != SR.vecMap.end())
       {
          if (it->first >= ke || jt->first >= ke)
@@ -862,7 +1079,7 @@ namespace gnsstk
          GNSSTK_THROW(Exception("length mismatch"));
       }
       T value(0);
-      typename std::map<unsigned int, T>::const_iterator it;
+      typename SparseIndexMap<T>::const_iterator it;
       for (it = SL.vecMap.begin(); it != SL.vecMap.end(); ++it)
       {
          value += it->second * R[it->first];
@@ -878,7 +1095,7 @@ namespace gnsstk
 
    template <class T> T min(const SparseVector<T>& SV)
    {
-      typename std::map<unsigned int, T>::const_iterator it = SV.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator it = SV.vecMap.begin();
       if (it == SV.vecMap.end())
       {
          return T(0);
@@ -894,7 +1111,7 @@ namespace gnsstk
 
    template <class T> T max(const SparseVector<T>& SV)
    {
-      typename std::map<unsigned int, T>::const_iterator it = SV.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator it = SV.vecMap.begin();
       if (it == SV.vecMap.end())
       {
          return T(0);
@@ -910,7 +1127,7 @@ namespace gnsstk
 
    template <class T> T minabs(const SparseVector<T>& SV)
    {
-      typename std::map<unsigned int, T>::const_iterator it = SV.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator it = SV.vecMap.begin();
       if (it == SV.vecMap.end())
       {
          return T(0);
@@ -926,7 +1143,7 @@ namespace gnsstk
 
    template <class T> T maxabs(const SparseVector<T>& SV)
    {
-      typename std::map<unsigned int, T>::const_iterator it = SV.vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator it = SV.vecMap.begin();
       if (it == SV.vecMap.end())
       {
          return T(0);
@@ -952,19 +1169,7 @@ namespace gnsstk
          GNSSTK_THROW(Exception("Incompatible dimensions op-=(SV)"));
       }
 
-      typename std::map<unsigned int, T>::const_iterator Rit;
-      for (Rit = R.vecMap.begin(); Rit != R.vecMap.end(); ++Rit)
-      {
-         if (vecMap.find(Rit->first) == vecMap.end())
-         {
-            vecMap[Rit->first] = -Rit->second;
-         }
-         else
-         {
-            vecMap[Rit->first] -= Rit->second;
-         }
-      }
-      zeroize(T(0));
+      addScaledMerge(T(-1), R);
 
       return *this;
    }
@@ -978,23 +1183,7 @@ namespace gnsstk
          GNSSTK_THROW(Exception("Incompatible dimensions op-=(V)"));
       }
 
-      for (unsigned int i = 0; i < R.size(); i++)
-      {
-         if (R[i] == T(0))
-         {
-            continue;
-         }
-
-         if (vecMap.find(i) == vecMap.end())
-         {
-            vecMap[i] = -R[i];
-         }
-         else
-         {
-            vecMap[i] -= R[i];
-         }
-      }
-      zeroize(T(0));
+      addScaledMerge(T(-1), R);
 
       return *this;
    }
@@ -1008,19 +1197,7 @@ namespace gnsstk
          GNSSTK_THROW(Exception("Incompatible dimensions op+=(SV)"));
       }
 
-      typename std::map<unsigned int, T>::const_iterator Rit;
-      for (Rit = R.vecMap.begin(); Rit != R.vecMap.end(); ++Rit)
-      {
-         if (vecMap.find(Rit->first) == vecMap.end())
-         {
-            vecMap[Rit->first] = Rit->second;
-         }
-         else
-         {
-            vecMap[Rit->first] += Rit->second;
-         }
-      }
-      zeroize(T(0));
+      addScaledMerge(T(1), R);
 
       return *this;
    }
@@ -1033,25 +1210,7 @@ namespace gnsstk
       {
          GNSSTK_THROW(Exception("Incompatible dimensions op+=(V)"));
       }
-      // std::cout << " op+=(V)" << std::endl;
-
-      for (unsigned int i = 0; i < R.size(); i++)
-      {
-         if (R[i] == T(0))
-         {
-            continue;
-         }
-
-         if (vecMap.find(i) == vecMap.end())
-         {
-            vecMap[i] = R[i];
-         }
-         else
-         {
-            vecMap[i] += R[i];
-         }
-      }
-      zeroize(T(0));
+      addScaledMerge(T(1), R);
 
       return *this;
    }
@@ -1071,23 +1230,76 @@ namespace gnsstk
             Exception("Incompatible dimensions addScaledSparseVector()"));
       }
 
-      for (unsigned int i = 0; i < R.size(); i++)
+      addScaledMerge(a, R);
+   }
+
+   // merge this and a*R into a new index array, then swap it in; O(n+nR)
+   template <class T>
+   void SparseVector<T>::addScaledMerge(const T& a, const SparseVector<T>& R)
+   {
+      SparseIndexMap<T> merged;
+      merged.reserve(vecMap.size() + R.vecMap.size());
+
+      typename SparseIndexMap<T>::const_iterator it = vecMap.begin();
+      typename SparseIndexMap<T>::const_iterator jt = R.vecMap.begin();
+      while (it != vecMap.end() || jt != R.vecMap.end())
       {
-         if (R[i] == T(0))
+         unsigned int i;
+         T value;
+         if (jt == R.vecMap.end() ||
+             (it != vecMap.end() && it->first < jt->first))
          {
-            continue;
+            i = it->first;
+            value = it->second;
+            ++it;
          }
-
-         if (vecMap.find(i) == vecMap.end())
+         else if (it == vecMap.end() || jt->first < it->first)
          {
-            vecMap[i] = a * R[i];
+            i = jt->first;
+            value = a * jt->second;
+            ++jt;
          }
          else
          {
-            vecMap[i] += a * R[i];
+            i = it->first;
+            value = it->second + a * jt->second;
+            ++it;
+            ++jt;
+         }
+
+         if (value != T(0))
+         {
+            merged.push_back(i, value);
+         }
+      }
+
+      vecMap.swap(merged);
+   }
+
+   // merge this and a*R, R a full Vector, in one pass over R; O(len)
+   template <class T>
+   void SparseVector<T>::addScaledMerge(const T& a, const Vector<T>& R)
+   {
+      SparseIndexMap<T> merged;
+      merged.reserve(vecMap.size());
+
+      typename SparseIndexMap<T>::const_iterator it = vecMap.begin();
+      for (unsigned int i = 0; i < len; i++)
+      {
+         T value(a * R[i]);
+         if (it != vecMap.end() && it->first == i)
+         {
+            value = it->second + value;
+            ++it;
+         }
+
+         if (value != T(0))
+         {
+            merged.push_back(i, value);
          }
       }
-      zeroize(T(0));
+
+      vecMap.swap(merged);
    }
 
    // member function operator*=(scalar)
@@ -1100,7 +1312,7 @@ namespace gnsstk
       }
       else
       {
-         typename std::map<unsigned int, T>::iterator it;
+         typename SparseIndexMap<T>::iterator it;
          for (it = vecMap.begin(); it != vecMap.end(); ++it)
          {
             it->second *= value;
@@ -1119,7 +1331,7 @@ namespace gnsstk
          GNSSTK_THROW(Exception("Divide by zero"));
       }
 
-      typename std::map<unsigned int, T>::iterator it;
+      typename SparseIndexMap<T>::iterator it;
       for (it = vecMap.begin(); it != vecMap.end(); ++it)
       {
          it->second /= value;
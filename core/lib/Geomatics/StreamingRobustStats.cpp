@@ -0,0 +1,460 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file StreamingRobustStats.cpp
+    Streaming robust statistics: quantile summary, sliding window median and
+    incremental robust polynomial fit. */
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// GNSSTk includes
+#include "StreamingRobustStats.hpp"
+#include "SRIMatrix.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gnsstk
+{
+namespace Robust
+{
+   //---------------------------------------------------------------------------------
+   QuantileSketch::QuantileSketch(double e)
+         : eps(e), n(0)
+   {
+      if (!(eps > 0.0 && eps < 0.5))
+      {
+         Exception ex("Invalid relative rank error for QuantileSketch");
+         GNSSTK_THROW(ex);
+      }
+      period = std::max(1UL, (unsigned long)(1.0 / (2.0 * eps)));
+   }
+
+   //---------------------------------------------------------------------------------
+   void QuantileSketch::add(double x)
+   {
+         // first tuple with a larger value
+      vector<Tuple>::iterator it = upper_bound(
+         tuples.begin(), tuples.end(), x,
+         [](double v, const Tuple& t) { return v < t.v; });
+      Tuple t = {x, 1, 0};
+         // a new extreme is known exactly; otherwise its rank is no better
+         // known than that of its successor
+      if (it != tuples.begin() && it != tuples.end())
+      {
+         t.delta = it->g + it->delta - 1;
+      }
+      tuples.insert(it, t);
+      n++;
+
+      if (n % period == 0)
+      {
+         compress();
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void QuantileSketch::compress()
+   {
+      const unsigned long threshold((unsigned long)(2.0 * eps * double(n)));
+      if (tuples.size() < 3)
+      {
+         return;
+      }
+         // merge each tuple into its successor while the merged uncertainty
+         // stays within threshold; the first and last (extremes) are kept
+      size_t out = 1;
+      for (size_t i = 1; i < tuples.size(); i++)
+      {
+         Tuple t = tuples[i];
+         while (out > 1 && tuples[out - 1].g + t.g + t.delta <= threshold)
+         {
+            t.g += tuples[out - 1].g;
+            out--;
+         }
+         tuples[out++] = t;
+      }
+      tuples.resize(out);
+   }
+
+   //---------------------------------------------------------------------------------
+   void QuantileSketch::reset()
+   {
+      tuples.clear();
+      n = 0;
+   }
+
+   //---------------------------------------------------------------------------------
+   double QuantileSketch::quantile(double phi) const
+   {
+      if (tuples.empty())
+      {
+         Exception e("QuantileSketch is empty");
+         GNSSTK_THROW(e);
+      }
+      phi = std::min(1.0, std::max(0.0, phi));
+      const double r(std::max(1.0, ::ceil(phi * double(n))));
+      const double e(eps * double(n));
+      unsigned long rmin = 0;
+      for (size_t i = 0; i < tuples.size(); i++)
+      {
+         rmin += tuples[i].g;
+         if (r - double(rmin) <= e && double(rmin + tuples[i].delta) - r <= e)
+         {
+            return tuples[i].v;
+         }
+      }
+      return tuples.back().v;
+   }
+
+   //---------------------------------------------------------------------------------
+   double QuantileSketch::rank(double x) const
+   {
+         // count of samples <= x lies between rmin of the last tuple <= x
+         // and rmax-1 of the following tuple
+      unsigned long rmin = 0;
+      size_t i;
+      for (i = 0; i < tuples.size() && tuples[i].v <= x; i++)
+         rmin += tuples[i].g;
+      if (i == tuples.size())
+      {
+         return double(n);
+      }
+      if (i == 0)
+      {
+         return 0.0;
+      }
+      const unsigned long rmax(rmin + tuples[i].g + tuples[i].delta - 1);
+      return 0.5 * double(rmin + rmax);
+   }
+
+   //---------------------------------------------------------------------------------
+   double QuantileSketch::MAD(double& M) const
+   {
+      M = median();
+         // the MAD is the smallest deviation d for which about half the
+         // samples lie within M+-d; search the deviations of the summary
+      vector<double> dev(tuples.size());
+      for (size_t i = 0; i < tuples.size(); i++)
+         dev[i] = ::fabs(tuples[i].v - M);
+      sort(dev.begin(), dev.end());
+      const double half(0.5 * double(n));
+      size_t lo = 0, hi = dev.size() - 1;
+      while (lo < hi)
+      {
+         const size_t mid((lo + hi) / 2);
+         const double d(dev[mid]);
+            // samples strictly below M-d are not within the interval
+         const double below(rank(std::nextafter(M - d, -HUGE_VAL)));
+         if (rank(M + d) - below >= half)
+         {
+            hi = mid;
+         }
+         else
+         {
+            lo = mid + 1;
+         }
+      }
+      return dev[lo] / RobustTuningE;
+   }
+
+   //---------------------------------------------------------------------------------
+   double QuantileSketch::minimum() const
+   {
+      if (tuples.empty())
+      {
+         Exception e("QuantileSketch is empty");
+         GNSSTK_THROW(e);
+      }
+      return tuples.front().v;
+   }
+
+   //---------------------------------------------------------------------------------
+   double QuantileSketch::maximum() const
+   {
+      if (tuples.empty())
+      {
+         Exception e("QuantileSketch is empty");
+         GNSSTK_THROW(e);
+      }
+      return tuples.back().v;
+   }
+
+   //---------------------------------------------------------------------------------
+   SlidingMedian::SlidingMedian(unsigned int N)
+         : next(0)
+   {
+      if (N == 0)
+      {
+         Exception e("SlidingMedian window must be > 0");
+         GNSSTK_THROW(e);
+      }
+      ring.resize(N);
+      sorted.reserve(N);
+   }
+
+   //---------------------------------------------------------------------------------
+   void SlidingMedian::add(double x)
+   {
+      if (full())
+      {
+            // drop the oldest sample, which is about to be overwritten
+         sorted.erase(lower_bound(sorted.begin(), sorted.end(), ring[next]));
+      }
+      ring[next] = x;
+      next = (next + 1) % ring.size();
+      sorted.insert(upper_bound(sorted.begin(), sorted.end(), x), x);
+   }
+
+   //---------------------------------------------------------------------------------
+   void SlidingMedian::reset()
+   {
+      sorted.clear();
+      next = 0;
+   }
+
+   //---------------------------------------------------------------------------------
+   double SlidingMedian::median() const
+   {
+      const size_t nd(sorted.size());
+      if (nd == 0)
+      {
+         Exception e("SlidingMedian is empty");
+         GNSSTK_THROW(e);
+      }
+      if (nd % 2)
+      {
+         return sorted[nd / 2];
+      }
+      return (sorted[nd / 2 - 1] + sorted[nd / 2]) / 2.0;
+   }
+
+   //---------------------------------------------------------------------------------
+   double SlidingMedian::quantile(double phi) const
+   {
+      if (sorted.empty())
+      {
+         Exception e("SlidingMedian is empty");
+         GNSSTK_THROW(e);
+      }
+      phi = std::min(1.0, std::max(0.0, phi));
+      return sorted[size_t(phi * double(sorted.size() - 1) + 0.5)];
+   }
+
+   //---------------------------------------------------------------------------------
+   double SlidingMedian::kthDeviation(double M, unsigned int k) const
+   {
+         // deviations below M, ascending: a(i) = M - sorted[p-1-i], i < na;
+         // deviations at or above M, ascending: b(j) = sorted[p+j] - M, j < nb
+      const unsigned int p(lower_bound(sorted.begin(), sorted.end(), M) -
+                           sorted.begin());
+      const unsigned int na(p), nb(sorted.size() - p);
+      auto a = [&](unsigned int i) { return M - sorted[p - 1 - i]; };
+      auto b = [&](unsigned int j) { return sorted[p + j] - M; };
+
+         // find how many of the k+1 smallest come from a
+      unsigned int lo(k + 1 > nb ? k + 1 - nb : 0), hi(std::min(k + 1, na));
+      while (lo < hi)
+      {
+         const unsigned int ia((lo + hi) / 2), jb(k + 1 - ia);
+         if (jb > 0 && b(jb - 1) > a(ia))
+         {
+            lo = ia + 1;
+         }
+         else
+         {
+            hi = ia;
+         }
+      }
+      const unsigned int jb(k + 1 - lo);
+      double rv(-1.0);
+      if (lo > 0)
+      {
+         rv = a(lo - 1);
+      }
+      if (jb > 0)
+      {
+         rv = std::max(rv, b(jb - 1));
+      }
+      return rv;
+   }
+
+   //---------------------------------------------------------------------------------
+   double SlidingMedian::MAD(double& M) const
+   {
+      M = median();
+      const unsigned int nd(sorted.size());
+      double mad;
+      if (nd % 2)
+      {
+         mad = kthDeviation(M, nd / 2);
+      }
+      else
+      {
+         mad = (kthDeviation(M, nd / 2 - 1) + kthDeviation(M, nd / 2)) / 2.0;
+      }
+      return mad / RobustTuningE;
+   }
+
+   //---------------------------------------------------------------------------------
+   StreamingPolyFit::StreamingPolyFit(unsigned int n, unsigned int window)
+         : N(n), nd(0), t0(0.0), x0(0.0), resid(window < 3 ? 3 : window)
+   {
+      if (n == 0 || window < 3)
+      {
+         Exception e("Invalid input to StreamingPolyFit");
+         GNSSTK_THROW(e);
+      }
+      R = Matrix<double>(N, N, 0.0);
+      Z = Vector<double>(N, 0.0);
+      A = Matrix<double>(1, N + 1);
+      coeff = Vector<double>(N, 0.0);
+   }
+
+   //---------------------------------------------------------------------------------
+   void StreamingPolyFit::reset()
+   {
+      nd = 0;
+      t0 = x0 = 0.0;
+      R = 0.0;
+      Z = 0.0;
+      resid.reset();
+   }
+
+   //---------------------------------------------------------------------------------
+   bool StreamingPolyFit::solve(Vector<double>& c) const
+   {
+         // back substitution in the upper triangular R
+      for (int i = N - 1; i >= 0; i--)
+      {
+         if (R(i, i) == 0.0)
+         {
+            return false;
+         }
+         double sum(Z(i));
+         for (unsigned int j = i + 1; j < N; j++)
+            sum -= R(i, j) * c(j);
+         c(i) = sum / R(i, i);
+      }
+      return true;
+   }
+
+   //---------------------------------------------------------------------------------
+   bool StreamingPolyFit::isValid() const
+   {
+      for (unsigned int i = 0; i < N; i++)
+      {
+         if (R(i, i) == 0.0)
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   //---------------------------------------------------------------------------------
+   double StreamingPolyFit::add(double t, double x)
+   {
+      if (nd == 0)
+      {
+         t0 = t;
+         x0 = x;
+      }
+      nd++;
+      const double dt(t - t0), d(x - x0);
+
+         // Huber weight of the prediction residual, once the fit and the
+         // scale of the residuals are known
+      double wt(1.0);
+      if (solve(coeff))
+      {
+         double fit(coeff(N - 1));
+         for (int j = N - 2; j >= 0; j--)
+            fit = fit * dt + coeff(j);
+         const double res(d - fit);
+         if (resid.size() >= 3)
+         {
+            double M, mad(resid.MAD(M));
+            const double tv(RobustTuningT * mad);
+            if (tv > 0.0 && ::fabs(res) > tv)
+            {
+               wt = tv / ::fabs(res);
+            }
+         }
+         resid.add(res);
+      }
+
+         // weighted partials and data, as in RobustPolyFit
+      A(0, 0) = wt;
+      for (unsigned int j = 1; j < N; j++)
+         A(0, j) = A(0, j - 1) * dt;
+      A(0, N) = d * wt;
+      SrifMU<double>(R, Z, A, 1);
+
+      return wt;
+   }
+
+   //---------------------------------------------------------------------------------
+   Vector<double> StreamingPolyFit::coefficients() const
+   {
+      Vector<double> c(N, 0.0);
+      if (!solve(c))
+      {
+         Exception e("StreamingPolyFit is not yet determined");
+         GNSSTK_THROW(e);
+      }
+      return c;
+   }
+
+   //---------------------------------------------------------------------------------
+   double StreamingPolyFit::evaluate(double t) const
+   {
+      Vector<double> c(coefficients());
+      const double dt(t - t0);
+      double fit(c(N - 1));
+      for (int j = N - 2; j >= 0; j--)
+         fit = fit * dt + c(j);
+      return x0 + fit;
+   }
+
+} // end namespace Robust
+} // end namespace gnsstk
@@ -0,0 +1,277 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file StreamingRobustStats.hpp
+    Streaming counterparts of the robust statistics in RobustStats.hpp, for
+    long (e.g. real time) data streams where keeping and sorting the whole data
+    array on every call is not an option. Each class has bounded memory and
+    an update cost of O(log n) or better per sample:
+    Robust::QuantileSketch approximates quantiles, median and MAD of the whole
+    stream with a guaranteed rank error; Robust::SlidingMedian gives the exact
+    median and MAD of the last N samples; Robust::StreamingPolyFit is an
+    incremental version of Robust::RobustPolyFit(). */
+
+#ifndef GNSSTK_STREAMINGROBUSTSTATS_HPP
+#define GNSSTK_STREAMINGROBUSTSTATS_HPP
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <vector>
+
+// GNSSTk
+#include "Exception.hpp"
+#include "Matrix.hpp"
+#include "RobustStats.hpp"
+#include "Vector.hpp"
+
+namespace gnsstk
+{
+   /// @ingroup MathGroup
+   //@{
+
+   namespace Robust
+   {
+         /**
+          Quantile summary of a data stream (Greenwald and Khanna, "Space
+          efficient online computation of quantile summaries", SIGMOD 2001).
+          The summary keeps O((1/eps)log(eps*n)) values out of the n added, and
+          any quantile returned has a rank within eps*n of the exact one; this
+          bound is available from rankErrorBound(). The median and MAD are
+          computed from the summary, with rank errors of at most eps*n and
+          about 2*eps*n respectively. Adding a sample costs a binary search
+          and an insertion into a short sorted array.
+         */
+      class QuantileSketch
+      {
+      public:
+            /** Constructor.
+             * @param eps relative rank error of the summary, 0 < eps < 0.5
+             * @throw Exception if eps is out of range */
+         explicit QuantileSketch(double eps = 0.001);
+
+            /// add one sample to the summary
+         void add(double x);
+
+            /// forget all the samples
+         void reset();
+
+            /// number of samples added
+         unsigned long count() const { return n; }
+
+            /// number of values kept in the summary
+         size_t size() const { return tuples.size(); }
+
+            /// relative rank error eps of the summary
+         double epsilon() const { return eps; }
+
+            /// maximum error, in samples, of the rank of any quantile returned
+         double rankErrorBound() const { return eps * double(n); }
+
+            /** Approximate quantile of the samples.
+             * @param phi quantile, 0 <= phi <= 1 (0.5 is the median)
+             * @return a sample whose rank is within rankErrorBound() of phi*n
+             * @throw Exception if the summary is empty */
+         double quantile(double phi) const;
+
+            /** approximate median of the samples
+             * @throw Exception if the summary is empty */
+         double median() const { return quantile(0.5); }
+
+            /** Approximate median absolute deviation, normalized as in
+             * Robust::MAD() so that the MAD of a normal distribution is the
+             * standard deviation.
+             * @param M (output) approximate median of the samples
+             * @return approximate MAD of the samples
+             * @throw Exception if the summary is empty */
+         double MAD(double& M) const;
+
+            /// approximate number of samples <= x; error is within eps*n
+         double rank(double x) const;
+
+            /// smallest sample (exact)
+         double minimum() const;
+
+            /// largest sample (exact)
+         double maximum() const;
+
+      private:
+            /// one value of the summary
+         struct Tuple
+         {
+            double v;            ///< sample value
+            unsigned long g;     ///< rmin(this) - rmin(previous tuple)
+            unsigned long delta; ///< rmax(this) - rmin(this)
+         };
+
+            /// merge tuples whose combined rank uncertainty is within 2*eps*n
+         void compress();
+
+         double eps;                ///< relative rank error
+         unsigned long n;           ///< number of samples
+         unsigned long period;      ///< compress every period samples
+         std::vector<Tuple> tuples; ///< summary, sorted by value
+      }; // end class QuantileSketch
+
+         /**
+          Exact median and MAD over a sliding window of the last N samples. The
+          window is kept sorted in a contiguous array, next to a ring buffer of
+          samples in arrival order: an update is two binary searches and two
+          short memory moves, the median is O(1) and the MAD is O(log N),
+          found as an order statistic of the deviations on either side of the
+          median without sorting them.
+         */
+      class SlidingMedian
+      {
+      public:
+            /** Constructor.
+             * @param N window length, > 0
+             * @throw Exception if N is zero */
+         explicit SlidingMedian(unsigned int N);
+
+            /// add a sample, dropping the oldest if the window is full
+         void add(double x);
+
+            /// empty the window
+         void reset();
+
+            /// number of samples in the window
+         unsigned int size() const { return sorted.size(); }
+
+            /// window length N
+         unsigned int window() const { return ring.size(); }
+
+            /// true if the window holds N samples
+         bool full() const { return sorted.size() == ring.size(); }
+
+            /** median of the samples in the window, as Robust::Median()
+             * @throw Exception if the window is empty */
+         double median() const;
+
+            /** median absolute deviation of the samples in the window, as
+             * Robust::MAD()
+             * @param M (output) median of the samples in the window
+             * @throw Exception if the window is empty */
+         double MAD(double& M) const;
+
+            /** sample of nearest rank to quantile phi (0 <= phi <= 1)
+             * @throw Exception if the window is empty */
+         double quantile(double phi) const;
+
+      private:
+            /// k-th (0-based) smallest absolute deviation from M
+         double kthDeviation(double M, unsigned int k) const;
+
+         std::vector<double> ring;   ///< samples in arrival order, length N
+         unsigned int next;          ///< index in ring of the next sample
+         std::vector<double> sorted; ///< samples in the window, sorted
+      }; // end class SlidingMedian
+
+         /**
+          Incremental robust fit of a polynomial, the streaming counterpart of
+          Robust::RobustPolyFit(). Each sample is weighted when it is added,
+          using the Huber weight of its prediction residual from the current
+          fit, scaled by the MAD of the last few prediction residuals, and
+          then added to a square root information matrix with SrifMU. Memory
+          is O(n^2 + window) and an update is O(n^2), independent of the
+          number of samples. As in RobustPolyFit(), the fit is
+          x(t) = x0 + c[0] + c[1]*(t-t0) + ... + c[n-1]*(t-t0)^(n-1),
+          with (t0,x0) the first sample. Unlike the batch fit, weights are
+          not revisited once a sample is in, so early outliers (before the
+          scale is known) are not downweighted.
+         */
+      class StreamingPolyFit
+      {
+      public:
+            /** Constructor.
+             * @param n number of coefficients (degree + 1), > 0
+             * @param window number of recent prediction residuals used for
+             *   the scale of the weights, >= 3
+             * @throw Exception on bad input */
+         StreamingPolyFit(unsigned int n, unsigned int window = 50);
+
+            /** Add one sample.
+             * @param t independent variable
+             * @param x data
+             * @return the weight (0 < weight <= 1) given to the sample */
+         double add(double t, double x);
+
+            /// forget all the samples
+         void reset();
+
+            /// number of samples added
+         unsigned long count() const { return nd; }
+
+            /// true if enough samples have been added to determine the fit
+         bool isValid() const;
+
+            /** coefficients c of the fit, as described above (dimension n)
+             * @throw Exception if the fit is not yet determined */
+         Vector<double> coefficients() const;
+
+            /** evaluate the fit, including x0, at t
+             * @throw Exception if the fit is not yet determined */
+         double evaluate(double t) const;
+
+            /// the first sample (t0,x0) which debiases the fit
+         double firstTime() const { return t0; }
+         double firstData() const { return x0; }
+
+            /// exact median and MAD of the recent prediction residuals
+         const SlidingMedian& residuals() const { return resid; }
+
+      private:
+            /// solve R*c=Z into c; return false if R is singular
+         bool solve(Vector<double>& c) const;
+
+         unsigned int N;       ///< number of coefficients
+         unsigned long nd;     ///< number of samples
+         double t0, x0;        ///< first sample
+         Matrix<double> R;     ///< square root information matrix
+         Vector<double> Z;     ///< SRI state vector
+         Matrix<double> A;     ///< scratch for SrifMU, 1 x (N+1)
+         mutable Vector<double> coeff; ///< scratch for the current solution
+         SlidingMedian resid;  ///< recent prediction residuals
+      }; // end class StreamingPolyFit
+
+   } // namespace Robust
+
+   //@}
+
+} // end namespace gnsstk
+
+#endif
@@ -191,7 +191,7 @@ namespace gnsstk
 
                // test for good data
                // must consistently mark bad data in SP with SatPass::BAD
-            if (!(SP.spdvector[i].flag & SatPass::OK) ||
+            if (!(SP.spdflag[i] & SatPass::OK) ||
                 SP.data(i, L1) == 0.0 || SP.data(i, L2) == 0.0 ||
                 SP.data(i, P1) == 0.0 || SP.data(i, P2) == 0.0)
             {
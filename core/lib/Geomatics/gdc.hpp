@@ -594,7 +594,7 @@ namespace gnsstk
 
          /**
           vector of dt*ndt = number of steps of dt from begin point * dt; from
-          spdvector
+          spdndt
          */
       std::vector<double> xdata;
 
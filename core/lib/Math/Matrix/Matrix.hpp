@@ -165,6 +165,10 @@ namespace gnsstk
       inline size_t rows() const { return r; }
          /// The number of columns in the matrix
       inline size_t cols() const { return c; }
+         /// Pointer to the elements, stored in column major order
+      inline T* data() { return v.begin(); }
+         /// Const pointer to the elements, stored in column major order
+      inline const T* data() const { return v.begin(); }
          /// A reference slice of a row with a given std::slice
       inline MatrixRowSlice<T> rowRef(size_t rowNum, const std::slice& s);
          /// A reference slice of a row with a starting column (i.e. sub-row)
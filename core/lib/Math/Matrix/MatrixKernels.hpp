@@ -0,0 +1,282 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file MatrixKernels.hpp
+ * Cache-blocked kernels for products of contiguous column-major matrices
+ */
+
+#ifndef GNSSTK_MATRIX_KERNELS_HPP
+#define GNSSTK_MATRIX_KERNELS_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /** Low-level kernels operating on raw column-major storage, as
+       * used by Matrix<T>.  Element (i,j) of an m-row matrix \a A is
+       * A[i + j*m].  These are the building blocks for the Matrix<T>
+       * overloads of operator*, transpose(), transposeTimes(),
+       * timesTranspose() and transposeWeighted().
+       *
+       * The kernels are written so that the innermost loop runs with
+       * unit stride down a column, which the compiler vectorizes,
+       * and are blocked so that the working set of the inner loops
+       * stays in cache.  Every element of a result is accumulated in
+       * the same order (increasing inner index) as the textbook
+       * triple loop, so results are identical to the generic
+       * ConstMatrixBase operators.
+       *
+       * The output must not alias any of the inputs. */
+   namespace MatrixKernels
+   {
+         /// Rows of A in the block held in cache by gemm().
+      const size_t blockRows = 256;
+         /// Inner-dimension length of the block held in cache by gemm().
+      const size_t blockInner = 128;
+         /// Tile size used by transpose().
+      const size_t blockTile = 32;
+
+         /** C += A*B where A is [m,k], B is [k,n] and C is [m,n].
+          * The columns of B are processed four at a time so each
+          * load of a column of A is used four times. */
+      template <class T>
+      void gemm(size_t m, size_t n, size_t k,
+                const T* A, const T* B, T* C)
+      {
+         for (size_t kk = 0; kk < k; kk += blockInner)
+         {
+            size_t kEnd = std::min(kk + blockInner, k);
+            for (size_t ii = 0; ii < m; ii += blockRows)
+            {
+               size_t iEnd = std::min(ii + blockRows, m);
+               size_t j = 0;
+               for (; j + 4 <= n; j += 4)
+               {
+                  T *c0 = C + j*m, *c1 = c0 + m, *c2 = c1 + m,
+                     *c3 = c2 + m;
+                  const T *b0 = B + j*k, *b1 = b0 + k, *b2 = b1 + k,
+                     *b3 = b2 + k;
+                  for (size_t p = kk; p < kEnd; p++)
+                  {
+                     const T *a = A + p*m;
+                     T x0 = b0[p], x1 = b1[p], x2 = b2[p], x3 = b3[p];
+                     for (size_t i = ii; i < iEnd; i++)
+                     {
+                        T ai = a[i];
+                        c0[i] += ai * x0;
+                        c1[i] += ai * x1;
+                        c2[i] += ai * x2;
+                        c3[i] += ai * x3;
+                     }
+                  }
+               }
+               for (; j < n; j++)
+               {
+                  T *c0 = C + j*m;
+                  const T *b0 = B + j*k;
+                  for (size_t p = kk; p < kEnd; p++)
+                  {
+                     const T *a = A + p*m;
+                     T x0 = b0[p];
+                     for (size_t i = ii; i < iEnd; i++)
+                        c0[i] += a[i] * x0;
+                  }
+               }
+            }
+         }
+      }
+
+         /** C += A*transpose(B) where A is [m,k], B is [n,k] and C
+          * is [m,n]. */
+      template <class T>
+      void gemmNT(size_t m, size_t n, size_t k,
+                  const T* A, const T* B, T* C)
+      {
+         for (size_t kk = 0; kk < k; kk += blockInner)
+         {
+            size_t kEnd = std::min(kk + blockInner, k);
+            for (size_t ii = 0; ii < m; ii += blockRows)
+            {
+               size_t iEnd = std::min(ii + blockRows, m);
+               for (size_t j = 0; j < n; j++)
+               {
+                  T *c0 = C + j*m;
+                  for (size_t p = kk; p < kEnd; p++)
+                  {
+                     const T *a = A + p*m;
+                     T x0 = B[j + p*n];
+                     for (size_t i = ii; i < iEnd; i++)
+                        c0[i] += a[i] * x0;
+                  }
+               }
+            }
+         }
+      }
+
+         /** C = transpose(A)*B where A is [k,m], B is [k,n] and C is
+          * [m,n].  Each element is the dot product of two contiguous
+          * columns; four columns of B are done at once so each
+          * element of A is loaded once per four products.
+          * @param[in] symmetric If true, A and B are the same matrix
+          *   (or the result is otherwise known to be symmetric) and
+          *   only the upper triangle is computed and then mirrored. */
+      template <class T>
+      void gemmTN(size_t m, size_t n, size_t k,
+                  const T* A, const T* B, T* C, bool symmetric = false)
+      {
+         for (size_t i = 0; i < m; i++)
+         {
+            const T *a = A + i*k;
+            size_t j = symmetric ? i : 0;
+            for (; j + 4 <= n; j += 4)
+            {
+               const T *b0 = B + j*k, *b1 = b0 + k, *b2 = b1 + k,
+                  *b3 = b2 + k;
+               T s0(0), s1(0), s2(0), s3(0);
+               for (size_t p = 0; p < k; p++)
+               {
+                  T ap = a[p];
+                  s0 += ap * b0[p];
+                  s1 += ap * b1[p];
+                  s2 += ap * b2[p];
+                  s3 += ap * b3[p];
+               }
+               C[i + j*m] = s0;
+               C[i + (j+1)*m] = s1;
+               C[i + (j+2)*m] = s2;
+               C[i + (j+3)*m] = s3;
+            }
+            for (; j < n; j++)
+            {
+               const T *b0 = B + j*k;
+               T s0(0);
+               for (size_t p = 0; p < k; p++)
+                  s0 += a[p] * b0[p];
+               C[i + j*m] = s0;
+            }
+         }
+         if (symmetric)
+         {
+            for (size_t j = 0; j < n; j++)
+               for (size_t i = j+1; i < m; i++)
+                  C[i + j*m] = C[j + i*m];
+         }
+      }
+
+         /** y += A*x where A is [m,n], x has n elements and y has m
+          * elements. */
+      template <class T>
+      void gemv(size_t m, size_t n, const T* A, const T* x, T* y)
+      {
+         for (size_t j = 0; j < n; j++)
+         {
+            const T *a = A + j*m;
+            T xj = x[j];
+            for (size_t i = 0; i < m; i++)
+               y[i] += a[i] * xj;
+         }
+      }
+
+         /** y = transpose(A)*x where A is [m,n], x has m elements and
+          * y has n elements. */
+      template <class T>
+      void gemvT(size_t m, size_t n, const T* A, const T* x, T* y)
+      {
+         for (size_t j = 0; j < n; j++)
+         {
+            const T *a = A + j*m;
+            T s(0);
+            for (size_t i = 0; i < m; i++)
+               s += a[i] * x[i];
+            y[j] = s;
+         }
+      }
+
+         /** C = transpose(A)*diag(w)*A where A is [k,n], w has k
+          * elements and C is [n,n].  Each element is accumulated as
+          * (A(p,i)*w[p])*A(p,j), the grouping of
+          * (transpose(A)*diag(w))*A; both triangles are computed so
+          * that C(i,j) and C(j,i) round the same way that product
+          * does. */
+      template <class T>
+      void syrkTW(size_t n, size_t k, const T* A, const T* w, T* C)
+      {
+         for (size_t j = 0; j < n; j++)
+         {
+            const T *aj = A + j*k;
+            for (size_t i = 0; i < n; i++)
+            {
+               const T *ai = A + i*k;
+               T s(0);
+               for (size_t p = 0; p < k; p++)
+                  s += (ai[p] * w[p]) * aj[p];
+               C[i + j*n] = s;
+            }
+         }
+      }
+
+         /** B = transpose(A) where A is [m,n] and B is [n,m], done in
+          * square tiles so both reads and writes stay in cache. */
+      template <class T>
+      void transpose(size_t m, size_t n, const T* A, T* B)
+      {
+         for (size_t jj = 0; jj < n; jj += blockTile)
+         {
+            size_t jEnd = std::min(jj + blockTile, n);
+            for (size_t ii = 0; ii < m; ii += blockTile)
+            {
+               size_t iEnd = std::min(ii + blockTile, m);
+               for (size_t j = jj; j < jEnd; j++)
+                  for (size_t i = ii; i < iEnd; i++)
+                     B[j + i*n] = A[i + j*m];
+            }
+         }
+      }
+   } // namespace MatrixKernels
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_MATRIX_KERNELS_HPP
@@ -47,6 +47,7 @@
 #include <limits>
 #include "MiscMath.hpp"
 #include "MatrixFunctors.hpp"
+#include "MatrixKernels.hpp"
 
 namespace gnsstk
 {
@@ -337,6 +338,18 @@ namespace gnsstk
       return temp;
    }
 
+      /**
+       * Returns a matrix that is \c m transposed, using a tiled copy
+       * of the contiguous storage.
+       */
+   template <class T>
+   inline Matrix<T> transpose(const Matrix<T>& m)
+   {
+      Matrix<T> temp(m.cols(), m.rows());
+      MatrixKernels::transpose(m.rows(), m.cols(), m.data(), temp.data());
+      return temp;
+   }
+
       /**
        * Uses an LU Decomposition to calculate the determinate of m.
        * @throw MatrixException
@@ -879,6 +892,147 @@ namespace gnsstk
       return toReturn;
    }
 
+      /**
+       * Matrix * Matrix for contiguous matrices, using the blocked
+       * kernel in MatrixKernels::gemm().
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Matrix<T> operator* (const Matrix<T>& l, const Matrix<T>& r)
+   {
+      if (l.cols() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * Matrix");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(l.rows(), r.cols(), T(0));
+      MatrixKernels::gemm(l.rows(), r.cols(), l.cols(),
+                          l.data(), r.data(), toReturn.data());
+      return toReturn;
+   }
+
+      /**
+       * Matrix times vector multiplication for contiguous operands.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Vector<T> operator* (const Matrix<T>& m, const Vector<T>& v)
+   {
+      if (v.size() != m.cols())
+      {
+         gnsstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GNSSTK_THROW(e);
+      }
+
+      Vector<T> toReturn(m.rows(), T(0));
+      MatrixKernels::gemv(m.rows(), m.cols(), m.data(), v.begin(),
+                          toReturn.begin());
+      return toReturn;
+   }
+
+      /**
+       * Vector times matrix multiplication for contiguous operands.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Vector<T> operator* (const Vector<T>& v, const Matrix<T>& m)
+   {
+      if (v.size() != m.rows())
+      {
+         gnsstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GNSSTK_THROW(e);
+      }
+
+      Vector<T> toReturn(m.cols());
+      MatrixKernels::gemvT(m.rows(), m.cols(), m.data(), v.begin(),
+                           toReturn.begin());
+      return toReturn;
+   }
+
+      /**
+       * Compute transpose(l) * r without forming the transpose.
+       * transposeTimes(A,A) only computes half of the symmetric result.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Matrix<T> transposeTimes(const Matrix<T>& l, const Matrix<T>& r)
+   {
+      if (l.rows() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(Matrix) * Matrix");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(l.cols(), r.cols());
+      MatrixKernels::gemmTN(l.cols(), r.cols(), l.rows(), l.data(),
+                            r.data(), toReturn.data(), &l == &r);
+      return toReturn;
+   }
+
+      /**
+       * Compute l * transpose(r) without forming the transpose.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Matrix<T> timesTranspose(const Matrix<T>& l, const Matrix<T>& r)
+   {
+      if (l.cols() != r.cols())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * transpose(Matrix)");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(l.rows(), r.rows(), T(0));
+      MatrixKernels::gemmNT(l.rows(), r.rows(), l.cols(), l.data(),
+                            r.data(), toReturn.data());
+      return toReturn;
+   }
+
+      /**
+       * Compute the weighted normal matrix transpose(A) * W * A, as
+       * (transpose(A) * W) * A without forming transpose(A).  The
+       * grouping and the order of accumulation are those of the
+       * expression transpose(A) * W * A, so results are identical
+       * to it; W need not be symmetric.
+       * @param[in] A The [m,n] partials matrix.
+       * @param[in] W The [m,m] weight matrix.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Matrix<T> transposeWeighted(const Matrix<T>& A, const Matrix<T>& W)
+   {
+      if ((W.rows() != A.rows()) || (W.cols() != A.rows()))
+      {
+         MatrixException e("Incompatible dimensions for transpose(A) * W * A");
+         GNSSTK_THROW(e);
+      }
+
+      return transposeTimes(A, W) * A;
+   }
+
+      /**
+       * Compute the weighted normal matrix transpose(A) * diag(w) * A,
+       * with the same grouping as (transpose(A) * diag(w)) * A.
+       * @param[in] A The [m,n] partials matrix.
+       * @param[in] w The m diagonal elements of the weight matrix.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Matrix<T> transposeWeighted(const Matrix<T>& A, const Vector<T>& w)
+   {
+      if (w.size() != A.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(A) * diag(w) * A");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(A.cols(), A.cols());
+      MatrixKernels::syrkTW(A.cols(), A.rows(), A.data(), w.begin(),
+                            toReturn.data());
+      return toReturn;
+   }
+
       /**
        * Compute sum of two matricies.
        * @throw MatrixException
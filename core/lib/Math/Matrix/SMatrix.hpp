@@ -0,0 +1,391 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file SMatrix.hpp
+ * Fixed-size matrix with compile-time dimensions
+ */
+
+#ifndef GNSSTK_SMATRIX_HPP
+#define GNSSTK_SMATRIX_HPP
+
+#include <cmath>
+#include <initializer_list>
+#include "Matrix.hpp"
+#include "SVector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * An R x C matrix of type T with the dimensions fixed at
+       * compile time.  The elements live in the object itself, in
+       * column major order like Matrix<T>, so an SMatrix costs no
+       * heap allocation and the loops below, having constant bounds,
+       * are fully unrolled by the compiler for the 3x3 and 4x4 sizes
+       * used in per-epoch coordinate transformations.
+       *
+       * SMatrix converts implicitly to Matrix<T> and explicitly from
+       * any matrix of the same dimensions, so it can be used for the
+       * inner computation while keeping Matrix<T> interfaces.
+       *
+       * @code
+       * SMatrix<double,3,3> R = SMatrix<double,3,3>::rotation(theta,3)
+       *                       * SMatrix<double,3,3>::rotation(phi,1);
+       * Matrix<double> M(R);
+       * @endcode
+       */
+   template <class T, size_t R, size_t C>
+   class SMatrix
+   {
+   public:
+         /// Initialize all elements to zero.
+      SMatrix()
+      { for (size_t i = 0; i < R*C; i++) m[i] = T(0); }
+
+         /** Initialize from a list of values given in row major order,
+          * i.e. as the matrix is written on paper; missing elements are
+          * zero.
+          * @throw MatrixException if the list has more than R*C values. */
+      SMatrix(std::initializer_list<T> l)
+      {
+         if (l.size() > R*C)
+         {
+            MatrixException e("Too many values for SMatrix");
+            GNSSTK_THROW(e);
+         }
+         for (size_t i = 0; i < R*C; i++)
+            m[i] = T(0);
+         size_t k = 0;
+         for (const T& x : l)
+         {
+            (*this)(k / C, k % C) = x;
+            k++;
+         }
+      }
+
+         /** Copy from a matrix of the same dimensions.
+          * @throw MatrixException if the dimensions differ. */
+      template <class BaseClass>
+      explicit SMatrix(const ConstMatrixBase<T, BaseClass>& mat)
+      {
+         if ((mat.rows() != R) || (mat.cols() != C))
+         {
+            MatrixException e("Incompatible dimensions for SMatrix");
+            GNSSTK_THROW(e);
+         }
+         for (size_t j = 0; j < C; j++)
+            for (size_t i = 0; i < R; i++)
+               (*this)(i,j) = mat(i,j);
+      }
+
+         /// Return a heap-allocated copy.
+      Matrix<T> toMatrix() const
+      {
+         Matrix<T> rv(R, C);
+         T *p = rv.data();
+         for (size_t i = 0; i < R*C; i++)
+            p[i] = m[i];
+         return rv;
+      }
+
+         /// Convert to Matrix<T> for use with the general purpose code.
+      operator Matrix<T>() const
+      { return toMatrix(); }
+
+         /// The number of rows.
+      static constexpr size_t rows()
+      { return R; }
+         /// The number of columns.
+      static constexpr size_t cols()
+      { return C; }
+
+      T& operator()(size_t i, size_t j)
+      { return m[i + j*R]; }
+      const T& operator()(size_t i, size_t j) const
+      { return m[i + j*R]; }
+
+         /// Pointer to the elements, stored in column major order.
+      T* data()
+      { return m; }
+      const T* data() const
+      { return m; }
+
+         /// Return the identity matrix.
+      static SMatrix identity()
+      {
+         SMatrix rv;
+         for (size_t i = 0; i < R && i < C; i++)
+            rv(i,i) = T(1);
+         return rv;
+      }
+
+         /**
+          * Return the rotation matrix for the rotation through \c
+          * angle radians about \c axis number (= 1, 2 or 3).  Same as
+          * gnsstk::rotation(), for 3x3 matrices only.
+          * @throw MatrixException
+          */
+      static SMatrix rotation(T angle, int axis)
+      {
+         static_assert(R == 3 && C == 3, "rotation() requires a 3x3 matrix");
+         if (axis < 1 || axis > 3)
+         {
+            MatrixException e("Invalid axis (must be 1,2, or 3)");
+            GNSSTK_THROW(e);
+         }
+         SMatrix rv;
+         int i1 = axis-1;
+         int i2 = (i1+1) % 3;
+         int i3 = (i2+1) % 3;
+         rv(i1,i1) = T(1);
+         rv(i2,i2) = rv(i3,i3) = ::cos(angle);
+         rv(i3,i2) = -(rv(i2,i3) = ::sin(angle));
+         return rv;
+      }
+
+      SMatrix& operator+=(const SMatrix& r)
+      { for (size_t i = 0; i < R*C; i++) m[i] += r.m[i]; return *this; }
+      SMatrix& operator-=(const SMatrix& r)
+      { for (size_t i = 0; i < R*C; i++) m[i] -= r.m[i]; return *this; }
+      SMatrix& operator*=(T d)
+      { for (size_t i = 0; i < R*C; i++) m[i] *= d; return *this; }
+      SMatrix& operator/=(T d)
+      { for (size_t i = 0; i < R*C; i++) m[i] /= d; return *this; }
+
+   private:
+      T m[R*C];
+   };
+
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,R,C> operator+(SMatrix<T,R,C> l, const SMatrix<T,R,C>& r)
+   { return l += r; }
+
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,R,C> operator-(SMatrix<T,R,C> l, const SMatrix<T,R,C>& r)
+   { return l -= r; }
+
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,R,C> operator*(SMatrix<T,R,C> l, T d)
+   { return l *= d; }
+
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,R,C> operator*(T d, SMatrix<T,R,C> r)
+   { return r *= d; }
+
+      /** Matrix product.  Each element is accumulated in the same
+       * order as the Matrix<T> operator, so results are identical. */
+   template <class T, size_t R, size_t K, size_t C>
+   inline SMatrix<T,R,C> operator*(const SMatrix<T,R,K>& l,
+                                   const SMatrix<T,K,C>& r)
+   {
+      SMatrix<T,R,C> rv;
+      for (size_t j = 0; j < C; j++)
+         for (size_t i = 0; i < R; i++)
+         {
+            T sum(0);
+            for (size_t k = 0; k < K; k++)
+               sum += l(i,k) * r(k,j);
+            rv(i,j) = sum;
+         }
+      return rv;
+   }
+
+      /// Matrix times vector.
+   template <class T, size_t R, size_t C>
+   inline SVector<T,R> operator*(const SMatrix<T,R,C>& l,
+                                 const SVector<T,C>& r)
+   {
+      SVector<T,R> rv;
+      for (size_t i = 0; i < R; i++)
+      {
+         T sum(0);
+         for (size_t k = 0; k < C; k++)
+            sum += l(i,k) * r[k];
+         rv[i] = sum;
+      }
+      return rv;
+   }
+
+      /// Vector times matrix, i.e. transpose(M) * v.
+   template <class T, size_t R, size_t C>
+   inline SVector<T,C> operator*(const SVector<T,R>& l,
+                                 const SMatrix<T,R,C>& r)
+   {
+      SVector<T,C> rv;
+      for (size_t j = 0; j < C; j++)
+      {
+         T sum(0);
+         for (size_t k = 0; k < R; k++)
+            sum += l[k] * r(k,j);
+         rv[j] = sum;
+      }
+      return rv;
+   }
+
+      /// Return the transpose of the matrix.
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,C,R> transpose(const SMatrix<T,R,C>& a)
+   {
+      SMatrix<T,C,R> rv;
+      for (size_t j = 0; j < C; j++)
+         for (size_t i = 0; i < R; i++)
+            rv(j,i) = a(i,j);
+      return rv;
+   }
+
+      /**
+       * Cholesky decomposition of a symmetric positive definite
+       * matrix: returns the lower triangular L with A = L*transpose(L).
+       * Same algorithm as Cholesky<T>::L.
+       * @throw MatrixException if A is not positive definite.
+       */
+   template <class T, size_t N>
+   inline SMatrix<T,N,N> cholesky(const SMatrix<T,N,N>& a)
+   {
+      SMatrix<T,N,N> P(a), L;
+      for (size_t j = 0; j < N; j++)
+      {
+         if (P(j,j) <= T(0))
+         {
+            MatrixException e("Cholesky fails - eigenvalue <= 0");
+            GNSSTK_THROW(e);
+         }
+         L(j,j) = std::sqrt(P(j,j));
+         T d = T(1) / L(j,j);
+         for (size_t k = j+1; k < N; k++)
+            L(k,j) = d * P(k,j);
+         for (size_t k = j+1; k < N; k++)
+            for (size_t i = k; i < N; i++)
+               P(i,k) -= L(i,j) * L(k,j);
+      }
+      return L;
+   }
+
+      /**
+       * Solve A*x = b given L = cholesky(A), by forward substitution
+       * with L and back substitution with transpose(L).
+       */
+   template <class T, size_t N>
+   inline SVector<T,N> choleskySolve(const SMatrix<T,N,N>& L,
+                                     const SVector<T,N>& b)
+   {
+      SVector<T,N> x(b);
+      for (size_t i = 0; i < N; i++)
+      {
+         T sum(x[i]);
+         for (size_t k = 0; k < i; k++)
+            sum -= L(i,k) * x[k];
+         x[i] = sum / L(i,i);
+      }
+      for (size_t i = N; i-- > 0; )
+      {
+         T sum(x[i]);
+         for (size_t k = i+1; k < N; k++)
+            sum -= L(k,i) * x[k];
+         x[i] = sum / L(i,i);
+      }
+      return x;
+   }
+
+      /**
+       * Invert a square matrix by Gauss-Jordan elimination with
+       * partial pivoting.
+       * @throw SingularMatrixException
+       */
+   template <class T, size_t N>
+   inline SMatrix<T,N,N> inverse(const SMatrix<T,N,N>& a)
+   {
+      SMatrix<T,N,N> A(a), rv(SMatrix<T,N,N>::identity());
+      for (size_t c = 0; c < N; c++)
+      {
+            // find the largest pivot in this column
+         size_t p = c;
+         for (size_t i = c+1; i < N; i++)
+            if (std::abs(A(i,c)) > std::abs(A(p,c)))
+               p = i;
+         if (A(p,c) == T(0))
+         {
+            SingularMatrixException e("Singular matrix");
+            GNSSTK_THROW(e);
+         }
+         if (p != c)
+         {
+            for (size_t j = 0; j < N; j++)
+            {
+               std::swap(A(p,j), A(c,j));
+               std::swap(rv(p,j), rv(c,j));
+            }
+         }
+            // scale the pivot row, then eliminate the column elsewhere
+         T d = T(1) / A(c,c);
+         for (size_t j = 0; j < N; j++)
+         {
+            A(c,j) *= d;
+            rv(c,j) *= d;
+         }
+         for (size_t i = 0; i < N; i++)
+         {
+            if (i == c)
+               continue;
+            T f = A(i,c);
+            if (f == T(0))
+               continue;
+            for (size_t j = 0; j < N; j++)
+            {
+               A(i,j) -= f * A(c,j);
+               rv(i,j) -= f * rv(c,j);
+            }
+         }
+      }
+      return rv;
+   }
+
+      /// Write the matrix in the same format as Matrix<T>.
+   template <class T, size_t R, size_t C>
+   inline std::ostream& operator<<(std::ostream& s, const SMatrix<T,R,C>& a)
+   { return s << a.toMatrix(); }
+
+      //@}
+
+}  // namespace gnsstk
+
+#endif // GNSSTK_SMATRIX_HPP
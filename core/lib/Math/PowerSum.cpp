@@ -78,6 +78,58 @@ namespace gnsstk
          subtract(*i);
    }
 
+   void PowerSum::add(const double *x, size_t nx) noexcept
+   {
+      const size_t L=4;
+      double acc[order+1][L];
+      size_t i, j;
+      int k;
+      for (k=1; k<=order; k++)
+         for (j=0; j<L; j++)
+            acc[k][j] = 0.0;
+
+      for (i=0; i+L <= nx; i+=L)
+      {
+         double px[L];
+         for (j=0; j<L; j++)
+            px[j] = x[i+j];
+         for (k=1; k<=order; k++)
+         {
+            for (j=0; j<L; j++)
+            {
+               acc[k][j] += px[j];
+               px[j] *= x[i+j];
+            }
+         }
+      }
+      for (j=0; i<nx; i++, j++)
+      {
+         double px=x[i];
+         for (k=1; k<=order; k++, px*=x[i])
+            acc[k][j] += px;
+      }
+
+      for (k=1; k<=order; k++)
+         s[k] += (acc[k][0] + acc[k][1]) + (acc[k][2] + acc[k][3]);
+      n += nx;
+   }
+
+   PowerSum& PowerSum::operator+=(const PowerSum& right) noexcept
+   {
+      for (int i=1; i<=order; i++)
+         s[i] += right.s[i];
+      n += right.n;
+      return *this;
+   }
+
+   PowerSum& PowerSum::operator-=(const PowerSum& right) noexcept
+   {
+      for (int i=1; i<=order; i++)
+         s[i] -= right.s[i];
+      n -= right.n;
+      return *this;
+   }
+
    /// See http://mathworld.wolfram.com/SampleCentralMoment.html for
    /// computing the central moments from the power sums.
    double PowerSum::moment(int i) const noexcept
@@ -39,6 +39,7 @@
 #ifndef GNSSTK_POWERSUM_HPP
 #define GNSSTK_POWERSUM_HPP
 
+#include <cstddef>
 #include <iostream>
 #include <list>
 
@@ -83,6 +84,20 @@ namespace gnsstk
       /// subtract(double) method.
       void subtract(dlc_iterator b, dlc_iterator e) noexcept;
 
+      /// Adds an array of values to the sums. Same as calling add(x[i]) for
+      /// each value, to within rounding, but the sums are kept in
+      /// independent lanes so that the loop vectorizes.
+      void add(const double *x, size_t nx) noexcept;
+
+      /// Combines the sums of another PowerSum, e.g. one accumulated over
+      /// another part of the data in another thread. Power sums add exactly,
+      /// so the moments are those of the union of the data.
+      PowerSum& operator+=(const PowerSum& right) noexcept;
+
+      /// Removes the sums of another PowerSum whose values were previously
+      /// added to this one. See the warning with the subtract(double) method.
+      PowerSum& operator-=(const PowerSum& right) noexcept;
+
       /// Computes the ith order central moment
       double moment(int i) const noexcept;
 
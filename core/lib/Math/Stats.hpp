@@ -45,6 +45,7 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <deque>
 #include <algorithm>
 #include "Exception.hpp"
 #include "MiscMath.hpp"
@@ -185,16 +186,58 @@ namespace gnsstk
          n--;
       }
 
+      /// add an array of samples to the computation of statistics.
+      /// Same as calling Add(x[i]) for each sample, to within rounding, but
+      /// the sums are kept in independent lanes so the loop vectorizes.
+      /// @param x array of samples
+      /// @param nx number of samples in x
+      void Add(const T *x, size_t nx)              // Stats
+      {
+         size_t i(0);
+         // the first sample, and the first non-zero one, are special
+         while(i < nx && (n == 0 || !setScale)) Add(x[i++]);
+         if(i == nx) return;
+
+         static const size_t L(4);
+         size_t j;
+         T s1[L], s2[L], lo[L], hi[L];
+         for(j=0; j<L; j++) { s1[j] = s2[j] = T(); lo[j] = min; hi[j] = max; }
+         const size_t nadd(nx-i);
+         for(; i+L <= nx; i += L) {
+            for(j=0; j<L; j++) {
+               const T sx(x[i+j]/scale);
+               s1[j] += sx;
+               s2[j] += sx*sx;
+               lo[j] = (x[i+j] < lo[j] ? x[i+j] : lo[j]);
+               hi[j] = (x[i+j] > hi[j] ? x[i+j] : hi[j]);
+            }
+         }
+         for(j=0; i < nx; i++, j++) {
+            const T sx(x[i]/scale);
+            s1[j] += sx;
+            s2[j] += sx*sx;
+            if(x[i] < lo[j]) lo[j] = x[i];
+            if(x[i] > hi[j]) hi[j] = x[i];
+         }
+         sum += (s1[0]+s1[1]) + (s1[2]+s1[3]);
+         sum2 += (s2[0]+s2[1]) + (s2[2]+s2[3]);
+         for(j=0; j<L; j++) {
+            if(lo[j] < min) min = lo[j];
+            if(hi[j] > max) max = hi[j];
+         }
+         n += nadd;
+      }
+
       /// Add gnsstk::Vector<T> of data to the statistics
       void Add(const Vector<T>& X)                 // Stats
       {
-         for(size_t i=0; i < X.size(); i++) Add(X(i));
+         if(X.size() > 0) Add(&X[0], X.size());
       }
 
       /// add a std::vector<T> of samples to the computation of statistics
-      inline void Add(std::vector<T>& X)           // Stats
+      inline void Add(const std::vector<T>& X)     // Stats
       {
-         for(size_t i=0; i<X.size(); i++) Add(X[i]);
+         Add(X.data(), X.size());
       }
 
       /// Subtract gnsstk::Vector<T> of data to the statistics
@@ -216,10 +259,13 @@ namespace gnsstk
       // combine two Stats objects -------------------------------------
 
       /// combine two Stats (assumed taken from the same or equivalent ensembles)
+      /// The sums combine exactly (to rounding), so data may be split into
+      /// shards, accumulated separately (e.g. in threads) and combined here.
       Stats<T>& operator+=(const Stats<T>& S)
       {
          if(S.n == 0)
             return *this;
+         if(n == 0) { *this = S; return *this; }   // may hold stale sums
          if(!setScale) { setScale=true; scale = S.scale; }
          // TD what if both have !setScale?
          if((n == 0) || (S.min < min)) min=S.min;
@@ -376,6 +422,121 @@ namespace gnsstk
       return s;
    }
 
+   //---------------------------------------------------------------------------
+   //---------------------------------------------------------------------------
+   /// Conventional statistics over a sliding window of the last N samples,
+   /// with O(1) cost per Add(). The sums are kept in a Stats<T>: each Add()
+   /// adds the new sample and subtracts the one leaving the window, and the
+   /// sums are rebuilt from the window every N samples so round-off from the
+   /// subtractions cannot accumulate. Minimum and maximum are kept exactly,
+   /// in monotonic queues (amortized O(1)).
+   template <class T> class SlidingStats
+   {
+   public:
+      /// constructor
+      /// @param N window length, > 0
+      /// @throw Exception if N is zero
+      explicit SlidingStats(unsigned int N) : buf(N)
+      {
+         if(N == 0) {
+            Exception e("SlidingStats window must be > 0");
+            GNSSTK_THROW(e);
+         }
+         Reset();
+      }
+
+      /// reset, i.e. ignore earlier data and restart sampling
+      inline void Reset(void)
+      {
+         next = count = sinceRebuild = 0;
+         seq = 0;
+         stats.Reset();
+         mins.clear();
+         maxs.clear();
+      }
+
+      /// add a sample, dropping the oldest if the window is full
+      void Add(const T& x)                // SlidingStats
+      {
+         const unsigned int N(buf.size());
+         if(count == N) {
+            const T old(buf[next]);
+            buf[next] = x;
+            if(++sinceRebuild >= N) {
+               stats.Reset();
+               stats.Add(buf.data(), N);
+               sinceRebuild = 0;
+            }
+            else {
+               stats.Subtract(old);
+               stats.Add(x);
+            }
+         }
+         else {
+            buf[next] = x;
+            stats.Add(x);
+            count++;
+         }
+         next = (next+1) % N;
+
+         // queues hold (sequence number, value) that may yet be the extreme
+         while(!mins.empty() && !(mins.back().second < x)) mins.pop_back();
+         mins.push_back(std::make_pair(seq,x));
+         while(!maxs.empty() && !(maxs.back().second > x)) maxs.pop_back();
+         maxs.push_back(std::make_pair(seq,x));
+         seq++;
+         if(seq > N && mins.front().first < seq-N) mins.pop_front();
+         if(seq > N && maxs.front().first < seq-N) maxs.pop_front();
+      }
+
+      /// add an array of samples
+      void Add(const T *x, size_t nx)     // SlidingStats
+      {
+         for(size_t i=0; i<nx; i++) Add(x[i]);
+      }
+
+      /// return the number of samples in the window
+      inline unsigned int N(void) const { return count; }
+
+      /// return the window length
+      inline unsigned int Window(void) const { return buf.size(); }
+
+      /// return true if the window is full
+      inline bool Full(void) const { return count == buf.size(); }
+
+      /// return minimum value in the window
+      inline T Minimum(void) const
+         { if(count) return mins.front().second; else return T(); }
+
+      /// return maximum value in the window
+      inline T Maximum(void) const
+         { if(count) return maxs.front().second; else return T(); }
+
+      /// return the average of the window
+      inline T Average(void) const { return stats.Average(); }
+
+      /// return the variance of the window
+      inline T Variance(void) const { return stats.Variance(); }
+
+      /// return the standard deviation of the window
+      inline T StdDev(void) const { return stats.StdDev(); }
+
+      /// return the sums over the window; NB. Minimum() and Maximum() of the
+      /// Stats may not be valid, use those of this class.
+      inline const Stats<T>& getStats(void) const { return stats; }
+
+   protected:
+      std::vector<T> buf;        ///< window, in arrival order (ring buffer)
+      unsigned int next;         ///< index in buf of the next sample
+      unsigned int count;        ///< number of samples in the window
+      unsigned int sinceRebuild; ///< samples replaced since the last rebuild
+      unsigned long seq;         ///< number of samples added
+      Stats<T> stats;            ///< sums over the window
+      std::deque<std::pair<unsigned long,T> > mins; ///< increasing values
+      std::deque<std::pair<unsigned long,T> > maxs; ///< decreasing values
+
+   }; // end class SlidingStats
+
    //---------------------------------------------------------------------------
    //---------------------------------------------------------------------------
    /// Sequential conventional statistics for one sample; gives results identical
@@ -886,18 +1047,41 @@ namespace gnsstk
          n--;
       }
 
+      /// Add two parallel arrays of data to the statistics; same as calling
+      /// Add(x[i],y[i]) for each pair, to within rounding, but vectorizable.
+      /// @param x array of first samples
+      /// @param y array of second samples, parallel to x
+      /// @param nd number of pairs
+      void Add(const T *x, const T *y, size_t nd)     // TwoSampleStats
+      {
+         if(nd == 0) return;
+         // samples before the first non-zero x or y contribute zero to sumxy,
+         // so the final scales can be used for all of them
+         SX.Add(x,nd);
+         SY.Add(y,nd);
+         static const size_t L(4);
+         size_t i(0), j;
+         T sxy[L] = { T(), T(), T(), T() };
+         for(; i+L <= nd; i += L)
+            for(j=0; j<L; j++)
+               sxy[j] += (x[i+j]/SX.scale)*(y[i+j]/SY.scale);
+         for(j=0; i < nd; i++, j++)
+            sxy[j] += (x[i]/SX.scale)*(y[i]/SY.scale);
+         sumxy += (sxy[0]+sxy[1]) + (sxy[2]+sxy[3]);
+         n += nd;
+      }
+
       /// Add two gnsstk::Vector<T>s of data to the statistics
       void Add(const Vector<T>& X, const Vector<T>& Y)      // TwoSampleStats
       {
-         for(size_t i=0; i<(X.size()<Y.size() ? X.size():Y.size()); i++)
-            Add(X[i],Y[i]);
+         size_t nd(X.size()<Y.size() ? X.size():Y.size());
+         if(nd > 0) Add(&X[0],&Y[0],nd);
       }
 
       /// Add two std::vectors of data to the statistics
       void Add(const std::vector<T>& X, const std::vector<T>& Y)     // TwoSampleStats
       {
-         for(size_t i=0; i<(X.size()<Y.size() ? X.size():Y.size()); i++)
-            Add(X[i],Y[i]);
+         Add(X.data(),Y.data(),(X.size()<Y.size() ? X.size():Y.size()));
       }
 
       /// Subtract two gnsstk::Vector<T>s of data from the statistics
@@ -918,9 +1102,10 @@ namespace gnsstk
 
       /// combine two TwoSampleStats (assumed to be taken from the same or
       /// equivalent ensembles)
-      TwoSampleStats<T>& operator+=(TwoSampleStats<T>& TSS)
+      TwoSampleStats<T>& operator+=(const TwoSampleStats<T>& TSS)
       {
-         if(n + TSS.n == 0) return *this;
+         if(TSS.n == 0) return *this;
+         if(n == 0) { *this = TSS; return *this; }
          SX += TSS.SX;
          SY += TSS.SY;
          sumxy += (TSS.SX.scale/SX.scale)*(TSS.SY.scale/SY.scale)*TSS.sumxy;
@@ -932,7 +1117,7 @@ namespace gnsstk
       /// equivalent ensembles.
       /// NB. Assumes that these samples were previously added.
       /// NB. Minimum() and Maximum() may no longer be valid.
-      TwoSampleStats<T>& operator-=(TwoSampleStats<T>& TSS)
+      TwoSampleStats<T>& operator-=(const TwoSampleStats<T>& TSS)
       {
          if(n <= TSS.n) { Reset(); return *this; }
          SX -= TSS.SX;
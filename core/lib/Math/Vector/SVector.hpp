@@ -0,0 +1,209 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/**
+ * @file SVector.hpp
+ * Fixed-size vector with compile-time dimension
+ */
+
+#ifndef GNSSTK_SVECTOR_HPP
+#define GNSSTK_SVECTOR_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include "Vector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A vector of N elements of type T with the dimension fixed at
+       * compile time.  The elements are stored in the object itself
+       * (no heap allocation) and all loops have compile-time bounds,
+       * so small vectors (3, 4 elements) compile down to straight
+       * line code.  Use it for the small, known-size vectors in
+       * per-epoch computations; it converts to and from Vector<T>
+       * for everything else.
+       *
+       * @sa SMatrix
+       */
+   template <class T, size_t N>
+   class SVector
+   {
+   public:
+         /// Initialize all elements to zero.
+      SVector()
+      { for (size_t i = 0; i < N; i++) v[i] = T(0); }
+
+         /** Initialize from a list of values; missing elements are zero.
+          * @throw VectorException if the list has more than N values. */
+      SVector(std::initializer_list<T> l)
+      {
+         if (l.size() > N)
+         {
+            VectorException e("Too many values for SVector");
+            GNSSTK_THROW(e);
+         }
+         size_t i = 0;
+         for (const T& x : l)
+            v[i++] = x;
+         for (; i < N; i++)
+            v[i] = T(0);
+      }
+
+         /** Copy from a Vector of the same size.
+          * @throw VectorException if the sizes differ. */
+      template <class BaseClass>
+      explicit SVector(const ConstVectorBase<T, BaseClass>& vec)
+      {
+         if (vec.size() != N)
+         {
+            VectorException e("Incompatible dimensions for SVector");
+            GNSSTK_THROW(e);
+         }
+         for (size_t i = 0; i < N; i++)
+            v[i] = vec[i];
+      }
+
+         /// Return a heap-allocated copy.
+      Vector<T> toVector() const
+      {
+         Vector<T> rv(N);
+         for (size_t i = 0; i < N; i++)
+            rv[i] = v[i];
+         return rv;
+      }
+
+         /// Convert to Vector<T> for use with the general purpose code.
+      operator Vector<T>() const
+      { return toVector(); }
+
+         /// The number of elements.
+      static constexpr size_t size()
+      { return N; }
+
+      T& operator[](size_t i)
+      { return v[i]; }
+      const T& operator[](size_t i) const
+      { return v[i]; }
+      T& operator()(size_t i)
+      { return v[i]; }
+      const T& operator()(size_t i) const
+      { return v[i]; }
+
+         /// Pointer to the elements.
+      T* data()
+      { return v; }
+      const T* data() const
+      { return v; }
+
+      SVector& operator+=(const SVector& r)
+      { for (size_t i = 0; i < N; i++) v[i] += r.v[i]; return *this; }
+      SVector& operator-=(const SVector& r)
+      { for (size_t i = 0; i < N; i++) v[i] -= r.v[i]; return *this; }
+      SVector& operator*=(T d)
+      { for (size_t i = 0; i < N; i++) v[i] *= d; return *this; }
+      SVector& operator/=(T d)
+      { for (size_t i = 0; i < N; i++) v[i] /= d; return *this; }
+
+   private:
+      T v[N];
+   };
+
+   template <class T, size_t N>
+   inline SVector<T,N> operator+(SVector<T,N> l, const SVector<T,N>& r)
+   { return l += r; }
+
+   template <class T, size_t N>
+   inline SVector<T,N> operator-(SVector<T,N> l, const SVector<T,N>& r)
+   { return l -= r; }
+
+   template <class T, size_t N>
+   inline SVector<T,N> operator-(SVector<T,N> l)
+   { return l *= T(-1); }
+
+   template <class T, size_t N>
+   inline SVector<T,N> operator*(SVector<T,N> l, T d)
+   { return l *= d; }
+
+   template <class T, size_t N>
+   inline SVector<T,N> operator*(T d, SVector<T,N> r)
+   { return r *= d; }
+
+   template <class T, size_t N>
+   inline SVector<T,N> operator/(SVector<T,N> l, T d)
+   { return l /= d; }
+
+      /// Inner product of two vectors.
+   template <class T, size_t N>
+   inline T dot(const SVector<T,N>& l, const SVector<T,N>& r)
+   {
+      T rv(0);
+      for (size_t i = 0; i < N; i++)
+         rv += l[i] * r[i];
+      return rv;
+   }
+
+      /// Euclidean length of a vector.
+   template <class T, size_t N>
+   inline T norm(const SVector<T,N>& v)
+   { return std::sqrt(dot(v, v)); }
+
+      /// Cross product of two 3-vectors.
+   template <class T>
+   inline SVector<T,3> cross(const SVector<T,3>& l, const SVector<T,3>& r)
+   {
+      return SVector<T,3>({ l[1]*r[2] - l[2]*r[1],
+                            l[2]*r[0] - l[0]*r[2],
+                            l[0]*r[1] - l[1]*r[0] });
+   }
+
+      /// Write the vector in the same format as Vector<T>.
+   template <class T, size_t N>
+   inline std::ostream& operator<<(std::ostream& s, const SVector<T,N>& v)
+   { return s << v.toVector(); }
+
+      //@}
+
+}  // namespace gnsstk
+
+#endif // GNSSTK_SVECTOR_HPP
@@ -177,9 +177,9 @@ namespace gnsstk
          }
          if (!is)
             return false;
-         while (is)
+         while (true)
          {
-            is >> data;
+            FFStreamStatus rc = data.tryGetRecord(is);
             if (processIono && !ionoProcessed)
             {
                   // We have to delay processing of iono data until we
@@ -211,13 +211,10 @@ namespace gnsstk
                   }
                }
             }
-            if (!is)
-            {
-               if (is.eof())
-                  break;
-               else
-                  return false; // some other error
-            }
+            if (rc == FFStreamStatus::EndOfFile)
+               break;
+            else if (rc == FFStreamStatus::Error)
+               return false; // some other error
             NavDataPtr eph, isc;
             NavDataPtrList health;
             if (processEph)
@@ -90,16 +90,13 @@ namespace gnsstk
          is >> head;
          if (!is)
             return false;
-         while (is)
+         while (true)
          {
-            is >> data;
-            if (!is)
-            {
-               if (is.eof())
-                  break;
-               else
-                  return false; // some other error
-            }
+            FFStreamStatus rc = data.tryGetRecord(is);
+            if (rc == FFStreamStatus::EndOfFile)
+               break;
+            else if (rc == FFStreamStatus::Error)
+               return false; // some other error
             NavDataPtr alm, health, sys;
             if (processAlm)
             {
@@ -37,6 +37,7 @@
 //
 //==============================================================================
 #include <iterator>
+#include <algorithm>
 #include "SP3NavDataFactory.hpp"
 #include "SP3Stream.hpp"
 #include "SP3Header.hpp"
@@ -98,6 +99,7 @@ namespace gnsstk
            interpType(ClkInterpType::Lagrange),
            halfOrderClk(5),
            halfOrderPos(5),
+           lazyLoad(false),
            initOrbitDataVal(0.0)
    {
       supportedSignals.insert(NavSignalID(SatelliteSystem::BeiDou,
@@ -249,6 +251,10 @@ namespace gnsstk
       }
          // ignore the return code of transNavMsgID, find might still work.
       transNavMsgID(nmid, genericID);
+      if (!lazyFiles.empty())
+      {
+         loadTimeSpan(when, when);
+      }
       rv = findGeneric(NavMessageType::Ephemeris, genericID, when, navOut);
       if (rv == false)
       {
@@ -562,30 +568,168 @@ namespace gnsstk
    addDataSource(const std::string& source)
    {
       DEBUGTRACE_FUNCTION();
+      if (lazyLoad && addLazySource(source))
+      {
+         return true;
+      }
       gnsstk::NavDataFactoryStoreCallback cb(this, data, nearestData,
                                              offsetData);
       return process(source, cb);
    }
 
 
+   void SP3NavDataFactory ::
+   clear()
+   {
+      NavDataFactoryWithStoreFile::clear();
+      lazyFiles.clear();
+   }
+
+
+   bool SP3NavDataFactory ::
+   addLazySource(const std::string& source)
+   {
+      DEBUGTRACE_FUNCTION();
+      LazyFile lf;
+      lf.filename = source;
+      if (!lf.index.open(source, lazyIndexCacheDir) || !lf.index.sorted ||
+          lf.index.epochs.empty())
+      {
+            // Let process() deal with whatever this is.
+         return false;
+      }
+      TimeSystem ts;
+      try
+      {
+         if (lf.index.format == EpochIndex::Format::SP3)
+         {
+            SP3Stream is(source.c_str(), ios::in);
+            is >> lf.sp3Head;
+            if (!is || !checkTimeSystem(lf.sp3Head))
+               return false;
+            ts = lf.sp3Head.timeSystem;
+         }
+         else
+         {
+               // Same as addRinexClock, files are only lazily
+               // loaded if the clock data is wanted.
+            if (procNavTypes.count(NavMessageType::Clock) == 0)
+               return false;
+            Rinex3ClockStream is(source.c_str(), ios::in);
+            is >> lf.clkHead;
+            if (!is || !checkTimeSystem(lf.clkHead))
+               return false;
+            ts = lf.clkHead.timeSystem;
+            useRinexClockData();
+         }
+      }
+      catch (gnsstk::Exception& exc)
+      {
+         return false;
+      }
+      CommonTime first(lf.index.epochs.front().time),
+         last(lf.index.epochs.back().time);
+      first.setTimeSystem(ts);
+      last.setTimeSystem(ts);
+      updateInitialFinal(first, last);
+      lf.loaded.resize(lf.index.epochs.size(), false);
+      lazyFiles.push_back(lf);
+      return true;
+   }
+
+
+   bool SP3NavDataFactory ::
+   loadTimeSpan(const CommonTime& from, const CommonTime& to)
+   {
+      DEBUGTRACE_FUNCTION();
+         // Load enough epochs on each side to interpolate, plus one
+         // to allow for the exact-match shift in findIterator.
+      size_t pad = std::max(halfOrderPos, halfOrderClk) + 1;
+      bool rv = true;
+      for (auto& lf : lazyFiles)
+      {
+         size_t n = lf.index.epochs.size();
+         size_t i0 = lf.index.upperBound(from);
+         size_t i1 = lf.index.upperBound(to);
+         i0 = (i0 > pad) ? i0 - pad : 0;
+         i1 = std::min(i1 + pad, n);
+            // load each run of epochs that isn't loaded yet
+         size_t i = i0;
+         while (i < i1)
+         {
+            if (lf.loaded[i])
+            {
+               i++;
+               continue;
+            }
+            size_t j = i;
+            while ((j < i1) && !lf.loaded[j])
+               j++;
+            if (!loadEpochs(lf, i, j))
+               rv = false;
+            i = j;
+         }
+      }
+      return rv;
+   }
+
+
+   bool SP3NavDataFactory ::
+   loadEpochs(LazyFile& lf, size_t first, size_t last)
+   {
+      DEBUGTRACE_FUNCTION();
+      DEBUGTRACE(lf.filename << " epochs [" << first << "," << last << ")");
+      gnsstk::NavDataFactoryStoreCallback cb(this, data, nearestData,
+                                             offsetData);
+      bool rv = true;
+      CommonTime stopTime(CommonTime::END_OF_TIME);
+      if (last < lf.index.epochs.size())
+         stopTime = lf.index.epochs[last].time;
+      try
+      {
+         if (lf.index.format == EpochIndex::Format::SP3)
+         {
+            SP3Stream is(lf.filename.c_str(), ios::in);
+               // Skip the header, using the copy from addLazySource.
+            is.header = lf.sp3Head;
+            is.seekg(lf.index.epochs[first].offset);
+            rv = is && loadSP3Records(is, lf.sp3Head, stopTime, cb);
+         }
+         else
+         {
+            Rinex3ClockStream is(lf.filename.c_str(), ios::in);
+            is.headerRead = true;
+            is.seekg(lf.index.epochs[first].offset);
+            rv = is && loadClockRecords(is, lf.clkHead, stopTime, cb);
+         }
+      }
+      catch (gnsstk::Exception& exc)
+      {
+         rv = false;
+         cerr << exc << endl;
+      }
+      catch (std::exception& exc)
+      {
+         rv = false;
+         cerr << exc.what() << endl;
+      }
+         // Mark the epochs as loaded even on failure so that a bad
+         // file isn't re-read on every find().
+      std::fill(lf.loaded.begin() + first, lf.loaded.begin() + last, true);
+      return rv;
+   }
+
+
    bool SP3NavDataFactory ::
    process(const std::string& filename,
            NavDataFactoryCallback& cb)
    {
       DEBUGTRACE_FUNCTION();
       bool rv = true;
-      bool processEph = (procNavTypes.count(NavMessageType::Ephemeris) > 0);
-      bool processClk = (procNavTypes.count(NavMessageType::Clock) > 0);
-         // When either of these two change, we store the existing
-         // NavDataPtr and create a new one.
-      CommonTime lastTime;
-      SatID lastSat;
-      NavDataPtr eph, clk;
       try
       {
          SP3Stream is(filename.c_str(), ios::in);
          SP3Header head;
-         SP3Data data;
          if (!is)
          {
             return false;
@@ -595,102 +739,11 @@ namespace gnsstk
          {
             return addRinexClock(filename, cb);
          }
-
-            // know whether to look for the extra info contained in SP3c
-         bool isC = (head.version==SP3Header::SP3c);
-            // check/save TimeSystem to storeTimeSystem
-         if ((head.timeSystem != TimeSystem::Any) &&
-             (head.timeSystem != TimeSystem::Unknown))
-         {
-               // if store time system has not been set, do so
-            if (storeTimeSystem == TimeSystem::Any)
-            {
-                  /// @note store TimeSystem must be consistent.
-               storeTimeSystem = head.timeSystem;
-            }
-            else if (storeTimeSystem != head.timeSystem)
-            {
-                  // Don't load an SP3 file with a differing time system
-               cerr << "Time system mismatch in SP3 data, "
-                    << gnsstk::StringUtils::asString(storeTimeSystem)
-                    << " (store) != "
-                    << gnsstk::StringUtils::asString(head.timeSystem)
-                    << " (file)" << endl;
-               return false;
-            }
-         }
-
-         while (is)
+         if (!checkTimeSystem(head))
          {
-            is >> data;
-            if (!is)
-            {
-               if (is.eof())
-                  break;
-               else
-                  return false; // some other error
-            }
-            if ((lastSat != data.sat) || (lastTime != data.time))
-            {
-               DEBUGTRACE("time or satellite change, storing");
-               lastSat = data.sat;
-               lastTime = data.time;
-               DEBUGTRACE("storing eph");
-               if (!store(processEph, cb, eph))
-                  return false;
-               DEBUGTRACE("storing clk");
-               if (!store(processClk && useSP3clock, cb, clk))
-                  return false;
-            }
-               // Don't process time records otherwise we'll end up
-               // storing junk in the store that has a time stamp and
-               // a bogus satellite ID.
-            if (data.RecType != '*')
-            {
-               if (rejectBadPosFlag &&
-                   (data.x[0] == 0.0) ||
-                   (data.x[1] == 0.0) ||
-                   (data.x[2] == 0.0))
-               {
-                     // don't add this record with a bad position
-                  continue;
-               }
-               else if (rejectBadClockFlag && (fabs(data.clk) >= maxBias))
-               {
-                     // don't add this record with a bad clock
-                  continue;
-               }
-               if (processEph)
-               {
-                     // If the orbit data are predictions and we've
-                     // been asked to ignore position predictions, do
-                     // so. Otherwise, add the data to the store.
-                  if ((!rejectPredPosFlag || data.orbitPredFlag) &&
-                      !convertToOrbit(head, data, isC, eph, initOrbitDataVal))
-                  {
-                     return false;
-                  }
-               }
-               if (processClk)
-               {
-                     // If the clock data are predictions and we've
-                     // been asked to ignore clock predictions, do
-                     // so. Otherwise, add the data to the store.
-                  if ((!rejectPredClockFlag || data.clockPredFlag) &&
-                      !convertToClock(head, data, isC, clk, initOrbitDataVal))
-                  {
-                     return false;
-                  }
-               }
-            }
-         }
-            // store the final record(s)
-         DEBUGTRACE("storing last eph");
-         if (!store(processEph, cb, eph))
-            return false;
-         DEBUGTRACE("storing last clk");
-         if (!store(processClk, cb, clk))
             return false;
+         }
+         rv = loadSP3Records(is, head, CommonTime::END_OF_TIME, cb);
       }
       catch (gnsstk::Exception& exc)
       {
@@ -711,6 +764,125 @@ namespace gnsstk
    }
 
 
+   bool SP3NavDataFactory ::
+   checkTimeSystem(const SP3Header& head)
+   {
+         // check/save TimeSystem to storeTimeSystem
+      if ((head.timeSystem != TimeSystem::Any) &&
+          (head.timeSystem != TimeSystem::Unknown))
+      {
+            // if store time system has not been set, do so
+         if (storeTimeSystem == TimeSystem::Any)
+         {
+               /// @note store TimeSystem must be consistent.
+            storeTimeSystem = head.timeSystem;
+         }
+         else if (storeTimeSystem != head.timeSystem)
+         {
+               // Don't load an SP3 file with a differing time system
+            cerr << "Time system mismatch in SP3 data, "
+                 << gnsstk::StringUtils::asString(storeTimeSystem)
+                 << " (store) != "
+                 << gnsstk::StringUtils::asString(head.timeSystem)
+                 << " (file)" << endl;
+            return false;
+         }
+      }
+      return true;
+   }
+
+
+   bool SP3NavDataFactory ::
+   loadSP3Records(SP3Stream& is, const SP3Header& head,
+                  const CommonTime& stopTime, NavDataFactoryCallback& cb)
+   {
+      DEBUGTRACE_FUNCTION();
+      bool processEph = (procNavTypes.count(NavMessageType::Ephemeris) > 0);
+      bool processClk = (procNavTypes.count(NavMessageType::Clock) > 0);
+         // When either of these two change, we store the existing
+         // NavDataPtr and create a new one.
+      CommonTime lastTime;
+      SatID lastSat;
+      NavDataPtr eph, clk;
+      SP3Data data;
+         // know whether to look for the extra info contained in SP3c
+      bool isC = (head.version==SP3Header::SP3c);
+      while (true)
+      {
+         FFStreamStatus rc = data.tryGetRecord(is);
+         if (rc == FFStreamStatus::EndOfFile)
+            break;
+         else if (rc == FFStreamStatus::Error)
+            return false; // some other error
+         if ((data.RecType == '*') && (data.time >= stopTime))
+         {
+            break;
+         }
+         if ((lastSat != data.sat) || (lastTime != data.time))
+         {
+            DEBUGTRACE("time or satellite change, storing");
+            lastSat = data.sat;
+            lastTime = data.time;
+            DEBUGTRACE("storing eph");
+            if (!store(processEph, cb, eph))
+               return false;
+            DEBUGTRACE("storing clk");
+            if (!store(processClk && useSP3clock, cb, clk))
+               return false;
+         }
+            // Don't process time records otherwise we'll end up
+            // storing junk in the store that has a time stamp and
+            // a bogus satellite ID.
+         if (data.RecType != '*')
+         {
+            if (rejectBadPosFlag &&
+                (data.x[0] == 0.0) ||
+                (data.x[1] == 0.0) ||
+                (data.x[2] == 0.0))
+            {
+                  // don't add this record with a bad position
+               continue;
+            }
+            else if (rejectBadClockFlag && (fabs(data.clk) >= maxBias))
+            {
+                  // don't add this record with a bad clock
+               continue;
+            }
+            if (processEph)
+            {
+                  // If the orbit data are predictions and we've
+                  // been asked to ignore position predictions, do
+                  // so. Otherwise, add the data to the store.
+               if ((!rejectPredPosFlag || data.orbitPredFlag) &&
+                   !convertToOrbit(head, data, isC, eph, initOrbitDataVal))
+               {
+                  return false;
+               }
+            }
+            if (processClk)
+            {
+                  // If the clock data are predictions and we've
+                  // been asked to ignore clock predictions, do
+                  // so. Otherwise, add the data to the store.
+               if ((!rejectPredClockFlag || data.clockPredFlag) &&
+                   !convertToClock(head, data, isC, clk, initOrbitDataVal))
+               {
+                  return false;
+               }
+            }
+         }
+      }
+         // store the final record(s)
+      DEBUGTRACE("storing last eph");
+      if (!store(processEph, cb, eph))
+         return false;
+      DEBUGTRACE("storing last clk");
+      if (!store(processClk && useSP3clock, cb, clk))
+         return false;
+      return true;
+   }
+
+
    bool SP3NavDataFactory ::
    addRinexClock(const std::string& source, NavDataFactoryCallback& cb)
    {
@@ -724,7 +896,6 @@ namespace gnsstk
       {
          Rinex3ClockStream is(source.c_str(), ios::in);
          Rinex3ClockHeader head;
-         Rinex3ClockData data;
          if (!is)
          {
             return false;
@@ -739,73 +910,15 @@ namespace gnsstk
          if (!processClk)
             return true; // ...but the user doesn't want it.
 
-            // check/save TimeSystem to storeTimeSystem
-         if(head.timeSystem != TimeSystem::Any &&
-            head.timeSystem != TimeSystem::Unknown)
-         {
-               // if store time system has not been set, do so
-            if(storeTimeSystem == TimeSystem::Any)
-            {
-                  /// @note store TimeSystem must be consistent.
-               storeTimeSystem = head.timeSystem;
-            }
-            else if (storeTimeSystem != head.timeSystem)
-            {
-                  // Don't load a RINEX clock file with a differing time system
-               cerr << "Time system mismatch in SP3/RINEX clock data "
-                    << gnsstk::StringUtils::asString(storeTimeSystem)
-                    << " (store) != "
-                    << gnsstk::StringUtils::asString(head.timeSystem)
-                    << " (file)" << endl;
-               return false;
-            }
-         }
-         else
-         {
-            head.timeSystem = TimeSystem::GPS;
-            storeTimeSystem = head.timeSystem;
-         }
+         if (!checkTimeSystem(head))
+            return false;
 
             // Valid RINEX clock data with appropriate time system, go
             // ahead and switch to using RINEX clock instead of SP3
             // clock.
          useRinexClockData();
 
-         while (is)
-         {
-            is >> data;
-            if (!is)
-            {
-               if (is.eof())
-                  break;
-               else
-                  return false; // some other error
-            }
-            if(data.datatype == std::string("AS"))
-            {
-               data.time.setTimeSystem(head.timeSystem);
-               OrbitDataSP3 *gps;
-               NavDataPtr clk = std::make_shared<OrbitDataSP3>(
-                  initOrbitDataVal);
-                  // Force the message type to clock because
-                  // OrbitDataSP3 defaults to Ephemeris.
-               clk->signal.messageType = NavMessageType::Clock;
-               setSignal(data.sat, clk->signal);
-               gps = dynamic_cast<OrbitDataSP3*>(clk.get());
-               gps->timeStamp = data.time;
-                  // apparently the time system isn't set in
-                  // Rinex3ClockData, only in the header.
-               gps->timeStamp.setTimeSystem(head.timeSystem);
-               gps->clkBias = data.bias * 1e6; // seconds to us
-               gps->biasSig = data.sig_bias;
-               gps->clkDrift = data.drift * 1e-6;
-               gps->driftSig = data.sig_drift;
-               gps->clkDrRate = data.accel;
-               gps->drRateSig = data.sig_accel;
-               if (!store(processClk, cb, clk))
-                  return false;
-            }
-         }
+         rv = loadClockRecords(is, head, CommonTime::END_OF_TIME, cb);
       }
       catch (gnsstk::Exception& exc)
       {
@@ -826,6 +939,81 @@ namespace gnsstk
    }
 
 
+   bool SP3NavDataFactory ::
+   checkTimeSystem(Rinex3ClockHeader& head)
+   {
+         // check/save TimeSystem to storeTimeSystem
+      if(head.timeSystem != TimeSystem::Any &&
+         head.timeSystem != TimeSystem::Unknown)
+      {
+            // if store time system has not been set, do so
+         if(storeTimeSystem == TimeSystem::Any)
+         {
+               /// @note store TimeSystem must be consistent.
+            storeTimeSystem = head.timeSystem;
+         }
+         else if (storeTimeSystem != head.timeSystem)
+         {
+               // Don't load a RINEX clock file with a differing time system
+            cerr << "Time system mismatch in SP3/RINEX clock data "
+                 << gnsstk::StringUtils::asString(storeTimeSystem)
+                 << " (store) != "
+                 << gnsstk::StringUtils::asString(head.timeSystem)
+                 << " (file)" << endl;
+            return false;
+         }
+      }
+      else
+      {
+         head.timeSystem = TimeSystem::GPS;
+         storeTimeSystem = head.timeSystem;
+      }
+      return true;
+   }
+
+
+   bool SP3NavDataFactory ::
+   loadClockRecords(Rinex3ClockStream& is, const Rinex3ClockHeader& head,
+                    const CommonTime& stopTime, NavDataFactoryCallback& cb)
+   {
+      Rinex3ClockData data;
+      while (true)
+      {
+         FFStreamStatus rc = data.tryGetRecord(is);
+         if (rc == FFStreamStatus::EndOfFile)
+            break;
+         else if (rc == FFStreamStatus::Error)
+            return false; // some other error
+            // apparently the time system isn't set in
+            // Rinex3ClockData, only in the header.
+         data.time.setTimeSystem(head.timeSystem);
+         if (data.time >= stopTime)
+            break;
+         if(data.datatype == std::string("AS"))
+         {
+            OrbitDataSP3 *gps;
+            NavDataPtr clk = std::make_shared<OrbitDataSP3>(
+               initOrbitDataVal);
+               // Force the message type to clock because
+               // OrbitDataSP3 defaults to Ephemeris.
+            clk->signal.messageType = NavMessageType::Clock;
+            setSignal(data.sat, clk->signal);
+            gps = dynamic_cast<OrbitDataSP3*>(clk.get());
+            gps->timeStamp = data.time;
+            gps->clkBias = data.bias * 1e6; // seconds to us
+            gps->biasSig = data.sig_bias;
+            gps->clkDrift = data.drift * 1e-6;
+            gps->driftSig = data.sig_drift;
+            gps->clkDrRate = data.accel;
+            gps->drRateSig = data.sig_accel;
+            if (!store(true, cb, clk))
+               return false;
+         }
+      }
+      return true;
+   }
+
+
    std::string SP3NavDataFactory ::
    getFactoryFormats() const
    {
@@ -1515,6 +1703,8 @@ namespace gnsstk
         << " predicted positions." << endl
         << (rejectPredClockFlag ? " Reject":" Do not reject")
         << " predicted clocks." << endl
+        << (lazyLoad ? " Lazy":" Full") << " loading of data sources ("
+        << lazyFiles.size() << " lazy)." << endl
         << "Position data:" << endl
         << " Interpolation is Lagrange, of order " << getPositionInterpOrder()
         << " (" << halfOrderPos << " points on each side)" << endl
@@ -42,6 +42,10 @@
 #include "NavDataFactoryWithStoreFile.hpp"
 #include "SP3Data.hpp"
 #include "SP3Header.hpp"
+#include "SP3Stream.hpp"
+#include "Rinex3ClockHeader.hpp"
+#include "Rinex3ClockStream.hpp"
+#include "EpochIndex.hpp"
 #include "gnsstk_export.h"
 
 namespace gnsstk
@@ -54,6 +58,15 @@ namespace gnsstk
        *   be selected via setTypeFilter (by default all data is
        *   selected).
        * @note SP3 does not contain health information.
+       *
+       * By default, addDataSource() loads the entire file into the
+       * internal store.  When lazy loading is enabled (see
+       * setLazyLoad()), addDataSource() only indexes the epochs of
+       * the file (see EpochIndex), and find() loads the epochs
+       * needed to interpolate at the requested time on demand.
+       * Methods that examine the internal store directly
+       * (e.g. numSatellites()) only see the data loaded so far; use
+       * loadTimeSpan() to force loading a span of time.
        */
    class SP3NavDataFactory : public NavDataFactoryWithStoreFile
    {
@@ -125,6 +138,34 @@ namespace gnsstk
          /// Return a comma-separated list of formats supported by this factory.
       std::string getFactoryFormats() const override;
 
+         /// Remove all data, including any lazily loaded sources.
+      void clear() override;
+
+         /** Enable or disable lazy loading of data sources.  Only
+          * affects subsequent calls to addDataSource().
+          * @param[in] lazy If true, addDataSource() only indexes
+          *   files, loading data as needed by find().
+          * @param[in] indexCacheDir If not empty, epoch indices are
+          *   read from and written to sidecar files in this
+          *   directory (see EpochIndex::open()).  By default
+          *   nothing is written. */
+      void setLazyLoad(bool lazy,
+                       const std::string& indexCacheDir = std::string())
+      { lazyLoad = lazy; lazyIndexCacheDir = indexCacheDir; }
+
+         /// Return true if lazy loading is enabled.
+      bool isLazyLoad() const
+      { return lazyLoad; }
+
+         /** Load the epochs of all lazily loaded sources needed to
+          * interpolate at any time in the span [from,to].  This is
+          * done implicitly by find(), but can be used ahead of time
+          * to load a known processing span in one pass.
+          * @param[in] from The start of the span of interest.
+          * @param[in] to The end of the span of interest.
+          * @return false if loading any file failed. */
+      bool loadTimeSpan(const CommonTime& from, const CommonTime& to);
+
          /** Convert SP3 nav data to a OrbitDataSP3 object with
           * position and velocity data.
           * @param[in] head The header from the SP3 file being converted.
@@ -354,6 +395,66 @@ namespace gnsstk
           *   processes the given data (obj).
           * @return true on success, false on failure. */
       bool addRinexClock(const std::string& source, NavDataFactoryCallback& cb);
+
+         /** Check and apply the time system of an SP3 header.
+          * @param[in] head The header of the file being loaded.
+          * @return false if the time system is inconsistent with
+          *   data already loaded. */
+      bool checkTimeSystem(const SP3Header& head);
+
+         /** Check and apply the time system of a RINEX clock header.
+          * @param[in,out] head The header of the file being loaded;
+          *   an unspecified time system is replaced with GPS.
+          * @return false if the time system is inconsistent with
+          *   data already loaded. */
+      bool checkTimeSystem(Rinex3ClockHeader& head);
+
+         /** Read SP3 records from the current position of a stream
+          * into the store.
+          * @param[in,out] is The stream to read, positioned at an
+          *   epoch record or just after the header.
+          * @param[in] head The header of the file being loaded.
+          * @param[in] stopTime Stop reading at the first epoch
+          *   record at or after this time.
+          * @param[in] cb The callback object that stores the data.
+          * @return false if a read or store failed. */
+      bool loadSP3Records(SP3Stream& is, const SP3Header& head,
+                          const CommonTime& stopTime,
+                          NavDataFactoryCallback& cb);
+
+         /** Read RINEX clock records from the current position of a
+          * stream into the store.
+          * @param[in,out] is The stream to read, positioned at a data
+          *   record.
+          * @param[in] head The header of the file being loaded.
+          * @param[in] stopTime Stop reading at the first record at or
+          *   after this time.
+          * @param[in] cb The callback object that stores the data.
+          * @return false if a read or store failed. */
+      bool loadClockRecords(Rinex3ClockStream& is,
+                            const Rinex3ClockHeader& head,
+                            const CommonTime& stopTime,
+                            NavDataFactoryCallback& cb);
+
+         /** Index a file for lazy loading.
+          * @param[in] source The path to the SP3 or RINEX clock file.
+          * @return false if the file can't be lazily loaded, in
+          *   which case it should be loaded in full. */
+      bool addLazySource(const std::string& source);
+
+         /// A data source that is loaded on demand.
+      struct LazyFile
+      {
+         std::string filename;       ///< Path of the data file.
+         EpochIndex index;           ///< Epochs in the file.
+         SP3Header sp3Head;          ///< Header, if SP3.
+         Rinex3ClockHeader clkHead;  ///< Header, if RINEX clock.
+         std::vector<bool> loaded;   ///< Which epochs have been loaded.
+      };
+
+         /** Load the epochs [first,last) of a lazily loaded file.
+          * @return false if reading the file failed. */
+      bool loadEpochs(LazyFile& lf, size_t first, size_t last);
       
          /** Store the given NavDataPtr object internally, provided it
           * passes any requested valditity checking. 
@@ -534,6 +635,16 @@ namespace gnsstk
 
          /// Clock data interpolation method.
       ClkInterpType interpType;
+
+         /// If true, addDataSource() indexes files instead of loading them.
+      bool lazyLoad;
+
+         /** Directory for EpochIndex sidecar files used by lazy
+          * loading, or empty to not cache indices. */
+      std::string lazyIndexCacheDir;
+
+         /// Data sources that have been indexed but not fully loaded.
+      std::vector<LazyFile> lazyFiles;
    };
 
       //@}
@@ -83,12 +83,12 @@ namespace gnsstk
          YumaData data;
          if (!is)
             return false;
-         while (is)
+         while (true)
          {
-            is >> data;
-            if (!is)
+            FFStreamStatus rc = data.tryGetRecord(is);
+            if (rc != FFStreamStatus::OK)
             {
-               if (is.eof() && gotdata)
+               if ((rc == FFStreamStatus::EndOfFile) && gotdata)
                   break;
                else
                   return false; // some other error
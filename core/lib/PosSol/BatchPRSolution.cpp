@@ -0,0 +1,336 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file BatchPRSolution.cpp
+/// Pseudorange solutions for many epochs and receivers, computed in parallel.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "BatchPRSolution.hpp"
+#include "GNSSconstants.hpp"
+#include "GPSEllipsoid.hpp"
+#include "stl_helpers.hpp"
+
+namespace gnsstk
+{
+      // Time of flight (s) used for the reference time of a satellite whose
+      // first pseudorange is not a plausible range.
+   static const double defaultTimeOfFlight = 0.075;
+
+
+      // Carry the satellite state ref forward by dt seconds, with the
+      // acceleration in the Earth-fixed frame of a point mass Earth, including
+      // the Coriolis and centrifugal terms; the clock by its drift and the
+      // relativity correction as -2 R.V/c^2.
+   static Xvt propagate(const Xvt& ref, double dt)
+   {
+      static const double GM = GPSEllipsoid().gm();
+      static const double w = GPSEllipsoid().angVelocity();
+      Xvt rv(ref);
+      double r = ref.x.mag();
+      double f = -GM / (r * r * r);
+      double a[3] = { (f + w * w) * ref.x[0] + 2.0 * w * ref.v[1],
+                      (f + w * w) * ref.x[1] - 2.0 * w * ref.v[0],
+                      f * ref.x[2] };
+      for (int k = 0; k < 3; k++)
+      {
+         rv.x[k] = ref.x[k] + dt * (ref.v[k] + 0.5 * dt * a[k]);
+         rv.v[k] = ref.v[k] + dt * a[k];
+      }
+      rv.clkbias = ref.clkbias + dt * ref.clkdrift;
+      rv.relcorr = ref.relcorr
+         - 2.0 * (rv.x.dot(rv.v) - ref.x.dot(ref.v)) / (C_MPS * C_MPS);
+      return rv;
+   }
+
+
+   BatchPRSolution ::
+   BatchPRSolution(NavLibrary& nav, const TropModelFactory& tropFactory)
+         : numThreads(0),
+           order(NavSearchOrder::User),
+           navLib(nav),
+           makeTrop(tropFactory)
+   {
+   }
+
+
+   BatchPRSolution::Results BatchPRSolution ::
+   compute(const std::vector<Observation>& obs)
+   {
+      if (config.allowedGNSS.empty())
+      {
+         Exception e("Must define systems vector allowedGNSS before processing");
+         GNSSTK_THROW(e);
+      }
+
+      findSatStates(obs);
+
+      const size_t n = obs.size();
+      Results res;
+      res.receiver.resize(n);
+      res.time.resize(n);
+      res.status.resize(n, 0);
+      res.x.resize(n, 0.0);
+      res.y.resize(n, 0.0);
+      res.z.resize(n, 0.0);
+      res.clock.assign(config.allowedGNSS.size(), std::vector<double>(n, 0.0));
+      res.rms.resize(n, 0.0);
+      res.pdop.resize(n, 0.0);
+      res.tdop.resize(n, 0.0);
+      res.gdop.resize(n, 0.0);
+      res.nsvs.resize(n, 0);
+      res.sats.resize(n);
+
+         // Group the work: with memory, each receiver's epochs are solved in
+         // time order by one PRSolution; without, every epoch is independent.
+      std::vector<std::vector<size_t> > tasks;
+      if (config.hasMemory)
+      {
+         std::map<int, std::vector<size_t> > byReceiver;
+         for (size_t i = 0; i < n; i++)
+         {
+            byReceiver[obs[i].receiver].push_back(i);
+         }
+         for (auto& rv : byReceiver)
+         {
+            std::stable_sort(rv.second.begin(), rv.second.end(),
+                             [&obs](size_t l, size_t r)
+                             { return obs[l].time < obs[r].time; });
+            tasks.push_back(rv.second);
+         }
+      }
+      else
+      {
+         for (size_t i = 0; i < n; i++)
+         {
+            tasks.push_back(std::vector<size_t>(1, i));
+         }
+      }
+
+      unsigned nthreads = numThreads;
+      if (nthreads == 0)
+      {
+         nthreads = std::max(1u, std::thread::hardware_concurrency());
+      }
+      nthreads = std::max<size_t>(1, std::min<size_t>(nthreads, tasks.size()));
+
+      std::atomic<size_t> next(0);
+      std::mutex errorMutex;
+      bool failed(false);
+      Exception error;
+      auto worker = [&]()
+      {
+         try
+         {
+            std::unique_ptr<TropModel> trop(makeTrop());
+            size_t task;
+            while ((task = next++) < tasks.size())
+            {
+               PRSolution prs(config);
+               for (size_t i : tasks[task])
+               {
+                  solve(prs, trop.get(), obs, i, res);
+               }
+            }
+         }
+         catch (Exception& e)
+         {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!failed)
+            {
+               failed = true;
+               error = e;
+            }
+            next = tasks.size();
+         }
+         catch (std::exception& e)
+         {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!failed)
+            {
+               failed = true;
+               error = Exception(e.what());
+            }
+            next = tasks.size();
+         }
+      };
+
+         // the calling thread is one of the workers
+      std::vector<std::thread> threads;
+      for (unsigned t = 1; t < nthreads; t++)
+      {
+         threads.push_back(std::thread(worker));
+      }
+      worker();
+      for (std::thread& th : threads)
+      {
+         th.join();
+      }
+      if (failed)
+      {
+         GNSSTK_THROW(error);
+      }
+      return res;
+   }
+
+
+   void BatchPRSolution ::
+   findSatStates(const std::vector<Observation>& obs)
+   {
+      states.clear();
+      for (const Observation& ob : obs)
+      {
+         SatStateMap& sm(states[ob.time]);
+         for (size_t i = 0; i < ob.sats.size(); i++)
+         {
+            const SatID& sat(ob.sats[i]);
+            if (sat.id <= 0 ||
+                vectorindex(config.allowedGNSS, sat.system) == -1 ||
+                sm.find(sat) != sm.end())
+            {
+               continue;
+            }
+               // the reference is the transmit time implied by the first
+               // pseudorange, so other receivers (and clock offsets) are
+               // only milliseconds away, whatever the orbit
+            double tof(i < ob.pseudoranges.size() ?
+                       ob.pseudoranges[i] / C_MPS : 0.0);
+            if (!(tof > 0.0 && tof < 0.5))
+            {
+               tof = defaultTimeOfFlight;
+            }
+            SatState& st(sm[sat]);
+            st.ref = ob.time - tof;
+            st.ok = navLib.getXvt(NavSatelliteID(sat), st.ref, st.xvt, false,
+                                  SVHealth::Healthy, NavValidityType::ValidOnly,
+                                  order);
+         }
+      }
+   }
+
+
+   Matrix<double> BatchPRSolution ::
+   buildSVP(const Observation& ob, std::vector<SatID>& sats) const
+   {
+      Matrix<double> svp(sats.size(), 4, 0.0);
+      std::map<CommonTime, SatStateMap>::const_iterator eit;
+      eit = states.find(ob.time);
+
+      for (size_t i = 0; i < sats.size(); i++)
+      {
+         SatID& sat(sats[i]);
+            // RAIMCompute() marks the systems not allowed
+         if (sat.id <= 0 || vectorindex(config.allowedGNSS, sat.system) == -1)
+         {
+            continue;
+         }
+         SatStateMap::const_iterator sit;
+         if (eit == states.end() ||
+             (sit = eit->second.find(sat)) == eit->second.end() ||
+             !sit->second.ok)
+         {
+               // no ephemeris
+            sat.id = -::abs(sat.id);
+            continue;
+         }
+         const SatState& st(sit->second);
+         double pr(ob.pseudoranges[i]);
+
+            // as RawRange::estTransmitFromObs() and PRSolution::getSatPVT()
+         CommonTime nominal(ob.time - pr / C_MPS);
+         Xvt xvt(propagate(st.xvt, nominal - st.ref));
+         CommonTime transmit(nominal - (xvt.clkbias + xvt.relcorr));
+         xvt = propagate(st.xvt, transmit - st.ref);
+
+         svp(i, 0) = xvt.x[0];
+         svp(i, 1) = xvt.x[1];
+         svp(i, 2) = xvt.x[2];
+         svp(i, 3) = pr + C_MPS * (xvt.clkbias + xvt.relcorr);
+      }
+      return svp;
+   }
+
+
+   void BatchPRSolution ::
+   solve(PRSolution& prs, TropModel *trop,
+         const std::vector<Observation>& obs, size_t i, Results& res) const
+   {
+      const Observation& ob(obs[i]);
+      if (ob.pseudoranges.size() != ob.sats.size())
+      {
+         Exception e("Observation has different numbers of satellites and"
+                     " pseudoranges");
+         GNSSTK_THROW(e);
+      }
+
+      std::vector<SatID> sats(ob.sats);
+      Matrix<double> svp(buildSVP(ob, sats));
+      int iret = prs.RAIMCompute(ob.time, sats, svp, ob.invMC, trop);
+
+      res.receiver[i] = ob.receiver;
+      res.time[i] = ob.time;
+      res.status[i] = iret;
+      res.sats[i] = sats;
+      if (iret < 0)
+      {
+         return;
+      }
+      res.x[i] = prs.Solution(0);
+      res.y[i] = prs.Solution(1);
+      res.z[i] = prs.Solution(2);
+      for (size_t k = 0; k < prs.dataGNSS.size(); k++)
+      {
+         int col = vectorindex(config.allowedGNSS, prs.dataGNSS[k]);
+         if (col >= 0 && 3 + k < prs.Solution.size())
+         {
+            res.clock[col][i] = prs.Solution(3 + k);
+         }
+      }
+      res.rms[i] = prs.RMSResidual;
+      res.pdop[i] = prs.PDOP;
+      res.tdop[i] = prs.TDOP;
+      res.gdop[i] = prs.GDOP;
+      res.nsvs[i] = prs.Nsvs;
+   }
+
+}  // namespace gnsstk
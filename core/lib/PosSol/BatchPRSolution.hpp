@@ -0,0 +1,191 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file BatchPRSolution.hpp
+/// Pseudorange solutions for many epochs and receivers, computed in parallel.
+
+#ifndef GNSSTK_BATCHPRSOLUTION_HPP
+#define GNSSTK_BATCHPRSOLUTION_HPP
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "CommonTime.hpp"
+#include "Matrix.hpp"
+#include "NavLibrary.hpp"
+#include "PRSolution.hpp"
+#include "SatID.hpp"
+#include "TropModel.hpp"
+#include "Xvt.hpp"
+
+namespace gnsstk
+{
+   /// @ingroup GNSSsolutions
+   //@{
+
+   /// Compute PRSolution::RAIMCompute() solutions for a batch of data, e.g. a
+   /// day of epochs from one receiver or the same epochs from a network of
+   /// receivers.
+   ///
+   /// The satellite states are found once per satellite and epoch: all
+   /// receivers with the same nominal receive time share one NavLibrary
+   /// evaluation, at the transmit time implied by the first pseudorange of
+   /// that satellite, which is carried to each receiver's transmit time (a few
+   /// ms away, for MEO, IGSO and GEO orbits alike) by a second order
+   /// expansion. This reproduces the per-receiver ephemeris evaluations of
+   /// PRSolution to well below a millimeter for receivers within a few
+   /// thousand km of each other.
+   /// The solutions are then computed on a pool of threads. Each receiver's
+   /// data is solved in time order by its own copy of the PRSolution settings
+   /// when PRSolution::hasMemory is set; otherwise every epoch is independent.
+   ///
+   /// NavLibrary is not thread safe, so it is only used from the calling
+   /// thread, and TropModel keeps per-call state, so each thread gets its own
+   /// from the given factory. Tropospheric delays depend on the receiver
+   /// position and so cannot be shared between receivers.
+   ///
+   /// @code
+   /// BatchPRSolution batch(navLib, []()
+   ///    { return std::unique_ptr<TropModel>(new GlobalTropModel); });
+   /// batch.config.allowedGNSS = { SatelliteSystem::GPS };
+   /// BatchPRSolution::Results res = batch.compute(obs);
+   /// for (size_t i = 0; i < res.size(); i++)
+   ///    if (res.status[i] >= 0) use(res.x[i], res.y[i], res.z[i]);
+   /// @endcode
+   class BatchPRSolution
+   {
+   public:
+         /// Pseudorange data from one receiver at one epoch.
+      struct Observation
+      {
+         Observation() : receiver(0) {}
+            /// Caller's index of the receiver.
+         int receiver;
+            /// Nominal time of reception.
+         CommonTime time;
+            /// Satellites, parallel to pseudoranges; mark with id < 0 to skip.
+         std::vector<SatID> sats;
+            /// Raw pseudoranges (m).
+         std::vector<double> pseudoranges;
+            /// Inverse measurement covariance (m^-2), empty for no weighting.
+         Matrix<double> invMC;
+      };
+
+         /// Solutions in columns, one row per Observation, in input order.
+      struct Results
+      {
+            /// Number of rows.
+         size_t size() const
+         { return status.size(); }
+
+         std::vector<int> receiver;       ///< Observation::receiver
+         std::vector<CommonTime> time;    ///< Observation::time
+            /// Return value of PRSolution::RAIMCompute(); the solution
+            /// columns are valid when this is >= 0, and zero otherwise.
+         std::vector<int> status;
+         std::vector<double> x, y, z;     ///< ECEF position (m)
+            /// Receiver clock bias (m) for each system in
+            /// config.allowedGNSS: clock[system][row].
+         std::vector<std::vector<double> > clock;
+         std::vector<double> rms;         ///< RMS post-fit residual (m)
+         std::vector<double> pdop, tdop, gdop;
+         std::vector<int> nsvs;           ///< Satellites used
+            /// Satellites, with those excluded marked by id < 0.
+         std::vector<std::vector<SatID> > sats;
+      };
+
+         /// Creates a TropModel for one worker thread.
+      typedef std::function<std::unique_ptr<TropModel>()> TropModelFactory;
+
+         /** @param[in] nav The source of satellite ephemerides.
+          * @param[in] tropFactory Creates the TropModel used by each
+          *   thread. */
+      BatchPRSolution(NavLibrary& nav, const TropModelFactory& tropFactory);
+
+         /** Compute solutions for all of obs.
+          * @throw Exception if any solution throws, or config.allowedGNSS
+          *   is empty. */
+      Results compute(const std::vector<Observation>& obs);
+
+         /// Settings (allowedGNSS, RMSLimit, hasMemory...) copied for each
+         /// receiver's solutions.
+      PRSolution config;
+         /// Number of worker threads; 0 uses all hardware threads.
+      unsigned numThreads;
+         /// How NavLibrary searches are performed.
+      NavSearchOrder order;
+
+   private:
+         /// Satellite state at a reference time near transmission.
+      struct SatState
+      {
+         SatState() : ok(false) {}
+         bool ok;
+         CommonTime ref;
+         Xvt xvt;
+      };
+      typedef std::map<SatID, SatState> SatStateMap;
+
+         /// Fill states with one evaluation per satellite and epoch.
+      void findSatStates(const std::vector<Observation>& obs);
+
+         /** Build the SVP matrix of PRSolution::PreparePRSolution() for
+          * one observation from the shared states, marking satellites
+          * without ephemeris in sats. */
+      Matrix<double> buildSVP(const Observation& ob,
+                              std::vector<SatID>& sats) const;
+
+         /// Solve observation i with prs, storing the results in row i.
+      void solve(PRSolution& prs, TropModel *trop,
+                 const std::vector<Observation>& obs, size_t i,
+                 Results& res) const;
+
+      NavLibrary& navLib;
+      TropModelFactory makeTrop;
+         /// Shared satellite states, by nominal receive time.
+      std::map<CommonTime, SatStateMap> states;
+   };
+
+   //@}
+
+}  // namespace gnsstk
+
+#endif // GNSSTK_BATCHPRSOLUTION_HPP
@@ -40,6 +40,7 @@
 /// Pseudorange navigation solution, either a simple solution using all the
 /// given data, or a solution including editing via a RAIM algorithm.
 
+#include <algorithm>
 #include <tuple>
 #include <functional>
 
@@ -63,6 +64,182 @@
 
 namespace gnsstk
 {
+   namespace
+   {
+         /* Linearization of the all-satellite solution, used by RAIMCompute()
+            to predict the fit of an exclusion subset without iterating.  The
+            normal equations N*dx = g of the full set are downdated by the rows
+            (and, when the weights are not diagonal, the weight couplings) of
+            the excluded satellites; clock columns left without data are
+            dropped, as SimplePRSolution() would.  The prediction ignores the
+            change in the partials and corrections as the position moves, so
+            it only ranks the subsets; it does not bound the iterated fit. */
+      class RAIMScreen
+      {
+      public:
+         enum Outcome { Predicted, Singular, TooFew };
+
+         RAIMScreen()
+               : valid(false), diagonal(true)
+         {}
+
+            /* Set up from the partials, weights and residuals of a converged
+               SimplePRSolution() with all the good satellites. */
+         void init(const Matrix<double>& partials,
+                   const Matrix<double>& weights,
+                   const Vector<double>& resids)
+         {
+            H = partials;
+            W = weights;
+            r = resids;
+            M = W * H;
+            N = transposeTimes(H, M);
+            u = W * r;
+            g = u * H;
+            diagonal = true;
+            for (size_t i = 0; i < W.rows() && diagonal; i++)
+               for (size_t j = 0; j < W.cols(); j++)
+                  if (i != j && W(i,j) != 0.0)
+                  {
+                     diagonal = false;
+                     break;
+                  }
+            clockCol.assign(H.rows(), -1);
+            for (size_t i = 0; i < H.rows(); i++)
+               for (size_t k = 3; k < H.cols(); k++)
+                  if (H(i,k) != 0.0)
+                     clockCol[i] = k;
+            valid = true;
+         }
+
+            /* Predict the RMS residual when the rows 'excluded' are removed.
+               Return TooFew if the subset has fewer satellites than unknowns,
+               as SimplePRSolution() would, and Singular if it cannot be
+               predicted. */
+         Outcome predict(const std::vector<int>& excluded, double& rms) const
+         {
+            const size_t n = H.rows(), dim = H.cols();
+            std::vector<bool> kept(n, true);
+            for (int i : excluded)
+               kept[i] = false;
+
+               // active columns: position plus clocks still having data
+            std::vector<int> count(dim, 0), cols;
+            size_t nk = 0;
+            for (size_t i = 0; i < n; i++)
+            {
+               if (kept[i])
+               {
+                  nk++;
+                  if (clockCol[i] >= 0)
+                     count[clockCol[i]]++;
+               }
+            }
+            for (size_t k = 0; k < dim; k++)
+               if (k < 3 || count[k] > 0)
+                  cols.push_back(k);
+            const size_t m = cols.size();
+            if (nk < m)
+               return TooFew;
+
+               // downdate the normal equations
+            Matrix<double> NK(N);
+            Vector<double> gK(g);
+            for (int i : excluded)
+            {
+               for (size_t a = 0; a < dim; a++)
+               {
+                  gK(a) -= H(i,a) * u(i);
+                  for (size_t b = 0; b < dim; b++)
+                     NK(a,b) -= H(i,a) * M(i,b);
+               }
+            }
+            if (!diagonal)
+            {
+                  // remove the coupling of the kept rows to the excluded ones
+               for (size_t i = 0; i < n; i++)
+               {
+                  if (!kept[i])
+                     continue;
+                  double wr = 0.0;
+                  Vector<double> c(dim, 0.0);
+                  for (int j : excluded)
+                  {
+                     wr += W(i,j) * r(j);
+                     for (size_t b = 0; b < dim; b++)
+                        c(b) += W(i,j) * H(j,b);
+                  }
+                  for (size_t a = 0; a < dim; a++)
+                  {
+                     gK(a) -= H(i,a) * wr;
+                     for (size_t b = 0; b < dim; b++)
+                        NK(a,b) -= H(i,a) * c(b);
+                  }
+               }
+            }
+
+               // solve the reduced system by Cholesky, L stored in A
+            std::vector<double> A(m*m), x(m);
+            for (size_t a = 0; a < m; a++)
+            {
+               x[a] = gK(cols[a]);
+               for (size_t b = 0; b < m; b++)
+                  A[a*m+b] = NK(cols[a],cols[b]);
+            }
+            for (size_t j = 0; j < m; j++)
+            {
+               double d = A[j*m+j];
+               for (size_t k = 0; k < j; k++)
+                  d -= A[j*m+k] * A[j*m+k];
+               if (d <= 1.e-12 * std::fabs(NK(cols[j],cols[j])))
+                  return Singular;
+               A[j*m+j] = SQRT(d);
+               for (size_t i = j+1; i < m; i++)
+               {
+                  double v = A[i*m+j];
+                  for (size_t k = 0; k < j; k++)
+                     v -= A[i*m+k] * A[j*m+k];
+                  A[i*m+j] = v / A[j*m+j];
+               }
+            }
+            for (size_t i = 0; i < m; i++)
+            {
+               for (size_t k = 0; k < i; k++)
+                  x[i] -= A[i*m+k] * x[k];
+               x[i] /= A[i*m+i];
+            }
+            for (size_t i = m; i-- > 0; )
+            {
+               for (size_t k = i+1; k < m; k++)
+                  x[i] -= A[k*m+i] * x[k];
+               x[i] /= A[i*m+i];
+            }
+
+               // post-fit residuals of the kept satellites
+            double sum = 0.0;
+            for (size_t i = 0; i < n; i++)
+            {
+               if (!kept[i])
+                  continue;
+               double e = r(i);
+               for (size_t a = 0; a < m; a++)
+                  e -= H(i,cols[a]) * x[a];
+               sum += e * e;
+            }
+            rms = SQRT(sum / double(nk));
+            return Predicted;
+         }
+
+         bool valid;
+
+      private:
+         Matrix<double> H, W, M, N;
+         Vector<double> r, u, g;
+         std::vector<int> clockCol;
+         bool diagonal;
+      };
+   }
+
    const std::string PRSolution::calfmt = std::string("%04Y/%02m/%02d %02H:%02M:%02S %P");
    const std::string PRSolution::gpsfmt = std::string("%4F %10.3g");
    const std::string PRSolution::timfmt = gpsfmt + std::string(" ") + calfmt;
@@ -178,7 +355,9 @@ namespace gnsstk
             for (size_t i = 0; i < currGNSS.size(); ++i) 
             {
                int k = vectorindex(allowedGNSS,currGNSS[i]);
-               localAPSol[3 + i] = (k == -1 ? 0.0 : APSolution[3 + k]);
+                  // APSolution starts with a single clock
+               localAPSol[3 + i] = (k == -1 || 3 + k >= APSolution.size()
+                                    ? 0.0 : APSolution[3 + k]);
             }
          }
          else
@@ -298,29 +477,13 @@ namespace gnsstk
 
          LOG(DEBUG) << "RAIMCompute at time " << printTime(Tr,gpsfmt);
 
-         int iret,N;
-         size_t j;
-         std::vector<int> GoodIndexes;
-            // use these to save the 'best' solution within the loop.
-            // BestRMS marks the 'Best' set as unused.
-         bool BestTropFlag(false);
-         int BestNIter(0), BestIret(-5);
-         double BestRMS(-1.0), BestSL(0.0), BestConv(0.0);
-         Vector<double> BestSol(3,0.0), BestPFR;
-         std::vector<SatID> BestSats, SaveSats;
-         Matrix<double> SVP, BestCov, BestInvMCov, BestPartials;
-         std::vector<SatelliteSystem> BestGNSS;
-
-            // initialize
-         Valid = false;
-         currTime = Tr;
-         TropFlag = SlopeFlag = RMSFlag = false;
+         Matrix<double> SVP;
 
             // ----------------------------------------------------------------
             // fill the SVP matrix, and use it for every solution
             // NB this routine will reject sat systems not found in allowedGNSS, and
             //    sats without ephemeris.
-         N = PreparePRSolution(Tr, Sats, Pseudorange, eph, SVP, order);
+         int N = PreparePRSolution(Tr, Sats, Pseudorange, eph, SVP, order);
 
          if (LOGlevel >= ConfigureLOG::Level("DEBUG"))
          {
@@ -341,6 +504,52 @@ namespace gnsstk
             LOG(DEBUG) << oss.str();
          }
 
+         return RAIMCompute(Tr, Sats, SVP, invMC, pTropModel);
+      }
+      catch(Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+
+   int PRSolution ::
+   RAIMCompute(const CommonTime& Tr,
+               std::vector<SatID>& Sats,
+               const Matrix<double>& SVP,
+               const Matrix<double>& invMC,
+               TropModel *pTropModel)
+   {
+      try
+      {
+         int iret,N;
+         size_t j;
+         std::vector<int> GoodIndexes;
+            // use these to save the 'best' solution within the loop.
+            // BestRMS marks the 'Best' set as unused.
+         bool BestTropFlag(false);
+         int BestNIter(0), BestIret(-5);
+         double BestRMS(-1.0), BestSL(0.0), BestConv(0.0);
+         Vector<double> BestSol(3,0.0), BestPFR;
+         std::vector<SatID> BestSats, SaveSats;
+         Matrix<double> BestCov, BestInvMCov, BestPartials;
+         std::vector<SatelliteSystem> BestGNSS;
+
+            // initialize
+         Valid = false;
+         currTime = Tr;
+         TropFlag = SlopeFlag = RMSFlag = false;
+
+         if (allowedGNSS.empty())
+         {
+            Exception e("Must define systems vector allowedGNSS before processing");
+            GNSSTK_THROW(e);
+         }
+
+            // reject sat systems not found in allowedGNSS; count the good sats
+         markDisallowedGNSS(Sats, allowedGNSS);
+         N = filterMarkedSats(Sats).size();
+
             // return is >=0(number of good sats) or -4(no ephemeris)
          if (N <= 0)
          {
@@ -381,113 +590,215 @@ namespace gnsstk
             // Resids stores the post-fit data residuals.
          Vector<double> Resids;
 
+            // BestStage and BestCombo identify the saved solution, so that ties
+            // in RMS go to the first combination, as in an exhaustive search.
+         int BestStage(-1), BestCombo(-1);
+         RAIMScreen screen;
+
+            // Compute the solution with the satellites of GoodIndexes at the
+            // positions 'excluded' marked, and save it if it is the best so far.
+         auto solveCombo = [&](const std::vector<int>& excluded, int stage,
+                               int combo) -> int
+         {
+               // Mark the satellites for this combination
+            Sats = SaveSats;
+            for (int i : excluded)
+            {
+               Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
+            }
+
+            if (LOGlevel >= ConfigureLOG::Level("DEBUG"))
+            {
+               std::ostringstream oss;
+               oss << " RAIM: Try the combo ";
+               for (SatID& sat : Sats)
+               {
+                  RinexSatID rs(::abs(sat.id), sat.system);
+                  oss << " " << (isMarked(sat) ? "-" : " ") << rs;
+               }
+               LOG(DEBUG) << oss.str();
+            }
+
+               // ----------------------------------------------------------------
+               // Compute a solution given the data; ignore ranges for marked
+               // satellites. Fill Vector 'Slopes' with slopes for each unmarked
+               // satellite.
+               // Return 0  ok
+               //       -1  failed to converge
+               //       -2  singular problem
+               //       -3  not enough good data
+               //       -4  no ephemeris
+            int ret = SimplePRSolution(Tr, Sats, SVP, invMC, pTropModel,
+                    MaxNIterations, ConvergenceLimit, Resids, Slopes);
+
+            LOG(DEBUG) << " RAIM: SimplePRS returns " << ret;
+            if (ret <= RETURN_CODE::OK && ret > BestIret)
+            {
+               BestIret = ret;
+            }
+
+               // ----------------------------------------------------------------
+               // if error, caller either quits or continues with next combo
+               // (SPS sets Valid F)
+            if (ret < RETURN_CODE::OK)
+            {
+               if (ret == RETURN_CODE::FAILED_CONVERGENCE)
+               {
+                  LOG(DEBUG) << " SPS: Failed to converge - go on";
+               }
+               else if (ret == RETURN_CODE::SINGULAR_SOLUTION)
+               {
+                  LOG(DEBUG) << " SPS: singular - go on";
+               }
+               else if (ret == RETURN_CODE::NOT_ENOUGH_SVS)
+               {
+                  LOG(DEBUG) <<" SPS: not enough satellites: quit";
+               }
+               else if (ret == RETURN_CODE::NO_EPHEMERIS)
+               {
+                  LOG(DEBUG) <<" SPS: no ephemeris: quit";
+               }
+               return ret;
+            }
+
+               // ----------------------------------------------------------------
+               // print solution with diagnostic information
+            LOG(DEBUG) << outputString(std::string("RPS"),ret);
+
+               // deal with the results of SimplePRSolution()
+               // save 'best' solution for later
+            if (BestRMS < 0.0 || RMSResidual < BestRMS ||
+                (RMSResidual == BestRMS && stage == BestStage &&
+                 combo < BestCombo))
+            {
+               BestRMS = RMSResidual;
+               BestSol = Solution;
+               BestSats = SatelliteIDs;
+               BestGNSS = dataGNSS;
+               BestSL = MaxSlope;
+               BestConv = Convergence;
+               BestNIter = NIterations;
+               BestCov = Covariance;
+               BestInvMCov = invMeasCov;
+               BestPartials = Partials;
+               BestPFR = PreFitResidual;
+               BestTropFlag = TropFlag;
+               BestIret = ret;
+               BestStage = stage;
+               BestCombo = combo;
+            }
+            return ret;
+         };
+
          for (int stage = 0;; ++stage)
          {
                // compute all the combinations of N satellites taken stage at a time
             Combinations Combo(N,stage);
 
-               // compute a solution for each combination of marked satellites
-            do {
-                  // Mark the satellites for this combination
-               Sats = SaveSats;
-               for (size_t i = 0; i < GoodIndexes.size(); ++i)
+            if (stage > 0 && screen.valid)
+            {
+                  // Predict the RMS residual of every combination from the
+                  // all-satellite solution. Since the exhaustive search stops at
+                  // the first combination with too few satellites, so does this.
+               struct Candidate
                {
-                  if (Combo.isSelected(i))
+                  int combo;
+                  double rms;       // predicted RMS residual
+                  std::vector<int> excluded;
+               };
+               std::vector<Candidate> cands;
+               do {
+                  Candidate cand;
+                  cand.combo = cands.size();
+                  for (int i = 0; i < N; ++i)
                   {
-                     Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
+                     if (Combo.isSelected(i))
+                     {
+                        cand.excluded.push_back(i);
+                     }
                   }
-               }
-
-               if (LOGlevel >= ConfigureLOG::Level("DEBUG"))
+                  double rms;
+                  RAIMScreen::Outcome out(screen.predict(cand.excluded, rms));
+                     // combinations that can't be predicted go first
+                  cand.rms = (out == RAIMScreen::Predicted ? rms : -1.0);
+                  cands.push_back(cand);
+                  if (out == RAIMScreen::TooFew)
+                  {
+                     break;
+                  }
+               } while (Combo.Next() != -1);
+
+                  // Solve in order of increasing predicted RMS, so the best
+                  // combination is usually saved first. The prediction does
+                  // not bound the iterated RMS, so every combination the
+                  // exhaustive search would solve is still solved; with ties
+                  // going to the lowest combination and the best RMS, BestIret
+                  // and the saved solution do not depend on the order. The
+                  // last combination is always solved last, so that iret and
+                  // the member data are left as the exhaustive search leaves
+                  // them.
+               Candidate last(cands.back());
+               cands.pop_back();
+               std::stable_sort(cands.begin(), cands.end(),
+                                [](const Candidate& l, const Candidate& r)
+                                { return l.rms < r.rms; });
+               iret = RETURN_CODE::OK;
+               for (const Candidate& cand : cands)
                {
-                  std::ostringstream oss;
-                  oss << " RAIM: Try the combo ";
-                  for (SatID& sat : Sats)
+                  iret = solveCombo(cand.excluded, stage, cand.combo);
+                     // only the last combination can have too few satellites
+                  if (iret == RETURN_CODE::NOT_ENOUGH_SVS ||
+                      iret == RETURN_CODE::NO_EPHEMERIS)
                   {
-                     RinexSatID rs(::abs(sat.id), sat.system);
-                     oss << " " << (isMarked(sat) ? "-" : " ") << rs;
+                     break;
                   }
-                  LOG(DEBUG) << oss.str();
                }
-
-                  // ----------------------------------------------------------------
-                  // Compute a solution given the data; ignore ranges for marked
-                  // satellites. Fill Vector 'Slopes' with slopes for each unmarked
-                  // satellite.
-                  // Return 0  ok
-                  //       -1  failed to converge
-                  //       -2  singular problem
-                  //       -3  not enough good data
-                  //       -4  no ephemeris
-               iret = SimplePRSolution(Tr, Sats, SVP, invMC, pTropModel,
-                       MaxNIterations, ConvergenceLimit, Resids, Slopes);
-
-               LOG(DEBUG) << " RAIM: SimplePRS returns " << iret;
-               if (iret <= RETURN_CODE::OK && iret > BestIret)
+               if (iret != RETURN_CODE::NOT_ENOUGH_SVS &&
+                   iret != RETURN_CODE::NO_EPHEMERIS)
                {
-                  BestIret = iret;
+                  iret = solveCombo(last.excluded, stage, last.combo);
                }
-
-                  // ----------------------------------------------------------------
-                  // if error, either quit or continue with next combo (SPS sets Valid F)
-               if (iret < RETURN_CODE::OK)
-               {
-                  if (iret == RETURN_CODE::FAILED_CONVERGENCE)
+            }
+            else
+            {
+                  // compute a solution for each combination of marked satellites
+               int combo = 0;
+               do {
+                  std::vector<int> excluded;
+                  for (int i = 0; i < N; ++i)
                   {
-                     LOG(DEBUG) << " SPS: Failed to converge - go on";
-                     continue;
+                     if (Combo.isSelected(i))
+                     {
+                        excluded.push_back(i);
+                     }
                   }
-                  else if (iret == RETURN_CODE::SINGULAR_SOLUTION)
+                  iret = solveCombo(excluded, stage, combo++);
+
+                  if (iret == RETURN_CODE::FAILED_CONVERGENCE ||
+                      iret == RETURN_CODE::SINGULAR_SOLUTION)
                   {
-                     LOG(DEBUG) << " SPS: singular - go on";
                      continue;
                   }
-                  else if (iret == RETURN_CODE::NOT_ENOUGH_SVS)
+                  else if (iret == RETURN_CODE::NOT_ENOUGH_SVS ||
+                           iret == RETURN_CODE::NO_EPHEMERIS)
                   {
-                     LOG(DEBUG) <<" SPS: not enough satellites: quit";
                      break;
                   }
-                  else if (iret == RETURN_CODE::NO_EPHEMERIS)
+
+                     // the all-satellite solution is the linearization point
+                     // for predicting the later stages
+                  if (stage == 0 && iret == RETURN_CODE::OK && IncrementalRAIM)
                   {
-                     LOG(DEBUG) <<" SPS: no ephemeris: quit";
-                     break;
+                     screen.init(Partials, invMeasCov, Resids);
                   }
-               }
-
-                  // ----------------------------------------------------------------
-                  // print solution with diagnostic information
-               LOG(DEBUG) << outputString(std::string("RPS"),iret);
-
-                  // do again for residuals
-                  // if memory exists, output residuals
-                  //if(hasMemory) LOG(DEBUG) << outputString(string("RAP"), -99,
-                     //(Solution-memory.APSolution));
 
-                  // deal with the results of SimplePRSolution()
-                  // save 'best' solution for later
-               if (BestRMS < 0.0 || RMSResidual < BestRMS)
-               {
-                  BestRMS = RMSResidual;
-                  BestSol = Solution;
-                  BestSats = SatelliteIDs;
-                  BestGNSS = dataGNSS;
-                  BestSL = MaxSlope;
-                  BestConv = Convergence;
-                  BestNIter = NIterations;
-                  BestCov = Covariance;
-                  BestInvMCov = invMeasCov;
-                  BestPartials = Partials;
-                  BestPFR = PreFitResidual;
-                  BestTropFlag = TropFlag;
-                  BestIret = iret;
-               }
-
-               if (stage == 0 && RMSResidual < RMSLimit)
-               {
-                  break;
-               }
+                  if (stage == 0 && RMSResidual < RMSLimit)
+                  {
+                     break;
+                  }
 
-            } while (Combo.Next() != -1);  // get the next combinations and repeat
+               } while (Combo.Next() != -1);  // get the next combinations and repeat
+            }
 
                // end of the stage
                // success
@@ -658,7 +969,7 @@ namespace gnsstk
    {
       try
       {
-         Matrix<double> PTP(transpose(Partials) * Partials);
+         Matrix<double> PTP(transposeTimes(Partials, Partials));
          Matrix<double> Cov(inverseLUD(PTP));
          PDOP = SQRT(Cov(0, 0) + Cov(1, 1) + Cov(2, 2));
          TDOP = 0.0;
@@ -1196,8 +1507,7 @@ namespace gnsstk
             firstIteration, pTropModel, nominalReceive, currGNSS);
 
 
-      Matrix<double> partialsT = transpose(partials);
-      covariance = partialsT * weights * partials;
+      covariance = transposeWeighted(partials, weights);
 
       try
       {
@@ -1210,7 +1520,7 @@ namespace gnsstk
          GNSSTK_THROW(SingularMatrixException());
       }
 
-      G = covariance * partialsT * weights;
+      G = timesTranspose(covariance, partials) * weights;
  
       dX = G * residuals;
      
@@ -228,6 +228,7 @@ namespace gnsstk
                       NSatsReject(-1),
                       MaxNIterations(10),
                       ConvergenceLimit(3.e-7),
+                      IncrementalRAIM(true),
                       hasMemory(true),
                       fixedAPriori(false),
                       nsol(0), ndata(0), APV(0.0),
@@ -262,6 +263,14 @@ namespace gnsstk
       /// solution exceeds this.
       double ConvergenceLimit;
 
+      /// If true (the default), RAIMCompute() linearizes about the
+      /// all-satellite solution and predicts the RMS residual of each exclusion
+      /// subset by downdating those normal equations, and solves the subsets of
+      /// each stage in order of increasing predicted RMS. Every subset is still
+      /// solved, so the selection is the same as when this is false, in which
+      /// case the subsets are solved in the order of Combinations.
+      bool IncrementalRAIM;
+
       /// vector<SatelliteSystem> containing the satellite systems allowed
       /// in the solution. **This vector MUST be defined before computing solutions.**
       /// It is used to determine which clock biases are included in the solution,
@@ -485,6 +494,24 @@ namespace gnsstk
                       TropModel *pTropModel,
                       NavSearchOrder order = NavSearchOrder::User);
 
+      /// Compute a RAIM solution, as above, from a satellite position /
+      /// corrected range matrix SVP computed beforehand, e.g. by
+      /// PreparePRSolution() or shared among receivers by BatchPRSolution.
+      /// @param Tr          Measured time of reception of the data.
+      /// @param Satellites  std::vector<SatID> of satellites, with those lacking
+      ///                    ephemeris already marked; on successful return,
+      ///                    satellites excluded by the algorithm are marked.
+      /// @param SVP         Matrix<double> of dimension (N,4), as output by
+      ///                    PreparePRSolution().
+      /// @param invMC       inverse measurement covariance, as above.
+      /// @param pTropModel  pointer to gnsstk::TropModel for trop correction.
+      /// @return the same values as RAIMCompute() above.
+      int RAIMCompute(const CommonTime& Tr,
+                      std::vector<SatID>& Satellites,
+                      const Matrix<double>& SVP,
+                      const Matrix<double>& invMC,
+                      TropModel *pTropModel);
+
       /// Compute DOPs using the partials matrix from the last successful solution.
       /// RAIMCompute(), if successful, calls this before returning.
       /// Results stored in PRSolution::TDOP,PDOP,GDOP.
@@ -597,7 +624,8 @@ namespace gnsstk
             S(i) = (fixedAPriori ? fixedAPrioriPos[i] : Sol(i));
          for(i=0; i<allowedGNSS.size(); i++) {
             k = vectorindex(dataGNSS,allowedGNSS[i]);
-            S(3+i) = (k == -1 ? APSolution[3+i] : Sol[3+k]);
+            S(3+i) = (k != -1 ? Sol[3+k] :
+                      3+i < APSolution.size() ? APSolution[3+i] : 0.0);
          }
 
          APSolution = S;
@@ -0,0 +1,117 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#ifndef GNSSTK_TEST_TESTMATH_HPP
+#define GNSSTK_TEST_TESTMATH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include "Matrix.hpp"
+
+namespace gnsstk
+{
+      /** Pseudo-random numbers for tests. This is a simple linear
+       * congruential generator, so that the test data, and so the
+       * results checked by a test, are the same on every platform,
+       * unlike those of rand() or the std::random distributions. */
+   class TestRandom
+   {
+   public:
+         /// Start the sequence at seed s.
+      explicit TestRandom(unsigned long s)
+            : seed(s)
+      {}
+
+         /// Pseudo-random value in [-1,1).
+      double random()
+      {
+         seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+         return 2.0 * (seed / 2147483648.0) - 1.0;
+      }
+
+         /// Approximately normal pseudo-random value: the sum of 12
+         /// uniforms of variance 1/3, scaled to unit variance.
+      double gaussian()
+      {
+         double sum = 0;
+         for (unsigned i = 0; i < 12; i++)
+            sum += random();
+         return sum / 2.0;
+      }
+
+         /// Matrix of pseudo-random values in [-1,1), filled by rows.
+      Matrix<double> matrix(size_t r, size_t c)
+      {
+         Matrix<double> rv(r, c);
+         for (size_t i = 0; i < r; i++)
+            for (size_t j = 0; j < c; j++)
+               rv(i,j) = random();
+         return rv;
+      }
+
+         /// current state of the generator
+      unsigned long seed;
+   };
+
+
+      /// @return the largest absolute difference between the elements of
+      /// a and b, which have the same dimensions.
+   inline double maxDiff(const Matrix<double>& a, const Matrix<double>& b)
+   {
+      double rv = 0;
+      for (size_t i = 0; i < a.rows(); i++)
+         for (size_t j = 0; j < a.cols(); j++)
+            rv = std::max(rv, std::abs(a(i,j) - b(i,j)));
+      return rv;
+   }
+
+
+      /// @return the largest absolute difference between the elements of
+      /// a and b, which have the same size.
+   inline double maxDiff(const Vector<double>& a, const Vector<double>& b)
+   {
+      double rv = 0;
+      for (size_t i = 0; i < a.size(); i++)
+         rv = std::max(rv, std::abs(a(i) - b(i)));
+      return rv;
+   }
+
+} // namespace gnsstk
+
+#endif // GNSSTK_TEST_TESTMATH_HPP
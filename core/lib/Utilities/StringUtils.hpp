@@ -52,6 +52,7 @@
 #include <vector>
 #include <cstdio>   /// @todo Get rid of the stdio.h dependency if possible.
 #include <cctype>
+#include <cmath>
 #include <limits>
 
 #ifdef _WIN32
@@ -766,6 +767,38 @@ namespace gnsstk
       inline std::string asString(const double x,
                                   const std::string::size_type precision = 17);
 
+         /**
+          * Append a double in fixed notation, right-justified to
+          * length, to a string.  The result is identical to
+          * s += rightJustify(asString(x,precision),length), but the
+          * number is formatted directly in most cases rather than
+          * through a stream and temporary strings.
+          * @param s string to append to.
+          * @param x double.
+          * @param precision the number of decimal places you want displayed.
+          * @param length the width of the appended field.
+          * @return a reference to \a s.
+          */
+      inline std::string& appendFixed(std::string& s,
+                                      const double x,
+                                      const std::string::size_type precision,
+                                      const std::string::size_type length);
+
+         /**
+          * Append an integer, right-justified to length, to a string.
+          * The result is identical to
+          * s += rightJustify(asString(x),length,pad).
+          * @param s string to append to.
+          * @param x integer.
+          * @param length the width of the appended field.
+          * @param pad character to pad the field with (blank by default).
+          * @return a reference to \a s.
+          */
+      inline std::string& appendInt(std::string& s,
+                                    const long x,
+                                    const std::string::size_type length,
+                                    const char pad = ' ');
+
          /**
           * Convert any old object to a string.
           * The class must have stream operators defined.
@@ -1696,6 +1729,105 @@ namespace gnsstk
          return ss.str();
       }
 
+         // Copy the rightmost length characters of [first,last) to
+         // the end of s, padding on the left to length if needed.
+      inline void appendRightJustified(std::string& s,
+                                       const char *first,
+                                       const char *last,
+                                       const std::string::size_type length,
+                                       const char pad)
+      {
+         std::string::size_type len = last - first;
+         if (len > length)
+         {
+            first = last - length;
+         }
+         else
+         {
+            s.append(length - len, pad);
+         }
+         s.append(first, last);
+      }
+
+      inline std::string& appendFixed(std::string& s,
+                                      const double x,
+                                      const std::string::size_type precision,
+                                      const std::string::size_type length)
+      {
+         static const double scale[] =
+            { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+              1e12, 1e13, 1e14, 1e15 };
+            // Only values whose scaled magnitude is exactly
+            // representable in the integer part of a double are
+            // formatted here.
+         if ((precision < sizeof(scale)/sizeof(scale[0])) && (x == x))
+         {
+            double scaled = std::fabs(x) * scale[precision];
+            if (scaled < 4503599627370496.0) // 2^52
+            {
+               double whole = std::floor(scaled);
+               double frac = scaled - whole;
+                  // The scaled value can be off by half an ulp, so the
+                  // rounding direction is only trusted when the
+                  // fraction is clearly away from one half.  Anything
+                  // else, including exact ties, goes to the stream.
+               if (std::fabs(frac - 0.5) > scaled * 2.3e-16)
+               {
+                  unsigned long long n =
+                     static_cast<unsigned long long>(whole) +
+                     (frac > 0.5 ? 1 : 0);
+                  char buf[32];
+                  char *last = buf + sizeof(buf);
+                  char *p = last;
+                  for (std::string::size_type i = 0; i < precision; i++)
+                  {
+                     *--p = '0' + (n % 10);
+                     n /= 10;
+                  }
+                  if (precision > 0)
+                  {
+                     *--p = '.';
+                  }
+                  do
+                  {
+                     *--p = '0' + (n % 10);
+                     n /= 10;
+                  } while (n > 0);
+                  if (std::signbit(x))
+                  {
+                     *--p = '-';
+                  }
+                  appendRightJustified(s, p, last, length, ' ');
+                  return s;
+               }
+            }
+         }
+         s += rightJustify(asString(x, precision), length);
+         return s;
+      }
+
+      inline std::string& appendInt(std::string& s,
+                                    const long x,
+                                    const std::string::size_type length,
+                                    const char pad)
+      {
+         char buf[24];
+         char *last = buf + sizeof(buf);
+         char *p = last;
+         unsigned long n = (x < 0) ? 0UL - static_cast<unsigned long>(x) : x;
+         do
+         {
+            *--p = '0' + (n % 10);
+            n /= 10;
+         } while (n > 0);
+         if (x < 0)
+         {
+            *--p = '-';
+         }
+         appendRightJustified(s, p, last, length, pad);
+         return s;
+      }
+
       template<class X>
       inline std::string asString(const X x)
       {
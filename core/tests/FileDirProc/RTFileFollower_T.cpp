@@ -0,0 +1,374 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "FileUtils.hpp"
+#include "RTFileFollower.hpp"
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /** Trivial text format with one record per line.  Lines
+    * starting with '!' are malformed. */
+class LineData : public FFData
+{
+public:
+   std::string line;
+protected:
+   virtual void reallyGetRecord(FFStream& s)
+   {
+      FFTextStream& strm = dynamic_cast<FFTextStream&>(s);
+      strm.formattedGetLine(line, true);
+      if (!line.empty() && line[0] == '!')
+      {
+         FFStreamError err("Malformed record " + line);
+         GNSSTK_THROW(err);
+      }
+   }
+   virtual void reallyPutRecord(FFStream& s) const
+   {}
+};
+
+typedef RTFileFollower<FFTextStream, LineData> LineFollower;
+
+class RTFileFollower_T
+{
+public:
+      /** Check that records are delivered once and only when
+       * complete, for several files, using either event notification
+       * or polling. */
+   unsigned followTest(bool forcePolling);
+      /** Check that files are still followed after their directory
+       * is deleted and created again. */
+   unsigned lostDirTest();
+      /** Check that malformed records are reported once and skipped,
+       * and that the records after them are delivered. */
+   unsigned badRecordTest();
+
+private:
+      /// Append text to a file.
+   static void append(const std::string& fn, const std::string& text);
+      /** Poll until \a expect records have been delivered or a few
+       * seconds have passed.  Records are appended to lines as
+       * "file:line", and errors, if wanted, to errors. */
+   static void collect(LineFollower& follower, size_t expect,
+                       std::vector<std::string>& lines,
+                       std::vector<std::string> *errors = NULL);
+};
+
+
+void RTFileFollower_T ::
+append(const std::string& fn, const std::string& text)
+{
+   std::ofstream os(fn.c_str(), std::ios::out | std::ios::app);
+   os << text;
+}
+
+
+void RTFileFollower_T ::
+collect(LineFollower& follower, size_t expect, std::vector<std::string>& lines,
+        std::vector<std::string> *errors)
+{
+   std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+   LineFollower::Handler handler =
+      [&lines](const std::string& fn, const LineData& ld)
+      {
+         lines.push_back(fn.substr(fn.size()-1) + ":" + ld.line);
+      };
+   LineFollower::ErrorHandler errorHandler;
+   if (errors)
+   {
+      errorHandler =
+         [errors](const std::string& fn, const FFStreamError& e)
+         {
+            errors->push_back(fn.substr(fn.size()-1) + ":" +
+                              e.getText(0));
+         };
+   }
+   while ((lines.size() < expect) &&
+          (std::chrono::steady_clock::now() - start < std::chrono::seconds(5)))
+   {
+      follower.poll(0.5, handler, errorHandler);
+   }
+      // make sure nothing more shows up
+   follower.poll(0, handler, errorHandler);
+}
+
+
+unsigned RTFileFollower_T ::
+followTest(bool forcePolling)
+{
+   TUDEF("RTFileFollower", forcePolling ? "poll" : "events");
+   std::string base = getPathTestTemp() + getFileSep() +
+      "test_output_rtfilefollower_";
+   std::string fn1 = base + "1", fn2 = base + "2";
+   std::remove(fn1.c_str());
+   std::remove(fn2.c_str());
+   std::vector<std::string> lines;
+   LineFollower follower(forcePolling);
+   follower.monitor.pollInterval = 0.05;
+   if (forcePolling)
+   {
+      TUASSERT(!follower.monitor.isEventDriven());
+   }
+      // files don't exist yet
+   follower.addFile(fn1);
+   follower.addFile(fn2);
+   TUASSERTE(size_t, 0, follower.poll(0, LineFollower::Handler()));
+   TUASSERT(follower.getStream(fn1) == NULL);
+
+   append(fn1, "a\nb\n");
+   collect(follower, 2, lines);
+   TUASSERTE(size_t, 2, lines.size());
+   if (lines.size() == 2)
+   {
+      TUASSERTE(std::string, "1:a", lines[0]);
+      TUASSERTE(std::string, "1:b", lines[1]);
+   }
+   TUASSERT(follower.getStream(fn1) != NULL);
+
+      // a partial line is held back until its newline arrives
+   lines.clear();
+   append(fn1, "c");
+   append(fn2, "x\n");
+   collect(follower, 1, lines);
+   TUASSERTE(size_t, 1, lines.size());
+   if (lines.size() == 1)
+   {
+      TUASSERTE(std::string, "2:x", lines[0]);
+   }
+   lines.clear();
+   append(fn1, "d\ne\n");
+   collect(follower, 2, lines);
+   TUASSERTE(size_t, 2, lines.size());
+   if (lines.size() == 2)
+   {
+      TUASSERTE(std::string, "1:cd", lines[0]);
+      TUASSERTE(std::string, "1:e", lines[1]);
+   }
+   TUASSERTE(unsigned, 4, follower.getStream(fn1)->lineNumber);
+
+      // a replaced file is read from the start
+   lines.clear();
+   std::string tmp = base + "tmp";
+   std::remove(tmp.c_str());
+   append(tmp, "f\n");
+   TUASSERTE(int, 0, std::rename(tmp.c_str(), fn2.c_str()));
+   collect(follower, 1, lines);
+   TUASSERTE(size_t, 1, lines.size());
+   if (lines.size() == 1)
+   {
+      TUASSERTE(std::string, "2:f", lines[0]);
+   }
+
+      // removed files are no longer read
+   lines.clear();
+   follower.removeFile(fn1);
+   TUASSERT(follower.getStream(fn1) == NULL);
+   append(fn1, "g\n");
+   append(fn2, "h\n");
+   collect(follower, 1, lines);
+   TUASSERTE(size_t, 1, lines.size());
+   if (lines.size() == 1)
+   {
+      TUASSERTE(std::string, "2:h", lines[0]);
+   }
+
+   std::remove(fn1.c_str());
+   std::remove(fn2.c_str());
+   TURETURN();
+}
+
+
+unsigned RTFileFollower_T ::
+lostDirTest()
+{
+   TUDEF("RTFileFollower", "lostDir");
+   std::string dir = getPathTestTemp() + getFileSep() +
+      "test_output_rtfilefollower_dir";
+   std::string fn = dir + getFileSep() + "file3";
+   std::remove(fn.c_str());
+   FileUtils::makeDir(dir, 0755);
+   std::vector<std::string> lines;
+   LineFollower follower;
+   follower.monitor.pollInterval = 0.05;
+   follower.addFile(fn);
+   bool events = follower.monitor.isEventDriven();
+   append(fn, "a\n");
+   collect(follower, 1, lines);
+   TUASSERTE(size_t, 1, lines.size());
+
+      // the directory goes away, and comes back with a new file
+   std::remove(fn.c_str());
+   TUASSERTE(int, 0, std::remove(dir.c_str()));
+   lines.clear();
+   collect(follower, 0, lines);
+   TUASSERTE(size_t, 0, lines.size());
+   FileUtils::makeDir(dir, 0755);
+   append(fn, "b\n");
+   collect(follower, 1, lines);
+   TUASSERTE(size_t, 1, lines.size());
+   if (lines.size() == 1)
+   {
+      TUASSERTE(std::string, "3:b", lines[0]);
+   }
+      // back to events once the file has been seen again
+   TUASSERTE(bool, events, follower.monitor.addFile(fn));
+   lines.clear();
+   append(fn, "c\n");
+   collect(follower, 1, lines);
+   TUASSERTE(size_t, 1, lines.size());
+   if (lines.size() == 1)
+   {
+      TUASSERTE(std::string, "3:c", lines[0]);
+   }
+
+   follower.removeFile(fn);
+   std::remove(fn.c_str());
+   std::remove(dir.c_str());
+   TURETURN();
+}
+
+
+unsigned RTFileFollower_T ::
+badRecordTest()
+{
+   TUDEF("RTFileFollower", "badRecord");
+   std::string fn = getPathTestTemp() + getFileSep() +
+      "test_output_rtfilefollower_4";
+   std::remove(fn.c_str());
+   std::vector<std::string> lines, errors;
+   LineFollower follower;
+   follower.monitor.pollInterval = 0.05;
+   follower.addFile(fn);
+
+      // a corrupt record followed by valid ones
+   append(fn, "a\n!b\nc\nd\n");
+   collect(follower, 3, lines, &errors);
+   TUASSERTE(size_t, 3, lines.size());
+   if (lines.size() == 3)
+   {
+      TUASSERTE(std::string, "4:a", lines[0]);
+      TUASSERTE(std::string, "4:c", lines[1]);
+      TUASSERTE(std::string, "4:d", lines[2]);
+   }
+   TUASSERTE(size_t, 1, errors.size());
+   if (errors.size() == 1)
+   {
+      TUASSERTE(std::string, "4:Malformed record !b", errors[0]);
+   }
+
+      // the same, in a later append, with consecutive bad lines
+      // reported once
+   lines.clear();
+   errors.clear();
+   append(fn, "!e\n!f\ng\n");
+   collect(follower, 1, lines, &errors);
+   TUASSERTE(size_t, 1, lines.size());
+   if (lines.size() == 1)
+   {
+      TUASSERTE(std::string, "4:g", lines[0]);
+   }
+   TUASSERTE(size_t, 1, errors.size());
+   if (errors.size() == 1)
+   {
+      TUASSERTE(std::string, "4:Malformed record !e", errors[0]);
+   }
+
+      // a bad line without its newline may not be finished yet, and
+      // is only reported once it is
+   lines.clear();
+   errors.clear();
+   append(fn, "!h");
+   collect(follower, 0, lines, &errors);
+   TUASSERTE(size_t, 0, lines.size());
+   TUASSERTE(size_t, 0, errors.size());
+   append(fn, "i\nj\n");
+   collect(follower, 1, lines, &errors);
+   TUASSERTE(size_t, 1, lines.size());
+   if (lines.size() == 1)
+   {
+      TUASSERTE(std::string, "4:j", lines[0]);
+   }
+   TUASSERTE(size_t, 1, errors.size());
+   if (errors.size() == 1)
+   {
+      TUASSERTE(std::string, "4:Malformed record !hi", errors[0]);
+   }
+   TUASSERTE(unsigned, 9, follower.getStream(fn)->lineNumber);
+
+      // without an error handler the bad record is still skipped
+   lines.clear();
+   append(fn, "!k\nl\n");
+   collect(follower, 1, lines);
+   TUASSERTE(size_t, 1, lines.size());
+   if (lines.size() == 1)
+   {
+      TUASSERTE(std::string, "4:l", lines[0]);
+   }
+
+   follower.removeFile(fn);
+   std::remove(fn.c_str());
+   TURETURN();
+}
+
+
+int main()
+{
+   RTFileFollower_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.followTest(false);
+   errorTotal += testClass.followTest(true);
+   errorTotal += testClass.lostDirTest();
+   errorTotal += testClass.badRecordTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -36,8 +36,10 @@
 //
 //==============================================================================
 
+#include <algorithm>
 #include "BinexData.hpp"
 #include "BinexStream.hpp"
+#include "BinexBlockReader.hpp"
 #include "TestUtil.hpp"
 
 using namespace std;
@@ -66,6 +68,7 @@ public:
       // @return  number of failures, i.e., 0=PASS, !0=FAIL
    int doForwardTests();
    int doReverseTests();
+   int doBlockReaderTests();
 
    unsigned  verboseLevel;  // amount to display during tests, 0 = least
 
@@ -378,7 +381,255 @@ int BinexReadWrite_T :: doReverseTests()
 {
    TUDEF("BinexData", "Read/Write (Rev)");
 
-      // @todo
+      // Copy the test records into reverse-readable records, in
+      // both byte orders, along with records that don't depend on
+      // the input data file.
+   const BinexData::SyncByte flagList[] =
+   {
+      BinexData::eReverseReadable,
+      BinexData::eReverseReadable | BinexData::eBigEndian,
+      BinexData::eReverseReadable | BinexData::eEnhancedCRC
+   };
+   RecordList  revRecords;
+   for (unsigned i = 0; i < sizeof(flagList)/sizeof(flagList[0]); i++)
+   {
+      BinexData  smallRecord(0x7e, flagList[i]);
+      size_t  smallOffset = 0;
+      smallRecord.updateMessageData(smallOffset, std::string("BINEX"), 5);
+      smallRecord.updateMessageData(smallOffset, BinexData::UBNXI(200000));
+      smallRecord.updateMessageData(smallOffset, BinexData::MGFZI(-12345));
+      revRecords.push_back(smallRecord);
+      RecordList::const_iterator  recordIter = testRecords.begin();
+      for ( ; recordIter != testRecords.end(); ++recordIter)
+      {
+         BinexData  record(recordIter->getRecordID(), flagList[i]);
+         size_t  offset = 0;
+         record.updateMessageData(offset, recordIter->getMessageData(),
+                                  recordIter->getMessageLength());
+         revRecords.push_back(record);
+      }
+   }
+      // Include a record long enough for a 4-byte CRC and a
+      // multi-byte reverse length.
+   BinexData  bigRecord(0x7f, BinexData::eReverseReadable);
+   size_t  bigOffset = 0;
+   bigRecord.updateMessageData(bigOffset, std::string(5000, 'x'), 5000);
+   revRecords.push_back(bigRecord);
+
+   ostringstream  oss;
+   RecordList::const_iterator  recordIter = revRecords.begin();
+   for ( ; recordIter != revRecords.end(); ++recordIter)
+   {
+      try
+      {
+         recordIter->putRecord(oss);
+      }
+      catch (Exception& e)
+      {
+         ostringstream  eoss;
+         eoss << "exception writing record: " << e;
+         TUFAIL(eoss.str());
+      }
+   }
+
+      // Write the whole stream backwards, as a reader starting from
+      // the end of the file would see it.
+   string  fileData(oss.str());
+   std::reverse(fileData.begin(), fileData.end());
+   string  tempFilePath = gnsstk::getPathTestTemp();
+   string  tempFileName = tempFilePath + gnsstk::getFileSep() +
+                          "test_output_binex_readwrite_rev.binex";
+   BinexStream  outStream(tempFileName.c_str(),
+                          std::ios::out | std::ios::binary);
+   TUASSERT(outStream.good());
+   outStream.write(fileData.data(), fileData.size());
+   outStream.close();
+
+   BinexStream  inStream(tempFileName.c_str(),
+                         std::ios::in | std::ios::binary);
+   inStream.exceptions(ios_base::failbit);
+
+   TUASSERT(inStream.good());
+
+   RecordList::const_reverse_iterator  revIter = revRecords.rbegin();
+   while (inStream.good() && (EOF != inStream.peek() ) )
+   {
+      if (revIter == revRecords.rend() )
+      {
+         TUFAIL("stored records exhausted before file records");
+         break;
+      }
+      BinexData record;
+      try
+      {
+         record.getRecord(inStream);
+         if (record == *revIter)
+         {
+            TUPASS("gotten record matches");
+         }
+         else
+         {
+            ostringstream  eoss;
+            eoss << "Actual record:" << endl;
+            record.dump(eoss);
+            eoss << "Expected record:" << endl;
+            revIter->dump(eoss);
+
+            TUFAIL(eoss.str());
+         }
+      }
+      catch (Exception& e)
+      {
+         ostringstream  eoss;
+         eoss << "stream exception reading record: " << e;
+         TUFAIL(eoss.str());
+         break;
+      }
+      catch (...)
+      {
+         TUFAIL("unknown exception reading record");
+         break;
+      }
+
+      revIter++;
+   }
+   TUASSERT(revIter == revRecords.rend());
+   inStream.close();
+
+   TURETURN();
+}
+
+
+int BinexReadWrite_T :: doBlockReaderTests()
+{
+   TUDEF("BinexBlockReader", "next");
+
+      // Write every test record using all of the framing/CRC variants.
+   const BinexData::SyncByte flagList[] =
+   {
+      0,
+      BinexData::eBigEndian,
+      BinexData::eEnhancedCRC,
+      BinexData::eReverseReadable,
+      BinexData::eReverseReadable | BinexData::eBigEndian,
+      BinexData::eReverseReadable | BinexData::eEnhancedCRC
+   };
+   RecordList  expected;
+   for (unsigned i = 0; i < sizeof(flagList)/sizeof(flagList[0]); i++)
+   {
+      BinexData  smallRecord(0x7e, flagList[i]);
+      size_t  smallOffset = 0;
+      smallRecord.updateMessageData(smallOffset, std::string("BINEX"), 5);
+      expected.push_back(smallRecord);
+      RecordList::const_iterator  recordIter = testRecords.begin();
+      for ( ; recordIter != testRecords.end(); ++recordIter)
+      {
+            // Copy the (opaque) message into a record using the
+            // framing being tested.
+         BinexData  record(recordIter->getRecordID(), flagList[i]);
+         size_t  offset = 0;
+         record.updateMessageData(offset, recordIter->getMessageData(),
+                                  recordIter->getMessageLength());
+         expected.push_back(record);
+      }
+   }
+      // Include a record large enough to require a 4-byte CRC.
+   BinexData  bigRecord(0x7f, BinexData::eReverseReadable);
+   size_t  bigOffset = 0;
+   bigRecord.updateMessageData(bigOffset, std::string(5000, 'x'), 5000);
+   expected.push_back(bigRecord);
+
+   ostringstream  oss;
+   RecordList::const_iterator  recordIter;
+   for (recordIter = expected.begin(); recordIter != expected.end();
+        ++recordIter)
+   {
+      recordIter->putRecord(oss);
+   }
+   string  fileData(oss.str());
+
+      // Use a tiny block size so records straddle refills.
+   istringstream  iss(fileData);
+   BinexBlockReader  reader(iss, 7);
+   BinexRecordView  view;
+   unsigned long long  offset = 0;
+   recordIter = expected.begin();
+   try
+   {
+      while (reader.next(view))
+      {
+         if (recordIter == expected.end())
+         {
+            TUFAIL("stored records exhausted before buffered records");
+            break;
+         }
+         TUASSERTE(unsigned long long, offset, view.streamOffset);
+         TUASSERTE(size_t, recordIter->getRecordSize(), view.recordSize);
+         TUASSERT(view.toData() == *recordIter);
+         offset += view.recordSize;
+         ++recordIter;
+      }
+   }
+   catch (Exception& e)
+   {
+      ostringstream  eoss;
+      eoss << "exception reading buffered record: " << e;
+      TUFAIL(eoss.str());
+   }
+   TUASSERT(recordIter == expected.end());
+   TUASSERTE(unsigned long long, fileData.size(), reader.getOffset());
+
+      // A byte-reversed stream yields the reverse-readable records
+      // in reverse order.
+   ostringstream  revoss;
+   RecordList  revExpected;
+   for (recordIter = expected.begin(); recordIter != expected.end();
+        ++recordIter)
+   {
+      if (recordIter->getRecordFlags() & BinexData::eReverseReadable)
+      {
+         recordIter->putRecord(revoss);
+         revExpected.insert(revExpected.begin(), *recordIter);
+      }
+   }
+   string  revData(revoss.str());
+   std::reverse(revData.begin(), revData.end());
+   istringstream  reviss(revData);
+   BinexBlockReader  revReader(reviss);
+   RecordList::const_iterator  revIter = revExpected.begin();
+   try
+   {
+      for (BinexBlockReader::iterator  i = revReader.begin();
+           i != revReader.end(); ++i)
+      {
+         if (revIter == revExpected.end())
+         {
+            TUFAIL("stored records exhausted before buffered records");
+            break;
+         }
+         TUASSERT(i->toData() == *revIter);
+         ++revIter;
+      }
+   }
+   catch (Exception& e)
+   {
+      ostringstream  eoss;
+      eoss << "exception reading reversed record: " << e;
+      TUFAIL(eoss.str());
+   }
+   TUASSERT(revIter == revExpected.end());
+
+      // Corrupting a CRC must be detected.
+   string  badData(fileData);
+   badData[expected.front().getRecordSize() - 1] ^= 0x5a;
+   istringstream  badiss(badData);
+   BinexBlockReader  badReader(badiss);
+   TUTHROW(badReader.next(view));
+
+      // A record cut short by the end of input must be detected.
+   istringstream  shortiss(fileData.substr(0, 3));
+   BinexBlockReader  shortReader(shortiss);
+   TUTHROW(shortReader.next(view));
 
    TURETURN();
 }
@@ -395,8 +646,8 @@ int main(int argc, char *argv[])
    BinexReadWrite_T  testClass;  // test data is loaded here
 
    errorTotal += testClass.doForwardTests();
-
-      //errorTotal += testClass.doReverseTests();
+   errorTotal += testClass.doReverseTests();
+   errorTotal += testClass.doBlockReaderTests();
 
    return( errorTotal );
 
@@ -0,0 +1,294 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <fstream>
+#include <string>
+#include "EpochIndex.hpp"
+#include "SP3Stream.hpp"
+#include "SP3Header.hpp"
+#include "SP3Data.hpp"
+#include "CivilTime.hpp"
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+namespace gnsstk
+{
+   std::ostream& operator<<(std::ostream& s, gnsstk::EpochIndex::Format e)
+   {
+      s << static_cast<int>(e);
+      return s;
+   }
+}
+
+
+class EpochIndex_T
+{
+public:
+   EpochIndex_T();
+      /// Index an SP3 file and check the offsets.
+   unsigned sp3Test();
+      /// Index a RINEX clock file and check the offsets.
+   unsigned rinexClockTest();
+      /// Write and read the sidecar file.
+   unsigned sidecarTest();
+      /// Make sure other formats are rejected.
+   unsigned unknownTest();
+
+private:
+      /// Write an SP3c file with numEpochs epochs.
+   void writeSP3(const std::string& fn, unsigned numEpochs);
+      /// Return the line at offset in fn.
+   static std::string lineAt(const std::string& fn, std::streamoff offset);
+
+   std::string sp3File, clkFile, otherFile;
+   CommonTime t0;
+};
+
+
+EpochIndex_T ::
+EpochIndex_T()
+      : t0(CivilTime(2020,1,1,0,0,0,TimeSystem::GPS))
+{
+   std::string op = getPathTestTemp() + getFileSep();
+   sp3File = op + "test_output_EpochIndex.sp3";
+   clkFile = op + "test_output_EpochIndex.clk";
+   otherFile = op + "test_output_EpochIndex.txt";
+}
+
+
+void EpochIndex_T ::
+writeSP3(const std::string& fn, unsigned numEpochs)
+{
+   SP3Stream os(fn.c_str(), ios::out);
+   SP3Header head;
+   head.version = SP3Header::SP3c;
+   head.containsVelocity = false;
+   head.time = t0;
+   head.epochInterval = 900;
+   head.numberOfEpochs = numEpochs;
+   head.dataUsed = "ORBIT";
+   head.coordSystem = "IGS14";
+   head.orbitType = "FIT";
+   head.agency = "TST";
+   head.timeSystem = TimeSystem::GPS;
+   head.basePV = 1.25;
+   head.baseClk = 1.025;
+   head.satList[SP3SatID(1,SatelliteSystem::GPS)] = 0;
+   head.satList[SP3SatID(2,SatelliteSystem::GPS)] = 0;
+   os << head;
+   for (unsigned e = 0; e < numEpochs; e++)
+   {
+      SP3Data epoch;
+      epoch.RecType = '*';
+      epoch.time = t0 + 900.0 * e;
+      os << epoch;
+      for (int prn = 1; prn <= 2; prn++)
+      {
+         SP3Data pos;
+         pos.RecType = 'P';
+         pos.sat = SP3SatID(prn,SatelliteSystem::GPS);
+         pos.time = epoch.time;
+         pos.x[0] = 1000.0 * prn;
+         pos.x[1] = 2000.0 + e;
+         pos.x[2] = 3000.0;
+         pos.clk = 4.0;
+         os << pos;
+      }
+   }
+   os.close();
+}
+
+
+std::string EpochIndex_T ::
+lineAt(const std::string& fn, std::streamoff offset)
+{
+   std::ifstream is(fn.c_str(), ios::in | ios::binary);
+   is.seekg(offset);
+   std::string line;
+   getline(is, line);
+   return line;
+}
+
+
+unsigned EpochIndex_T ::
+sp3Test()
+{
+   TUDEF("EpochIndex", "build");
+   writeSP3(sp3File, 4);
+   EpochIndex uut;
+   TUASSERT(uut.build(sp3File));
+   TUASSERTE(EpochIndex::Format, EpochIndex::Format::SP3, uut.format);
+   TUASSERT(uut.sorted);
+   TUASSERTE(size_t, 4, uut.epochs.size());
+   for (unsigned i = 0; i < uut.epochs.size(); i++)
+   {
+      CommonTime exp(t0 + 900.0 * i);
+      exp.setTimeSystem(TimeSystem::Any);
+      TUASSERTE(CommonTime, exp, uut.epochs[i].time);
+      TUASSERTE(char, '*', lineAt(sp3File, uut.epochs[i].offset)[0]);
+   }
+   TUASSERTE(std::streamoff, uut.epochs[0].offset, uut.headerEnd);
+   TUASSERTE(std::string, "EOF", lineAt(sp3File, uut.dataEnd));
+   TUASSERTE(std::streamoff, uut.dataEnd, uut.endOffset(3));
+   TUASSERTE(std::streamoff, uut.epochs[2].offset, uut.endOffset(1));
+      // upperBound gives the first epoch after the time
+   TUASSERTE(size_t, 0, uut.upperBound(t0 - 1.0));
+   TUASSERTE(size_t, 1, uut.upperBound(t0));
+   TUASSERTE(size_t, 2, uut.upperBound(t0 + 1000.0));
+   TUASSERTE(size_t, 4, uut.upperBound(t0 + 2700.0));
+   TURETURN();
+}
+
+
+unsigned EpochIndex_T ::
+rinexClockTest()
+{
+   TUDEF("EpochIndex", "build");
+   {
+      std::ofstream os(clkFile.c_str(), ios::out | ios::trunc);
+      os << "     3.00           C                                       "
+         << "RINEX VERSION / TYPE" << endl
+         << "                                                            "
+         << "END OF HEADER" << endl
+         << "AS G01  2020 01 01 00 00  0.000000  1   "
+         << "-1.000000000000E-04" << endl
+         << "AS G02  2020 01 01 00 00  0.000000  1   "
+         << "-2.000000000000E-04" << endl
+         << "AS G01  2020 01 01 00 00 30.000000  3   "
+         << "-1.000000000000E-04  1.000000000000E-10" << endl
+         << "-1.000000000000E-12" << endl
+         << "AS G02  2020 01 01 00 00 30.000000  1   "
+         << "-2.000000000000E-04" << endl
+         << "AS G01  2020 01 01 00 01  0.000000  1   "
+         << "-1.000000000000E-04" << endl;
+   }
+   EpochIndex uut;
+   TUASSERT(uut.build(clkFile));
+   TUASSERTE(EpochIndex::Format, EpochIndex::Format::RinexClock, uut.format);
+   TUASSERT(uut.sorted);
+   TUASSERTE(size_t, 3, uut.epochs.size());
+   TUASSERTE(std::streamoff, uut.epochs[0].offset, uut.headerEnd);
+   CommonTime exp(t0);
+   exp.setTimeSystem(TimeSystem::Any);
+   for (unsigned i = 0; i < uut.epochs.size(); i++)
+   {
+      TUASSERTE(CommonTime, exp + 30.0 * i, uut.epochs[i].time);
+      TUASSERTE(std::string, "AS G01",
+                lineAt(clkFile, uut.epochs[i].offset).substr(0,6));
+   }
+   TURETURN();
+}
+
+
+unsigned EpochIndex_T ::
+sidecarTest()
+{
+   TUDEF("EpochIndex", "open");
+   writeSP3(sp3File, 5);
+   std::string cacheDir(getPathTestTemp());
+   std::string sidecar(EpochIndex::sidecarName(sp3File, cacheDir));
+   std::remove(sidecar.c_str());
+   EpochIndex built, cached;
+      // Nothing is cached unless a directory is given.
+   TUASSERT(built.open(sp3File));
+   TUASSERT(!std::ifstream(sidecar.c_str()).good());
+   TUASSERT(!cached.readSidecar(sp3File, cacheDir));
+   TUASSERT(built.open(sp3File, cacheDir));
+   TUASSERT(std::ifstream(sidecar.c_str()).good());
+   TUASSERT(cached.readSidecar(sp3File, cacheDir));
+   TUASSERTE(EpochIndex::Format, built.format, cached.format);
+   TUASSERTE(std::streamoff, built.headerEnd, cached.headerEnd);
+   TUASSERTE(std::streamoff, built.dataEnd, cached.dataEnd);
+   TUASSERTE(size_t, 5, cached.epochs.size());
+   for (unsigned i = 0; i < cached.epochs.size(); i++)
+   {
+      TUASSERTE(std::streamoff, built.epochs[i].offset,
+                cached.epochs[i].offset);
+      TUASSERTE(CommonTime, built.epochs[i].time, cached.epochs[i].time);
+   }
+      // A data file that changes size invalidates the sidecar.
+   writeSP3(sp3File, 3);
+   TUASSERT(!cached.readSidecar(sp3File, cacheDir));
+   TUASSERT(cached.open(sp3File, cacheDir));
+   TUASSERTE(size_t, 3, cached.epochs.size());
+   TUASSERT(cached.readSidecar(sp3File, cacheDir));
+   TUASSERTE(size_t, 3, cached.epochs.size());
+      // The sidecar belongs to the data file named in it.
+   std::string sameFile(cacheDir + getFileSep() + "." + getFileSep() +
+                        "test_output_EpochIndex.sp3");
+   TUASSERT(!cached.readSidecar(sameFile, cacheDir));
+   std::remove(sidecar.c_str());
+   TURETURN();
+}
+
+
+unsigned EpochIndex_T ::
+unknownTest()
+{
+   TUDEF("EpochIndex", "open");
+   {
+      std::ofstream os(otherFile.c_str(), ios::out | ios::trunc);
+      os << "not a data file" << endl;
+   }
+   EpochIndex uut;
+   TUASSERT(!uut.open(otherFile));
+   TUASSERTE(EpochIndex::Format, EpochIndex::Format::Unknown, uut.format);
+   TUASSERT(!uut.open(otherFile + ".missing"));
+   TURETURN();
+}
+
+
+int main()
+{
+   EpochIndex_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.sp3Test();
+   errorTotal += testClass.rinexClockTest();
+   errorTotal += testClass.sidecarTest();
+   errorTotal += testClass.unknownTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,243 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <fstream>
+#include <string>
+#include "FFTextStream.hpp"
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+namespace gnsstk
+{
+   std::ostream& operator<<(std::ostream& s, gnsstk::FFStreamStatus e)
+   {
+      s << static_cast<int>(e);
+      return s;
+   }
+}
+
+   /** Trivial text format with one record per line.  Lines must
+    * start with 'L', anything else is a format error. */
+class LineData : public FFData
+{
+public:
+   virtual bool isData() const
+   { return true; }
+   std::string line;
+      /// Number of times reallyGetRecord has been called.
+   static unsigned reads;
+protected:
+   virtual void reallyGetRecord(FFStream& s)
+   {
+      reads++;
+      FFTextStream& strm = dynamic_cast<FFTextStream&>(s);
+      strm.formattedGetLine(line, true);
+      if (line.empty() || (line[0] != 'L'))
+      {
+         FFStreamError err("bad line: " + line);
+         GNSSTK_THROW(err);
+      }
+   }
+   virtual void reallyPutRecord(FFStream& s) const
+   {}
+};
+
+unsigned LineData::reads = 0;
+
+
+class FFTextStream_T
+{
+public:
+   FFTextStream_T();
+      /// Read a good file to the end with tryGetRecord.
+   unsigned statusTest();
+      /// Make sure errors are reported without losing the position.
+   unsigned errorTest();
+      /// Make sure the exception API behaves as before.
+   unsigned exceptionTest();
+
+private:
+      /// Write text to a file.
+   static void writeFile(const std::string& fn, const std::string& text);
+
+   std::string goodFile, badFile, emptyFile;
+};
+
+
+FFTextStream_T ::
+FFTextStream_T()
+{
+   std::string op = getPathTestTemp() + getFileSep();
+   goodFile = op + "test_output_FFTextStream_good.txt";
+   badFile = op + "test_output_FFTextStream_bad.txt";
+   emptyFile = op + "test_output_FFTextStream_empty.txt";
+   writeFile(goodFile, "La\nLb\nLc\n");
+   writeFile(badFile, "La\nXb\nLc\n");
+   writeFile(emptyFile, "");
+}
+
+
+void FFTextStream_T ::
+writeFile(const std::string& fn, const std::string& text)
+{
+   std::ofstream os(fn.c_str(), std::ios::out | std::ios::trunc);
+   os << text;
+}
+
+
+unsigned FFTextStream_T ::
+statusTest()
+{
+   TUDEF("FFData", "tryGetRecord");
+   FFTextStream strm(goodFile.c_str());
+   LineData ld;
+   LineData::reads = 0;
+   TUASSERTE(FFStreamStatus, FFStreamStatus::OK, ld.tryGetRecord(strm));
+   TUASSERTE(std::string, "La", ld.line);
+   TUASSERTE(FFStreamStatus, FFStreamStatus::OK, ld.tryGetRecord(strm));
+   TUASSERTE(FFStreamStatus, FFStreamStatus::OK, ld.tryGetRecord(strm));
+   TUASSERTE(std::string, "Lc", ld.line);
+   TUASSERTE(FFStreamStatus, FFStreamStatus::EndOfFile,
+             ld.tryGetRecord(strm));
+      // the end of the file is found without asking the reader
+   TUASSERTE(unsigned, 3, LineData::reads);
+   TUASSERT(strm.fail());
+   TUASSERT(strm.eof());
+   TUASSERTE(unsigned, 3, strm.recordNumber);
+   TUASSERTE(unsigned, 3, strm.lineNumber);
+      // and again, once at the end
+   TUASSERTE(FFStreamStatus, FFStreamStatus::EndOfFile,
+             ld.tryGetRecord(strm));
+
+      // without a record read yet, EOF comes from the reader
+   FFTextStream empty(emptyFile.c_str());
+   LineData::reads = 0;
+   TUASSERTE(FFStreamStatus, FFStreamStatus::EndOfFile,
+             ld.tryGetRecord(empty));
+   TUASSERTE(unsigned, 1, LineData::reads);
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+errorTest()
+{
+   TUDEF("FFData", "tryGetRecord");
+   FFTextStream strm(badFile.c_str());
+   LineData ld;
+   TUASSERTE(FFStreamStatus, FFStreamStatus::OK, ld.tryGetRecord(strm));
+   TUASSERTE(FFStreamStatus, FFStreamStatus::Error, ld.tryGetRecord(strm));
+   TUASSERT(strm.fail());
+   TUASSERT(!strm.eof());
+   TUASSERT(strm.mostRecentException.what().find("bad line: Xb") !=
+            std::string::npos);
+   TUASSERTE(unsigned, 1, strm.recordNumber);
+   TUASSERTE(unsigned, 1, strm.lineNumber);
+   strm.clear();
+   TUASSERTE(long, 3, (long)strm.tellg());
+
+      // errors aren't thrown even when exceptions are enabled
+   FFTextStream exstrm(badFile.c_str());
+   exstrm.exceptions(std::fstream::failbit);
+   TUASSERTE(FFStreamStatus, FFStreamStatus::OK, ld.tryGetRecord(exstrm));
+   TUCATCH(TUASSERTE(FFStreamStatus, FFStreamStatus::Error,
+                     ld.tryGetRecord(exstrm)));
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+exceptionTest()
+{
+   TUDEF("FFData", "getRecord");
+   LineData ld;
+   unsigned count = 0;
+   {
+         // reading to the end never throws
+      FFTextStream strm(goodFile.c_str());
+      strm.exceptions(std::fstream::failbit);
+      try
+      {
+         while (strm >> ld)
+            count++;
+         TUPASS("no exception at EOF");
+      }
+      catch (...)
+      {
+         TUFAIL("unexpected exception at EOF");
+      }
+      TUASSERTE(unsigned, 3, count);
+   }
+   {
+      FFTextStream strm(badFile.c_str());
+      strm.exceptions(std::fstream::failbit);
+      strm >> ld;
+      TUTHROW(strm >> ld);
+      TUASSERTE(unsigned, 1, strm.lineNumber);
+   }
+   {
+         // errors set the state silently when exceptions are disabled
+      FFTextStream strm(badFile.c_str());
+      count = 0;
+      while (strm >> ld)
+         count++;
+      TUASSERTE(unsigned, 1, count);
+      TUASSERT(!strm.eof());
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   FFTextStream_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.statusTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.exceptionTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,177 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "RinexDatum.hpp"
+#include "StringUtils.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class RinexDatum_T
+{
+public:
+   RinexDatum_T();
+      /// Make sure appendTo and asString match the original formatting.
+   unsigned formatTest();
+      /// Compare the throughput of the original and current formatting.
+   unsigned throughputTest();
+
+private:
+      /// The formatting used by RinexDatum::asString prior to appendTo.
+   static string legacyAsString(const RinexDatum& rd);
+
+   vector<RinexDatum> data;
+};
+
+
+RinexDatum_T ::
+RinexDatum_T()
+{
+      // Observation-like values from millimetres to GLONASS
+      // pseudoranges, with and without LLI/SSI and blanks.
+   unsigned long long seed = 20240131;
+   for (unsigned i = 0; i < 200000; i++)
+   {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      RinexDatum rd;
+      rd.data = ((double)(seed >> 11) / 9007199254740992.0 - 0.3) *
+         (i % 2 ? 4.0e7 : 2.0e3);
+      rd.dataBlank = (i % 97) == 0;
+      rd.lli = (seed >> 3) % 8;
+      rd.lliBlank = (rd.lli == 0) && (i % 3 != 0);
+      rd.ssi = (seed >> 7) % 10;
+      rd.ssiBlank = (rd.ssi == 0) && (i % 5 != 0);
+      data.push_back(rd);
+   }
+}
+
+
+string RinexDatum_T ::
+legacyAsString(const RinexDatum& rd)
+{
+   using StringUtils::rightJustify;
+   string rv;
+   if (!rd.dataBlank)
+      rv += rightJustify(StringUtils::asString(rd.data, 3), 14);
+   else
+      rv += string(14, ' ');
+   if ((rd.lli != 0) || !rd.lliBlank)
+      rv += rightJustify(StringUtils::asString<short>(rd.lli),1);
+   else
+      rv += " ";
+   if ((rd.ssi != 0) || !rd.ssiBlank)
+      rv += rightJustify(StringUtils::asString<short>(rd.ssi),1);
+   else
+      rv += " ";
+   return rv;
+}
+
+
+unsigned RinexDatum_T ::
+formatTest()
+{
+   TUDEF("RinexDatum", "appendTo");
+   string got;
+   bool allMatch = true;
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      string exp = legacyAsString(data[i]);
+      got.clear();
+      data[i].appendTo(got);
+      if ((got != exp) || (data[i].asString() != exp))
+      {
+         TUASSERTE(string, exp, got);
+         allMatch = false;
+      }
+   }
+   TUASSERT(allMatch);
+      // appendTo adds to rather than replacing the string contents
+   RinexDatum rd(string("  20422685.123 7"));
+   got = "G01";
+   rd.appendTo(got);
+   TUASSERTE(string, "G01  20422685.123 7", got);
+   TURETURN();
+}
+
+
+unsigned RinexDatum_T ::
+throughputTest()
+{
+   TUDEF("RinexDatum", "asString");
+   typedef std::chrono::steady_clock Clock;
+   string legacyBuf, fastBuf;
+   legacyBuf.reserve(data.size() * 16);
+   fastBuf.reserve(data.size() * 16);
+
+   Clock::time_point t0 = Clock::now();
+   for (unsigned i = 0; i < data.size(); i++)
+      legacyBuf += legacyAsString(data[i]);
+   Clock::time_point t1 = Clock::now();
+   for (unsigned i = 0; i < data.size(); i++)
+      data[i].appendTo(fastBuf);
+   Clock::time_point t2 = Clock::now();
+
+   double legacySec = std::chrono::duration<double>(t1-t0).count();
+   double fastSec = std::chrono::duration<double>(t2-t1).count();
+   cout << "RinexDatum formatting of " << data.size() << " values:"
+        << " legacy " << legacySec << " s, appendTo " << fastSec << " s";
+   if (fastSec > 0)
+      cout << " (" << legacySec / fastSec << "x)";
+   cout << endl;
+      // the buffers must be byte-identical; timing is informational
+   TUASSERT(legacyBuf == fastBuf);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   RinexDatum_T testClass;
+
+   errorTotal += testClass.formatTest();
+   errorTotal += testClass.throughputTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
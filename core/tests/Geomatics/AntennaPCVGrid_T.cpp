@@ -0,0 +1,236 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file AntennaPCVGrid_T.cpp Test class AntennaPCVGrid and the PCV handles
+/// of AntennaStore against AntexData.
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AntennaPCVGrid.hpp"
+#include "AntennaStore.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class AntennaPCVGrid_T
+{
+public:
+   AntennaPCVGrid_T();
+      /// Compare grid lookups with AntexData::getPhaseCenterVariation().
+   unsigned lookupTest();
+      /// Check the handles of AntennaStore.
+   unsigned storeTest();
+
+private:
+      /** Make a valid antenna with a smooth PCV pattern.
+       * @param rx true for a receiver antenna
+       * @param dazi azimuth spacing, 0 for no azimuth dependence
+       * @param zmax largest zenith (nadir) angle
+       * @param dzen zenith angle spacing
+       * @param scale multiplies the PCVs */
+   AntexData makeAntenna(bool rx, double dazi, double zmax, double dzen,
+                         double scale = 1.0);
+   TestRandom rng;
+};
+
+
+AntennaPCVGrid_T ::
+AntennaPCVGrid_T()
+      : rng(11235)
+{
+}
+
+
+AntexData AntennaPCVGrid_T ::
+makeAntenna(bool rx, double dazi, double zmax, double dzen, double scale)
+{
+   AntexData ant;
+   ant.valid = AntexData::allValid13;
+   ant.isRxAntenna = rx;
+   ant.type = (rx ? "TESTANT         NONE" : "BLOCK TEST");
+   ant.serialNo = (rx ? "" : "G99");
+   ant.azimDelta = dazi;
+   ant.zenRange[0] = 0.0;
+   ant.zenRange[1] = zmax;
+   ant.zenRange[2] = dzen;
+   const char *freqs[] = {"G01", "G02"};
+   ant.nFreq = 2;
+   for (unsigned f = 0; f < 2; f++)
+   {
+      AntexData::antennaPCOandPCVData& pd = ant.freqPCVmap[freqs[f]];
+      pd.PCOvalue[0] = 1.5 + f;
+      pd.PCOvalue[1] = -0.7;
+      pd.PCOvalue[2] = 60.0 + 3 * f;
+      pd.hasAzimuth = (dazi > 0.0);
+      for (double z = 0.0; z <= zmax + 1.e-9; z += dzen)
+         pd.PCVvalue[-1.0][z] = ::floor(100 * scale * ::sin(z / 20.0)) / 100;
+      for (double a = 0.0; dazi > 0.0 && a <= 360.0 + 1.e-9; a += dazi)
+      {
+         for (double z = 0.0; z <= zmax + 1.e-9; z += dzen)
+         {
+            double v = scale * (::sin(z / 20.0) + 0.3 * ::cos(a / 57.3) *
+                                z / zmax + f);
+            pd.PCVvalue[a][z] = ::floor(100 * v) / 100;
+         }
+      }
+   }
+   return ant;
+}
+
+
+unsigned AntennaPCVGrid_T ::
+lookupTest()
+{
+   TUDEF("AntennaPCVGrid", "getPhaseCenterVariation");
+   const double eps = 1e-4;    // float storage of values ~ 10 mm
+   vector<AntexData> ants;
+   ants.push_back(makeAntenna(true, 5.0, 90.0, 5.0, 10.0));
+   ants.push_back(makeAntenna(true, 0.0, 80.0, 5.0, 10.0));
+   ants.push_back(makeAntenna(false, 0.0, 14.0, 1.0, 5.0));
+   ants.push_back(makeAntenna(false, 30.0, 17.0, 1.0, 5.0));
+   for (unsigned k = 0; k < ants.size(); k++)
+   {
+      AntennaPCVGrid grid(ants[k], "G02");
+      TUASSERT(grid.isValid());
+      TUASSERTE(string, "G02", grid.getFrequency());
+      TUASSERTE(Triple, ants[k].getPhaseCenterOffset("G02"),
+                grid.getPhaseCenterOffset());
+      vector<double> az, el, pcv;
+         // grid nodes, edges and random points, with azimuths to be wrapped
+      az.push_back(0.0);   el.push_back(0.0);
+      az.push_back(360.0); el.push_back(90.0);
+      az.push_back(-5.0);  el.push_back(45.0);
+      az.push_back(725.5); el.push_back(12.3);
+      az.push_back(355.0); el.push_back(5.0);
+      for (unsigned i = 0; i < 200; i++)
+      {
+         az.push_back(400.0 * rng.random());
+         el.push_back(45.0 + 45.0 * rng.random());
+      }
+      pcv.resize(az.size());
+      grid.getPhaseCenterVariations(&az[0], &el[0], &pcv[0], az.size());
+      for (unsigned i = 0; i < az.size(); i++)
+      {
+         double exp = ants[k].getPhaseCenterVariation("G02", az[i], el[i]);
+         TUASSERTFEPS(exp, grid.getPhaseCenterVariation(az[i], el[i]), eps);
+         TUASSERTFEPS(exp, pcv[i], eps);
+         TUASSERTFEPS(ants[k].getTotalPhaseCenterOffset("G02", az[i], el[i]),
+                      grid.getTotalPhaseCenterOffset(az[i], el[i]), eps);
+      }
+      TUTHROW(grid.getPhaseCenterVariation(0.0, 91.0));
+   }
+
+   TUCSM("AntennaPCVGrid");
+   TUTHROW(AntennaPCVGrid(ants[0], "E05"));
+   TUTHROW(AntennaPCVGrid(AntexData(), "G01"));
+   AntennaPCVGrid empty;
+   TUASSERT(!empty.isValid());
+   TUTHROW(empty.getPhaseCenterVariation(0.0, 10.0));
+      // irregular zenith angles
+   AntexData bad(ants[1]);
+   bad.freqPCVmap["G01"].PCVvalue[-1.0][82.5] = 1.0;
+   TUTHROW(AntennaPCVGrid(bad, "G01"));
+   TURETURN();
+}
+
+
+unsigned AntennaPCVGrid_T ::
+storeTest()
+{
+   TUDEF("AntennaStore", "getPCVHandle");
+   AntennaStore store;
+   AntexData rx(makeAntenna(true, 5.0, 90.0, 5.0));
+   AntexData rx2(makeAntenna(true, 10.0, 90.0, 5.0, 2.0));
+   store.addAntenna("RX", rx);
+   int h1 = store.getPCVHandle("RX", "G01");
+   int h2 = store.getPCVHandle("RX", "G02");
+   TUASSERT(h1 != h2);
+   TUASSERTE(int, h1, store.getPCVHandle("RX", "G01"));
+   TUASSERTFEPS(rx.getPhaseCenterVariation("G01", 33.0, 21.0),
+                store.getPCVGrid(h1).getPhaseCenterVariation(33.0, 21.0),
+                1e-4);
+   TUTHROW(store.getPCVHandle("NONE", "G01"));
+   TUTHROW(store.getPCVHandle("RX", "E05"));
+   TUTHROW(store.getPCVGrid(-1));
+   TUTHROW(store.getPCVGrid(5));
+
+      // grids stay put as more are compiled
+   const AntennaPCVGrid& grid1 = store.getPCVGrid(h1);
+   for (int i = 0; i < 40; i++)
+   {
+      ostringstream oss;
+      oss << "RX" << i;
+      store.addAntenna(oss.str(), rx2);
+      store.getPCVHandle(oss.str(), "G01");
+      store.getPCVHandle(oss.str(), "G02");
+   }
+   TUASSERT(&grid1 == &store.getPCVGrid(h1));
+   TUASSERTFEPS(rx.getPhaseCenterVariation("G01", 33.0, 21.0),
+                grid1.getPhaseCenterVariation(33.0, 21.0), 1e-4);
+
+      // replacing the antenna recompiles its grids under the same handle
+   store.addAntenna("RX", rx2);
+   TUASSERTE(int, h1, store.getPCVHandle("RX", "G01"));
+   TUASSERTFEPS(rx2.getPhaseCenterVariation("G01", 33.0, 21.0),
+                store.getPCVGrid(h1).getPhaseCenterVariation(33.0, 21.0),
+                1e-4);
+   TUASSERTFEPS(rx2.getPhaseCenterVariation("G01", 33.0, 21.0),
+                grid1.getPhaseCenterVariation(33.0, 21.0), 1e-4);
+   store.clear();
+   TUTHROW(store.getPCVGrid(h1));
+   TURETURN();
+}
+
+
+int main()
+{
+   AntennaPCVGrid_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.lookupTest();
+   errorTotal += testClass.storeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,334 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file BatchKalmanFilter_T.cpp Test class BatchKalmanFilter against the
+/// textbook single filter equations.
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "BatchKalmanFilter.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class BatchKalmanFilter_T
+{
+public:
+   BatchKalmanFilter_T();
+      /// Compare time and measurement updates with the dense equations.
+   unsigned updateTest();
+      /// Check that threaded updates give the serial results.
+   unsigned threadTest();
+      /// Check the errors on bad dimensions.
+   unsigned errorTest();
+
+private:
+      /// Fill a random state and positive definite covariance.
+   void randomState(Vector<double>& X, Matrix<double>& P);
+      /// Dense time update.
+   static void denseTU(Vector<double>& X, Matrix<double>& P,
+                       const Matrix<double>& Phi, const Matrix<double>& Q);
+      /// Dense scalar measurement update.
+   static void denseMU(Vector<double>& X, Matrix<double>& P,
+                       const Vector<double>& h, double z, double r);
+      /// Return the largest absolute difference between filter k and X,P.
+   static double maxDiff(const BatchKalmanFilter& bkf, unsigned k,
+                         const Vector<double>& X, const Matrix<double>& P);
+   TestRandom rng;
+};
+
+
+BatchKalmanFilter_T ::
+BatchKalmanFilter_T()
+      : rng(24680)
+{
+}
+
+
+void BatchKalmanFilter_T ::
+randomState(Vector<double>& X, Matrix<double>& P)
+{
+   const unsigned n = X.size();
+   Matrix<double> A(n, n);
+   for (unsigned i = 0; i < n; i++)
+   {
+      X(i) = rng.random();
+      for (unsigned j = 0; j < n; j++)
+         A(i,j) = rng.random();
+   }
+   P = A * transpose(A);
+   for (unsigned i = 0; i < n; i++)
+      P(i,i) += 1.0;
+}
+
+
+void BatchKalmanFilter_T ::
+denseTU(Vector<double>& X, Matrix<double>& P, const Matrix<double>& Phi,
+        const Matrix<double>& Q)
+{
+   X = Phi * X;
+   P = Phi * P * transpose(Phi) + Q;
+}
+
+
+void BatchKalmanFilter_T ::
+denseMU(Vector<double>& X, Matrix<double>& P, const Vector<double>& h,
+        double z, double r)
+{
+   Vector<double> PH(P * h);
+   const double s = dot(h, PH) + r;
+   X += PH * ((z - dot(h, X)) / s);
+   P -= outer(PH, PH) / s;
+}
+
+
+double BatchKalmanFilter_T ::
+maxDiff(const BatchKalmanFilter& bkf, unsigned k, const Vector<double>& X,
+        const Matrix<double>& P)
+{
+   double rv = 0;
+   for (unsigned i = 0; i < X.size(); i++)
+   {
+      rv = std::max(rv, std::abs(bkf.state(i,k) - X(i)));
+      for (unsigned j = 0; j < X.size(); j++)
+         rv = std::max(rv, std::abs(bkf.covariance(i,j,k) - P(i,j)));
+   }
+   return rv;
+}
+
+
+unsigned BatchKalmanFilter_T ::
+updateTest()
+{
+   TUDEF("BatchKalmanFilter", "timeUpdate");
+   const unsigned n = 4, K = 7;
+   const double eps = 1e-12;
+   BatchKalmanFilter bkf(n, K);
+   TUASSERTE(unsigned, n, bkf.dimension());
+   TUASSERTE(unsigned, K, bkf.size());
+   vector<Vector<double> > X(K, Vector<double>(n));
+   vector<Matrix<double> > P(K, Matrix<double>(n, n));
+   for (unsigned k = 0; k < K; k++)
+   {
+      randomState(X[k], P[k]);
+      bkf.setState(k, X[k], P[k]);
+   }
+
+      // constant velocity model, with a zero in Phi
+   Matrix<double> Phi(n, n, 0.0), Q(n, n, 0.0);
+   for (unsigned i = 0; i < n; i++)
+   {
+      Phi(i,i) = 1.0;
+      Q(i,i) = 0.01 * (i + 1);
+   }
+   Phi(0,2) = Phi(1,3) = 0.5;
+   Q(0,2) = Q(2,0) = 0.001;
+   bkf.timeUpdate(Phi, Q);
+   for (unsigned k = 0; k < K; k++)
+   {
+      denseTU(X[k], P[k], Phi, Q);
+      TUASSERTFEPS(0.0, maxDiff(bkf, k, X[k], P[k]), eps);
+   }
+
+      // process noise scaled per filter
+   vector<double> qscale(K);
+   for (unsigned k = 0; k < K; k++)
+      qscale[k] = 1.0 + k;
+   bkf.timeUpdate(Phi, Q, qscale);
+   for (unsigned k = 0; k < K; k++)
+   {
+      denseTU(X[k], P[k], Phi, Q * qscale[k]);
+      TUASSERTFEPS(0.0, maxDiff(bkf, k, X[k], P[k]), eps);
+   }
+
+   TUCSM("measurementUpdate");
+      // common partials; filter 2 has no data and filter 4 has bad variance
+   Vector<double> h(n);
+   for (unsigned i = 0; i < n; i++)
+      h(i) = rng.random();
+   vector<double> z(K), r(K, 0.25);
+   for (unsigned k = 0; k < K; k++)
+      z[k] = rng.random();
+   z[2] = numeric_limits<double>::quiet_NaN();
+   r[4] = 0.0;
+   bkf.measurementUpdate(h, z, r);
+   for (unsigned k = 0; k < K; k++)
+   {
+      if (k != 2 && k != 4)
+      {
+         const double v = z[k] - dot(h, X[k]);
+         TUASSERTFEPS(v, bkf.innovations()[k], eps);
+         denseMU(X[k], P[k], h, z[k], r[k]);
+      }
+      else
+      {
+         TUASSERTE(double, 0.0, bkf.innovations()[k]);
+      }
+      TUASSERTFEPS(0.0, maxDiff(bkf, k, X[k], P[k]), eps);
+   }
+
+      // partials per filter
+   vector<double> H(n * K);
+   for (unsigned i = 0; i < n * K; i++)
+      H[i] = rng.random();
+   r.assign(K, 0.5);
+   for (unsigned k = 0; k < K; k++)
+      z[k] = rng.random();
+   bkf.measurementUpdate(H, z, r);
+   for (unsigned k = 0; k < K; k++)
+   {
+      Vector<double> hk(n);
+      for (unsigned i = 0; i < n; i++)
+         hk(i) = H[i * K + k];
+      denseMU(X[k], P[k], hk, z[k], r[k]);
+      TUASSERTFEPS(0.0, maxDiff(bkf, k, X[k], P[k]), eps);
+   }
+
+      // m measurements, processed one at a time
+   const unsigned m = 3;
+   Matrix<double> Hm(m, n), Zm(m, K), Rm(m, K);
+   for (unsigned l = 0; l < m; l++)
+   {
+      for (unsigned i = 0; i < n; i++)
+         Hm(l,i) = rng.random();
+      for (unsigned k = 0; k < K; k++)
+      {
+         Zm(l,k) = rng.random();
+         Rm(l,k) = 0.3 + 0.1 * l;
+      }
+   }
+   bkf.measurementUpdate(Hm, Zm, Rm);
+   for (unsigned k = 0; k < K; k++)
+   {
+      for (unsigned l = 0; l < m; l++)
+         denseMU(X[k], P[k], Hm.rowCopy(l), Zm(l,k), Rm(l,k));
+      TUASSERTFEPS(0.0, maxDiff(bkf, k, X[k], P[k]), eps);
+      TUASSERTFEPS(0.0, maxDiff(bkf, k, bkf.getState(k),
+                                bkf.getCovariance(k)), 0.0);
+   }
+   TURETURN();
+}
+
+
+unsigned BatchKalmanFilter_T ::
+threadTest()
+{
+   TUDEF("BatchKalmanFilter", "numThreads");
+   const unsigned n = 3, K = 1001;
+   BatchKalmanFilter serial(n, K), threaded(n, K);
+   serial.numThreads = 1;
+   threaded.numThreads = 4;
+   threaded.minFiltersPerThread = 1;
+   Vector<double> X(n);
+   Matrix<double> P(n, n);
+   for (unsigned k = 0; k < K; k++)
+   {
+      randomState(X, P);
+      serial.setState(k, X, P);
+      threaded.setState(k, X, P);
+   }
+   Matrix<double> Phi(n, n), Q(n, n, 0.0);
+   for (unsigned i = 0; i < n; i++)
+   {
+      Q(i,i) = 0.1;
+      for (unsigned j = 0; j < n; j++)
+         Phi(i,j) = (i == j ? 1.0 : 0.1 * rng.random());
+   }
+   Vector<double> h(n);
+   vector<double> z(K), r(K, 1.0);
+   for (unsigned t = 0; t < 5; t++)
+   {
+      serial.timeUpdate(Phi, Q);
+      threaded.timeUpdate(Phi, Q);
+      for (unsigned i = 0; i < n; i++)
+         h(i) = rng.random();
+      for (unsigned k = 0; k < K; k++)
+         z[k] = rng.random();
+      serial.measurementUpdate(h, z, r);
+      threaded.measurementUpdate(h, z, r);
+   }
+   TUASSERT(serial.stateData() == threaded.stateData());
+   TUASSERT(serial.covarianceData() == threaded.covarianceData());
+   TUASSERT(serial.innovations() == threaded.innovations());
+   TURETURN();
+}
+
+
+unsigned BatchKalmanFilter_T ::
+errorTest()
+{
+   TUDEF("BatchKalmanFilter", "BatchKalmanFilter");
+   TUTHROW(BatchKalmanFilter(0, 5));
+   TUTHROW(BatchKalmanFilter(3, 0));
+   BatchKalmanFilter bkf(3, 5);
+   TUCSM("setState");
+   TUTHROW(bkf.setState(5, Vector<double>(3), Matrix<double>(3, 3)));
+   TUTHROW(bkf.setState(0, Vector<double>(2), Matrix<double>(3, 3)));
+   TUTHROW(bkf.setAllStates(Vector<double>(3), Matrix<double>(3, 2)));
+   TUCSM("timeUpdate");
+   TUTHROW(bkf.timeUpdate(Matrix<double>(3, 2), Matrix<double>(3, 3)));
+   TUTHROW(bkf.timeUpdate(Matrix<double>(3, 3), Matrix<double>(3, 3),
+                          vector<double>(4)));
+   TUCSM("measurementUpdate");
+   TUTHROW(bkf.measurementUpdate(Vector<double>(2), vector<double>(5),
+                                 vector<double>(5)));
+   TUTHROW(bkf.measurementUpdate(vector<double>(14), vector<double>(5),
+                                 vector<double>(5)));
+   TUTHROW(bkf.measurementUpdate(Matrix<double>(2, 3), Matrix<double>(2, 5),
+                                 Matrix<double>(1, 5)));
+   TURETURN();
+}
+
+
+int main()
+{
+   BatchKalmanFilter_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.updateTest();
+   errorTotal += testClass.threadTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
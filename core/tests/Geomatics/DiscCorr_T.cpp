@@ -0,0 +1,273 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file DiscCorr_T.cpp Test the multi-pass DiscontinuityCorrector(), which
+/// corrects passes concurrently, against the single-pass version called on
+/// each pass in turn, using simulated GPS and GLONASS passes with slips.
+
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "CivilTime.hpp"
+#include "DiscCorr.hpp"
+#include "GNSSconstants.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class DiscCorr_T
+{
+public:
+   DiscCorr_T();
+      /** Correct the same passes serially and concurrently, and compare
+       * return codes, messages, editing commands, debug output and the
+       * corrected data. */
+   unsigned concurrentTest();
+
+private:
+      /** Simulate a pass of n epochs, DT=30s, of satellite sat (GLONASS
+       * channel GLOn), with a slip of n1,n2 cycles at epoch islip and a
+       * gap of ngap epochs at epoch igap. */
+   SatPass simulate(const RinexSatID& sat, int GLOn, int n, int islip,
+                    long n1, long n2, int igap, int ngap);
+      /// All the test passes, and the GLONASS channel of each.
+   void makePasses(vector<SatPass>& passes, vector<int>& GLOn);
+      /// Set up config as the test needs; debug output goes to log.
+   void configure(GDCconfiguration& config, ostringstream& log);
+      /** Debug output without the lines that may differ: the run time, and
+       * the EditCmd dumps, which in serial runs repeat the commands of
+       * earlier passes. */
+   string stripLog(const string& log);
+
+   std::mt19937 gen;
+   Epoch t0;
+   vector<string> obstypes;
+};
+
+
+DiscCorr_T ::
+DiscCorr_T()
+      : t0(CivilTime(2020,1,1,0,0,0.0,TimeSystem::GPS))
+{
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back("P1");
+   obstypes.push_back("P2");
+}
+
+
+SatPass DiscCorr_T ::
+simulate(const RinexSatID& sat, int GLOn, int n, int islip, long n1, long n2,
+         int igap, int ngap)
+{
+   double wl1, wl2;
+   if (sat.system == SatelliteSystem::Glonass)
+   {
+      wl1 = C_MPS / (1602.0e6 + GLOn * 562.5e3);
+      wl2 = C_MPS / (1246.0e6 + GLOn * 437.5e3);
+   }
+   else
+   {
+      wl1 = C_MPS / (L1_MULT_GPS * OSC_FREQ_GPS);
+      wl2 = C_MPS / (L2_MULT_GPS * OSC_FREQ_GPS);
+   }
+   const double gamma = (wl2 * wl2) / (wl1 * wl1);
+   std::normal_distribution<double> noise(0.0, 1.0);
+
+   SatPass sp(sat, 30.0, obstypes);
+   vector<double> data(4);
+   vector<unsigned short> lli(4, 0), ssi(4, 9);
+   for (int i = 0; i < n; i++)
+   {
+      double ph1 = 0.003 * noise(gen), ph2 = 0.003 * noise(gen);
+      double pr1 = 0.3 * noise(gen), pr2 = 0.3 * noise(gen);
+      if (i >= igap && i < igap + ngap)
+         continue;
+         // range and L1 ionospheric delay (m)
+      const double rho = 2.2e7 - 600.0 * i + 0.3 * i * i;
+      const double ion = 4.0 + 0.002 * i + 1.0e-5 * i * i;
+      long s1 = (i >= islip ? n1 : 0), s2 = (i >= islip ? n2 : 0);
+      data[0] = (rho - ion) / wl1 + s1 + ph1;
+      data[1] = (rho - gamma * ion) / wl2 + s2 + ph2;
+      data[2] = rho + ion + pr1;
+      data[3] = rho + gamma * ion + pr2;
+      sp.addData(t0 + 30.0 * i, obstypes, data, lli, ssi);
+   }
+   return sp;
+}
+
+
+void DiscCorr_T ::
+makePasses(vector<SatPass>& passes, vector<int>& GLOn)
+{
+   gen.seed(20200101);
+   passes.clear();
+   GLOn.clear();
+      // GPS passes with slips, one with a gap
+   for (int id = 1; id <= 8; id++)
+   {
+      RinexSatID sat(id, SatelliteSystem::GPS);
+      passes.push_back(simulate(sat, 0, 300 + 20 * id, 50 + 25 * id,
+                                id % 3, (id % 3) + id % 2,
+                                (id == 5 ? 120 : 1000), 20));
+      GLOn.push_back(-99);
+   }
+      // GLONASS passes, each with its own channel and so wavelengths
+   int channels[3] = { -7, 1, 6 };
+   for (int k = 0; k < 3; k++)
+   {
+      RinexSatID sat(k + 1, SatelliteSystem::Glonass);
+      passes.push_back(simulate(sat, channels[k], 350, 100 + 40 * k, 2, 1,
+                                1000, 0));
+      GLOn.push_back(channels[k]);
+   }
+      // too short to correct
+   passes.push_back(simulate(RinexSatID(9, SatelliteSystem::GPS), 0, 5,
+                             1000, 0, 0, 1000, 0));
+   GLOn.push_back(-99);
+}
+
+
+void DiscCorr_T ::
+configure(GDCconfiguration& config, ostringstream& log)
+{
+   config.setDebugStream(log);
+   config.setParameter("DT=30");
+   config.setParameter("Debug=1");
+   config.setParameter("ResetUnique=1");
+}
+
+
+string DiscCorr_T ::
+stripLog(const string& log)
+{
+   istringstream iss(log);
+   string line, rv;
+   while (getline(iss, line))
+   {
+      if (line.find("GNSSTK Discontinuity Corrector Ver.") == 0 ||
+          line.find("EditCmd: ") == 0)
+         continue;
+      rv += line + "\n";
+   }
+   return rv;
+}
+
+
+unsigned DiscCorr_T ::
+concurrentTest()
+{
+   TUDEF("DiscCorr", "DiscontinuityCorrector");
+
+      // serial, one pass at a time
+   vector<SatPass> serial;
+   vector<int> GLOn;
+   makePasses(serial, GLOn);
+   GDCconfiguration config;
+   ostringstream serialLog;
+   configure(config, serialLog);
+   vector<string> serialCmds, serialMsgs;
+   vector<int> serialRet;
+   for (size_t k = 0; k < serial.size(); k++)
+   {
+      string msg;
+      serialRet.push_back(DiscontinuityCorrector(serial[k], config,
+                                                 serialCmds, msg, GLOn[k]));
+      serialMsgs.push_back(msg);
+   }
+
+      // the test must exercise corrections and failures
+   for (size_t k = 0; k + 1 < serialRet.size(); k++)
+   {
+      TUASSERTE(int, 0, serialRet[k]);
+   }
+   TUASSERTE(int, -4, serialRet.back());
+   TUASSERT(!serialCmds.empty());
+   TUASSERT(!stripLog(serialLog.str()).empty());
+
+   const int nthreads[3] = { 1, 4, 16 };
+   for (int nt : nthreads)
+   {
+      vector<SatPass> passes;
+      makePasses(passes, GLOn);
+      GDCconfiguration config;
+      ostringstream log;
+      configure(config, log);
+      vector<string> cmds, msgs;
+      vector<int> ret = DiscontinuityCorrector(passes, config, cmds, msgs,
+                                               nt, GLOn);
+      TUASSERT(ret == serialRet);
+      TUASSERT(msgs == serialMsgs);
+      TUASSERT(cmds == serialCmds);
+      TUASSERT(stripLog(serialLog.str()) == stripLog(log.str()));
+      TUASSERTE(size_t, serial.size(), passes.size());
+      for (size_t k = 0; k < serial.size() && k < passes.size(); k++)
+      {
+         TUASSERTE(unsigned, serial[k].size(), passes[k].size());
+         bool same = (serial[k].size() == passes[k].size());
+         for (unsigned i = 0; same && i < serial[k].size(); i++)
+         {
+            same = (serial[k].time(i) == passes[k].time(i) &&
+                    serial[k].getFlag(i) == passes[k].getFlag(i));
+            for (const string& ot : obstypes)
+            {
+               same = same && (serial[k].data(i, ot) == passes[k].data(i, ot)
+                               && serial[k].LLI(i, ot) == passes[k].LLI(i, ot));
+            }
+         }
+         TUASSERT(same);
+      }
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   DiscCorr_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.concurrentTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,237 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file EOPStore_T.cpp Test class EOPStore against direct interpolation
+/// with EarthOrientation::interpolateEOP().
+
+#include <cmath>
+#include <cstdio>
+#include "EOPStore.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class EOPStore_T
+{
+public:
+   EOPStore_T();
+   ~EOPStore_T();
+      /// Compare getEOP() with interpolateEOP() on the 4 surrounding entries.
+   unsigned interpolateTest(const IERSConvention& conv);
+      /// Compare the vector getEOP() with the scalar one.
+   unsigned batchTest();
+      /// Write and read back a binary file.
+   unsigned binaryTest();
+      /// Check the errors.
+   unsigned throwTest();
+
+private:
+      /// EOPs at mjd interpolated directly from the entries in eopMap.
+   EarthOrientation reference(double mjd, const IERSConvention& conv);
+
+   map<int, EarthOrientation> eopMap;
+   EOPStore eops;
+   string fileName;
+};
+
+
+EOPStore_T ::
+EOPStore_T()
+{
+   fileName = getPathTestTemp() + getFileSep() + "test_output_EOPStore.bin";
+      // smooth EOPs for September 2017, between leap seconds, with a gap
+   for (int mjd = 58000; mjd <= 58030; mjd++)
+   {
+      if (mjd == 58015)
+         continue;
+      double d = mjd - 58000;
+      EarthOrientation eo;
+      eo.xp = 0.12 + 0.08 * ::sin(2 * M_PI * d / 433.0);
+      eo.yp = 0.35 + 0.08 * ::cos(2 * M_PI * d / 433.0);
+      eo.UT1mUTC = 0.31 - 0.0012 * d + 0.0003 * ::sin(2 * M_PI * d / 13.66);
+      eopMap[mjd] = eo;
+      eops.addEOP(mjd, eo);
+   }
+}
+
+
+EOPStore_T ::
+~EOPStore_T()
+{
+   std::remove(fileName.c_str());
+}
+
+
+EarthOrientation EOPStore_T ::
+reference(double mjd, const IERSConvention& conv)
+{
+      // L . t . H, or L t . . H at the start, or L . . t H at the end
+   map<int, EarthOrientation>::iterator it = eopMap.find(int(mjd));
+   if (it == eopMap.begin())
+      ;
+   else if (++map<int, EarthOrientation>::iterator(it) == --eopMap.end())
+      advance(it, -2);
+   else
+      --it;
+
+   vector<double> vtime, vX, vY, vdT;
+   for (int i = 0; i < 4; i++, ++it)
+   {
+      vtime.push_back(double(it->first));
+      vX.push_back(it->second.xp);
+      vY.push_back(it->second.yp);
+      vdT.push_back(it->second.UT1mUTC);
+   }
+   EarthOrientation eo;
+   eo.interpolateEOP(EphTime(mjd, TimeSystem::UTC), vtime, vX, vY, vdT, conv);
+   return eo;
+}
+
+
+unsigned EOPStore_T ::
+interpolateTest(const IERSConvention& conv)
+{
+   TUDEF("EOPStore", "getEOP");
+      // both ends, either side of the gap, on and between the entries
+   const double mjds[] = { 58000.0, 58000.3, 58001.7, 58010.0, 58010.25,
+                           58014.6, 58016.0, 58016.9, 58028.5, 58029.99 };
+   for (size_t i = 0; i < sizeof(mjds) / sizeof(mjds[0]); i++)
+   {
+      EarthOrientation ref = reference(mjds[i], conv);
+      EarthOrientation eo = eops.getEOP(mjds[i], conv);
+      TUASSERTFEPS(ref.xp, eo.xp, 1.e-12);
+      TUASSERTFEPS(ref.yp, eo.yp, 1.e-12);
+      TUASSERTFEPS(ref.UT1mUTC, eo.UT1mUTC, 1.e-12);
+      TUASSERTE(IERSConvention, conv, eo.convention);
+   }
+   TURETURN();
+}
+
+
+unsigned EOPStore_T ::
+batchTest()
+{
+   TUDEF("EOPStore", "getEOP");
+   vector<double> mjds;
+   for (double mjd = 58003.0; mjd < 58012.0; mjd += 0.37)
+      mjds.push_back(mjd);
+   vector<EarthOrientation> batch;
+   eops.getEOP(mjds, IERSConvention::IERS2010, batch);
+   TUASSERTE(size_t, mjds.size(), batch.size());
+   for (size_t i = 0; i < mjds.size(); i++)
+   {
+      EarthOrientation eo = eops.getEOP(mjds[i], IERSConvention::IERS2010);
+      TUASSERTE(double, eo.xp, batch[i].xp);
+      TUASSERTE(double, eo.yp, batch[i].yp);
+      TUASSERTE(double, eo.UT1mUTC, batch[i].UT1mUTC);
+   }
+   TURETURN();
+}
+
+
+unsigned EOPStore_T ::
+binaryTest()
+{
+   TUDEF("EOPStore", "writeBinaryFile");
+   TUCATCH(eops.writeBinaryFile(fileName));
+
+   EOPStore copy;
+   TUCATCH(copy.addFile(fileName));
+   TUASSERTE(int, eops.size(), copy.size());
+   TUASSERTE(int, eops.getFirstTimeMJD(), copy.getFirstTimeMJD());
+   TUASSERTE(int, eops.getLastTimeMJD(), copy.getLastTimeMJD());
+   for (double mjd = 58000.5; mjd < 58030.0; mjd += 1.0)
+   {
+      if (int(mjd) == 58015)
+         continue;
+      EarthOrientation a = eops.getEOP(mjd, IERSConvention::IERS2003);
+      EarthOrientation b = copy.getEOP(mjd, IERSConvention::IERS2003);
+      TUASSERTE(double, a.xp, b.xp);
+      TUASSERTE(double, a.yp, b.yp);
+      TUASSERTE(double, a.UT1mUTC, b.UT1mUTC);
+   }
+
+      // editing the store updates the interpolation
+   copy.edit(58005, 58025);
+   TUASSERTE(int, 58005, copy.getFirstTimeMJD());
+   TUTHROW(copy.getEOP(58004.5, IERSConvention::IERS2010));
+   TUASSERTFEPS(reference(58012.5, IERSConvention::IERS2010).xp,
+                copy.getEOP(58012.5, IERSConvention::IERS2010).xp, 1.e-12);
+   TURETURN();
+}
+
+
+unsigned EOPStore_T ::
+throwTest()
+{
+   TUDEF("EOPStore", "getEOP");
+   TUTHROW(eops.getEOP(57999.5, IERSConvention::IERS2010));
+   TUTHROW(eops.getEOP(58015.5, IERSConvention::IERS2010));
+   TUTHROW(eops.getEOP(58030.0, IERSConvention::IERS2010));
+   vector<double> mjds(2, 58010.0);
+   mjds[1] = 58031.0;
+   vector<EarthOrientation> batch;
+   TUTHROW(eops.getEOP(mjds, IERSConvention::IERS2010, batch));
+
+   EOPStore small;
+   for (int mjd = 58000; mjd < 58003; mjd++)
+      small.addEOP(mjd, eopMap[mjd]);
+   TUTHROW(small.getEOP(58001.5, IERSConvention::IERS2010));
+
+   TUTHROW(small.addBinaryFile(getPathTestTemp() + getFileSep() +
+                               "no_such_file.bin"));
+   TURETURN();
+}
+
+
+int main()
+{
+   EOPStore_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.interpolateTest(IERSConvention::IERS2010);
+   errorTotal += testClass.interpolateTest(IERSConvention::IERS2003);
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.binaryTest();
+   errorTotal += testClass.throwTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,185 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+/// @file EarthRotationTable_T.cpp Test class EarthRotationTable against the
+/// full computation in EarthOrientation.
+
+#include <cmath>
+#include "EarthRotationTable.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class EarthRotationTable_T
+{
+public:
+   EarthRotationTable_T();
+      /** Compare interpolated rotations with
+       * EarthOrientation::ECEFtoInertial(). */
+   unsigned rotationTest(const IERSConvention& conv, double stepDays,
+                         double tol);
+      /// Check the EOPs, the cached rotation and the errors.
+   unsigned accessTest();
+
+private:
+
+   TestRandom rng;
+   EOPStore eops;
+};
+
+
+EarthRotationTable_T ::
+EarthRotationTable_T()
+      : rng(27182)
+{
+      // smooth EOPs for September 2017, between leap seconds
+   for (int mjd = 58000; mjd <= 58030; mjd++)
+   {
+      double d = mjd - 58000;
+      EarthOrientation eo;
+      eo.xp = 0.12 + 0.08 * ::sin(2 * M_PI * d / 433.0);
+      eo.yp = 0.35 + 0.08 * ::cos(2 * M_PI * d / 433.0);
+      eo.UT1mUTC = 0.31 - 0.0012 * d;
+      eops.addEOP(mjd, eo);
+   }
+}
+
+
+unsigned EarthRotationTable_T ::
+rotationTest(const IERSConvention& conv, double stepDays, double tol)
+{
+   TUDEF("EarthRotationTable", "ECEFtoInertial");
+   EarthRotationTable table;
+   EphTime beg(58010.0, TimeSystem::UTC), end(58012.0, TimeSystem::UTC);
+   table.initialize(eops, conv, beg, end, stepDays);
+   TUASSERT(table.isValid());
+
+   double worst = 0.0;
+   for (int k = 0; k < 40; k++)
+   {
+         // random times, including the ends of the span, in UTC and TT
+      double mjd = 58011.0 + rng.random();
+      if (k == 0)
+         mjd = 58010.0;
+      if (k == 1)
+         mjd = 58012.0;
+      EphTime t(mjd, TimeSystem::UTC);
+      if (k % 2)
+         t.convertSystemTo(TimeSystem::TT);
+
+      EphTime utc(t);
+      utc.convertSystemTo(TimeSystem::UTC);
+      EarthOrientation eo = eops.getEOP(utc.dMJD(), conv);
+      Matrix<double> full = eo.ECEFtoInertial(t);
+      worst = std::max(worst, maxDiff(full, table.ECEFtoInertial(t)));
+   }
+   TUASSERTFEPS(0.0, worst, tol);
+   TURETURN();
+}
+
+
+unsigned EarthRotationTable_T ::
+accessTest()
+{
+   TUDEF("EarthRotationTable", "getEOP");
+   EarthRotationTable table;
+   EphTime beg(58010.0, TimeSystem::UTC), end(58011.0, TimeSystem::UTC);
+   EphTime t(58010.3, TimeSystem::UTC);
+
+   TUTHROW(table.rotation(t));
+   TUTHROW(table.initialize(eops, IERSConvention::IERS1996, beg, end));
+   TUTHROW(table.initialize(eops, IERSConvention::IERS2010, beg, end, 0.0));
+   TUTHROW(table.initialize(eops, IERSConvention::IERS2010, end, beg));
+   TUASSERT(!table.isValid());
+
+   table.initialize(eops, IERSConvention::IERS2010, beg, end);
+   TUASSERTE(size_t, 28, table.size());
+   TUASSERTE(IERSConvention, IERSConvention::IERS2010,
+             table.getConvention());
+
+      // the EOPs interpolate those of EOPStore, including across the grid
+   for (int k = 0; k < 20; k++)
+   {
+      EphTime tk(58010.5 + 0.5 * rng.random(), TimeSystem::UTC);
+      EarthOrientation a = table.getEOP(tk);
+      EarthOrientation b = eops.getEOP(tk.dMJD(), IERSConvention::IERS2010);
+      TUASSERTFEPS(b.xp, a.xp, 1.e-6);
+      TUASSERTFEPS(b.yp, a.yp, 1.e-6);
+      TUASSERTFEPS(b.UT1mUTC, a.UT1mUTC, 1.e-7);
+   }
+
+      // the same epoch returns the cached rotation
+   const SMatrix<double, 3, 3>& r1 = table.rotation(t);
+   Matrix<double> m1(r1);
+   EphTime ttt(t);
+   ttt.convertSystemTo(TimeSystem::TT);
+   const SMatrix<double, 3, 3>& r2 = table.rotation(ttt);
+   TUASSERT(&r1 == &r2);
+   TUASSERTFEPS(0.0, maxDiff(m1, Matrix<double>(r2)), 1.e-15);
+   table.rotation(EphTime(58010.4, TimeSystem::UTC));
+   TUASSERT(maxDiff(m1, Matrix<double>(table.rotation(t))) < 1.e-15);
+   TUASSERT(maxDiff(m1, table.ECEFtoInertial(EphTime(58010.4))) > 1.e-3);
+
+      // outside the table
+   TUTHROW(table.rotation(EphTime(58009.9, TimeSystem::UTC)));
+   TUTHROW(table.getEOP(EphTime(58011.1, TimeSystem::UTC)));
+   TURETURN();
+}
+
+
+int main()
+{
+   EarthRotationTable_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.rotationTest(IERSConvention::IERS2010, 1. / 24,
+                                        1.e-11);
+   errorTotal += testClass.rotationTest(IERSConvention::IERS2003, 1. / 24,
+                                        1.e-11);
+   errorTotal += testClass.rotationTest(IERSConvention::IERS2010, 0.25,
+                                        2.e-9);
+   errorTotal += testClass.accessTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,253 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file GDCStreamDetector_T.cpp Test the streaming cycle slip detector on
+/// simulated dual-frequency GPS data with known slips.
+
+#include <cmath>
+#include <vector>
+#include "CivilTime.hpp"
+#include "FreqConsts.hpp"
+#include "GDCStreamDetector.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class GDCStreamDetector_T
+{
+public:
+   GDCStreamDetector_T();
+      /// Check latency, flags and slip estimates on a pass with slips, an
+      /// outlier, a bad epoch and a gap.
+   unsigned streamTest();
+      /// Check obvious slips and obvious outliers.
+   unsigned obviousTest();
+      /// Check the exceptions.
+   unsigned throwTest();
+
+private:
+      /** Simulated data for epoch i, DT=30s, with slips n1,n2 (cycles);
+       * 0.1m pseudorange and 0.003 cycle phase noise. */
+   void simulate(int i, long n1, long n2, double& L1, double& L2,
+                 double& P1, double& P2);
+   TestRandom rng;
+   Epoch t0;
+};
+
+
+GDCStreamDetector_T ::
+GDCStreamDetector_T()
+      : rng(24680), t0(CivilTime(2020,1,1,0,0,0.0,TimeSystem::GPS))
+{
+}
+
+
+void GDCStreamDetector_T ::
+simulate(int i, long n1, long n2, double& L1, double& L2, double& P1,
+         double& P2)
+{
+   static const double wl1 = getWavelength(SatelliteSystem::GPS, 1);
+   static const double wl2 = getWavelength(SatelliteSystem::GPS, 2);
+   static const double gamma = (wl2 * wl2) / (wl1 * wl1);
+      // range and L1 ionospheric delay (m)
+   const double rho = 2.2e7 - 600.0 * i + 0.3 * i * i;
+   const double ion = 4.0 + 0.002 * i + 1.0e-5 * i * i;
+   L1 = (rho - ion) / wl1 + n1 + 0.003 * rng.gaussian();
+   L2 = (rho - gamma * ion) / wl2 + n2 + 0.003 * rng.gaussian();
+   P1 = rho + ion + 0.1 * rng.gaussian();
+   P2 = rho + gamma * ion + 0.1 * rng.gaussian();
+}
+
+
+unsigned GDCStreamDetector_T ::
+streamTest()
+{
+   TUDEF("GDCStreamDetector", "add");
+   GDCconfiguration config;
+   config.setParameter("DT=30");
+   GDCStreamDetector det(config);
+   const unsigned lat = det.latency();
+   TUASSERT(lat > 10 && lat < det.capacity());
+
+   vector<GDCStreamDetector::Result> out;
+   vector<Epoch> times;
+   long n1 = 0, n2 = 0;
+   double L1, L2, P1, P2;
+   for (int i = 0; i < 400; i++)
+   {
+         // slips at 100 (WL 1 cycle) and 200 (WL 3 cycles); a 10 minute gap
+         // before 300; L1 outlier at 320; no data at 50
+      if (i == 100)
+      {
+         n1 += 3;
+         n2 += 2;
+      }
+      if (i == 200)
+      {
+         n1 += 10;
+         n2 += 7;
+      }
+      simulate(i, n1, n2, L1, L2, P1, P2);
+      if (i == 320)
+      {
+         L1 += 2.0;
+      }
+      Epoch t(t0 + 30.0 * i + (i >= 300 ? 600.0 : 0.0));
+      times.push_back(t);
+
+      const size_t nout = out.size();
+      const int n = det.add(t, L1, L2, P1, P2, i != 50, out);
+      TUASSERTE(size_t, nout + n, out.size());
+         // after the gap, the pending epochs come out at once
+      if (i == 300)
+      {
+         TUASSERTE(int, lat, n);
+      }
+      else
+      {
+         TUASSERTE(int, (i % 300 < int(lat) ? 0 : 1), n);
+      }
+      TUASSERTE(unsigned, min(unsigned(i % 300 + 1), lat), det.pending());
+   }
+   TUCSM("flush");
+   TUASSERTE(int, lat, det.flush(out));
+   TUASSERTE(unsigned, 0, det.pending());
+
+   TUCSM("Result");
+   TUASSERTE(size_t, times.size(), out.size());
+   for (size_t i = 0; i < out.size(); i++)
+   {
+      TUASSERTE(Epoch, times[i], out[i].time);
+      unsigned short expect = GDCStreamDetector::OK;
+      if (i == 0 || i == 300)
+         expect |= GDCStreamDetector::BREAK;
+      if (i == 50 || i == 320)
+         expect = GDCStreamDetector::BAD;
+      if (i == 100 || i == 200)
+         expect |= GDCStreamDetector::WLSLIP | GDCStreamDetector::GFSLIP;
+      TUASSERTE(unsigned short, expect, out[i].flag);
+   }
+   TUASSERTFEPS(1.0, out[100].WLslip, 0.2);
+   TUASSERTE(long, 3, out[100].N1);
+   TUASSERTE(long, 2, out[100].N2);
+   TUASSERTFEPS(3.0, out[200].WLslip, 0.2);
+   TUASSERTE(long, 10, out[200].N1);
+   TUASSERTE(long, 7, out[200].N2);
+   TURETURN();
+}
+
+
+unsigned GDCStreamDetector_T ::
+obviousTest()
+{
+   TUDEF("GDCStreamDetector", "add");
+   GDCconfiguration config;
+   config.setParameter("DT=30");
+   GDCStreamDetector det(config);
+   vector<GDCStreamDetector::Result> out;
+   long n1 = 0, n2 = 0;
+   double L1, L2, P1, P2;
+   for (int i = 0; i < 200; i++)
+   {
+         // WL slip of 50 cycles at 60, P1 outlier at 120
+      if (i == 60)
+      {
+         n1 += 100;
+         n2 += 50;
+      }
+      simulate(i, n1, n2, L1, L2, P1, P2);
+      if (i == 120)
+      {
+         P1 += 100.0;
+      }
+      det.add(t0 + 30.0 * i, L1, L2, P1, P2, true, out);
+   }
+   det.flush(out);
+   TUASSERTE(size_t, 200, out.size());
+   for (size_t i = 1; i < out.size(); i++)
+   {
+      unsigned short expect = GDCStreamDetector::OK;
+      if (i == 120)
+         expect = GDCStreamDetector::BAD;
+      if (i == 60)
+         expect |= GDCStreamDetector::WLSLIP | GDCStreamDetector::GFSLIP;
+      TUASSERTE(unsigned short, expect, out[i].flag);
+   }
+   TUASSERTE(long, 100, out[60].N1);
+   TUASSERTE(long, 50, out[60].N2);
+   TURETURN();
+}
+
+
+unsigned GDCStreamDetector_T ::
+throwTest()
+{
+   TUDEF("GDCStreamDetector", "GDCStreamDetector");
+   GDCconfiguration config;
+      // DT is required
+   TUTHROW(GDCStreamDetector det(config));
+   config.setParameter("DT=30");
+      // so is the GLONASS channel
+   TUTHROW(GDCStreamDetector det(config, SatelliteSystem::Glonass));
+   TUCATCH(GDCStreamDetector det(config, SatelliteSystem::Glonass, -3));
+   TUTHROW(GDCStreamDetector det(config, SatelliteSystem::Mixed));
+
+   TUCSM("add");
+   GDCStreamDetector det(config);
+   vector<GDCStreamDetector::Result> out;
+   det.add(t0, 1.0, 1.0, 1.0, 1.0, true, out);
+   TUTHROW(det.add(t0, 1.0, 1.0, 1.0, 1.0, true, out));
+   TURETURN();
+}
+
+
+int main()
+{
+   GDCStreamDetector_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.streamTest();
+   errorTotal += testClass.obviousTest();
+   errorTotal += testClass.throwTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,274 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+/// @file NutationSeries_T.cpp Test class NutationSeries against term by term
+/// evaluation of the IERS series.
+
+#include <cmath>
+#include "NutationSeries.hpp"
+#include "EarthOrientation.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class NutationSeries_T
+{
+public:
+   NutationSeries_T();
+      /// Compare nutation angles with the term by term sums.
+   unsigned nutationTest();
+      /// Compare the CIP X,Y with the term by term sums.
+   unsigned cioTest();
+      /// Check the cache and the vector interfaces.
+   unsigned batchTest();
+
+private:
+      /// IAU 2000A nutation, one term at a time.
+   static void refNutation2003(double T, double& deps, double& dpsi);
+      /// IERS2010 CIP X,Y, one term at a time.
+   static void refXYCIO(double T, double& X, double& Y);
+
+      /// times to test, in Julian centuries since J2000
+   vector<double> times;
+};
+
+
+NutationSeries_T ::
+NutationSeries_T()
+{
+   times.push_back(0.0);
+   times.push_back(-0.4);
+   times.push_back(0.17654321);
+   times.push_back(0.25);
+   times.push_back(1.0);
+   for (int i = 0; i < 20; i++)
+   {
+      times.push_back(0.1 + 0.0137 * i);
+   }
+}
+
+
+void NutationSeries_T ::
+refNutation2003(double T, double& deps, double& dpsi)
+{
+#include "IERS2003NutationData.hpp"
+   const double AS2R(EarthOrientation::ARCSEC_TO_RAD);
+   const double ASPC(EarthOrientation::ARCSEC_PER_CIRCLE);
+   const double TWOPI(EarthOrientation::TWOPI);
+   double l(EarthOrientation::L(T));
+   double lp(::fmod(1287104.79305 + T * (129596581.0481 + T * (-0.5532 +
+                    T * (0.000136 + T * (-0.00001149)))), ASPC) * AS2R);
+   double f(::fmod(335779.526232 + T * (1739527262.8478 + T * (-12.7512 +
+                   T * (-0.001037 + T * (0.00000417)))), ASPC) * AS2R);
+   double d(::fmod(1072260.70369 + T * (1602961601.2090 + T * (-6.3706 +
+                   T * (0.006593 + T * (-0.00003169)))), ASPC) * AS2R);
+   double om(EarthOrientation::Omega2003(T));
+   deps = dpsi = 0.0;
+   for (int i = NLS - 1; i >= 0; --i)
+   {
+      double arg(::fmod(LSCoeff[i].nl * l + LSCoeff[i].nlp * lp +
+                        LSCoeff[i].nf * f + LSCoeff[i].nd * d +
+                        LSCoeff[i].nom * om, TWOPI));
+      deps += (LSCoeff[i].ce + LSCoeff[i].cet * T) * ::cos(arg) +
+              LSCoeff[i].se * ::sin(arg);
+      dpsi += (LSCoeff[i].sp + LSCoeff[i].spt * T) * ::sin(arg) +
+              LSCoeff[i].cp * ::cos(arg);
+   }
+   l = ::fmod(2.35555598 + 8328.6914269554 * T, TWOPI);
+   f = ::fmod(1.627905234 + 8433.466158131 * T, TWOPI);
+   d = ::fmod(5.198466741 + 7771.3771468121 * T, TWOPI);
+   om = ::fmod(2.18243920 - 33.757045 * T, TWOPI);
+   double lne(::fmod(5.321159000 + 3.8127774000 * T, TWOPI));
+   for (int i = NP - 1; i >= 0; --i)
+   {
+      double arg(::fmod(PCoeff[i].nl * l + PCoeff[i].nf * f +
+                        PCoeff[i].nd * d + PCoeff[i].nom * om +
+                        PCoeff[i].nme * EarthOrientation::LMe(T) +
+                        PCoeff[i].nve * EarthOrientation::LV(T) +
+                        PCoeff[i].nea * EarthOrientation::LE(T) +
+                        PCoeff[i].nma * EarthOrientation::LMa(T) +
+                        PCoeff[i].nju * EarthOrientation::LJ(T) +
+                        PCoeff[i].nsa * EarthOrientation::LS(T) +
+                        PCoeff[i].nur * EarthOrientation::LU(T) +
+                        PCoeff[i].nne * lne +
+                        PCoeff[i].npa * EarthOrientation::Pa(T), TWOPI));
+      deps += PCoeff[i].ce * ::cos(arg) + PCoeff[i].se * ::sin(arg);
+      dpsi += PCoeff[i].sp * ::sin(arg) + PCoeff[i].cp * ::cos(arg);
+   }
+   deps *= AS2R * 1.e-7;
+   dpsi *= AS2R * 1.e-7;
+}
+
+
+void NutationSeries_T ::
+refXYCIO(double T, double& X, double& Y)
+{
+#include "IERS2010CIOSeriesData.hpp"
+   double fa[14] = {
+      EarthOrientation::L(T), EarthOrientation::Lp(T),
+      EarthOrientation::F(T), EarthOrientation::D(T),
+      EarthOrientation::Omega2003(T), EarthOrientation::LMe(T),
+      EarthOrientation::LV(T), EarthOrientation::LE(T),
+      EarthOrientation::LMa(T), EarthOrientation::LJ(T),
+      EarthOrientation::LS(T), EarthOrientation::LU(T),
+      EarthOrientation::LN(T), EarthOrientation::Pa(T)};
+   double xy[2] = {0.0, 0.0};
+   for (int f = 0; f < NFALS + NFAP; f++)
+   {
+      double arg(0.0);
+      for (int i = 0; i < 14; i++)
+      {
+         int n(f < NFALS ? (i < 5 ? nFAlunarsolar[f][i] : 0)
+                         : nFAplanetary[f - NFALS][i]);
+         arg += n * fa[i];
+      }
+      double sc[2] = {::sin(arg), ::cos(arg)};
+      int ilast(f + 1 < NFALS + NFAP ? iamp[f + 1] - 1 : NAmp);
+      for (int i = iamp[f]; i <= ilast; i++)
+      {
+         int j(i - iamp[f]);
+         xy[jaxy[j]] += amp[i - 1] * sc[jasc[j]] * ::pow(T, japt[j]);
+      }
+   }
+   double poly[2] = {0.0, 0.0};
+   for (int i = 0; i < 2; i++)
+   {
+      for (int j = MAXPT; j >= 0; j--)
+      {
+         poly[i] += XYcoeff[i][j] * ::pow(T, j);
+      }
+   }
+   X = (poly[0] + xy[0] * 1.e-6) * EarthOrientation::ARCSEC_TO_RAD;
+   Y = (poly[1] + xy[1] * 1.e-6) * EarthOrientation::ARCSEC_TO_RAD;
+}
+
+
+unsigned NutationSeries_T ::
+nutationTest()
+{
+   TUDEF("NutationSeries", "nutationAngles2003");
+   NutationSeries ns;
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      double T(times[i]), deps, dpsi, rdeps, rdpsi;
+      refNutation2003(T, rdeps, rdpsi);
+      ns.nutationAngles2003(T, deps, dpsi);
+      TUASSERTFEPS(rdeps, deps, 1.e-14);
+      TUASSERTFEPS(rdpsi, dpsi, 1.e-14);
+         // nutation is tens of arcseconds, not zero
+      TUASSERT(rdeps * rdeps + rdpsi * rdpsi > 1.e-12);
+
+      TUCSM("nutationAngles2010");
+      double fj2(-2.7774e-6 * T);
+      ns.nutationAngles2010(T, deps, dpsi);
+      TUASSERTFEPS(rdeps * (1.0 + fj2), deps, 1.e-14);
+      TUASSERTFEPS(rdpsi * (1.0 + 0.4697e-6 + fj2), dpsi, 1.e-14);
+      TUCSM("nutationAngles2003");
+   }
+   TURETURN();
+}
+
+
+unsigned NutationSeries_T ::
+cioTest()
+{
+   TUDEF("NutationSeries", "XYCIO");
+   NutationSeries ns;
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      double T(times[i]), X, Y, rX, rY;
+      refXYCIO(T, rX, rY);
+      ns.XYCIO(T, X, Y);
+      TUASSERTFEPS(rX, X, 1.e-14);
+      TUASSERTFEPS(rY, Y, 1.e-14);
+   }
+   TURETURN();
+}
+
+
+unsigned NutationSeries_T ::
+batchTest()
+{
+   TUDEF("NutationSeries", "nutationAngles2010");
+   NutationSeries ns, single;
+   vector<double> deps, dpsi, X, Y;
+   ns.nutationAngles2010(times, deps, dpsi);
+   ns.XYCIO(times, X, Y);
+   TUASSERTE(size_t, times.size(), deps.size());
+   TUASSERTE(size_t, times.size(), Y.size());
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      double e, p, x, y;
+      single.nutationAngles2010(times[i], e, p);
+      single.XYCIO(times[i], x, y);
+      TUASSERTFE(e, deps[i]);
+      TUASSERTFE(p, dpsi[i]);
+      TUASSERTFE(x, X[i]);
+      TUASSERTFE(y, Y[i]);
+   }
+
+      // repeated epoch uses the cache, and agrees with a new object
+   double e1, p1, e2, p2;
+   ns.nutationAngles2003(times[3], e1, p1);
+   ns.nutationAngles2003(times[3], e2, p2);
+   TUASSERTFE(e1, e2);
+   TUASSERTFE(p1, p2);
+   NutationSeries fresh;
+   fresh.nutationAngles2003(times[3], e2, p2);
+   TUASSERTFE(e1, e2);
+   TUASSERTFE(p1, p2);
+   TURETURN();
+}
+
+
+int main()
+{
+   NutationSeries_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.nutationTest();
+   errorTotal += testClass.cioTest();
+   errorTotal += testClass.batchTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,396 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file SRI_T.cpp Test the in-place update engine of SRIMatrix.hpp and SRI
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "SRI.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SRI_T
+{
+public:
+   SRI_T();
+      /// Compare SrifMUInPlace() with SrifMU() on the concatenated matrix.
+   unsigned measurementUpdateTest();
+      /// Check SrifRetriangularize() preserves the information.
+   unsigned retriangularizeTest();
+      /// Check SrifMoveState() permutes the information, both directions.
+   unsigned moveStateTest();
+      /// Check SRI::permute() and split() against the state and covariance.
+   unsigned permuteTest();
+      /// Check SRI::Qbump() with q=0 against the marginal information.
+   unsigned qbumpTest();
+      /// Check SRI::operator+=(SRI) adds the information of both.
+   unsigned mergeTest();
+
+private:
+      /// Random upper triangular R with a dominant diagonal, and random Z.
+   void randomSRI(unsigned n, Matrix<double>& R, Vector<double>& Z);
+      /// Return true if R is upper triangular.
+   static bool isUT(const Matrix<double>& R);
+   Namelist names(unsigned n, const string& prefix = "S");
+   TestRandom rng;
+};
+
+
+SRI_T ::
+SRI_T()
+      : rng(13579)
+{
+}
+
+
+void SRI_T ::
+randomSRI(unsigned n, Matrix<double>& R, Vector<double>& Z)
+{
+   R = Matrix<double>(n, n, 0.0);
+   Z = Vector<double>(n, 0.0);
+   for (unsigned j = 0; j < n; j++)
+   {
+      for (unsigned i = 0; i < j; i++)
+         R(i,j) = rng.random();
+      R(j,j) = 3.0 + rng.random();
+      Z(j) = 10.0 * rng.random();
+   }
+}
+
+
+bool SRI_T ::
+isUT(const Matrix<double>& R)
+{
+   for (unsigned j = 0; j < R.cols(); j++)
+      for (unsigned i = j+1; i < R.rows(); i++)
+         if (R(i,j) != 0.0)
+            return false;
+   return true;
+}
+
+
+Namelist SRI_T ::
+names(unsigned n, const string& prefix)
+{
+   vector<string> labels;
+   for (unsigned i = 0; i < n; i++)
+      labels.push_back(prefix + StringUtils::asString(i));
+   return Namelist(labels);
+}
+
+
+unsigned SRI_T ::
+measurementUpdateTest()
+{
+   TUDEF("SRIMatrix", "SrifMUInPlace");
+   const unsigned n = 7, m = 12;
+   Matrix<double> R, H(m, n);
+   Vector<double> Z, D(m);
+   randomSRI(n, R, Z);
+   for (unsigned i = 0; i < m; i++)
+   {
+      for (unsigned j = 0; j < n; j++)
+         H(i,j) = rng.random();
+      D(i) = rng.random();
+   }
+
+   Matrix<double> R1(R), R2(R), A(H || D), H2(H);
+   const Matrix<double> H3(H);
+   Vector<double> Z1(Z), Z2(Z), D2(D);
+   SrifMU(R1, Z1, A);
+   SrifMUInPlace(R2, Z2, H2, D2);
+   TUASSERTE(double, 0.0, maxDiff(R1, R2));
+   TUASSERTE(double, 0.0, maxDiff(Z1, Z2));
+   TUASSERTE(double, 0.0, maxDiff(Vector<double>(A.colCopy(n)), D2));
+
+      // the const version leaves H alone
+   Matrix<double> R3(R);
+   Vector<double> Z3(Z), D3(D);
+   SrifMU(R3, Z3, H3, D3);
+   TUASSERTE(double, 0.0, maxDiff(R1, R3));
+   TUASSERTE(double, 0.0, maxDiff(D2, D3));
+   TUASSERTE(double, 0.0, maxDiff(H, H3));
+
+      // an empty SRI is created by the update
+   Matrix<double> R4;
+   Vector<double> Z4, D4(D);
+   H2 = H;
+   SrifMUInPlace(R4, Z4, H2, D4);
+   TUASSERTE(unsigned, n, R4.rows());
+   TUASSERT(isUT(R4));
+
+   H2 = Matrix<double>(m, n+1, 0.0);
+   TUTHROW(SrifMUInPlace(R2, Z2, H2, D2));
+   TURETURN();
+}
+
+
+unsigned SRI_T ::
+retriangularizeTest()
+{
+   TUDEF("SRIMatrix", "SrifRetriangularize");
+   const unsigned n = 9;
+   Matrix<double> R, T(n, n);
+   Vector<double> Z;
+   randomSRI(n, R, Z);
+   for (unsigned i = 0; i < n; i++)
+      for (unsigned j = 0; j < n; j++)
+         T(i,j) = (i == j ? 1.0 : 0.3 * rng.random());
+   R = R * T;
+   Matrix<double> info(transpose(R) * R);
+   Vector<double> infoZ(transpose(R) * Z);
+
+   SrifRetriangularize(R, Z);
+   TUASSERT(isUT(R));
+   TUASSERTFEPS(0.0, maxDiff(info, transpose(R) * R), 1e-11);
+   TUASSERTFEPS(0.0, maxDiff(infoZ, transpose(R) * Z), 1e-11);
+
+      // the SRI member agrees with the state from the original
+   SRI S(R, Z, names(n));
+   Vector<double> X1, X2;
+   S.getState(X1);
+   S.transform(ident<double>(n), names(n));
+   S.getState(X2);
+   TUASSERTFEPS(0.0, maxDiff(X1, X2), 1e-11);
+   TURETURN();
+}
+
+
+unsigned SRI_T ::
+moveStateTest()
+{
+   TUDEF("SRIMatrix", "SrifMoveState");
+   const unsigned n = 8;
+   const unsigned moves[][2] = { {0,7}, {7,0}, {2,5}, {6,1}, {3,4}, {4,4} };
+   for (const auto& mv : moves)
+   {
+      Matrix<double> R;
+      Vector<double> Z;
+      randomSRI(n, R, Z);
+      Matrix<double> info(transpose(R) * R);
+      Vector<double> infoZ(transpose(R) * Z);
+
+         // perm[new index] = old index
+      vector<unsigned> perm;
+      for (unsigned i = 0; i < n; i++)
+         if (i != mv[0])
+            perm.push_back(i);
+      perm.insert(perm.begin() + mv[1], mv[0]);
+
+      SrifMoveState(R, Z, mv[0], mv[1]);
+      TUASSERT(isUT(R));
+      Matrix<double> newInfo(transpose(R) * R);
+      Vector<double> newInfoZ(transpose(R) * Z);
+      double diff = 0;
+      for (unsigned i = 0; i < n; i++)
+      {
+         diff = std::max(diff, std::abs(newInfoZ(i) - infoZ(perm[i])));
+         for (unsigned j = 0; j < n; j++)
+            diff = std::max(diff, std::abs(newInfo(i,j) -
+                                           info(perm[i],perm[j])));
+      }
+      TUASSERTFEPS(0.0, diff, 1e-12);
+   }
+
+   Matrix<double> R;
+   Vector<double> Z;
+   randomSRI(n, R, Z);
+   TUTHROW(SrifMoveState(R, Z, 0, n));
+   TURETURN();
+}
+
+
+unsigned SRI_T ::
+permuteTest()
+{
+   TUDEF("SRI", "permute");
+   const unsigned n = 10;
+   Matrix<double> R, C1, C2;
+   Vector<double> Z, X1, X2;
+   randomSRI(n, R, Z);
+   Namelist nl(names(n));
+   SRI S(R, Z, nl);
+   S.getStateAndCovariance(X1, C1);
+
+   Namelist pnl(nl);
+   pnl.randomize(11);
+   S.permute(pnl);
+   TUASSERT(identical(S.getNames(), pnl));
+   TUASSERT(isUT(S.getR()));
+   S.getStateAndCovariance(X2, C2);
+   double diff = 0;
+   for (unsigned i = 0; i < n; i++)
+   {
+      unsigned ii = nl.index(pnl.getName(i));
+      diff = std::max(diff, std::abs(X2(i) - X1(ii)));
+      for (unsigned j = 0; j < n; j++)
+         diff = std::max(diff, std::abs(C2(i,j) - C1(ii, nl.index(pnl.getName(j)))));
+   }
+   TUASSERTFEPS(0.0, diff, 1e-12);
+
+   TUTHROW(S.permute(names(n, "T")));
+
+      // split off the last three states; they keep their state and covariance
+   Namelist keep;
+   keep += nl.getName(2);
+   keep += nl.getName(5);
+   keep += nl.getName(7);
+   SRI Sleft;
+   S.split(keep, Sleft);
+   TUASSERT(identical(S.getNames(), keep));
+   TUASSERTE(unsigned, n, Sleft.size());
+   S.getStateAndCovariance(X2, C2);
+   diff = 0;
+   for (unsigned i = 0; i < keep.size(); i++)
+   {
+      unsigned ii = nl.index(keep.getName(i));
+      diff = std::max(diff, std::abs(X2(i) - X1(ii)));
+   }
+   TUASSERTFEPS(0.0, diff, 1e-12);
+   TURETURN();
+}
+
+
+unsigned SRI_T ::
+qbumpTest()
+{
+   TUDEF("SRI", "Qbump");
+   const unsigned n = 6, k = 2;
+   Matrix<double> R;
+   Vector<double> Z;
+   randomSRI(n, R, Z);
+   Matrix<double> info(transpose(R) * R);
+   Vector<double> infoZ(transpose(R) * Z);
+
+      // removing all information about k leaves the marginal information of
+      // the others: I - I(:,k)*I(k,:)/I(k,k)
+   Matrix<double> expInfo(n, n, 0.0);
+   Vector<double> expInfoZ(n, 0.0);
+   for (unsigned i = 0; i < n; i++)
+   {
+      if (i == k)
+         continue;
+      expInfoZ(i) = infoZ(i) - info(i,k) * infoZ(k) / info(k,k);
+      for (unsigned j = 0; j < n; j++)
+         if (j != k)
+            expInfo(i,j) = info(i,j) - info(i,k) * info(k,j) / info(k,k);
+   }
+
+   SRI S(R, Z, names(n));
+   S.Qbump(k);
+   Matrix<double> newR(S.getR());
+   Vector<double> newZ(S.getZ());
+   TUASSERT(isUT(newR));
+   TUASSERTFEPS(0.0, maxDiff(expInfo, transpose(newR) * newR), 1e-12);
+   TUASSERTFEPS(0.0, maxDiff(expInfoZ, transpose(newR) * newZ), 1e-12);
+
+      // a finite bump adds q^2 to the variance
+   Matrix<double> C1, C2;
+   Vector<double> X1, X2;
+   SRI S2(R, Z, names(n));
+   S2.getStateAndCovariance(X1, C1);
+   S2.Qbump(k, 0.5);
+   S2.getStateAndCovariance(X2, C2);
+   TUASSERTFEPS(C1(k,k) + 0.25, C2(k,k), 1e-12);
+   TUASSERTFEPS(0.0, maxDiff(X1, X2), 1e-12);
+   TURETURN();
+}
+
+
+unsigned SRI_T ::
+mergeTest()
+{
+   TUDEF("SRI", "operator+=");
+   Matrix<double> R1, R2;
+   Vector<double> Z1, Z2;
+   randomSRI(4, R1, Z1);
+   randomSRI(3, R2, Z2);
+   vector<string> l1, l2;
+   l1.push_back("A"); l1.push_back("B"); l1.push_back("C"); l1.push_back("D");
+   l2.push_back("E"); l2.push_back("B"); l2.push_back("F");
+   SRI S1(R1, Z1, Namelist(l1)), S2(R2, Z2, Namelist(l2));
+   S1 += S2;
+
+   Namelist all(S1.getNames());
+   TUASSERTE(unsigned, 6, all.size());
+   Matrix<double> expInfo(6, 6, 0.0);
+   Vector<double> expInfoZ(6, 0.0);
+   Matrix<double> I1(transpose(R1) * R1), I2(transpose(R2) * R2);
+   Vector<double> b1(transpose(R1) * Z1), b2(transpose(R2) * Z2);
+   for (unsigned i = 0; i < 4; i++)
+   {
+      expInfoZ(all.index(l1[i])) += b1(i);
+      for (unsigned j = 0; j < 4; j++)
+         expInfo(all.index(l1[i]), all.index(l1[j])) += I1(i,j);
+   }
+   for (unsigned i = 0; i < 3; i++)
+   {
+      expInfoZ(all.index(l2[i])) += b2(i);
+      for (unsigned j = 0; j < 3; j++)
+         expInfo(all.index(l2[i]), all.index(l2[j])) += I2(i,j);
+   }
+   Matrix<double> R(S1.getR());
+   Vector<double> Z(S1.getZ());
+   TUASSERT(isUT(R));
+   TUASSERTFEPS(0.0, maxDiff(expInfo, transpose(R) * R), 1e-12);
+   TUASSERTFEPS(0.0, maxDiff(expInfoZ, transpose(R) * Z), 1e-12);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SRI_T testClass;
+
+   errorTotal += testClass.measurementUpdateTest();
+   errorTotal += testClass.retriangularizeTest();
+   errorTotal += testClass.moveStateTest();
+   errorTotal += testClass.permuteTest();
+   errorTotal += testClass.qbumpTest();
+   errorTotal += testClass.mergeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,352 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SatPassIterator_T.cpp Test class SatPassIterator on lists of
+/// overlapping and gapped passes, against a reference that merges the
+/// passes by sorting every epoch of every pass on time.
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "CivilTime.hpp"
+#include "SatPassIterator.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SatPassIterator_T
+{
+public:
+   SatPassIterator_T();
+      /** Iterate over lists of passes, forward and reverse, and compare
+       * the epochs and their contents with the reference merge. */
+   unsigned mergeTest();
+      /// Check the exceptions.
+   unsigned throwTest();
+
+private:
+      /// one epoch of the reference: time, and (pass, index) pairs
+   typedef std::pair<Epoch, SatPassIterator::IndexList> RefEpoch;
+
+      /** Simulate nsat satellites with npass passes each, DT=30s. Passes
+       * of different satellites overlap; passes of one satellite are
+       * separated by gaps and have missing epochs within them; some
+       * epochs are flagged bad and some passes have negative Status. */
+   vector<SatPass> simulate(int nsat, int npass);
+      /** The linear merge: every epoch of every pass with Status >= 0,
+       * sorted on time (reversed if rev) and then on pass. */
+   vector<RefEpoch> reference(vector<SatPass>& list, bool rev);
+      /// Iterate over list and compare with reference().
+   void compare(TestUtil& testFramework, vector<SatPass>& list, bool rev);
+
+   std::mt19937 gen;
+   Epoch t0;
+   vector<string> obstypes;
+};
+
+
+SatPassIterator_T ::
+SatPassIterator_T()
+      : gen(13579), t0(CivilTime(2020,1,1,0,0,0.0,TimeSystem::GPS))
+{
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back("C1");
+   obstypes.push_back("P2");
+}
+
+
+vector<SatPass> SatPassIterator_T ::
+simulate(int nsat, int npass)
+{
+   std::uniform_int_distribution<int> uniform(0, 999);
+   vector<SatPass> list;
+   vector<double> data(4);
+   vector<unsigned short> lli(4, 0), ssi(4, 9);
+   for (int s = 1; s <= nsat; s++)
+   {
+      RinexSatID sat(s, SatelliteSystem::GPS);
+      int start = uniform(gen) % 50;
+      for (int p = 0; p < npass; p++)
+      {
+         SatPass sp(sat, 30.0, obstypes);
+         int n = 20 + uniform(gen) % 200;
+         for (int i = 0; i < n; i++)
+         {
+               // missing epochs
+            if (uniform(gen) % 10 == 0)
+               continue;
+            data[0] = 1000.0 * s + p + 0.5 * i;
+            data[1] = -data[0];
+            data[2] = 2.0e7 + data[0];
+            data[3] = 2.0e7 - data[0];
+            lli[0] = i % 3;
+            ssi[1] = 5 + i % 4;
+            sp.addData(t0 + 30.0 * (start + i), obstypes, data, lli, ssi,
+                       (uniform(gen) % 20 == 0 ? SatPass::BAD : SatPass::OK));
+         }
+         if (sp.size() > 0)
+         {
+            if (uniform(gen) % 7 == 0)
+               sp.status() = -1;
+            list.push_back(sp);
+         }
+            // gap before the next pass
+         start += n + 1 + uniform(gen) % 30;
+      }
+   }
+   return list;
+}
+
+
+vector<SatPassIterator_T::RefEpoch> SatPassIterator_T ::
+reference(vector<SatPass>& list, bool rev)
+{
+   vector<std::tuple<Epoch, unsigned, unsigned> > all;
+   for (unsigned i = 0; i < list.size(); i++)
+   {
+      if (list[i].status() < 0)
+         continue;
+      for (unsigned j = 0; j < list[i].size(); j++)
+      {
+         all.push_back(std::make_tuple(list[i].time(j), i, j));
+      }
+   }
+   std::sort(all.begin(), all.end());
+   if (rev)
+   {
+      std::stable_sort(all.begin(), all.end(),
+                       [](const std::tuple<Epoch, unsigned, unsigned>& l,
+                          const std::tuple<Epoch, unsigned, unsigned>& r)
+                       { return std::get<0>(r) < std::get<0>(l); });
+   }
+   vector<RefEpoch> rv;
+   for (const auto& e : all)
+   {
+      if (rv.empty() || rv.back().first != std::get<0>(e))
+      {
+         rv.push_back(RefEpoch(std::get<0>(e), SatPassIterator::IndexList()));
+      }
+      rv.back().second.push_back(std::make_pair(std::get<1>(e),
+                                                std::get<2>(e)));
+   }
+   return rv;
+}
+
+
+void SatPassIterator_T ::
+compare(TestUtil& testFramework, vector<SatPass>& list, bool rev)
+{
+      // the constructor sorts the list
+   SatPassIterator spi(list, rev);
+   vector<RefEpoch> ref(reference(list, rev));
+   TUASSERT(!ref.empty());
+
+      // next(IndexList) and next(map)
+   SatPassIterator::IndexList il;
+   map<unsigned, unsigned> im;
+   size_t k = 0;
+   bool same = true;
+   while (spi.next(il))
+   {
+      if (k >= ref.size())
+      {
+         k++;
+         break;
+      }
+      same = same && (il == ref[k].second);
+      k++;
+   }
+   TUASSERTE(size_t, ref.size(), k);
+   TUASSERT(same);
+   spi.reset(rev);
+   k = 0;
+   same = true;
+   while (spi.next(im))
+   {
+      same = same && k < ref.size() &&
+         im == map<unsigned, unsigned>(ref[k].second.begin(),
+                                       ref[k].second.end());
+      k++;
+   }
+   TUASSERTE(size_t, ref.size(), k);
+   TUASSERT(same);
+
+      // next(EpochData): times, satellites, flags and data
+   spi.reset(rev);
+   SatPassIterator::EpochData ed;
+   const vector<string>& ots(spi.getObsTypes());
+   TUASSERTE(size_t, obstypes.size(), ots.size());
+   k = 0;
+   same = true;
+   while (spi.next(ed))
+   {
+      if (k >= ref.size())
+      {
+         k++;
+         break;
+      }
+      const SatPassIterator::IndexList& r(ref[k].second);
+      same = same && ed.time == ref[k].first && ed.sats.size() == r.size() &&
+         ed.pass.size() == r.size() && ed.index.size() == r.size() &&
+         ed.flag.size() == r.size() && ed.data.size() == ots.size();
+      for (size_t m = 0; same && m < r.size(); m++)
+      {
+         SatPass& sp(list[r[m].first]);
+         unsigned j = r[m].second;
+         same = ed.pass[m] == r[m].first && ed.index[m] == j &&
+            ed.sats[m] == sp.getSat() && ed.flag[m] == sp.getFlag(j);
+         for (size_t n = 0; same && n < ots.size(); n++)
+         {
+            same = ed.data[n][m] == sp.data(j, ots[n]) &&
+               ed.lli[n][m] == sp.LLI(j, ots[n]) &&
+               ed.ssi[n][m] == sp.SSI(j, ots[n]);
+         }
+      }
+      k++;
+   }
+   TUASSERTE(size_t, ref.size(), k);
+   TUASSERT(same);
+
+      // next(RinexObsData)
+   spi.reset(rev);
+   RinexObsData robs;
+   k = 0;
+   same = true;
+   while (spi.next(robs))
+   {
+      if (k >= ref.size())
+      {
+         k++;
+         break;
+      }
+      const SatPassIterator::IndexList& r(ref[k].second);
+      same = same && robs.time == ref[k].first &&
+         robs.obs.size() == r.size();
+      for (size_t m = 0; same && m < r.size(); m++)
+      {
+         SatPass& sp(list[r[m].first]);
+         RinexObsData::RinexSatMap::const_iterator it;
+         it = robs.obs.find(sp.getSat());
+         same = (it != robs.obs.end() && it->second.size() == ots.size());
+         for (size_t n = 0; same && n < ots.size(); n++)
+         {
+            RinexObsData::RinexObsTypeMap::const_iterator jt;
+            jt = it->second.find(RinexObsHeader::convertObsType(ots[n]));
+            same = (jt != it->second.end() &&
+                    jt->second.data == sp.data(r[m].second, ots[n]));
+         }
+      }
+      k++;
+   }
+   TUASSERTE(size_t, ref.size(), k);
+   TUASSERT(same);
+}
+
+
+unsigned SatPassIterator_T ::
+mergeTest()
+{
+   TUDEF("SatPassIterator", "next");
+      // many short passes, a few long ones, one satellite, one pass
+   int sizes[4][2] = { { 30, 20 }, { 8, 3 }, { 1, 5 }, { 1, 1 } };
+   for (int s = 0; s < 4; s++)
+   {
+      vector<SatPass> list(simulate(sizes[s][0], sizes[s][1]));
+      for (int rev = 0; rev < 2; rev++)
+      {
+         vector<SatPass> copy(list);
+         compare(testFramework, copy, rev == 1);
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned SatPassIterator_T ::
+throwTest()
+{
+   TUDEF("SatPassIterator", "SatPassIterator");
+   vector<SatPass> empty;
+   TUTHROW(SatPassIterator spi(empty));
+
+      // different time steps
+   vector<SatPass> list(simulate(2, 1));
+   SatPass sp(RinexSatID(3, SatelliteSystem::GPS), 15.0, obstypes);
+   sp.addData(t0, obstypes, vector<double>(4, 1.0),
+              vector<unsigned short>(4, 0), vector<unsigned short>(4, 0));
+   list.push_back(sp);
+   TUTHROW(SatPassIterator spi(list));
+
+      // overlapping passes of one satellite
+   list = simulate(1, 1);
+   list.push_back(list[0]);
+   list[1].status() = 0;
+   list[0].status() = 0;
+   bool threw = false;
+   try
+   {
+      SatPassIterator spi(list);
+      SatPassIterator::IndexList il;
+      while (spi.next(il))
+         ;
+   }
+   catch (Exception& e)
+   {
+      threw = true;
+   }
+   TUASSERT(threw);
+   TURETURN();
+}
+
+
+int main()
+{
+   SatPassIterator_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.mergeTest();
+   errorTotal += testClass.throwTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
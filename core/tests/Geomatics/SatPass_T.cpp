@@ -0,0 +1,431 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SatPass_T.cpp Test the SatPass routines that work on the data
+/// columns: smooth(), getGLOchannel(), split(), decimate() and trimAfter().
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "CivilTime.hpp"
+#include "GNSSconstants.hpp"
+#include "SatPass.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SatPass_T
+{
+public:
+   SatPass_T();
+      /// Smooth noise-free data, whose biases are known exactly.
+   unsigned smoothTest();
+      /// Find the channel of GLONASS passes from a nominal start.
+   unsigned gloTest();
+      /// Split a pass in two and check both halves.
+   unsigned splitTest();
+      /// Decimate a pass and check the epochs that are kept.
+   unsigned decimateTest();
+      /// Truncate a pass and check what remains.
+   unsigned trimTest();
+
+private:
+      /// The contents of one epoch, as seen through the public accessors.
+   struct EpochData
+   {
+      Epoch time;
+      unsigned short flag;
+      unsigned int userFlag;
+      vector<double> data;
+      vector<unsigned short> lli, ssi;
+   };
+
+      /** Simulate a pass of n epochs, DT=30s, of satellite sat (GLONASS
+       * channel GLOn) with phase ambiguities N1 and N2 (cycles), range and
+       * phase noise scaled by noise, a gap of 10 epochs at epoch igap, and
+       * epoch ibad flagged bad.  The types are L1 L2, then P1 or C1, then
+       * P2. */
+   SatPass simulate(const RinexSatID& sat, int GLOn, int n, long N1, long N2,
+                    double noise, int igap, int ibad, bool useC1 = false);
+      /// The wavelengths of sat (GLONASS channel GLOn).
+   static void wavelengths(const RinexSatID& sat, int GLOn, double& wl1,
+                           double& wl2);
+      /// Range and L1 ionospheric delay (m) at epoch count i.
+   static double range(int i)
+   { return 2.2e7 - 600.0 * i + 0.3 * i * i; }
+   static double iono(int i)
+   { return 4.0 + 0.002 * i + 1.0e-5 * i * i; }
+      /// Copy every epoch of sp.
+   vector<EpochData> snapshot(SatPass& sp);
+      /// Assert that epoch i of sp is the same as ed.
+   void checkEpoch(TestUtil& testFramework, SatPass& sp, unsigned i,
+                   const EpochData& ed);
+
+   TestRandom rng;
+   Epoch t0;
+};
+
+
+SatPass_T ::
+SatPass_T()
+      : rng(2468), t0(CivilTime(2020,1,1,0,0,0.0,TimeSystem::GPS))
+{
+}
+
+
+void SatPass_T ::
+wavelengths(const RinexSatID& sat, int GLOn, double& wl1, double& wl2)
+{
+   if (sat.system == SatelliteSystem::Glonass)
+   {
+      wl1 = C_MPS / (1602.0e6 + GLOn * 562.5e3);
+      wl2 = C_MPS / (1246.0e6 + GLOn * 437.5e3);
+   }
+   else
+   {
+      wl1 = C_MPS / (L1_MULT_GPS * OSC_FREQ_GPS);
+      wl2 = C_MPS / (L2_MULT_GPS * OSC_FREQ_GPS);
+   }
+}
+
+
+SatPass SatPass_T ::
+simulate(const RinexSatID& sat, int GLOn, int n, long N1, long N2,
+         double noise, int igap, int ibad, bool useC1)
+{
+   double wl1, wl2;
+   wavelengths(sat, GLOn, wl1, wl2);
+   const double gamma = (wl2 * wl2) / (wl1 * wl1);
+   vector<string> obstypes;
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back(useC1 ? "C1" : "P1");
+   obstypes.push_back("P2");
+
+   SatPass sp(sat, 30.0, obstypes);
+   vector<double> data(4);
+   vector<unsigned short> lli(4), ssi(4);
+   for (int i = 0; i < n; i++)
+   {
+      if (i >= igap && i < igap + 10)
+         continue;
+      const double rho = range(i), ion = iono(i);
+      data[0] = (rho - ion) / wl1 + N1 + 0.003 * noise * rng.gaussian();
+      data[1] = (rho - gamma * ion) / wl2 + N2 + 0.003 * noise * rng.gaussian();
+      data[2] = rho + ion + 0.3 * noise * rng.gaussian();
+      data[3] = rho + gamma * ion + 0.3 * noise * rng.gaussian();
+      for (unsigned k = 0; k < 4; k++)
+      {
+         lli[k] = (i + k) % 3;
+         ssi[k] = 5 + (i + k) % 5;
+      }
+      if (i == ibad)
+      {
+            // junk, which must be skipped
+         data[2] = data[3] = 0.0;
+      }
+      sp.addData(t0 + 30.0 * i, obstypes, data, lli, ssi,
+                 (i == ibad ? SatPass::BAD : SatPass::OK));
+      sp.setUserFlag(sp.size() - 1, i);
+   }
+   return sp;
+}
+
+
+vector<SatPass_T::EpochData> SatPass_T ::
+snapshot(SatPass& sp)
+{
+   vector<string> types(sp.getObsTypes());
+   vector<EpochData> rv(sp.size());
+   for (unsigned i = 0; i < sp.size(); i++)
+   {
+      rv[i].time = sp.time(i);
+      rv[i].flag = sp.getFlag(i);
+      rv[i].userFlag = sp.getUserFlag(i);
+      for (unsigned k = 0; k < types.size(); k++)
+      {
+         rv[i].data.push_back(sp.data(i, types[k]));
+         rv[i].lli.push_back(sp.LLI(i, types[k]));
+         rv[i].ssi.push_back(sp.SSI(i, types[k]));
+      }
+   }
+   return rv;
+}
+
+
+void SatPass_T ::
+checkEpoch(TestUtil& testFramework, SatPass& sp, unsigned i,
+           const EpochData& ed)
+{
+   vector<string> types(sp.getObsTypes());
+   TUASSERTE(Epoch, ed.time, sp.time(i));
+   TUASSERTE(unsigned short, ed.flag, sp.getFlag(i));
+   TUASSERTE(unsigned int, ed.userFlag, sp.getUserFlag(i));
+   for (unsigned k = 0; k < types.size(); k++)
+   {
+      TUASSERTE(double, ed.data[k], sp.data(i, types[k]));
+      TUASSERTE(unsigned short, ed.lli[k], sp.LLI(i, types[k]));
+      TUASSERTE(unsigned short, ed.ssi[k], sp.SSI(i, types[k]));
+   }
+}
+
+
+unsigned SatPass_T ::
+smoothTest()
+{
+   TUDEF("SatPass", "smooth");
+   const long N1 = 123456, N2 = -98765;
+   double wl1, wl2;
+   RinexSatID sat(5, SatelliteSystem::GPS);
+   wavelengths(sat, 0, wl1, wl2);
+   const double gamma = (wl2 * wl2) / (wl1 * wl1);
+
+      // with P1, and with C1
+   for (int c1 = 0; c1 < 2; c1++)
+   {
+      SatPass sp(simulate(sat, 0, 200, N1, N2, 0.0, 50, 20, c1 == 1));
+      vector<EpochData> before(snapshot(sp));
+      string msg;
+      sp.smooth(true, true, msg, wl1, wl2);
+      TUASSERTE(string, "SMT G05", msg.substr(0, 7));
+      TUASSERTE(unsigned, before.size(), sp.size());
+      const string P1(c1 == 1 ? "C1" : "P1");
+      bool first(true);
+      double off1(0.0), off2(0.0);
+      for (unsigned i = 0; i < sp.size(); i++)
+      {
+         int count = sp.getUserFlag(i);
+         if (count == 20)
+         {
+               // the bad epoch is left alone
+            checkEpoch(testFramework, sp, i, before[i]);
+            continue;
+         }
+            // without noise the smoothed range follows the true one up to a
+            // constant (the real bias is relative to the whole cycles
+            // removed at the first epoch), and the integer ambiguities are
+            // removed exactly
+         const double rho = range(count), ion = iono(count);
+         if (first)
+         {
+            off1 = sp.data(i, P1) - (rho + ion);
+            off2 = sp.data(i, "P2") - (rho + gamma * ion);
+            first = false;
+         }
+         TUASSERTFEPS(rho + ion + off1, sp.data(i, P1), 1.e-5);
+         TUASSERTFEPS(rho + gamma * ion + off2, sp.data(i, "P2"), 1.e-5);
+         TUASSERTFEPS(before[i].data[0] - N1, sp.data(i, "L1"), 1.e-6);
+         TUASSERTFEPS(before[i].data[1] - N2, sp.data(i, "L2"), 1.e-6);
+      }
+   }
+
+      // only the statistics
+   SatPass sp(simulate(sat, 0, 100, N1, N2, 1.0, 1000, -1));
+   vector<EpochData> before(snapshot(sp));
+   string msg;
+   sp.smooth(false, false, msg, wl1, wl2);
+   TUASSERTE(string, "SMT G05", msg.substr(0, 7));
+   for (unsigned i = 0; i < sp.size(); i++)
+      checkEpoch(testFramework, sp, i, before[i]);
+
+   vector<string> types;
+   types.push_back("L1");
+   types.push_back("P1");
+   SatPass sf(sat, 30.0, types);
+   TUTHROW(sf.smooth(true, true, msg));
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+gloTest()
+{
+   TUDEF("SatPass", "getGLOchannel");
+   int channels[4] = { -7, -2, 1, 6 };
+   for (int k = 0; k < 4; k++)
+   {
+      RinexSatID sat(k + 1, SatelliteSystem::Glonass);
+      SatPass sp(simulate(sat, channels[k], 350, 2000 + k, -1500 - k, 1.0,
+                          1000, 40));
+      vector<EpochData> before(snapshot(sp));
+      int n = 0;
+      string msg;
+      TUASSERT(sp.getGLOchannel(n, msg));
+      TUASSERTE(int, channels[k], n);
+      TUASSERTE(string, "FINAL", msg.substr(0, 5));
+         // a good start is kept
+      TUASSERT(sp.getGLOchannel(n, msg));
+      TUASSERTE(int, channels[k], n);
+         // nothing is changed
+      for (unsigned i = 0; i < sp.size(); i++)
+         checkEpoch(testFramework, sp, i, before[i]);
+   }
+
+      // not GLONASS
+   SatPass gps(simulate(RinexSatID(3, SatelliteSystem::GPS), 0, 100, 0, 0,
+                        1.0, 1000, -1));
+   int n = 0;
+   string msg;
+   TUASSERT(!gps.getGLOchannel(n, msg));
+      // missing obs types
+   vector<string> types;
+   types.push_back("L1");
+   types.push_back("P1");
+   SatPass glo(RinexSatID(1, SatelliteSystem::Glonass), 30.0, types);
+   TUTHROW(glo.getGLOchannel(n, msg));
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+splitTest()
+{
+   TUDEF("SatPass", "split");
+   SatPass sp(simulate(RinexSatID(7, SatelliteSystem::GPS), 0, 120, 0, 0,
+                       1.0, 30, 75));
+   vector<EpochData> before(snapshot(sp));
+   const int ngood = sp.getNgood();
+
+      // split at count 60; counts 30-39 are missing
+   SatPass second(RinexSatID(1, SatelliteSystem::GPS), 1.0);
+   TUASSERT(sp.split(60, second));
+   TUASSERTE(RinexSatID, sp.getSat(), second.getSat());
+   TUASSERTE(double, 30.0, second.getDT());
+   TUASSERTE(unsigned, 50, sp.size());
+   TUASSERTE(unsigned, 60, second.size());
+   TUASSERTE(unsigned, before.size(), sp.size() + second.size());
+   TUASSERTE(int, 50, sp.getNgood());
+   TUASSERTE(int, ngood, sp.getNgood() + second.getNgood());
+   TUASSERTE(Epoch, before[0].time, sp.getFirstTime());
+   TUASSERTE(Epoch, before[49].time, sp.getLastTime());
+   TUASSERTE(Epoch, before[50].time, second.getFirstTime());
+   TUASSERTE(Epoch, before.back().time, second.getLastTime());
+   TUASSERTE(unsigned, 0, second.getCount(0));
+   TUASSERTE(unsigned, 59, second.getCount(59));
+   for (unsigned i = 0; i < sp.size(); i++)
+      checkEpoch(testFramework, sp, i, before[i]);
+   for (unsigned i = 0; i < second.size(); i++)
+      checkEpoch(testFramework, second, i, before[50 + i]);
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+decimateTest()
+{
+   TUDEF("SatPass", "decimate");
+      // counts 30-39 are missing
+   SatPass sp(simulate(RinexSatID(8, SatelliteSystem::GPS), 0, 100, 0, 0,
+                       1.0, 30, 46));
+   vector<EpochData> before(snapshot(sp));
+
+      // keep every 4th epoch, referenced to a time 2 epochs before the start
+   sp.decimate(4, t0 - 60.0);
+   TUASSERTE(double, 120.0, sp.getDT());
+   vector<EpochData> expect;
+   for (unsigned i = 0; i < before.size(); i++)
+   {
+      int count = before[i].userFlag;
+      if (count % 4 == 2)
+         expect.push_back(before[i]);
+   }
+   TUASSERTE(unsigned, expect.size(), sp.size());
+   TUASSERTE(Epoch, t0 + 60.0, sp.getFirstTime());
+   TUASSERTE(Epoch, expect.back().time, sp.getLastTime());
+      // 46 is flagged bad and is kept
+   TUASSERTE(int, int(expect.size()) - 1, sp.getNgood());
+   for (unsigned i = 0; i < sp.size() && i < expect.size(); i++)
+   {
+      checkEpoch(testFramework, sp, i, expect[i]);
+      TUASSERTE(unsigned, (expect[i].userFlag - 2) / 4, sp.getCount(i));
+   }
+
+      // decimating by 1 does nothing
+   vector<EpochData> after(snapshot(sp));
+   sp.decimate(1);
+   TUASSERTE(unsigned, after.size(), sp.size());
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+trimTest()
+{
+   TUDEF("SatPass", "trimAfter");
+   SatPass sp(simulate(RinexSatID(9, SatelliteSystem::GPS), 0, 80, 0, 0,
+                       1.0, 20, 10));
+   vector<EpochData> before(snapshot(sp));
+
+   TUASSERTE(int, -1, sp.trimAfter(t0));
+   TUASSERTE(int, 1, sp.trimAfter(before.back().time));
+   TUASSERTE(unsigned, before.size(), sp.size());
+
+      // counts 20-29 are missing; data up to the epoch at count 45 remain
+   TUASSERTE(int, 0, sp.trimAfter(t0 + 45 * 30.0));
+   TUASSERTE(unsigned, 36, sp.size());
+   TUASSERTE(Epoch, t0 + 45 * 30.0, sp.getLastTime());
+   for (unsigned i = 0; i < sp.size(); i++)
+      checkEpoch(testFramework, sp, i, before[i]);
+
+      // a time inside the gap keeps the first epoch after it
+   TUASSERTE(int, 0, sp.trimAfter(t0 + 25 * 30.0));
+   TUASSERTE(unsigned, 21, sp.size());
+   TUASSERTE(Epoch, t0 + 30 * 30.0, sp.getLastTime());
+   for (unsigned i = 0; i < sp.size(); i++)
+      checkEpoch(testFramework, sp, i, before[i]);
+   TURETURN();
+}
+
+
+int main()
+{
+   SatPass_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.smoothTest();
+   errorTotal += testClass.gloTest();
+   errorTotal += testClass.splitTest();
+   errorTotal += testClass.decimateTest();
+   errorTotal += testClass.trimTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
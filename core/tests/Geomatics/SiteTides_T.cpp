@@ -0,0 +1,251 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SiteTides_T.cpp Test class SiteTides against the tide functions it
+/// combines.
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CivilTime.hpp"
+#include "SiteTides.hpp"
+#include "SolarPosition.hpp"
+#include "SunEarthSatGeometry.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SiteTides_T
+{
+public:
+   SiteTides_T();
+   ~SiteTides_T();
+      /// Check single epochs against the solid, pole and ocean tide functions.
+   unsigned displacementTest();
+      /// Check the batch computation, the choice of tides and sharing by
+      /// threads.
+   unsigned batchTest();
+      /// Check the exceptions.
+   unsigned throwTest();
+
+private:
+      /// Write a BLQ file with one site, ONSALA.
+   void writeBLQ();
+   string fileName;
+   Position site;
+   EphTime t0;
+   OceanLoadTides olt;
+};
+
+
+SiteTides_T ::
+SiteTides_T()
+      : site(3370658.5419, 711877.1496, 5349786.9542),
+        t0(CivilTime(2019,6,1,0,0,0.0,TimeSystem::GPS))
+{
+   fileName = getPathTestTemp() + getFileSep() + "test_output_SiteTides.blq";
+   writeBLQ();
+   vector<string> sites(1, "ONSALA");
+   olt.initializeSites(sites, fileName);
+}
+
+
+SiteTides_T ::
+~SiteTides_T()
+{
+   std::remove(fileName.c_str());
+}
+
+
+void SiteTides_T ::
+writeBLQ()
+{
+   ofstream ofs(fileName.c_str());
+   ofs << "$$ Ocean loading test file\n"
+       << "  ONSALA\n"
+       << "$$ Onsala,                     lon/lat:   11.9264   57.3958    0.00\n"
+       << "  .00352 .00123 .00080 .00034 .00187 .00112 .00063 .00034 .00082"
+       << " .00050 .00346\n"
+       << "  .00093 .00031 .00019 .00011 .00035 .00023 .00011 .00006 .00014"
+       << " .00006 .00010\n"
+       << "  .00116 .00040 .00026 .00011 .00024 .00015 .00008 .00004 .00010"
+       << " .00006 .00011\n"
+       << "  -64.7  -52.0  -96.2  -55.2  -58.8 -151.4  -65.6 -138.1    8.4"
+       << "    5.2    2.1\n"
+       << "   85.5  114.5   56.5  113.6   99.4   19.1   94.1  -10.4 -167.4"
+       << " -170.0 -177.7\n"
+       << "  109.5  147.0   92.7  148.8   54.4   -6.4   51.7  -24.3  -71.8"
+       << "  -80.2  -90.0\n";
+}
+
+
+unsigned SiteTides_T ::
+displacementTest()
+{
+   TUDEF("SiteTides", "computeDisplacement");
+   const double xp(0.1), yp(0.3), eps(1.e-12);
+   Matrix<double> R(northEastUp(site));
+   SiteTides tides(site);
+   tides.setOceanLoading(olt, "ONSALA", t0);
+   TUASSERT(!tides.getHarmonics().cosU.empty());
+
+   for (int i = 0; i < 20; i++)
+   {
+      EphTime t(t0);
+      t += 3727.0 * i;
+      double AR;
+      Position Sun(solarPosition(t, AR)), Moon(lunarPosition(t, AR));
+      Triple solid(computeSolidEarthTides(site, t, Sun, Moon));
+      Triple pole(computePolarTides(site, t, xp, yp));
+      Triple ocean(olt.computeDisplacement("ONSALA", t));
+      Triple disp(tides.computeDisplacement(t, Sun, Moon, xp, yp));
+      for (int k = 0; k < 3; k++)
+      {
+         double expect = solid[k] + pole[k] + R(0, k) * ocean[0] +
+                         R(1, k) * ocean[1] + R(2, k) * ocean[2];
+         TUASSERTFEPS(expect, disp[k], eps);
+      }
+   }
+
+   TUCSM("getHarmonics");
+      // the derived tides may be used long after the reference time
+   OceanLoadTides::Harmonics harm;
+   olt.getHarmonics("ONSALA", t0, harm);
+   for (int i = 0; i < 10; i++)
+   {
+      EphTime t(t0);
+      t += 86400.0 * 37 * i;
+      Triple ocean(olt.computeDisplacement("ONSALA", t));
+      Triple fast(OceanLoadTides::computeDisplacement(harm, t));
+      for (int k = 0; k < 3; k++)
+         TUASSERTFEPS(ocean[k], fast[k], 1.e-9);
+   }
+   TURETURN();
+}
+
+
+unsigned SiteTides_T ::
+batchTest()
+{
+   TUDEF("SiteTides", "computeDisplacements");
+   SiteTides tides(site);
+   tides.setOceanLoading(olt, "ONSALA", t0);
+
+   vector<EphTime> times;
+   for (int i = 0; i < 96; i++)
+   {
+      EphTime t(t0);
+      t += 900.0 * i;
+      times.push_back(t);
+   }
+
+      // without EOPs the pole tide is not included
+   vector<Triple> disp;
+   tides.computeDisplacements(times, disp);
+   TUASSERTE(size_t, times.size(), disp.size());
+   SiteTides nopole(site);
+   nopole.setOceanLoading(olt, "ONSALA", t0);
+   nopole.setTides(true, true, false);
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      double AR;
+      Position Sun(solarPosition(times[i], AR)), Moon(lunarPosition(times[i], AR));
+      Triple d(nopole.computeDisplacement(times[i], Sun, Moon, 0.1, 0.3));
+      for (int k = 0; k < 3; k++)
+         TUASSERTFE(d[k], disp[i][k]);
+   }
+
+      // threads share one object
+   vector<vector<Triple> > results(4);
+   vector<thread> workers;
+   for (int n = 0; n < 4; n++)
+   {
+      workers.push_back(thread([&tides, &times, &results, n]()
+                               { tides.computeDisplacements(times, results[n]); }));
+   }
+   for (int n = 0; n < 4; n++)
+      workers[n].join();
+   for (int n = 0; n < 4; n++)
+   {
+      TUASSERTE(size_t, times.size(), results[n].size());
+      bool same(true);
+      for (size_t i = 0; i < times.size(); i++)
+         for (int k = 0; k < 3; k++)
+            if (results[n][i][k] != disp[i][k])
+               same = false;
+      TUASSERT(same);
+   }
+
+   TUCSM("setTides");
+   tides.setTides(false, false, false);
+   tides.computeDisplacements(times, disp);
+   for (size_t i = 0; i < times.size(); i++)
+      for (int k = 0; k < 3; k++)
+         TUASSERTFE(0.0, disp[i][k]);
+   TURETURN();
+}
+
+
+unsigned SiteTides_T ::
+throwTest()
+{
+   TUDEF("SiteTides", "setOceanLoading");
+   SiteTides tides(site);
+   TUTHROW(tides.setOceanLoading(olt, "NOWHERE", t0));
+   TUCATCH(tides.setOceanLoading(olt, "ONSALA", t0));
+   TURETURN();
+}
+
+
+int main()
+{
+   SiteTides_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.displacementTest();
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.throwTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,408 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+/// @file SolarSystemEphemeris_T.cpp Test class SolarSystemEphemeris, reading a
+/// synthetic binary ephemeris both through the stream and memory-mapped.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FileUtils.hpp"
+#include "SolarSystemEphemeris.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SolarSystemEphemeris_T
+{
+public:
+   SolarSystemEphemeris_T();
+   ~SolarSystemEphemeris_T();
+      /// Compare the stream and mapped modes, and check errors.
+   unsigned mappedTest();
+      /// Compare the Chebyshev evaluation with the closed form.
+   unsigned chebyshevTest();
+      /// Check the batch routines and concurrent callers.
+   unsigned batchTest();
+
+private:
+      /// Write the synthetic ephemeris, in the format of writeBinaryFile().
+   void writeFile();
+      /// Pick a time well inside the records.
+   double randomMJD();
+
+   TestRandom rng;
+   string fileName, swappedName;
+   bool written;
+   int ncoeff[13], nsets[13], offset[13], Ncoeff;
+   double startJD, interval;
+   vector<vector<double> > records;
+   static const int nrec = 6;
+   static const double AUkm, EMRAT;
+};
+
+const double SolarSystemEphemeris_T::AUkm = 149597870.7;
+const double SolarSystemEphemeris_T::EMRAT = 81.30056;
+
+
+SolarSystemEphemeris_T ::
+SolarSystemEphemeris_T()
+      : rng(31415), startJD(2451536.5), interval(32.0)
+{
+   FileUtils::makeDir(getPathTestTemp(), 0755);
+   fileName = getPathTestTemp() + getFileSep() + "test_output_SSEph.bin";
+   swappedName = getPathTestTemp() + getFileSep() + "test_output_SSEph_swap.bin";
+   writeFile();
+}
+
+
+SolarSystemEphemeris_T ::
+~SolarSystemEphemeris_T()
+{
+   std::remove(fileName.c_str());
+   std::remove(swappedName.c_str());
+}
+
+
+double SolarSystemEphemeris_T ::
+randomMJD()
+{
+   double t = startJD - MJD_TO_JD + nrec * interval * 0.5 * (1.0 + rng.random());
+      // stay off the record boundaries, where the synthetic data jumps
+   double f = ::fmod(t - (startJD - MJD_TO_JD), interval / 4);
+   if (f < 0.01 || f > interval / 4 - 0.01)
+      t += 0.5;
+   return t;
+}
+
+
+void SolarSystemEphemeris_T ::
+writeFile()
+{
+      // 10 coefficients per component; several sets for the Moon and Sun
+   Ncoeff = 2;
+   for (int b = 0; b < 13; b++)
+   {
+      ncoeff[b] = 10;
+      nsets[b] = (b == 9 ? 4 : (b == 10 ? 2 : 1));
+      offset[b] = Ncoeff + 1;
+      Ncoeff += (b == 11 ? 2 : 3) * ncoeff[b] * nsets[b];
+   }
+
+   ofstream strm(fileName.c_str(), ios::out | ios::binary);
+   string blank(84, ' ');
+   int recLength = 0;
+   for (int i = 0; i < 3; i++)
+      strm.write(blank.c_str(), 84);
+   recLength += 3 * 84;
+   const char *names[3] = {"AU    ", "DENUM ", "EMRAT "};
+   for (int i = 0; i < 400; i++)
+      strm.write(i < 3 ? names[i] : "      ", 6);
+   recLength += 400 * 6;
+   double endJD = startJD + nrec * interval, denum = 999.0;
+   strm.write((char *)&startJD, sizeof(double));
+   strm.write((char *)&endJD, sizeof(double));
+   strm.write((char *)&interval, sizeof(double));
+   strm.write((char *)&Ncoeff, sizeof(int));
+   strm.write((char *)&AUkm, sizeof(double));
+   strm.write((char *)&EMRAT, sizeof(double));
+   recLength += 3 * sizeof(double) + sizeof(int) + 2 * sizeof(double);
+   for (int b = 0; b < 12; b++)
+   {
+      strm.write((char *)&offset[b], sizeof(int));
+      strm.write((char *)&ncoeff[b], sizeof(int));
+      strm.write((char *)&nsets[b], sizeof(int));
+   }
+   strm.write((char *)&denum, sizeof(double));
+   strm.write((char *)&offset[12], sizeof(int));
+   strm.write((char *)&ncoeff[12], sizeof(int));
+   strm.write((char *)&nsets[12], sizeof(int));
+   recLength += 39 * sizeof(int) + sizeof(double);
+   for (int i = recLength; i < Ncoeff * int(sizeof(double)); i++)
+      strm.put(' ');
+
+      // second header record: the constants, then a pad
+   double consts[3] = {AUkm, denum, EMRAT}, z = 0.0;
+   for (int i = 0; i < 400; i++)
+      strm.write((char *)(i < 3 ? &consts[i] : &z), sizeof(double));
+   for (int i = 0; i < (400 - 3) * int(sizeof(double)); i++)
+      strm.put(' ');
+
+      // data records, coefficients decreasing with degree
+   records.resize(nrec);
+   for (int n = 0; n < nrec; n++)
+   {
+      vector<double>& rec = records[n];
+      rec.resize(Ncoeff);
+      rec[0] = startJD + n * interval;
+      rec[1] = rec[0] + interval;
+      for (int i = 2; i < Ncoeff; i++)
+      {
+         int j = (i - 2) % 10;
+         rec[i] = 1.e6 * rng.random() / ((j + 1) * (j + 1));
+      }
+      strm.write((char *)&rec[0], Ncoeff * sizeof(double));
+   }
+   written = strm.good();
+   strm.close();
+
+      // a copy with the record length in the other byte order
+   ifstream in(fileName.c_str(), ios::in | ios::binary);
+   string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+   size_t pos = 3 * 84 + 400 * 6 + 3 * sizeof(double);
+   std::reverse(bytes.begin() + pos, bytes.begin() + pos + sizeof(int));
+   ofstream swapped(swappedName.c_str(), ios::out | ios::binary);
+   swapped.write(bytes.data(), bytes.size());
+   written = written && swapped.good();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+mappedTest()
+{
+   TUDEF("SolarSystemEphemeris", "initializeWithMappedFile");
+   SolarSystemEphemeris streamEph, mappedEph;
+   double pv[6], pvStream[6];
+   TUASSERT(written);
+
+      // nothing is mapped yet
+   SolarSystemEphemeris::RecordCursor cursor;
+   TUTHROW(mappedEph.relativeInertialPositionVelocity(
+              51600.0, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv, cursor));
+
+   TUASSERTE(int, 0, streamEph.initializeWithBinaryFile(fileName));
+   TUASSERTE(int, 0, mappedEph.initializeWithMappedFile(fileName));
+   TUASSERT(mappedEph.isMapped());
+   TUASSERT(!streamEph.isMapped());
+   TUASSERTE(int, 999, mappedEph.EphNumber());
+   TUASSERTFE(AUkm, mappedEph.AU());
+   TUASSERTFE(startJD - MJD_TO_JD, mappedEph.startTimeMJD());
+
+      // every pair of bodies agrees with the stream mode
+   for (int k = 0; k < 100; k++)
+   {
+      double mjd = randomMJD();
+      for (int t = 1; t <= 15; t++)
+      {
+         SolarSystemEphemeris::Planet target = SolarSystemEphemeris::Planet(t);
+         SolarSystemEphemeris::Planet center =
+            SolarSystemEphemeris::Planet(1 + (t + k) % 13);
+         streamEph.relativeInertialPositionVelocity(mjd, target, center,
+                                                    pvStream);
+         mappedEph.relativeInertialPositionVelocity(mjd, target, center, pv,
+                                                    cursor);
+         for (int i = 0; i < 6; i++)
+            TUASSERTFEPS(pvStream[i], pv[i], 1.e-9 * (1 + ::fabs(pv[i])));
+            // the non-const interface uses the mapping too
+         mappedEph.relativeInertialPositionVelocity(mjd, target, center,
+                                                    pvStream);
+         for (int i = 0; i < 6; i++)
+            TUASSERTFE(pv[i], pvStream[i]);
+      }
+   }
+
+      // the ends of the data, and beyond
+   double first = startJD - MJD_TO_JD, last = first + nrec * interval;
+   mappedEph.relativeInertialPositionVelocity(
+      first, SolarSystemEphemeris::idSun, SolarSystemEphemeris::idEarth, pv,
+      cursor);
+   mappedEph.relativeInertialPositionVelocity(
+      last, SolarSystemEphemeris::idSun, SolarSystemEphemeris::idEarth, pv,
+      cursor);
+   TUTHROW(mappedEph.relativeInertialPositionVelocity(
+              first - 0.1, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv, cursor));
+   TUTHROW(mappedEph.relativeInertialPositionVelocity(
+              last + 0.1, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv, cursor));
+
+      // a header in the other byte order is refused
+   SolarSystemEphemeris swappedEph;
+   TUTHROW(swappedEph.initializeWithMappedFile(swappedName));
+   TUASSERT(!swappedEph.isMapped());
+
+      // re-initializing with the stream releases the mapping
+   TUASSERTE(int, 0, mappedEph.initializeWithBinaryFile(fileName));
+   TUASSERT(!mappedEph.isMapped());
+   TUTHROW(mappedEph.relativeInertialPositionVelocity(
+              first + 1, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv, cursor));
+   TURETURN();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+chebyshevTest()
+{
+   TUDEF("SolarSystemEphemeris", "relativeInertialPositionVelocity");
+   SolarSystemEphemeris eph;
+   eph.initializeWithMappedFile(fileName);
+   SolarSystemEphemeris::RecordCursor cursor;
+   double pv[6];
+
+      // Sun and Moon (several sets per record) relative to the barycenters
+   const int body[2] = {10, 9};
+   const SolarSystemEphemeris::Planet planet[2] = {
+      SolarSystemEphemeris::idSun, SolarSystemEphemeris::idMoon};
+   const SolarSystemEphemeris::Planet center[2] = {
+      SolarSystemEphemeris::idSolarSystemBarycenter,
+      SolarSystemEphemeris::idEarth};
+   for (int k = 0; k < 50; k++)
+   {
+      double mjd = randomMJD();
+      for (int b = 0; b < 2; b++)
+      {
+         eph.relativeInertialPositionVelocity(mjd, planet[b], center[b], pv,
+                                              cursor);
+         int n = int((mjd + MJD_TO_JD - startJD) / interval);
+         double span = interval / nsets[body[b]];
+         double t0 = records[n][0] - MJD_TO_JD;
+         int set = int((mjd - t0) / span);
+         double T = 2.0 * (mjd - t0 - set * span) / span - 1.0;
+         double theta = ::acos(T);
+         for (int c = 0; c < 3; c++)
+         {
+            const double *coef = &records[n][offset[body[b]] - 1 +
+                                             (set * 3 + c) * ncoeff[body[b]]];
+            double pos = 0.0, vel = 0.0;
+            for (int j = 0; j < ncoeff[body[b]]; j++)
+            {
+               pos += coef[j] * ::cos(j * theta);
+               vel += coef[j] * j * ::sin(j * theta) / ::sin(theta);
+            }
+            vel *= 2.0 / span;
+            TUASSERTFEPS(pos, pv[c], 1.e-8 * (1 + ::fabs(pos)));
+            TUASSERTFEPS(vel, pv[c + 3], 1.e-8 * (1 + ::fabs(vel)));
+         }
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+batchTest()
+{
+   TUDEF("SolarSystemEphemeris", "geocentricSunMoon");
+   SolarSystemEphemeris eph;
+   eph.initializeWithMappedFile(fileName);
+   SolarSystemEphemeris::RecordCursor cursor;
+   double pv[6];
+
+      // an hourly grid across several records
+   vector<double> mjds;
+   for (double t = startJD - MJD_TO_JD + 0.5; t < startJD - MJD_TO_JD + 70.0;
+        t += 1.0 / 24)
+      mjds.push_back(t);
+
+   vector<double> sunPV, moonPV, batch;
+   eph.geocentricSunMoon(mjds, sunPV, moonPV);
+   eph.relativeInertialPositionVelocity(mjds, SolarSystemEphemeris::idMars,
+                                        SolarSystemEphemeris::idSun, batch,
+                                        false);
+   TUASSERTE(size_t, 6 * mjds.size(), sunPV.size());
+   TUASSERTE(size_t, 6 * mjds.size(), batch.size());
+   for (size_t n = 0; n < mjds.size(); n++)
+   {
+      eph.relativeInertialPositionVelocity(
+         mjds[n], SolarSystemEphemeris::idSun, SolarSystemEphemeris::idEarth,
+         pv, cursor);
+      for (int i = 0; i < 6; i++)
+         TUASSERTFEPS(pv[i], sunPV[6 * n + i], 1.e-9 * (1 + ::fabs(pv[i])));
+      eph.relativeInertialPositionVelocity(
+         mjds[n], SolarSystemEphemeris::idMoon, SolarSystemEphemeris::idEarth,
+         pv, cursor);
+      for (int i = 0; i < 6; i++)
+         TUASSERTFEPS(pv[i], moonPV[6 * n + i], 1.e-9 * (1 + ::fabs(pv[i])));
+      eph.relativeInertialPositionVelocity(
+         mjds[n], SolarSystemEphemeris::idMars, SolarSystemEphemeris::idSun,
+         pv, cursor, false);
+      for (int i = 0; i < 6; i++)
+         TUASSERTFEPS(pv[i], batch[6 * n + i], 1.e-15 * (1 + ::fabs(pv[i])));
+   }
+
+      // concurrent callers, each with its own cursor
+   const int nthreads = 4;
+   vector<vector<double> > results(nthreads);
+   vector<thread> threads;
+   for (int k = 0; k < nthreads; k++)
+   {
+      threads.push_back(thread([&eph, &mjds, &results, k]() {
+         SolarSystemEphemeris::RecordCursor myCursor;
+         vector<double>& res = results[k];
+         res.resize(6 * mjds.size());
+         for (size_t n = 0; n < mjds.size(); n++)
+            eph.relativeInertialPositionVelocity(
+               mjds[n], SolarSystemEphemeris::idSun,
+               SolarSystemEphemeris::idEarth, &res[6 * n], myCursor);
+      }));
+   }
+   for (int k = 0; k < nthreads; k++)
+      threads[k].join();
+   for (int k = 0; k < nthreads; k++)
+      TUASSERT(sunPV == results[k]);
+
+   vector<double> late(1, startJD - MJD_TO_JD + nrec * interval + 1.0);
+   TUTHROW(eph.geocentricSunMoon(late, sunPV, moonPV));
+   TURETURN();
+}
+
+
+int main()
+{
+   SolarSystemEphemeris_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.mappedTest();
+   errorTotal += testClass.chebyshevTest();
+   errorTotal += testClass.batchTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
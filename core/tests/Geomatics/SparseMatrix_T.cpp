@@ -0,0 +1,337 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file SparseMatrix_T.cpp Test SparseVector and SparseMatrix against the
+/// dense Vector and Matrix results.
+
+#include <cmath>
+#include <vector>
+#include "SparseMatrix.hpp"
+#include "SRIMatrix.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SparseMatrix_T
+{
+public:
+   SparseMatrix_T();
+      /// Check element access and the sorted index storage of SparseVector.
+   unsigned vectorStorageTest();
+      /// Check SparseVector sums and scaled sums against Vector.
+   unsigned vectorArithmeticTest();
+      /// Check the SparseMatrix products against the dense products.
+   unsigned productTest();
+      /// Check sums, concatenation, sub-matrix and swaps against Matrix.
+   unsigned editTest();
+      /// Check SparseHouseholder() and the sparse SrifMU() against dense.
+   unsigned householderTest();
+
+private:
+      /// Random dense matrix with about density*r*c non-zero elements.
+   Matrix<double> randomSparse(unsigned r, unsigned c, double density);
+   TestRandom rng;
+};
+
+
+SparseMatrix_T ::
+SparseMatrix_T()
+      : rng(24680)
+{
+}
+
+
+Matrix<double> SparseMatrix_T ::
+randomSparse(unsigned r, unsigned c, double density)
+{
+   Matrix<double> rv(r, c, 0.0);
+   for (unsigned i = 0; i < r; i++)
+      for (unsigned j = 0; j < c; j++)
+         if (0.5 * (rng.random() + 1.0) < density)
+            rv(i,j) = rng.random();
+   return rv;
+}
+
+
+unsigned SparseMatrix_T ::
+vectorStorageTest()
+{
+   TUDEF("SparseVector", "operator[]");
+   SparseVector<double> sv(10);
+      // assign out of order; storage must stay sorted
+   sv[7] = 7.0;
+   sv[2] = 2.0;
+   sv[9] = 9.0;
+   sv[4] = 4.0;
+   sv[2] = 2.5;
+   TUASSERTE(unsigned, 4, sv.datasize());
+   TUASSERTE(double, 2.5, sv[2]);
+   TUASSERTE(double, 0.0, sv[3]);
+   TUASSERT(sv.isFilled(9));
+   TUASSERT(!sv.isFilled(8));
+      // assigning zero removes the element
+   sv[4] = 0.0;
+   TUASSERTE(unsigned, 3, sv.datasize());
+   TUASSERT(!sv.isFilled(4));
+
+   TUCSM("SparseVector(SV,ind,n)");
+   SparseVector<double> sub(sv, 2, 5);
+   TUASSERTE(unsigned, 5, sub.size());
+   TUASSERTE(unsigned, 1, sub.datasize());
+   TUASSERTE(double, 2.5, sub[0]);
+
+   TUCSM("truncate");
+   sv.truncate(8);
+   TUASSERTE(unsigned, 2, sv.datasize());
+   TUASSERTE(unsigned, 10, sv.size());
+
+   TUCSM("zeroize");
+   sv[0] = 1.e-20;
+   sv.zeroize(1.e-14);
+   TUASSERTE(unsigned, 2, sv.datasize());
+   TUASSERT(!sv.isFilled(0));
+   TURETURN();
+}
+
+
+unsigned SparseMatrix_T ::
+vectorArithmeticTest()
+{
+   TUDEF("SparseVector", "operator+=");
+   const unsigned n = 40;
+   Matrix<double> M(randomSparse(2, n, 0.3));
+   Vector<double> a(M.rowCopy(0)), b(M.rowCopy(1));
+   SparseVector<double> sa(a), sb(b);
+
+   SparseVector<double> s(sa);
+   s += sb;
+   TUASSERTE(double, 0.0, maxDiff(Vector<double>(s), a + b));
+   s += b;
+   TUASSERTE(double, 0.0, maxDiff(Vector<double>(s), a + b + b));
+
+   TUCSM("operator-=");
+   s = sa;
+   s -= sb;
+   TUASSERTE(double, 0.0, maxDiff(Vector<double>(s), a - b));
+   s -= s;
+   TUASSERTE(unsigned, 0, s.datasize());
+   s = sa;
+   s -= a;
+   TUASSERTE(unsigned, 0, s.datasize());
+
+   TUCSM("addScaledSparseVector");
+   s = sa;
+   s.addScaledSparseVector(-2.0, sb);
+   TUASSERTFEPS(0.0, maxDiff(Vector<double>(s), a - 2.0 * b), 1e-15);
+   s.addScaledSparseVector(1.0, s);
+   TUASSERTFEPS(0.0, maxDiff(Vector<double>(s), 2.0 * (a - 2.0 * b)), 1e-15);
+
+   TUCSM("dot");
+   TUASSERTFEPS(dot(a, b), dot(sa, sb), 1e-14);
+   TURETURN();
+}
+
+
+unsigned SparseMatrix_T ::
+productTest()
+{
+   TUDEF("SparseMatrix", "operator*");
+   const unsigned r = 17, k = 23, c = 13;
+   Matrix<double> L(randomSparse(r, k, 0.2)), R(randomSparse(k, c, 0.2));
+   Vector<double> v(k), w(r);
+   for (unsigned i = 0; i < k; i++)
+      v(i) = (i % 3 == 0 ? rng.random() : 0.0);
+   for (unsigned i = 0; i < r; i++)
+      w(i) = (i % 4 == 1 ? rng.random() : 0.0);
+   SparseMatrix<double> SL(L), SR(R);
+   SparseVector<double> sv(v), sw(w);
+   const double eps = 1e-14;
+
+   TUASSERTFEPS(0.0, maxDiff(Matrix<double>(SL * SR), L * R), eps);
+   TUASSERTFEPS(0.0, maxDiff(Matrix<double>(SL * R), L * R), eps);
+   TUASSERTFEPS(0.0, maxDiff(Matrix<double>(L * SR), L * R), eps);
+   TUASSERTFEPS(0.0, maxDiff(Vector<double>(SL * sv), L * v), eps);
+   TUASSERTFEPS(0.0, maxDiff(Vector<double>(SL * v), L * v), eps);
+   TUASSERTFEPS(0.0, maxDiff(Vector<double>(sw * SL), w * L), eps);
+   TUASSERTFEPS(0.0, maxDiff(Vector<double>(w * SL), w * L), eps);
+   TUASSERTFEPS(0.0, maxDiff(Vector<double>(sw * L), w * L), eps);
+
+   TUCSM("transpose");
+   Matrix<double> LT(transpose(L));
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(transpose(SL)), LT));
+   TUASSERTE(unsigned, SL.datasize(), transpose(SL).datasize());
+
+   TUCSM("matrixTimesTranspose");
+   TUASSERTFEPS(0.0, maxDiff(Matrix<double>(matrixTimesTranspose(SL)), L * LT),
+                eps);
+
+      // an all-zero product has no rows
+   SparseMatrix<double> Z(r, k);
+   TUASSERTE(unsigned, 0, (Z * SR).datasize());
+   TURETURN();
+}
+
+
+unsigned SparseMatrix_T ::
+editTest()
+{
+   TUDEF("SparseMatrix", "operator+=");
+   const unsigned r = 11, c = 9;
+   Matrix<double> A(randomSparse(r, c, 0.25)), B(randomSparse(r, c, 0.25));
+   SparseMatrix<double> SA(A), SB(B);
+
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA + SB), A + B));
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA - SB), A - B));
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA + B), A + B));
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA - B), A - B));
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(A - SB), A - B));
+   SparseMatrix<double> S(SA);
+   S -= SA;
+   TUASSERTE(unsigned, 0, S.datasize());
+
+   TUCSM("operator||");
+   Vector<double> v(r, 0.0);
+   v(0) = 1.0;
+   v(r-1) = -2.0;
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA || SB), A || B));
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA || v), A || v));
+   SparseMatrix<double> SAv(SA || v);
+   TUASSERTE(unsigned, c+1, SAv.rowCopy(r-1).size());
+
+   TUCSM("SparseMatrix(SM,rind,cind,rnum,cnum)");
+   SparseMatrix<double> sub(SA, 3, 2, 5, 4);
+   Matrix<double> dsub(A, 3, 2, 5, 4);
+   TUASSERTE(unsigned, 5, sub.rows());
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(sub), dsub));
+
+   TUCSM("swapRows");
+   Matrix<double> A2(A);
+   for (unsigned j = 0; j < c; j++)
+   {
+      A(1,j) = 0.0;
+      A2(1,j) = A(4,j);
+      A2(4,j) = 0.0;
+   }
+   SparseMatrix<double> SA2(A);
+   SA2.swapRows(1, 4);
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA2), A2));
+   SA2.swapRows(0, 4);
+   A2.swapRows(0, 4);
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA2), A2));
+
+   TUCSM("swapCols");
+   SA2.swapCols(0, 3);
+   A2.swapCols(0, 3);
+   TUASSERTE(double, 0.0, maxDiff(Matrix<double>(SA2), A2));
+
+   TUCSM("inverse");
+   Matrix<double> P(randomSparse(c, c, 0.3));
+   P = P * transpose(P);
+   for (unsigned i = 0; i < c; i++)
+      P(i,i) += 4.0;
+   SparseMatrix<double> SP(P);
+   Matrix<double> ident(c, c, 0.0);
+   for (unsigned i = 0; i < c; i++)
+      for (unsigned j = 0; j < c; j++)
+         ident(i,j) = (i == j ? 1.0 : 0.0);
+   TUASSERTFEPS(0.0, maxDiff(Matrix<double>(inverse(SP) * SP), ident), 1e-12);
+   TUASSERTFEPS(0.0, maxDiff(Matrix<double>(inverseViaCholesky(SP) * SP),
+                             ident), 1e-12);
+   TURETURN();
+}
+
+
+unsigned SparseMatrix_T ::
+householderTest()
+{
+   TUDEF("SparseMatrix", "SparseHouseholder");
+   const unsigned n = 8, m = 20;
+   Matrix<double> A(randomSparse(m, n, 0.3));
+   for (unsigned j = 0; j < n; j++)
+      A(j,j) = 2.0 + rng.random();
+   SparseMatrix<double> SA(A);
+   Matrix<double> H(SparseHouseholder(SA));
+      // the last column is treated as data, and not zeroed
+   for (unsigned j = 0; j+1 < n; j++)
+      for (unsigned i = j+1; i < m; i++)
+         TUASSERTE(double, 0.0, H(i,j));
+      // an orthogonal transformation preserves A^T*A
+   TUASSERTFEPS(0.0, maxDiff(transpose(H) * H, transpose(A) * A), 1e-12);
+
+   TUCSM("SrifMU");
+   Matrix<double> R(n, n, 0.0), HD(randomSparse(m, n+1, 0.3));
+   Vector<double> Z(n, 0.0);
+   for (unsigned j = 0; j < n; j++)
+   {
+      for (unsigned i = 0; i <= j; i++)
+         R(i,j) = rng.random();
+      R(j,j) = 3.0 + rng.random();
+      Z(j) = rng.random();
+   }
+   Matrix<double> R1(R), R2(R);
+   Vector<double> Z1(Z), Z2(Z);
+   SparseMatrix<double> SHD(HD);
+   SrifMU(R1, Z1, HD);
+   SrifMU(R2, Z2, SHD);
+   TUASSERTFEPS(0.0, maxDiff(R1, R2), 1e-12);
+   TUASSERTFEPS(0.0, maxDiff(Z1, Z2), 1e-12);
+      // residuals are returned in the last column
+   TUASSERTFEPS(0.0, maxDiff(HD.colCopy(n),
+                             Vector<double>(SHD.colCopy(n))), 1e-12);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SparseMatrix_T testClass;
+
+   errorTotal += testClass.vectorStorageTest();
+   errorTotal += testClass.vectorArithmeticTest();
+   errorTotal += testClass.productTest();
+   errorTotal += testClass.editTest();
+   errorTotal += testClass.householderTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,222 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file SparseNormalEquations_T.cpp Test class SparseNormalEquations against
+/// a dense least squares solution of the same problem.
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "SparseNormalEquations.hpp"
+#include "SRIMatrix.hpp"
+#include "StringUtils.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SparseNormalEquations_T
+{
+public:
+   SparseNormalEquations_T();
+      /// Compare the Schur complement solution with the dense solution.
+   unsigned solveTest();
+      /// Check the errors on bad labels, dimensions and singular blocks.
+   unsigned errorTest();
+
+private:
+   TestRandom rng;
+};
+
+
+SparseNormalEquations_T ::
+SparseNormalEquations_T()
+      : rng(97531)
+{
+}
+
+
+unsigned SparseNormalEquations_T ::
+solveTest()
+{
+   TUDEF("SparseNormalEquations", "solve");
+      // 5 stations, each with a clock and a troposphere parameter, sharing
+      // 6 satellite parameters; each station sees only some satellites
+   const unsigned nsta = 5, nloc = 2, nsat = 6, nobs = 12;
+   vector<string> gl;
+   for (unsigned s = 0; s < nsat; s++)
+      gl.push_back("Sat" + StringUtils::asString(s));
+   Namelist globals(gl), locals(vector<string>({"Clock", "Trop"}));
+   SparseNormalEquations sne(globals);
+
+      // the dense problem has all parameters: globals, then locals by station
+   const unsigned n = nsat + nsta * nloc;
+   Matrix<double> Nd(n, n, 0.0);
+   Vector<double> bd(n, 0.0);
+   double dwd = 0.0;
+   for (unsigned k = 0; k < nsta; k++)
+   {
+      const string sta("Sta" + StringUtils::asString(k));
+      sne.addBlock(sta, locals);
+         // columns: clock, trop, and 3 satellites
+      vector<string> cols({"Clock", "Trop"});
+      vector<unsigned> dcol({nsat + k * nloc, nsat + k * nloc + 1});
+      for (unsigned j = 0; j < 3; j++)
+      {
+         const unsigned s = (k + 2 * j) % nsat;
+         cols.push_back(gl[s]);
+         dcol.push_back(s);
+      }
+      Matrix<double> H(nobs, cols.size());
+      Vector<double> D(nobs), W(nobs);
+      for (unsigned i = 0; i < nobs; i++)
+      {
+         for (unsigned j = 0; j < cols.size(); j++)
+            H(i,j) = (j == 0 ? 1.0 : rng.random());
+         D(i) = rng.random();
+         W(i) = 2.0 + rng.random();
+         dwd += W(i) * D(i) * D(i);
+         for (unsigned a = 0; a < cols.size(); a++)
+         {
+            bd(dcol[a]) += H(i,a) * W(i) * D(i);
+            for (unsigned c = 0; c < cols.size(); c++)
+               Nd(dcol[a], dcol[c]) += H(i,a) * W(i) * H(i,c);
+         }
+      }
+      sne.addData(sta, Namelist(cols), H, D, W);
+   }
+      // a global-only pseudo-measurement on each satellite
+   Matrix<double> Hg(nsat, nsat, 0.0);
+   Vector<double> Dg(nsat);
+   for (unsigned s = 0; s < nsat; s++)
+   {
+      Hg(s,s) = 1.0;
+      Dg(s) = 0.1 * rng.random();
+      Nd(s,s) += 1.0;
+      bd(s) += Dg(s);
+      dwd += Dg(s) * Dg(s);
+   }
+   sne.addData("", globals, Hg, Dg);
+   TUASSERTE(unsigned, nsta * nobs + nsat, sne.getNumberOfData());
+   TUASSERT(!sne.isValid());
+
+   sne.solve();
+   TUASSERT(sne.isValid());
+   Matrix<double> Cd(inverseCholesky(Nd));
+   Vector<double> Xd(Cd * bd);
+   const double eps = 1e-10;
+   Vector<double> Xg(sne.getGlobalSolution());
+   Matrix<double> Cg(sne.getGlobalCovariance());
+   TUASSERTFEPS(0.0, maxDiff(Xg, Vector<double>(Xd, 0, nsat)), eps);
+   TUASSERTFEPS(0.0, maxDiff(Cg, Matrix<double>(Cd, 0, 0, nsat, nsat)), eps);
+   for (unsigned k = 0; k < nsta; k++)
+   {
+      const string sta("Sta" + StringUtils::asString(k));
+      const unsigned off = nsat + k * nloc;
+      TUASSERTFEPS(0.0, maxDiff(sne.getLocalSolution(sta),
+                                Vector<double>(Xd, off, nloc)), eps);
+      TUASSERTFEPS(0.0, maxDiff(sne.getLocalCovariance(sta),
+                                Matrix<double>(Cd, off, off, nloc, nloc)), eps);
+   }
+   TUASSERTFEPS(dwd - dot(Xd, bd), sne.getSumSquaredResiduals(), eps);
+
+      // adding a global keeps the information accumulated
+   TUCSM("addGlobals");
+   sne.addGlobals(Namelist(vector<string>({"Sat0", "Extra"})));
+   TUASSERTE(unsigned, nsat + 1, sne.getGlobalNames().size());
+   Matrix<double> He(1, 1, 1.0);
+   Vector<double> De(1, 0.5);
+   sne.addData("", Namelist(vector<string>({"Extra"})), He, De);
+   sne.solve();
+   TUASSERTFEPS(0.0, maxDiff(Vector<double>(sne.getGlobalSolution(), 0, nsat),
+                             Vector<double>(Xd, 0, nsat)), eps);
+   TUASSERTFEPS(0.5, sne.getGlobalSolution()(nsat), eps);
+
+   TUCSM("zeroAll");
+   sne.zeroAll();
+   TUASSERTE(unsigned, 0, sne.getNumberOfData());
+   TUASSERT(!sne.isValid());
+   TUTHROW(sne.getGlobalSolution());
+   TURETURN();
+}
+
+
+unsigned SparseNormalEquations_T ::
+errorTest()
+{
+   TUDEF("SparseNormalEquations", "addBlock");
+   Namelist globals(vector<string>({"G0", "G1"}));
+   Namelist locals(vector<string>({"L0"}));
+   SparseNormalEquations sne(globals);
+   sne.addBlock("A", locals);
+   TUTHROW(sne.addBlock("A", locals));
+   TUTHROW(sne.addBlock("B", globals));
+   TUTHROW(sne.addBlock("", locals));
+   TUCSM("addGlobals");
+   TUTHROW(sne.addGlobals(locals));
+
+   TUCSM("addData");
+   Matrix<double> H(2, 2, 1.0);
+   Vector<double> D(2, 1.0);
+   TUTHROW(sne.addData("X", globals, H, D));
+   TUTHROW(sne.addData("", Namelist(vector<string>({"G0", "L0"})), H, D));
+   TUTHROW(sne.addData("A", globals, H, Vector<double>(3, 1.0)));
+   TUTHROW(sne.getLocalNames("X"));
+
+   TUCSM("solve");
+      // block A has no information
+   sne.addData("", globals, ident<double>(2), D);
+   TUTHROW(sne.solve());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SparseNormalEquations_T testClass;
+
+   errorTotal += testClass.solveTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,223 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file StreamingRobustStats_T.cpp Test the streaming robust statistics
+/// against the exact functions in RobustStats.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "StreamingRobustStats.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class StreamingRobustStats_T
+{
+public:
+   StreamingRobustStats_T();
+      /// Check the rank error of QuantileSketch quantiles, median and MAD.
+   unsigned sketchTest();
+      /// Compare SlidingMedian with Robust::Median and Robust::MAD.
+   unsigned slidingTest();
+      /// Check that StreamingPolyFit recovers a polynomial with outliers.
+   unsigned polyFitTest();
+
+private:
+   TestRandom rng;
+};
+
+
+StreamingRobustStats_T ::
+StreamingRobustStats_T()
+      : rng(13579)
+{
+}
+
+
+unsigned StreamingRobustStats_T ::
+sketchTest()
+{
+   TUDEF("QuantileSketch", "quantile");
+   const unsigned nd = 20000;
+   const double eps = 0.005;
+   Robust::QuantileSketch qs(eps);
+   vector<double> data(nd);
+   for (unsigned i = 0; i < nd; i++)
+   {
+      data[i] = rng.gaussian() + (i % 97 == 0 ? 50.0 : 0.0);
+      qs.add(data[i]);
+   }
+   TUASSERTE(unsigned long, nd, qs.count());
+   TUASSERTFE(eps * nd, qs.rankErrorBound());
+      // the summary is much smaller than the data
+   TUASSERT(qs.size() < nd / 20);
+   vector<double> sorted(data);
+   sort(sorted.begin(), sorted.end());
+   TUASSERTE(double, sorted.front(), qs.minimum());
+   TUASSERTE(double, sorted.back(), qs.maximum());
+   for (double phi = 0.0; phi <= 1.0; phi += 0.05)
+   {
+         // rank of the returned value must be within eps*n of phi*n
+      const double v = qs.quantile(phi);
+      const double lo = lower_bound(sorted.begin(), sorted.end(), v) -
+         sorted.begin() + 1;
+      const double hi = upper_bound(sorted.begin(), sorted.end(), v) -
+         sorted.begin();
+      const double r = max(1.0, ceil(phi * nd));
+      TUASSERT(lo - eps * nd <= r && r <= hi + eps * nd);
+   }
+
+   TUCSM("MAD");
+   double M, Mx;
+   double mad = qs.MAD(M);
+   double madx = Robust::MAD(&data[0], nd, Mx);
+   TUASSERTFEPS(Mx, M, 0.05);
+   TUASSERTFEPS(madx, mad, 0.05);
+
+   TUCSM("reset");
+   qs.reset();
+   TUASSERTE(unsigned long, 0, qs.count());
+   TUTHROW(qs.median());
+   TUTHROW(Robust::QuantileSketch(0.0));
+   TURETURN();
+}
+
+
+unsigned StreamingRobustStats_T ::
+slidingTest()
+{
+   TUDEF("SlidingMedian", "MAD");
+   const unsigned N = 31, nd = 500;
+   Robust::SlidingMedian sm(N);
+   TUTHROW(sm.median());
+   vector<double> data;
+   for (unsigned i = 0; i < nd; i++)
+   {
+         // steps and duplicates exercise both sides of the median
+      const double x = (i % 7 == 0 ? 1.0 : floor(10 * rng.random()) / 4) +
+         (i > 250 ? 5.0 : 0.0);
+      data.push_back(x);
+      sm.add(x);
+      const unsigned n = min(i + 1, N);
+      TUASSERTE(unsigned, n, sm.size());
+      if (n < 2)
+      {
+         continue;
+      }
+      vector<double> win(data.end() - n, data.end());
+      double M, Mx, mad, madx;
+      mad = sm.MAD(M);
+      madx = Robust::MAD(&win[0], n, Mx);
+      TUASSERTE(double, Mx, M);
+      TUASSERTFEPS(madx, mad, 1e-14);
+      TUASSERTE(double, Robust::Median(&win[0], n), sm.median());
+      // even windows exercise the averaged median
+      if (i == 40)
+      {
+         Robust::SlidingMedian even(N + 1);
+         for (unsigned j = 0; j <= N; j++)
+            even.add(data[i - N + j]);
+         win.assign(data.end() - N - 1, data.end());
+         mad = even.MAD(M);
+         madx = Robust::MAD(&win[0], N + 1, Mx);
+         TUASSERTE(double, Mx, M);
+         TUASSERTFEPS(madx, mad, 1e-14);
+      }
+   }
+   TUASSERT(sm.full());
+   TUTHROW(Robust::SlidingMedian(0));
+   TURETURN();
+}
+
+
+unsigned StreamingRobustStats_T ::
+polyFitTest()
+{
+   TUDEF("StreamingPolyFit", "add");
+   const double c0 = 1.5, c1 = -0.25, c2 = 0.01;
+   Robust::StreamingPolyFit fit(3);
+   TUASSERT(!fit.isValid());
+   TUTHROW(fit.coefficients());
+   unsigned nout = 0, ndown = 0;
+   for (unsigned i = 0; i < 400; i++)
+   {
+      const double t = 100.0 + 0.5 * i;
+      const double dt = t - 100.0;
+      double x = c0 + c1 * dt + c2 * dt * dt + 0.01 * rng.gaussian();
+      const bool outlier = (i > 20 && i % 13 == 0);
+      if (outlier)
+      {
+         x += 10.0;
+         nout++;
+      }
+      const double w = fit.add(t, x);
+      if (outlier && w < 0.01)
+      {
+         ndown++;
+      }
+   }
+   TUASSERT(fit.isValid());
+   TUASSERTE(unsigned, nout, ndown);
+   Vector<double> c = fit.coefficients();
+   TUASSERTFEPS(0.0, fit.firstData() + c(0) - c0, 0.01);
+   TUASSERTFEPS(c1, c(1), 1e-3);
+   TUASSERTFEPS(c2, c(2), 1e-5);
+   TUASSERTFEPS(c0 + c1 * 50.0 + c2 * 2500.0, fit.evaluate(150.0), 0.01);
+   fit.reset();
+   TUASSERT(!fit.isValid());
+   TURETURN();
+}
+
+
+int main()
+{
+   StreamingRobustStats_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.sketchTest();
+   errorTotal += testClass.slidingTest();
+   errorTotal += testClass.polyFitTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,220 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <chrono>
+#include <cmath>
+#include "Matrix.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// Generic (ConstMatrixBase) view of a Matrix, to get the reference operators.
+typedef ConstMatrixBase<double, Matrix<double> > GenericMatrix;
+   /// Generic (ConstVectorBase) view of a Vector.
+typedef ConstVectorBase<double, Vector<double> > GenericVector;
+
+class Matrix_Kernels_T
+{
+public:
+   Matrix_Kernels_T();
+      /// Compare Matrix*Matrix against the generic operator.
+   unsigned multiplyTest();
+      /// Compare Matrix*Vector and Vector*Matrix against the generic operators.
+   unsigned vectorTest();
+      /// Check transpose and the fused transpose products.
+   unsigned transposeTest();
+      /// Compare timing of the generic and blocked products.
+   unsigned timingTest();
+
+private:
+   TestRandom rng;
+};
+
+
+Matrix_Kernels_T ::
+Matrix_Kernels_T()
+      : rng(12345)
+{
+}
+
+
+unsigned Matrix_Kernels_T ::
+multiplyTest()
+{
+   TUDEF("Matrix", "operator*");
+      // sizes that exercise the 4-column unrolling remainder and
+      // the cache block boundaries in MatrixKernels.
+   const size_t dims[][3] = { {1,1,1}, {3,5,2}, {4,4,4}, {7,9,6}, {13,3,17},
+                              {300,6,140}, {257,129,131} };
+   for (const auto& d : dims)
+   {
+      Matrix<double> a(rng.matrix(d[0],d[2])), b(rng.matrix(d[2],d[1]));
+      const GenericMatrix &ga(a), &gb(b);
+      Matrix<double> fast(a * b), ref(ga * gb);
+      TUASSERTE(size_t, d[0], fast.rows());
+      TUASSERTE(size_t, d[1], fast.cols());
+         // same summation order, so the results should match exactly
+      TUASSERTE(double, 0, maxDiff(fast, ref));
+   }
+   Matrix<double> a(3,4), b(3,4);
+   TUTHROW(a * b);
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+vectorTest()
+{
+   TUDEF("Matrix", "operator*");
+   Matrix<double> a(rng.matrix(11,7));
+   Vector<double> x(7), y(11);
+   for (size_t i = 0; i < x.size(); i++)
+      x[i] = 0.5 * i - 1.0;
+   for (size_t i = 0; i < y.size(); i++)
+      y[i] = 1.0 - 0.25 * i;
+   const GenericMatrix& ga(a);
+   const GenericVector &gx(x), &gy(y);
+   Vector<double> fast(a * x), ref(ga * gx);
+   TUASSERTE(size_t, 11, fast.size());
+   for (size_t i = 0; i < fast.size(); i++)
+      TUASSERTE(double, ref[i], fast[i]);
+   fast = y * a;
+   ref = gy * ga;
+   TUASSERTE(size_t, 7, fast.size());
+   for (size_t i = 0; i < fast.size(); i++)
+      TUASSERTE(double, ref[i], fast[i]);
+   TUTHROW(a * y);
+   TUTHROW(x * a);
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+transposeTest()
+{
+   TUDEF("Matrix", "transpose");
+   Matrix<double> a(rng.matrix(45,7)), b(rng.matrix(45,5)),
+      c(rng.matrix(6,7));
+   const GenericMatrix &ga(a), &gb(b), &gc(c);
+   Matrix<double> at(transpose(a)), ref(transpose(ga));
+   TUASSERTE(size_t, 7, at.rows());
+   TUASSERTE(size_t, 45, at.cols());
+   TUASSERTE(double, 0, maxDiff(at, ref));
+
+   TUCSM("transposeTimes");
+   ref = transpose(ga) * gb;
+   TUASSERTE(double, 0, maxDiff(transposeTimes(a, b), ref));
+      // symmetric case only computes half, check the mirroring
+   ref = transpose(ga) * ga;
+   TUASSERTE(double, 0, maxDiff(transposeTimes(a, a), ref));
+   TUTHROW(transposeTimes(a, c));
+
+   TUCSM("timesTranspose");
+   ref = gc * transpose(ga);
+   TUASSERTE(double, 0, maxDiff(timesTranspose(c, a), ref));
+   TUTHROW(timesTranspose(a, b));
+
+   TUCSM("transposeWeighted");
+      // W need not be symmetric
+   Matrix<double> w(rng.matrix(45,45));
+   const GenericMatrix& gw(w);
+   ref = transpose(ga) * gw * ga;
+   TUASSERTE(double, 0, maxDiff(transposeWeighted(a, w), ref));
+   Vector<double> wd(45);
+   Matrix<double> wdm(45, 45, 0.0);
+   for (size_t i = 0; i < wd.size(); i++)
+      wdm(i,i) = wd[i] = 1.0 + 0.1 * i;
+   const GenericMatrix& gwdm(wdm);
+   ref = transpose(ga) * gwdm * ga;
+   TUASSERTE(double, 0, maxDiff(transposeWeighted(a, wd), ref));
+   TUTHROW(transposeWeighted(a, c));
+   TUTHROW(transposeWeighted(a, Vector<double>(3)));
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+timingTest()
+{
+   TUDEF("Matrix", "operator*");
+   typedef std::chrono::steady_clock Clock;
+   const size_t sizes[] = { 4, 8, 16, 32, 64, 128, 256, 500 };
+   for (size_t n : sizes)
+   {
+      Matrix<double> a(rng.matrix(n,n)), b(rng.matrix(n,n)), fast, ref;
+      const GenericMatrix &ga(a), &gb(b);
+         // repeat small products so the timing is measurable
+      unsigned reps = std::max<size_t>(1, 2000000 / (n*n*n));
+      Clock::time_point t0 = Clock::now();
+      for (unsigned i = 0; i < reps; i++)
+         ref = ga * gb;
+      Clock::time_point t1 = Clock::now();
+      for (unsigned i = 0; i < reps; i++)
+         fast = a * b;
+      Clock::time_point t2 = Clock::now();
+      double genericSec = std::chrono::duration<double>(t1-t0).count() / reps;
+      double fastSec = std::chrono::duration<double>(t2-t1).count() / reps;
+      cout << "Matrix " << n << "x" << n << " product: generic "
+           << genericSec << " s, blocked " << fastSec << " s";
+      if (fastSec > 0)
+         cout << " (" << genericSec / fastSec << "x)";
+      cout << endl;
+         // timing is informational, only the results are checked
+      TUASSERTE(double, 0, maxDiff(fast, ref));
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Matrix_Kernels_T testClass;
+
+   errorTotal += testClass.multiplyTest();
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.transposeTest();
+   errorTotal += testClass.timingTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
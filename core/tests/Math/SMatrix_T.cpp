@@ -0,0 +1,305 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <chrono>
+#include <cmath>
+#include "SMatrix.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+typedef SMatrix<double,3,3> Matrix33;
+typedef SMatrix<double,4,4> Matrix44;
+
+class SMatrix_T
+{
+public:
+   SMatrix_T();
+      /// Check construction and conversion to and from Matrix/Vector.
+   unsigned convertTest();
+      /// Compare products and transpose against Matrix<double>.
+   unsigned multiplyTest();
+      /// Compare rotation() against gnsstk::rotation().
+   unsigned rotationTest();
+      /// Check inverse() and cholesky() against Matrix<double>.
+   unsigned inverseTest();
+      /// Check the SVector operations.
+   unsigned vectorTest();
+      /// Compare timing of 3x3 rotation chains with Matrix<double>.
+   unsigned timingTest();
+
+private:
+      /// Fill a matrix with pseudo-random values in [-1,1).
+   template <size_t R, size_t C>
+   SMatrix<double,R,C> randomMatrix();
+   TestRandom rng;
+};
+
+
+SMatrix_T ::
+SMatrix_T()
+      : rng(54321)
+{
+}
+
+
+template <size_t R, size_t C>
+SMatrix<double,R,C> SMatrix_T ::
+randomMatrix()
+{
+   SMatrix<double,R,C> rv;
+   for (size_t i = 0; i < R; i++)
+   {
+      for (size_t j = 0; j < C; j++)
+      {
+         rv(i,j) = rng.random();
+      }
+   }
+   return rv;
+}
+
+
+unsigned SMatrix_T ::
+convertTest()
+{
+   TUDEF("SMatrix", "SMatrix");
+   Matrix33 z;
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTE(double, 0, z(i,j));
+      // initializer list is row major
+   SMatrix<double,2,3> a({1, 2, 3, 4, 5, 6});
+   TUASSERTE(double, 2, a(0,1));
+   TUASSERTE(double, 4, a(1,0));
+   TUASSERTE(double, 6, a(1,2));
+      // storage is column major, like Matrix
+   TUASSERTE(double, 4, a.data()[1]);
+   Matrix<double> m(a);
+   TUASSERTE(size_t, 2, m.rows());
+   TUASSERTE(size_t, 3, m.cols());
+   for (size_t i = 0; i < 2; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTE(double, a(i,j), m(i,j));
+   SMatrix<double,2,3> b(m);
+   TUASSERTE(double, 0, maxDiff(Matrix<double>(b), m));
+   TUCSM("SMatrix(Matrix)");
+   Matrix<double> wrong(3,2);
+   TUTHROW((Matrix33(wrong)));
+   TUTHROW((SMatrix<double,2,2>({1, 2, 3, 4, 5})));
+   Matrix44 eye(Matrix44::identity());
+   TUASSERTE(double, 0, maxDiff(eye, ident<double>(4)));
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+multiplyTest()
+{
+   TUDEF("SMatrix", "operator*");
+   Matrix33 a(randomMatrix<3,3>()), b(randomMatrix<3,3>());
+   Matrix<double> ma(a), mb(b);
+      // same summation order, so the results should match exactly
+   TUASSERTE(double, 0, maxDiff(a * b, ma * mb));
+   SMatrix<double,4,3> c(randomMatrix<4,3>());
+   Matrix<double> mc(c);
+   TUASSERTE(double, 0, maxDiff(c * a, mc * ma));
+   SVector<double,3> x({0.5, -1.25, 2.0});
+   Vector<double> vx(x);
+   Vector<double> y(c * x), vy(mc * vx);
+   TUASSERTE(size_t, 4, y.size());
+   for (size_t i = 0; i < y.size(); i++)
+      TUASSERTE(double, vy[i], y[i]);
+   SVector<double,4> w({1, 2, 3, 4});
+   Vector<double> z(w * c), vz(Vector<double>(w) * mc);
+   for (size_t i = 0; i < z.size(); i++)
+      TUASSERTE(double, vz[i], z[i]);
+   TUCSM("transpose");
+   TUASSERTE(double, 0, maxDiff(transpose(c), transpose(mc)));
+   TUCSM("operator+");
+   TUASSERTE(double, 0, maxDiff(a + b, ma + mb));
+   TUCSM("operator-");
+   TUASSERTE(double, 0, maxDiff(a - b, ma - mb));
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+rotationTest()
+{
+   TUDEF("SMatrix", "rotation");
+   for (int axis = 1; axis <= 3; axis++)
+   {
+      TUASSERTE(double, 0, maxDiff(Matrix33::rotation(0.3, axis),
+                                   rotation(0.3, axis)));
+   }
+   Matrix33 r(Matrix33::rotation(-0.7, 1) * Matrix33::rotation(0.2, 3) *
+              Matrix33::rotation(1.1, 2));
+   Matrix<double> mr(rotation(-0.7, 1) * rotation(0.2, 3) * rotation(1.1, 2));
+   TUASSERTE(double, 0, maxDiff(r, mr));
+      // a rotation's inverse is its transpose
+   TUASSERTFEPS(0, maxDiff(inverse(r), transpose(r)), 1e-15);
+   TUTHROW(Matrix33::rotation(0.3, 0));
+   TUTHROW(Matrix33::rotation(0.3, 4));
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+inverseTest()
+{
+   TUDEF("SMatrix", "inverse");
+   Matrix44 a(randomMatrix<4,4>());
+   Matrix<double> ma(a);
+   TUASSERTFEPS(0, maxDiff(inverse(a), inverse(ma)), 1e-12);
+   TUASSERTFEPS(0, maxDiff(a * inverse(a), ident<double>(4)), 1e-12);
+      // zero leading element requires pivoting
+   Matrix33 p({0, 1, 2, 1, 0, 3, 4, -3, 8});
+   TUASSERTFEPS(0, maxDiff(p * inverse(p), Matrix33::identity()), 1e-12);
+   Matrix33 s({1, 2, 3, 2, 4, 6, 1, 0, 1});
+   TUTHROW(inverse(s));
+
+   TUCSM("cholesky");
+      // symmetric positive definite
+   Matrix44 spd(a * transpose(a) + Matrix44::identity() * 0.5);
+   Matrix44 L(cholesky(spd));
+   Cholesky<double> ch;
+   ch(Matrix<double>(spd));
+   TUASSERTFEPS(0, maxDiff(L, ch.L), 1e-14);
+   TUASSERTFEPS(0, maxDiff(L * transpose(L), spd), 1e-14);
+   for (size_t i = 0; i < 4; i++)
+      for (size_t j = i+1; j < 4; j++)
+         TUASSERTE(double, 0, L(i,j));
+   TUTHROW(cholesky(Matrix33({1, 0, 0, 0, -1, 0, 0, 0, 1})));
+
+   TUCSM("choleskySolve");
+   SVector<double,4> b({1, -2, 3, -4});
+   SVector<double,4> x(choleskySolve(L, b));
+   SVector<double,4> r(spd * x - b);
+   TUASSERTFEPS(0, norm(r), 1e-12);
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+vectorTest()
+{
+   TUDEF("SVector", "SVector");
+   SVector<double,3> z;
+   TUASSERTE(double, 0, z[0] + z[1] + z[2]);
+   SVector<double,3> a({1, 2, 3}), b({-2, 0.5, 4});
+   Vector<double> va(a);
+   TUASSERTE(size_t, 3, va.size());
+   TUASSERTE(double, 2, va[1]);
+   SVector<double,3> c(va);
+   TUASSERTE(double, 3, c[2]);
+   TUTHROW((SVector<double,4>(va)));
+   TUTHROW((SVector<double,2>({1, 2, 3})));
+   TUCSM("dot");
+   TUASSERTE(double, 11, dot(a, b));
+   TUCSM("norm");
+   TUASSERTFE(std::sqrt(14.0), norm(a));
+   TUCSM("cross");
+   SVector<double,3> x(cross(a, b));
+   TUASSERTE(double, 6.5, x[0]);
+   TUASSERTE(double, -10, x[1]);
+   TUASSERTE(double, 4.5, x[2]);
+   TUASSERTE(double, 0, dot(x, a));
+   TUCSM("operator+");
+   SVector<double,3> s(a + b * 2.0 - a);
+   TUASSERTE(double, -4, s[0]);
+   TUASSERTE(double, 8, s[2]);
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+timingTest()
+{
+   TUDEF("SMatrix", "operator*");
+   typedef std::chrono::steady_clock Clock;
+   const int reps = 100000;
+   double sumS = 0, sumM = 0;
+   Clock::time_point t0 = Clock::now();
+   for (int i = 0; i < reps; i++)
+   {
+      double ang = i * 1e-5;
+      Matrix<double> R(rotation(-ang, 1) * rotation(ang, 3) *
+                       rotation(2*ang, 1) * rotation(0.5*ang, 3));
+      sumM += R(0,1);
+   }
+   Clock::time_point t1 = Clock::now();
+   for (int i = 0; i < reps; i++)
+   {
+      double ang = i * 1e-5;
+      Matrix33 R(Matrix33::rotation(-ang, 1) * Matrix33::rotation(ang, 3) *
+                 Matrix33::rotation(2*ang, 1) * Matrix33::rotation(0.5*ang,3));
+      sumS += R(0,1);
+   }
+   Clock::time_point t2 = Clock::now();
+   double mSec = std::chrono::duration<double>(t1-t0).count() / reps;
+   double sSec = std::chrono::duration<double>(t2-t1).count() / reps;
+   cout << "3x3 rotation chain: Matrix " << mSec << " s, SMatrix "
+        << sSec << " s";
+   if (sSec > 0)
+      cout << " (" << mSec / sSec << "x)";
+   cout << endl;
+      // timing is informational, only the results are checked
+   TUASSERTE(double, sumM, sumS);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SMatrix_T testClass;
+
+   errorTotal += testClass.convertTest();
+   errorTotal += testClass.multiplyTest();
+   errorTotal += testClass.rotationTest();
+   errorTotal += testClass.inverseTest();
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.timingTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,241 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file Stats_Accumulate_T.cpp Test batch, merged and sliding window
+/// accumulation in Stats, TwoSampleStats and PowerSum.
+
+#include <cmath>
+#include <vector>
+#include "Stats.hpp"
+#include "PowerSum.hpp"
+#include "TestMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class Stats_Accumulate_T
+{
+public:
+   Stats_Accumulate_T();
+      /// Compare batch Add with sample-by-sample Add.
+   unsigned batchTest();
+      /// Check that accumulators of shards combine to that of the whole.
+   unsigned mergeTest();
+      /// Compare SlidingStats with Stats of the window.
+   unsigned slidingTest();
+
+private:
+   TestRandom rng;
+   vector<double> x, y;
+};
+
+
+Stats_Accumulate_T ::
+Stats_Accumulate_T()
+      : rng(8642)
+{
+      // large offset, to exercise the scaling in Stats
+   for (unsigned i = 0; i < 1003; i++)
+   {
+      x.push_back(i < 3 ? 0.0 : 1.0e6 + rng.random());
+      y.push_back(0.5 * x.back() + 0.1 * rng.random());
+   }
+}
+
+
+unsigned Stats_Accumulate_T ::
+batchTest()
+{
+   TUDEF("Stats", "Add");
+   Stats<double> one, batch;
+   for (unsigned i = 0; i < x.size(); i++)
+      one.Add(x[i]);
+   batch.Add(x);
+   TUASSERTE(unsigned, one.N(), batch.N());
+   TUASSERTE(double, one.Minimum(), batch.Minimum());
+   TUASSERTE(double, one.Maximum(), batch.Maximum());
+   TUASSERTE(double, one.Scale(), batch.Scale());
+   TUASSERTFEPS(one.Average(), batch.Average(),
+                1e-12 * std::abs(one.Average()));
+   TUASSERTFEPS(one.Variance(), batch.Variance(),
+                1e-12 * std::abs(one.Variance()));
+      // a batch added to existing data
+   batch.Add(&y[0], 7);
+   for (unsigned i = 0; i < 7; i++)
+      one.Add(y[i]);
+   TUASSERTE(unsigned, one.N(), batch.N());
+   TUASSERTE(double, one.Minimum(), batch.Minimum());
+   TUASSERTFEPS(one.Average(), batch.Average(),
+                1e-12 * std::abs(one.Average()));
+   TUASSERTFEPS(one.Variance(), batch.Variance(),
+                1e-12 * std::abs(one.Variance()));
+
+   TUCSM("TwoSampleStats::Add");
+   TwoSampleStats<double> tone, tbatch;
+   for (unsigned i = 0; i < x.size(); i++)
+      tone.Add(x[i], y[i]);
+   tbatch.Add(x, y);
+   TUASSERTE(unsigned, tone.N(), tbatch.N());
+   TUASSERTFEPS(tone.Slope(), tbatch.Slope(), 1e-9);
+   TUASSERTFEPS(tone.Intercept(), tbatch.Intercept(), 1e-6);
+   TUASSERTFEPS(tone.Correlation(), tbatch.Correlation(), 1e-9);
+
+   TUCSM("PowerSum::add");
+   PowerSum pone, pbatch;
+   vector<double> z(x.size());
+   for (unsigned i = 0; i < z.size(); i++)
+   {
+      z[i] = x[i] - 1.0e6 + (i % 5);
+      pone.add(z[i]);
+   }
+   pbatch.add(&z[0], z.size());
+   TUASSERTE(long, pone.size(), pbatch.size());
+   TUASSERTFEPS(pone.average(), pbatch.average(),
+                1e-12 * std::abs(pone.average()));
+   TUASSERTFEPS(pone.variance(), pbatch.variance(),
+                1e-12 * std::abs(pone.variance()));
+   TUASSERTFEPS(pone.skew(), pbatch.skew(), 1e-10);
+   TUASSERTFEPS(pone.kurtosis(), pbatch.kurtosis(), 1e-10);
+   TURETURN();
+}
+
+
+unsigned Stats_Accumulate_T ::
+mergeTest()
+{
+   TUDEF("Stats", "operator+=");
+   const unsigned nshard = 4, len = x.size() / nshard + 1;
+   Stats<double> whole, merged;
+   TwoSampleStats<double> twhole, tmerged;
+   PowerSum pwhole, pmerged;
+   whole.Add(x);
+   twhole.Add(x, y);
+   pwhole.add(&y[0], y.size());
+   for (unsigned s = 0; s < nshard; s++)
+   {
+      const unsigned b = s * len, e = min<unsigned>(x.size(), b + len);
+      Stats<double> shard;
+      TwoSampleStats<double> tshard;
+      PowerSum pshard;
+      shard.Add(&x[b], e - b);
+      tshard.Add(&x[b], &y[b], e - b);
+      pshard.add(&y[b], e - b);
+      merged += shard;
+      tmerged += tshard;
+      pmerged += pshard;
+   }
+   TUASSERTE(unsigned, whole.N(), merged.N());
+   TUASSERTE(double, whole.Minimum(), merged.Minimum());
+   TUASSERTE(double, whole.Maximum(), merged.Maximum());
+   TUASSERTFEPS(whole.Average(), merged.Average(),
+                1e-12 * std::abs(whole.Average()));
+   TUASSERTFEPS(whole.Variance(), merged.Variance(),
+                1e-12 * std::abs(whole.Variance()));
+
+      // a Stats emptied by Subtract does not keep its old sums
+   Stats<double> emptied;
+   emptied.Add(5.0);
+   emptied.Add(7.0);
+   emptied.Subtract(7.0);
+   emptied.Subtract(5.0);
+   emptied += whole;
+   TUASSERTFEPS(whole.Average(), emptied.Average(),
+                1e-12 * std::abs(whole.Average()));
+
+   TUCSM("TwoSampleStats::operator+=");
+   TUASSERTE(unsigned, twhole.N(), tmerged.N());
+   TUASSERTFEPS(twhole.Slope(), tmerged.Slope(), 1e-9);
+   TUASSERTFEPS(twhole.Correlation(), tmerged.Correlation(), 1e-9);
+
+   TUCSM("PowerSum::operator+=");
+   TUASSERTE(long, pwhole.size(), pmerged.size());
+   TUASSERTFEPS(pwhole.average(), pmerged.average(),
+                1e-12 * std::abs(pwhole.average()));
+   pmerged -= pwhole;
+   TUASSERTE(long, 0, pmerged.size());
+   TURETURN();
+}
+
+
+unsigned Stats_Accumulate_T ::
+slidingTest()
+{
+   TUDEF("SlidingStats", "Add");
+   const unsigned N = 25;
+   SlidingStats<double> ss(N);
+   TUASSERTE(unsigned, N, ss.Window());
+      // a modest offset; Stats itself loses precision on the variance when
+      // the offset is large compared with the spread
+   vector<double> z(x.size());
+   for (unsigned i = 0; i < z.size(); i++)
+      z[i] = 10.0 + rng.random() + (i > 500 ? 3.0 : 0.0);
+   for (unsigned i = 0; i < z.size(); i++)
+   {
+      ss.Add(z[i]);
+      const unsigned n = min(i + 1, N);
+      TUASSERTE(unsigned, n, ss.N());
+      Stats<double> win;
+      win.Add(&z[i + 1 - n], n);
+      TUASSERTE(double, win.Minimum(), ss.Minimum());
+      TUASSERTE(double, win.Maximum(), ss.Maximum());
+      TUASSERTFEPS(win.Average(), ss.Average(), 1e-12);
+      TUASSERTFEPS(win.Variance(), ss.Variance(), 1e-10);
+   }
+   TUASSERT(ss.Full());
+   ss.Reset();
+   TUASSERTE(unsigned, 0, ss.N());
+   TUTHROW(SlidingStats<double>(0));
+   TURETURN();
+}
+
+
+int main()
+{
+   Stats_Accumulate_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.mergeTest();
+   errorTotal += testClass.slidingTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
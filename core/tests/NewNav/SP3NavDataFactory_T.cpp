@@ -99,6 +99,8 @@ public:
    unsigned findInterpTest();
       /// Test find with edge cases
    unsigned findEdgeTest();
+      /// Make sure lazy loading gives the same results as full loading.
+   unsigned lazyLoadTest();
       /// Test find with an SP3c file which contains P/EP, V/EV records
    unsigned sp3cPVTest();
       /// Test find with an SP3c file which contains P/EP records (no V)
@@ -510,6 +512,66 @@ findInterpTest()
 }
 
 
+unsigned SP3NavDataFactory_T ::
+lazyLoadTest()
+{
+   TUDEF("SP3NavDataFactory", "setLazyLoad");
+   gnsstk::SP3NavDataFactory full, lazy;
+   gnsstk::NavSatelliteID satID1(15, 15, gnsstk::SatelliteSystem::GPS,
+                                 gnsstk::CarrierBand::L1,
+                                 gnsstk::TrackingCode::CA,
+                                 gnsstk::NavType::GPSLNAV);
+   gnsstk::NavMessageID nmid1(satID1, gnsstk::NavMessageType::Ephemeris);
+   std::string fname = gnsstk::getPathData() + gnsstk::getFileSep() +
+      "test_input_sp3_nav_ephemerisData.sp3";
+      // sidecar files are only written if a directory is given
+   lazy.setLazyLoad(true);
+   TUASSERT(lazy.isLazyLoad());
+   TUASSERT(full.addDataSource(fname));
+   TUASSERT(lazy.addDataSource(fname));
+      // nothing is loaded until it's needed...
+   TUASSERTE(size_t, 0, lazy.size());
+      // ...but the time span is known up front.
+   TUASSERTE(gnsstk::CommonTime, full.getInitialTime(),
+             lazy.getInitialTime());
+   TUASSERTE(gnsstk::CommonTime, full.getFinalTime(), lazy.getFinalTime());
+   gnsstk::CommonTime ct = gnsstk::CivilTime(1997,4,6,0,0,0,
+                                             gnsstk::TimeSystem::GPS);
+      // step through the file at an interval that isn't a multiple
+      // of the SP3 interval to get both exact matches and
+      // interpolation.
+   for (unsigned i = 0; i < 100; i++, ct += 870)
+   {
+      gnsstk::NavDataPtr ndFull, ndLazy;
+      bool rvFull = full.find(nmid1, ct, ndFull, gnsstk::SVHealth::Any,
+                              gnsstk::NavValidityType::ValidOnly,
+                              gnsstk::NavSearchOrder::User);
+      bool rvLazy = lazy.find(nmid1, ct, ndLazy, gnsstk::SVHealth::Any,
+                              gnsstk::NavValidityType::ValidOnly,
+                              gnsstk::NavSearchOrder::User);
+      TUASSERTE(bool, rvFull, rvLazy);
+      if (!rvFull || !rvLazy)
+         continue;
+      gnsstk::OrbitDataSP3 *odFull =
+         dynamic_cast<gnsstk::OrbitDataSP3*>(ndFull.get());
+      gnsstk::OrbitDataSP3 *odLazy =
+         dynamic_cast<gnsstk::OrbitDataSP3*>(ndLazy.get());
+      TUASSERTE(gnsstk::Triple, odFull->pos, odLazy->pos);
+      TUASSERTE(gnsstk::Triple, odFull->vel, odLazy->vel);
+      TUASSERTFE(odFull->clkBias, odLazy->clkBias);
+      TUASSERTFE(odFull->clkDrift, odLazy->clkDrift);
+   }
+      // a partial load should have happened.
+   TUASSERT(lazy.size() > 0);
+   TUASSERT(lazy.size() <= full.size());
+   TUASSERT(lazy.loadTimeSpan(full.getInitialTime(), full.getFinalTime()));
+   TUASSERTE(size_t, full.size(), lazy.size());
+   lazy.clear();
+   TUASSERTE(size_t, 0, lazy.size());
+   TURETURN();
+}
+
+
 unsigned SP3NavDataFactory_T ::
 findEdgeTest()
 {
@@ -1403,6 +1465,7 @@ int main()
    errorTotal += testClass.findExactTest();
    errorTotal += testClass.findInterpTest();
    errorTotal += testClass.findEdgeTest();
+   errorTotal += testClass.lazyLoadTest();
    errorTotal += testClass.sp3cPVTest();
    errorTotal += testClass.sp3cPTest();
    errorTotal += testClass.loadIntoMapFGNSSTest(false, false, false, false);
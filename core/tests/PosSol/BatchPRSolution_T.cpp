@@ -0,0 +1,458 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file BatchPRSolution_T.cpp Test class BatchPRSolution by comparing its
+/// results with PRSolution::RAIMCompute() run epoch by epoch, with GPS,
+/// BeiDou geostationary and BeiDou IGSO satellites, on one and on several
+/// threads.
+
+#include <cmath>
+#include <random>
+#include "BatchPRSolution.hpp"
+#include "NavDataFactory.hpp"
+#include "OrbitData.hpp"
+#include "CivilTime.hpp"
+#include "Position.hpp"
+#include "GNSSconstants.hpp"
+#include "GPSEllipsoid.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+/// A satellite on a circular Keplerian orbit, Earth-fixed frame
+/// coincident with the inertial frame at t0.
+class CircularOrbit : public OrbitData
+{
+public:
+   CircularOrbit(const CommonTime& t0, double radius, double incl,
+                 double raan, double u0, double bias, double drift)
+         : t0(t0), radius(radius), incl(incl), raan(raan), u0(u0),
+           bias(bias), drift(drift)
+   {
+      timeStamp = t0;
+   }
+   NavDataPtr clone() const override
+   { return std::make_shared<CircularOrbit>(*this); }
+   bool validate() const override
+   { return true; }
+   bool getXvt(const CommonTime& when, Xvt& xvt, const ObsID& oid) override
+   {
+      GPSEllipsoid ell;
+      double w = ell.angVelocity();
+      double dt = when - t0;
+      double n = ::sqrt(ell.gm() / (radius * radius * radius));
+      double u = u0 + n * dt, cu = ::cos(u), su = ::sin(u);
+      double cO = ::cos(raan), sO = ::sin(raan);
+      double ci = ::cos(incl), si = ::sin(incl);
+         // inertial position and velocity
+      double xi = radius * (cO * cu - sO * su * ci);
+      double yi = radius * (sO * cu + cO * su * ci);
+      double zi = radius * su * si;
+      double vxi = radius * n * (-cO * su - sO * cu * ci);
+      double vyi = radius * n * (-sO * su + cO * cu * ci);
+      double vzi = radius * n * cu * si;
+         // rotate into the Earth-fixed frame
+      double th = w * dt, ct = ::cos(th), st = ::sin(th);
+      xvt.x = Triple(ct * xi + st * yi, -st * xi + ct * yi, zi);
+      xvt.v = Triple(ct * vxi + st * vyi + w * xvt.x[1],
+                     -st * vxi + ct * vyi - w * xvt.x[0], vzi);
+      xvt.clkbias = bias + drift * dt;
+      xvt.clkdrift = drift;
+      xvt.relcorr = -2.0 * xvt.x.dot(xvt.v) / (C_MPS * C_MPS);
+      xvt.health = Xvt::Healthy;
+      xvt.frame = RefFrame(RefFrameRlz::WGS84G1762);
+      return true;
+   }
+
+   CommonTime t0;
+   double radius, incl, raan, u0, bias, drift;
+};
+
+
+/// Serve a CircularOrbit for each satellite as its ephemeris.
+class OrbitFactory : public NavDataFactory
+{
+public:
+   OrbitFactory()
+   {
+      supportedSignals.insert(NavSignalID(SatelliteSystem::GPS,
+                                          CarrierBand::L1,
+                                          TrackingCode::CA,
+                                          NavType::GPSLNAV));
+      supportedSignals.insert(NavSignalID(SatelliteSystem::BeiDou,
+                                          CarrierBand::B1,
+                                          TrackingCode::B1I,
+                                          NavType::BeiDou_D1));
+      supportedSignals.insert(NavSignalID(SatelliteSystem::BeiDou,
+                                          CarrierBand::B1,
+                                          TrackingCode::B1I,
+                                          NavType::BeiDou_D2));
+   }
+   bool find(const NavMessageID& nmid, const CommonTime& when,
+             NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
+             NavSearchOrder order) override
+   {
+      if (nmid.messageType != NavMessageType::Ephemeris)
+         return false;
+      auto it = orbits.find(nmid.sat);
+      if (it == orbits.end())
+         return false;
+      navOut = it->second;
+      return true;
+   }
+   bool getOffset(TimeSystem fromSys, TimeSystem toSys,
+                  const CommonTime& when, NavDataPtr& offset,
+                  SVHealth xmitHealth, NavValidityType valid) override
+   { return false; }
+   bool addDataSource(const std::string& source) override
+   { return false; }
+   NavSatelliteIDSet getAvailableSats(const CommonTime& fromTime,
+                                      const CommonTime& toTime) const override
+   { return NavSatelliteIDSet(); }
+   NavSatelliteIDSet getAvailableSats(NavMessageType nmt,
+                                      const CommonTime& fromTime,
+                                      const CommonTime& toTime) const override
+   { return NavSatelliteIDSet(); }
+   NavMessageIDSet getAvailableMsgs(const CommonTime& fromTime,
+                                    const CommonTime& toTime) const override
+   { return NavMessageIDSet(); }
+   std::string getFactoryFormats() const override
+   { return "Test"; }
+
+   std::map<SatID, std::shared_ptr<CircularOrbit> > orbits;
+};
+
+
+class BatchPRSolution_T
+{
+public:
+   BatchPRSolution_T();
+      /** Compare the batch solutions, with and without memory, with
+       * those of PRSolution::RAIMCompute() epoch by epoch. */
+   unsigned compareTest();
+      /// Check that the results do not depend on the number of threads.
+   unsigned threadTest();
+
+private:
+      /// Solve obs epoch by epoch with PRSolution::RAIMCompute().
+   BatchPRSolution::Results reference(const PRSolution& config);
+      /** Compare two sets of results; positions and clocks must agree to
+       * within tol meters. */
+   void compare(TestUtil& testFramework, const BatchPRSolution::Results& r1,
+                const BatchPRSolution::Results& r2, double tol);
+
+   std::shared_ptr<OrbitFactory> factory;
+   NavLibrary navLib;
+   std::vector<BatchPRSolution::Observation> obs;
+      /// receiver positions
+   std::vector<Triple> truth;
+      /// the epoch with a bad range
+   CommonTime badTime;
+   PRSolution config;
+};
+
+
+BatchPRSolution_T ::
+BatchPRSolution_T()
+      : factory(std::make_shared<OrbitFactory>())
+{
+   const double deg = PI / 180.0;
+   GPSEllipsoid ell;
+   const double w = ell.angVelocity();
+   CommonTime t0 = CivilTime(2020, 3, 1, 0, 0, 0.0, TimeSystem::GPS);
+   std::mt19937 gen(20200301);
+   std::normal_distribution<double> noise(0.0, 0.5);
+   std::uniform_real_distribution<double> clk(-1.e-4, 1.e-4);
+
+      // GPS: 6 planes of 4 satellites
+   for (int id = 1; id <= 24; id++)
+   {
+      int plane = (id - 1) / 4, slot = (id - 1) % 4;
+      factory->orbits[SatID(id, SatelliteSystem::GPS)] =
+         std::make_shared<CircularOrbit>(
+            t0, 26559.7e3, 55.0 * deg, plane * 60.0 * deg,
+            (slot * 90.0 + plane * 15.0) * deg, clk(gen), 1.e-11);
+   }
+      // BeiDou: GEOs at 80, 110.5 and 140 E, and 3 IGSOs
+   double rgeo = ::cbrt(ell.gm() / (w * w));
+   double geolon[3] = { 80.0, 110.5, 140.0 };
+   for (int id = 1; id <= 3; id++)
+   {
+      factory->orbits[SatID(id, SatelliteSystem::BeiDou)] =
+         std::make_shared<CircularOrbit>(
+            t0, rgeo, 0.0, 0.0, geolon[id - 1] * deg, clk(gen), -2.e-11);
+   }
+   for (int id = 6; id <= 8; id++)
+   {
+      factory->orbits[SatID(id, SatelliteSystem::BeiDou)] =
+         std::make_shared<CircularOrbit>(
+            t0, rgeo, 55.0 * deg, (118.0 + (id - 6) * 120.0) * deg,
+            (id - 6) * 120.0 * deg, clk(gen), 5.e-12);
+   }
+   NavDataFactoryPtr ndfp(factory);
+   navLib.addFactory(ndfp);
+
+      // receivers in east Asia, where the GEOs are visible
+   double sites[3][3] = { { 30.5, 114.3, 50.0 },
+                          { 39.9, 116.4, 80.0 },
+                          { 22.3, 114.2, 20.0 } };
+   for (int rec = 0; rec < 3; rec++)
+   {
+      Position p(sites[rec][0], sites[rec][1], sites[rec][2],
+                 Position::Geodetic);
+      p.asECEF();
+      Triple rx(p.X(), p.Y(), p.Z());
+      Triple up(rx.unitVector());
+      truth.push_back(rx);
+      double rxclk = 3000.0 * (rec + 1), isb = 25.0;
+      for (int ep = 0; ep < 10; ep++)
+      {
+         BatchPRSolution::Observation ob;
+         ob.receiver = rec;
+         ob.time = t0 + 30.0 * ep;
+         for (auto& orb : factory->orbits)
+         {
+            const SatID& sat(orb.first);
+            double bias = rxclk +
+               (sat.system == SatelliteSystem::BeiDou ? isb : 0.0);
+               // light time with Earth rotation
+            CommonTime receive(ob.time - bias / C_MPS);
+            double tof(0.07), rho(0.0);
+            Xvt xvt;
+            for (int iter = 0; iter < 5; iter++)
+            {
+               orb.second->getXvt(receive - tof, xvt, ObsID());
+               double th = w * tof, ct = ::cos(th), st = ::sin(th);
+               Triple sv(ct * xvt.x[0] + st * xvt.x[1],
+                         -st * xvt.x[0] + ct * xvt.x[1], xvt.x[2]);
+               rho = (sv - rx).mag();
+               if (iter == 0 && (sv - rx).unitVector().dot(up) < ::sin(10*deg))
+               {
+                  rho = 0.0;
+                  break;
+               }
+               tof = rho / C_MPS;
+            }
+            if (rho == 0.0)
+               continue;
+            ob.sats.push_back(sat);
+            ob.pseudoranges.push_back(rho + bias - C_MPS * xvt.clkbias
+                                      + noise(gen));
+         }
+            // one bad range, for RAIM to find
+         if (ep == 4)
+         {
+            badTime = ob.time;
+            ob.pseudoranges[rec + 1] += 200.0;
+         }
+         obs.push_back(ob);
+      }
+   }
+      // interleave the receivers, as a network file would
+   std::stable_sort(obs.begin(), obs.end(),
+                    [](const BatchPRSolution::Observation& l,
+                       const BatchPRSolution::Observation& r)
+                    { return l.time < r.time; });
+
+   config.allowedGNSS.push_back(SatelliteSystem::GPS);
+   config.allowedGNSS.push_back(SatelliteSystem::BeiDou);
+}
+
+
+BatchPRSolution::Results BatchPRSolution_T ::
+reference(const PRSolution& cfg)
+{
+   BatchPRSolution::Results res;
+   const size_t n = obs.size();
+   res.receiver.resize(n);
+   res.time.resize(n);
+   res.status.resize(n, 0);
+   res.x.resize(n, 0.0);
+   res.y.resize(n, 0.0);
+   res.z.resize(n, 0.0);
+   res.clock.assign(cfg.allowedGNSS.size(), std::vector<double>(n, 0.0));
+   res.rms.resize(n, 0.0);
+   res.pdop.resize(n, 0.0);
+   res.tdop.resize(n, 0.0);
+   res.gdop.resize(n, 0.0);
+   res.nsvs.resize(n, 0);
+   res.sats.resize(n);
+
+   ZeroTropModel trop;
+   std::map<int, PRSolution> byReceiver;
+   for (size_t i = 0; i < n; i++)
+   {
+      const BatchPRSolution::Observation& ob(obs[i]);
+         // obs is in time order, so each receiver's memory is built in order
+      if (!cfg.hasMemory || byReceiver.count(ob.receiver) == 0)
+      {
+         byReceiver[ob.receiver] = cfg;
+      }
+      PRSolution& prs(byReceiver[ob.receiver]);
+      std::vector<SatID> sats(ob.sats);
+      int iret = prs.RAIMCompute(ob.time, sats, ob.pseudoranges, ob.invMC,
+                                 navLib, &trop);
+      res.receiver[i] = ob.receiver;
+      res.time[i] = ob.time;
+      res.status[i] = iret;
+      res.sats[i] = sats;
+      if (iret < 0)
+         continue;
+      res.x[i] = prs.Solution(0);
+      res.y[i] = prs.Solution(1);
+      res.z[i] = prs.Solution(2);
+      for (size_t k = 0; k < prs.dataGNSS.size(); k++)
+      {
+         int col = vectorindex(cfg.allowedGNSS, prs.dataGNSS[k]);
+         res.clock[col][i] = prs.Solution(3 + k);
+      }
+      res.rms[i] = prs.RMSResidual;
+      res.pdop[i] = prs.PDOP;
+      res.tdop[i] = prs.TDOP;
+      res.gdop[i] = prs.GDOP;
+      res.nsvs[i] = prs.Nsvs;
+   }
+   return res;
+}
+
+
+void BatchPRSolution_T ::
+compare(TestUtil& testFramework, const BatchPRSolution::Results& r1,
+        const BatchPRSolution::Results& r2, double tol)
+{
+   TUASSERTE(size_t, r1.size(), r2.size());
+   TUASSERTE(size_t, r1.clock.size(), r2.clock.size());
+   double maxPos(0.0), maxClk(0.0);
+   for (size_t i = 0; i < r1.size() && i < r2.size(); i++)
+   {
+      TUASSERTE(int, r1.receiver[i], r2.receiver[i]);
+      TUASSERTE(CommonTime, r1.time[i], r2.time[i]);
+      TUASSERTE(int, r1.status[i], r2.status[i]);
+      TUASSERTE(int, r1.nsvs[i], r2.nsvs[i]);
+      TUASSERT(r1.sats[i] == r2.sats[i]);
+      maxPos = std::max(maxPos, ::fabs(r1.x[i] - r2.x[i]));
+      maxPos = std::max(maxPos, ::fabs(r1.y[i] - r2.y[i]));
+      maxPos = std::max(maxPos, ::fabs(r1.z[i] - r2.z[i]));
+      for (size_t k = 0; k < r1.clock.size() && k < r2.clock.size(); k++)
+      {
+         maxClk = std::max(maxClk, ::fabs(r1.clock[k][i] - r2.clock[k][i]));
+      }
+      TUASSERTFEPS(r1.rms[i], r2.rms[i], tol);
+      TUASSERTFEPS(r1.pdop[i], r2.pdop[i], 1.e-6);
+   }
+   TUASSERTFEPS(0.0, maxPos, tol);
+   TUASSERTFEPS(0.0, maxClk, tol);
+}
+
+
+unsigned BatchPRSolution_T ::
+compareTest()
+{
+   TUDEF("BatchPRSolution", "compute");
+   for (int mem = 0; mem < 2; mem++)
+   {
+      PRSolution cfg(config);
+      cfg.hasMemory = (mem == 1);
+      BatchPRSolution::Results ref(reference(cfg));
+
+         // the simulation must give good solutions, each including the GEOs,
+         // and RAIM must find the bad range
+      for (size_t i = 0; i < ref.size(); i++)
+      {
+         TUASSERTE(int, 1, ref.status[i] >= 0);
+         Triple sol(ref.x[i], ref.y[i], ref.z[i]);
+         TUASSERTE(int, 1, (sol - truth[ref.receiver[i]]).mag() < 5.0);
+         int ngeo(0), nbad(0);
+         for (const SatID& sat : ref.sats[i])
+         {
+            if (sat.system == SatelliteSystem::BeiDou && ::abs(sat.id) <= 3)
+               ngeo++;
+            if (sat.id < 0)
+               nbad++;
+         }
+         TUASSERTE(int, 3, ngeo);
+         TUASSERTE(int, (ref.time[i] == badTime ? 1 : 0), nbad);
+      }
+
+      BatchPRSolution batch(navLib, []()
+                            { return std::unique_ptr<TropModel>(
+                                  new ZeroTropModel()); });
+      batch.config = cfg;
+      batch.numThreads = 1;
+      compare(testFramework, batch.compute(obs), ref, 1.e-4);
+      batch.numThreads = 4;
+      compare(testFramework, batch.compute(obs), ref, 1.e-4);
+   }
+   TURETURN();
+}
+
+
+unsigned BatchPRSolution_T ::
+threadTest()
+{
+   TUDEF("BatchPRSolution", "numThreads");
+   for (int mem = 0; mem < 2; mem++)
+   {
+      BatchPRSolution batch(navLib, []()
+                            { return std::unique_ptr<TropModel>(
+                                  new ZeroTropModel()); });
+      batch.config = config;
+      batch.config.hasMemory = (mem == 1);
+      batch.numThreads = 1;
+      BatchPRSolution::Results r1(batch.compute(obs));
+      batch.numThreads = 4;
+      compare(testFramework, r1, batch.compute(obs), 0.0);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   BatchPRSolution_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.compareTest();
+   errorTotal += testClass.threadTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
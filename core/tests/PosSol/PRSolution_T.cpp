@@ -0,0 +1,229 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file PRSolution_T.cpp Test the RAIM algorithm of class PRSolution,
+/// comparing the incremental screening of exclusion subsets with the
+/// exhaustive search.
+
+#include <cmath>
+#include <random>
+#include <tuple>
+#include "PRSolution.hpp"
+#include "RawRange.hpp"
+#include "GPSEllipsoid.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class PRSolution_T
+{
+public:
+   PRSolution_T();
+      /** Solve simulated epochs with IncrementalRAIM true and false and
+       * compare the satellites selected and the solutions. */
+   unsigned raimTest();
+      /// Check that a bad satellite is found and excluded.
+   unsigned badSatTest();
+
+private:
+      /** Simulate an epoch of nsat satellites, GPS and (if twoSys)
+       * Galileo, with nfault ranges in error by 'fault' meters or more;
+       * wtype 0, 1 or 2 selects identity, diagonal or full weights. */
+   void simulate(int nsat, bool twoSys, int nfault, double fault, int wtype,
+                 vector<SatID>& sats, Matrix<double>& SVP,
+                 Matrix<double>& W, vector<int>& bad);
+      /** Run RAIMCompute() with IncrementalRAIM true and false, check
+       * that the results are the same and return the satellites. */
+   void compare(TestUtil& testFramework, const vector<SatID>& sats,
+                const Matrix<double>& SVP, const Matrix<double>& W,
+                int nreject, vector<SatID>& result);
+
+   std::mt19937 gen;
+   Triple rx;
+   CommonTime ttag;
+   ZeroTropModel trop;
+};
+
+
+PRSolution_T ::
+PRSolution_T()
+      : gen(20170904), rx(-740289.9, -5457071.7, 3207245.6),
+        ttag(CommonTime::BEGINNING_OF_TIME)
+{
+}
+
+
+void PRSolution_T ::
+simulate(int nsat, bool twoSys, int nfault, double fault, int wtype,
+         vector<SatID>& sats, Matrix<double>& SVP, Matrix<double>& W,
+         vector<int>& bad)
+{
+   std::normal_distribution<double> normal(0.0, 1.0);
+   std::uniform_real_distribution<double> uniform(0.0, 1.0);
+   GPSEllipsoid ellip;
+   const double clk[2] = { 1000.0 * normal(gen), 1000.0 * normal(gen) };
+   const double rxn = rx.mag();
+   const Triple up(rx[0] / rxn, rx[1] / rxn, rx[2] / rxn);
+
+   sats.clear();
+   SVP = Matrix<double>(nsat, 4, 0.0);
+   for (int i = 0; i < nsat; i++)
+   {
+      SatelliteSystem sys = (twoSys && i % 3 == 2 ? SatelliteSystem::Galileo
+                             : SatelliteSystem::GPS);
+      sats.push_back(SatID(i + 1, sys));
+         // random satellite above 10 degrees elevation
+      Triple sv;
+      do
+      {
+         double a = normal(gen), b = normal(gen), c = normal(gen);
+         double n = ::sqrt(a * a + b * b + c * c);
+         sv = Triple(2.656e7 * a / n, 2.656e7 * b / n, 2.656e7 * c / n);
+      } while ((sv - rx).dot(up) / (sv - rx).mag() < 0.17);
+      for (int k = 0; k < 3; k++)
+         SVP(i, k) = sv[k];
+         // range as the solution computes it, including Earth rotation
+      Position rxPos(rx[0], rx[1], rx[2]), svPos(sv[0], sv[1], sv[2]);
+      double rho;
+      std::tie(rho, svPos) = RawRange::computeRange(
+         rxPos, svPos, range(rxPos, svPos) / ellip.c(), ellip);
+      SVP(i, 3) = rho + clk[sys == SatelliteSystem::GPS ? 0 : 1]
+         + 0.5 * normal(gen);
+   }
+
+   bad.clear();
+   while ((int)bad.size() < nfault)
+   {
+      int i = gen() % nsat;
+      if (find(bad.begin(), bad.end(), i) != bad.end())
+         continue;
+      bad.push_back(i);
+      SVP(i, 3) += (bad.size() % 2 ? 1.0 : -1.0) * fault
+         * (1.0 + 4.0 * uniform(gen));
+   }
+
+   W = Matrix<double>(nsat, nsat, 0.0);
+   for (int i = 0; i < nsat; i++)
+   {
+      W(i, i) = (wtype == 0 ? 1.0 : 0.5 + uniform(gen));
+      if (wtype == 2)
+         for (int j = 0; j < i; j++)
+            W(i, j) = W(j, i) = 0.02 * normal(gen);
+   }
+}
+
+
+void PRSolution_T ::
+compare(TestUtil& testFramework, const vector<SatID>& sats,
+        const Matrix<double>& SVP, const Matrix<double>& W, int nreject,
+        vector<SatID>& result)
+{
+   vector<SatID> s1(sats), s2(sats);
+   PRSolution p1, p2;
+   p1.allowedGNSS = p2.allowedGNSS =
+      { SatelliteSystem::GPS, SatelliteSystem::Galileo };
+   p1.NSatsReject = p2.NSatsReject = nreject;
+   p1.RMSLimit = p2.RMSLimit = 2.0;
+   p1.IncrementalRAIM = false;
+   p2.IncrementalRAIM = true;
+
+   int r1 = p1.RAIMCompute(ttag, s1, SVP, W, &trop);
+   int r2 = p2.RAIMCompute(ttag, s2, SVP, W, &trop);
+   TUASSERTE(int, r1, r2);
+   TUASSERTE(bool, p1.isValid(), p2.isValid());
+   TUASSERT(s1 == s2);
+   TUASSERTE(double, p1.RMSResidual, p2.RMSResidual);
+   TUASSERTE(size_t, p1.Solution.size(), p2.Solution.size());
+   for (size_t i = 0; i < p1.Solution.size() && i < p2.Solution.size(); i++)
+      TUASSERTE(double, p1.Solution(i), p2.Solution(i));
+   result = s1;
+}
+
+
+unsigned PRSolution_T ::
+raimTest()
+{
+   TUDEF("PRSolution", "RAIMCompute");
+   TUASSERTE(bool, true, PRSolution().IncrementalRAIM);
+   vector<SatID> sats, result;
+   Matrix<double> SVP, W;
+   vector<int> bad;
+   for (int ep = 0; ep < 60; ep++)
+   {
+      int nsat = 8 + ep % 7;
+      int nfault = ep % 3;
+      simulate(nsat, ep % 2 == 1, nfault, 20.0, (ep / 3) % 3, sats, SVP, W,
+               bad);
+      compare(testFramework, sats, SVP, W, (ep % 4 ? 2 : -1), result);
+   }
+   TURETURN();
+}
+
+
+unsigned PRSolution_T ::
+badSatTest()
+{
+   TUDEF("PRSolution", "RAIMCompute");
+   vector<SatID> sats, result;
+   Matrix<double> SVP, W;
+   vector<int> bad;
+   for (int wtype = 0; wtype < 3; wtype++)
+   {
+      simulate(10, false, 1, 100.0, wtype, sats, SVP, W, bad);
+      compare(testFramework, sats, SVP, W, 1, result);
+         // the bad satellite, and only that one, is excluded
+      for (size_t i = 0; i < result.size(); i++)
+         TUASSERTE(bool, (int)i == bad[0], result[i].id <= 0);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   PRSolution_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.raimTest();
+   errorTotal += testClass.badSatTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -40,6 +40,8 @@
 #include <string>
 #include <sstream>
 #include <iterator>
+#include <cmath>
+#include <limits>
 #include "StringUtils.hpp"
 #include "TestUtil.hpp"
 
@@ -1257,6 +1259,70 @@ public:
 
       TURETURN();
    }
+
+      /**
+       * appendFixed and appendInt must produce exactly what
+       * rightJustify(asString(...)) produces, including for values
+       * that fall back to stream formatting.
+       */
+   unsigned appendTest()
+   {
+      TUDEF("StringUtils", "appendFixed");
+      const double values[] =
+      {
+         0., -0., 1., -1., 0.0005, -0.0005, 0.0015, 0.0625, -0.0625,
+         0.4999999, 2.5, 1e-20, -1e-20, 23456789.123456, -23456789.123456,
+         123456789012.3455, 99999999999.9995, 1e15, -1e15, 1e300,
+         std::numeric_limits<double>::quiet_NaN(),
+         std::numeric_limits<double>::infinity(),
+         -std::numeric_limits<double>::infinity()
+      };
+      std::string exp, got;
+      for (unsigned i = 0; i < sizeof(values)/sizeof(values[0]); i++)
+      {
+         for (std::string::size_type prec = 0; prec < 18; prec++)
+         {
+            for (std::string::size_type len = 1; len < 20; len += 3)
+            {
+               exp = "x" + rightJustify(asString(values[i], prec), len);
+               got = "x";
+               appendFixed(got, values[i], prec, len);
+               TUASSERTE(std::string, exp, got);
+            }
+         }
+      }
+         // pseudo-random observation-like values
+      unsigned long long seed = 12345;
+      for (unsigned i = 0; i < 100000; i++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         double x = ((double)(seed >> 11) / 9007199254740992.0 - 0.5) *
+            std::pow(10., (double)(i % 12));
+         exp = rightJustify(asString(x, 3), 14);
+         got.clear();
+         appendFixed(got, x, 3, 14);
+         TUASSERTE(std::string, exp, got);
+      }
+
+      TUCSM("appendInt");
+      const long ints[] = { 0, 7, -7, 42, -42, 2020, 32767, -32768 };
+      for (unsigned i = 0; i < sizeof(ints)/sizeof(ints[0]); i++)
+      {
+         for (std::string::size_type len = 1; len < 8; len++)
+         {
+            exp = rightJustify(asString(ints[i]), len, '0');
+            got.clear();
+            appendInt(got, ints[i], len, '0');
+            TUASSERTE(std::string, exp, got);
+            exp = rightJustify(asString(ints[i]), len);
+            got.clear();
+            appendInt(got, ints[i], len);
+            TUASSERTE(std::string, exp, got);
+         }
+      }
+
+      TURETURN();
+   }
 };
 
 int main() // Main function to initialize and run all tests above
@@ -1282,6 +1348,7 @@ int main() // Main function to initialize and run all tests above
    errorTotal += testClass.hexDumpDataConfigTest();
    errorTotal += testClass.hexToAsciiTest();
    errorTotal += testClass.floatFormatTest();
+   errorTotal += testClass.appendTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
@@ -95,6 +95,11 @@ namespace gnsstk
       virtual bool isStreamLittleEndian() const noexcept
       { return false; }
 
+   protected:
+         /// Records may still be waiting in rawData at end of file.
+      virtual bool atEndOfData()
+      { return rawData.empty() && FFBinaryStream::atEndOfData(); }
+
    }; // class AshtechStream
 } // namespace gnsstk
 